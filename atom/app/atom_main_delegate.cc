@@ -12,6 +12,7 @@
 #include "atom/browser/atom_browser_client.h"
 #include "atom/browser/relauncher.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
 #include "atom/renderer/atom_renderer_client.h"
 #include "atom/renderer/atom_sandboxed_renderer_client.h"
 #include "atom/utility/atom_content_utility_client.h"
@@ -121,6 +122,8 @@ AtomMainDelegate::AtomMainDelegate() {}
 AtomMainDelegate::~AtomMainDelegate() {}
 
 bool AtomMainDelegate::BasicStartupComplete(int* exit_code) {
+  StartupTimeline::AddMark("main");
+
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
   logging::LoggingSettings settings;
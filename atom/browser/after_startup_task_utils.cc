@@ -0,0 +1,103 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/after_startup_task_utils.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/lazy_instance.h"
+#include "base/location.h"
+#include "base/synchronization/atomic_flag.h"
+#include "base/task_runner.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace atom {
+
+namespace {
+
+// For the apps that only show a tray icon, or a window after a long while.
+const int kMaxStartupDelaySeconds = 10;
+
+struct AfterStartupTask {
+  base::Location from_here;
+  scoped_refptr<base::TaskRunner> task_runner;
+  base::OnceClosure task;
+};
+
+// Set on the UI thread, read on any thread.
+base::LazyInstance<base::AtomicFlag>::Leaky g_startup_complete_flag =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Only accessed on the UI thread.
+base::LazyInstance<std::vector<AfterStartupTask>>::Leaky g_after_startup_tasks =
+    LAZY_INSTANCE_INITIALIZER;
+
+void QueueTask(AfterStartupTask queued_task) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  // The startup may have completed since the task was posted to this thread.
+  if (AfterStartupTaskUtils::IsBrowserStartupComplete()) {
+    queued_task.task_runner->PostTask(queued_task.from_here,
+                                      std::move(queued_task.task));
+    return;
+  }
+  g_after_startup_tasks.Get().push_back(std::move(queued_task));
+}
+
+}  // namespace
+
+// static
+void AfterStartupTaskUtils::PostTask(
+    const base::Location& from_here,
+    const scoped_refptr<base::TaskRunner>& task_runner,
+    base::OnceClosure task) {
+  if (IsBrowserStartupComplete()) {
+    task_runner->PostTask(from_here, std::move(task));
+    return;
+  }
+
+  AfterStartupTask queued_task = {from_here, task_runner, std::move(task)};
+  if (BrowserThread::CurrentlyOn(BrowserThread::UI)) {
+    QueueTask(std::move(queued_task));
+  } else {
+    BrowserThread::PostTask(
+        BrowserThread::UI, FROM_HERE,
+        base::BindOnce(&QueueTask, std::move(queued_task)));
+  }
+}
+
+// static
+bool AfterStartupTaskUtils::IsBrowserStartupComplete() {
+  return g_startup_complete_flag.Get().IsSet();
+}
+
+// static
+void AfterStartupTaskUtils::SetBrowserStartupIsComplete() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (IsBrowserStartupComplete())
+    return;
+
+  TRACE_EVENT0("startup", "AfterStartupTaskUtils::SetBrowserStartupIsComplete");
+  g_startup_complete_flag.Get().Set();
+  std::vector<AfterStartupTask> tasks;
+  tasks.swap(g_after_startup_tasks.Get());
+  for (auto& queued_task : tasks)
+    queued_task.task_runner->PostTask(queued_task.from_here,
+                                      std::move(queued_task.task));
+}
+
+// static
+void AfterStartupTaskUtils::StartMonitoringStartup() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  BrowserThread::PostDelayedTask(
+      BrowserThread::UI, FROM_HERE,
+      base::BindOnce(&AfterStartupTaskUtils::SetBrowserStartupIsComplete),
+      base::TimeDelta::FromSeconds(kMaxStartupDelaySeconds));
+}
+
+}  // namespace atom
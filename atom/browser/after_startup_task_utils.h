@@ -0,0 +1,44 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_AFTER_STARTUP_TASK_UTILS_H_
+#define ATOM_BROWSER_AFTER_STARTUP_TASK_UTILS_H_
+
+#include "base/callback_forward.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+
+namespace base {
+class Location;
+class TaskRunner;
+}  // namespace base
+
+namespace atom {
+
+// Holds the tasks that are not needed to show the first window, until it has
+// painted. This backs content::BrowserThread::PostAfterStartupTask.
+class AfterStartupTaskUtils {
+ public:
+  // Runs |task| on |task_runner| once the startup is complete. Can be called
+  // on any thread.
+  static void PostTask(const base::Location& from_here,
+                       const scoped_refptr<base::TaskRunner>& task_runner,
+                       base::OnceClosure task);
+
+  static bool IsBrowserStartupComplete();
+
+  // Called on the UI thread when the first window has painted. Posts the
+  // tasks that were held.
+  static void SetBrowserStartupIsComplete();
+
+  // Completes the startup after a while for the apps that show no window.
+  static void StartMonitoringStartup();
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(AfterStartupTaskUtils);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_AFTER_STARTUP_TASK_UTILS_H_
@@ -4,6 +4,9 @@
 
 #include "atom/browser/api/atom_api_app.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -11,11 +14,18 @@
 #include "atom/browser/api/atom_api_session.h"
 #include "atom/browser/api/atom_api_web_contents.h"
 #include "atom/browser/api/gpuinfo_manager.h"
+#include "atom/browser/atom_browser_client.h"
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/atom_paths.h"
+#include "atom/browser/javascript_environment.h"
 #include "atom/browser/login_handler.h"
+#include "atom/browser/memory_metrics_request.h"
+#include "atom/browser/microtasks_runner.h"
+#include "atom/browser/process_memory.h"
 #include "atom/browser/relauncher.h"
+#include "atom/browser/task_duration_monitor.h"
+#include "atom/common/asar/archive.h"
 #include "atom/common/atom_command_line.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
@@ -25,15 +35,15 @@
 #include "atom/common/native_mate_converters/network_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
 #include "base/command_line.h"
 #include "base/environment.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/path_service.h"
+#include "base/process/process_metrics.h"
 #include "base/strings/string_util.h"
-#include "base/sys_info.h"
 #include "chrome/browser/browser_process.h"
-#include "chrome/browser/icon_manager.h"
 #include "chrome/common/chrome_paths.h"
 #include "content/browser/gpu/compositor_util.h"
 #include "content/browser/gpu/gpu_data_manager_impl.h"
@@ -359,12 +369,9 @@ struct Converter<content::CertificateRequestResultType> {
 
 namespace atom {
 
-ProcessMetric::ProcessMetric(int type,
-                             base::ProcessId pid,
-                             std::unique_ptr<base::ProcessMetrics> metrics) {
+ProcessMetric::ProcessMetric(int type, base::ProcessId pid) {
   this->type = type;
   this->pid = pid;
-  this->metrics = std::move(metrics);
 }
 
 ProcessMetric::~ProcessMetric() = default;
@@ -537,12 +544,12 @@ int ImportIntoCertStore(CertificateManagerModel* model,
 
 void OnIconDataAvailable(v8::Isolate* isolate,
                          const App::FileIconCallback& callback,
-                         gfx::Image* icon) {
+                         const gfx::Image& icon) {
   v8::Locker locker(isolate);
   v8::HandleScope handle_scope(isolate);
 
-  if (icon && !icon->IsEmpty()) {
-    callback.Run(v8::Null(isolate), *icon);
+  if (!icon.IsEmpty()) {
+    callback.Run(v8::Null(isolate), icon);
   } else {
     v8::Local<v8::String> error_message =
         v8::String::NewFromUtf8(isolate, "Failed to get file icon.");
@@ -550,6 +557,75 @@ void OnIconDataAvailable(v8::Isolate* isolate,
   }
 }
 
+// The memory of a process as counted by the OS, which is read when the
+// metrics are requested.
+struct ProcessMemorySample {
+  base::ProcessId pid;
+  int type;
+  bool has_memory;
+  ProcessMemory memory;
+};
+
+void OnAppMemoryMetrics(scoped_refptr<util::Promise> promise,
+                        const std::vector<ProcessMemorySample>& samples,
+                        const MemoryMetricsRequest::Result& result) {
+  v8::Isolate* isolate = promise->isolate();
+  v8::HeapStatistics heap;
+  isolate->GetHeapStatistics(&heap);
+
+  base::ListValue metrics;
+  for (const auto& sample : samples) {
+    base::DictionaryValue metric;
+    metric.SetInteger("pid", sample.pid);
+    metric.SetString("type",
+                     content::GetProcessTypeNameInEnglish(sample.type));
+
+    if (sample.has_memory) {
+      base::DictionaryValue memory;
+      memory.SetInteger("pid", sample.pid);
+      memory.SetInteger("workingSetSize", sample.memory.working_set_size);
+      memory.SetInteger("peakWorkingSetSize",
+                        sample.memory.peak_working_set_size);
+      memory.SetInteger("privateBytes", sample.memory.private_bytes);
+      memory.SetInteger("sharedBytes", sample.memory.shared_bytes);
+      metric.SetKey("memory", std::move(memory));
+    }
+
+    if (sample.type == content::PROCESS_TYPE_BROWSER) {
+      base::DictionaryValue js_heap;
+      js_heap.SetInteger("used", static_cast<int>(heap.used_heap_size() >> 10));
+      js_heap.SetInteger("total",
+                         static_cast<int>(heap.total_heap_size() >> 10));
+      metric.SetKey("jsHeap", std::move(js_heap));
+    }
+
+    auto renderer = result.renderers.find(sample.pid);
+    if (renderer != result.renderers.end()) {
+      for (const auto& item : renderer->second.DictItems())
+        metric.SetKey(item.first, item.second.Clone());
+    }
+
+    auto video_memory = result.video_memory.find(sample.pid);
+    if (video_memory != result.video_memory.end())
+      metric.SetInteger("gpuMemory", static_cast<int>(video_memory->second));
+
+    metrics.GetList().push_back(std::move(metric));
+  }
+  promise->Resolve(metrics);
+}
+
+mate::Dictionary TaskHistogramToDict(
+    v8::Isolate* isolate,
+    const TaskDurationMonitor::Histogram& histogram) {
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("count", histogram.count);
+  dict.Set("totalTime", histogram.total.InMillisecondsF());
+  dict.Set("maxTime", histogram.max.InMillisecondsF());
+  dict.Set("buckets", std::vector<uint64_t>(histogram.buckets.begin(),
+                                            histogram.buckets.end()));
+  return dict;
+}
+
 }  // namespace
 
 App::App(v8::Isolate* isolate) {
@@ -558,10 +634,23 @@ App::App(v8::Isolate* isolate) {
   content::GpuDataManager::GetInstance()->AddObserver(this);
 
   base::ProcessId pid = base::GetCurrentProcId();
-  auto process_metric = std::make_unique<atom::ProcessMetric>(
-      content::PROCESS_TYPE_BROWSER, pid,
-      base::ProcessMetrics::CreateCurrentProcessMetrics());
-  app_metrics_[pid] = std::move(process_metric);
+  app_metrics_[pid] =
+      std::make_unique<atom::ProcessMetric>(content::PROCESS_TYPE_BROWSER, pid);
+  metrics_sampler_.AddProcess(
+      pid, base::ProcessMetrics::CreateCurrentProcessMetrics());
+  memory_pressure_subscription_ =
+      MemoryPressureHub::Get()->RegisterTrimCallback(base::BindRepeating(
+          &App::OnMemoryPressure, base::Unretained(this)));
+  gpu_info_subscription_ =
+      GPUInfoManager::GetInstance()->AddCompleteInfoCallback(base::Bind(
+          &App::OnCompleteGPUInfo, base::Unretained(this)));
+#if !defined(OS_WIN)
+  // An instance relaunched with waitForExit set to false already holds the
+  // single instance lock of the instance it replaces.
+  process_singleton_ = ProcessSingleton::TakeOver(base::Bind(
+      NotificationCallbackWrapper,
+      base::Bind(&App::OnSecondInstance, base::Unretained(this))));
+#endif
   Init(isolate);
 }
 
@@ -571,6 +660,8 @@ App::~App() {
   Browser::Get()->RemoveObserver(this);
   content::GpuDataManager::GetInstance()->RemoveObserver(this);
   content::BrowserChildProcessObserver::Remove(this);
+  if (auto* monitor = TaskDurationMonitor::Get())
+    monitor->SetLongTaskCallback(TaskDurationMonitor::LongTaskCallback());
 }
 
 void App::OnBeforeQuit(bool* prevent_default) {
@@ -614,6 +705,10 @@ void App::OnActivate(bool has_visible_windows) {
 }
 
 void App::OnWillFinishLaunching() {
+  // An instance relaunched with waitForExit set to false opens no session
+  // until the instance it replaces has exited, sessions are only available
+  // once the app is ready.
+  relauncher::WaitForParallelParent();
   Emit("will-finish-launching");
 }
 
@@ -628,6 +723,7 @@ void App::OnFinishLaunching(const base::DictionaryValue& launch_info) {
 
 void App::OnPreMainMessageLoopRun() {
   content::BrowserChildProcessObserver::Add(this);
+  idle_task_scheduler_.Start();
   if (process_singleton_) {
     process_singleton_->OnBrowserReady();
   }
@@ -786,6 +882,12 @@ void App::OnGpuProcessCrashed(base::TerminationStatus status) {
        status == base::TERMINATION_STATUS_PROCESS_WAS_KILLED);
 }
 
+void App::OnCompleteGPUInfo(const base::Value& info) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  Emit("gpu-info-update", info);
+}
+
 void App::BrowserChildProcessLaunchedAndConnected(
     const content::ChildProcessData& data) {
   ChildProcessLaunched(data.process_type, data.handle);
@@ -828,12 +930,13 @@ void App::ChildProcessLaunched(int process_type, base::ProcessHandle handle) {
   std::unique_ptr<base::ProcessMetrics> metrics(
       base::ProcessMetrics::CreateProcessMetrics(handle));
 #endif
-  app_metrics_[pid] = std::make_unique<atom::ProcessMetric>(process_type, pid,
-                                                            std::move(metrics));
+  app_metrics_[pid] = std::make_unique<atom::ProcessMetric>(process_type, pid);
+  metrics_sampler_.AddProcess(pid, std::move(metrics));
 }
 
 void App::ChildProcessDisconnected(base::ProcessId pid) {
   app_metrics_.erase(pid);
+  metrics_sampler_.RemoveProcess(pid);
 }
 
 base::FilePath App::GetAppPath() const {
@@ -868,8 +971,16 @@ void App::SetPath(mate::Arguments* args,
   if (key >= 0)
     succeed =
         base::PathService::OverrideAndCreateIfNeeded(key, path, true, false);
-  if (!succeed)
+  if (!succeed) {
     args->ThrowError("Failed to set path");
+    return;
+  }
+
+  // Files extracted from asar archives are kept with other user data so they
+  // survive restarts.
+  if (key == DIR_USER_DATA)
+    asar::Archive::SetExtractionCacheDirectory(
+        path.Append(asar::Archive::kExtractionCacheDirectoryName));
 }
 
 void App::SetDesktopName(const std::string& desktop_name) {
@@ -968,6 +1079,7 @@ void App::ReleaseSingleInstanceLock() {
 bool App::Relaunch(mate::Arguments* js_args) {
   // Parse parameters.
   bool override_argv = false;
+  bool wait_for_exit = true;
   base::FilePath exec_path;
   relauncher::StringVector args;
 
@@ -975,27 +1087,61 @@ bool App::Relaunch(mate::Arguments* js_args) {
   if (js_args->GetNext(&options)) {
     if (options.Get("execPath", &exec_path) | options.Get("args", &args))
       override_argv = true;
+    options.Get("waitForExit", &wait_for_exit);
   }
 
+  relauncher::StringVector argv;
   if (!override_argv) {
-    const relauncher::StringVector& argv = atom::AtomCommandLine::argv();
-    return relauncher::RelaunchApp(argv);
+    argv = atom::AtomCommandLine::argv();
+  } else {
+    argv.reserve(1 + args.size());
+
+    if (exec_path.empty()) {
+      base::FilePath current_exe_path;
+      base::PathService::Get(base::FILE_EXE, &current_exe_path);
+      argv.push_back(current_exe_path.value());
+    } else {
+      argv.push_back(exec_path.value());
+    }
+
+    argv.insert(argv.end(), args.begin(), args.end());
   }
 
-  relauncher::StringVector argv;
-  argv.reserve(1 + args.size());
+  if (!wait_for_exit)
+    return RelaunchInParallel(argv);
+  return relauncher::RelaunchApp(argv);
+}
 
-  if (exec_path.empty()) {
-    base::FilePath current_exe_path;
-    base::PathService::Get(base::FILE_EXE, &current_exe_path);
-    argv.push_back(current_exe_path.value());
-  } else {
-    argv.push_back(exec_path.value());
-  }
+bool App::RelaunchInParallel(const base::CommandLine::StringVector& argv) {
+  base::LaunchOptions options;
+#if defined(OS_WIN)
+  // The lock can not be handed over on Windows, it is released before the new
+  // instance starts so that instance does not find this one.
+  bool had_lock = HasSingleInstanceLock();
+  ReleaseSingleInstanceLock();
+#else
+  if (process_singleton_)
+    process_singleton_->PrepareHandOver(&options);
+#endif
 
-  argv.insert(argv.end(), args.begin(), args.end());
+  base::Process process = relauncher::LaunchAppInParallel(argv, options);
+  if (!process.IsValid()) {
+    LOG(ERROR) << "Failed to relaunch the app";
+#if defined(OS_WIN)
+    // Nothing took the lock over, this instance keeps running as before.
+    if (had_lock)
+      RequestSingleInstanceLock();
+#endif
+    return false;
+  }
 
-  return relauncher::RelaunchApp(argv);
+#if !defined(OS_WIN)
+  if (process_singleton_) {
+    process_singleton_->HandOver(process.Pid());
+    process_singleton_.reset();
+  }
+#endif
+  return true;
 }
 
 void App::DisableHardwareAcceleration(mate::Arguments* args) {
@@ -1008,6 +1154,41 @@ void App::DisableHardwareAcceleration(mate::Arguments* args) {
   content::GpuDataManager::GetInstance()->DisableHardwareAcceleration();
 }
 
+void App::SetSpareRendererCount(mate::Arguments* args, int count) {
+  if (count < 0) {
+    args->ThrowError("The count of spare renderers can not be negative");
+    return;
+  }
+  AtomBrowserClient::Get()->spare_renderer_pool()->SetSize(count);
+}
+
+int App::GetSpareRendererCount() {
+  return AtomBrowserClient::Get()->spare_renderer_pool()->size();
+}
+
+void App::SetRendererProcessReusePolicy(mate::Arguments* args,
+                                        const mate::Dictionary& policy) {
+  auto* reuse_policy = AtomBrowserClient::Get()->renderer_reuse_policy();
+  bool share_processes = reuse_policy->share_processes();
+  int max_processes = reuse_policy->max_processes();
+  policy.Get("shareProcesses", &share_processes);
+  policy.Get("maxProcesses", &max_processes);
+  if (max_processes < 0) {
+    args->ThrowError("The maximum number of processes can not be negative");
+    return;
+  }
+  reuse_policy->SetShareProcesses(share_processes);
+  reuse_policy->SetMaxProcesses(max_processes);
+}
+
+v8::Local<v8::Value> App::GetRendererProcessReusePolicy(v8::Isolate* isolate) {
+  auto* reuse_policy = AtomBrowserClient::Get()->renderer_reuse_policy();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("shareProcesses", reuse_policy->share_processes());
+  dict.Set("maxProcesses", reuse_policy->max_processes());
+  return dict.GetHandle();
+}
+
 void App::DisableDomainBlockingFor3DAPIs(mate::Arguments* args) {
   if (Browser::Get()->is_ready()) {
     args->ThrowError(
@@ -1098,6 +1279,13 @@ JumpListResult App::SetJumpList(v8::Local<v8::Value> val,
     return JumpListResult::ARGUMENT_ERROR;
   }
 
+  // Rebuilding every shell link is slow, so don't commit a list that is
+  // already shown.
+  if (!delete_jump_list && committed_jump_list_ &&
+      *committed_jump_list_ == categories)
+    return JumpListResult::SUCCESS;
+  committed_jump_list_.reset();
+
   JumpList jump_list(Browser::Get()->GetAppUserModelID());
 
   if (delete_jump_list) {
@@ -1121,6 +1309,8 @@ JumpListResult App::SetJumpList(v8::Local<v8::Value> val,
       result = JumpListResult::GENERIC_ERROR;
   }
 
+  if (result == JumpListResult::SUCCESS)
+    committed_jump_list_.reset(new std::vector<JumpListCategory>(categories));
   return result;
 }
 #endif  // defined(OS_WIN)
@@ -1148,22 +1338,17 @@ void App::GetFileIcon(const base::FilePath& path, mate::Arguments* args) {
     return;
   }
 
-  auto* icon_manager = AtomBrowserMainParts::Get()->GetIconManager();
-  gfx::Image* icon =
-      icon_manager->LookupIconFromFilepath(normalized_path, icon_size);
-  if (icon) {
-    callback.Run(v8::Null(isolate()), *icon);
-  } else {
-    icon_manager->LoadIcon(
-        normalized_path, icon_size,
-        base::Bind(&OnIconDataAvailable, isolate(), callback),
-        &cancelable_task_tracker_);
-  }
+  file_icon_loader_.LoadIcon(
+      normalized_path, icon_size,
+      base::Bind(&OnIconDataAvailable, isolate(), callback));
 }
 
 std::vector<mate::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   std::vector<mate::Dictionary> result;
-  int processor_count = base::SysInfo::NumberOfProcessors();
+  // The CPU usage is sampled in the background, the processes that have not
+  // been sampled yet report none.
+  const ProcessMetricsSampler::SampleMap& samples =
+      metrics_sampler_.GetSamples();
 
   for (const auto& process_metric : app_metrics_) {
     mate::Dictionary pid_dict = mate::Dictionary::CreateEmpty(isolate);
@@ -1172,20 +1357,13 @@ std::vector<mate::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
     pid_dict.SetHidden("simple", true);
     cpu_dict.SetHidden("simple", true);
 
-    cpu_dict.Set(
-        "percentCPUUsage",
-        process_metric.second->metrics->GetPlatformIndependentCPUUsage() /
-            processor_count);
-
-#if !defined(OS_WIN)
-    cpu_dict.Set("idleWakeupsPerSecond",
-                 process_metric.second->metrics->GetIdleWakeupsPerSecond());
-#else
-    // Chrome's underlying process_metrics.cc will throw a non-fatal warning
-    // that this method isn't implemented on Windows, so set it to 0 instead
-    // of calling it
-    cpu_dict.Set("idleWakeupsPerSecond", 0);
-#endif
+    ProcessMetricsSampler::Sample sample;
+    auto it = samples.find(process_metric.first);
+    if (it != samples.end())
+      sample = it->second;
+    cpu_dict.Set("percentCPUUsage", sample.cpu_usage);
+    // The idle wakeups are not measured on Windows and stay 0.
+    cpu_dict.Set("idleWakeupsPerSecond", sample.idle_wakeups_per_second);
 
     pid_dict.Set("cpu", cpu_dict);
     pid_dict.Set("pid", process_metric.second->pid);
@@ -1197,6 +1375,177 @@ std::vector<mate::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   return result;
 }
 
+void App::SetAppMetricsInterval(mate::Arguments* args, double interval_ms) {
+  if (std::isnan(interval_ms)) {
+    args->ThrowError("The interval must be a number");
+    return;
+  }
+  metrics_sampler_.SetInterval(
+      base::TimeDelta::FromMillisecondsD(std::max(interval_ms, 10.0)));
+}
+
+v8::Local<v8::Promise> App::GetAppMemoryMetrics(v8::Isolate* isolate) {
+  scoped_refptr<util::Promise> promise = new util::Promise(isolate);
+
+  // The processes may be gone by the time the others have answered, so their
+  // counters are read right away.
+  std::vector<ProcessMemorySample> samples;
+  for (const auto& process_metric : app_metrics_) {
+    ProcessMemorySample sample;
+    sample.pid = process_metric.second->pid;
+    sample.type = process_metric.second->type;
+    sample.has_memory = GetProcessMemory(sample.pid, &sample.memory);
+    samples.push_back(sample);
+  }
+
+  MemoryMetricsRequest::Start(
+      base::BindOnce(&OnAppMemoryMetrics, promise, std::move(samples)));
+  return promise->GetHandle();
+}
+
+v8::Local<v8::Value> App::GetStartupTimeline(v8::Isolate* isolate) {
+  return mate::ConvertToV8(isolate,
+                           *StartupTimeline::GetInstance()->GetMarks());
+}
+
+v8::Local<v8::Value> App::GetMicrotaskCheckpointStats(v8::Isolate* isolate) {
+  MicrotasksRunner::Stats stats = MicrotasksRunner::GetStats();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("checkpoints", stats.checkpoints);
+  dict.Set("skipped", stats.skipped);
+  return dict.GetHandle();
+}
+
+v8::Local<v8::Value> App::GetMainThreadTaskStats(v8::Isolate* isolate) {
+  TaskDurationMonitor::Histogram tasks;
+  TaskDurationMonitor::Histogram uv_runs;
+  if (auto* monitor = TaskDurationMonitor::Get()) {
+    tasks = monitor->tasks();
+    uv_runs = monitor->uv_runs();
+  }
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("tasks", TaskHistogramToDict(isolate, tasks));
+  dict.Set("uvRuns", TaskHistogramToDict(isolate, uv_runs));
+  return dict.GetHandle();
+}
+
+void App::SetLongTaskThreshold(double threshold_ms) {
+  auto* monitor = TaskDurationMonitor::Get();
+  if (!monitor)
+    return;
+  monitor->SetLongTaskCallback(
+      base::BindRepeating(&App::OnLongTask, base::Unretained(this)));
+  monitor->SetLongTaskThreshold(
+      base::TimeDelta::FromMillisecondsD(std::max(threshold_ms, 0.0)));
+}
+
+void App::SetMainProcessHeapOptions(mate::Arguments* args,
+                                    const mate::Dictionary& options) {
+  if (Browser::Get()->is_ready()) {
+    args->ThrowError(
+        "app.setMainProcessHeapOptions() can only be called "
+        "before app is ready");
+    return;
+  }
+
+  double max_old_space_size = 0;
+  if (options.Get("maxOldSpaceSize", &max_old_space_size)) {
+    if (!(max_old_space_size > 0)) {
+      args->ThrowError("maxOldSpaceSize must be a positive number");
+      return;
+    }
+    double size = std::min(max_old_space_size * 1024 * 1024,
+                           static_cast<double>(
+                               std::numeric_limits<size_t>::max()));
+    AtomBrowserMainParts::Get()->js_env()->SetMaxOldGenerationSize(
+        static_cast<size_t>(size));
+  }
+
+  // V8 reads the flag whenever it considers starting a marking cycle, and
+  // flags only affect the isolates of this process.
+  bool incremental_marking = true;
+  if (options.Get("incrementalMarking", &incremental_marking)) {
+    std::string flag = incremental_marking ? "--incremental-marking"
+                                           : "--no-incremental-marking";
+    v8::V8::SetFlagsFromString(flag.c_str(), flag.size());
+  }
+}
+
+void App::NotifyMemoryPressure(mate::Arguments* args,
+                               const std::string& level) {
+  v8::MemoryPressureLevel pressure_level;
+  if (level == "none") {
+    pressure_level = v8::MemoryPressureLevel::kNone;
+  } else if (level == "moderate") {
+    pressure_level = v8::MemoryPressureLevel::kModerate;
+  } else if (level == "critical") {
+    pressure_level = v8::MemoryPressureLevel::kCritical;
+  } else {
+    args->ThrowError("Invalid memory pressure level: " + level);
+    return;
+  }
+  isolate()->MemoryPressureNotification(pressure_level);
+}
+
+void App::SimulateMemoryPressure(mate::Arguments* args,
+                                 const std::string& level) {
+  if (level == "moderate") {
+    MemoryPressureHub::Simulate(
+        base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  } else if (level == "critical") {
+    MemoryPressureHub::Simulate(
+        base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  } else {
+    args->ThrowError("Invalid memory pressure level: " + level);
+  }
+}
+
+void App::OnMemoryPressure(MemoryPressureHub::Level level) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  Emit("memory-pressure",
+       level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL
+           ? "critical"
+           : "moderate");
+}
+
+void App::OnLongTask(const TaskDurationMonitor::LongTask& long_task) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+
+  const base::Location& location = long_task.posted_from;
+  const char* function_name = location.function_name();
+  const char* file_name = location.file_name();
+  mate::Dictionary posted_from = mate::Dictionary::CreateEmpty(isolate());
+  posted_from.Set("functionName", function_name ? function_name : "");
+  posted_from.Set("fileName", file_name ? file_name : "");
+  posted_from.Set("lineNumber", location.line_number());
+
+  mate::Dictionary details = mate::Dictionary::CreateEmpty(isolate());
+  details.Set("duration", long_task.duration.InMillisecondsF());
+  details.Set("postedFrom", posted_from);
+  Emit("long-task", details);
+}
+
+int App::RequestIdleCallback(
+    const base::Callback<void(double, bool)>& callback,
+    double timeout_ms) {
+  return idle_task_scheduler_.PostIdleTask(
+      base::BindOnce(
+          [](const base::Callback<void(double, bool)>& callback,
+             base::TimeTicks deadline, bool did_timeout) {
+            base::TimeDelta remaining = deadline - base::TimeTicks::Now();
+            callback.Run(std::max(remaining.InMillisecondsF(), 0.0),
+                         did_timeout);
+          },
+          callback),
+      base::TimeDelta::FromMillisecondsD(std::max(timeout_ms, 0.0)));
+}
+
+void App::CancelIdleCallback(int id) {
+  idle_task_scheduler_.CancelIdleTask(id);
+}
+
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   auto status = content::GetFeatureStatus();
   base::DictionaryValue temp;
@@ -1369,10 +1718,28 @@ void App::BuildPrototype(v8::Isolate* isolate,
                  &App::SetAccessibilitySupportEnabled)
       .SetMethod("disableHardwareAcceleration",
                  &App::DisableHardwareAcceleration)
+      .SetMethod("setSpareRendererCount", &App::SetSpareRendererCount)
+      .SetMethod("getSpareRendererCount", &App::GetSpareRendererCount)
+      .SetMethod("setRendererProcessReusePolicy",
+                 &App::SetRendererProcessReusePolicy)
+      .SetMethod("getRendererProcessReusePolicy",
+                 &App::GetRendererProcessReusePolicy)
       .SetMethod("disableDomainBlockingFor3DAPIs",
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("setAppMetricsInterval", &App::SetAppMetricsInterval)
+      .SetMethod("getAppMemoryMetrics", &App::GetAppMemoryMetrics)
+      .SetMethod("getStartupTimeline", &App::GetStartupTimeline)
+      .SetMethod("getMicrotaskCheckpointStats",
+                 &App::GetMicrotaskCheckpointStats)
+      .SetMethod("getMainThreadTaskStats", &App::GetMainThreadTaskStats)
+      .SetMethod("setLongTaskThreshold", &App::SetLongTaskThreshold)
+      .SetMethod("setMainProcessHeapOptions", &App::SetMainProcessHeapOptions)
+      .SetMethod("notifyMemoryPressure", &App::NotifyMemoryPressure)
+      .SetMethod("simulateMemoryPressure", &App::SimulateMemoryPressure)
+      .SetMethod("requestIdleCallback", &App::RequestIdleCallback)
+      .SetMethod("cancelIdleCallback", &App::CancelIdleCallback)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
 #if defined(MAS_BUILD)
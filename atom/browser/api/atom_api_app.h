@@ -12,14 +12,19 @@
 #include <vector>
 
 #include "atom/browser/api/event_emitter.h"
+#include "atom/browser/api/gpuinfo_manager.h"
 #include "atom/browser/atom_browser_client.h"
 #include "atom/browser/browser.h"
 #include "atom/browser/browser_observer.h"
+#include "atom/browser/file_icon_loader.h"
+#include "atom/browser/idle_task_scheduler.h"
+#include "atom/browser/memory_pressure_hub.h"
+#include "atom/browser/process_metrics_sampler.h"
+#include "atom/browser/task_duration_monitor.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/promise_util.h"
 #include "base/process/process_iterator.h"
-#include "base/task/cancelable_task_tracker.h"
-#include "chrome/browser/icon_manager.h"
+#include "chrome/browser/icon_loader.h"
 #include "chrome/browser/process_singleton.h"
 #include "content/public/browser/browser_child_process_observer.h"
 #include "content/public/browser/gpu_data_manager_observer.h"
@@ -45,16 +50,14 @@ namespace atom {
 
 #if defined(OS_WIN)
 enum class JumpListResult : int;
+struct JumpListCategory;
 #endif
 
 struct ProcessMetric {
   int type;
   base::ProcessId pid;
-  std::unique_ptr<base::ProcessMetrics> metrics;
 
-  ProcessMetric(int type,
-                base::ProcessId pid,
-                std::unique_ptr<base::ProcessMetrics> metrics);
+  ProcessMetric(int type, base::ProcessId pid);
   ~ProcessMetric();
 };
 
@@ -170,6 +173,9 @@ class App : public AtomBrowserClient::Delegate,
       const content::ChildProcessTerminationInfo& info) override;
 
  private:
+  void OnLongTask(const TaskDurationMonitor::LongTask& long_task);
+  void OnMemoryPressure(MemoryPressureHub::Level level);
+  void OnCompleteGPUInfo(const base::Value& info);
   void SetAppPath(const base::FilePath& app_path);
   void ChildProcessLaunched(int process_type, base::ProcessHandle handle);
   void ChildProcessDisconnected(base::ProcessId pid);
@@ -189,8 +195,16 @@ class App : public AtomBrowserClient::Delegate,
   bool RequestSingleInstanceLock();
   void ReleaseSingleInstanceLock();
   bool Relaunch(mate::Arguments* args);
+  // Starts the new instance right away, handing the single instance lock over
+  // to it where the platform allows.
+  bool RelaunchInParallel(const base::CommandLine::StringVector& argv);
   void DisableHardwareAcceleration(mate::Arguments* args);
   void DisableDomainBlockingFor3DAPIs(mate::Arguments* args);
+  void SetSpareRendererCount(mate::Arguments* args, int count);
+  int GetSpareRendererCount();
+  void SetRendererProcessReusePolicy(mate::Arguments* args,
+                                     const mate::Dictionary& policy);
+  v8::Local<v8::Value> GetRendererProcessReusePolicy(v8::Isolate* isolate);
   bool IsAccessibilitySupportEnabled();
   void SetAccessibilitySupportEnabled(bool enabled);
   Browser::LoginItemSettings GetLoginItemSettings(mate::Arguments* args);
@@ -201,6 +215,20 @@ class App : public AtomBrowserClient::Delegate,
   void GetFileIcon(const base::FilePath& path, mate::Arguments* args);
 
   std::vector<mate::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  void SetAppMetricsInterval(mate::Arguments* args, double interval_ms);
+  v8::Local<v8::Promise> GetAppMemoryMetrics(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetStartupTimeline(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetMicrotaskCheckpointStats(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetMainThreadTaskStats(v8::Isolate* isolate);
+  void SetLongTaskThreshold(double threshold_ms);
+  void SetMainProcessHeapOptions(mate::Arguments* args,
+                                 const mate::Dictionary& options);
+  void NotifyMemoryPressure(mate::Arguments* args, const std::string& level);
+  void SimulateMemoryPressure(mate::Arguments* args, const std::string& level);
+  int RequestIdleCallback(
+      const base::Callback<void(double, bool)>& callback,
+      double timeout_ms);
+  void CancelIdleCallback(int id);
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
@@ -230,14 +258,27 @@ class App : public AtomBrowserClient::Delegate,
   std::unique_ptr<CertificateManagerModel> certificate_manager_model_;
 #endif
 
-  // Tracks tasks requesting file icons.
-  base::CancelableTaskTracker cancelable_task_tracker_;
+#if defined(OS_WIN)
+  // The categories of the last successfully committed Jump List.
+  std::unique_ptr<std::vector<JumpListCategory>> committed_jump_list_;
+#endif
+
+  FileIconLoader file_icon_loader_;
+
+  IdleTaskScheduler idle_task_scheduler_;
 
   base::FilePath app_path_;
 
   using ProcessMetricMap =
       std::unordered_map<base::ProcessId, std::unique_ptr<atom::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
+  // The CPU usage of the processes in |app_metrics_|.
+  ProcessMetricsSampler metrics_sampler_;
+
+  std::unique_ptr<MemoryPressureHub::Subscription>
+      memory_pressure_subscription_;
+  std::unique_ptr<GPUInfoManager::CompleteInfoCallbackList::Subscription>
+      gpu_info_subscription_;
 
   DISALLOW_COPY_AND_ASSIGN(App);
 };
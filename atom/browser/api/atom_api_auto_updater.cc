@@ -4,12 +4,19 @@
 
 #include "atom/browser/api/atom_api_auto_updater.h"
 
+#include <string>
+
 #include "atom/browser/browser.h"
+#include "atom/browser/delta_update.h"
 #include "atom/browser/native_window.h"
 #include "atom/browser/window_list.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/node_includes.h"
+#include "atom/common/promise_util.h"
+#include "base/bind.h"
+#include "base/task_scheduler/post_task.h"
 #include "base/time/time.h"
 #include "native_mate/dictionary.h"
 #include "native_mate/object_template_builder.h"
@@ -140,6 +147,37 @@ namespace {
 
 using atom::api::AutoUpdater;
 
+// Returns an empty string on success.
+std::string ApplyDeltaUpdateOnBlockingThread(const base::FilePath& base_dir,
+                                             const base::FilePath& delta_path,
+                                             const base::FilePath& output_dir) {
+  std::string error;
+  if (!atom::ApplyDeltaUpdate(base_dir, delta_path, output_dir, &error))
+    return error.empty() ? "Failed to apply the delta" : error;
+  return std::string();
+}
+
+void OnDeltaUpdateApplied(scoped_refptr<atom::util::Promise> promise,
+                          const std::string& error) {
+  if (error.empty())
+    promise->Resolve();
+  else
+    promise->RejectWithErrorMessage(error);
+}
+
+v8::Local<v8::Promise> ApplyDelta(v8::Isolate* isolate,
+                                  const base::FilePath& base_dir,
+                                  const base::FilePath& delta_path,
+                                  const base::FilePath& output_dir) {
+  scoped_refptr<atom::util::Promise> promise = new atom::util::Promise(isolate);
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BACKGROUND},
+      base::BindOnce(&ApplyDeltaUpdateOnBlockingThread, base_dir, delta_path,
+                     output_dir),
+      base::BindOnce(&OnDeltaUpdateApplied, promise));
+  return promise->GetHandle();
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -148,6 +186,7 @@ void Initialize(v8::Local<v8::Object> exports,
   mate::Dictionary dict(isolate, exports);
   dict.Set("autoUpdater", AutoUpdater::Create(isolate));
   dict.Set("AutoUpdater", AutoUpdater::GetConstructor(isolate)->GetFunction());
+  dict.SetMethod("applyDelta", &ApplyDelta);
 }
 
 }  // namespace
@@ -7,6 +7,7 @@
 #include "atom/browser/api/atom_api_web_contents.h"
 #include "atom/browser/browser.h"
 #include "atom/browser/native_browser_view.h"
+#include "atom/browser/native_window.h"
 #include "atom/common/color_util.h"
 #include "atom/common/native_mate_converters/gfx_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
@@ -117,6 +118,10 @@ void BrowserView::SetAutoResize(AutoResizeFlags flags) {
 
 void BrowserView::SetBounds(const gfx::Rect& bounds) {
   view_->SetBounds(bounds);
+  // The view may now cover the contents of its window, or stop covering them.
+  NativeWindow* window = api_web_contents_->owner_window();
+  if (window && window->browser_view() == view_.get())
+    window->NotifyWindowOcclusionChanged();
 }
 
 void BrowserView::SetBackgroundColor(const std::string& color_name) {
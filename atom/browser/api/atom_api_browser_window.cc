@@ -6,7 +6,9 @@
 
 #include <memory>
 
+#include "atom/browser/after_startup_task_utils.h"
 #include "atom/browser/browser.h"
+#include "atom/browser/native_browser_view.h"
 #include "atom/browser/unresponsive_suppressor.h"
 #include "atom/browser/web_contents_preferences.h"
 #include "atom/browser/window_list.h"
@@ -20,6 +22,7 @@
 #include "content/browser/renderer_host/render_widget_host_impl.h"
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
+#include "content/public/browser/visibility.h"
 #include "native_mate/dictionary.h"
 #include "ui/gl/gpu_switching_manager.h"
 
@@ -29,6 +32,19 @@ namespace atom {
 
 namespace api {
 
+namespace {
+
+// Only the visible contents get occluded, the hidden ones stay hidden.
+void SetContentsOccluded(content::WebContents* web_contents, bool occluded) {
+  content::Visibility visibility = web_contents->GetVisibility();
+  if (occluded && visibility == content::Visibility::VISIBLE)
+    web_contents->WasOccluded();
+  else if (!occluded && visibility == content::Visibility::OCCLUDED)
+    web_contents->WasShown();
+}
+
+}  // namespace
+
 BrowserWindow::BrowserWindow(v8::Isolate* isolate,
                              v8::Local<v8::Object> wrapper,
                              const mate::Dictionary& options)
@@ -133,6 +149,9 @@ void BrowserWindow::RenderViewCreated(
 }
 
 void BrowserWindow::DidFirstVisuallyNonEmptyPaint() {
+  // The first paint of any window completes the startup.
+  AfterStartupTaskUtils::SetBrowserStartupIsComplete();
+
   if (window()->IsVisible())
     return;
 
@@ -270,9 +289,14 @@ void BrowserWindow::OnWindowResize() {
   if (!draggable_regions_.empty())
     UpdateDraggableRegions(nullptr, draggable_regions_);
 #endif
+  UpdateOcclusion();
   TopLevelWindow::OnWindowResize();
 }
 
+void BrowserWindow::OnWindowOcclusionChanged() {
+  UpdateOcclusion();
+}
+
 void BrowserWindow::OnWindowLeaveFullScreen() {
   TopLevelWindow::OnWindowLeaveFullScreen();
 #if defined(OS_MACOSX)
@@ -303,10 +327,15 @@ void BrowserWindow::SetBackgroundColor(const std::string& color_name) {
 }
 
 void BrowserWindow::SetBrowserView(v8::Local<v8::Value> value) {
+  // The removed view no longer follows the occlusion of this window.
+  NativeBrowserView* old_view = window_->browser_view();
+  if (old_view && old_view->GetWebContents())
+    SetContentsOccluded(old_view->GetWebContents(), false);
   TopLevelWindow::SetBrowserView(value);
 #if defined(OS_MACOSX)
   UpdateDraggableRegions(nullptr, draggable_regions_);
 #endif
+  UpdateOcclusion();
 }
 
 void BrowserWindow::SetVibrancy(v8::Isolate* isolate,
@@ -348,13 +377,37 @@ v8::Local<v8::Value> BrowserWindow::GetWebContents(v8::Isolate* isolate) {
 std::unique_ptr<SkRegion> BrowserWindow::DraggableRegionsToSkRegion(
     const std::vector<DraggableRegion>& regions) {
   auto sk_region = std::make_unique<SkRegion>();
-  for (const DraggableRegion& region : regions) {
+  AddDraggableRegionsToSkRegion(regions, 0, sk_region.get());
+  return sk_region;
+}
+
+void BrowserWindow::AddDraggableRegionsToSkRegion(
+    const std::vector<DraggableRegion>& regions,
+    size_t first,
+    SkRegion* sk_region) {
+  for (size_t i = first; i < regions.size(); ++i) {
+    const DraggableRegion& region = regions[i];
     sk_region->op(
         region.bounds.x(), region.bounds.y(), region.bounds.right(),
         region.bounds.bottom(),
         region.draggable ? SkRegion::kUnion_Op : SkRegion::kDifference_Op);
   }
-  return sk_region;
+}
+
+void BrowserWindow::UpdateOcclusion() {
+  if (!window_->occlusion_tracking() || !web_contents())
+    return;
+
+  bool occluded = window_->is_occluded();
+  // A browser view that fills the window hides the page below it.
+  bool covered = false;
+  NativeBrowserView* browser_view = window_->browser_view();
+  if (browser_view) {
+    covered = browser_view->GetBounds().Contains(
+        gfx::Rect(window_->GetContentSize()));
+    SetContentsOccluded(browser_view->GetWebContents(), occluded);
+  }
+  SetContentsOccluded(web_contents(), occluded || covered);
 }
 
 void BrowserWindow::ScheduleUnresponsiveEvent(int ms) {
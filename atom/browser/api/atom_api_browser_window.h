@@ -61,6 +61,7 @@ class BrowserWindow : public TopLevelWindow,
   // NativeWindowObserver:
   void RequestPreferredWidth(int* width) override;
   void OnCloseButtonClicked(bool* prevent_default) override;
+  void OnWindowOcclusionChanged() override;
 
   // TopLevelWindow:
   void OnWindowClosed() override;
@@ -87,6 +88,10 @@ class BrowserWindow : public TopLevelWindow,
 
   // Helpers.
 
+  // Marks the contents of the window and of its browser view as occluded
+  // when they are covered, with the occlusionTracking option.
+  void UpdateOcclusion();
+
   // Called when the window needs to update its draggable region.
   void UpdateDraggableRegions(content::RenderFrameHost* rfh,
                               const std::vector<DraggableRegion>& regions);
@@ -95,6 +100,12 @@ class BrowserWindow : public TopLevelWindow,
   std::unique_ptr<SkRegion> DraggableRegionsToSkRegion(
       const std::vector<DraggableRegion>& regions);
 
+  // Applies the regions from |first| on to |sk_region|, in order.
+  void AddDraggableRegionsToSkRegion(
+      const std::vector<DraggableRegion>& regions,
+      size_t first,
+      SkRegion* sk_region);
+
   // Schedule a notification unresponsive event.
   void ScheduleUnresponsiveEvent(int ms);
 
@@ -108,9 +119,8 @@ class BrowserWindow : public TopLevelWindow,
   // it should be cancelled when we can prove that the window is responsive.
   base::CancelableClosure window_unresponsive_closure_;
 
-#if defined(OS_MACOSX)
+  // The regions that were last received from the page.
   std::vector<DraggableRegion> draggable_regions_;
-#endif
 
   v8::Global<v8::Value> web_contents_;
   api::WebContents* api_web_contents_;
@@ -4,6 +4,10 @@
 
 #include "atom/browser/api/atom_api_browser_window.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
 #include "atom/browser/native_window_views.h"
 
 namespace atom {
@@ -15,8 +19,24 @@ void BrowserWindow::UpdateDraggableRegions(
     const std::vector<DraggableRegion>& regions) {
   if (window_->has_frame())
     return;
-  static_cast<NativeWindowViews*>(window_.get())
-      ->UpdateDraggableRegions(DraggableRegionsToSkRegion(regions));
+
+  // The regions are applied in order, so when the page only appended regions
+  // they are added to the current region instead of building it again.
+  auto* window = static_cast<NativeWindowViews*>(window_.get());
+  const size_t previous = draggable_regions_.size();
+  std::unique_ptr<SkRegion> sk_region;
+  if (window->draggable_region() && regions.size() >= previous &&
+      std::equal(draggable_regions_.begin(), draggable_regions_.end(),
+                 regions.begin())) {
+    if (regions.size() == previous)
+      return;
+    sk_region = std::make_unique<SkRegion>(*window->draggable_region());
+    AddDraggableRegionsToSkRegion(regions, previous, sk_region.get());
+  } else {
+    sk_region = DraggableRegionsToSkRegion(regions);
+  }
+  draggable_regions_ = regions;
+  window->UpdateDraggableRegions(std::move(sk_region));
 }
 
 }  // namespace api
@@ -4,11 +4,15 @@
 
 #include <set>
 #include <string>
+#include <utility>
 
+#include "atom/common/cpu_profile.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/promise_util.h"
 #include "base/bind.h"
 #include "base/files/file_util.h"
+#include "base/task_scheduler/post_task.h"
 #include "content/public/browser/tracing_controller.h"
 #include "native_mate/dictionary.h"
 
@@ -58,6 +62,50 @@ void StopRecording(const base::FilePath& path,
       GetTraceDataEndpoint(path, callback));
 }
 
+// The default of V8, which is fine enough for latency spikes of the UI.
+const int kDefaultSamplingIntervalUs = 1000;
+
+bool StartCpuProfiling(mate::Arguments* args) {
+  int sampling_interval = kDefaultSamplingIntervalUs;
+  mate::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("samplingInterval", &sampling_interval);
+  if (sampling_interval <= 0) {
+    args->ThrowError("samplingInterval must be greater than 0");
+    return false;
+  }
+  return atom::StartCpuProfiling(args->isolate(), sampling_interval);
+}
+
+bool WriteCpuProfile(const base::FilePath& path, const std::string& json) {
+  int size = static_cast<int>(json.size());
+  return base::WriteFile(path, json.data(), size) == size;
+}
+
+void OnCpuProfileWritten(scoped_refptr<atom::util::Promise> promise,
+                         bool success) {
+  if (success)
+    promise->Resolve();
+  else
+    promise->RejectWithErrorMessage("Failed to write the CPU profile");
+}
+
+v8::Local<v8::Promise> StopCpuProfiling(v8::Isolate* isolate,
+                                        const base::FilePath& path) {
+  scoped_refptr<atom::util::Promise> promise = new atom::util::Promise(isolate);
+  std::string json;
+  if (!atom::StopCpuProfiling(isolate, &json)) {
+    promise->RejectWithErrorMessage("The CPU profiler is not running");
+    return promise->GetHandle();
+  }
+
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&WriteCpuProfile, path, std::move(json)),
+      base::BindOnce(&OnCpuProfileWritten, promise));
+  return promise->GetHandle();
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -72,6 +120,8 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod(
       "getTraceBufferUsage",
       base::Bind(&TracingController::GetTraceBufferUsage, controller));
+  dict.SetMethod("startCpuProfiling", &StartCpuProfiling);
+  dict.SetMethod("stopCpuProfiling", &StopCpuProfiling);
 }
 
 }  // namespace
@@ -4,14 +4,23 @@
 
 #include "atom/browser/api/atom_api_cookies.h"
 
+#include <algorithm>
 #include <memory>
+#include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/cookie_change_notifier.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "atom/common/promise_util.h"
+#include "base/barrier_closure.h"
+#include "base/optional.h"
+#include "base/stl_util.h"
+#include "base/strings/string_piece.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
@@ -89,44 +98,62 @@ namespace api {
 
 namespace {
 
-// Returns whether |domain| matches |filter|.
-bool MatchesDomain(std::string filter, const std::string& domain) {
-  // Add a leading '.' character to the filter domain if it doesn't exist.
-  if (net::cookie_util::DomainIsHostOnly(filter))
-    filter.insert(0, ".");
+// Removes the leading "." of |domain|, so "example.com" and ".example.com"
+// both match the subdomains.
+std::string NormalizeDomainFilter(std::string domain) {
+  if (!net::cookie_util::DomainIsHostOnly(domain))
+    domain.erase(0, 1);
+  return domain;
+}
 
-  std::string sub_domain(domain);
-  // Strip any leading '.' character from the input cookie domain.
-  if (!net::cookie_util::DomainIsHostOnly(sub_domain))
-    sub_domain = sub_domain.substr(1);
+// Returns whether |cookie_domain| is |domain| or one of its subdomains.
+bool MatchesDomain(base::StringPiece domain, base::StringPiece cookie_domain) {
+  if (!cookie_domain.empty() && cookie_domain[0] == '.')
+    cookie_domain.remove_prefix(1);
+  if (cookie_domain == domain)
+    return true;
+  return cookie_domain.size() > domain.size() &&
+         cookie_domain.ends_with(domain) &&
+         cookie_domain[cookie_domain.size() - domain.size() - 1] == '.';
+}
 
-  // Now check whether the domain argument is a subdomain of the filter domain.
-  for (sub_domain.insert(0, "."); sub_domain.length() >= filter.length();) {
-    if (sub_domain == filter)
-      return true;
-    const size_t next_dot = sub_domain.find('.', 1);  // Skip over leading dot.
-    sub_domain.erase(0, next_dot);
+// The filter of Cookies::Get, read once instead of for every cookie.
+struct CookieFilter {
+  explicit CookieFilter(const base::DictionaryValue& filter) {
+    std::string str;
+    bool b;
+    if (filter.GetString("name", &str))
+      name = str;
+    if (filter.GetString("path", &str))
+      path = str;
+    if (filter.GetString("domain", &str))
+      domain = NormalizeDomainFilter(str);
+    if (filter.GetBoolean("secure", &b))
+      secure = b;
+    if (filter.GetBoolean("session", &b))
+      session = b;
   }
-  return false;
-}
 
-// Returns whether |cookie| matches |filter|.
-bool MatchesCookie(const base::DictionaryValue* filter,
-                   const net::CanonicalCookie& cookie) {
-  std::string str;
-  bool b;
-  if (filter->GetString("name", &str) && str != cookie.Name())
-    return false;
-  if (filter->GetString("path", &str) && str != cookie.Path())
-    return false;
-  if (filter->GetString("domain", &str) && !MatchesDomain(str, cookie.Domain()))
-    return false;
-  if (filter->GetBoolean("secure", &b) && b != cookie.IsSecure())
-    return false;
-  if (filter->GetBoolean("session", &b) && b != !cookie.IsPersistent())
-    return false;
-  return true;
-}
+  bool Matches(const net::CanonicalCookie& cookie) const {
+    if (name && *name != cookie.Name())
+      return false;
+    if (path && *path != cookie.Path())
+      return false;
+    if (domain && !MatchesDomain(*domain, cookie.Domain()))
+      return false;
+    if (secure && *secure != cookie.IsSecure())
+      return false;
+    if (session && *session != !cookie.IsPersistent())
+      return false;
+    return true;
+  }
+
+  base::Optional<std::string> name;
+  base::Optional<std::string> path;
+  base::Optional<std::string> domain;
+  base::Optional<bool> secure;
+  base::Optional<bool> session;
+};
 
 // Helper to returns the CookieStore.
 inline net::CookieStore* GetCookieStore(
@@ -143,9 +170,10 @@ void RunCallbackInUI(const base::Closure& callback) {
 void FilterCookies(std::unique_ptr<base::DictionaryValue> filter,
                    const Cookies::GetCallback& callback,
                    const net::CookieList& list) {
+  const CookieFilter cookie_filter(*filter);
   net::CookieList result;
   for (const auto& cookie : list) {
-    if (MatchesCookie(filter.get(), cookie))
+    if (cookie_filter.Matches(cookie))
       result.push_back(cookie);
   }
   RunCallbackInUI(base::Bind(callback, Cookies::SUCCESS, result));
@@ -191,66 +219,153 @@ void FlushCookieStoreOnIOThread(
   GetCookieStore(getter)->FlushStore(base::BindOnce(RunCallbackInUI, callback));
 }
 
-// Sets cookie with |details| in IO thread.
-void SetCookieOnIO(scoped_refptr<net::URLRequestContextGetter> getter,
-                   std::unique_ptr<base::DictionaryValue> details,
-                   const Cookies::SetCallback& callback) {
+// Runs the callback of flushStore(), when there is one, and resolves its
+// promise.
+void OnCookieStoreFlushed(scoped_refptr<util::Promise> promise,
+                          const base::Closure& callback) {
+  if (!callback.is_null())
+    callback.Run();
+  v8::Isolate* isolate = promise->isolate();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise->GetHandle()->CreationContext());
+  promise->Resolve();
+}
+
+// Returns the cookie described by |details|, or null when it is not valid.
+std::unique_ptr<net::CanonicalCookie> CreateCookie(
+    const base::DictionaryValue& details) {
   std::string url, name, value, domain, path;
   bool secure = false;
   bool http_only = false;
   double creation_date;
   double expiration_date;
   double last_access_date;
-  details->GetString("url", &url);
-  details->GetString("name", &name);
-  details->GetString("value", &value);
-  details->GetString("domain", &domain);
-  details->GetString("path", &path);
-  details->GetBoolean("secure", &secure);
-  details->GetBoolean("httpOnly", &http_only);
+  details.GetString("url", &url);
+  details.GetString("name", &name);
+  details.GetString("value", &value);
+  details.GetString("domain", &domain);
+  details.GetString("path", &path);
+  details.GetBoolean("secure", &secure);
+  details.GetBoolean("httpOnly", &http_only);
 
   base::Time creation_time;
-  if (details->GetDouble("creationDate", &creation_date)) {
+  if (details.GetDouble("creationDate", &creation_date)) {
     creation_time = (creation_date == 0)
                         ? base::Time::UnixEpoch()
                         : base::Time::FromDoubleT(creation_date);
   }
 
   base::Time expiration_time;
-  if (details->GetDouble("expirationDate", &expiration_date)) {
+  if (details.GetDouble("expirationDate", &expiration_date)) {
     expiration_time = (expiration_date == 0)
                           ? base::Time::UnixEpoch()
                           : base::Time::FromDoubleT(expiration_date);
   }
 
   base::Time last_access_time;
-  if (details->GetDouble("lastAccessDate", &last_access_date)) {
+  if (details.GetDouble("lastAccessDate", &last_access_date)) {
     last_access_time = (last_access_date == 0)
                            ? base::Time::UnixEpoch()
                            : base::Time::FromDoubleT(last_access_date);
   }
 
+  if (url.empty() || name.empty())
+    return nullptr;
+
   std::unique_ptr<net::CanonicalCookie> canonical_cookie(
       net::CanonicalCookie::CreateSanitizedCookie(
           GURL(url), name, value, domain, path, creation_time, expiration_time,
           last_access_time, secure, http_only,
           net::CookieSameSite::DEFAULT_MODE, net::COOKIE_PRIORITY_DEFAULT));
-  auto completion_callback = base::BindOnce(OnSetCookie, callback);
-  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
-    std::move(completion_callback).Run(false);
+  if (!canonical_cookie || !canonical_cookie->IsCanonical())
+    return nullptr;
+  return canonical_cookie;
+}
+
+// Sets |cookie| in IO thread, or fails when it is null.
+void SetCanonicalCookie(scoped_refptr<net::URLRequestContextGetter> getter,
+                        std::unique_ptr<net::CanonicalCookie> cookie,
+                        net::CookieStore::SetCookiesCallback callback) {
+  if (!cookie) {
+    std::move(callback).Run(false);
     return;
   }
-  if (url.empty()) {
-    std::move(completion_callback).Run(false);
-    return;
+  bool secure = cookie->IsSecure();
+  bool http_only = cookie->IsHttpOnly();
+  GetCookieStore(getter)->SetCanonicalCookieAsync(
+      std::move(cookie), secure, http_only, std::move(callback));
+}
+
+// Sets cookie with |details| in IO thread.
+void SetCookieOnIO(scoped_refptr<net::URLRequestContextGetter> getter,
+                   std::unique_ptr<base::DictionaryValue> details,
+                   const Cookies::SetCallback& callback) {
+  SetCanonicalCookie(getter, CreateCookie(*details),
+                     base::BindOnce(OnSetCookie, callback));
+}
+
+// Counts the cookies of a batch that are set, and calls the callback of the
+// batch once with whether all of them were.
+class SetCookiesBatch : public base::RefCounted<SetCookiesBatch> {
+ public:
+  SetCookiesBatch(size_t count, const Cookies::SetCallback& callback)
+      : remaining_(count), callback_(callback) {}
+
+  void OnCookieSet(bool success) {
+    all_succeeded_ &= success;
+    DCHECK_GT(remaining_, 0u);
+    if (--remaining_ == 0)
+      OnSetCookie(callback_, all_succeeded_);
   }
-  if (name.empty()) {
-    std::move(completion_callback).Run(false);
+
+ private:
+  friend class base::RefCounted<SetCookiesBatch>;
+  ~SetCookiesBatch() = default;
+
+  size_t remaining_;
+  bool all_succeeded_ = true;
+  Cookies::SetCallback callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(SetCookiesBatch);
+};
+
+// Sets all the cookies of |list| in one trip to the IO thread.
+void SetCookiesOnIO(scoped_refptr<net::URLRequestContextGetter> getter,
+                    std::unique_ptr<base::ListValue> list,
+                    const Cookies::SetCallback& callback) {
+  if (list->empty()) {
+    OnSetCookie(callback, true);
     return;
   }
-  GetCookieStore(getter)->SetCanonicalCookieAsync(
-      std::move(canonical_cookie), secure, http_only,
-      std::move(completion_callback));
+
+  auto batch = base::MakeRefCounted<SetCookiesBatch>(list->GetSize(), callback);
+  for (const auto& details : list->GetList()) {
+    std::unique_ptr<net::CanonicalCookie> cookie;
+    const base::DictionaryValue* dict = nullptr;
+    if (details.GetAsDictionary(&dict))
+      cookie = CreateCookie(*dict);
+    SetCanonicalCookie(getter, std::move(cookie),
+                       base::BindOnce(&SetCookiesBatch::OnCookieSet, batch));
+  }
+}
+
+// Removes the cookies with the "url" and "name" of |list| in IO thread.
+void RemoveCookiesOnIO(scoped_refptr<net::URLRequestContextGetter> getter,
+                       std::unique_ptr<base::ListValue> list,
+                       const base::Closure& callback) {
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      list->GetSize(), base::BindOnce(RunCallbackInUI, callback));
+  for (const auto& details : list->GetList()) {
+    const base::DictionaryValue* dict = nullptr;
+    std::string url, name;
+    if (details.GetAsDictionary(&dict) && dict->GetString("url", &url) &&
+        dict->GetString("name", &name)) {
+      GetCookieStore(getter)->DeleteCookieAsync(GURL(url), name, barrier);
+    } else {
+      barrier.Run();
+    }
+  }
 }
 
 }  // namespace
@@ -297,16 +412,115 @@ void Cookies::Set(const base::DictionaryValue& details,
                      callback));
 }
 
-void Cookies::FlushStore(const base::Closure& callback) {
+void Cookies::SetBatch(const base::ListValue& list,
+                       const SetCallback& callback) {
+  auto copy =
+      base::ListValue::From(base::Value::ToUniquePtrValue(list.Clone()));
   auto* getter = browser_context_->GetRequestContext();
   content::BrowserThread::PostTask(
       BrowserThread::IO, FROM_HERE,
-      base::BindOnce(FlushCookieStoreOnIOThread, base::RetainedRef(getter),
+      base::BindOnce(SetCookiesOnIO, base::RetainedRef(getter), std::move(copy),
                      callback));
 }
 
+void Cookies::RemoveBatch(const base::ListValue& list,
+                          const base::Closure& callback) {
+  auto copy =
+      base::ListValue::From(base::Value::ToUniquePtrValue(list.Clone()));
+  auto* getter = browser_context_->GetRequestContext();
+  content::BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(RemoveCookiesOnIO, base::RetainedRef(getter),
+                     std::move(copy), callback));
+}
+
+v8::Local<v8::Promise> Cookies::FlushStore(mate::Arguments* args) {
+  scoped_refptr<util::Promise> promise = new util::Promise(args->isolate());
+  base::Closure callback;
+  args->GetNext(&callback);
+  auto* getter = browser_context_->GetRequestContext();
+  content::BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(FlushCookieStoreOnIOThread, base::RetainedRef(getter),
+                     base::Bind(&OnCookieStoreFlushed, promise, callback)));
+  return promise->GetHandle();
+}
+
+void Cookies::SetChangeBatching(mate::Arguments* args) {
+  // Anything queued under the previous options is sent first.
+  EmitChangeBatch();
+
+  mate::Dictionary options;
+  if (!args->GetNext(&options)) {
+    batch_changes_ = false;
+    return;
+  }
+
+  double interval = 16;
+  options.Get("interval", &interval);
+  std::vector<std::string> domains;
+  options.Get("domains", &domains);
+  std::vector<std::string> names;
+  options.Get("names", &names);
+
+  batch_changes_ = true;
+  batch_interval_ = base::TimeDelta::FromMillisecondsD(std::max(interval, 0.0));
+  batch_domains_.clear();
+  for (auto& domain : domains)
+    batch_domains_.push_back(NormalizeDomainFilter(std::move(domain)));
+  batch_names_ = std::set<std::string>(names.begin(), names.end());
+}
+
+bool Cookies::MatchesBatchFilter(const net::CanonicalCookie& cookie) const {
+  if (!batch_names_.empty() && !base::ContainsKey(batch_names_, cookie.Name()))
+    return false;
+  if (batch_domains_.empty())
+    return true;
+  for (const auto& domain : batch_domains_) {
+    if (MatchesDomain(domain, cookie.Domain()))
+      return true;
+  }
+  return false;
+}
+
+void Cookies::EmitChangeBatch() {
+  batch_timer_.Stop();
+  if (pending_changes_.empty())
+    return;
+
+  std::vector<Change> changes;
+  changes.swap(pending_changes_);
+
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  v8::Local<v8::Array> list = v8::Array::New(isolate(), changes.size());
+  for (size_t i = 0; i < changes.size(); ++i) {
+    mate::Dictionary change = mate::Dictionary::CreateEmpty(isolate());
+    change.Set("cookie", changes[i].cookie);
+    change.Set("cause", changes[i].cause);
+    change.Set("removed", changes[i].removed);
+    list->Set(static_cast<uint32_t>(i), change.GetHandle());
+  }
+  Emit("changed-batch", list);
+}
+
 void Cookies::OnCookieChanged(const CookieDetails* details) {
-  Emit("changed", *(details->cookie), details->cause, details->removed);
+  if (!batch_changes_) {
+    Emit("changed", *(details->cookie), details->cause, details->removed);
+    return;
+  }
+
+  // The cookies that don't match never reach JavaScript.
+  if (!MatchesBatchFilter(*details->cookie))
+    return;
+
+  pending_changes_.push_back(
+      {*details->cookie, details->cause, details->removed});
+  if (!batch_timer_.IsRunning()) {
+    batch_timer_.Start(FROM_HERE, batch_interval_,
+                       base::Bind(&Cookies::EmitChangeBatch,
+                                  base::Unretained(this)));
+  }
 }
 
 // static
@@ -323,7 +537,10 @@ void Cookies::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("get", &Cookies::Get)
       .SetMethod("remove", &Cookies::Remove)
       .SetMethod("set", &Cookies::Set)
-      .SetMethod("flushStore", &Cookies::FlushStore);
+      .SetMethod("setBatch", &Cookies::SetBatch)
+      .SetMethod("removeBatch", &Cookies::RemoveBatch)
+      .SetMethod("flushStore", &Cookies::FlushStore)
+      .SetMethod("setChangeBatching", &Cookies::SetChangeBatching);
 }
 
 }  // namespace api
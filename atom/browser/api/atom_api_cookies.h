@@ -6,16 +6,21 @@
 #define ATOM_BROWSER_API_ATOM_API_COOKIES_H_
 
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/net/cookie_details.h"
 #include "base/callback_list.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "native_mate/handle.h"
 #include "net/cookies/canonical_cookie.h"
 
 namespace base {
 class DictionaryValue;
+class ListValue;
 }
 
 namespace net {
@@ -54,14 +59,36 @@ class Cookies : public mate::TrackableObject<Cookies> {
               const std::string& name,
               const base::Closure& callback);
   void Set(const base::DictionaryValue& details, const SetCallback& callback);
-  void FlushStore(const base::Closure& callback);
+  void SetBatch(const base::ListValue& list, const SetCallback& callback);
+  void RemoveBatch(const base::ListValue& list, const base::Closure& callback);
+  v8::Local<v8::Promise> FlushStore(mate::Arguments* args);
+  void SetChangeBatching(mate::Arguments* args);
 
   // CookieChangeNotifier subscription:
   void OnCookieChanged(const CookieDetails*);
 
  private:
+  struct Change {
+    net::CanonicalCookie cookie;
+    network::mojom::CookieChangeCause cause;
+    bool removed;
+  };
+
+  bool MatchesBatchFilter(const net::CanonicalCookie& cookie) const;
+  void EmitChangeBatch();
+
   std::unique_ptr<base::CallbackList<void(const CookieDetails*)>::Subscription>
       cookie_change_subscription_;
+
+  // When |batch_changes_| is set the changes are queued in |pending_changes_|
+  // and emitted together by |batch_timer_|.
+  bool batch_changes_ = false;
+  base::TimeDelta batch_interval_;
+  std::vector<std::string> batch_domains_;
+  std::set<std::string> batch_names_;
+  std::vector<Change> pending_changes_;
+  base::OneShotTimer batch_timer_;
+
   scoped_refptr<AtomBrowserContext> browser_context_;
 
   DISALLOW_COPY_AND_ASSIGN(Cookies);
@@ -4,15 +4,18 @@
 
 #include "atom/browser/api/atom_api_desktop_capturer.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "atom/common/api/atom_api_native_image.h"
 #include "atom/common/native_mate_converters/gfx_converter.h"
+#include "base/bind.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/media/webrtc/desktop_media_list.h"
 #include "content/public/browser/desktop_capture.h"
 #include "native_mate/dictionary.h"
@@ -52,11 +55,18 @@ namespace atom {
 
 namespace api {
 
-DesktopCapturer::DesktopCapturer(v8::Isolate* isolate) {
+DesktopCapturer::DesktopCapturer(v8::Isolate* isolate)
+    : weak_ptr_factory_(this) {
   Init(isolate);
 }
 
-DesktopCapturer::~DesktopCapturer() {}
+DesktopCapturer::~DesktopCapturer() {
+  base::ScopedAllowBaseSyncPrimitivesForTesting
+      scoped_allow_base_sync_primitives;
+  window_capturer_.reset();
+  screen_capturer_.reset();
+  finishing_capturers_.clear();
+}
 
 void DesktopCapturer::StartHandling(bool capture_window,
                                     bool capture_screen,
@@ -78,6 +88,15 @@ void DesktopCapturer::StartHandling(bool capture_window,
   capture_window_ = capture_window;
   capture_screen_ = capture_screen;
 
+  // Without thumbnails the sources are reported as soon as they have been
+  // enumerated. The lists still capture the sources afterwards, so their
+  // frames are scaled down to a single pixel.
+  fetch_thumbnails_ = !thumbnail_size.IsEmpty();
+  gfx::Size capture_size = fetch_thumbnails_ ? thumbnail_size : gfx::Size(1, 1);
+
+  RetireCapturer(std::move(window_capturer_), window_capturer_idle_);
+  RetireCapturer(std::move(screen_capturer_), screen_capturer_idle_);
+
   {
     // Remove this once
     // https://bugs.chromium.org/p/chromium/issues/detail?id=795340 is fixed.
@@ -89,7 +108,8 @@ void DesktopCapturer::StartHandling(bool capture_window,
       window_capturer_.reset(new NativeDesktopMediaList(
           content::DesktopMediaID::TYPE_WINDOW,
           content::desktop_capture::CreateWindowCapturer()));
-      window_capturer_->SetThumbnailSize(thumbnail_size);
+      window_capturer_idle_ = false;
+      window_capturer_->SetThumbnailSize(capture_size);
       window_capturer_->AddObserver(this);
       window_capturer_->StartUpdating();
     }
@@ -98,14 +118,72 @@ void DesktopCapturer::StartHandling(bool capture_window,
       screen_capturer_.reset(new NativeDesktopMediaList(
           content::DesktopMediaID::TYPE_SCREEN,
           content::desktop_capture::CreateScreenCapturer()));
-      screen_capturer_->SetThumbnailSize(thumbnail_size);
+      screen_capturer_idle_ = false;
+      screen_capturer_->SetThumbnailSize(capture_size);
       screen_capturer_->AddObserver(this);
       screen_capturer_->StartUpdating();
     }
   }
 }
 
-void DesktopCapturer::OnSourceAdded(DesktopMediaList* list, int index) {}
+bool DesktopCapturer::IsCurrentCapturer(DesktopMediaList* list) const {
+  return list == window_capturer_.get() || list == screen_capturer_.get();
+}
+
+void DesktopCapturer::OnCapturerIdle(DesktopMediaList* list) {
+  if (list == window_capturer_.get()) {
+    window_capturer_idle_ = true;
+  } else if (list == screen_capturer_.get()) {
+    screen_capturer_idle_ = true;
+  } else {
+    // A list can not be destroyed while it notifies its observer.
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&DesktopCapturer::DestroyFinishingCapturer,
+                                  weak_ptr_factory_.GetWeakPtr(), list));
+  }
+}
+
+void DesktopCapturer::RetireCapturer(std::unique_ptr<DesktopMediaList> list,
+                                     bool idle) {
+  if (!list)
+    return;
+  if (!idle) {
+    finishing_capturers_.push_back(std::move(list));
+    return;
+  }
+  // The list joins its idle capture thread.
+  base::ScopedAllowBaseSyncPrimitivesForTesting
+      scoped_allow_base_sync_primitives;
+  list.reset();
+}
+
+void DesktopCapturer::DestroyFinishingCapturer(DesktopMediaList* list) {
+  auto it = std::find_if(
+      finishing_capturers_.begin(), finishing_capturers_.end(),
+      [list](const std::unique_ptr<DesktopMediaList>& finishing) {
+        return finishing.get() == list;
+      });
+  if (it == finishing_capturers_.end())
+    return;
+  base::ScopedAllowBaseSyncPrimitivesForTesting
+      scoped_allow_base_sync_primitives;
+  finishing_capturers_.erase(it);
+}
+
+void DesktopCapturer::OnSourcesListed(DesktopMediaList* list) {
+  if (IsCurrentCapturer(list))
+    UpdateSourcesList(list);
+}
+
+void DesktopCapturer::OnSourceAdded(DesktopMediaList* list, int index) {
+  if (fetch_thumbnails_ || !IsCurrentCapturer(list))
+    return;
+  // The sources are added in one go, so the list is complete once the
+  // current task is done.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&DesktopCapturer::OnSourcesListed,
+                                weak_ptr_factory_.GetWeakPtr(), list));
+}
 
 void DesktopCapturer::OnSourceRemoved(DesktopMediaList* list, int index) {}
 
@@ -116,18 +194,30 @@ void DesktopCapturer::OnSourceMoved(DesktopMediaList* list,
 void DesktopCapturer::OnSourceNameChanged(DesktopMediaList* list, int index) {}
 
 void DesktopCapturer::OnSourceThumbnailChanged(DesktopMediaList* list,
-                                               int index) {}
+                                               int index) {
+  if (!fetch_thumbnails_ || !IsCurrentCapturer(list))
+    return;
+  // Stream the thumbnails while the others are still being captured.
+  Emit("thumbnail", Source{list->GetSource(index), std::string()});
+}
 
 void DesktopCapturer::OnSourceUnchanged(DesktopMediaList* list) {
-  UpdateSourcesList(list);
+  // There are no sources, so no thumbnails are captured.
+  OnCapturerIdle(list);
+  OnSourcesListed(list);
 }
 
 bool DesktopCapturer::ShouldScheduleNextRefresh(DesktopMediaList* list) {
-  UpdateSourcesList(list);
+  OnCapturerIdle(list);
+  OnSourcesListed(list);
   return false;
 }
 
 void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
+  // Each list is reported once per request.
+  if (list == window_capturer_.get() ? !capture_window_ : !capture_screen_)
+    return;
+
   std::vector<DesktopCapturer::Source> window_sources;
   if (capture_window_ &&
       list->GetMediaListType() == content::DesktopMediaID::TYPE_WINDOW) {
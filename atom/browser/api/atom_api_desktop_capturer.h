@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "atom/browser/api/event_emitter.h"
+#include "base/memory/weak_ptr.h"
 #include "chrome/browser/media/webrtc/desktop_media_list_observer.h"
 #include "chrome/browser/media/webrtc/native_desktop_media_list.h"
 #include "native_mate/handle.h"
@@ -52,17 +53,32 @@ class DesktopCapturer : public mate::EventEmitter<DesktopCapturer>,
   bool ShouldScheduleNextRefresh(DesktopMediaList* list) override;
 
  private:
+  bool IsCurrentCapturer(DesktopMediaList* list) const;
+  // Called once |list| stopped capturing, which destroys the lists of earlier
+  // requests.
+  void OnCapturerIdle(DesktopMediaList* list);
+  void RetireCapturer(std::unique_ptr<DesktopMediaList> list, bool idle);
+  void DestroyFinishingCapturer(DesktopMediaList* list);
+  void OnSourcesListed(DesktopMediaList* list);
   void UpdateSourcesList(DesktopMediaList* list);
 
   std::unique_ptr<DesktopMediaList> window_capturer_;
   std::unique_ptr<DesktopMediaList> screen_capturer_;
+  bool window_capturer_idle_ = true;
+  bool screen_capturer_idle_ = true;
+  // The lists of earlier requests that are still capturing thumbnails. They
+  // are destroyed once done, instead of waiting for their capture thread.
+  std::vector<std::unique_ptr<DesktopMediaList>> finishing_capturers_;
   std::vector<DesktopCapturer::Source> captured_sources_;
   bool capture_window_ = false;
   bool capture_screen_ = false;
+  bool fetch_thumbnails_ = true;
 #if defined(OS_WIN)
   bool using_directx_capturer_ = false;
 #endif  // defined(OS_WIN)
 
+  base::WeakPtrFactory<DesktopCapturer> weak_ptr_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(DesktopCapturer);
 };
 
@@ -2,6 +2,7 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,12 +17,109 @@
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/image_converter.h"
 #include "atom/common/native_mate_converters/net_converter.h"
+#include "base/memory/ref_counted.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "native_mate/dictionary.h"
 
 #include "atom/common/node_includes.h"
 
 namespace {
 
+#if defined(MAS_BUILD)
+typedef base::Callback<void(bool result,
+                            v8::Local<v8::Value> paths,
+                            const std::vector<std::string>& bookmarkData)>
+    OpenDialogResultCallback;
+#else
+typedef base::Callback<void(bool result, v8::Local<v8::Value> paths)>
+    OpenDialogResultCallback;
+#endif
+
+// Number of paths converted in each task when passing open dialog results.
+const size_t kOpenDialogPathsPerTask = 1000;
+
+// Converts the paths chosen in an open dialog to a JS array over several
+// tasks, so that selecting a huge number of files does not block the main
+// loop while the result is handed to the callback.
+class OpenDialogResult : public base::RefCounted<OpenDialogResult> {
+ public:
+  OpenDialogResult(v8::Isolate* isolate,
+                   const OpenDialogResultCallback& callback)
+      : isolate_(isolate),
+        context_(isolate, isolate->GetCurrentContext()),
+        callback_(callback) {}
+
+#if defined(MAS_BUILD)
+  void OnDialogDone(bool result,
+                    const std::vector<base::FilePath>& paths,
+                    const std::vector<std::string>& bookmark_data) {
+    bookmark_data_ = bookmark_data;
+#else
+  void OnDialogDone(bool result, const std::vector<base::FilePath>& paths) {
+#endif
+    result_ = result;
+    if (result)
+      paths_ = paths;
+    {
+      v8::Locker locker(isolate_);
+      v8::HandleScope handle_scope(isolate_);
+      v8::Context::Scope context_scope(context_.Get(isolate_));
+      paths_array_.Reset(isolate_, v8::Array::New(isolate_, paths_.size()));
+    }
+    ConvertNextChunk();
+  }
+
+ private:
+  friend class base::RefCounted<OpenDialogResult>;
+
+  ~OpenDialogResult() {}
+
+  void ConvertNextChunk() {
+    v8::Locker locker(isolate_);
+    v8::HandleScope handle_scope(isolate_);
+    v8::Local<v8::Context> context = context_.Get(isolate_);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::Array> paths_array = paths_array_.Get(isolate_);
+
+    size_t end = std::min(next_index_ + kOpenDialogPathsPerTask, paths_.size());
+    for (; next_index_ < end; ++next_index_) {
+      paths_array
+          ->Set(context, static_cast<uint32_t>(next_index_),
+                mate::ConvertToV8(isolate_, paths_[next_index_]))
+          .ToChecked();
+    }
+
+    if (next_index_ < paths_.size()) {
+      base::ThreadTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::BindOnce(&OpenDialogResult::ConvertNextChunk,
+                                    scoped_refptr<OpenDialogResult>(this)));
+      return;
+    }
+
+#if defined(MAS_BUILD)
+    callback_.Run(result_, paths_array, bookmark_data_);
+#else
+    callback_.Run(result_, paths_array);
+#endif
+  }
+
+  v8::Isolate* isolate_;
+  v8::Global<v8::Context> context_;
+  OpenDialogResultCallback callback_;
+
+  bool result_ = false;
+  std::vector<base::FilePath> paths_;
+#if defined(MAS_BUILD)
+  std::vector<std::string> bookmark_data_;
+#endif
+
+  // The array being filled, and the index of the next path to convert.
+  v8::Global<v8::Array> paths_array_;
+  size_t next_index_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(OpenDialogResult);
+};
+
 void ShowMessageBox(int type,
                     const std::vector<std::string>& buttons,
                     int default_id,
@@ -54,10 +152,13 @@ void ShowMessageBox(int type,
 void ShowOpenDialog(const file_dialog::DialogSettings& settings,
                     mate::Arguments* args) {
   v8::Local<v8::Value> peek = args->PeekNext();
-  file_dialog::OpenDialogCallback callback;
-  if (mate::Converter<file_dialog::OpenDialogCallback>::FromV8(
-          args->isolate(), peek, &callback)) {
-    file_dialog::ShowOpenDialog(settings, callback);
+  OpenDialogResultCallback callback;
+  if (mate::Converter<OpenDialogResultCallback>::FromV8(args->isolate(), peek,
+                                                        &callback)) {
+    auto result =
+        base::MakeRefCounted<OpenDialogResult>(args->isolate(), callback);
+    file_dialog::ShowOpenDialog(
+        settings, base::Bind(&OpenDialogResult::OnDialogDone, result));
   } else {
     std::vector<base::FilePath> paths;
     if (file_dialog::ShowOpenDialog(settings, &paths))
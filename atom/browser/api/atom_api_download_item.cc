@@ -4,6 +4,7 @@
 
 #include "atom/browser/api/atom_api_download_item.h"
 
+#include <algorithm>
 #include <map>
 
 #include "atom/browser/atom_browser_main_parts.h"
@@ -20,6 +21,33 @@
 
 namespace mate {
 
+v8::Local<v8::Value> Converter<download::DownloadItem::ReceivedSlice>::ToV8(
+    v8::Isolate* isolate,
+    const download::DownloadItem::ReceivedSlice& slice) {
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("offset", slice.offset);
+  dict.Set("receivedBytes", slice.received_bytes);
+  dict.Set("finished", slice.finished);
+  return dict.GetHandle();
+}
+
+bool Converter<download::DownloadItem::ReceivedSlice>::FromV8(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> val,
+    download::DownloadItem::ReceivedSlice* out) {
+  mate::Dictionary dict;
+  int64_t offset = 0, received_bytes = 0;
+  bool finished = false;
+  if (!ConvertFromV8(isolate, val, &dict) || !dict.Get("offset", &offset) ||
+      !dict.Get("receivedBytes", &received_bytes) || offset < 0 ||
+      received_bytes < 0)
+    return false;
+  dict.Get("finished", &finished);
+  *out = download::DownloadItem::ReceivedSlice(offset, received_bytes,
+                                               finished);
+  return true;
+}
+
 template <>
 struct Converter<download::DownloadItem::DownloadState> {
   static v8::Local<v8::Value> ToV8(
@@ -79,15 +107,47 @@ DownloadItem::~DownloadItem() {
 
 void DownloadItem::OnDownloadUpdated(download::DownloadItem* item) {
   if (download_item_->IsDone()) {
+    update_timer_.Stop();
     Emit("done", item->GetState());
     // Destroy the item once item is downloaded.
     base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE,
                                                   GetDestroyClosure());
-  } else {
-    Emit("updated", item->GetState());
+  } else if (!ShouldSkipUpdate()) {
+    EmitUpdated();
   }
 }
 
+bool DownloadItem::ShouldSkipUpdate() {
+  if (update_interval_.is_zero() && update_bytes_ == 0)
+    return false;
+  if (download_item_->GetState() != last_update_state_ ||
+      download_item_->IsPaused() != last_update_paused_)
+    return false;
+  if (download_item_->GetReceivedBytes() - last_update_bytes_ < update_bytes_)
+    return true;
+
+  base::TimeDelta elapsed = base::TimeTicks::Now() - last_update_time_;
+  if (elapsed >= update_interval_)
+    return false;
+  // Make sure the latest progress is reported even if no other update
+  // follows.
+  if (!update_timer_.IsRunning()) {
+    update_timer_.Start(FROM_HERE, update_interval_ - elapsed,
+                        base::Bind(&DownloadItem::EmitUpdated,
+                                   base::Unretained(this)));
+  }
+  return true;
+}
+
+void DownloadItem::EmitUpdated() {
+  update_timer_.Stop();
+  last_update_time_ = base::TimeTicks::Now();
+  last_update_bytes_ = download_item_->GetReceivedBytes();
+  last_update_state_ = download_item_->GetState();
+  last_update_paused_ = download_item_->IsPaused();
+  Emit("updated", last_update_state_);
+}
+
 void DownloadItem::OnDownloadDestroyed(download::DownloadItem* download_item) {
   download_item_ = nullptr;
   // Destroy the native class immediately when downloadItem is destroyed.
@@ -187,6 +247,25 @@ double DownloadItem::GetStartTime() const {
   return download_item_->GetStartTime().ToDoubleT();
 }
 
+download::DownloadItem::ReceivedSlices DownloadItem::GetReceivedSlices()
+    const {
+  return download_item_->GetReceivedSlices();
+}
+
+void DownloadItem::SetUpdateThrottle(base::TimeDelta interval, int64_t bytes) {
+  update_interval_ = std::max(interval, base::TimeDelta());
+  update_bytes_ = std::max<int64_t>(bytes, 0);
+}
+
+void DownloadItem::SetUpdateThrottleFromOptions(
+    const mate::Dictionary& options) {
+  int interval = 0;
+  int64_t bytes = 0;
+  options.Get("interval", &interval);
+  options.Get("bytes", &bytes);
+  SetUpdateThrottle(base::TimeDelta::FromMilliseconds(interval), bytes);
+}
+
 // static
 void DownloadItem::BuildPrototype(v8::Isolate* isolate,
                                   v8::Local<v8::FunctionTemplate> prototype) {
@@ -214,7 +293,10 @@ void DownloadItem::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("getSaveDialogOptions", &DownloadItem::GetSaveDialogOptions)
       .SetMethod("getLastModifiedTime", &DownloadItem::GetLastModifiedTime)
       .SetMethod("getETag", &DownloadItem::GetETag)
-      .SetMethod("getStartTime", &DownloadItem::GetStartTime);
+      .SetMethod("getStartTime", &DownloadItem::GetStartTime)
+      .SetMethod("getReceivedSlices", &DownloadItem::GetReceivedSlices)
+      .SetMethod("setUpdateThrottle",
+                 &DownloadItem::SetUpdateThrottleFromOptions);
 }
 
 // static
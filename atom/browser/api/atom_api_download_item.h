@@ -11,7 +11,11 @@
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/ui/file_dialog.h"
 #include "base/files/file_path.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/download/public/common/download_item.h"
+#include "native_mate/converter.h"
+#include "native_mate/dictionary.h"
 #include "native_mate/handle.h"
 #include "url/gurl.h"
 
@@ -50,6 +54,12 @@ class DownloadItem : public mate::TrackableObject<DownloadItem>,
   std::string GetLastModifiedTime() const;
   std::string GetETag() const;
   double GetStartTime() const;
+  download::DownloadItem::ReceivedSlices GetReceivedSlices() const;
+
+  // Emits "updated" only once |interval| passed and |bytes| were received
+  // since the last one, unless the state changed. Zero disables a limit.
+  void SetUpdateThrottle(base::TimeDelta interval, int64_t bytes);
+  void SetUpdateThrottleFromOptions(const mate::Dictionary& options);
 
  protected:
   DownloadItem(v8::Isolate* isolate, download::DownloadItem* download_item);
@@ -60,10 +70,24 @@ class DownloadItem : public mate::TrackableObject<DownloadItem>,
   void OnDownloadDestroyed(download::DownloadItem* download) override;
 
  private:
+  // Whether the "updated" event for the current update should be skipped,
+  // schedules a later one when only |update_interval_| prevents it.
+  bool ShouldSkipUpdate();
+  void EmitUpdated();
+
   base::FilePath save_path_;
   file_dialog::DialogSettings dialog_options_;
   download::DownloadItem* download_item_;
 
+  base::TimeDelta update_interval_;
+  int64_t update_bytes_ = 0;
+  base::TimeTicks last_update_time_;
+  int64_t last_update_bytes_ = 0;
+  download::DownloadItem::DownloadState last_update_state_ =
+      download::DownloadItem::IN_PROGRESS;
+  bool last_update_paused_ = false;
+  base::OneShotTimer update_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(DownloadItem);
 };
 
@@ -71,4 +95,18 @@ class DownloadItem : public mate::TrackableObject<DownloadItem>,
 
 }  // namespace atom
 
+namespace mate {
+
+template <>
+struct Converter<download::DownloadItem::ReceivedSlice> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const download::DownloadItem::ReceivedSlice& slice);
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     download::DownloadItem::ReceivedSlice* out);
+};
+
+}  // namespace mate
+
 #endif  // ATOM_BROWSER_API_ATOM_API_DOWNLOAD_ITEM_H_
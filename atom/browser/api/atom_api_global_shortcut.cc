@@ -7,9 +7,15 @@
 #include <string>
 #include <vector>
 
+#include "atom/common/api/api_messages.h"
 #include "atom/common/native_mate_converters/accelerator_converter.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "atom/common/native_mate_converters/content_converter.h"
 #include "base/stl_util.h"
+#include "base/values.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
 #include "native_mate/dictionary.h"
 
 #include "atom/common/node_includes.h"
@@ -20,6 +26,33 @@ namespace atom {
 
 namespace api {
 
+// Delivers a pressed shortcut to a renderer as an IPC message on |channel_|,
+// without running JS in the main process. The shortcut is still dispatched
+// on the UI thread, so it waits while that thread is busy.
+class GlobalShortcut::WebContentsForwarder
+    : public content::WebContentsObserver {
+ public:
+  WebContentsForwarder(content::WebContents* web_contents,
+                       const std::string& channel)
+      : content::WebContentsObserver(web_contents), channel_(channel) {}
+
+  void Forward() {
+    if (!web_contents())
+      return;
+    auto* frame_host = web_contents()->GetMainFrame();
+    if (frame_host) {
+      frame_host->Send(new AtomFrameMsg_Message(frame_host->GetRoutingID(),
+                                                false, false, channel_,
+                                                base::ListValue(), 0));
+    }
+  }
+
+ private:
+  std::string channel_;
+
+  DISALLOW_COPY_AND_ASSIGN(WebContentsForwarder);
+};
+
 GlobalShortcut::GlobalShortcut(v8::Isolate* isolate) {
   Init(isolate);
 }
@@ -39,9 +72,35 @@ void GlobalShortcut::OnKeyPressed(const ui::Accelerator& accelerator) {
   accelerator_callback_map_[accelerator].Run();
 }
 
+// static
+bool GlobalShortcut::GetShortcutHandler(mate::Arguments* args,
+                                        base::Closure* callback) {
+  if (args->GetNext(callback))
+    return true;
+
+  mate::Dictionary target;
+  content::WebContents* web_contents = nullptr;
+  std::string channel;
+  if (!args->GetNext(&target) || !target.Get("webContents", &web_contents) ||
+      !web_contents || !target.Get("channel", &channel)) {
+    args->ThrowError(
+        "Expected a function or an object with webContents and channel");
+    return false;
+  }
+
+  *callback =
+      base::Bind(&WebContentsForwarder::Forward,
+                 base::Owned(new WebContentsForwarder(web_contents, channel)));
+  return true;
+}
+
 bool GlobalShortcut::RegisterAll(
     const std::vector<ui::Accelerator>& accelerators,
-    const base::Closure& callback) {
+    mate::Arguments* args) {
+  base::Closure callback;
+  if (!GetShortcutHandler(args, &callback))
+    return false;
+
   std::vector<ui::Accelerator> registered;
   for (auto& accelerator : accelerators) {
     GlobalShortcutListener* listener = GlobalShortcutListener::GetInstance();
@@ -58,7 +117,11 @@ bool GlobalShortcut::RegisterAll(
 }
 
 bool GlobalShortcut::Register(const ui::Accelerator& accelerator,
-                              const base::Closure& callback) {
+                              mate::Arguments* args) {
+  base::Closure callback;
+  if (!GetShortcutHandler(args, &callback))
+    return false;
+
   if (!GlobalShortcutListener::GetInstance()->RegisterAccelerator(accelerator,
                                                                   this)) {
     return false;
@@ -93,6 +156,14 @@ void GlobalShortcut::UnregisterAll() {
   GlobalShortcutListener::GetInstance()->UnregisterAccelerators(this);
 }
 
+void GlobalShortcut::UnregisterAccelerators(mate::Arguments* args) {
+  std::vector<ui::Accelerator> accelerators;
+  if (args->GetNext(&accelerators))
+    UnregisterSome(accelerators);
+  else
+    UnregisterAll();
+}
+
 // static
 mate::Handle<GlobalShortcut> GlobalShortcut::Create(v8::Isolate* isolate) {
   return mate::CreateHandle(isolate, new GlobalShortcut(isolate));
@@ -107,7 +178,7 @@ void GlobalShortcut::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("register", &GlobalShortcut::Register)
       .SetMethod("isRegistered", &GlobalShortcut::IsRegistered)
       .SetMethod("unregister", &GlobalShortcut::Unregister)
-      .SetMethod("unregisterAll", &GlobalShortcut::UnregisterAll);
+      .SetMethod("unregisterAll", &GlobalShortcut::UnregisterAccelerators);
 }
 
 }  // namespace api
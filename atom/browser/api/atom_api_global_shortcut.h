@@ -15,6 +15,10 @@
 #include "native_mate/handle.h"
 #include "ui/base/accelerators/accelerator.h"
 
+namespace mate {
+class Arguments;
+}
+
 namespace atom {
 
 namespace api {
@@ -34,14 +38,22 @@ class GlobalShortcut : public extensions::GlobalShortcutListener::Observer,
  private:
   typedef std::map<ui::Accelerator, base::Closure> AcceleratorCallbackMap;
 
+  class WebContentsForwarder;
+
+  // Reads the handler of a shortcut from |args|, which is either a function
+  // or a {webContents, channel} target.
+  static bool GetShortcutHandler(mate::Arguments* args,
+                                 base::Closure* callback);
+
   bool RegisterAll(const std::vector<ui::Accelerator>& accelerators,
-                   const base::Closure& callback);
-  bool Register(const ui::Accelerator& accelerator,
-                const base::Closure& callback);
+                   mate::Arguments* args);
+  bool Register(const ui::Accelerator& accelerator, mate::Arguments* args);
   bool IsRegistered(const ui::Accelerator& accelerator);
   void Unregister(const ui::Accelerator& accelerator);
   void UnregisterSome(const std::vector<ui::Accelerator>& accelerators);
   void UnregisterAll();
+  // Unregisters the given accelerators, or all of them when none are given.
+  void UnregisterAccelerators(mate::Arguments* args);
 
   // GlobalShortcutListener::Observer implementation.
   void OnKeyPressed(const ui::Accelerator& accelerator) override;
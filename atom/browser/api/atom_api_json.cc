@@ -0,0 +1,545 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/promise_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversion_utils.h"
+#include "base/task_scheduler/post_task.h"
+#include "native_mate/arguments.h"
+#include "native_mate/dictionary.h"
+
+#include "atom/common/node_includes.h"
+
+namespace {
+
+// The version of the wire format of v8::ValueSerializer that is written,
+// every later version of V8 still reads it.
+const uint32_t kWireFormatVersion = 13;
+
+// The nesting limit of base::JSONReader.
+const int kMaxDepth = 200;
+
+// The bytes of a varint holding any uint32_t.
+const size_t kFixedVarintSize = 5;
+
+// Parses JSON text straight into the wire format of v8::ValueSerializer, so
+// the main thread only has to deserialize it instead of parsing the JSON
+// again. The members of objects are written in the order of the text, which
+// is the order JSON.parse defines them in. Only the tags that V8 uses for
+// plain JSON data are needed.
+class JSONParser {
+ public:
+  explicit JSONParser(const std::string& json) : json_(json) {}
+
+  // Returns false and sets |error| when |json_| is not valid JSON.
+  bool Parse(std::vector<uint8_t>* data, std::string* error) {
+    WriteTag(0xFF);
+    WriteVarint(kWireFormatVersion);
+    // A byte order mark is skipped, like base::JSONReader does.
+    if (base::StartsWith(json_, "\xEF\xBB\xBF", base::CompareCase::SENSITIVE))
+      pos_ = 3;
+    SkipWhitespace();
+    bool success = ParseValue(0);
+    SkipWhitespace();
+    if (success && pos_ != json_.size())
+      success = Fail("Unexpected data after the root value.");
+    if (!success) {
+      *error = std::move(error_);
+      return false;
+    }
+    *data = std::move(buffer_);
+    return true;
+  }
+
+ private:
+  // The offsets of a member of an object in |buffer_|.
+  struct Member {
+    size_t name;
+    size_t name_end;
+    size_t value;
+    size_t end;
+  };
+
+  bool ParseValue(int depth) {
+    if (depth > kMaxDepth)
+      return Fail("Too much nesting.");
+    if (pos_ >= json_.size())
+      return Fail("Unexpected end of input.");
+    switch (json_[pos_]) {
+      case '{':
+        return ParseObject(depth + 1);
+      case '[':
+        return ParseArray(depth + 1);
+      case '"': {
+        base::string16 string;
+        if (!ParseString(&string))
+          return false;
+        WriteString(string);
+        return true;
+      }
+      case 't':
+        return ParseLiteral("true", 'T');
+      case 'f':
+        return ParseLiteral("false", 'F');
+      case 'n':
+        return ParseLiteral("null", '0');
+      default:
+        return ParseNumber();
+    }
+  }
+
+  bool ParseObject(int depth) {
+    ++pos_;
+    WriteTag('o');
+    std::vector<Member> members;
+    // The members by their written name.
+    std::unordered_map<std::string, size_t> names;
+    bool has_repeated_names = false;
+    SkipWhitespace();
+    if (Peek('}')) {
+      ++pos_;
+    } else {
+      while (true) {
+        base::string16 key;
+        if (!Peek('"'))
+          return Fail("Expected a property name.");
+        if (!ParseString(&key))
+          return false;
+        Member member;
+        member.name = buffer_.size();
+        WriteString(key);
+        member.name_end = member.value = buffer_.size();
+        SkipWhitespace();
+        if (!Peek(':'))
+          return Fail("Expected ':'.");
+        ++pos_;
+        SkipWhitespace();
+        if (!ParseValue(depth))
+          return false;
+        member.end = buffer_.size();
+
+        std::string name(buffer_.begin() + member.name,
+                         buffer_.begin() + member.value);
+        auto inserted = names.emplace(std::move(name), members.size());
+        if (inserted.second) {
+          members.push_back(member);
+        } else {
+          has_repeated_names = true;
+          members[inserted.first->second].value = member.value;
+          members[inserted.first->second].end = member.end;
+        }
+        SkipWhitespace();
+        if (Peek('}')) {
+          ++pos_;
+          break;
+        }
+        if (!Peek(','))
+          return Fail("Expected ',' or '}'.");
+        ++pos_;
+        SkipWhitespace();
+      }
+    }
+
+    // V8 does not read a name twice, while JSON.parse keeps the position of
+    // the first member and the value of the last one with the same name.
+    if (has_repeated_names) {
+      std::vector<uint8_t> unique;
+      for (const auto& member : members) {
+        unique.insert(unique.end(), buffer_.begin() + member.name,
+                      buffer_.begin() + member.name_end);
+        unique.insert(unique.end(), buffer_.begin() + member.value,
+                      buffer_.begin() + member.end);
+      }
+      buffer_.resize(members.front().name);
+      buffer_.insert(buffer_.end(), unique.begin(), unique.end());
+    }
+    WriteTag('{');
+    WriteVarint(members.size());
+    return true;
+  }
+
+  bool ParseArray(int depth) {
+    ++pos_;
+    WriteTag('A');
+    // The length is only known at the end of the array, so room is left for
+    // a varint of fixed size, which V8 reads like any other.
+    size_t length_offset = buffer_.size();
+    buffer_.resize(buffer_.size() + kFixedVarintSize);
+    uint32_t length = 0;
+    SkipWhitespace();
+    if (Peek(']')) {
+      ++pos_;
+    } else {
+      while (true) {
+        if (!ParseValue(depth))
+          return false;
+        ++length;
+        SkipWhitespace();
+        if (Peek(']')) {
+          ++pos_;
+          break;
+        }
+        if (!Peek(','))
+          return Fail("Expected ',' or ']'.");
+        ++pos_;
+        SkipWhitespace();
+      }
+    }
+    for (size_t i = 0; i < kFixedVarintSize; ++i) {
+      uint8_t byte = (length >> (7 * i)) & 0x7F;
+      if (i + 1 < kFixedVarintSize)
+        byte |= 0x80;
+      buffer_[length_offset + i] = byte;
+    }
+    WriteTag('$');
+    WriteVarint(0);
+    WriteVarint(length);
+    return true;
+  }
+
+  bool ParseString(base::string16* string) {
+    ++pos_;
+    while (true) {
+      if (pos_ >= json_.size())
+        return Fail("Unterminated string.");
+      unsigned char c = json_[pos_];
+      if (c == '"') {
+        ++pos_;
+        return true;
+      }
+      if (c < 0x20)
+        return Fail("Invalid character in string.");
+      if (c == '\\') {
+        if (!ParseEscape(string))
+          return false;
+      } else if (c < 0x80) {
+        string->push_back(c);
+        ++pos_;
+      } else {
+        // Invalid UTF-8 is replaced, like Buffer.toString() does.
+        int32_t index = 0;
+        uint32_t code_point;
+        if (!base::ReadUnicodeCharacter(
+                json_.data() + pos_,
+                std::min<size_t>(json_.size() - pos_, 4), &index, &code_point))
+          code_point = 0xFFFD;
+        base::WriteUnicodeCharacter(code_point, string);
+        pos_ += index + 1;
+      }
+    }
+  }
+
+  bool ParseEscape(base::string16* string) {
+    if (++pos_ >= json_.size())
+      return Fail("Unterminated string.");
+    char c = json_[pos_++];
+    switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        string->push_back(c);
+        return true;
+      case 'b':
+        string->push_back('\b');
+        return true;
+      case 'f':
+        string->push_back('\f');
+        return true;
+      case 'n':
+        string->push_back('\n');
+        return true;
+      case 'r':
+        string->push_back('\r');
+        return true;
+      case 't':
+        string->push_back('\t');
+        return true;
+      case 'u': {
+        if (json_.size() - pos_ < 4)
+          return Fail("Invalid escape sequence.");
+        base::char16 unit = 0;
+        for (size_t i = 0; i < 4; ++i) {
+          char digit = json_[pos_ + i];
+          if (!base::IsHexDigit(digit))
+            return Fail("Invalid escape sequence.");
+          unit = unit * 16 + base::HexDigitToInt(digit);
+        }
+        // Lone surrogates are kept, as JSON.parse does.
+        string->push_back(unit);
+        pos_ += 4;
+        return true;
+      }
+      default:
+        --pos_;
+        return Fail("Invalid escape sequence.");
+    }
+  }
+
+  bool ParseNumber() {
+    size_t start = pos_;
+    bool is_integer = true;
+    if (Peek('-'))
+      ++pos_;
+    if (Peek('0')) {
+      ++pos_;
+    } else if (PeekDigit()) {
+      SkipDigits();
+    } else {
+      return Fail("Unexpected token.");
+    }
+    if (Peek('.')) {
+      is_integer = false;
+      ++pos_;
+      if (!PeekDigit())
+        return Fail("Invalid number.");
+      SkipDigits();
+    }
+    if (Peek('e') || Peek('E')) {
+      is_integer = false;
+      ++pos_;
+      if (Peek('+') || Peek('-'))
+        ++pos_;
+      if (!PeekDigit())
+        return Fail("Invalid number.");
+      SkipDigits();
+    }
+
+    std::string text = json_.substr(start, pos_ - start);
+    int integer;
+    // -0 is a double to V8.
+    if (is_integer && text != "-0" && base::StringToInt(text, &integer)) {
+      // ZigZag encoding of a signed 32-bit integer.
+      WriteTag('I');
+      WriteVarint((static_cast<uint32_t>(integer) << 1) ^
+                  static_cast<uint32_t>(integer >> 31));
+      return true;
+    }
+    double number;
+    if (!base::StringToDouble(text, &number))
+      return Fail("Invalid number.");
+    WriteTag('N');
+    WriteRawBytes(&number, sizeof(number));
+    return true;
+  }
+
+  bool ParseLiteral(base::StringPiece literal, uint8_t tag) {
+    if (base::StringPiece(json_).substr(pos_, literal.size()) != literal)
+      return Fail("Unexpected token.");
+    pos_ += literal.size();
+    WriteTag(tag);
+    return true;
+  }
+
+  bool Peek(char c) const { return pos_ < json_.size() && json_[pos_] == c; }
+
+  bool PeekDigit() const {
+    return pos_ < json_.size() && base::IsAsciiDigit(json_[pos_]);
+  }
+
+  void SkipDigits() {
+    while (PeekDigit())
+      ++pos_;
+  }
+
+  void SkipWhitespace() {
+    while (pos_ < json_.size() && (json_[pos_] == ' ' || json_[pos_] == '\n' ||
+                                   json_[pos_] == '\r' || json_[pos_] == '\t'))
+      ++pos_;
+  }
+
+  // Sets the error with the position of the parser, in the format of
+  // base::JSONReader.
+  bool Fail(const char* message) {
+    int line = 1;
+    int column = 1;
+    for (size_t i = 0; i < pos_ && i < json_.size(); ++i) {
+      if (json_[i] == '\n') {
+        ++line;
+        column = 1;
+      } else {
+        ++column;
+      }
+    }
+    error_ = base::StringPrintf("Line: %d, column: %d, %s", line, column,
+                                message);
+    return false;
+  }
+
+  void WriteString(const base::string16& string) {
+    // One-byte strings hold Latin-1.
+    bool one_byte = std::all_of(string.begin(), string.end(),
+                                [](base::char16 c) { return c < 0x100; });
+    if (one_byte) {
+      WriteTag('"');
+      WriteVarint(string.size());
+      for (base::char16 c : string)
+        buffer_.push_back(static_cast<uint8_t>(c));
+    } else {
+      WriteTag('c');
+      WriteVarint(string.size() * sizeof(base::char16));
+      WriteRawBytes(string.data(), string.size() * sizeof(base::char16));
+    }
+  }
+
+  void WriteTag(uint8_t tag) { buffer_.push_back(tag); }
+
+  void WriteVarint(uint64_t value) {
+    do {
+      uint8_t byte = value & 0x7F;
+      value >>= 7;
+      buffer_.push_back(value ? byte | 0x80 : byte);
+    } while (value);
+  }
+
+  void WriteRawBytes(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+  }
+
+  const std::string& json_;
+  size_t pos_ = 0;
+  std::string error_;
+  std::vector<uint8_t> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(JSONParser);
+};
+
+struct ParseResult {
+  std::vector<uint8_t> data;
+  std::string error;
+};
+
+ParseResult ParseJSON(const std::string& json) {
+  ParseResult result;
+  JSONParser(json).Parse(&result.data, &result.error);
+  return result;
+}
+
+void ResolveWithParsedValue(scoped_refptr<atom::util::Promise> promise,
+                            ParseResult result) {
+  v8::Isolate* isolate = promise->isolate();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = promise->GetHandle()->CreationContext();
+  v8::Context::Scope context_scope(context);
+
+  if (!result.error.empty()) {
+    promise->RejectWithErrorMessage(result.error);
+    return;
+  }
+
+  v8::TryCatch try_catch(isolate);
+  v8::ValueDeserializer deserializer(isolate, result.data.data(),
+                                     result.data.size());
+  v8::Local<v8::Value> value;
+  if (!deserializer.ReadHeader(context).FromMaybe(false) ||
+      !deserializer.ReadValue(context).ToLocal(&value)) {
+    promise->RejectWithErrorMessage("Failed to deserialize the parsed JSON");
+    return;
+  }
+  promise->Resolve(value);
+}
+
+bool WriteJSONFile(const base::FilePath& path, const std::string& json) {
+  return base::ImportantFileWriter::WriteFileAtomically(path, json);
+}
+
+void ResolveWithWriteResult(scoped_refptr<atom::util::Promise> promise,
+                            bool success) {
+  v8::Isolate* isolate = promise->isolate();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise->GetHandle()->CreationContext());
+  if (success)
+    promise->Resolve();
+  else
+    promise->RejectWithErrorMessage("Failed to write the JSON file");
+}
+
+v8::Local<v8::Value> Parse(mate::Arguments* args) {
+  scoped_refptr<atom::util::Promise> promise =
+      new atom::util::Promise(args->isolate());
+
+  v8::Local<v8::Value> input;
+  std::string json;
+  if (args->GetNext(&input) && node::Buffer::HasInstance(input)) {
+    json.assign(node::Buffer::Data(input), node::Buffer::Length(input));
+  } else if (input.IsEmpty() || !input->IsString() ||
+             !mate::ConvertFromV8(args->isolate(), input, &json)) {
+    promise->RejectWithErrorMessage("Must pass a string or a Buffer");
+    return promise->GetHandle();
+  }
+
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&ParseJSON, std::move(json)),
+      base::BindOnce(&ResolveWithParsedValue, promise));
+  return promise->GetHandle();
+}
+
+v8::Local<v8::Value> StringifyToFile(mate::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  scoped_refptr<atom::util::Promise> promise =
+      new atom::util::Promise(isolate);
+
+  v8::Local<v8::Value> value;
+  base::FilePath path;
+  if (!args->GetNext(&value) || !args->GetNext(&path) || path.empty()) {
+    promise->RejectWithErrorMessage("Must pass a value and a file path");
+    return promise->GetHandle();
+  }
+
+  // V8 generates the text as JSON.stringify does, which keeps the order of
+  // the properties and calls toJSON, only the file I/O is moved to the thread
+  // pool.
+  v8::TryCatch try_catch(isolate);
+  v8::Local<v8::String> json;
+  if (!v8::JSON::Stringify(isolate->GetCurrentContext(), value)
+           .ToLocal(&json)) {
+    promise->Reject(try_catch.Exception());
+    return promise->GetHandle();
+  }
+  std::string text;
+  mate::ConvertFromV8(isolate, json, &text);
+  // The values JSON.stringify returns undefined for come back as the string
+  // "undefined", which is never valid JSON text.
+  if (text == "undefined") {
+    promise->RejectWithErrorMessage("The value can not be written as JSON");
+    return promise->GetHandle();
+  }
+
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::BLOCK_SHUTDOWN},
+      base::BindOnce(&WriteJSONFile, path, std::move(text)),
+      base::BindOnce(&ResolveWithWriteResult, promise));
+  return promise->GetHandle();
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  mate::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("parse", &Parse);
+  dict.SetMethod("stringifyToFile", &StringifyToFile);
+}
+
+}  // namespace
+
+NODE_BUILTIN_MODULE_CONTEXT_AWARE(atom_browser_json, Initialize)
@@ -9,6 +9,7 @@
 #include "atom/browser/atom_browser_context.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/native_mate_converters/value_converter.h"
 #include "base/command_line.h"
 #include "chrome/browser/browser_process.h"
 #include "components/net_log/chrome_net_log.h"
@@ -19,10 +20,68 @@
 
 #include "atom/common/node_includes.h"
 
+namespace mate {
+
+template <>
+struct Converter<net::NetLogCaptureMode> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     net::NetLogCaptureMode* out) {
+    std::string mode;
+    if (!ConvertFromV8(isolate, val, &mode))
+      return false;
+    if (mode == "default")
+      *out = net::NetLogCaptureMode::Default();
+    else if (mode == "includeCookiesAndCredentials")
+      *out = net::NetLogCaptureMode::IncludeCookiesAndCredentials();
+    else if (mode == "includeSocketBytes")
+      *out = net::NetLogCaptureMode::IncludeSocketBytes();
+    else
+      return false;
+    return true;
+  }
+};
+
+}  // namespace mate
+
 namespace atom {
 
 namespace api {
 
+namespace {
+
+// The default size of the ring buffer of startCapture.
+const int kDefaultCaptureSize = 10 * 1024 * 1024;
+
+// How often the events of startStreaming are emitted by default.
+const int kDefaultStreamingInterval = 1000;
+
+// Reads the options that the logging, the capture and the streaming share.
+bool GetCaptureMode(mate::Arguments* args,
+                    const mate::Dictionary& options,
+                    net::NetLogCaptureMode* mode) {
+  *mode = net::NetLogCaptureMode::Default();
+  v8::Local<v8::Value> value;
+  if (options.IsEmpty() || !options.Get("captureMode", &value) ||
+      value->IsUndefined())
+    return true;
+  if (!mate::ConvertFromV8(args->isolate(), value, mode)) {
+    args->ThrowError(
+        "captureMode must be 'default', 'includeCookiesAndCredentials' or "
+        "'includeSocketBytes'");
+    return false;
+  }
+  return true;
+}
+
+void OnCaptureDumped(const base::Callback<void(bool)>& callback,
+                     bool success) {
+  if (!callback.is_null())
+    callback.Run(success);
+}
+
+}  // namespace
+
 NetLog::NetLog(v8::Isolate* isolate, AtomBrowserContext* browser_context)
     : browser_context_(browser_context) {
   Init(isolate);
@@ -42,15 +101,27 @@ void NetLog::StartLogging(mate::Arguments* args) {
     return;
   }
 
+  mate::Dictionary options;
+  args->GetNext(&options);
+  net::NetLogCaptureMode capture_mode;
+  if (!GetCaptureMode(args, options, &capture_mode))
+    return;
+  uint64_t max_file_size = net_log::NetExportFileWriter::kNoLimit;
+  int64_t size = 0;
+  if (!options.IsEmpty() && options.Get("maxFileSize", &size)) {
+    if (size <= 0) {
+      args->ThrowError("maxFileSize must be positive");
+      return;
+    }
+    max_file_size = static_cast<uint64_t>(size);
+  }
+
   auto* network_context =
       content::BrowserContext::GetDefaultStoragePartition(browser_context_)
           ->GetNetworkContext();
 
-  // TODO(deepak1556): Provide more flexibility to this module
-  // by allowing customizations on the capturing options.
   net_log_writer_->StartNetLog(
-      log_path, net::NetLogCaptureMode::Default(),
-      net_log::NetExportFileWriter::kNoLimit /* file size limit */,
+      log_path, capture_mode, max_file_size,
       base::CommandLine::ForCurrentProcess()->GetCommandLineString(),
       std::string(), network_context);
 }
@@ -100,6 +171,75 @@ void NetLog::StopLogging(mate::Arguments* args) {
   }
 }
 
+void NetLog::StartCapture(mate::Arguments* args) {
+  mate::Dictionary options;
+  args->GetNext(&options);
+  net::NetLogCaptureMode capture_mode;
+  if (!GetCaptureMode(args, options, &capture_mode))
+    return;
+  int max_size = kDefaultCaptureSize;
+  if (!options.IsEmpty() && options.Get("maxSize", &max_size) &&
+      max_size <= 0) {
+    args->ThrowError("maxSize must be positive");
+    return;
+  }
+
+  ring_buffer_ = std::make_unique<RingBufferNetLogObserver>(max_size);
+  ring_buffer_->StartObserving(g_browser_process->net_log(), capture_mode);
+}
+
+void NetLog::DumpCapture(mate::Arguments* args) {
+  base::FilePath path;
+  if (!args->GetNext(&path) || path.empty()) {
+    args->ThrowError("The first parameter must be a valid string");
+    return;
+  }
+  base::Callback<void(bool)> callback;
+  args->GetNext(&callback);
+
+  if (!ring_buffer_) {
+    args->ThrowError("No capture is running");
+    return;
+  }
+  ring_buffer_->Dump(path, base::BindOnce(&OnCaptureDumped, callback));
+}
+
+void NetLog::StopCapture() {
+  ring_buffer_.reset();
+}
+
+bool NetLog::IsCapturing() const {
+  return !!ring_buffer_;
+}
+
+void NetLog::StartStreaming(mate::Arguments* args) {
+  mate::Dictionary options;
+  if (args->Length() > 1)
+    args->GetNext(&options);
+  StreamingNetLogObserver::EventsCallback callback;
+  if (!args->GetNext(&callback)) {
+    args->ThrowError("Must pass a callback");
+    return;
+  }
+  net::NetLogCaptureMode capture_mode;
+  if (!GetCaptureMode(args, options, &capture_mode))
+    return;
+  int interval = kDefaultStreamingInterval;
+  if (!options.IsEmpty() && options.Get("interval", &interval) &&
+      interval <= 0) {
+    args->ThrowError("interval must be positive");
+    return;
+  }
+
+  streaming_ = std::make_unique<StreamingNetLogObserver>(
+      callback, base::TimeDelta::FromMilliseconds(interval));
+  streaming_->StartObserving(g_browser_process->net_log(), capture_mode);
+}
+
+void NetLog::StopStreaming() {
+  streaming_.reset();
+}
+
 void NetLog::OnNewState(const base::DictionaryValue& state) {
   net_log_state_ = state.CreateDeepCopy();
 
@@ -129,7 +269,13 @@ void NetLog::BuildPrototype(v8::Isolate* isolate,
       .SetProperty("currentlyLogging", &NetLog::IsCurrentlyLogging)
       .SetProperty("currentlyLoggingPath", &NetLog::GetCurrentlyLoggingPath)
       .SetMethod("startLogging", &NetLog::StartLogging)
-      .SetMethod("stopLogging", &NetLog::StopLogging);
+      .SetMethod("stopLogging", &NetLog::StopLogging)
+      .SetProperty("currentlyCapturing", &NetLog::IsCapturing)
+      .SetMethod("startCapture", &NetLog::StartCapture)
+      .SetMethod("dumpCapture", &NetLog::DumpCapture)
+      .SetMethod("stopCapture", &NetLog::StopCapture)
+      .SetMethod("startStreaming", &NetLog::StartStreaming)
+      .SetMethod("stopStreaming", &NetLog::StopStreaming);
 }
 
 }  // namespace api
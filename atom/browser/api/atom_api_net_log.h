@@ -10,6 +10,8 @@
 #include <string>
 
 #include "atom/browser/api/trackable_object.h"
+#include "atom/browser/net/ring_buffer_net_log_observer.h"
+#include "atom/browser/net/streaming_net_log_observer.h"
 #include "base/callback.h"
 #include "base/values.h"
 #include "components/net_log/net_export_file_writer.h"
@@ -35,6 +37,12 @@ class NetLog : public mate::TrackableObject<NetLog>,
   bool IsCurrentlyLogging() const;
   std::string GetCurrentlyLoggingPath() const;
   void StopLogging(mate::Arguments* args);
+  void StartCapture(mate::Arguments* args);
+  void DumpCapture(mate::Arguments* args);
+  void StopCapture();
+  bool IsCapturing() const;
+  void StartStreaming(mate::Arguments* args);
+  void StopStreaming();
 
  protected:
   explicit NetLog(v8::Isolate* isolate, AtomBrowserContext* browser_context);
@@ -49,6 +57,8 @@ class NetLog : public mate::TrackableObject<NetLog>,
   std::list<net_log::NetExportFileWriter::FilePathCallback>
       stop_callback_queue_;
   std::unique_ptr<base::DictionaryValue> net_log_state_;
+  std::unique_ptr<RingBufferNetLogObserver> ring_buffer_;
+  std::unique_ptr<StreamingNetLogObserver> streaming_;
 
   DISALLOW_COPY_AND_ASSIGN(NetLog);
 };
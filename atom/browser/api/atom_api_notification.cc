@@ -190,7 +190,7 @@ void Notification::NotificationClosed() {
 
 void Notification::Close() {
   if (notification_) {
-    notification_->Dismiss();
+    presenter_->DismissNotification(notification_.get());
     notification_.reset();
   }
 }
@@ -213,14 +213,16 @@ void Notification::Show() {
       options.actions = actions_;
       options.sound = sound_;
       options.close_button_text = close_button_text_;
-      notification_->Show(options);
+      presenter_->ShowNotification(notification_.get(), options);
     }
   }
 }
 
 bool Notification::IsSupported() {
-  return !!static_cast<AtomBrowserClient*>(AtomBrowserClient::Get())
-               ->GetNotificationPresenter();
+  NotificationPresenter* presenter =
+      static_cast<AtomBrowserClient*>(AtomBrowserClient::Get())
+          ->GetNotificationPresenter();
+  return presenter && presenter->IsAvailable();
 }
 
 // static
@@ -0,0 +1,192 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/api/atom_api_offscreen_atlas.h"
+
+#include <algorithm>
+
+#include "atom/browser/api/atom_api_web_contents.h"
+#include "atom/common/api/atom_api_native_image.h"
+#include "atom/common/native_mate_converters/gfx_converter.h"
+#include "native_mate/constructor.h"
+#include "native_mate/dictionary.h"
+#include "native_mate/object_template_builder.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "ui/gfx/image/image.h"
+#include "ui/gfx/skia_util.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+namespace api {
+
+namespace {
+
+const int kDefaultFrameRate = 60;
+const int kMaxFrameRate = 240;
+
+}  // namespace
+
+OffscreenAtlas::OffscreenAtlas(v8::Isolate* isolate,
+                               v8::Local<v8::Object> wrapper,
+                               const gfx::Size& size,
+                               int frame_rate)
+    : frame_interval_(base::TimeDelta::FromSeconds(1) / frame_rate),
+      weak_factory_(this) {
+  bitmap_.allocN32Pixels(size.width(), size.height(), false);
+  bitmap_.eraseColor(SK_ColorTRANSPARENT);
+  InitWith(isolate, wrapper);
+}
+
+OffscreenAtlas::~OffscreenAtlas() {}
+
+// static
+mate::WrappableBase* OffscreenAtlas::New(mate::Arguments* args) {
+  // new OffscreenAtlas({width, height[, frameRate]})
+  mate::Dictionary options;
+  int width = 0;
+  int height = 0;
+  if (!args->GetNext(&options) || !options.Get("width", &width) ||
+      !options.Get("height", &height) || width <= 0 || height <= 0) {
+    args->ThrowError("A positive width and height are required");
+    return nullptr;
+  }
+  int frame_rate = kDefaultFrameRate;
+  options.Get("frameRate", &frame_rate);
+  frame_rate = std::max(1, std::min(frame_rate, kMaxFrameRate));
+  return new OffscreenAtlas(args->isolate(), args->GetThis(),
+                            gfx::Size(width, height), frame_rate);
+}
+
+void OffscreenAtlas::OnMemberPaint(int32_t web_contents_id,
+                                   const gfx::Rect& dirty_rect,
+                                   const SkBitmap& bitmap) {
+  auto it = members_.find(web_contents_id);
+  if (it == members_.end())
+    return;
+  Member& member = it->second;
+
+  // Only the part of the page within the member's region of the atlas is
+  // copied.
+  gfx::Rect region = gfx::IntersectRects(member.bounds, gfx::Rect(GetSize()));
+  region.Offset(-member.bounds.x(), -member.bounds.y());
+  gfx::Rect area = gfx::IntersectRects(dirty_rect, region);
+  area.Intersect(gfx::Rect(bitmap.width(), bitmap.height()));
+  SkBitmap subset;
+  if (area.IsEmpty() ||
+      !bitmap.extractSubset(&subset, gfx::RectToSkIRect(area)))
+    return;
+
+  EnsureBitmapWritable();
+  SkCanvas canvas(bitmap_);
+  area.Offset(member.bounds.x(), member.bounds.y());
+  canvas.writePixels(subset, area.x(), area.y());
+  member.dirty.Union(area);
+
+  if (!frame_timer_.IsRunning()) {
+    frame_timer_.Start(FROM_HERE, frame_interval_,
+                       base::Bind(&OffscreenAtlas::OnFrame,
+                                  base::Unretained(this)));
+  }
+}
+
+void OffscreenAtlas::RemoveMember(int32_t web_contents_id) {
+  members_.erase(web_contents_id);
+}
+
+void OffscreenAtlas::Add(mate::Handle<WebContents> web_contents,
+                         const gfx::Rect& bounds,
+                         mate::Arguments* args) {
+  if (!web_contents->IsOffScreen()) {
+    args->ThrowError("Only offscreen webContents can be added to an atlas");
+    return;
+  }
+  members_[web_contents->ID()] = {bounds, gfx::Rect()};
+  web_contents->SetPaintAtlas(weak_factory_.GetWeakPtr());
+  // Fill the new region with the whole page.
+  web_contents->Invalidate();
+}
+
+void OffscreenAtlas::Remove(mate::Handle<WebContents> web_contents) {
+  if (members_.erase(web_contents->ID()))
+    web_contents->SetPaintAtlas(base::WeakPtr<OffscreenAtlas>());
+}
+
+gfx::Size OffscreenAtlas::GetSize() const {
+  return gfx::Size(bitmap_.width(), bitmap_.height());
+}
+
+void OffscreenAtlas::OnFrame() {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  std::vector<mate::Dictionary> regions;
+  for (auto& it : members_) {
+    if (it.second.dirty.IsEmpty())
+      continue;
+    mate::Dictionary region = mate::Dictionary::CreateEmpty(isolate());
+    region.Set("webContentsId", it.first);
+    region.Set("rect", it.second.dirty);
+    regions.push_back(region);
+    it.second.dirty = gfx::Rect();
+  }
+
+  // Keep the timer off while nothing paints.
+  if (regions.empty()) {
+    frame_timer_.Stop();
+    return;
+  }
+
+  // The image shares the pixels of the atlas only during the event, so the
+  // next paint writes into the atlas without copying it first.
+  auto image =
+      NativeImage::Create(isolate(), gfx::Image::CreateFrom1xBitmap(bitmap_));
+  image->MarkPixelsTransient();
+  Emit("paint", regions, image);
+  image->ReleasePixels();
+}
+
+void OffscreenAtlas::EnsureBitmapWritable() {
+  if (bitmap_.pixelRef()->unique())
+    return;
+  SkBitmap copy;
+  copy.allocPixels(bitmap_.info());
+  bitmap_.readPixels(copy.pixmap());
+  bitmap_ = copy;
+}
+
+// static
+void OffscreenAtlas::BuildPrototype(v8::Isolate* isolate,
+                                    v8::Local<v8::FunctionTemplate> prototype) {
+  prototype->SetClassName(mate::StringToV8(isolate, "OffscreenAtlas"));
+  mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
+      .MakeDestroyable()
+      .SetMethod("add", &OffscreenAtlas::Add)
+      .SetMethod("remove", &OffscreenAtlas::Remove)
+      .SetMethod("getSize", &OffscreenAtlas::GetSize);
+}
+
+}  // namespace api
+
+}  // namespace atom
+
+namespace {
+
+using atom::api::OffscreenAtlas;
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  v8::Isolate* isolate = context->GetIsolate();
+  OffscreenAtlas::SetConstructor(isolate, base::Bind(&OffscreenAtlas::New));
+
+  mate::Dictionary dict(isolate, exports);
+  dict.Set("OffscreenAtlas",
+           OffscreenAtlas::GetConstructor(isolate)->GetFunction());
+}
+
+}  // namespace
+
+NODE_BUILTIN_MODULE_CONTEXT_AWARE(atom_browser_offscreen_atlas, Initialize)
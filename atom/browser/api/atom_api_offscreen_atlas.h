@@ -0,0 +1,79 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_API_ATOM_API_OFFSCREEN_ATLAS_H_
+#define ATOM_BROWSER_API_ATOM_API_OFFSCREEN_ATLAS_H_
+
+#include <map>
+#include <vector>
+
+#include "atom/browser/api/trackable_object.h"
+#include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
+#include "native_mate/handle.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace atom {
+
+namespace api {
+
+class WebContents;
+
+// Several offscreen WebContents painting into regions of one bitmap, the
+// changes of all of them are reported by a single "paint" event per frame.
+class OffscreenAtlas : public mate::TrackableObject<OffscreenAtlas> {
+ public:
+  static mate::WrappableBase* New(mate::Arguments* args);
+
+  static void BuildPrototype(v8::Isolate* isolate,
+                             v8::Local<v8::FunctionTemplate> prototype);
+
+  // Called by the member |web_contents_id| instead of emitting "paint".
+  void OnMemberPaint(int32_t web_contents_id,
+                     const gfx::Rect& dirty_rect,
+                     const SkBitmap& bitmap);
+  void RemoveMember(int32_t web_contents_id);
+
+ protected:
+  OffscreenAtlas(v8::Isolate* isolate,
+                 v8::Local<v8::Object> wrapper,
+                 const gfx::Size& size,
+                 int frame_rate);
+  ~OffscreenAtlas() override;
+
+  void Add(mate::Handle<WebContents> web_contents,
+           const gfx::Rect& bounds,
+           mate::Arguments* args);
+  void Remove(mate::Handle<WebContents> web_contents);
+  gfx::Size GetSize() const;
+
+ private:
+  struct Member {
+    gfx::Rect bounds;
+    // The part of |bounds| changed since the last "paint" event.
+    gfx::Rect dirty;
+  };
+
+  void OnFrame();
+
+  // Makes sure writing to |bitmap_| does not change an image that was handed
+  // out by a previous "paint" event.
+  void EnsureBitmapWritable();
+
+  SkBitmap bitmap_;
+  std::map<int32_t, Member> members_;
+  base::TimeDelta frame_interval_;
+  base::RepeatingTimer frame_timer_;
+
+  base::WeakPtrFactory<OffscreenAtlas> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(OffscreenAtlas);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_API_ATOM_API_OFFSCREEN_ATLAS_H_
@@ -88,6 +88,10 @@ void PowerMonitor::QuerySystemIdleState(v8::Isolate* isolate,
                                         int idle_threshold,
                                         const ui::IdleCallback& callback) {
   if (idle_threshold > 0) {
+#if defined(OS_MACOSX)
+    // The monitor may be deferred by --defer-initialization.
+    ui::InitIdleMonitor();
+#endif
     ui::CalculateIdleState(idle_threshold, callback);
   } else {
     isolate->ThrowException(v8::Exception::TypeError(mate::StringToV8(
@@ -96,9 +100,16 @@ void PowerMonitor::QuerySystemIdleState(v8::Isolate* isolate,
 }
 
 void PowerMonitor::QuerySystemIdleTime(const ui::IdleTimeCallback& callback) {
+#if defined(OS_MACOSX)
+  ui::InitIdleMonitor();
+#endif
   ui::CalculateIdleTime(callback);
 }
 
+bool PowerMonitor::IsOnBatteryPower() {
+  return base::PowerMonitor::Get()->IsOnBatteryPower();
+}
+
 // static
 v8::Local<v8::Value> PowerMonitor::Create(v8::Isolate* isolate) {
   if (!Browser::Get()->is_ready()) {
@@ -123,7 +134,8 @@ void PowerMonitor::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("unblockShutdown", &PowerMonitor::UnblockShutdown)
 #endif
       .SetMethod("querySystemIdleState", &PowerMonitor::QuerySystemIdleState)
-      .SetMethod("querySystemIdleTime", &PowerMonitor::QuerySystemIdleTime);
+      .SetMethod("querySystemIdleTime", &PowerMonitor::QuerySystemIdleTime)
+      .SetMethod("isOnBatteryPower", &PowerMonitor::IsOnBatteryPower);
 }
 
 }  // namespace api
@@ -50,6 +50,7 @@ class PowerMonitor : public mate::TrackableObject<PowerMonitor>,
                             int idle_threshold,
                             const ui::IdleCallback& callback);
   void QuerySystemIdleTime(const ui::IdleTimeCallback& callback);
+  bool IsOnBatteryPower();
 
 #if defined(OS_WIN)
   // Static callback invoked when a message comes in to our messaging window.
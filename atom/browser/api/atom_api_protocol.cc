@@ -7,17 +7,20 @@
 #include "atom/browser/atom_browser_client.h"
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/browser.h"
+#include "atom/browser/net/directory_protocol_handler.h"
 #include "atom/browser/net/url_request_async_asar_job.h"
 #include "atom/browser/net/url_request_buffer_job.h"
 #include "atom/browser/net/url_request_fetch_job.h"
 #include "atom/browser/net/url_request_stream_job.h"
 #include "atom/browser/net/url_request_string_job.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/node_includes.h"
 #include "atom/common/options_switches.h"
 #include "base/command_line.h"
 #include "base/strings/string_util.h"
+#include "base/task_scheduler/post_task.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "native_mate/dictionary.h"
 #include "url/url_util.h"
@@ -79,6 +82,97 @@ void Protocol::RegisterServiceWorkerSchemes(
   atom::AtomBrowserClient::SetCustomServiceWorkerSchemes(schemes);
 }
 
+void Protocol::RegisterDirectoryProtocol(const std::string& scheme,
+                                         const base::FilePath& directory,
+                                         mate::Arguments* args) {
+  CompletionCallback callback;
+  args->GetNext(&callback);
+  auto* getter = static_cast<URLRequestContextGetter*>(
+      browser_context_->GetRequestContext());
+  content::BrowserThread::PostTaskAndReplyWithResult(
+      content::BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&Protocol::RegisterDirectoryProtocolInIO,
+                     base::RetainedRef(getter), scheme, directory),
+      base::BindOnce(&Protocol::OnIOCompleted, GetWeakPtr(), callback));
+}
+
+// static
+Protocol::ProtocolError Protocol::RegisterDirectoryProtocolInIO(
+    scoped_refptr<URLRequestContextGetter> request_context_getter,
+    const std::string& scheme,
+    const base::FilePath& directory) {
+  auto* job_factory = request_context_getter->job_factory();
+  if (job_factory->IsHandledProtocol(scheme))
+    return PROTOCOL_REGISTERED;
+  auto protocol_handler = std::make_unique<DirectoryProtocolHandler>(
+      directory,
+      base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}));
+  if (job_factory->SetProtocolHandler(scheme, std::move(protocol_handler)))
+    return PROTOCOL_OK;
+  else
+    return PROTOCOL_FAIL;
+}
+
+void Protocol::SetFileProtocolRules(const std::string& scheme,
+                                    const std::vector<mate::Dictionary>& rules,
+                                    mate::Arguments* args) {
+  std::vector<FileProtocolRule> file_protocol_rules;
+  for (const auto& dict : rules) {
+    FileProtocolRule rule;
+    if (!dict.Get("directory", &rule.directory) || rule.directory.empty()) {
+      args->ThrowError("Each rule must have a directory");
+      return;
+    }
+    dict.Get("host", &rule.host);
+    dict.Get("mimeType", &rule.mime_type);
+    std::string path_prefix;
+    if (dict.Get("pathPrefix", &path_prefix)) {
+      if (!base::StartsWith(path_prefix, "/", base::CompareCase::SENSITIVE))
+        path_prefix = "/" + path_prefix;
+      if (!base::EndsWith(path_prefix, "/", base::CompareCase::SENSITIVE))
+        path_prefix += "/";
+      rule.path_prefix = path_prefix;
+    }
+    std::map<std::string, std::string> headers;
+    if (dict.Get("headers", &headers))
+      rule.headers.assign(headers.begin(), headers.end());
+    file_protocol_rules.push_back(rule);
+  }
+
+  CompletionCallback callback;
+  args->GetNext(&callback);
+  auto* getter = static_cast<URLRequestContextGetter*>(
+      browser_context_->GetRequestContext());
+  content::BrowserThread::PostTaskAndReplyWithResult(
+      content::BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&Protocol::SetFileProtocolRulesInIO,
+                     base::RetainedRef(getter), scheme,
+                     std::move(file_protocol_rules)),
+      base::BindOnce(&Protocol::OnIOCompleted, GetWeakPtr(), callback));
+}
+
+// static
+Protocol::ProtocolError Protocol::SetFileProtocolRulesInIO(
+    scoped_refptr<URLRequestContextGetter> request_context_getter,
+    const std::string& scheme,
+    const std::vector<FileProtocolRule>& rules) {
+  auto* job_factory = request_context_getter->job_factory();
+  if (!job_factory->HasProtocolHandler(scheme))
+    return PROTOCOL_NOT_REGISTERED;
+  if (rules.empty()) {
+    job_factory->SetFileProtocolRules(scheme, nullptr);
+    return PROTOCOL_OK;
+  }
+  auto file_task_runner = base::CreateSequencedTaskRunnerWithTraits(
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  job_factory->SetFileProtocolRules(
+      scheme, std::make_unique<FileProtocolRules>(rules, file_task_runner));
+  return PROTOCOL_OK;
+}
+
 void Protocol::UnregisterProtocol(const std::string& scheme,
                                   mate::Arguments* args) {
   CompletionCallback callback;
@@ -200,6 +294,9 @@ void Protocol::BuildPrototype(v8::Isolate* isolate,
                  &Protocol::RegisterProtocol<URLRequestFetchJob>)
       .SetMethod("registerStreamProtocol",
                  &Protocol::RegisterProtocol<URLRequestStreamJob>)
+      .SetMethod("registerDirectoryProtocol",
+                 &Protocol::RegisterDirectoryProtocol)
+      .SetMethod("setFileProtocolRules", &Protocol::SetFileProtocolRules)
       .SetMethod("unregisterProtocol", &Protocol::UnregisterProtocol)
       .SetMethod("isProtocolHandled", &Protocol::IsProtocolHandled)
       .SetMethod("interceptStringProtocol",
@@ -14,7 +14,10 @@
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/net/atom_url_request_job_factory.h"
+#include "atom/browser/net/file_protocol_rules.h"
+#include "atom/browser/net/protocol_response_cache.h"
 #include "base/callback.h"
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/browser_thread.h"
 #include "native_mate/arguments.h"
@@ -73,14 +76,16 @@ class Protocol : public mate::TrackableObject<Protocol> {
                           const Handler& handler)
         : isolate_(isolate),
           request_context_(request_context),
-          handler_(handler) {}
+          handler_(handler),
+          response_cache_(new ProtocolResponseCache) {}
     ~CustomProtocolHandler() override {}
 
     net::URLRequestJob* MaybeCreateJob(
         net::URLRequest* request,
         net::NetworkDelegate* network_delegate) const override {
       RequestJob* request_job = new RequestJob(request, network_delegate);
-      request_job->SetHandlerInfo(isolate_, request_context_, handler_);
+      request_job->SetHandlerInfo(isolate_, request_context_, handler_,
+                                  response_cache_.get());
       return request_job;
     }
 
@@ -88,6 +93,7 @@ class Protocol : public mate::TrackableObject<Protocol> {
     v8::Isolate* isolate_;
     net::URLRequestContextGetter* request_context_;
     Protocol::Handler handler_;
+    scoped_refptr<ProtocolResponseCache> response_cache_;
 
     DISALLOW_COPY_AND_ASSIGN(CustomProtocolHandler);
   };
@@ -127,6 +133,24 @@ class Protocol : public mate::TrackableObject<Protocol> {
       return PROTOCOL_FAIL;
   }
 
+  // Register the protocol that serves the files of |directory| in IO thread.
+  void RegisterDirectoryProtocol(const std::string& scheme,
+                                 const base::FilePath& directory,
+                                 mate::Arguments* args);
+  static ProtocolError RegisterDirectoryProtocolInIO(
+      scoped_refptr<URLRequestContextGetter> request_context_getter,
+      const std::string& scheme,
+      const base::FilePath& directory);
+
+  // Set the rules that map URLs of |scheme| to files before its handler.
+  void SetFileProtocolRules(const std::string& scheme,
+                            const std::vector<mate::Dictionary>& rules,
+                            mate::Arguments* args);
+  static ProtocolError SetFileProtocolRulesInIO(
+      scoped_refptr<URLRequestContextGetter> request_context_getter,
+      const std::string& scheme,
+      const std::vector<FileProtocolRule>& rules);
+
   // Unregister the protocol handler that handles |scheme|.
   void UnregisterProtocol(const std::string& scheme, mate::Arguments* args);
   static ProtocolError UnregisterProtocolInIO(
@@ -31,7 +31,7 @@ namespace {
 
 // Find an item in container according to its ID.
 template <class T>
-typename T::iterator FindById(T* container, int id) {
+typename T::iterator FindById(T* container, int64_t id) {
   auto predicate = [id](const typename T::value_type& item) -> bool {
     return item.id() == id;
   };
@@ -52,6 +52,10 @@ std::vector<std::string> MetricsToArray(uint32_t metrics) {
   return array;
 }
 
+// Monitor hotplugs and docking send bursts of changes, the burst ends once no
+// change arrived for this long.
+const int kDisplayChangesBatchDelayMs = 100;
+
 }  // namespace
 
 Screen::Screen(v8::Isolate* isolate, display::Screen* screen)
@@ -73,7 +77,10 @@ display::Display Screen::GetPrimaryDisplay() {
 }
 
 std::vector<display::Display> Screen::GetAllDisplays() {
-  return screen_->GetAllDisplays();
+  // Each call converts the displays again, so callers can change them.
+  if (!all_displays_)
+    all_displays_ = screen_->GetAllDisplays();
+  return *all_displays_;
 }
 
 display::Display Screen::GetDisplayNearestPoint(const gfx::Point& point) {
@@ -101,18 +108,70 @@ static gfx::Rect DIPToScreenRect(atom::NativeWindow* window,
 #endif
 
 void Screen::OnDisplayAdded(const display::Display& new_display) {
+  all_displays_.reset();
+  added_displays_.push_back(new_display);
+  ScheduleDisplayChangesBatch();
   Emit("display-added", new_display);
 }
 
 void Screen::OnDisplayRemoved(const display::Display& old_display) {
+  all_displays_.reset();
+  changed_displays_.erase(old_display.id());
+  auto added = FindById(&added_displays_, old_display.id());
+  if (added != added_displays_.end())
+    added_displays_.erase(added);
+  else
+    removed_displays_.push_back(old_display);
+  ScheduleDisplayChangesBatch();
   Emit("display-removed", old_display);
 }
 
 void Screen::OnDisplayMetricsChanged(const display::Display& display,
                                      uint32_t changed_metrics) {
+  all_displays_.reset();
+  auto added = FindById(&added_displays_, display.id());
+  if (added != added_displays_.end()) {
+    // Listeners get the added display with its latest metrics.
+    *added = display;
+  } else {
+    auto& change = changed_displays_[display.id()];
+    change.first = display;
+    change.second |= changed_metrics;
+  }
+  ScheduleDisplayChangesBatch();
   Emit("display-metrics-changed", display, MetricsToArray(changed_metrics));
 }
 
+void Screen::ScheduleDisplayChangesBatch() {
+  // Restarting the timer delays the event until the burst is over.
+  batch_timer_.Start(
+      FROM_HERE, base::TimeDelta::FromMilliseconds(kDisplayChangesBatchDelayMs),
+      base::Bind(&Screen::EmitDisplayChangesBatch, base::Unretained(this)));
+}
+
+void Screen::EmitDisplayChangesBatch() {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+
+  std::vector<mate::Dictionary> changed;
+  for (const auto& pair : changed_displays_) {
+    mate::Dictionary change = mate::Dictionary::CreateEmpty(isolate());
+    change.Set("display", pair.second.first);
+    change.Set("changedMetrics", MetricsToArray(pair.second.second));
+    changed.push_back(change);
+  }
+
+  mate::Dictionary changes = mate::Dictionary::CreateEmpty(isolate());
+  changes.Set("added", added_displays_);
+  changes.Set("removed", removed_displays_);
+  changes.Set("changed", changed);
+
+  added_displays_.clear();
+  removed_displays_.clear();
+  changed_displays_.clear();
+  Emit("display-metrics-changed-batch", changes);
+}
+
 // static
 v8::Local<v8::Value> Screen::Create(v8::Isolate* isolate) {
   if (!Browser::Get()->is_ready()) {
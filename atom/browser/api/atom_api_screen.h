@@ -5,9 +5,13 @@
 #ifndef ATOM_BROWSER_API_ATOM_API_SCREEN_H_
 #define ATOM_BROWSER_API_ATOM_API_SCREEN_H_
 
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "atom/browser/api/event_emitter.h"
+#include "base/optional.h"
+#include "base/timer/timer.h"
 #include "native_mate/handle.h"
 #include "ui/display/display_observer.h"
 #include "ui/display/screen.h"
@@ -47,8 +51,21 @@ class Screen : public mate::EventEmitter<Screen>,
                                uint32_t changed_metrics) override;
 
  private:
+  // Emits the changes collected since the first one of a burst.
+  void EmitDisplayChangesBatch();
+  void ScheduleDisplayChangesBatch();
+
   display::Screen* screen_;
 
+  // The displays, reset whenever a display changes.
+  base::Optional<std::vector<display::Display>> all_displays_;
+
+  // Changes waiting for the display-metrics-changed-batch event.
+  std::vector<display::Display> added_displays_;
+  std::vector<display::Display> removed_displays_;
+  std::map<int64_t, std::pair<display::Display, uint32_t>> changed_displays_;
+  base::OneShotTimer batch_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(Screen);
 };
 
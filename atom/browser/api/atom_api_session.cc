@@ -4,6 +4,8 @@
 
 #include "atom/browser/api/atom_api_session.h"
 
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -21,6 +23,8 @@
 #include "atom/browser/browser.h"
 #include "atom/browser/media/media_device_id_salt.h"
 #include "atom/browser/net/atom_cert_verifier.h"
+#include "atom/browser/net/atom_network_delegate.h"
+#include "atom/browser/net/url_request_context_getter.h"
 #include "atom/browser/session_preferences.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/content_converter.h"
@@ -29,6 +33,7 @@
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "base/files/file_path.h"
+#include "base/callback_helpers.h"
 #include "base/guid.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
@@ -51,11 +56,19 @@
 #include "net/http/http_auth_handler_factory.h"
 #include "net/http/http_auth_preferences.h"
 #include "net/http/http_cache.h"
+#include "net/http/http_network_session.h"
+#include "net/http/http_request_info.h"
+#include "net/http/http_stream_factory.h"
 #include "net/http/http_transaction_factory.h"
 #include "net/url_request/static_http_user_agent_settings.h"
 #include "net/url_request/url_request_context.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
 #include "net/url_request/url_request_context_getter.h"
+#include "storage/browser/quota/quota_client.h"
+#include "storage/browser/quota/quota_manager.h"
+#include "third_party/blink/public/mojom/quota/quota_types.mojom.h"
 #include "ui/base/l10n/l10n_util.h"
+#include "url/origin.h"
 
 #include "atom/common/node_includes.h"
 
@@ -66,11 +79,24 @@ using content::StoragePartition;
 namespace {
 
 struct ClearStorageDataOptions {
-  GURL origin;
+  std::vector<GURL> origins;
   uint32_t storage_types = StoragePartition::REMOVE_DATA_MASK_ALL;
   uint32_t quota_types = StoragePartition::QUOTA_MANAGED_STORAGE_MASK_ALL;
+  bool defer_purge = false;
+  base::Callback<void(int, int)> progress;
+};
+
+struct DownloadProgress {
+  int count = 0;
+  int64_t received_bytes = 0;
+  int64_t total_bytes = 0;
+  int64_t current_speed = 0;
 };
 
+// How often "download-progress" is emitted.
+constexpr base::TimeDelta kDownloadProgressInterval =
+    base::TimeDelta::FromSeconds(1);
+
 struct ClearAuthCacheOptions {
   std::string type;
   GURL origin;
@@ -80,28 +106,29 @@ struct ClearAuthCacheOptions {
   net::HttpAuth::Scheme auth_scheme;
 };
 
+const struct {
+  const char* name;
+  uint32_t mask;
+} kStorageTypes[] = {
+    {"appcache", StoragePartition::REMOVE_DATA_MASK_APPCACHE},
+    {"cookies", StoragePartition::REMOVE_DATA_MASK_COOKIES},
+    {"filesystem", StoragePartition::REMOVE_DATA_MASK_FILE_SYSTEMS},
+    {"indexdb", StoragePartition::REMOVE_DATA_MASK_INDEXEDDB},
+    {"localstorage", StoragePartition::REMOVE_DATA_MASK_LOCAL_STORAGE},
+    {"shadercache", StoragePartition::REMOVE_DATA_MASK_SHADER_CACHE},
+    {"websql", StoragePartition::REMOVE_DATA_MASK_WEBSQL},
+    {"serviceworkers", StoragePartition::REMOVE_DATA_MASK_SERVICE_WORKERS},
+    {"cachestorage", StoragePartition::REMOVE_DATA_MASK_CACHE_STORAGE},
+};
+
 uint32_t GetStorageMask(const std::vector<std::string>& storage_types) {
   uint32_t storage_mask = 0;
   for (const auto& it : storage_types) {
     auto type = base::ToLowerASCII(it);
-    if (type == "appcache")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_APPCACHE;
-    else if (type == "cookies")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_COOKIES;
-    else if (type == "filesystem")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_FILE_SYSTEMS;
-    else if (type == "indexdb")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_INDEXEDDB;
-    else if (type == "localstorage")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_LOCAL_STORAGE;
-    else if (type == "shadercache")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_SHADER_CACHE;
-    else if (type == "websql")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_WEBSQL;
-    else if (type == "serviceworkers")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_SERVICE_WORKERS;
-    else if (type == "cachestorage")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_CACHE_STORAGE;
+    for (const auto& storage_type : kStorageTypes) {
+      if (type == storage_type.name)
+        storage_mask |= storage_type.mask;
+    }
   }
   return storage_mask;
 }
@@ -153,16 +180,36 @@ struct Converter<ClearStorageDataOptions> {
     mate::Dictionary options;
     if (!ConvertFromV8(isolate, val, &options))
       return false;
-    options.Get("origin", &out->origin);
+    GURL origin;
+    if (options.Get("origin", &origin))
+      out->origins.push_back(origin);
+    std::vector<GURL> origins;
+    if (options.Get("origins", &origins))
+      out->origins.insert(out->origins.end(), origins.begin(), origins.end());
     std::vector<std::string> types;
     if (options.Get("storages", &types))
       out->storage_types = GetStorageMask(types);
     if (options.Get("quotas", &types))
       out->quota_types = GetQuotaMask(types);
+    options.Get("deferPurge", &out->defer_purge);
+    options.Get("progress", &out->progress);
     return true;
   }
 };
 
+template <>
+struct Converter<DownloadProgress> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const DownloadProgress& val) {
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+    dict.Set("count", val.count);
+    dict.Set("receivedBytes", val.received_bytes);
+    dict.Set("totalBytes", val.total_bytes);
+    dict.Set("currentSpeed", val.current_speed);
+    return dict.GetHandle();
+  }
+};
+
 template <>
 struct Converter<ClearAuthCacheOptions> {
   static bool FromV8(v8::Isolate* isolate,
@@ -196,6 +243,24 @@ struct Converter<atom::VerifyRequestParams> {
   }
 };
 
+template <>
+struct Converter<atom::AtomPermissionManager::CheckResult> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     atom::AtomPermissionManager::CheckResult* out) {
+    if (!val->IsObject())
+      return ConvertFromV8(isolate, val, &out->granted);
+    mate::Dictionary result;
+    if (!ConvertFromV8(isolate, val, &result) ||
+        !result.Get("granted", &out->granted))
+      return false;
+    double cache_for = 0;
+    if (result.Get("cacheFor", &cache_for) && cache_for > 0)
+      out->cache_duration = base::TimeDelta::FromMillisecondsD(cache_for);
+    return true;
+  }
+};
+
 }  // namespace mate
 
 namespace atom {
@@ -268,10 +333,11 @@ void DoCacheActionInIO(
 
 void SetCertVerifyProcInIO(
     const scoped_refptr<net::URLRequestContextGetter>& context_getter,
-    const AtomCertVerifier::VerifyProc& proc) {
+    const AtomCertVerifier::VerifyProc& proc,
+    base::TimeDelta cache_duration) {
   auto* request_context = context_getter->GetURLRequestContext();
   static_cast<AtomCertVerifier*>(request_context->cert_verifier())
-      ->SetVerifyProc(proc);
+      ->SetVerifyProc(proc, cache_duration);
 }
 
 void ClearHostResolverCacheInIO(
@@ -287,6 +353,116 @@ void ClearHostResolverCacheInIO(
   }
 }
 
+void GetSocketPoolInfoInIO(
+    const scoped_refptr<URLRequestContextGetter>& context_getter,
+    const base::Callback<void(const base::DictionaryValue&)>& callback) {
+  base::DictionaryValue info;
+  auto* request_context = context_getter->GetURLRequestContext();
+  auto* network_session =
+      request_context
+          ? request_context->http_transaction_factory()->GetSession()
+          : nullptr;
+  if (network_session) {
+    info.Set("socketPools", network_session->SocketPoolInfoToValue());
+    info.Set("http2Sessions", network_session->SpdySessionPoolInfoToValue());
+    auto* network_delegate = context_getter->network_delegate();
+    info.SetInteger("networkRequestCount",
+                    network_delegate->network_request_count());
+    info.SetInteger("reusedSocketCount",
+                    network_delegate->reused_socket_count());
+  }
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+                          base::BindOnce(callback, std::move(info)));
+}
+
+// The blockfile backend reports its counters in hex.
+int64_t ParseCacheStat(const std::string& value) {
+  int64_t result = 0;
+  if (base::StartsWith(value, "0x", base::CompareCase::SENSITIVE))
+    base::HexStringToInt64(value, &result);
+  else
+    base::StringToInt64(value, &result);
+  return result;
+}
+
+// Callback of HttpCache::GetBackend for ses.getCacheStats.
+void OnGetBackendForStats(
+    disk_cache::Backend** backend_ptr,
+    std::unique_ptr<base::DictionaryValue> info,
+    const base::Callback<void(const base::DictionaryValue&)>& callback,
+    int result) {
+  if (result == net::OK && backend_ptr && *backend_ptr) {
+    disk_cache::Backend* backend = *backend_ptr;
+    info->SetInteger("entryCount", backend->GetEntryCount());
+
+    base::StringPairs stats;
+    backend->GetStats(&stats);
+    auto backend_stats = std::make_unique<base::DictionaryValue>();
+    for (const auto& stat : stats) {
+      backend_stats->SetKey(stat.first, base::Value(stat.second));
+      if (stat.first == "Current size")
+        info->SetDouble("size", ParseCacheStat(stat.second));
+      else if (stat.first == "Trim entry")
+        info->SetDouble("evictionCount", ParseCacheStat(stat.second));
+    }
+    info->Set("backendStats", std::move(backend_stats));
+  }
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+                          base::BindOnce(callback, std::move(*info)));
+}
+
+void GetCacheStatsInIO(
+    const scoped_refptr<URLRequestContextGetter>& context_getter,
+    const base::Callback<void(const base::DictionaryValue&)>& callback) {
+  auto info = std::make_unique<base::DictionaryValue>();
+  auto* network_delegate = context_getter->network_delegate();
+  info->SetInteger("hitCount", network_delegate->cache_hit_count());
+  info->SetInteger("missCount", network_delegate->cache_miss_count());
+
+  auto* request_context = context_getter->GetURLRequestContext();
+  auto* http_cache = request_context->http_transaction_factory()->GetCache();
+  if (!http_cache) {
+    BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+                            base::BindOnce(callback, std::move(*info)));
+    return;
+  }
+
+  using BackendPtr = disk_cache::Backend*;
+  auto** backend_ptr = new BackendPtr(nullptr);
+  net::CompletionCallback on_get_backend =
+      base::Bind(&OnGetBackendForStats, base::Owned(backend_ptr),
+                 base::Passed(&info), callback);
+  int rv = http_cache->GetBackend(backend_ptr, on_get_backend);
+  if (rv != net::ERR_IO_PENDING)
+    on_get_backend.Run(net::OK);
+}
+
+void PreconnectInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter,
+    const GURL& url,
+    int num_sockets) {
+  auto* request_context = context_getter->GetURLRequestContext();
+  auto* network_session =
+      request_context
+          ? request_context->http_transaction_factory()->GetSession()
+          : nullptr;
+  if (!network_session)
+    return;
+
+  net::HttpRequestInfo request_info;
+  request_info.url = url;
+  request_info.method = "GET";
+  if (request_context->http_user_agent_settings()) {
+    request_info.extra_headers.SetHeader(
+        net::HttpRequestHeaders::kUserAgent,
+        request_context->http_user_agent_settings()->GetUserAgent());
+  }
+  request_info.traffic_annotation =
+      net::MutableNetworkTrafficAnnotationTag(NO_TRAFFIC_ANNOTATION_YET);
+  network_session->http_stream_factory()->PreconnectStreams(num_sockets,
+                                                            request_info);
+}
+
 void ClearAuthCacheInIO(
     const scoped_refptr<net::URLRequestContextGetter>& context_getter,
     const ClearAuthCacheOptions& options,
@@ -327,9 +503,196 @@ void AllowNTLMCredentialsForDomainsInIO(
   }
 }
 
-void OnClearStorageDataDone(const base::Closure& callback) {
-  if (!callback.is_null())
-    callback.Run();
+void DeleteOriginDataInIO(scoped_refptr<storage::QuotaManager> quota_manager,
+                          const url::Origin& origin,
+                          blink::mojom::StorageType type,
+                          int quota_client_mask,
+                          const base::Closure& callback) {
+  quota_manager->DeleteOriginData(
+      origin, type, quota_client_mask,
+      base::BindOnce(
+          [](const base::Closure& callback,
+             blink::mojom::QuotaStatusCode status) {
+            RunCallbackInUI(callback);
+          },
+          callback));
+}
+
+// Clears the storages of a clearStorageData request in parts that run at
+// once, so a large IndexedDB does not hold up clearing the cookies. The
+// storages that are not quota managed are cleared with one
+// StoragePartition::ClearData call per origin. A ClearData call for quota
+// managed storages enumerates every origin in the quota database even when
+// given a single origin, so the quota managed storages of given origins are
+// deleted with one QuotaManager::DeleteOriginData call per origin and quota
+// type, covering all the storage types at once. Without origins they are
+// cleared by a single ClearData call. Deletes itself when done.
+class StorageDataRemover {
+ public:
+  StorageDataRemover(StoragePartition* storage_partition,
+                     const ClearStorageDataOptions& options,
+                     const base::Closure& callback)
+      : storage_partition_(storage_partition),
+        storage_types_(options.storage_types),
+        quota_types_(options.quota_types),
+        origins_(options.origins),
+        defer_purge_(options.defer_purge),
+        progress_(options.progress),
+        callback_(callback) {
+    // The cookies and the local storage are not quota managed, they are
+    // cleared with the other storages that are quick to remove.
+    int origin_count = std::max(static_cast<int>(origins_.size()), 1);
+    if (storage_types_ & ~kQuotaStorageMask)
+      pending_credentials_ = origin_count;
+    total_ = pending_credentials_;
+    if (storage_types_ & kQuotaStorageMask) {
+      if (origins_.empty())
+        total_ += 1;
+      else
+        total_ +=
+            origin_count * static_cast<int>(GetQuotaStorageTypes().size());
+    }
+  }
+
+  void Start() {
+    // ClearData may finish synchronously when there is nothing to remove.
+    starting_ = true;
+    base::Closure credentials_done = base::Bind(
+        &StorageDataRemover::OnPartDone, base::Unretained(this), true);
+    base::Closure done = base::Bind(&StorageDataRemover::OnPartDone,
+                                    base::Unretained(this), false);
+    uint32_t other_types = storage_types_ & ~kQuotaStorageMask;
+    uint32_t quota_storage_types = storage_types_ & kQuotaStorageMask;
+    if (origins_.empty()) {
+      if (other_types)
+        ClearData(other_types, GURL(), credentials_done);
+      if (quota_storage_types)
+        ClearData(quota_storage_types, GURL(), done);
+    } else {
+      int quota_client_mask = GetQuotaClientMask(quota_storage_types);
+      std::vector<blink::mojom::StorageType> types = GetQuotaStorageTypes();
+      for (const GURL& origin : origins_) {
+        if (other_types)
+          ClearData(other_types, origin, credentials_done);
+        if (!quota_storage_types)
+          continue;
+        for (blink::mojom::StorageType type : types) {
+          BrowserThread::PostTask(
+              BrowserThread::IO, FROM_HERE,
+              base::BindOnce(&DeleteOriginDataInIO,
+                             base::WrapRefCounted(
+                                 storage_partition_->GetQuotaManager()),
+                             url::Origin::Create(origin), type,
+                             quota_client_mask, done));
+        }
+      }
+    }
+    starting_ = false;
+    if (completed_ == total_)
+      Finish();
+    else if (defer_purge_ && pending_credentials_ == 0)
+      RunCallback();
+  }
+
+ private:
+  // The storages deleted by the quota clients of an origin.
+  static constexpr uint32_t kQuotaStorageMask =
+      StoragePartition::REMOVE_DATA_MASK_APPCACHE |
+      StoragePartition::REMOVE_DATA_MASK_FILE_SYSTEMS |
+      StoragePartition::REMOVE_DATA_MASK_INDEXEDDB |
+      StoragePartition::REMOVE_DATA_MASK_WEBSQL |
+      StoragePartition::REMOVE_DATA_MASK_SERVICE_WORKERS |
+      StoragePartition::REMOVE_DATA_MASK_CACHE_STORAGE;
+
+  static int GetQuotaClientMask(uint32_t storage_types) {
+    int mask = 0;
+    if (storage_types & StoragePartition::REMOVE_DATA_MASK_APPCACHE)
+      mask |= storage::QuotaClient::kAppcache;
+    if (storage_types & StoragePartition::REMOVE_DATA_MASK_FILE_SYSTEMS)
+      mask |= storage::QuotaClient::kFileSystem;
+    if (storage_types & StoragePartition::REMOVE_DATA_MASK_INDEXEDDB)
+      mask |= storage::QuotaClient::kIndexedDatabase;
+    if (storage_types & StoragePartition::REMOVE_DATA_MASK_WEBSQL)
+      mask |= storage::QuotaClient::kDatabase;
+    if (storage_types & StoragePartition::REMOVE_DATA_MASK_SERVICE_WORKERS)
+      mask |= storage::QuotaClient::kServiceWorker;
+    if (storage_types & StoragePartition::REMOVE_DATA_MASK_CACHE_STORAGE)
+      mask |= storage::QuotaClient::kServiceWorkerCache;
+    return mask;
+  }
+
+  std::vector<blink::mojom::StorageType> GetQuotaStorageTypes() const {
+    std::vector<blink::mojom::StorageType> types;
+    if (quota_types_ & StoragePartition::QUOTA_MANAGED_STORAGE_MASK_TEMPORARY)
+      types.push_back(blink::mojom::StorageType::kTemporary);
+    if (quota_types_ & StoragePartition::QUOTA_MANAGED_STORAGE_MASK_PERSISTENT)
+      types.push_back(blink::mojom::StorageType::kPersistent);
+    if (quota_types_ & StoragePartition::QUOTA_MANAGED_STORAGE_MASK_SYNCABLE)
+      types.push_back(blink::mojom::StorageType::kSyncable);
+    return types;
+  }
+
+  void ClearData(uint32_t storage_types,
+                 const GURL& origin,
+                 const base::Closure& callback) {
+    storage_partition_->ClearData(
+        storage_types, quota_types_, origin,
+        StoragePartition::OriginMatcherFunction(), base::Time(),
+        base::Time::Max(), callback);
+  }
+
+  void OnPartDone(bool credentials) {
+    ++completed_;
+    if (!progress_.is_null())
+      progress_.Run(completed_, total_);
+    if (credentials && --pending_credentials_ == 0 && defer_purge_)
+      RunCallback();
+    if (completed_ == total_ && !starting_)
+      Finish();
+  }
+
+  void RunCallback() {
+    if (!callback_.is_null())
+      base::ResetAndReturn(&callback_).Run();
+  }
+
+  void Finish() {
+    RunCallback();
+    delete this;
+  }
+
+  StoragePartition* storage_partition_;
+  uint32_t storage_types_;
+  uint32_t quota_types_;
+  std::vector<GURL> origins_;
+  bool defer_purge_;
+  base::Callback<void(int, int)> progress_;
+  base::Closure callback_;
+  int total_ = 0;
+  int completed_ = 0;
+  int pending_credentials_ = 0;
+  bool starting_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(StorageDataRemover);
+};
+
+// Sums up the downloads of |browser_context| that are in progress, a total
+// size is only known for the downloads that reported one.
+DownloadProgress GetDownloadProgressOf(
+    content::BrowserContext* browser_context) {
+  std::vector<download::DownloadItem*> items;
+  content::BrowserContext::GetDownloadManager(browser_context)
+      ->GetAllDownloads(&items);
+  DownloadProgress progress;
+  for (const auto* item : items) {
+    if (item->GetState() != download::DownloadItem::IN_PROGRESS)
+      continue;
+    ++progress.count;
+    progress.received_bytes += item->GetReceivedBytes();
+    progress.total_bytes += item->GetTotalBytes();
+    progress.current_speed += item->CurrentSpeed();
+  }
+  return progress;
 }
 
 void DownloadIdCallback(content::DownloadManager* download_manager,
@@ -341,6 +704,7 @@ void DownloadIdCallback(content::DownloadManager* download_manager,
                         const std::string& last_modified,
                         const std::string& etag,
                         const base::Time& start_time,
+                        const download::DownloadItem::ReceivedSlices& slices,
                         uint32_t id) {
   download_manager->CreateDownloadItem(
       base::GenerateGUID(), id, path, path, url_chain, GURL(), GURL(), GURL(),
@@ -349,7 +713,7 @@ void DownloadIdCallback(content::DownloadManager* download_manager,
       download::DownloadItem::INTERRUPTED,
       download::DOWNLOAD_DANGER_TYPE_NOT_DANGEROUS,
       download::DOWNLOAD_INTERRUPT_REASON_NETWORK_TIMEOUT, false, base::Time(),
-      false, std::vector<download::DownloadItem::ReceivedSlice>());
+      false, slices);
 }
 
 void DestroyGlobalHandle(v8::Isolate* isolate,
@@ -402,6 +766,8 @@ void Session::OnDownloadCreated(content::DownloadManager* manager,
   v8::Locker locker(isolate());
   v8::HandleScope handle_scope(isolate());
   auto handle = DownloadItem::Create(isolate(), item);
+  handle->SetUpdateThrottle(download_update_interval_,
+                            download_update_bytes_);
   if (item->GetState() == download::DownloadItem::INTERRUPTED)
     handle->SetSavePath(item->GetTargetFilePath());
   content::WebContents* web_contents =
@@ -410,15 +776,35 @@ void Session::OnDownloadCreated(content::DownloadManager* manager,
   if (prevent_default) {
     item->Cancel(true);
     item->Remove();
+  } else if (!download_progress_timer_.IsRunning()) {
+    download_progress_timer_.Start(
+        FROM_HERE, kDownloadProgressInterval,
+        base::Bind(&Session::OnDownloadProgressTimer, base::Unretained(this)));
   }
 }
 
+void Session::OnDownloadProgressTimer() {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  DownloadProgress progress = GetDownloadProgressOf(browser_context());
+  Emit("download-progress", progress);
+  // The last event reports that nothing is left to download.
+  if (progress.count == 0)
+    download_progress_timer_.Stop();
+}
+
 void Session::ResolveProxy(
     const GURL& url,
     const ResolveProxyHelper::ResolveProxyCallback& callback) {
   browser_context_->GetResolveProxyHelper()->ResolveProxy(url, callback);
 }
 
+void Session::ResolveProxies(
+    const std::vector<GURL>& urls,
+    const ResolveProxyHelper::ResolveProxiesCallback& callback) {
+  browser_context_->GetResolveProxyHelper()->ResolveProxies(urls, callback);
+}
+
 template <Session::CacheAction action>
 void Session::DoCacheAction(const net::CompletionCallback& callback) {
   BrowserThread::PostTask(
@@ -442,10 +828,7 @@ void Session::ClearStorageData(mate::Arguments* args) {
     // https://w3c.github.io/mediacapture-main/#dom-mediadeviceinfo-deviceid
     MediaDeviceIDSalt::Reset(browser_context()->prefs());
   }
-  storage_partition->ClearData(
-      options.storage_types, options.quota_types, options.origin,
-      content::StoragePartition::OriginMatcherFunction(), base::Time(),
-      base::Time::Max(), base::Bind(&OnClearStorageDataDone, callback));
+  (new StorageDataRemover(storage_partition, options, callback))->Start();
 }
 
 void Session::FlushStorageData() {
@@ -480,6 +863,7 @@ void Session::SetProxy(const mate::Dictionary& options,
         ProxyConfigDictionary::CreateFixedServers(proxy_rules, bypass_list),
         WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
   }
+  browser_context_->GetResolveProxyHelper()->ClearCache();
 
   base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE, callback);
 }
@@ -532,11 +916,18 @@ void Session::SetCertVerifyProc(v8::Local<v8::Value> val,
     return;
   }
 
+  base::TimeDelta cache_duration;
+  mate::Dictionary options;
+  double cache_for = 0;
+  if (args->GetNext(&options) && options.Get("cacheFor", &cache_for) &&
+      cache_for > 0)
+    cache_duration = base::TimeDelta::FromMillisecondsD(cache_for);
+
   BrowserThread::PostTask(
       BrowserThread::IO, FROM_HERE,
       base::BindOnce(&SetCertVerifyProcInIO,
                      WrapRefCounted(browser_context_->GetRequestContext()),
-                     base::Bind(&WrapVerifyProc, proc)));
+                     base::Bind(&WrapVerifyProc, proc), cache_duration));
 }
 
 void Session::SetPermissionRequestHandler(v8::Local<v8::Value> val,
@@ -563,6 +954,12 @@ void Session::SetPermissionCheckHandler(v8::Local<v8::Value> val,
   permission_manager->SetPermissionCheckHandler(handler);
 }
 
+void Session::ClearPermissionCheckCache() {
+  auto* permission_manager = static_cast<AtomPermissionManager*>(
+      browser_context()->GetPermissionControllerDelegate());
+  permission_manager->ClearPermissionCheckCache();
+}
+
 void Session::ClearHostResolverCache(mate::Arguments* args) {
   base::Closure callback;
   args->GetNext(&callback);
@@ -574,6 +971,68 @@ void Session::ClearHostResolverCache(mate::Arguments* args) {
                      callback));
 }
 
+void Session::GetSocketPoolInfo(mate::Arguments* args) {
+  base::Callback<void(const base::DictionaryValue&)> callback;
+  if (!args->GetNext(&callback)) {
+    args->ThrowError("Must pass a callback");
+    return;
+  }
+
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&GetSocketPoolInfoInIO,
+                     WrapRefCounted(static_cast<URLRequestContextGetter*>(
+                         browser_context_->GetRequestContext())),
+                     callback));
+}
+
+void Session::GetCacheStats(mate::Arguments* args) {
+  base::Callback<void(const base::DictionaryValue&)> callback;
+  if (!args->GetNext(&callback)) {
+    args->ThrowError("Must pass a callback");
+    return;
+  }
+
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&GetCacheStatsInIO,
+                     WrapRefCounted(static_cast<URLRequestContextGetter*>(
+                         browser_context_->GetRequestContext())),
+                     callback));
+}
+
+void Session::Preconnect(const mate::Dictionary& options,
+                         mate::Arguments* args) {
+  GURL url;
+  if (!options.Get("url", &url) || !url.is_valid() ||
+      !url.SchemeIsHTTPOrHTTPS()) {
+    args->ThrowError("Must pass an HTTP or HTTPS url");
+    return;
+  }
+  // The same default and limit as the preconnects of Chromium's predictor.
+  int num_sockets = 1;
+  options.Get("numSockets", &num_sockets);
+  if (num_sockets < 1 || num_sockets > 6) {
+    args->ThrowError("numSockets must be between 1 and 6");
+    return;
+  }
+
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&PreconnectInIO,
+                     WrapRefCounted(browser_context_->GetRequestContext()),
+                     url, num_sockets));
+}
+
+void Session::PrefetchDNS(const std::vector<std::string>& hosts) {
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&URLRequestContextGetter::PrefetchDNS,
+                     WrapRefCounted(static_cast<URLRequestContextGetter*>(
+                         browser_context_->GetRequestContext())),
+                     hosts));
+}
+
 void Session::ClearAuthCache(mate::Arguments* args) {
   ClearAuthCacheOptions options;
   if (!args->GetNext(&options)) {
@@ -625,7 +1084,23 @@ void Session::GetBlobData(const std::string& uuid,
   BrowserThread::PostTask(
       BrowserThread::IO, FROM_HERE,
       base::BindOnce(&AtomBlobReader::StartReading,
-                     base::Unretained(blob_reader), uuid, callback));
+                     base::Unretained(blob_reader), uuid, uint64_t{0},
+                     std::numeric_limits<uint64_t>::max(), callback));
+}
+
+void Session::ReadBlobData(const std::string& uuid,
+                           uint64_t offset,
+                           uint64_t length,
+                           const AtomBlobReader::CompletionCallback& callback) {
+  if (callback.is_null())
+    return;
+
+  AtomBlobReader* blob_reader = browser_context()->GetBlobReader();
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&AtomBlobReader::StartReading,
+                     base::Unretained(blob_reader), uuid, offset, length,
+                     callback));
 }
 
 void Session::CreateInterruptedDownload(const mate::Dictionary& options) {
@@ -642,6 +1117,8 @@ void Session::CreateInterruptedDownload(const mate::Dictionary& options) {
   options.Get("lastModified", &last_modified);
   options.Get("eTag", &etag);
   options.Get("startTime", &start_time);
+  download::DownloadItem::ReceivedSlices slices;
+  options.Get("receivedSlices", &slices);
   if (path.empty() || url_chain.empty() || length == 0) {
     isolate()->ThrowException(v8::Exception::Error(mate::StringToV8(
         isolate(), "Must pass non-empty path, urlChain and length.")));
@@ -656,7 +1133,8 @@ void Session::CreateInterruptedDownload(const mate::Dictionary& options) {
       content::BrowserContext::GetDownloadManager(browser_context());
   download_manager->GetDelegate()->GetNextId(base::Bind(
       &DownloadIdCallback, download_manager, path, url_chain, mime_type, offset,
-      length, last_modified, etag, base::Time::FromDoubleT(start_time)));
+      length, last_modified, etag, base::Time::FromDoubleT(start_time),
+      slices));
 }
 
 void Session::SetPreloads(
@@ -672,6 +1150,74 @@ std::vector<base::FilePath::StringType> Session::GetPreloads() const {
   return prefs->preloads();
 }
 
+int Session::AddUserStyleSheet(const std::string& css, mate::Arguments* args) {
+  if (css.empty()) {
+    args->ThrowError("The stylesheet must not be empty");
+    return 0;
+  }
+  bool main_frame_only = false;
+  mate::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("mainFrameOnly", &main_frame_only);
+
+  auto* prefs = SessionPreferences::FromBrowserContext(browser_context());
+  DCHECK(prefs);
+  int id = prefs->AddUserStyleSheet(css, main_frame_only);
+  if (!id)
+    args->ThrowError("Failed to allocate the stylesheet");
+  return id;
+}
+
+bool Session::RemoveUserStyleSheet(int id) {
+  auto* prefs = SessionPreferences::FromBrowserContext(browser_context());
+  DCHECK(prefs);
+  return prefs->RemoveUserStyleSheet(id);
+}
+
+void Session::SetNavigationPolicy(v8::Local<v8::Value> val,
+                                  mate::Arguments* args) {
+  auto* prefs = SessionPreferences::FromBrowserContext(browser_context());
+  DCHECK(prefs);
+  if (val->IsNull()) {
+    prefs->set_navigation_policy(nullptr);
+    return;
+  }
+
+  mate::Dictionary options;
+  if (!mate::ConvertFromV8(isolate(), val, &options)) {
+    args->ThrowError("Must pass an object or null");
+    return;
+  }
+  std::vector<std::string> allow, deny;
+  if ((options.Has("allow") && !options.Get("allow", &allow)) ||
+      (options.Has("deny") && !options.Get("deny", &deny))) {
+    args->ThrowError("allow and deny must be arrays of strings");
+    return;
+  }
+
+  std::string error;
+  auto policy = NavigationPolicy::Create(allow, deny, &error);
+  if (!policy) {
+    args->ThrowError(error);
+    return;
+  }
+  prefs->set_navigation_policy(std::move(policy));
+}
+
+void Session::SetDownloadUpdateThrottle(const mate::Dictionary& options) {
+  int interval = 0;
+  options.Get("interval", &interval);
+  download_update_interval_ =
+      base::TimeDelta::FromMilliseconds(std::max(interval, 0));
+  download_update_bytes_ = 0;
+  options.Get("bytes", &download_update_bytes_);
+  download_update_bytes_ = std::max<int64_t>(download_update_bytes_, 0);
+}
+
+v8::Local<v8::Value> Session::GetDownloadProgress() {
+  return mate::ConvertToV8(isolate(), GetDownloadProgressOf(browser_context()));
+}
+
 v8::Local<v8::Value> Session::Cookies(v8::Isolate* isolate) {
   if (cookies_.IsEmpty()) {
     auto handle = Cookies::Create(isolate, browser_context());
@@ -747,6 +1293,7 @@ void Session::BuildPrototype(v8::Isolate* isolate,
   mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .MakeDestroyable()
       .SetMethod("resolveProxy", &Session::ResolveProxy)
+      .SetMethod("resolveProxies", &Session::ResolveProxies)
       .SetMethod("getCacheSize", &Session::DoCacheAction<CacheAction::STATS>)
       .SetMethod("clearCache", &Session::DoCacheAction<CacheAction::CLEAR>)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
@@ -760,17 +1307,30 @@ void Session::BuildPrototype(v8::Isolate* isolate,
                  &Session::SetPermissionRequestHandler)
       .SetMethod("setPermissionCheckHandler",
                  &Session::SetPermissionCheckHandler)
+      .SetMethod("clearPermissionCheckCache",
+                 &Session::ClearPermissionCheckCache)
       .SetMethod("clearHostResolverCache", &Session::ClearHostResolverCache)
+      .SetMethod("getSocketPoolInfo", &Session::GetSocketPoolInfo)
+      .SetMethod("getCacheStats", &Session::GetCacheStats)
+      .SetMethod("preconnect", &Session::Preconnect)
+      .SetMethod("prefetchDNS", &Session::PrefetchDNS)
       .SetMethod("clearAuthCache", &Session::ClearAuthCache)
       .SetMethod("allowNTLMCredentialsForDomains",
                  &Session::AllowNTLMCredentialsForDomains)
       .SetMethod("setUserAgent", &Session::SetUserAgent)
       .SetMethod("getUserAgent", &Session::GetUserAgent)
       .SetMethod("getBlobData", &Session::GetBlobData)
+      .SetMethod("_readBlobData", &Session::ReadBlobData)
       .SetMethod("createInterruptedDownload",
                  &Session::CreateInterruptedDownload)
       .SetMethod("setPreloads", &Session::SetPreloads)
       .SetMethod("getPreloads", &Session::GetPreloads)
+      .SetMethod("addUserStyleSheet", &Session::AddUserStyleSheet)
+      .SetMethod("removeUserStyleSheet", &Session::RemoveUserStyleSheet)
+      .SetMethod("setNavigationPolicy", &Session::SetNavigationPolicy)
+      .SetMethod("setDownloadUpdateThrottle",
+                 &Session::SetDownloadUpdateThrottle)
+      .SetMethod("getDownloadProgress", &Session::GetDownloadProgress)
       .SetProperty("cookies", &Session::Cookies)
       .SetProperty("netLog", &Session::NetLog)
       .SetProperty("protocol", &Session::Protocol)
@@ -11,6 +11,7 @@
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/atom_blob_reader.h"
 #include "atom/browser/net/resolve_proxy_helper.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "content/public/browser/download_manager.h"
 #include "native_mate/handle.h"
@@ -64,6 +65,9 @@ class Session : public mate::TrackableObject<Session>,
   // Methods.
   void ResolveProxy(const GURL& url,
                     const ResolveProxyHelper::ResolveProxyCallback& callback);
+  void ResolveProxies(
+      const std::vector<GURL>& urls,
+      const ResolveProxyHelper::ResolveProxiesCallback& callback);
   template <CacheAction action>
   void DoCacheAction(const net::CompletionCallback& callback);
   void ClearStorageData(mate::Arguments* args);
@@ -77,16 +81,30 @@ class Session : public mate::TrackableObject<Session>,
                                    mate::Arguments* args);
   void SetPermissionCheckHandler(v8::Local<v8::Value> val,
                                  mate::Arguments* args);
+  void ClearPermissionCheckCache();
   void ClearHostResolverCache(mate::Arguments* args);
+  void GetSocketPoolInfo(mate::Arguments* args);
+  void GetCacheStats(mate::Arguments* args);
+  void Preconnect(const mate::Dictionary& options, mate::Arguments* args);
+  void PrefetchDNS(const std::vector<std::string>& hosts);
   void ClearAuthCache(mate::Arguments* args);
   void AllowNTLMCredentialsForDomains(const std::string& domains);
   void SetUserAgent(const std::string& user_agent, mate::Arguments* args);
   std::string GetUserAgent();
   void GetBlobData(const std::string& uuid,
                    const AtomBlobReader::CompletionCallback& callback);
+  void ReadBlobData(const std::string& uuid,
+                    uint64_t offset,
+                    uint64_t length,
+                    const AtomBlobReader::CompletionCallback& callback);
   void CreateInterruptedDownload(const mate::Dictionary& options);
   void SetPreloads(const std::vector<base::FilePath::StringType>& preloads);
   std::vector<base::FilePath::StringType> GetPreloads() const;
+  int AddUserStyleSheet(const std::string& css, mate::Arguments* args);
+  bool RemoveUserStyleSheet(int id);
+  void SetNavigationPolicy(v8::Local<v8::Value> val, mate::Arguments* args);
+  void SetDownloadUpdateThrottle(const mate::Dictionary& options);
+  v8::Local<v8::Value> GetDownloadProgress();
   v8::Local<v8::Value> Cookies(v8::Isolate* isolate);
   v8::Local<v8::Value> Protocol(v8::Isolate* isolate);
   v8::Local<v8::Value> WebRequest(v8::Isolate* isolate);
@@ -101,6 +119,8 @@ class Session : public mate::TrackableObject<Session>,
                          download::DownloadItem* item) override;
 
  private:
+  void OnDownloadProgressTimer();
+
   // Cached object.
   v8::Global<v8::Value> cookies_;
   v8::Global<v8::Value> protocol_;
@@ -110,6 +130,13 @@ class Session : public mate::TrackableObject<Session>,
   // The client id to enable the network throttler.
   base::UnguessableToken network_emulation_token_;
 
+  // Passed to the DownloadItem of each new download.
+  base::TimeDelta download_update_interval_;
+  int64_t download_update_bytes_ = 0;
+
+  // Emits "download-progress" while there are downloads in progress.
+  base::RepeatingTimer download_progress_timer_;
+
   scoped_refptr<AtomBrowserContext> browser_context_;
 
   DISALLOW_COPY_AND_ASSIGN(Session);
@@ -1116,7 +1116,7 @@ void TopLevelWindow::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setThumbnailToolTip", &TopLevelWindow::SetThumbnailToolTip)
       .SetMethod("setAppDetails", &TopLevelWindow::SetAppDetails)
 #endif
-      .SetProperty("id", &TopLevelWindow::GetID);
+      .SetFastProperty("id", &TopLevelWindow::GetID);
 }
 
 }  // namespace api
@@ -1127,6 +1127,25 @@ namespace {
 
 using atom::api::TopLevelWindow;
 
+void SetBoundsForWindows(const std::vector<mate::Dictionary>& entries,
+                         mate::Arguments* args) {
+  std::vector<atom::NativeWindow::BoundsUpdate> updates;
+  for (const auto& entry : entries) {
+    mate::Handle<TopLevelWindow> window;
+    gfx::Rect bounds;
+    if (!entry.Get("window", &window) || !window->window()) {
+      args->ThrowError("Each entry must have a window");
+      return;
+    }
+    if (!entry.Get("bounds", &bounds)) {
+      args->ThrowError("Each entry must have bounds");
+      return;
+    }
+    updates.emplace_back(window->window(), bounds);
+  }
+  atom::NativeWindow::SetBoundsForWindows(updates);
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -1140,6 +1159,7 @@ void Initialize(v8::Local<v8::Object> exports,
                         &mate::TrackableObject<TopLevelWindow>::FromWeakMapID);
   constructor.SetMethod("getAllWindows",
                         &mate::TrackableObject<TopLevelWindow>::GetAll);
+  constructor.SetMethod("setBoundsForWindows", &SetBoundsForWindows);
 
   mate::Dictionary dict(isolate, exports);
   dict.Set("TopLevelWindow", constructor);
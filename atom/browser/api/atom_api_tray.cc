@@ -4,6 +4,7 @@
 
 #include "atom/browser/api/atom_api_tray.h"
 
+#include <algorithm>
 #include <string>
 
 #include "atom/browser/api/atom_api_menu.h"
@@ -102,38 +103,84 @@ void Tray::OnBalloonClosed() {
 }
 
 void Tray::OnDrop() {
+  if (ignore_drag_events_)
+    return;
   Emit("drop");
 }
 
 void Tray::OnDropFiles(const std::vector<std::string>& files) {
+  if (ignore_drag_events_)
+    return;
   Emit("drop-files", files);
 }
 
 void Tray::OnDropText(const std::string& text) {
+  if (ignore_drag_events_)
+    return;
   Emit("drop-text", text);
 }
 
 void Tray::OnMouseEntered(const gfx::Point& location, int modifiers) {
+  if (ignore_mouse_events_)
+    return;
   EmitWithFlags("mouse-enter", modifiers, location);
 }
 
 void Tray::OnMouseExited(const gfx::Point& location, int modifiers) {
+  if (ignore_mouse_events_)
+    return;
+  // Deliver the coalesced move first so listeners see the final position.
+  if (mouse_move_timer_.IsRunning()) {
+    mouse_move_timer_.Stop();
+    EmitPendingMouseMove();
+  }
   EmitWithFlags("mouse-leave", modifiers, location);
 }
 
 void Tray::OnMouseMoved(const gfx::Point& location, int modifiers) {
-  EmitWithFlags("mouse-move", modifiers, location);
+  if (ignore_mouse_events_)
+    return;
+  if (mouse_move_interval_.is_zero()) {
+    EmitWithFlags("mouse-move", modifiers, location);
+    return;
+  }
+
+  pending_mouse_move_location_ = location;
+  pending_mouse_move_modifiers_ = modifiers;
+  if (mouse_move_timer_.IsRunning())
+    return;
+
+  base::TimeDelta elapsed = base::TimeTicks::Now() - last_mouse_move_time_;
+  if (elapsed >= mouse_move_interval_) {
+    EmitPendingMouseMove();
+  } else {
+    mouse_move_timer_.Start(
+        FROM_HERE, mouse_move_interval_ - elapsed,
+        base::Bind(&Tray::EmitPendingMouseMove, base::Unretained(this)));
+  }
+}
+
+void Tray::EmitPendingMouseMove() {
+  last_mouse_move_time_ = base::TimeTicks::Now();
+  EmitWithFlags("mouse-move", pending_mouse_move_modifiers_,
+                pending_mouse_move_location_);
 }
 
 void Tray::OnDragEntered() {
+  if (ignore_drag_events_)
+    return;
   Emit("drag-enter");
 }
 
 void Tray::OnDragExited() {
+  if (ignore_drag_events_)
+    return;
   Emit("drag-leave");
 }
 
 void Tray::OnDragEnded() {
+  if (ignore_drag_events_)
+    return;
   Emit("drag-end");
 }
 
@@ -180,6 +227,38 @@ bool Tray::GetIgnoreDoubleClickEvents() {
 #endif
 }
 
+void Tray::SetIgnoreMouseEvents(bool ignore) {
+  ignore_mouse_events_ = ignore;
+  if (ignore)
+    mouse_move_timer_.Stop();
+}
+
+bool Tray::GetIgnoreMouseEvents() const {
+  return ignore_mouse_events_;
+}
+
+void Tray::SetIgnoreDragEvents(bool ignore) {
+  ignore_drag_events_ = ignore;
+}
+
+bool Tray::GetIgnoreDragEvents() const {
+  return ignore_drag_events_;
+}
+
+void Tray::SetMouseMoveInterval(double interval_ms) {
+  mouse_move_interval_ =
+      base::TimeDelta::FromMillisecondsD(std::max(interval_ms, 0.0));
+  // Flush a move that was waiting on the old interval.
+  if (mouse_move_timer_.IsRunning()) {
+    mouse_move_timer_.Stop();
+    EmitPendingMouseMove();
+  }
+}
+
+double Tray::GetMouseMoveInterval() const {
+  return mouse_move_interval_.InMillisecondsF();
+}
+
 void Tray::DisplayBalloon(mate::Arguments* args,
                           const mate::Dictionary& options) {
   mate::Handle<NativeImage> icon;
@@ -232,6 +311,12 @@ void Tray::BuildPrototype(v8::Isolate* isolate,
                  &Tray::SetIgnoreDoubleClickEvents)
       .SetMethod("getIgnoreDoubleClickEvents",
                  &Tray::GetIgnoreDoubleClickEvents)
+      .SetMethod("setIgnoreMouseEvents", &Tray::SetIgnoreMouseEvents)
+      .SetMethod("getIgnoreMouseEvents", &Tray::GetIgnoreMouseEvents)
+      .SetMethod("setIgnoreDragEvents", &Tray::SetIgnoreDragEvents)
+      .SetMethod("getIgnoreDragEvents", &Tray::GetIgnoreDragEvents)
+      .SetMethod("setMouseMoveInterval", &Tray::SetMouseMoveInterval)
+      .SetMethod("getMouseMoveInterval", &Tray::GetMouseMoveInterval)
       .SetMethod("displayBalloon", &Tray::DisplayBalloon)
       .SetMethod("popUpContextMenu", &Tray::PopUpContextMenu)
       .SetMethod("setContextMenu", &Tray::SetContextMenu)
@@ -12,6 +12,8 @@
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/ui/tray_icon.h"
 #include "atom/browser/ui/tray_icon_observer.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "native_mate/handle.h"
 
 namespace gfx {
@@ -72,15 +74,36 @@ class Tray : public mate::TrackableObject<Tray>, public TrayIconObserver {
   void SetHighlightMode(TrayIcon::HighlightMode mode);
   void SetIgnoreDoubleClickEvents(bool ignore);
   bool GetIgnoreDoubleClickEvents();
+  void SetIgnoreMouseEvents(bool ignore);
+  bool GetIgnoreMouseEvents() const;
+  void SetIgnoreDragEvents(bool ignore);
+  bool GetIgnoreDragEvents() const;
+  void SetMouseMoveInterval(double interval_ms);
+  double GetMouseMoveInterval() const;
   void DisplayBalloon(mate::Arguments* args, const mate::Dictionary& options);
   void PopUpContextMenu(mate::Arguments* args);
   void SetContextMenu(v8::Isolate* isolate, mate::Handle<Menu> menu);
   gfx::Rect GetBounds();
 
  private:
+  // Emits the latest coalesced 'mouse-move' event.
+  void EmitPendingMouseMove();
+
   v8::Global<v8::Object> menu_;
   std::unique_ptr<TrayIcon> tray_icon_;
 
+  // Event classes that are dropped before reaching JavaScript.
+  bool ignore_mouse_events_ = false;
+  bool ignore_drag_events_ = false;
+
+  // Minimum time between two 'mouse-move' events, moves in between are
+  // coalesced into the last one.
+  base::TimeDelta mouse_move_interval_;
+  base::TimeTicks last_mouse_move_time_;
+  base::OneShotTimer mouse_move_timer_;
+  gfx::Point pending_mouse_move_location_;
+  int pending_mouse_move_modifiers_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(Tray);
 };
 
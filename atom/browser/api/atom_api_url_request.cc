@@ -4,12 +4,14 @@
 
 #include "atom/browser/api/atom_api_url_request.h"
 
+#include <algorithm>
 #include <string>
 
 #include "atom/browser/api/atom_api_session.h"
 #include "atom/browser/net/atom_url_request.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
@@ -20,13 +22,6 @@ namespace mate {
 
 template <>
 struct Converter<scoped_refptr<const net::IOBufferWithSize>> {
-  static v8::Local<v8::Value> ToV8(
-      v8::Isolate* isolate,
-      scoped_refptr<const net::IOBufferWithSize> buffer) {
-    return node::Buffer::Copy(isolate, buffer->data(), buffer->size())
-        .ToLocalChecked();
-  }
-
   static bool FromV8(v8::Isolate* isolate,
                      v8::Local<v8::Value> val,
                      scoped_refptr<const net::IOBufferWithSize>* out) {
@@ -54,11 +49,49 @@ struct Converter<scoped_refptr<const net::IOBufferWithSize>> {
   }
 };
 
+template <>
+struct Converter<net::RequestPriority> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     net::RequestPriority* out) {
+    std::string priority;
+    if (!ConvertFromV8(isolate, val, &priority))
+      return false;
+    if (priority == "throttled")
+      *out = net::THROTTLED;
+    else if (priority == "idle")
+      *out = net::IDLE;
+    else if (priority == "lowest")
+      *out = net::LOWEST;
+    else if (priority == "low")
+      *out = net::LOW;
+    else if (priority == "medium")
+      *out = net::MEDIUM;
+    else if (priority == "highest")
+      *out = net::HIGHEST;
+    else
+      return false;
+    return true;
+  }
+};
+
 }  // namespace mate
 
 namespace atom {
 namespace api {
 
+namespace {
+
+// Size of the reads of the response body, unless "bufferSize" is passed.
+const int kDefaultBufferSize = 4096;
+const int kMaxBufferSize = 16 * 1024 * 1024;
+
+void ReleaseIOBuffer(char* data, void* hint) {
+  static_cast<net::IOBuffer*>(hint)->Release();
+}
+
+}  // namespace
+
 template <typename Flags>
 URLRequest::StateBase<Flags>::StateBase(Flags initialState)
     : state_(initialState) {}
@@ -162,6 +195,11 @@ mate::WrappableBase* URLRequest::New(mate::Arguments* args) {
   dict.Get("url", &url);
   std::string redirect_policy;
   dict.Get("redirect", &redirect_policy);
+  int buffer_size = kDefaultBufferSize;
+  dict.Get("bufferSize", &buffer_size);
+  buffer_size = std::min(std::max(buffer_size, 1), kMaxBufferSize);
+  base::FilePath save_path;
+  dict.Get("savePath", &save_path);
   std::string partition;
   mate::Handle<api::Session> session;
   if (dict.Get("session", &session)) {
@@ -174,10 +212,15 @@ mate::WrappableBase* URLRequest::New(mate::Arguments* args) {
   auto* browser_context = session->browser_context();
   auto* api_url_request = new URLRequest(args->isolate(), args->GetThis());
   auto atom_url_request = AtomURLRequest::Create(
-      browser_context, method, url, redirect_policy, api_url_request);
+      browser_context, method, url, redirect_policy, buffer_size, save_path,
+      api_url_request);
 
   api_url_request->atom_request_ = atom_url_request;
 
+  net::RequestPriority priority;
+  if (dict.Get("priority", &priority))
+    api_url_request->SetPriority(priority);
+
   return api_url_request;
 }
 
@@ -195,6 +238,7 @@ void URLRequest::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setChunkedUpload", &URLRequest::SetChunkedUpload)
       .SetMethod("followRedirect", &URLRequest::FollowRedirect)
       .SetMethod("_setLoadFlags", &URLRequest::SetLoadFlags)
+      .SetMethod("setPriority", &URLRequest::SetPriority)
       .SetMethod("getUploadProgress", &URLRequest::GetUploadProgress)
       .SetProperty("notStarted", &URLRequest::NotStarted)
       .SetProperty("finished", &URLRequest::Finished)
@@ -335,6 +379,17 @@ void URLRequest::SetLoadFlags(int flags) {
   }
 }
 
+void URLRequest::SetPriority(net::RequestPriority priority) {
+  if (request_state_.Canceled() || request_state_.Closed()) {
+    return;
+  }
+
+  DCHECK(atom_request_);
+  if (atom_request_) {
+    atom_request_->SetPriority(priority);
+  }
+}
+
 void URLRequest::OnReceivedRedirect(
     int status_code,
     const std::string& method,
@@ -380,18 +435,27 @@ void URLRequest::OnResponseStarted(
   Emit("response");
 }
 
-void URLRequest::OnResponseData(
-    scoped_refptr<const net::IOBufferWithSize> buffer) {
+void URLRequest::OnResponseData(scoped_refptr<net::IOBuffer> buffer,
+                                int size) {
   if (request_state_.Canceled() || request_state_.Closed() ||
       request_state_.Failed() || response_state_.Failed()) {
     // In case we received an unexpected event from Chromium net,
     // don't emit any data event after request cancel/error/close.
     return;
   }
-  if (!buffer || !buffer->data() || !buffer->size()) {
+  if (!buffer || !buffer->data() || size <= 0) {
+    return;
+  }
+  // The Buffer uses the memory of |buffer| and holds a reference to it until
+  // it is garbage collected.
+  buffer->AddRef();
+  v8::Local<v8::Object> data;
+  if (!node::Buffer::New(isolate(), buffer->data(), size, &ReleaseIOBuffer,
+                         buffer.get())
+           .ToLocal(&data)) {
     return;
   }
-  Emit("data", buffer);
+  Emit("data", data);
 }
 
 void URLRequest::OnResponseCompleted() {
@@ -16,6 +16,7 @@
 #include "native_mate/wrappable_base.h"
 #include "net/base/auth.h"
 #include "net/base/io_buffer.h"
+#include "net/base/request_priority.h"
 #include "net/http/http_response_headers.h"
 #include "net/url_request/url_request_context.h"
 
@@ -109,7 +110,7 @@ class URLRequest : public mate::EventEmitter<URLRequest> {
       scoped_refptr<const net::AuthChallengeInfo> auth_info);
   void OnResponseStarted(
       scoped_refptr<net::HttpResponseHeaders> response_headers);
-  void OnResponseData(scoped_refptr<const net::IOBufferWithSize> data);
+  void OnResponseData(scoped_refptr<net::IOBuffer> data, int size);
   void OnResponseCompleted();
   void OnError(const std::string& error, bool isRequestError);
   mate::Dictionary GetUploadProgress(v8::Isolate* isolate);
@@ -182,6 +183,7 @@ class URLRequest : public mate::EventEmitter<URLRequest> {
   void RemoveExtraHeader(const std::string& name);
   void SetChunkedUpload(bool is_chunked_upload);
   void SetLoadFlags(int flags);
+  void SetPriority(net::RequestPriority priority);
 
   int StatusCode() const;
   std::string StatusMessage() const;
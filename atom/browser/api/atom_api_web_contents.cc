@@ -4,14 +4,20 @@
 
 #include "atom/browser/api/atom_api_web_contents.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "atom/browser/api/atom_api_browser_window.h"
 #include "atom/browser/api/atom_api_debugger.h"
 #include "atom/browser/api/atom_api_session.h"
+#include "atom/browser/api/page_capturer.h"
+#include "atom/browser/api/video_recorder.h"
 #include "atom/browser/atom_browser_client.h"
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/atom_browser_main_parts.h"
@@ -19,9 +25,11 @@
 #include "atom/browser/atom_navigation_throttle.h"
 #include "atom/browser/browser.h"
 #include "atom/browser/child_web_contents_tracker.h"
+#include "atom/browser/console_message_sink.h"
 #include "atom/browser/lib/bluetooth_chooser.h"
 #include "atom/browser/native_window.h"
 #include "atom/browser/net/atom_network_delegate.h"
+#include "atom/browser/session_preferences.h"
 #include "atom/browser/ui/drag_util.h"
 #include "atom/browser/ui/inspectable_web_contents.h"
 #include "atom/browser/ui/inspectable_web_contents_view.h"
@@ -32,8 +40,13 @@
 #include "atom/common/api/api_messages.h"
 #include "atom/common/api/atom_api_native_image.h"
 #include "atom/common/api/event_emitter_caller.h"
+#include "atom/common/bitmap_buffer.h"
 #include "atom/common/color_util.h"
+#include "atom/common/ipc_channel_stats.h"
+#include "atom/common/keyboard_util.h"
+#include "atom/common/mapped_shared_array_buffer.h"
 #include "atom/common/mouse_util.h"
+#include "atom/common/native_mate_converters/accelerator_converter.h"
 #include "atom/common/native_mate_converters/blink_converter.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/content_converter.h"
@@ -46,10 +59,14 @@
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/v8_value_serializer.h"
+#include "base/lazy_instance.h"
+#include "base/memory/unsafe_shared_memory_region.h"
 #include "base/message_loop/message_loop.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/ssl/security_state_tab_helper.h"
@@ -59,6 +76,7 @@
 #include "content/browser/renderer_host/render_widget_host_view_base.h"
 #include "content/common/view_messages.h"
 #include "content/public/browser/child_process_security_policy.h"
+#include "content/public/browser/dom_storage_context.h"
 #include "content/public/browser/download_request_utils.h"
 #include "content/public/browser/favicon_status.h"
 #include "content/public/browser/native_web_keyboard_event.h"
@@ -72,22 +90,28 @@
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/render_widget_host_view.h"
 #include "content/public/browser/service_worker_context.h"
+#include "content/public/browser/session_storage_namespace.h"
+#include "content/public/browser/session_storage_usage_info.h"
 #include "content/public/browser/site_instance.h"
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/context_menu_params.h"
+#include "mojo/public/cpp/system/message_pipe.h"
 #include "native_mate/converter.h"
 #include "native_mate/dictionary.h"
 #include "native_mate/object_template_builder.h"
 #include "net/url_request/url_request_context.h"
 #include "third_party/blink/public/platform/web_input_event.h"
+#include "third_party/blink/public/platform/web_mouse_event.h"
 #include "third_party/blink/public/web/web_find_options.h"
 #include "ui/display/screen.h"
 #include "ui/events/base_event_utils.h"
 
 #if BUILDFLAG(ENABLE_OSR)
+#include "atom/browser/api/atom_api_offscreen_atlas.h"
 #include "atom/browser/osr/osr_output_device.h"
 #include "atom/browser/osr/osr_render_widget_host_view.h"
+#include "atom/browser/osr/osr_shared_texture.h"
 #include "atom/browser/osr/osr_web_contents_view.h"
 #endif
 
@@ -239,6 +263,17 @@ namespace api {
 
 namespace {
 
+// The channels of ipcMain and of the internal ipcMain that have listeners.
+base::LazyInstance<std::unordered_set<std::string>>::Leaky
+    g_ipc_main_channels = LAZY_INSTANCE_INITIALIZER;
+base::LazyInstance<std::unordered_set<std::string>>::Leaky
+    g_ipc_main_internal_channels = LAZY_INSTANCE_INITIALIZER;
+
+std::unordered_set<std::string>* GetListenedChannels(bool internal) {
+  return internal ? g_ipc_main_internal_channels.Pointer()
+                  : g_ipc_main_channels.Pointer();
+}
+
 content::ServiceWorkerContext* GetServiceWorkerContext(
     const content::WebContents* web_contents) {
   auto* context = web_contents->GetBrowserContext();
@@ -254,6 +289,15 @@ content::ServiceWorkerContext* GetServiceWorkerContext(
   return storage_partition->GetServiceWorkerContext();
 }
 
+// Returns the accelerator that |event| triggers, key ups map to the same
+// accelerator as their key downs.
+ui::Accelerator AcceleratorFromKeyboardEvent(
+    const content::NativeWebKeyboardEvent& event) {
+  return ui::Accelerator(
+      static_cast<ui::KeyboardCode>(event.windows_key_code),
+      WebEventModifiersToEventFlags(event.GetModifiers()));
+}
+
 // Called when CapturePage is done.
 void OnCapturePageDone(const base::Callback<void(const gfx::Image&)>& callback,
                        const SkBitmap& bitmap) {
@@ -263,6 +307,92 @@ void OnCapturePageDone(const base::Callback<void(const gfx::Image&)>& callback,
   callback.Run(gfx::Image::CreateFrom1xBitmap(bitmap));
 }
 
+// Called when CapturePageRegions is done.
+void OnCapturePageRegionsDone(
+    v8::Isolate* isolate,
+    const base::Callback<void(v8::Local<v8::Value>)>& callback,
+    const PageCapturer::Images& images) {
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Array> buffers = v8::Array::New(isolate, images.size());
+  for (size_t i = 0; i < images.size(); ++i) {
+    v8::Local<v8::Value> buffer = v8::Null(isolate);
+    if (!images[i].empty())
+      buffer = node::Buffer::Copy(
+                   isolate, reinterpret_cast<const char*>(images[i].data()),
+                   images[i].size())
+                   .ToLocalChecked();
+    buffers->Set(static_cast<uint32_t>(i), buffer);
+  }
+  callback.Run(buffers);
+}
+
+// Each event of sendInputEvents is packed as
+// [type, x, y, modifiers, timestamp].
+const size_t kPackedEventFields = 5;
+
+// Converts a packed event into a mouse event, returns false when the type or
+// the modifiers are unknown.
+bool PackedEventToMouseEvent(const double* fields,
+                             base::TimeTicks time_stamp,
+                             blink::WebMouseEvent* out) {
+  static const blink::WebInputEvent::Type kTypes[] = {
+      blink::WebInputEvent::kMouseMove, blink::WebInputEvent::kMouseDown,
+      blink::WebInputEvent::kMouseUp, blink::WebInputEvent::kMouseEnter,
+      blink::WebInputEvent::kMouseLeave,
+  };
+  static const int kModifiers[] = {
+      blink::WebInputEvent::kShiftKey,
+      blink::WebInputEvent::kControlKey,
+      blink::WebInputEvent::kAltKey,
+      blink::WebInputEvent::kMetaKey,
+      blink::WebInputEvent::kLeftButtonDown,
+      blink::WebInputEvent::kMiddleButtonDown,
+      blink::WebInputEvent::kRightButtonDown,
+  };
+
+  double type = fields[0];
+  if (!(type >= 0 && type < arraysize(kTypes)) || type != std::floor(type))
+    return false;
+  double bits = fields[3];
+  if (!(bits >= 0 && bits < (1 << arraysize(kModifiers))) ||
+      bits != std::floor(bits))
+    return false;
+
+  int modifiers = 0;
+  for (size_t i = 0; i < arraysize(kModifiers); ++i) {
+    if (static_cast<int>(bits) & (1 << i))
+      modifiers |= kModifiers[i];
+  }
+
+  *out = blink::WebMouseEvent(kTypes[static_cast<size_t>(type)], modifiers,
+                              time_stamp);
+  out->SetPositionInWidget(fields[1], fields[2]);
+  out->pointer_type = blink::WebPointerProperties::PointerType::kMouse;
+  if (out->GetType() == blink::WebInputEvent::kMouseDown ||
+      out->GetType() == blink::WebInputEvent::kMouseUp) {
+    // The pressed button is taken from the modifiers, defaults to left.
+    if (modifiers & blink::WebInputEvent::kRightButtonDown)
+      out->button = blink::WebMouseEvent::Button::kRight;
+    else if (modifiers & blink::WebInputEvent::kMiddleButtonDown)
+      out->button = blink::WebMouseEvent::Button::kMiddle;
+    else
+      out->button = blink::WebMouseEvent::Button::kLeft;
+    out->click_count = 1;
+  }
+  return true;
+}
+
+void DeleteSessionStorage(
+    content::DOMStorageContext* dom_storage,
+    const std::string& namespace_id,
+    const std::vector<content::SessionStorageUsageInfo>& infos) {
+  for (const auto& info : infos) {
+    if (info.namespace_id == namespace_id)
+      dom_storage->DeleteSessionStorage(info);
+  }
+}
+
 }  // namespace
 
 struct WebContents::FrameDispatchHelper {
@@ -288,7 +418,9 @@ struct WebContents::FrameDispatchHelper {
 
 WebContents::WebContents(v8::Isolate* isolate,
                          content::WebContents* web_contents)
-    : content::WebContentsObserver(web_contents), type_(REMOTE) {
+    : content::WebContentsObserver(web_contents),
+      type_(REMOTE),
+      weak_factory_(this) {
   web_contents->SetUserAgentOverride(GetBrowserContext()->GetUserAgent(),
                                      false);
   Init(isolate);
@@ -299,7 +431,9 @@ WebContents::WebContents(v8::Isolate* isolate,
 WebContents::WebContents(v8::Isolate* isolate,
                          std::unique_ptr<content::WebContents> web_contents,
                          Type type)
-    : content::WebContentsObserver(web_contents.get()), type_(type) {
+    : content::WebContentsObserver(web_contents.get()),
+      type_(type),
+      weak_factory_(this) {
   DCHECK(type != REMOTE) << "Can't take ownership of a remote WebContents";
   auto session = Session::CreateFrom(isolate, GetBrowserContext());
   session_.Reset(isolate, session.ToV8());
@@ -308,7 +442,8 @@ WebContents::WebContents(v8::Isolate* isolate,
 }
 
 WebContents::WebContents(v8::Isolate* isolate,
-                         const mate::Dictionary& options) {
+                         const mate::Dictionary& options)
+    : weak_factory_(this) {
   // Read options.
   options.Get("backgroundThrottling", &background_throttling_);
 
@@ -361,7 +496,8 @@ WebContents::WebContents(v8::Isolate* isolate,
 #if BUILDFLAG(ENABLE_OSR)
     if (embedder_ && embedder_->IsOffScreen()) {
       auto* view = new OffScreenWebContentsView(
-          false, base::Bind(&WebContents::OnPaint, base::Unretained(this)));
+          false, base::Bind(&WebContents::OnPaint, base::Unretained(this)),
+          OnTexturePaintCallback(), OnPaintRegionsCallback());
       params.view = view;
       params.delegate_view = view;
 
@@ -375,10 +511,20 @@ WebContents::WebContents(v8::Isolate* isolate,
   } else if (IsOffScreen()) {
     bool transparent = false;
     options.Get("transparent", &transparent);
+    bool shared_texture = false;
+    options.Get(options::kSharedTexture, &shared_texture);
+    bool paint_regions = false;
+    options.Get(options::kPaintRegions, &paint_regions);
 
     content::WebContents::CreateParams params(session->browser_context());
     auto* view = new OffScreenWebContentsView(
-        transparent, base::Bind(&WebContents::OnPaint, base::Unretained(this)));
+        transparent, base::Bind(&WebContents::OnPaint, base::Unretained(this)),
+        shared_texture ? base::Bind(&WebContents::OnTexturePaint,
+                                    base::Unretained(this))
+                       : OnTexturePaintCallback(),
+        paint_regions ? base::Bind(&WebContents::OnPaintRegions,
+                                   base::Unretained(this))
+                      : OnPaintRegionsCallback());
     params.view = view;
     params.delegate_view = view;
 
@@ -463,6 +609,9 @@ void WebContents::InitWithSessionAndOptions(
 }
 
 WebContents::~WebContents() {
+#if BUILDFLAG(ENABLE_OSR)
+  SetPaintAtlas(base::WeakPtr<OffscreenAtlas>());
+#endif
   // The destroy() is called.
   if (managed_web_contents()) {
     managed_web_contents()->GetView()->SetDelegate(nullptr);
@@ -509,6 +658,17 @@ bool WebContents::DidAddMessageToConsole(content::WebContents* source,
                                          const base::string16& message,
                                          int32_t line_no,
                                          const base::string16& source_id) {
+  if (console_message_sink_) {
+    switch (console_message_sink_->AddMessage(level, message, line_no,
+                                              source_id)) {
+      case ConsoleMessageSink::Result::kDropped:
+        return false;
+      case ConsoleMessageSink::Result::kQueued:
+        return true;
+      case ConsoleMessageSink::Result::kPassThrough:
+        break;
+    }
+  }
   return Emit("console-message", level, message, line_no, source_id);
 }
 
@@ -571,9 +731,19 @@ content::WebContents* WebContents::OpenURLFromTab(
     return nullptr;
   }
 
-  // Give user a chance to cancel navigation.
-  if (Emit("will-navigate", params.url))
-    return nullptr;
+  // The navigation policy of the session decides without asking JS, otherwise
+  // give user a chance to cancel navigation.
+  switch (SessionPreferences::EvaluateNavigation(GetBrowserContext(),
+                                                 params.url)) {
+    case NavigationPolicy::Decision::ALLOW:
+      break;
+    case NavigationPolicy::Decision::DENY:
+      return nullptr;
+    case NavigationPolicy::Decision::UNMATCHED:
+      if (Emit("will-navigate", params.url))
+        return nullptr;
+      break;
+  }
 
   // Don't load the URL if the web contents was marked as destroyed from a
   // will-navigate event listener
@@ -634,6 +804,11 @@ content::KeyboardEventProcessingResult WebContents::PreHandleKeyboardEvent(
     const content::NativeWebKeyboardEvent& event) {
   if (event.GetType() == blink::WebInputEvent::Type::kRawKeyDown ||
       event.GetType() == blink::WebInputEvent::Type::kKeyUp) {
+    // Keys that do not match the filter go to the page without entering JS.
+    if (input_event_filter_ &&
+        !input_event_filter_->count(AcceleratorFromKeyboardEvent(event)))
+      return content::KeyboardEventProcessingResult::NOT_HANDLED;
+
     bool prevent_default = Emit("before-input-event", event);
     if (prevent_default) {
       return content::KeyboardEventProcessingResult::HANDLED;
@@ -779,6 +954,10 @@ void WebContents::RenderViewCreated(content::RenderViewHost* render_view_host) {
       render_view_host->GetRoutingID());
   if (impl)
     impl->disable_hidden_ = !background_throttling_;
+
+  // The page is being restored from hibernation.
+  hibernated_ = false;
+  hibernation_snapshot_ = gfx::Image();
 }
 
 void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
@@ -786,6 +965,9 @@ void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
 }
 
 void WebContents::RenderProcessGone(base::TerminationStatus status) {
+  // Releasing the renderer on hibernate() is not a crash.
+  if (hibernated_)
+    return;
   Emit("crashed", status == base::TERMINATION_STATUS_PROCESS_WAS_KILLED);
 }
 
@@ -901,6 +1083,8 @@ void WebContents::DidFinishNavigation(
   if (frame_host) {
     frame_process_id = frame_host->GetProcess()->GetID();
     frame_routing_id = frame_host->GetRoutingID();
+    if (!navigation_handle->IsSameDocument())
+      DropPendingInvokes(frame_process_id, frame_routing_id);
   }
   if (!navigation_handle->IsErrorPage()) {
     auto url = navigation_handle->GetURL();
@@ -1043,11 +1227,16 @@ bool WebContents::OnMessageReceived(const IPC::Message& message,
                                     content::RenderFrameHost* frame_host) {
   bool handled = true;
   FrameDispatchHelper helper = {this, frame_host};
+  received_message_size_ = message.size();
   IPC_BEGIN_MESSAGE_MAP_WITH_PARAM(WebContents, message, frame_host)
     IPC_MESSAGE_HANDLER(AtomFrameHostMsg_Message, OnRendererMessage)
+    IPC_MESSAGE_HANDLER(AtomFrameHostMsg_Message_Serialized,
+                        OnRendererMessageSerialized)
     IPC_MESSAGE_FORWARD_DELAY_REPLY(AtomFrameHostMsg_Message_Sync, &helper,
                                     FrameDispatchHelper::OnRendererMessageSync)
     IPC_MESSAGE_HANDLER(AtomFrameHostMsg_Message_To, OnRendererMessageTo)
+    IPC_MESSAGE_HANDLER(AtomFrameHostMsg_Invoke, OnRendererInvoke)
+    IPC_MESSAGE_HANDLER(AtomFrameHostMsg_OpenPort, OnRendererOpenPort)
     IPC_MESSAGE_FORWARD_DELAY_REPLY(
         AtomFrameHostMsg_SetTemporaryZoomLevel, &helper,
         FrameDispatchHelper::OnSetTemporaryZoomLevel)
@@ -1107,11 +1296,15 @@ void WebContents::NavigationEntryCommitted(
 void WebContents::SetBackgroundThrottling(bool allowed) {
   background_throttling_ = allowed;
 
-  const auto* contents = web_contents();
+  auto* contents = web_contents();
   if (!contents) {
     return;
   }
 
+  // The page should keep running while hidden, so bring it back.
+  if (!allowed && hibernated_)
+    contents->GetController().LoadIfNecessary();
+
   const auto* render_view_host = contents->GetRenderViewHost();
   if (!render_view_host) {
     return;
@@ -1135,6 +1328,107 @@ void WebContents::SetBackgroundThrottling(bool allowed) {
   }
 }
 
+bool WebContents::GetBackgroundThrottling() const {
+  return background_throttling_;
+}
+
+void WebContents::Hibernate(mate::Arguments* args) {
+  base::Callback<void(bool)> callback;
+  if (args->Length() > 0 && !args->GetNext(&callback)) {
+    args->ThrowError("Callback must be a function");
+    return;
+  }
+  if (callback.is_null())
+    callback = base::Bind([](bool) {});
+
+  // A page that disabled background throttling wants to keep running while
+  // hidden, and a visible page would show its crashed state.
+  auto* const view = web_contents()->GetRenderWidgetHostView();
+  if (hibernated_ || hibernating_ || !background_throttling_ || !view ||
+      web_contents()->GetVisibility() == content::Visibility::VISIBLE) {
+    callback.Run(false);
+    return;
+  }
+
+  hibernating_ = true;
+  view->CopyFromSurface(
+      gfx::Rect(view->GetViewBounds().size()), gfx::Size(),
+      base::BindOnce(&WebContents::OnHibernationSnapshot,
+                     weak_factory_.GetWeakPtr(), callback));
+}
+
+void WebContents::OnHibernationSnapshot(
+    const base::Callback<void(bool)>& callback,
+    const SkBitmap& bitmap) {
+  TRACE_EVENT0("electron", "WebContents::OnHibernationSnapshot");
+  // Only a process that hosts nothing but this page and has no unload
+  // handlers to run can be released.
+  hibernating_ = false;
+  hibernated_ = true;
+  auto* process = web_contents()->GetMainFrame()->GetProcess();
+  if (!process->FastShutdownIfPossible(1, false)) {
+    hibernated_ = false;
+    callback.Run(false);
+    return;
+  }
+  hibernation_snapshot_ = gfx::Image::CreateFrom1xBitmap(bitmap);
+
+  // The navigation entries keep the page state, including the scroll
+  // position, and the page is loaded from them once it is shown again.
+  web_contents()->GetController().SetNeedsReload();
+  callback.Run(true);
+}
+
+bool WebContents::IsHibernated() const {
+  return hibernated_;
+}
+
+gfx::Image WebContents::GetHibernationSnapshot() const {
+  return hibernation_snapshot_;
+}
+
+void WebContents::SetConsoleMessageOptions(mate::Arguments* args) {
+  v8::Local<v8::Value> peek = args->PeekNext();
+  if (!peek.IsEmpty() && peek->IsNull()) {
+    console_message_sink_.reset();
+    return;
+  }
+
+  mate::Dictionary dict;
+  if (!args->GetNext(&dict)) {
+    args->ThrowError("Must pass an object or null");
+    return;
+  }
+
+  ConsoleMessageSink::Options options;
+  std::string min_level;
+  if (dict.Get("minLevel", &min_level)) {
+    static const char* const kLevels[] = {"verbose", "info", "warning",
+                                          "error"};
+    auto* it = std::find(std::begin(kLevels), std::end(kLevels), min_level);
+    if (it == std::end(kLevels)) {
+      args->ThrowError("Unknown console message level: " + min_level);
+      return;
+    }
+    options.min_level = it - std::begin(kLevels);
+  }
+  dict.Get("sources", &options.sources);
+  int batch_interval = 0;
+  if (dict.Get("batchInterval", &batch_interval) && batch_interval > 0)
+    options.batch_interval = base::TimeDelta::FromMilliseconds(batch_interval);
+  dict.Get("path", &options.path);
+
+  console_message_sink_ = std::make_unique<ConsoleMessageSink>(
+      options, base::Bind(&WebContents::OnConsoleMessages,
+                          base::Unretained(this)));
+}
+
+void WebContents::OnConsoleMessages(const base::ListValue& messages) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  Emit("console-messages", messages);
+}
+
 int WebContents::GetProcessID() const {
   return web_contents()->GetMainFrame()->GetProcess()->GetID();
 }
@@ -1442,8 +1736,22 @@ void WebContents::UnregisterServiceWorker(
 void WebContents::SetIgnoreMenuShortcuts(bool ignore) {
   auto* web_preferences = WebContentsPreferences::From(web_contents());
   DCHECK(web_preferences);
-  web_preferences->preference()->SetKey("ignoreMenuShortcuts",
-                                        base::Value(ignore));
+  web_preferences->SetPreference("ignoreMenuShortcuts", base::Value(ignore));
+}
+
+void WebContents::SetInputEventFilter(mate::Arguments* args) {
+  v8::Local<v8::Value> peek = args->PeekNext();
+  if (!peek.IsEmpty() && peek->IsNull()) {
+    input_event_filter_.reset();
+    return;
+  }
+
+  std::vector<ui::Accelerator> accelerators;
+  if (!args->GetNext(&accelerators)) {
+    args->ThrowError("Must pass an array of accelerators or null");
+    return;
+  }
+  input_event_filter_.emplace(accelerators.begin(), accelerators.end());
 }
 
 void WebContents::SetAudioMuted(bool muted) {
@@ -1460,7 +1768,7 @@ bool WebContents::IsCurrentlyAudible() {
 
 #if BUILDFLAG(ENABLE_PRINTING)
 void WebContents::Print(mate::Arguments* args) {
-  bool silent, print_background = false;
+  bool silent = false, print_background = false;
   base::string16 device_name;
   mate::Dictionary options = mate::Dictionary::CreateEmpty(args->isolate());
   base::DictionaryValue settings;
@@ -1484,6 +1792,8 @@ void WebContents::Print(mate::Arguments* args) {
   auto* rfh = focused_frame && focused_frame->HasSelection()
                   ? focused_frame
                   : web_contents()->GetMainFrame();
+  // The callback also runs, with false, when printing can not be started, the
+  // dialog is cancelled or printing fails.
   print_view_manager->PrintNow(
       rfh,
       std::make_unique<PrintMsg_PrintPages>(rfh->GetRoutingID(), silent,
@@ -1505,9 +1815,10 @@ std::vector<printing::PrinterBasicInfo> WebContents::GetPrinterList() {
 
 void WebContents::PrintToPDF(
     const base::DictionaryValue& settings,
+    const base::FilePath& output_path,
     const PrintPreviewMessageHandler::PrintToPDFCallback& callback) {
   PrintPreviewMessageHandler::FromWebContents(web_contents())
-      ->PrintToPDF(settings, callback);
+      ->PrintToPDF(settings, output_path, callback);
 }
 #endif
 
@@ -1644,13 +1955,122 @@ bool WebContents::SendIPCMessageWithSender(bool internal,
                                            int32_t sender_id) {
   auto* frame_host = web_contents()->GetMainFrame();
   if (frame_host) {
-    return frame_host->Send(new AtomFrameMsg_Message(frame_host->GetRoutingID(),
-                                                     internal, send_to_all,
-                                                     channel, args, sender_id));
+    auto* message =
+        new AtomFrameMsg_Message(frame_host->GetRoutingID(), internal,
+                                 send_to_all, channel, args, sender_id);
+    IPCChannelStats::GetInstance()->Record(IPCChannelStats::Direction::kSent,
+                                           channel, message->size());
+    return frame_host->Send(message);
   }
   return false;
 }
 
+bool WebContents::SendIPCMessageSerialized(
+    bool internal,
+    bool send_to_all,
+    const std::string& channel,
+    v8::Local<v8::Value> args,
+    const std::vector<v8::Local<v8::Value>>& transfer) {
+  std::vector<uint8_t> data;
+  std::vector<base::UnsafeSharedMemoryRegion> array_buffers;
+  if (!SerializeV8Value(isolate(), args, transfer, &data, &array_buffers))
+    return false;
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (frame_host) {
+    auto* message = new AtomFrameMsg_Message_Serialized(
+        frame_host->GetRoutingID(), internal, send_to_all, channel, data,
+        array_buffers, 0);
+    IPCChannelStats::GetInstance()->Record(IPCChannelStats::Direction::kSent,
+                                           channel, message->size());
+    return frame_host->Send(message);
+  }
+  return false;
+}
+
+v8::Local<v8::Value> WebContents::CreateSharedRingBuffer(
+    const std::string& channel,
+    int32_t ring_id,
+    uint32_t size,
+    mate::Arguments* args) {
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host) {
+    args->ThrowError("The webContents has no frame to share the ring with");
+    return v8::Null(isolate());
+  }
+
+  base::UnsafeSharedMemoryRegion region =
+      base::UnsafeSharedMemoryRegion::Create(size);
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid()) {
+    args->ThrowError("Unable to allocate the shared memory of the ring");
+    return v8::Null(isolate());
+  }
+
+  frame_host->Send(new AtomFrameMsg_SharedRing(frame_host->GetRoutingID(),
+                                               channel, ring_id, region));
+  return CreateMappedSharedArrayBuffer(isolate(), std::move(mapping));
+}
+
+bool WebContents::RingDoorbell(int32_t ring_id) {
+  auto* frame_host = web_contents()->GetMainFrame();
+  return frame_host && frame_host->Send(new AtomFrameMsg_SharedRingDoorbell(
+                           frame_host->GetRoutingID(), ring_id));
+}
+
+void WebContents::CloseSharedRing(int32_t ring_id) {
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (frame_host) {
+    frame_host->Send(new AtomFrameMsg_SharedRingClose(
+        frame_host->GetRoutingID(), ring_id));
+  }
+}
+
+void WebContents::ClearSessionStorage() {
+  content::SessionStorageNamespace* session_storage =
+      web_contents()->GetController().GetDefaultSessionStorageNamespace();
+  content::DOMStorageContext* dom_storage =
+      content::BrowserContext::GetStoragePartition(
+          GetBrowserContext(), web_contents()->GetSiteInstance())
+          ->GetDOMStorageContext();
+  // The storage partition lives as long as the browser context.
+  dom_storage->GetSessionStorageUsage(
+      base::BindOnce(&DeleteSessionStorage, base::Unretained(dom_storage),
+                     session_storage->id()));
+}
+
+void WebContents::ReplyToInvoke(int invoke_id,
+                                bool success,
+                                const base::ListValue& result) {
+  auto it = pending_invokes_.find(invoke_id);
+  if (it == pending_invokes_.end())
+    return;
+  PendingInvoke pending = it->second;
+  pending_invokes_.erase(it);
+
+  // The frame may have gone away while the handler was running.
+  auto* frame_host =
+      content::RenderFrameHost::FromID(pending.process_id, pending.routing_id);
+  if (frame_host) {
+    frame_host->Send(new AtomFrameMsg_InvokeReply(
+        pending.routing_id, pending.request_id, success, result));
+  }
+}
+
+void WebContents::DropPendingInvokes(int process_id, int routing_id) {
+  for (auto it = pending_invokes_.begin(); it != pending_invokes_.end();) {
+    if (it->second.process_id == process_id &&
+        it->second.routing_id == routing_id)
+      it = pending_invokes_.erase(it);
+    else
+      ++it;
+  }
+}
+
+void WebContents::RouteAllIPCMessages() {
+  route_all_ipc_messages_ = true;
+}
+
 void WebContents::SendInputEvent(v8::Isolate* isolate,
                                  v8::Local<v8::Value> input_event) {
   content::RenderWidgetHostView* view =
@@ -1700,24 +2120,139 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
       v8::Exception::Error(mate::StringToV8(isolate, "Invalid event object")));
 }
 
+void WebContents::SendInputEvents(mate::Arguments* args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value) || !value->IsFloat64Array()) {
+    args->ThrowError("Must pass a Float64Array");
+    return;
+  }
+
+  auto array = value.As<v8::Float64Array>();
+  size_t length = array->Length();
+  if (length % kPackedEventFields != 0) {
+    args->ThrowError("The length must be a multiple of 5");
+    return;
+  }
+  std::vector<double> fields(length);
+  array->CopyContents(fields.data(), length * sizeof(double));
+
+  // The timestamps are only meaningful relative to each other, the last event
+  // is stamped with the current time and the others keep their distance to
+  // it so the input router coalesces them like real input.
+  std::vector<blink::WebMouseEvent> events(length / kPackedEventFields);
+  base::TimeTicks now = ui::EventTimeForNow();
+  double last_timestamp = length ? fields[length - 1] : 0;
+  for (size_t i = 0; i < events.size(); ++i) {
+    const double* event_fields = &fields[i * kPackedEventFields];
+    double delta = last_timestamp - event_fields[4];
+    if (!std::isfinite(delta) ||
+        !PackedEventToMouseEvent(
+            event_fields,
+            now - base::TimeDelta::FromMillisecondsD(std::max(0.0, delta)),
+            &events[i])) {
+      args->ThrowError("Invalid event at index " + std::to_string(i));
+      return;
+    }
+  }
+
+  content::RenderWidgetHostView* view =
+      web_contents()->GetRenderWidgetHostView();
+  if (!view)
+    return;
+
+  content::RenderWidgetHost* rwh = view->GetRenderWidgetHost();
+  for (const auto& mouse_event : events) {
+    if (IsOffScreen()) {
+#if BUILDFLAG(ENABLE_OSR)
+      GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
+#endif
+    } else {
+      rwh->ForwardMouseEvent(mouse_event);
+    }
+  }
+}
+
 void WebContents::BeginFrameSubscription(mate::Arguments* args) {
-  bool only_dirty = false;
+  FrameSubscriber::Options options;
   FrameSubscriber::FrameCaptureCallback callback;
 
-  args->GetNext(&only_dirty);
+  mate::Dictionary dict;
+  if (!args->PeekNext().IsEmpty() && !args->PeekNext()->IsFunction() &&
+      args->GetNext(&dict)) {
+    // The frames of the pool are only copied with the old signature.
+    options.pooled = true;
+    std::string format;
+    if (dict.Get("format", &format)) {
+      if (format == "i420") {
+        options.format = media::PIXEL_FORMAT_I420;
+      } else if (format != "bgra") {
+        args->ThrowError("Unsupported frame format: " + format);
+        return;
+      }
+    }
+    int width, height;
+    if (dict.Get("width", &width) && dict.Get("height", &height))
+      options.size = gfx::Size(width, height);
+    dict.Get("frameRate", &options.frame_rate);
+    options.frame_rate = std::max(options.frame_rate, 1.0);
+  } else {
+    args->GetNext(&options.only_dirty);
+  }
+
   if (!args->GetNext(&callback)) {
     args->ThrowError();
     return;
   }
 
   frame_subscriber_.reset(
-      new FrameSubscriber(isolate(), web_contents(), callback, only_dirty));
+      new FrameSubscriber(isolate(), web_contents(), options, callback));
 }
 
 void WebContents::EndFrameSubscription() {
   frame_subscriber_.reset();
 }
 
+void WebContents::BeginRecording(mate::Arguments* args) {
+  mate::Dictionary options;
+  VideoRecorder::ChunkCallback chunk_callback;
+  VideoRecorder::ErrorCallback error_callback;
+  if (!args->GetNext(&options) || !args->GetNext(&chunk_callback) ||
+      !args->GetNext(&error_callback)) {
+    args->ThrowError();
+    return;
+  }
+
+  VideoRecorder::Options recorder_options;
+  auto* view = static_cast<content::RenderWidgetHostViewBase*>(
+      web_contents()->GetRenderWidgetHostView());
+  if (view)
+    recorder_options.size = view->GetCompositorViewportPixelSize();
+  int width, height;
+  if (options.Get("width", &width) && options.Get("height", &height))
+    recorder_options.size = gfx::Size(width, height);
+  options.Get("bitrate", &recorder_options.bitrate);
+  options.Get("frameRate", &recorder_options.frame_rate);
+  options.Get("keyFrameInterval", &recorder_options.key_frame_interval);
+  if (recorder_options.frame_rate <= 0 ||
+      recorder_options.key_frame_interval <= 0) {
+    args->ThrowError("frameRate and keyFrameInterval must be positive");
+    return;
+  }
+
+  EndRecording();
+  video_recorder_.reset(new VideoRecorder(isolate(), web_contents(),
+                                          recorder_options, chunk_callback,
+                                          error_callback));
+}
+
+void WebContents::EndRecording() {
+  // May be called from the callbacks of the recorder.
+  if (video_recorder_) {
+    base::ThreadTaskRunnerHandle::Get()->DeleteSoon(FROM_HERE,
+                                                    video_recorder_.release());
+  }
+}
+
 void WebContents::StartDrag(const mate::Dictionary& item,
                             mate::Arguments* args) {
   base::FilePath file;
@@ -1790,6 +2325,48 @@ void WebContents::CapturePage(mate::Arguments* args) {
                         base::BindOnce(&OnCapturePageDone, callback));
 }
 
+void WebContents::CapturePageRegions(mate::Arguments* args) {
+  std::vector<gfx::Rect> regions;
+  mate::Dictionary options;
+  base::Callback<void(v8::Local<v8::Value>)> callback;
+  if (!args->GetNext(&regions) || !args->GetNext(&options) ||
+      !args->GetNext(&callback)) {
+    args->ThrowError();
+    return;
+  }
+
+  PageCapturer::Options capture_options;
+  std::string encoding;
+  if (options.Get("encoding", &encoding)) {
+    if (encoding == "jpeg") {
+      capture_options.encoding = PageCapturer::Encoding::JPEG;
+    } else if (encoding == "webp") {
+      capture_options.encoding = PageCapturer::Encoding::WEBP;
+    } else if (encoding != "png") {
+      args->ThrowError("Unsupported image encoding: " + encoding);
+      return;
+    }
+  }
+  options.Get("quality", &capture_options.quality);
+  capture_options.quality = std::max(0, std::min(capture_options.quality, 100));
+
+  auto* const view = web_contents()->GetRenderWidgetHostView();
+  if (!options.Get("scaleFactor", &capture_options.scale_factor) && view) {
+    capture_options.scale_factor =
+        display::Screen::GetScreen()
+            ->GetDisplayNearestView(view->GetNativeView())
+            .device_scale_factor();
+  }
+  if (capture_options.scale_factor <= 0) {
+    args->ThrowError("scaleFactor must be positive");
+    return;
+  }
+
+  PageCapturer::Capture(
+      view, regions, capture_options,
+      base::BindOnce(&OnCapturePageRegionsDone, isolate(), callback));
+}
+
 void WebContents::OnCursorChange(const content::WebCursor& cursor) {
   content::CursorInfo info;
   cursor.GetCursorInfo(&info);
@@ -1825,7 +2402,56 @@ bool WebContents::IsOffScreen() const {
 
 #if BUILDFLAG(ENABLE_OSR)
 void WebContents::OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap) {
-  Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+  if (paint_atlas_) {
+    paint_atlas_->OnMemberPaint(ID(), dirty_rect, bitmap);
+    return;
+  }
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  // The pixels of the frame are reused once the event has been handled, even
+  // when the image has not been collected yet.
+  auto image = NativeImage::Create(isolate(),
+                                   gfx::Image::CreateFrom1xBitmap(bitmap));
+  image->MarkPixelsTransient();
+  Emit("paint", dirty_rect, image);
+  image->ReleasePixels();
+}
+
+void WebContents::SetPaintAtlas(base::WeakPtr<OffscreenAtlas> atlas) {
+  if (paint_atlas_ && paint_atlas_.get() != atlas.get())
+    paint_atlas_->RemoveMember(ID());
+  paint_atlas_ = atlas;
+}
+
+void WebContents::OnPaintRegions(
+    const std::vector<OffScreenPaintRegion>& regions) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  std::vector<mate::Dictionary> values;
+  values.reserve(regions.size());
+  for (const auto& region : regions) {
+    mate::Dictionary value = mate::Dictionary::CreateEmpty(isolate());
+    value.Set("rect", region.rect);
+    value.Set("buffer", CreateBitmapBuffer(isolate(), region.bitmap));
+    values.push_back(value);
+  }
+  Emit("paint-regions", values);
+}
+
+void WebContents::OnTexturePaint(const gfx::Rect& dirty_rect,
+                                 const OffScreenSharedTextureFrame& frame,
+                                 const base::Closure& release) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  mate::Dictionary texture = mate::Dictionary::CreateEmpty(isolate());
+  texture.Set("type", frame.type);
+  texture.Set("handle", node::Buffer::Copy(isolate(), frame.handle.data(),
+                                           frame.handle.size())
+                            .ToLocalChecked());
+  texture.Set("width", frame.size.width());
+  texture.Set("height", frame.size.height());
+  texture.Set("release", release);
+  Emit("paint", dirty_rect, gfx::Image(), texture);
 }
 
 void WebContents::StartPainting() {
@@ -1845,16 +2471,28 @@ bool WebContents::IsPainting() const {
   return osr_wcv && osr_wcv->IsPainting();
 }
 
-void WebContents::SetFrameRate(int frame_rate) {
+void WebContents::SetFrameRate(double frame_rate) {
   auto* osr_wcv = GetOffScreenWebContentsView();
   if (osr_wcv)
     osr_wcv->SetFrameRate(frame_rate);
 }
 
-int WebContents::GetFrameRate() const {
+double WebContents::GetFrameRate() const {
   auto* osr_wcv = GetOffScreenWebContentsView();
   return osr_wcv ? osr_wcv->GetFrameRate() : 0;
 }
+
+void WebContents::SetExternalBeginFrames(bool enabled) {
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (osr_wcv)
+    osr_wcv->SetExternalBeginFrames(enabled);
+}
+
+void WebContents::SendBeginFrame() {
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (osr_wcv)
+    osr_wcv->SendExternalBeginFrame();
+}
 #endif
 
 void WebContents::Invalidate() {
@@ -2044,6 +2682,45 @@ bool WebContents::TakeHeapSnapshot(const base::FilePath& file_path,
       IPC::TakePlatformFileForTransit(std::move(file)), channel));
 }
 
+bool WebContents::StartHeapSampling(int sample_interval, int stack_depth) {
+  if (sample_interval <= 0 || stack_depth <= 0)
+    return false;
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host)
+    return false;
+
+  return frame_host->Send(new AtomFrameMsg_StartHeapSampling(
+      frame_host->GetRoutingID(), sample_interval, stack_depth));
+}
+
+bool WebContents::StopHeapSampling(const base::FilePath& file_path,
+                                   const std::string& channel) {
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+
+  base::File file(file_path,
+                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  if (!file.IsValid())
+    return false;
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host)
+    return false;
+
+  return frame_host->Send(new AtomFrameMsg_StopHeapSampling(
+      frame_host->GetRoutingID(),
+      IPC::TakePlatformFileForTransit(std::move(file)), channel));
+}
+
+bool WebContents::PurgeMemory(bool critical, const std::string& channel) {
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive())
+    return false;
+
+  return frame_host->Send(new AtomFrameMsg_PurgeMemory(
+      frame_host->GetRoutingID(), critical, channel));
+}
+
 // static
 void WebContents::BuildPrototype(v8::Isolate* isolate,
                                  v8::Local<v8::FunctionTemplate> prototype) {
@@ -2052,21 +2729,29 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .MakeDestroyable()
       .SetMethod("setBackgroundThrottling",
                  &WebContents::SetBackgroundThrottling)
-      .SetMethod("getProcessId", &WebContents::GetProcessID)
-      .SetMethod("getOSProcessId", &WebContents::GetOSProcessID)
+      .SetMethod("setConsoleMessageOptions",
+                 &WebContents::SetConsoleMessageOptions)
+      .SetMethod("getBackgroundThrottling",
+                 &WebContents::GetBackgroundThrottling)
+      .SetMethod("hibernate", &WebContents::Hibernate)
+      .SetMethod("isHibernated", &WebContents::IsHibernated)
+      .SetMethod("getHibernationSnapshot",
+                 &WebContents::GetHibernationSnapshot)
+      .SetFastMethod("getProcessId", &WebContents::GetProcessID)
+      .SetFastMethod("getOSProcessId", &WebContents::GetOSProcessID)
       .SetMethod("equal", &WebContents::Equal)
       .SetMethod("_loadURL", &WebContents::LoadURL)
       .SetMethod("downloadURL", &WebContents::DownloadURL)
-      .SetMethod("_getURL", &WebContents::GetURL)
+      .SetFastMethod("_getURL", &WebContents::GetURL)
       .SetMethod("getTitle", &WebContents::GetTitle)
-      .SetMethod("isLoading", &WebContents::IsLoading)
-      .SetMethod("isLoadingMainFrame", &WebContents::IsLoadingMainFrame)
-      .SetMethod("isWaitingForResponse", &WebContents::IsWaitingForResponse)
+      .SetFastMethod("isLoading", &WebContents::IsLoading)
+      .SetFastMethod("isLoadingMainFrame", &WebContents::IsLoadingMainFrame)
+      .SetFastMethod("isWaitingForResponse", &WebContents::IsWaitingForResponse)
       .SetMethod("_stop", &WebContents::Stop)
       .SetMethod("_goBack", &WebContents::GoBack)
       .SetMethod("_goForward", &WebContents::GoForward)
       .SetMethod("_goToOffset", &WebContents::GoToOffset)
-      .SetMethod("isCrashed", &WebContents::IsCrashed)
+      .SetFastMethod("isCrashed", &WebContents::IsCrashed)
       .SetMethod("setUserAgent", &WebContents::SetUserAgent)
       .SetMethod("getUserAgent", &WebContents::GetUserAgent)
       .SetMethod("savePage", &WebContents::SavePage)
@@ -2079,6 +2764,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("toggleDevTools", &WebContents::ToggleDevTools)
       .SetMethod("inspectElement", &WebContents::InspectElement)
       .SetMethod("setIgnoreMenuShortcuts", &WebContents::SetIgnoreMenuShortcuts)
+      .SetMethod("setInputEventFilter", &WebContents::SetInputEventFilter)
       .SetMethod("setAudioMuted", &WebContents::SetAudioMuted)
       .SetMethod("isAudioMuted", &WebContents::IsAudioMuted)
       .SetMethod("isCurrentlyAudible", &WebContents::IsCurrentlyAudible)
@@ -2099,9 +2785,20 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("isFocused", &WebContents::IsFocused)
       .SetMethod("tabTraverse", &WebContents::TabTraverse)
       .SetMethod("_send", &WebContents::SendIPCMessage)
+      .SetMethod("_sendSerialized", &WebContents::SendIPCMessageSerialized)
+      .SetMethod("_replyToInvoke", &WebContents::ReplyToInvoke)
+      .SetMethod("_routeAllIPCMessages", &WebContents::RouteAllIPCMessages)
+      .SetMethod("_createSharedRingBuffer",
+                 &WebContents::CreateSharedRingBuffer)
+      .SetMethod("_ringDoorbell", &WebContents::RingDoorbell)
+      .SetMethod("_closeSharedRing", &WebContents::CloseSharedRing)
+      .SetMethod("_clearSessionStorage", &WebContents::ClearSessionStorage)
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
+      .SetMethod("sendInputEvents", &WebContents::SendInputEvents)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
+      .SetMethod("_beginRecording", &WebContents::BeginRecording)
+      .SetMethod("_endRecording", &WebContents::EndRecording)
       .SetMethod("startDrag", &WebContents::StartDrag)
       .SetMethod("isGuest", &WebContents::IsGuest)
       .SetMethod("attachToIframe", &WebContents::AttachToIframe)
@@ -2112,6 +2809,8 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("isPainting", &WebContents::IsPainting)
       .SetMethod("setFrameRate", &WebContents::SetFrameRate)
       .SetMethod("getFrameRate", &WebContents::GetFrameRate)
+      .SetMethod("setExternalBeginFrames", &WebContents::SetExternalBeginFrames)
+      .SetMethod("sendBeginFrame", &WebContents::SendBeginFrame)
 #endif
       .SetMethod("invalidate", &WebContents::Invalidate)
       .SetMethod("setZoomLevel", &WebContents::SetZoomLevel)
@@ -2139,6 +2838,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::ShowDefinitionForSelection)
       .SetMethod("copyImageAt", &WebContents::CopyImageAt)
       .SetMethod("capturePage", &WebContents::CapturePage)
+      .SetMethod("_capturePageRegions", &WebContents::CapturePageRegions)
       .SetMethod("setEmbedder", &WebContents::SetEmbedder)
       .SetMethod("setDevToolsWebContents", &WebContents::SetDevToolsWebContents)
       .SetMethod("getNativeView", &WebContents::GetNativeView)
@@ -2148,7 +2848,10 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("_grantOriginAccess", &WebContents::GrantOriginAccess)
       .SetMethod("_takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
-      .SetProperty("id", &WebContents::ID)
+      .SetMethod("_startHeapSampling", &WebContents::StartHeapSampling)
+      .SetMethod("_stopHeapSampling", &WebContents::StopHeapSampling)
+      .SetMethod("_purgeMemory", &WebContents::PurgeMemory)
+      .SetFastProperty("id", &WebContents::ID)
       .SetProperty("session", &WebContents::Session)
       .SetProperty("hostWebContents", &WebContents::HostWebContents)
       .SetProperty("devToolsWebContents", &WebContents::DevToolsWebContents)
@@ -2162,16 +2865,107 @@ AtomBrowserContext* WebContents::GetBrowserContext() const {
 void WebContents::OnRendererMessage(content::RenderFrameHost* frame_host,
                                     const std::string& channel,
                                     const base::ListValue& args) {
+  TRACE_EVENT1("electron", "WebContents::OnRendererMessage", "channel",
+               channel);
+  base::TimeTicks start = base::TimeTicks::Now();
   // webContents.emit(channel, new Event(), args...);
-  Emit(channel, args);
+  if (ShouldEmitIPCMessage(channel, args))
+    Emit(channel, args);
+  RecordReceivedMessage(IPCChannelStats::GetChannelName(channel, args), start);
+}
+
+void WebContents::OnRendererMessageSerialized(
+    content::RenderFrameHost* frame_host,
+    const std::string& channel,
+    const std::vector<uint8_t>& args,
+    const std::vector<base::UnsafeSharedMemoryRegion>& array_buffers) {
+  TRACE_EVENT1("electron", "WebContents::OnRendererMessageSerialized",
+               "channel", channel);
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  base::TimeTicks start = base::TimeTicks::Now();
+  v8::Local<v8::Value> value;
+  if (DeserializeV8Value(isolate(), args, array_buffers, &value))
+    Emit(channel, value);
+  RecordReceivedMessage(channel, start);
 }
 
 void WebContents::OnRendererMessageSync(content::RenderFrameHost* frame_host,
                                         const std::string& channel,
                                         const base::ListValue& args,
                                         IPC::Message* message) {
+  TRACE_EVENT1("electron", "WebContents::OnRendererMessageSync", "channel",
+               channel);
+  base::TimeTicks start = base::TimeTicks::Now();
   // webContents.emit(channel, new Event(sender, message), args...);
   EmitWithSender(channel, frame_host, message, args);
+  RecordReceivedMessage(IPCChannelStats::GetChannelName(channel, args), start);
+}
+
+void WebContents::OnRendererInvoke(content::RenderFrameHost* frame_host,
+                                   int request_id,
+                                   const std::string& channel,
+                                   const base::ListValue& args) {
+  TRACE_EVENT1("electron", "WebContents::OnRendererInvoke", "channel",
+               channel);
+  int invoke_id = ++next_invoke_id_;
+  pending_invokes_[invoke_id] = {frame_host->GetProcess()->GetID(),
+                                 frame_host->GetRoutingID(), request_id};
+  base::TimeTicks start = base::TimeTicks::Now();
+  // webContents.emit('-ipc-invoke', new Event(), invokeId, channel, args);
+  Emit("-ipc-invoke", invoke_id, channel, args);
+  RecordReceivedMessage(channel, start);
+}
+
+bool WebContents::ShouldEmitIPCMessage(const std::string& event_name,
+                                       const base::ListValue& args) const {
+  bool internal;
+  if (event_name == "ipc-message")
+    internal = false;
+  else if (event_name == "ipc-internal-message")
+    internal = true;
+  else
+    return true;
+
+  if (route_all_ipc_messages_)
+    return true;
+  const auto& list = args.GetList();
+  if (list.empty() || !list[0].is_string())
+    return true;
+  return GetListenedChannels(internal)->count(list[0].GetString()) > 0;
+}
+
+void WebContents::RecordReceivedMessage(const std::string& channel,
+                                        base::TimeTicks start) {
+  IPCChannelStats::GetInstance()->Record(
+      IPCChannelStats::Direction::kReceived, channel, received_message_size_,
+      base::TimeTicks::Now() - start);
+}
+
+void WebContents::OnRendererOpenPort(content::RenderFrameHost* frame_host,
+                                     int request_id,
+                                     int32_t web_contents_id,
+                                     const std::string& channel) {
+  auto* web_contents = mate::TrackableObject<WebContents>::FromWeakMapID(
+      isolate(), web_contents_id);
+  content::RenderFrameHost* target =
+      web_contents ? web_contents->web_contents()->GetMainFrame() : nullptr;
+  if (!target) {
+    frame_host->Send(new AtomFrameMsg_Port(frame_host->GetRoutingID(),
+                                           request_id, channel,
+                                           web_contents_id,
+                                           mojo::MessagePipeHandle()));
+    return;
+  }
+
+  // The browser only hands out the two ends, messages posted to the ports
+  // then go directly from one renderer to the other.
+  mojo::MessagePipe pipe;
+  frame_host->Send(new AtomFrameMsg_Port(frame_host->GetRoutingID(),
+                                         request_id, channel, web_contents_id,
+                                         pipe.handle0.release()));
+  target->Send(new AtomFrameMsg_Port(target->GetRoutingID(), 0, channel, ID(),
+                                     pipe.handle1.release()));
 }
 
 void WebContents::OnRendererMessageTo(content::RenderFrameHost* frame_host,
@@ -2195,6 +2989,17 @@ mate::Handle<WebContents> WebContents::Create(v8::Isolate* isolate,
   return mate::CreateHandle(isolate, new WebContents(isolate, options));
 }
 
+// static
+void WebContents::SetIPCChannelListened(bool internal,
+                                        const std::string& channel,
+                                        bool listened) {
+  auto* channels = GetListenedChannels(internal);
+  if (listened)
+    channels->insert(channel);
+  else
+    channels->erase(channel);
+}
+
 // static
 mate::Handle<WebContents> WebContents::CreateAndTake(
     v8::Isolate* isolate,
@@ -2234,6 +3039,23 @@ namespace {
 
 using atom::api::WebContents;
 
+// The devtools WebContents kept after closing their devtools are left out.
+v8::Local<v8::Array> GetAllWebContents(v8::Isolate* isolate) {
+  v8::Local<v8::Array> result = v8::Array::New(isolate);
+  uint32_t index = 0;
+  mate::TrackableObject<WebContents>::ForEach(
+      isolate, [&](v8::Local<v8::Object> object) {
+        WebContents* contents = nullptr;
+        if (mate::ConvertFromV8(isolate, object, &contents) &&
+            contents->web_contents() &&
+            atom::InspectableWebContents::IsParkedDevTools(
+                contents->web_contents()))
+          return;
+        result->Set(index++, object);
+      });
+  return result;
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -2243,8 +3065,9 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.Set("WebContents", WebContents::GetConstructor(isolate)->GetFunction());
   dict.SetMethod("create", &WebContents::Create);
   dict.SetMethod("fromId", &mate::TrackableObject<WebContents>::FromWeakMapID);
-  dict.SetMethod("getAllWebContents",
-                 &mate::TrackableObject<WebContents>::GetAll);
+  dict.SetMethod("getAllWebContents", &GetAllWebContents);
+  dict.SetMethod("_setIPCChannelListened",
+                 &WebContents::SetIPCChannelListened);
 }
 
 }  // namespace
@@ -5,7 +5,9 @@
 #ifndef ATOM_BROWSER_API_ATOM_API_WEB_CONTENTS_H_
 #define ATOM_BROWSER_API_ATOM_API_WEB_CONTENTS_H_
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -14,7 +16,9 @@
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/common_web_contents_delegate.h"
 #include "atom/browser/ui/autofill_popup.h"
+#include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
+#include "base/optional.h"
 #include "content/common/cursors/webcursor.h"
 #include "content/public/browser/keyboard_event_processing_result.h"
 #include "content/public/browser/web_contents.h"
@@ -23,6 +27,7 @@
 #include "electron/buildflags/buildflags.h"
 #include "native_mate/handle.h"
 #include "printing/buildflags/buildflags.h"
+#include "ui/base/accelerators/accelerator.h"
 #include "ui/gfx/image/image.h"
 
 #if BUILDFLAG(ENABLE_PRINTING)
@@ -47,17 +52,25 @@ namespace atom {
 
 class AtomBrowserContext;
 class AtomJavaScriptDialogManager;
+class ConsoleMessageSink;
 class InspectableWebContents;
 class WebContentsZoomController;
 class WebViewGuestDelegate;
 class FrameSubscriber;
+class VideoRecorder;
 
 #if BUILDFLAG(ENABLE_OSR)
 class OffScreenWebContentsView;
+struct OffScreenPaintRegion;
+struct OffScreenSharedTextureFrame;
 #endif
 
 namespace api {
 
+#if BUILDFLAG(ENABLE_OSR)
+class OffscreenAtlas;
+#endif
+
 // Certain events are only in WebContentsDelegate, provide our own Observer to
 // dispatch those events.
 class ExtendedWebContentsObserver {
@@ -107,6 +120,13 @@ class WebContents : public mate::TrackableObject<WebContents>,
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype);
 
+  // Tells whether ipcMain (or the internal ipcMain when |internal|) has
+  // listeners for |channel|, messages sent to channels without listeners are
+  // dropped before their arguments are converted.
+  static void SetIPCChannelListened(bool internal,
+                                    const std::string& channel,
+                                    bool listened);
+
   // Destroy the managed content::WebContents instance.
   //
   // Note: The |async| should only be |true| when users are expecting to use the
@@ -123,6 +143,11 @@ class WebContents : public mate::TrackableObject<WebContents>,
   void DestroyWebContents(bool async);
 
   void SetBackgroundThrottling(bool allowed);
+  bool GetBackgroundThrottling() const;
+  void Hibernate(mate::Arguments* args);
+  bool IsHibernated() const;
+  gfx::Image GetHibernationSnapshot() const;
+  void SetConsoleMessageOptions(mate::Arguments* args);
   int GetProcessID() const;
   base::ProcessId GetOSProcessID() const;
   Type GetType() const;
@@ -160,6 +185,7 @@ class WebContents : public mate::TrackableObject<WebContents>,
   void HasServiceWorker(const base::Callback<void(bool)>&);
   void UnregisterServiceWorker(const base::Callback<void(bool)>&);
   void SetIgnoreMenuShortcuts(bool ignore);
+  void SetInputEventFilter(mate::Arguments* args);
   void SetAudioMuted(bool muted);
   bool IsAudioMuted();
   bool IsCurrentlyAudible();
@@ -173,6 +199,7 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // Print current page as PDF.
   void PrintToPDF(
       const base::DictionaryValue& settings,
+      const base::FilePath& output_path,
       const PrintPreviewMessageHandler::PrintToPDFCallback& callback);
 #endif
 
@@ -214,12 +241,49 @@ class WebContents : public mate::TrackableObject<WebContents>,
                                 const base::ListValue& args,
                                 int32_t sender_id = 0);
 
+  // Same with SendIPCMessage, but |args| is cloned with v8::ValueSerializer
+  // and the ArrayBuffers in |transfer| are moved to the renderer.
+  bool SendIPCMessageSerialized(
+      bool internal,
+      bool send_to_all,
+      const std::string& channel,
+      v8::Local<v8::Value> args,
+      const std::vector<v8::Local<v8::Value>>& transfer);
+
+  // Creates a SharedArrayBuffer of |size| bytes in shared memory and sends it
+  // to the main frame with AtomFrameMsg_SharedRing. The memory stays mapped
+  // until the SharedArrayBuffer is garbage collected.
+  v8::Local<v8::Value> CreateSharedRingBuffer(const std::string& channel,
+                                              int32_t ring_id,
+                                              uint32_t size,
+                                              mate::Arguments* args);
+  bool RingDoorbell(int32_t ring_id);
+  // Tells the main frame that the ring will not be written anymore.
+  void CloseSharedRing(int32_t ring_id);
+
+  // Deletes the sessionStorage of all the origins loaded in this WebContents.
+  void ClearSessionStorage();
+
+  // Answers an AtomFrameHostMsg_Invoke with the result of the ipcMain handler.
+  void ReplyToInvoke(int invoke_id,
+                     bool success,
+                     const base::ListValue& result);
+
+  // Emits messages of all channels, for when the "ipc-message" events of this
+  // webContents are listened to directly.
+  void RouteAllIPCMessages();
+
   // Send WebInputEvent to the page.
   void SendInputEvent(v8::Isolate* isolate, v8::Local<v8::Value> input_event);
 
+  // Send a batch of mouse events packed in a Float64Array to the page.
+  void SendInputEvents(mate::Arguments* args);
+
   // Subscribe to the frame updates.
   void BeginFrameSubscription(mate::Arguments* args);
   void EndFrameSubscription();
+  void BeginRecording(mate::Arguments* args);
+  void EndRecording();
 
   // Dragging native items.
   void StartDrag(const mate::Dictionary& item, mate::Arguments* args);
@@ -228,6 +292,10 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // done.
   void CapturePage(mate::Arguments* args);
 
+  // Captures several regions of the page and encodes them off the UI thread,
+  // |callback| is called with the encoded images.
+  void CapturePageRegions(mate::Arguments* args);
+
   // Methods for creating <webview>.
   bool IsGuest() const;
   void AttachToIframe(content::WebContents* embedder_web_contents,
@@ -237,11 +305,19 @@ class WebContents : public mate::TrackableObject<WebContents>,
   bool IsOffScreen() const;
 #if BUILDFLAG(ENABLE_OSR)
   void OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap);
+  void OnPaintRegions(const std::vector<OffScreenPaintRegion>& regions);
+  void OnTexturePaint(const gfx::Rect& dirty_rect,
+                      const OffScreenSharedTextureFrame& frame,
+                      const base::Closure& release);
   void StartPainting();
   void StopPainting();
   bool IsPainting() const;
-  void SetFrameRate(int frame_rate);
-  int GetFrameRate() const;
+  void SetFrameRate(double frame_rate);
+  double GetFrameRate() const;
+  void SetExternalBeginFrames(bool enabled);
+  void SendBeginFrame();
+  // Paints go to |atlas| instead of the "paint" event while it is set.
+  void SetPaintAtlas(base::WeakPtr<OffscreenAtlas> atlas);
 #endif
   void Invalidate();
   gfx::Size GetSizeForNewRenderView(content::WebContents*) const override;
@@ -284,6 +360,10 @@ class WebContents : public mate::TrackableObject<WebContents>,
 
   bool TakeHeapSnapshot(const base::FilePath& file_path,
                         const std::string& channel);
+  bool StartHeapSampling(int sample_interval, int stack_depth);
+  bool StopHeapSampling(const base::FilePath& file_path,
+                        const std::string& channel);
+  bool PurgeMemory(bool critical, const std::string& channel);
 
   // Properties.
   int32_t ID() const;
@@ -452,6 +532,18 @@ class WebContents : public mate::TrackableObject<WebContents>,
 
  private:
   struct FrameDispatchHelper;
+
+  // The renderer side of an invocation waiting for its reply.
+  struct PendingInvoke {
+    int process_id;
+    int routing_id;
+    int request_id;
+  };
+
+  // Forgets the invocations of a frame that has a new document, their replies
+  // are not for it.
+  void DropPendingInvokes(int process_id, int routing_id);
+
   AtomBrowserContext* GetBrowserContext() const;
 
   uint32_t GetNextRequestId() { return ++request_id_; }
@@ -470,12 +562,39 @@ class WebContents : public mate::TrackableObject<WebContents>,
                          const std::string& channel,
                          const base::ListValue& args);
 
+  // Called when received a message cloned by v8::ValueSerializer.
+  void OnRendererMessageSerialized(
+      content::RenderFrameHost* frame_host,
+      const std::string& channel,
+      const std::vector<uint8_t>& args,
+      const std::vector<base::UnsafeSharedMemoryRegion>& array_buffers);
+
   // Called when received a synchronous message from renderer.
   void OnRendererMessageSync(content::RenderFrameHost* frame_host,
                              const std::string& channel,
                              const base::ListValue& args,
                              IPC::Message* message);
 
+  // Called when the renderer invokes a handler of ipcMain.
+  void OnRendererInvoke(content::RenderFrameHost* frame_host,
+                        int request_id,
+                        const std::string& channel,
+                        const base::ListValue& args);
+
+  // Called when the renderer opens a port to another webContents.
+  void OnRendererOpenPort(content::RenderFrameHost* frame_host,
+                          int request_id,
+                          int32_t web_contents_id,
+                          const std::string& channel);
+
+  // Whether the message |args| sent as |event_name| has any listener.
+  bool ShouldEmitIPCMessage(const std::string& event_name,
+                            const base::ListValue& args) const;
+
+  // Counts a message from the renderer whose handler started at |start|.
+  void RecordReceivedMessage(const std::string& channel,
+                             base::TimeTicks start);
+
   // Called when received a message from renderer to be forwarded.
   void OnRendererMessageTo(content::RenderFrameHost* frame_host,
                            bool internal,
@@ -498,6 +617,13 @@ class WebContents : public mate::TrackableObject<WebContents>,
   void InitZoomController(content::WebContents* web_contents,
                           const mate::Dictionary& options);
 
+  // Releases the renderer process once the last frame has been captured.
+  void OnHibernationSnapshot(const base::Callback<void(bool)>& callback,
+                             const SkBitmap& bitmap);
+
+  // Called by |console_message_sink_| with a batch of console messages.
+  void OnConsoleMessages(const base::ListValue& messages);
+
   v8::Global<v8::Value> session_;
   v8::Global<v8::Value> devtools_web_contents_;
   v8::Global<v8::Value> debugger_;
@@ -505,6 +631,8 @@ class WebContents : public mate::TrackableObject<WebContents>,
   std::unique_ptr<AtomJavaScriptDialogManager> dialog_manager_;
   std::unique_ptr<WebViewGuestDelegate> guest_delegate_;
   std::unique_ptr<FrameSubscriber> frame_subscriber_;
+  std::unique_ptr<VideoRecorder> video_recorder_;
+  std::unique_ptr<ConsoleMessageSink> console_message_sink_;
 
   // The host webcontents that may contain this webcontents.
   WebContents* embedder_ = nullptr;
@@ -518,15 +646,42 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // Request id used for findInPage request.
   uint32_t request_id_ = 0;
 
+  // Invocations from all frames waiting for ipcMain handlers, the renderer's
+  // request ids are only unique per frame so they are keyed by our own ids.
+  std::map<int, PendingInvoke> pending_invokes_;
+  int next_invoke_id_ = 0;
+
+  // The size of the IPC message being dispatched, for IPCChannelStats.
+  size_t received_message_size_ = 0;
+
+  // Whether messages are emitted even when ipcMain does not listen to them.
+  bool route_all_ipc_messages_ = false;
+
   // Whether background throttling is disabled.
   bool background_throttling_ = true;
 
+  // Whether the renderer has been released by hibernate(), the page is then
+  // loaded again from its navigation entry when it is shown.
+  bool hibernated_ = false;
+  bool hibernating_ = false;
+  gfx::Image hibernation_snapshot_;
+
   // Whether to enable devtools.
   bool enable_devtools_ = true;
 
+  // The keys that emit before-input-event, all keys do when unset.
+  base::Optional<std::set<ui::Accelerator>> input_event_filter_;
+
+#if BUILDFLAG(ENABLE_OSR)
+  // The atlas this offscreen WebContents paints into.
+  base::WeakPtr<OffscreenAtlas> paint_atlas_;
+#endif
+
   // Observers of this WebContents.
   base::ObserverList<ExtendedWebContentsObserver> observers_;
 
+  base::WeakPtrFactory<WebContents> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(WebContents);
 };
 
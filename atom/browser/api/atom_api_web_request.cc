@@ -4,12 +4,19 @@
 
 #include "atom/browser/api/atom_api_web_request.h"
 
+#include <memory>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/net/atom_network_delegate.h"
+#include "atom/browser/net/request_log_writer.h"
+#include "atom/browser/net/web_request_details.h"
+#include "atom/browser/net/web_request_rule.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "content/public/browser/browser_thread.h"
@@ -33,6 +40,101 @@ struct Converter<URLPattern> {
   }
 };
 
+template <>
+struct Converter<atom::WebRequestDetails> {
+  using HeadersType = atom::WebRequestDetails::HeadersType;
+
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const atom::WebRequestDetails& val) {
+    auto details = ConvertToV8(isolate, val.dict()).As<v8::Object>();
+    auto context = isolate->GetCurrentContext();
+    for (const auto& headers : val.lazy_headers()) {
+      // The raw headers are stored byte by byte in the property data.
+      auto raw = v8::String::NewFromOneByte(
+                     isolate, reinterpret_cast<const uint8_t*>(
+                                  headers.raw.data()),
+                     v8::NewStringType::kNormal, headers.raw.size())
+                     .ToLocalChecked();
+      auto getter = headers.type == HeadersType::REQUEST
+                        ? &GetHeaders<HeadersType::REQUEST>
+                        : &GetHeaders<HeadersType::RESPONSE>;
+      details
+          ->SetLazyDataProperty(context, StringToV8(isolate, headers.key),
+                                getter, raw)
+          .ToChecked();
+    }
+    return details;
+  }
+
+  template <HeadersType type>
+  static void GetHeaders(v8::Local<v8::Name> name,
+                         const v8::PropertyCallbackInfo<v8::Value>& info) {
+    auto data = info.Data().As<v8::String>();
+    std::string raw(data->Length(), '\0');
+    data->WriteOneByte(reinterpret_cast<uint8_t*>(&raw[0]), 0, raw.size());
+    info.GetReturnValue().Set(ConvertToV8(
+        info.GetIsolate(), *atom::WebRequestDetails::ParseHeaders(type, raw)));
+  }
+};
+
+template <>
+struct Converter<atom::WebRequestRule> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     atom::WebRequestRule* out) {
+    mate::Dictionary dict;
+    if (!ConvertFromV8(isolate, val, &dict))
+      return false;
+    // The optional properties must be valid when they are present.
+    std::set<URLPattern> url_patterns;
+    std::string redirect_url;
+    base::DictionaryValue request_headers, response_headers;
+    if (!GetOptional(dict, "urls", &url_patterns) ||
+        !GetOptional(dict, "resourceTypes", &out->resource_types) ||
+        !GetOptional(dict, "cancel", &out->cancel) ||
+        !GetOptional(dict, "redirectURL", &redirect_url) ||
+        !GetOptional(dict, "requestHeaders", &request_headers) ||
+        !GetOptional(dict, "responseHeaders", &response_headers))
+      return false;
+    out->url_matcher = atom::URLPatternMatcher(url_patterns);
+    if (!redirect_url.empty()) {
+      out->redirect_url = GURL(redirect_url);
+      if (!out->redirect_url.is_valid())
+        return false;
+    }
+    return ReadHeaders(request_headers, &out->set_request_headers,
+                       &out->remove_request_headers) &&
+           ReadHeaders(response_headers, &out->set_response_headers,
+                       &out->remove_response_headers);
+  }
+
+  template <typename T>
+  static bool GetOptional(const mate::Dictionary& dict,
+                          base::StringPiece key,
+                          T* out) {
+    v8::Local<v8::Value> value;
+    if (!dict.Get(key, &value) || value->IsUndefined())
+      return true;
+    return ConvertFromV8(dict.isolate(), value, out);
+  }
+
+  // A header with a null value is removed, the others are set.
+  static bool ReadHeaders(const base::DictionaryValue& headers,
+                          atom::WebRequestRule::Headers* set_headers,
+                          std::vector<std::string>* remove_headers) {
+    for (base::DictionaryValue::Iterator it(headers); !it.IsAtEnd();
+         it.Advance()) {
+      if (it.value().is_none())
+        remove_headers->push_back(it.key());
+      else if (it.value().is_string())
+        set_headers->emplace_back(it.key(), it.value().GetString());
+      else
+        return false;
+    }
+    return true;
+  }
+};
+
 }  // namespace mate
 
 namespace atom {
@@ -55,6 +157,22 @@ void CallNetworkDelegateMethod(
   (network_delegate->*method)(type, std::move(patterns), std::move(listener));
 }
 
+void SetNetworkDelegateRules(
+    URLRequestContextGetter* url_request_context_getter,
+    WebRequestRules rules) {
+  url_request_context_getter->GetURLRequestContext();
+  url_request_context_getter->network_delegate()->SetRulesInIO(
+      std::move(rules));
+}
+
+void SetNetworkDelegateRequestLog(
+    URLRequestContextGetter* url_request_context_getter,
+    std::unique_ptr<RequestLogWriter> request_log) {
+  url_request_context_getter->GetURLRequestContext();
+  url_request_context_getter->network_delegate()->SetRequestLogInIO(
+      std::move(request_log));
+}
+
 }  // namespace
 
 WebRequest::WebRequest(v8::Isolate* isolate,
@@ -104,6 +222,71 @@ void WebRequest::SetListener(Method method, Event type, mate::Arguments* args) {
                      type, std::move(patterns), std::move(listener)));
 }
 
+void WebRequest::SetRules(mate::Arguments* args) {
+  WebRequestRules rules;
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&rules) &&
+      !(args->GetNext(&value) && value->IsNull())) {
+    args->ThrowError("Must pass null or an Array of valid rules");
+    return;
+  }
+
+  auto* url_request_context_getter = static_cast<URLRequestContextGetter*>(
+      browser_context_->GetRequestContext());
+  if (!url_request_context_getter)
+    return;
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&SetNetworkDelegateRules,
+                     base::RetainedRef(url_request_context_getter),
+                     std::move(rules)));
+}
+
+void WebRequest::SetCompletionLog(mate::Arguments* args) {
+  std::unique_ptr<RequestLogWriter> request_log;
+  mate::Dictionary options;
+  v8::Local<v8::Value> value;
+  if (args->GetNext(&options)) {
+    RequestLogWriter::Options log_options;
+    if (!options.Get("path", &log_options.path) ||
+        log_options.path.empty()) {
+      args->ThrowError("Must specify the path of the log");
+      return;
+    }
+    std::vector<std::string> fields = {
+        "id", "timestamp", "method", "url", "statusCode", "fromCache", "error"};
+    options.Get("fields", &fields);
+    for (const auto& name : fields) {
+      RequestLogWriter::Field field;
+      if (!RequestLogWriter::FieldFromString(name, &field)) {
+        args->ThrowError("Unknown log field: " + name);
+        return;
+      }
+      log_options.fields.push_back(field);
+    }
+    double max_file_size;
+    if (options.Get("maxFileSize", &max_file_size) && max_file_size > 0)
+      log_options.max_file_size = static_cast<int64_t>(max_file_size);
+    int max_files;
+    if (options.Get("maxFiles", &max_files) && max_files > 0)
+      log_options.max_files = max_files;
+    request_log = std::make_unique<RequestLogWriter>(log_options);
+  } else if (!(args->GetNext(&value) && value->IsNull())) {
+    args->ThrowError("Must pass null or an Object");
+    return;
+  }
+
+  auto* url_request_context_getter = static_cast<URLRequestContextGetter*>(
+      browser_context_->GetRequestContext());
+  if (!url_request_context_getter)
+    return;
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&SetNetworkDelegateRequestLog,
+                     base::RetainedRef(url_request_context_getter),
+                     std::move(request_log)));
+}
+
 // static
 mate::Handle<WebRequest> WebRequest::Create(
     v8::Isolate* isolate,
@@ -137,7 +320,9 @@ void WebRequest::BuildPrototype(v8::Isolate* isolate,
           "onCompleted",
           &WebRequest::SetSimpleListener<AtomNetworkDelegate::kOnCompleted>)
       .SetMethod("onErrorOccurred", &WebRequest::SetSimpleListener<
-                                        AtomNetworkDelegate::kOnErrorOccurred>);
+                                        AtomNetworkDelegate::kOnErrorOccurred>)
+      .SetMethod("setRules", &WebRequest::SetRules)
+      .SetMethod("setCompletionLog", &WebRequest::SetCompletionLog);
 }
 
 }  // namespace api
@@ -35,6 +35,8 @@ class WebRequest : public mate::TrackableObject<WebRequest> {
   void SetResponseListener(mate::Arguments* args);
   template <typename Listener, typename Method, typename Event>
   void SetListener(Method method, Event type, mate::Arguments* args);
+  void SetRules(mate::Arguments* args);
+  void SetCompletionLog(mate::Arguments* args);
 
  private:
   scoped_refptr<AtomBrowserContext> browser_context_;
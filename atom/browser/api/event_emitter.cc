@@ -4,7 +4,12 @@
 
 #include "atom/browser/api/event_emitter.h"
 
+#include <map>
+#include <string>
+#include <utility>
+
 #include "atom/browser/api/event.h"
+#include "base/no_destructor.h"
 #include "native_mate/arguments.h"
 #include "native_mate/dictionary.h"
 #include "native_mate/object_template_builder.h"
@@ -18,6 +23,14 @@ namespace {
 
 v8::Persistent<v8::ObjectTemplate> event_template;
 
+using EventNameMap =
+    std::map<std::pair<v8::Isolate*, std::string>, v8::Eternal<v8::String>>;
+
+// Eternal handles are never freed, and some names come from renderers, e.g.
+// IPC channels, so only this many names are kept. Electron's own event names
+// are far fewer.
+const size_t kMaxEventNames = 1024;
+
 void PreventDefault(mate::Arguments* args) {
   mate::Dictionary self(args->isolate(), args->GetThis());
   self.Set("defaultPrevented", true);
@@ -55,7 +68,7 @@ v8::Local<v8::Object> CreateJSEvent(v8::Isolate* isolate,
   } else {
     event = CreateEventObject(isolate);
   }
-  mate::Dictionary(isolate, event).Set("sender", object);
+  event->Set(GetEventName(isolate, "sender"), object);
   return event;
 }
 
@@ -64,7 +77,7 @@ v8::Local<v8::Object> CreateCustomEvent(v8::Isolate* isolate,
                                         v8::Local<v8::Object> custom_event) {
   v8::Local<v8::Object> event = CreateEventObject(isolate);
   (void)event->SetPrototype(custom_event->CreationContext(), custom_event);
-  mate::Dictionary(isolate, event).Set("sender", object);
+  event->Set(GetEventName(isolate, "sender"), object);
   return event;
 }
 
@@ -77,6 +90,58 @@ v8::Local<v8::Object> CreateEventFromFlags(v8::Isolate* isolate, int flags) {
   return obj.GetHandle();
 }
 
+v8::Local<v8::String> GetEventName(v8::Isolate* isolate,
+                                   const base::StringPiece& name) {
+  static base::NoDestructor<EventNameMap> names;
+  auto key = std::make_pair(isolate, name.as_string());
+  auto it = names->find(key);
+  if (it != names->end())
+    return it->second.Get(isolate);
+
+  v8::Local<v8::String> string =
+      v8::String::NewFromUtf8(isolate, name.data(),
+                              v8::NewStringType::kInternalized,
+                              static_cast<int>(name.size()))
+          .ToLocalChecked();
+  if (names->size() < kMaxEventNames)
+    names->emplace(std::move(key), v8::Eternal<v8::String>(isolate, string));
+  return string;
+}
+
+bool HasListeners(v8::Isolate* isolate,
+                  v8::Local<v8::Object> object,
+                  v8::Local<v8::String> name) {
+  if (object.IsEmpty())
+    return false;
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  // Some modules handle the events of their bindings by replacing emit.
+  v8::Local<v8::String> emit = GetEventName(isolate, "emit");
+  if (object->HasOwnProperty(context, emit).FromMaybe(true))
+    return true;
+  if (name == GetEventName(isolate, "error"))
+    return true;
+
+  // The listeners of Node's EventEmitter, which is created lazily.
+  v8::Local<v8::Value> events;
+  if (!object->Get(context, GetEventName(isolate, "_events")).ToLocal(&events))
+    return true;
+  if (!events->IsObject())
+    return false;
+  v8::Local<v8::Value> listeners;
+  if (!events.As<v8::Object>()->Get(context, name).ToLocal(&listeners))
+    return true;
+  return !listeners->IsUndefined();
+}
+
+bool IsDefaultPrevented(v8::Isolate* isolate, v8::Local<v8::Object> event) {
+  v8::Local<v8::Value> prevented;
+  if (!event->Get(isolate->GetCurrentContext(),
+                  GetEventName(isolate, "defaultPrevented"))
+           .ToLocal(&prevented))
+    return false;
+  return prevented->BooleanValue();
+}
+
 }  // namespace internal
 
 }  // namespace mate
@@ -31,6 +31,20 @@ v8::Local<v8::Object> CreateCustomEvent(v8::Isolate* isolate,
                                         v8::Local<v8::Object> event);
 v8::Local<v8::Object> CreateEventFromFlags(v8::Isolate* isolate, int flags);
 
+// Returns |name| as an internalized string. The first names are kept as long
+// as the isolate lives, so the names of frequent events are only converted
+// once.
+v8::Local<v8::String> GetEventName(v8::Isolate* isolate,
+                                   const base::StringPiece& name);
+
+// Whether obj.emit(name, ...) could do anything, i.e. there is a listener for
+// the event, obj.emit is replaced, or the event is "error" which throws.
+bool HasListeners(v8::Isolate* isolate,
+                  v8::Local<v8::Object> object,
+                  v8::Local<v8::String> name);
+
+bool IsDefaultPrevented(v8::Isolate* isolate, v8::Local<v8::Object> event);
+
 }  // namespace internal
 
 // Provide helperers to emit event in JavaScript.
@@ -51,8 +65,14 @@ class EventEmitter : public Wrappable<T> {
   bool EmitCustomEvent(const base::StringPiece& name,
                        v8::Local<v8::Object> event,
                        const Args&... args) {
+    v8::Locker locker(isolate());
+    v8::HandleScope handle_scope(isolate());
+    v8::Local<v8::Object> wrapper = GetWrapper();
+    v8::Local<v8::String> event_name = internal::GetEventName(isolate(), name);
+    if (!internal::HasListeners(isolate(), wrapper, event_name))
+      return false;
     return EmitWithEvent(
-        name, internal::CreateCustomEvent(isolate(), GetWrapper(), event),
+        event_name, internal::CreateCustomEvent(isolate(), wrapper, event),
         args...);
   }
 
@@ -83,9 +103,13 @@ class EventEmitter : public Wrappable<T> {
     if (wrapper.IsEmpty()) {
       return false;
     }
+    // Neither the event nor the arguments are created when nobody listens.
+    v8::Local<v8::String> event_name = internal::GetEventName(isolate(), name);
+    if (!internal::HasListeners(isolate(), wrapper, event_name))
+      return false;
     v8::Local<v8::Object> event =
         internal::CreateJSEvent(isolate(), wrapper, sender, message);
-    return EmitWithEvent(name, event, args...);
+    return EmitWithEvent(event_name, event, args...);
   }
 
  protected:
@@ -94,14 +118,21 @@ class EventEmitter : public Wrappable<T> {
  private:
   // this.emit(name, event, args...);
   template <typename... Args>
-  bool EmitWithEvent(const base::StringPiece& name,
+  bool EmitWithEvent(v8::Local<v8::String> name,
                      v8::Local<v8::Object> event,
                      const Args&... args) {
     v8::Locker locker(isolate());
     v8::HandleScope handle_scope(isolate());
-    EmitEvent(isolate(), GetWrapper(), name, event, args...);
-    return event->Get(StringToV8(isolate(), "defaultPrevented"))
-        ->BooleanValue();
+    internal::ValueVector converted_args = {
+        name, event, ConvertToV8(isolate(), args)...,
+    };
+    v8::Local<v8::Value> handled = internal::CallMethodWithArgs(
+        isolate(), GetWrapper(), "emit", &converted_args);
+    // emit() returns false when no listener ran, so nothing could have
+    // prevented the default action.
+    if (handled->IsFalse())
+      return false;
+    return internal::IsDefaultPrevented(isolate(), event);
   }
 
   DISALLOW_COPY_AND_ASSIGN(EventEmitter);
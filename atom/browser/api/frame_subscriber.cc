@@ -4,14 +4,17 @@
 
 #include "atom/browser/api/frame_subscriber.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "atom/common/native_mate_converters/gfx_converter.h"
-#include "components/viz/common/frame_sinks/copy_output_request.h"
-#include "components/viz/service/frame_sinks/frame_sink_manager_impl.h"
-#include "components/viz/service/surfaces/surface_manager.h"
+#include "components/viz/host/host_frame_sink_manager.h"
 #include "content/browser/compositor/surface_utils.h"
 #include "content/browser/renderer_host/render_widget_host_view_base.h"
-#include "ui/gfx/geometry/rect_conversions.h"
-#include "ui/gfx/skbitmap_operations.h"
+#include "content/public/browser/render_view_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "media/base/video_frame.h"
+#include "native_mate/dictionary.h"
 
 #include "atom/common/node_includes.h"
 
@@ -19,82 +22,139 @@ namespace atom {
 
 namespace api {
 
+namespace {
+
+const char* GetFormatName(media::VideoPixelFormat format) {
+  return format == media::PIXEL_FORMAT_I420 ? "i420" : "bgra";
+}
+
+}  // namespace
+
 FrameSubscriber::FrameSubscriber(v8::Isolate* isolate,
                                  content::WebContents* web_contents,
-                                 const FrameCaptureCallback& callback,
-                                 bool only_dirty)
+                                 const Options& options,
+                                 const FrameCaptureCallback& callback)
     : content::WebContentsObserver(web_contents),
       isolate_(isolate),
+      options_(options),
       callback_(callback),
-      only_dirty_(only_dirty),
-      weak_ptr_factory_(this) {}
+      binding_(this) {
+  content::GetHostFrameSinkManager()->CreateVideoCapturer(
+      mojo::MakeRequest(&capturer_));
+  capturer_->SetFormat(options_.format, media::COLOR_SPACE_UNSPECIFIED);
+  capturer_->SetMinCapturePeriod(
+      base::TimeDelta::FromSecondsD(1.0 / options_.frame_rate));
+  // The frames must keep the requested size.
+  capturer_->SetAutoThrottlingEnabled(false);
+  AttachToView(web_contents->GetRenderWidgetHostView());
+
+  viz::mojom::FrameSinkVideoConsumerPtr consumer;
+  binding_.Bind(mojo::MakeRequest(&consumer));
+  capturer_->Start(std::move(consumer));
+}
 
-FrameSubscriber::~FrameSubscriber() = default;
+FrameSubscriber::~FrameSubscriber() {
+  capturer_->Stop();
+}
 
-gfx::Rect FrameSubscriber::GetDamageRect() {
-  auto* view = web_contents()->GetRenderWidgetHostView();
+void FrameSubscriber::AttachToView(content::RenderWidgetHostView* view) {
   if (view == nullptr)
-    return gfx::Rect();
+    return;
 
   auto* view_base = static_cast<content::RenderWidgetHostViewBase*>(view);
-  viz::SurfaceManager* surface_manager =
-      content::GetFrameSinkManager()->surface_manager();
-  viz::Surface* surface =
-      surface_manager->GetSurfaceForId(view_base->GetCurrentSurfaceId());
-  if (surface == nullptr)
-    return gfx::Rect();
-
-  if (surface->HasActiveFrame()) {
-    const viz::CompositorFrame& frame = surface->GetActiveFrame();
-    viz::RenderPass* root_pass = frame.render_pass_list.back().get();
-    gfx::Size frame_size = root_pass->output_rect.size();
-    gfx::Rect damage_rect =
-        gfx::ToEnclosingRect(gfx::RectF(root_pass->damage_rect));
-    damage_rect.Intersect(gfx::Rect(frame_size));
-    return gfx::ScaleToEnclosedRect(damage_rect,
-                                    1.0f / frame.device_scale_factor());
-  } else {
-    return gfx::Rect();
-  }
+  capturer_->ChangeTarget(view_base->GetFrameSinkId());
+  UpdateResolution(view);
 }
 
-void FrameSubscriber::DidReceiveCompositorFrame() {
-  auto* view = web_contents()->GetRenderWidgetHostView();
-  if (view == nullptr)
+void FrameSubscriber::UpdateResolution(content::RenderWidgetHostView* view) {
+  gfx::Size size = options_.size;
+  if (size.IsEmpty() && view)
+    size = view->GetViewBounds().size();
+  if (size.IsEmpty() || size == resolution_)
     return;
 
-  view->CopyFromSurface(
-      gfx::Rect(), view->GetViewBounds().size(),
-      base::BindOnce(&FrameSubscriber::Done, weak_ptr_factory_.GetWeakPtr(),
-                     GetDamageRect()));
+  resolution_ = size;
+  capturer_->SetResolutionConstraints(size, size, false);
+}
+
+void FrameSubscriber::RenderViewHostChanged(content::RenderViewHost* old_host,
+                                            content::RenderViewHost* new_host) {
+  AttachToView(new_host->GetWidget()->GetView());
+}
+
+void FrameSubscriber::DidReceiveCompositorFrame() {
+  // Only the size is checked here, the capturer observes the frames itself.
+  if (options_.size.IsEmpty())
+    UpdateResolution(web_contents()->GetRenderWidgetHostView());
 }
 
-void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
-  if (frame.drawsNothing())
+void FrameSubscriber::OnFrameCaptured(
+    mojo::ScopedSharedBufferHandle buffer,
+    uint32_t buffer_size,
+    media::mojom::VideoFrameInfoPtr info,
+    const gfx::Rect& update_rect,
+    const gfx::Rect& content_rect,
+    viz::mojom::FrameSinkVideoConsumerFrameCallbacksPtr callbacks) {
+  size_t frame_size = std::min<size_t>(
+      buffer_size,
+      media::VideoFrame::AllocationSize(info->pixel_format, info->coded_size));
+  mojo::ScopedSharedBufferMapping mapping = buffer->Map(buffer_size);
+  if (!mapping || frame_size == 0) {
+    callbacks->Done();
     return;
+  }
 
   v8::Locker locker(isolate_);
   v8::HandleScope handle_scope(isolate_);
 
-  const_cast<SkBitmap&>(frame).setAlphaType(kPremul_SkAlphaType);
-  const SkBitmap& bitmap = only_dirty_ ? SkBitmapOperations::CreateTiledBitmap(
-                                             frame, damage.x(), damage.y(),
-                                             damage.width(), damage.height())
-                                       : frame;
+  const char* pixels = static_cast<const char*>(mapping.get());
+  gfx::Rect dirty_rect = gfx::IntersectRects(update_rect, info->visible_rect);
+  v8::Local<v8::Object> data;
+  v8::Local<v8::ArrayBuffer> array_buffer;
+  if (options_.pooled) {
+    array_buffer = v8::ArrayBuffer::New(isolate_, mapping.get(), frame_size);
+    data = node::Buffer::New(isolate_, array_buffer, 0, frame_size)
+               .ToLocalChecked();
+  } else if (options_.only_dirty &&
+             info->pixel_format == media::PIXEL_FORMAT_ARGB) {
+    // Only the rows of the dirty area are copied out of the pool.
+    size_t stride = media::VideoFrame::RowBytes(
+        media::VideoFrame::kARGBPlane, info->pixel_format,
+        info->coded_size.width());
+    size_t row_size = dirty_rect.width() * 4;
+    data = node::Buffer::New(isolate_, row_size * dirty_rect.height())
+               .ToLocalChecked();
+    char* target = node::Buffer::Data(data);
+    for (int y = 0; y < dirty_rect.height(); ++y) {
+      memcpy(target + y * row_size,
+             pixels + (dirty_rect.y() + y) * stride + dirty_rect.x() * 4,
+             row_size);
+    }
+  } else {
+    data = node::Buffer::Copy(isolate_, pixels, frame_size).ToLocalChecked();
+  }
 
-  size_t rgb_row_size = bitmap.width() * bitmap.bytesPerPixel();
-  auto* source = static_cast<const char*>(bitmap.getPixels());
+  mate::Dictionary frame = mate::Dictionary::CreateEmpty(isolate_);
+  frame.Set("format", GetFormatName(info->pixel_format));
+  frame.Set("codedSize", info->coded_size);
+  frame.Set("contentRect", content_rect);
+  frame.Set("timestamp", info->timestamp.InMillisecondsF());
 
-  v8::MaybeLocal<v8::Object> buffer =
-      node::Buffer::Copy(isolate_, source, rgb_row_size * bitmap.height());
-  auto local_buffer = buffer.ToLocalChecked();
+  callback_.Run(data, mate::ConvertToV8(isolate_, dirty_rect),
+                frame.GetHandle());
 
-  v8::Local<v8::Value> damage_rect =
-      mate::Converter<gfx::Rect>::ToV8(isolate_, damage);
+  // The buffer goes back to the pool, JavaScript can no longer read it.
+  if (!array_buffer.IsEmpty())
+    array_buffer->Neuter();
+  callbacks->Done();
+}
 
-  callback_.Run(local_buffer, damage_rect);
+void FrameSubscriber::OnTargetLost(const viz::FrameSinkId& frame_sink_id) {
+  // The new view is attached by RenderViewHostChanged.
 }
 
+void FrameSubscriber::OnStopped() {}
+
 }  // namespace api
 
 }  // namespace atom
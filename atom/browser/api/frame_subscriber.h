@@ -8,39 +8,76 @@
 #include "content/public/browser/web_contents.h"
 
 #include "base/callback.h"
-#include "base/memory/weak_ptr.h"
-#include "components/viz/common/frame_sinks/copy_output_result.h"
 #include "content/public/browser/web_contents_observer.h"
-#include "ui/gfx/image/image.h"
+#include "media/base/video_types.h"
+#include "mojo/public/cpp/bindings/binding.h"
+#include "services/viz/privileged/interfaces/compositing/frame_sink_video_capture.mojom.h"
+#include "ui/gfx/geometry/size.h"
 #include "v8/include/v8.h"
 
+namespace content {
+class RenderWidgetHostView;
+}
+
 namespace atom {
 
 namespace api {
 
 class WebContents;
 
-class FrameSubscriber : public content::WebContentsObserver {
+// Receives the frames of a WebContents from the video capturer of viz, which
+// scales and converts them on the GPU into a fixed pool of shared buffers.
+class FrameSubscriber : public content::WebContentsObserver,
+                        public viz::mojom::FrameSinkVideoConsumer {
  public:
-  using FrameCaptureCallback =
-      base::Callback<void(v8::Local<v8::Value>, v8::Local<v8::Value>)>;
+  using FrameCaptureCallback = base::Callback<void(v8::Local<v8::Value>,
+                                                   v8::Local<v8::Value>,
+                                                   v8::Local<v8::Value>)>;
+
+  struct Options {
+    bool only_dirty = false;
+    media::VideoPixelFormat format = media::PIXEL_FORMAT_ARGB;
+    // Follows the size of the view in DIPs when empty.
+    gfx::Size size;
+    double frame_rate = 60;
+    // Passes the pooled buffers to JavaScript instead of copies, they are
+    // only valid until the callback returns.
+    bool pooled = false;
+  };
 
   FrameSubscriber(v8::Isolate* isolate,
                   content::WebContents* web_contents,
-                  const FrameCaptureCallback& callback,
-                  bool only_dirty);
+                  const Options& options,
+                  const FrameCaptureCallback& callback);
   ~FrameSubscriber() override;
 
  private:
-  gfx::Rect GetDamageRect();
+  void AttachToView(content::RenderWidgetHostView* view);
+  void UpdateResolution(content::RenderWidgetHostView* view);
+
+  // content::WebContentsObserver:
+  void RenderViewHostChanged(content::RenderViewHost* old_host,
+                             content::RenderViewHost* new_host) override;
   void DidReceiveCompositorFrame() override;
-  void Done(const gfx::Rect& damage, const SkBitmap& frame);
+
+  // viz::mojom::FrameSinkVideoConsumer:
+  void OnFrameCaptured(
+      mojo::ScopedSharedBufferHandle buffer,
+      uint32_t buffer_size,
+      media::mojom::VideoFrameInfoPtr info,
+      const gfx::Rect& update_rect,
+      const gfx::Rect& content_rect,
+      viz::mojom::FrameSinkVideoConsumerFrameCallbacksPtr callbacks) override;
+  void OnTargetLost(const viz::FrameSinkId& frame_sink_id) override;
+  void OnStopped() override;
 
   v8::Isolate* isolate_;
+  Options options_;
   FrameCaptureCallback callback_;
-  bool only_dirty_;
 
-  base::WeakPtrFactory<FrameSubscriber> weak_ptr_factory_;
+  viz::mojom::FrameSinkVideoCapturerPtr capturer_;
+  mojo::Binding<viz::mojom::FrameSinkVideoConsumer> binding_;
+  gfx::Size resolution_;
 
   DISALLOW_COPY_AND_ASSIGN(FrameSubscriber);
 };
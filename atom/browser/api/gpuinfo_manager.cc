@@ -39,32 +39,55 @@ bool GPUInfoManager::NeedsCompleteGpuInfoCollection() const {
 
 // Should be posted to the task runner
 void GPUInfoManager::ProcessCompleteInfo() {
-  const auto result = EnumerateGPUInfo(gpu_data_manager_->GetGPUInfo());
+  // Another update might have been processed since this task was posted.
+  if (NeedsCompleteGpuInfoCollection())
+    return;
+
+  auto result = EnumerateGPUInfo(gpu_data_manager_->GetGPUInfo());
+  bool changed = !notified_info_ || !notified_info_->Equals(result.get());
+  if (changed)
+    notified_info_ = result->CreateDeepCopy();
+  complete_info_ = std::move(result);
+
   // We have received the complete information, resolve all promises that
   // were waiting for this info.
   for (const auto& promise : complete_info_promise_set_) {
-    promise->Resolve(*result);
+    promise->Resolve(*complete_info_);
   }
   complete_info_promise_set_.clear();
+
+  if (changed)
+    complete_info_callbacks_.Notify(*complete_info_);
 }
 
 void GPUInfoManager::OnGpuInfoUpdate() {
   // Ignore if called when not asked for complete GPUInfo
   if (NeedsCompleteGpuInfoCollection())
     return;
+  complete_info_.reset();
   base::ThreadTaskRunnerHandle::Get()->PostTask(
       FROM_HERE, base::BindOnce(&GPUInfoManager::ProcessCompleteInfo,
                                 base::Unretained(this)));
 }
 
+std::unique_ptr<GPUInfoManager::CompleteInfoCallbackList::Subscription>
+GPUInfoManager::AddCompleteInfoCallback(const CompleteInfoCallback& callback) {
+  return complete_info_callbacks_.Add(callback);
+}
+
 // Should be posted to the task runner
 void GPUInfoManager::CompleteInfoFetcher(scoped_refptr<util::Promise> promise) {
+  if (complete_info_) {
+    promise->Resolve(*complete_info_);
+    return;
+  }
+
   complete_info_promise_set_.push_back(promise);
 
   if (NeedsCompleteGpuInfoCollection()) {
     gpu_data_manager_->RequestCompleteGpuInfoIfNeeded();
   } else {
-    GPUInfoManager::OnGpuInfoUpdate();
+    ProcessCompleteInfo();
   }
 }
 
@@ -77,9 +100,12 @@ void GPUInfoManager::FetchCompleteInfo(scoped_refptr<util::Promise> promise) {
 // This fetches the info synchronously, so no need to post to the task queue.
 // There cannot be multiple promises as they are resolved synchronously.
 void GPUInfoManager::FetchBasicInfo(scoped_refptr<util::Promise> promise) {
-  gpu::GPUInfo gpu_info;
-  CollectBasicGraphicsInfo(&gpu_info);
-  promise->Resolve(*EnumerateGPUInfo(gpu_info));
+  if (!basic_info_) {
+    gpu::GPUInfo gpu_info;
+    CollectBasicGraphicsInfo(&gpu_info);
+    basic_info_ = EnumerateGPUInfo(gpu_info);
+  }
+  promise->Resolve(*basic_info_);
 }
 
 std::unique_ptr<base::DictionaryValue> GPUInfoManager::EnumerateGPUInfo(
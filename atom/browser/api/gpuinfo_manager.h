@@ -11,15 +11,21 @@
 
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/promise_util.h"
+#include "base/callback_list.h"
 #include "content/browser/gpu/gpu_data_manager_impl.h"
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/gpu_data_manager_observer.h"
 
 namespace atom {
 
-// GPUInfoManager is a singleton used to manage and fetch GPUInfo
+// GPUInfoManager is a singleton used to manage and fetch GPUInfo. The basic
+// and complete info are enumerated once and kept until the GPU info changes.
 class GPUInfoManager : public content::GpuDataManagerObserver {
  public:
+  using CompleteInfoCallback = base::Callback<void(const base::Value&)>;
+  using CompleteInfoCallbackList =
+      base::CallbackList<void(const base::Value&)>;
+
   static GPUInfoManager* GetInstance();
 
   GPUInfoManager();
@@ -29,6 +35,11 @@ class GPUInfoManager : public content::GpuDataManagerObserver {
   void FetchBasicInfo(scoped_refptr<util::Promise> promise);
   void OnGpuInfoUpdate() override;
 
+  // Runs |callback| each time the complete info is collected and differs from
+  // the previously collected one.
+  std::unique_ptr<CompleteInfoCallbackList::Subscription>
+  AddCompleteInfoCallback(const CompleteInfoCallback& callback);
+
  private:
   std::unique_ptr<base::DictionaryValue> EnumerateGPUInfo(
       gpu::GPUInfo gpu_info) const;
@@ -42,6 +53,15 @@ class GPUInfoManager : public content::GpuDataManagerObserver {
   std::vector<scoped_refptr<util::Promise>> complete_info_promise_set_;
   content::GpuDataManager* gpu_data_manager_;
 
+  // The basic info does not change while the app runs, the complete info is
+  // dropped when the GPU info is updated.
+  std::unique_ptr<base::DictionaryValue> basic_info_;
+  std::unique_ptr<base::DictionaryValue> complete_info_;
+  // The complete info last passed to the callbacks, it is kept across updates
+  // so an update that changes nothing is not reported.
+  std::unique_ptr<base::DictionaryValue> notified_info_;
+  CompleteInfoCallbackList complete_info_callbacks_;
+
   DISALLOW_COPY_AND_ASSIGN(GPUInfoManager);
 };
 
@@ -0,0 +1,114 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/api/page_capturer.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/task_scheduler/post_task.h"
+#include "content/public/browser/render_widget_host_view.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImageEncoder.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "ui/gfx/codec/jpeg_codec.h"
+#include "ui/gfx/codec/png_codec.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+namespace atom {
+
+namespace api {
+
+namespace {
+
+std::vector<unsigned char> EncodeBitmap(const SkBitmap& bitmap,
+                                        const PageCapturer::Options& options) {
+  std::vector<unsigned char> image;
+  if (bitmap.drawsNothing())
+    return image;
+
+  switch (options.encoding) {
+    case PageCapturer::Encoding::PNG:
+      gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &image);
+      break;
+    case PageCapturer::Encoding::JPEG:
+      gfx::JPEGCodec::Encode(bitmap, options.quality, &image);
+      break;
+    case PageCapturer::Encoding::WEBP: {
+      SkPixmap pixmap;
+      SkDynamicMemoryWStream stream;
+      if (bitmap.peekPixels(&pixmap) &&
+          SkEncodeImage(&stream, pixmap, SkEncodedImageFormat::kWEBP,
+                        options.quality)) {
+        image.resize(stream.bytesWritten());
+        stream.copyTo(image.data());
+      }
+      break;
+    }
+  }
+  return image;
+}
+
+}  // namespace
+
+// static
+void PageCapturer::Capture(content::RenderWidgetHostView* view,
+                           const std::vector<gfx::Rect>& regions,
+                           const Options& options,
+                           Callback callback) {
+  scoped_refptr<PageCapturer> capturer(
+      new PageCapturer(regions.size(), options, std::move(callback)));
+  if (regions.empty() || !view) {
+    for (size_t i = 0; i < regions.size(); ++i)
+      capturer->OnEncoded(i, std::vector<unsigned char>());
+    if (regions.empty())
+      std::move(capturer->callback_).Run(capturer->images_);
+    return;
+  }
+
+  // All the copies are requested before any of them is read back, so the
+  // compositor can serve them from the same frame.
+  for (size_t i = 0; i < regions.size(); ++i) {
+    gfx::Rect rect = regions[i];
+    if (rect.IsEmpty())
+      rect = gfx::Rect(view->GetViewBounds().size());
+    gfx::Size output_size =
+        gfx::ScaleToCeiledSize(rect.size(), options.scale_factor);
+    view->CopyFromSurface(
+        rect, output_size,
+        base::BindOnce(&PageCapturer::OnCaptured, capturer, i));
+  }
+}
+
+PageCapturer::PageCapturer(size_t count,
+                           const Options& options,
+                           Callback callback)
+    : options_(options),
+      callback_(std::move(callback)),
+      images_(count),
+      pending_(count) {}
+
+PageCapturer::~PageCapturer() = default;
+
+void PageCapturer::OnCaptured(size_t index, const SkBitmap& bitmap) {
+  // Same transparency hack as OnCapturePageDone in atom_api_web_contents.cc.
+  const_cast<SkBitmap&>(bitmap).setAlphaType(kPremul_SkAlphaType);
+
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&EncodeBitmap, bitmap, options_),
+      base::BindOnce(&PageCapturer::OnEncoded, this, index));
+}
+
+void PageCapturer::OnEncoded(size_t index, std::vector<unsigned char> image) {
+  images_[index] = std::move(image);
+  if (--pending_ == 0)
+    std::move(callback_).Run(images_);
+}
+
+}  // namespace api
+
+}  // namespace atom
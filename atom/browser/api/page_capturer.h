@@ -0,0 +1,72 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_API_PAGE_CAPTURER_H_
+#define ATOM_BROWSER_API_PAGE_CAPTURER_H_
+
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "ui/gfx/geometry/rect.h"
+
+class SkBitmap;
+
+namespace content {
+class RenderWidgetHostView;
+}
+
+namespace atom {
+
+namespace api {
+
+// Captures several regions of a page in one batch. The copies are requested
+// together and the bitmaps are encoded on the thread pool, so the UI thread
+// never touches the pixels.
+class PageCapturer : public base::RefCounted<PageCapturer> {
+ public:
+  enum class Encoding { PNG, JPEG, WEBP };
+
+  struct Options {
+    Encoding encoding = Encoding::PNG;
+    // Quality of JPEG and WebP images, from 0 to 100.
+    int quality = 90;
+    // Number of pixels per DIP of the captured images.
+    float scale_factor = 1.0f;
+  };
+
+  // Encoded images in the order of the regions, empty for the regions that
+  // could not be captured.
+  using Images = std::vector<std::vector<unsigned char>>;
+  using Callback = base::OnceCallback<void(const Images& images)>;
+
+  // An empty rect in |regions| captures the whole visible page. |callback| is
+  // called on the UI thread once every region is encoded.
+  static void Capture(content::RenderWidgetHostView* view,
+                      const std::vector<gfx::Rect>& regions,
+                      const Options& options,
+                      Callback callback);
+
+ private:
+  friend class base::RefCounted<PageCapturer>;
+
+  PageCapturer(size_t count, const Options& options, Callback callback);
+  ~PageCapturer();
+
+  void OnCaptured(size_t index, const SkBitmap& bitmap);
+  void OnEncoded(size_t index, std::vector<unsigned char> image);
+
+  Options options_;
+  Callback callback_;
+  Images images_;
+  size_t pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(PageCapturer);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_API_PAGE_CAPTURER_H_
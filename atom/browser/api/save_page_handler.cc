@@ -7,9 +7,11 @@
 #include <string>
 
 #include "atom/browser/atom_browser_context.h"
+#include "base/bind.h"
 #include "base/callback.h"
 #include "base/files/file_path.h"
 #include "content/public/browser/web_contents.h"
+#include "content/public/common/mhtml_generation_params.h"
 
 namespace atom {
 
@@ -30,6 +32,16 @@ void SavePageHandler::OnDownloadCreated(content::DownloadManager* manager,
 
 bool SavePageHandler::Handle(const base::FilePath& full_path,
                              const content::SavePageType& save_type) {
+  if (save_type == content::SAVE_PAGE_TYPE_AS_MHTML) {
+    // The renderers serialize their frames straight into the file, there is
+    // no download to track.
+    web_contents_->GenerateMHTML(
+        content::MHTMLGenerationParams(full_path),
+        base::BindOnce(&SavePageHandler::OnMHTMLGenerated,
+                       base::Unretained(this)));
+    return true;
+  }
+
   auto* download_manager = content::BrowserContext::GetDownloadManager(
       web_contents_->GetBrowserContext());
   download_manager->AddObserver(this);
@@ -64,6 +76,20 @@ void SavePageHandler::OnDownloadUpdated(download::DownloadItem* item) {
   }
 }
 
+void SavePageHandler::OnMHTMLGenerated(int64_t file_size) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  if (file_size >= 0) {
+    callback_.Run(v8::Null(isolate));
+  } else {
+    v8::Local<v8::String> error_message =
+        v8::String::NewFromUtf8(isolate, "Fail to save page");
+    callback_.Run(v8::Exception::Error(error_message));
+  }
+  delete this;
+}
+
 void SavePageHandler::Destroy(download::DownloadItem* item) {
   item->RemoveObserver(this);
   delete this;
@@ -40,6 +40,9 @@ class SavePageHandler : public content::DownloadManager::Observer,
  private:
   void Destroy(download::DownloadItem* item);
 
+  // Called with -1 when the MHTML file could not be written.
+  void OnMHTMLGenerated(int64_t file_size);
+
   // content::DownloadManager::Observer:
   void OnDownloadCreated(content::DownloadManager* manager,
                          download::DownloadItem* item) override;
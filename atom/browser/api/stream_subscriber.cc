@@ -4,16 +4,55 @@
 
 #include "atom/browser/api/stream_subscriber.h"
 
+#include <memory>
 #include <string>
 
 #include "atom/browser/net/url_request_stream_job.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "native_mate/dictionary.h"
+#include "net/base/io_buffer.h"
 
 #include "atom/common/node_includes.h"
 
 namespace mate {
 
+namespace {
+
+void ReleaseBuffer(v8::Isolate* isolate, v8::Global<v8::Value>* buffer) {
+  v8::Locker locker(isolate);
+  buffer->Reset();
+  delete buffer;
+}
+
+// Points to the memory of a Buffer, which is kept alive until the IO thread
+// is done with it.
+class BufferIOBuffer : public net::WrappedIOBuffer {
+ public:
+  BufferIOBuffer(v8::Isolate* isolate, v8::Local<v8::Value> buffer)
+      : net::WrappedIOBuffer(node::Buffer::Data(buffer)),
+        isolate_(isolate),
+        buffer_(std::make_unique<v8::Global<v8::Value>>(isolate, buffer)) {}
+
+ private:
+  ~BufferIOBuffer() override {
+    // The buffer can only be released on the thread of the isolate. The task
+    // does not own the handle, so when it is dropped at shutdown the handle
+    // is leaked with the isolate instead of being destroyed on this thread.
+    content::BrowserThread::PostTask(
+        content::BrowserThread::UI, FROM_HERE,
+        base::BindOnce(&ReleaseBuffer, isolate_,
+                       base::Unretained(buffer_.release())));
+  }
+
+  v8::Isolate* isolate_;
+  std::unique_ptr<v8::Global<v8::Value>> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(BufferIOBuffer);
+};
+
+}  // namespace
+
 StreamSubscriber::StreamSubscriber(
     v8::Isolate* isolate,
     v8::Local<v8::Object> emitter,
@@ -69,17 +108,17 @@ void StreamSubscriber::OnData(mate::Arguments* args) {
     return;
   }
 
-  const char* data = node::Buffer::Data(buf);
   size_t length = node::Buffer::Length(buf);
   if (length == 0)
     return;
 
-  // Pass the data to the URLJob in IO thread.
-  std::vector<char> buffer(data, data + length);
+  // Pass the data to the URLJob in IO thread without copying it.
+  scoped_refptr<net::IOBuffer> buffer =
+      base::MakeRefCounted<BufferIOBuffer>(isolate_, buf);
   content::BrowserThread::PostTask(
       content::BrowserThread::IO, FROM_HERE,
-      base::Bind(&atom::URLRequestStreamJob::OnData, url_job_,
-                 base::Passed(&buffer)));
+      base::BindOnce(&atom::URLRequestStreamJob::OnData, url_job_,
+                     std::move(buffer), static_cast<int>(length)));
 }
 
 void StreamSubscriber::OnEnd(mate::Arguments* args) {
@@ -95,6 +134,28 @@ void StreamSubscriber::OnError(mate::Arguments* args) {
                  net::ERR_FAILED));
 }
 
+void StreamSubscriber::Pause() {
+  CallOptionalMethod("pause");
+}
+
+void StreamSubscriber::Resume() {
+  CallOptionalMethod("resume");
+}
+
+void StreamSubscriber::CallOptionalMethod(const char* method) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  v8::Locker locker(isolate_);
+  v8::Isolate::Scope isolate_scope(isolate_);
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Value> value;
+  mate::Dictionary emitter(isolate_, emitter_.Get(isolate_));
+  if (!emitter.Get(method, &value) || !value->IsFunction())
+    return;
+  internal::ValueVector args;
+  internal::CallMethodWithArgs(isolate_, emitter_.Get(isolate_), method,
+                               &args);
+}
+
 void StreamSubscriber::RemoveAllListeners() {
   v8::Locker locker(isolate_);
   v8::Isolate::Scope isolate_scope(isolate_);
@@ -30,6 +30,14 @@ class StreamSubscriber {
                    base::WeakPtr<atom::URLRequestStreamJob> url_job);
   ~StreamSubscriber();
 
+  // Flow control of the stream, called when the job reads too slowly.
+  void Pause();
+  void Resume();
+
+  base::WeakPtr<StreamSubscriber> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
  private:
   using JSHandlersMap = std::map<std::string, v8::Global<v8::Value>>;
   using EventCallback = base::Callback<void(mate::Arguments* args)>;
@@ -43,6 +51,8 @@ class StreamSubscriber {
 
   void RemoveAllListeners();
   void RemoveListener(JSHandlersMap::iterator it);
+  // Calls |method| of the emitter when it has one.
+  void CallOptionalMethod(const char* method);
 
   v8::Isolate* isolate_;
   v8::Global<v8::Object> emitter_;
@@ -92,12 +92,25 @@ class TrackableObject : public TrackableObjectBase,
     return FromWeakMapID(isolate, id);
   }
 
+  // Calls |callback| with each object in this class's weak map.
+  template <typename Callback>
+  static void ForEach(v8::Isolate* isolate, const Callback& callback) {
+    if (weak_map_) {
+      weak_map_->ForEach(
+          isolate, [&callback](int32_t id, v8::Local<v8::Object> object) {
+            callback(object);
+          });
+    }
+  }
+
   // Returns all objects in this class's weak map.
-  static std::vector<v8::Local<v8::Object>> GetAll(v8::Isolate* isolate) {
-    if (weak_map_)
-      return weak_map_->Values(isolate);
-    else
-      return std::vector<v8::Local<v8::Object>>();
+  static v8::Local<v8::Array> GetAll(v8::Isolate* isolate) {
+    v8::Local<v8::Array> result = v8::Array::New(isolate);
+    uint32_t index = 0;
+    ForEach(isolate, [&](v8::Local<v8::Object> object) {
+      result->Set(index++, object);
+    });
+    return result;
   }
 
   // Removes this instance from the weak map.
@@ -0,0 +1,252 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/api/video_recorder.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "components/viz/common/frame_sinks/copy_output_request.h"
+#include "components/viz/common/frame_sinks/copy_output_result.h"
+#include "components/viz/host/host_frame_sink_manager.h"
+#include "content/browser/compositor/surface_utils.h"
+#include "content/browser/gpu/gpu_data_manager_impl.h"
+#include "content/browser/gpu/gpu_process_host.h"
+#include "content/browser/renderer_host/render_widget_host_view_base.h"
+#include "content/public/browser/browser_thread.h"
+#include "media/base/bitstream_buffer.h"
+#include "media/base/video_frame.h"
+#include "media/mojo/clients/mojo_video_encode_accelerator.h"
+#include "mojo/public/cpp/bindings/interface_request.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+namespace api {
+
+namespace {
+
+void CreateProviderOnIO(
+    media::mojom::VideoEncodeAcceleratorProviderRequest request,
+    content::GpuProcessHost* host) {
+  if (host)
+    host->gpu_service()->CreateVideoEncodeAcceleratorProvider(
+        std::move(request));
+}
+
+}  // namespace
+
+// An I420 frame in shared memory, the GPU process reads it without a copy.
+struct VideoRecorder::InputBuffer {
+  base::SharedMemory memory;
+  bool in_use = false;
+};
+
+VideoRecorder::VideoRecorder(v8::Isolate* isolate,
+                             content::WebContents* web_contents,
+                             const Options& options,
+                             const ChunkCallback& chunk_callback,
+                             const ErrorCallback& error_callback)
+    : content::WebContentsObserver(web_contents),
+      isolate_(isolate),
+      options_(options),
+      chunk_callback_(chunk_callback),
+      error_callback_(error_callback),
+      weak_ptr_factory_(this) {
+  // The encoders only accept even sizes.
+  options_.size.set_width(options_.size.width() & ~1);
+  options_.size.set_height(options_.size.height() & ~1);
+
+  content::GpuProcessHost::CallOnIO(
+      content::GPU_PROCESS_KIND_SANDBOXED, false /* force_create */,
+      base::BindOnce(&CreateProviderOnIO, mojo::MakeRequest(&provider_)));
+
+  media::mojom::VideoEncodeAcceleratorPtr encoder;
+  provider_->CreateVideoEncodeAccelerator(mojo::MakeRequest(&encoder));
+  encoder_.reset(new media::MojoVideoEncodeAccelerator(
+      std::move(encoder), content::GpuDataManagerImpl::GetInstance()
+                              ->GetGPUInfo()
+                              .video_encode_accelerator_supported_profiles));
+
+  bool supported = false;
+  for (const auto& profile : encoder_->GetSupportedProfiles()) {
+    if (profile.profile == media::H264PROFILE_MAIN &&
+        profile.max_resolution.width() >= options_.size.width() &&
+        profile.max_resolution.height() >= options_.size.height())
+      supported = true;
+  }
+
+  if (!supported || options_.size.IsEmpty() ||
+      !encoder_->Initialize(media::PIXEL_FORMAT_I420, options_.size,
+                            media::H264PROFILE_MAIN, options_.bitrate, this)) {
+    // Reported asynchronously so the caller has a chance to handle it.
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&VideoRecorder::Fail,
+                                  weak_ptr_factory_.GetWeakPtr(),
+                                  "Hardware H.264 encoding is not available"));
+  }
+}
+
+VideoRecorder::~VideoRecorder() {
+  // The encoder must be destroyed before the buffers it uses.
+  encoder_.reset();
+}
+
+void VideoRecorder::DidReceiveCompositorFrame() {
+  if (!encoder_ready_ || failed_ || copy_pending_)
+    return;
+
+  auto* view = static_cast<content::RenderWidgetHostViewBase*>(
+      web_contents()->GetRenderWidgetHostView());
+  if (!view)
+    return;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (!last_capture_time_.is_null() &&
+      now - last_capture_time_ <
+          base::TimeDelta::FromSecondsD(1.0 / options_.frame_rate))
+    return;
+
+  // Scaled and converted to I420 by the compositor.
+  gfx::Size source_size = view->GetCompositorViewportPixelSize();
+  if (source_size.IsEmpty())
+    return;
+  auto request = std::make_unique<viz::CopyOutputRequest>(
+      viz::CopyOutputRequest::ResultFormat::I420_PLANES,
+      base::BindOnce(&VideoRecorder::OnCopyResult,
+                     weak_ptr_factory_.GetWeakPtr(), now));
+  request->SetScaleRatio(
+      gfx::Vector2d(source_size.width(), source_size.height()),
+      gfx::Vector2d(options_.size.width(), options_.size.height()));
+  request->set_result_selection(gfx::Rect(options_.size));
+
+  copy_pending_ = true;
+  last_capture_time_ = now;
+  content::GetHostFrameSinkManager()->RequestCopyOfOutput(
+      view->GetCurrentSurfaceId(), std::move(request));
+}
+
+void VideoRecorder::OnCopyResult(
+    base::TimeTicks capture_time,
+    std::unique_ptr<viz::CopyOutputResult> result) {
+  copy_pending_ = false;
+  if (failed_ || result->IsEmpty())
+    return;
+
+  size_t index = 0;
+  while (index < input_buffers_.size() && input_buffers_[index]->in_use)
+    ++index;
+  // The encoder is busy with every buffer, the frame is dropped.
+  if (index == input_buffers_.size())
+    return;
+
+  InputBuffer* buffer = input_buffers_[index].get();
+  gfx::Rect visible_rect(options_.size);
+  if (start_time_.is_null())
+    start_time_ = capture_time;
+  scoped_refptr<media::VideoFrame> frame =
+      media::VideoFrame::WrapExternalSharedMemory(
+          media::PIXEL_FORMAT_I420, coded_size_, visible_rect, options_.size,
+          static_cast<uint8_t*>(buffer->memory.memory()),
+          buffer->memory.mapped_size(), buffer->memory.handle(), 0,
+          capture_time - start_time_);
+  if (!frame)
+    return;
+
+  if (!result->ReadI420Planes(
+          frame->visible_data(media::VideoFrame::kYPlane),
+          frame->stride(media::VideoFrame::kYPlane),
+          frame->visible_data(media::VideoFrame::kUPlane),
+          frame->stride(media::VideoFrame::kUPlane),
+          frame->visible_data(media::VideoFrame::kVPlane),
+          frame->stride(media::VideoFrame::kVPlane)))
+    return;
+
+  // The frame may be released on another thread.
+  buffer->in_use = true;
+  frame->AddDestructionObserver(base::BindOnce(
+      base::IgnoreResult(&content::BrowserThread::PostTask),
+      content::BrowserThread::UI, FROM_HERE,
+      base::BindOnce(&VideoRecorder::OnInputBufferReleased,
+                     weak_ptr_factory_.GetWeakPtr(), index)));
+  bool key_frame = frame_count_++ % options_.key_frame_interval == 0;
+  encoder_->Encode(frame, key_frame);
+}
+
+void VideoRecorder::OnInputBufferReleased(size_t index) {
+  if (index < input_buffers_.size())
+    input_buffers_[index]->in_use = false;
+}
+
+void VideoRecorder::RequireBitstreamBuffers(unsigned int input_count,
+                                            const gfx::Size& input_coded_size,
+                                            size_t output_buffer_size) {
+  coded_size_ = input_coded_size;
+  size_t frame_size = media::VideoFrame::AllocationSize(
+      media::PIXEL_FORMAT_I420, input_coded_size);
+  for (unsigned int i = 0; i < input_count; ++i) {
+    auto buffer = std::make_unique<InputBuffer>();
+    if (!buffer->memory.CreateAndMapAnonymous(frame_size)) {
+      Fail("Failed to allocate the video frames");
+      return;
+    }
+    input_buffers_.push_back(std::move(buffer));
+  }
+
+  // Enough output buffers so the encoder never waits for JavaScript.
+  for (unsigned int i = 0; i < input_count + 1; ++i) {
+    auto memory = std::make_unique<base::SharedMemory>();
+    if (!memory->CreateAndMapAnonymous(output_buffer_size)) {
+      Fail("Failed to allocate the video chunks");
+      return;
+    }
+    output_buffers_.push_back(std::move(memory));
+    UseOutputBuffer(static_cast<int32_t>(i));
+  }
+
+  encoder_ready_ = true;
+}
+
+void VideoRecorder::BitstreamBufferReady(
+    int32_t bitstream_buffer_id,
+    const media::BitstreamBufferMetadata& metadata) {
+  if (failed_)
+    return;
+
+  base::SharedMemory* memory = output_buffers_[bitstream_buffer_id].get();
+  {
+    v8::Locker locker(isolate_);
+    v8::HandleScope handle_scope(isolate_);
+    auto data = node::Buffer::Copy(isolate_,
+                                   static_cast<const char*>(memory->memory()),
+                                   metadata.payload_size_bytes)
+                    .ToLocalChecked();
+    chunk_callback_.Run(data, metadata.key_frame,
+                        metadata.timestamp.InMillisecondsF());
+  }
+  UseOutputBuffer(bitstream_buffer_id);
+}
+
+void VideoRecorder::NotifyError(media::VideoEncodeAccelerator::Error error) {
+  Fail("The hardware encoder failed");
+}
+
+void VideoRecorder::UseOutputBuffer(int32_t id) {
+  base::SharedMemory* memory = output_buffers_[id].get();
+  encoder_->UseOutputBitstreamBuffer(media::BitstreamBuffer(
+      id, memory->handle().Duplicate(), memory->mapped_size()));
+}
+
+void VideoRecorder::Fail(const std::string& message) {
+  if (failed_)
+    return;
+  failed_ = true;
+  error_callback_.Run(message);
+}
+
+}  // namespace api
+
+}  // namespace atom
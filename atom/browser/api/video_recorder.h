@@ -0,0 +1,107 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_API_VIDEO_RECORDER_H_
+#define ATOM_BROWSER_API_VIDEO_RECORDER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/shared_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "media/mojo/interfaces/video_encode_accelerator.mojom.h"
+#include "media/video/video_encode_accelerator.h"
+#include "ui/gfx/geometry/size.h"
+#include "v8/include/v8.h"
+
+namespace media {
+class VideoFrame;
+}
+
+namespace viz {
+class CopyOutputResult;
+}
+
+namespace atom {
+
+namespace api {
+
+// Encodes the frames of a WebContents to H.264 with the hardware encoder of
+// the GPU process. The frames are converted to I420 by the compositor, so
+// they are neither read back as RGBA nor passed to JavaScript.
+class VideoRecorder : public content::WebContentsObserver,
+                      public media::VideoEncodeAccelerator::Client {
+ public:
+  struct Options {
+    gfx::Size size;
+    int bitrate = 4000000;
+    int frame_rate = 30;
+    int key_frame_interval = 60;
+  };
+
+  using ChunkCallback = base::Callback<
+      void(v8::Local<v8::Value> data, bool key_frame, double timestamp)>;
+  using ErrorCallback = base::Callback<void(const std::string& message)>;
+
+  VideoRecorder(v8::Isolate* isolate,
+                content::WebContents* web_contents,
+                const Options& options,
+                const ChunkCallback& chunk_callback,
+                const ErrorCallback& error_callback);
+  ~VideoRecorder() override;
+
+ private:
+  struct InputBuffer;
+
+  // content::WebContentsObserver:
+  void DidReceiveCompositorFrame() override;
+
+  // media::VideoEncodeAccelerator::Client:
+  void RequireBitstreamBuffers(unsigned int input_count,
+                               const gfx::Size& input_coded_size,
+                               size_t output_buffer_size) override;
+  void BitstreamBufferReady(
+      int32_t bitstream_buffer_id,
+      const media::BitstreamBufferMetadata& metadata) override;
+  void NotifyError(media::VideoEncodeAccelerator::Error error) override;
+
+  void OnCopyResult(base::TimeTicks capture_time,
+                    std::unique_ptr<viz::CopyOutputResult> result);
+  void OnInputBufferReleased(size_t index);
+  void UseOutputBuffer(int32_t id);
+  void Fail(const std::string& message);
+
+  v8::Isolate* isolate_;
+  Options options_;
+  ChunkCallback chunk_callback_;
+  ErrorCallback error_callback_;
+
+  media::mojom::VideoEncodeAcceleratorProviderPtr provider_;
+  std::unique_ptr<media::VideoEncodeAccelerator> encoder_;
+  bool encoder_ready_ = false;
+  bool failed_ = false;
+
+  gfx::Size coded_size_;
+  std::vector<std::unique_ptr<InputBuffer>> input_buffers_;
+  std::vector<std::unique_ptr<base::SharedMemory>> output_buffers_;
+
+  bool copy_pending_ = false;
+  int frame_count_ = 0;
+  base::TimeTicks start_time_;
+  base::TimeTicks last_capture_time_;
+
+  base::WeakPtrFactory<VideoRecorder> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(VideoRecorder);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_API_VIDEO_RECORDER_H_
@@ -0,0 +1,132 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/asar_index_distributor.h"
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "atom/common/api/api_messages.h"
+#include "atom/common/asar/archive.h"
+#include "atom/common/asar/archive_index.h"
+#include "atom/common/asar/asar_util.h"
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
+#include "base/task_scheduler/post_task.h"
+
+namespace atom {
+
+namespace {
+
+struct SharedIndex {
+  int64_t size = 0;
+  int64_t last_modified = 0;
+  uint32_t header_size = 0;
+  base::ReadOnlySharedMemoryRegion region;
+};
+
+// The read-only regions are created once for each version of an archive and
+// duplicated for each request, whichever process asks.
+struct SharedIndexes {
+  base::Lock lock;
+  std::map<base::FilePath, SharedIndex> indexes;
+};
+
+base::LazyInstance<SharedIndexes>::Leaky g_shared_indexes =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Builds the shared index of the archive at |path| parsed by this process,
+// when it is the version identified by |size| and |last_modified|.
+bool CreateSharedIndex(const base::FilePath& path,
+                       int64_t size,
+                       int64_t last_modified,
+                       SharedIndex* shared) {
+  for (const auto& archive : asar::GetCachedArchives()) {
+    if (archive->path() != path)
+      continue;
+
+    base::File::Info info;
+    if (!archive->GetArchiveFileInfo(&info) || info.size != size ||
+        info.last_modified.ToInternalValue() != last_modified)
+      return false;
+
+    std::string serialized;
+    base::StringPiece data;
+    if (archive->index()) {
+      data = archive->index()->data();
+    } else if (archive->header()) {
+      serialized = asar::ArchiveIndex::Serialize(*archive->header());
+      data = serialized;
+    } else {
+      return false;
+    }
+
+    base::MappedReadOnlyRegion mapped =
+        base::ReadOnlySharedMemoryRegion::Create(data.size());
+    if (!mapped.IsValid())
+      return false;
+    memcpy(mapped.mapping.memory(), data.data(), data.size());
+
+    shared->size = size;
+    shared->last_modified = last_modified;
+    shared->header_size = archive->header_size();
+    shared->region = std::move(mapped.region);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+AsarIndexDistributor::AsarIndexDistributor()
+    : content::BrowserMessageFilter(ShellMsgStart),
+      task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::USER_BLOCKING})) {}
+
+AsarIndexDistributor::~AsarIndexDistributor() {}
+
+base::TaskRunner* AsarIndexDistributor::OverrideTaskRunnerForMessage(
+    const IPC::Message& message) {
+  if (message.type() == AtomHostMsg_GetSharedAsarIndex::ID)
+    return task_runner_.get();
+  return nullptr;
+}
+
+bool AsarIndexDistributor::OnMessageReceived(const IPC::Message& message) {
+  bool handled = true;
+  IPC_BEGIN_MESSAGE_MAP(AsarIndexDistributor, message)
+    IPC_MESSAGE_HANDLER(AtomHostMsg_GetSharedAsarIndex, OnGetSharedAsarIndex)
+    IPC_MESSAGE_UNHANDLED(handled = false)
+  IPC_END_MESSAGE_MAP()
+  return handled;
+}
+
+void AsarIndexDistributor::OnGetSharedAsarIndex(
+    const base::FilePath& path,
+    int64_t size,
+    int64_t last_modified,
+    uint32_t* header_size,
+    base::ReadOnlySharedMemoryRegion* region) {
+  *header_size = 0;
+
+  SharedIndexes& shared_indexes = g_shared_indexes.Get();
+  base::AutoLock auto_lock(shared_indexes.lock);
+  auto it = shared_indexes.indexes.find(path);
+  if (it == shared_indexes.indexes.end() || it->second.size != size ||
+      it->second.last_modified != last_modified) {
+    SharedIndex shared;
+    if (!CreateSharedIndex(path, size, last_modified, &shared))
+      return;
+    // The index of an older version of the archive is replaced.
+    shared_indexes.indexes[path] = std::move(shared);
+  }
+
+  const SharedIndex& shared = shared_indexes.indexes[path];
+  *header_size = shared.header_size;
+  *region = shared.region.Duplicate();
+}
+
+}  // namespace atom
@@ -0,0 +1,49 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_ASAR_INDEX_DISTRIBUTOR_H_
+#define ATOM_BROWSER_ASAR_INDEX_DISTRIBUTOR_H_
+
+#include "base/files/file_path.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/ref_counted.h"
+#include "content/public/browser/browser_message_filter.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace atom {
+
+// Hands the indexes of the asar archives parsed by the browser process to the
+// render processes that ask for them, so renderers do not parse the same
+// headers again. An index is only handed out for the version of the archive
+// the renderer has opened.
+class AsarIndexDistributor : public content::BrowserMessageFilter {
+ public:
+  AsarIndexDistributor();
+
+  // content::BrowserMessageFilter:
+  base::TaskRunner* OverrideTaskRunnerForMessage(
+      const IPC::Message& message) override;
+  bool OnMessageReceived(const IPC::Message& message) override;
+
+ private:
+  ~AsarIndexDistributor() override;
+
+  void OnGetSharedAsarIndex(const base::FilePath& path,
+                            int64_t size,
+                            int64_t last_modified,
+                            uint32_t* header_size,
+                            base::ReadOnlySharedMemoryRegion* region);
+
+  // The index may have to be built, which can block.
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsarIndexDistributor);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_ASAR_INDEX_DISTRIBUTOR_H_
@@ -4,6 +4,8 @@
 
 #include "atom/browser/atom_blob_reader.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "content/browser/blob_storage/chrome_blob_storage_context.h"
@@ -22,12 +24,12 @@ namespace atom {
 
 namespace {
 
-void FreeNodeBufferData(char* data, void* hint) {
-  delete[] data;
+void ReleaseBlobData(char* data, void* hint) {
+  static_cast<net::IOBuffer*>(hint)->Release();
 }
 
 void RunCallbackInUI(const AtomBlobReader::CompletionCallback& callback,
-                     char* blob_data,
+                     scoped_refptr<net::IOBuffer> blob_data,
                      int size) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
 
@@ -35,9 +37,12 @@ void RunCallbackInUI(const AtomBlobReader::CompletionCallback& callback,
   v8::Locker locker(isolate);
   v8::HandleScope handle_scope(isolate);
   if (blob_data) {
+    // The Buffer uses the memory that the blob was read into, and releases
+    // it when it is garbage collected.
+    blob_data->AddRef();
     v8::Local<v8::Value> buffer =
-        node::Buffer::New(isolate, blob_data, static_cast<size_t>(size),
-                          &FreeNodeBufferData, nullptr)
+        node::Buffer::New(isolate, blob_data->data(), static_cast<size_t>(size),
+                          &ReleaseBlobData, blob_data.get())
             .ToLocalChecked();
     callback.Run(buffer);
   } else {
@@ -54,6 +59,8 @@ AtomBlobReader::~AtomBlobReader() {}
 
 void AtomBlobReader::StartReading(
     const std::string& uuid,
+    uint64_t offset,
+    uint64_t length,
     const AtomBlobReader::CompletionCallback& completion_callback) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
@@ -67,14 +74,19 @@ void AtomBlobReader::StartReading(
 
   auto blob_reader = blob_data_handle->CreateReader();
   BlobReadHelper* blob_read_helper =
-      new BlobReadHelper(std::move(blob_reader), callback);
+      new BlobReadHelper(std::move(blob_reader), offset, length, callback);
   blob_read_helper->Read();
 }
 
 AtomBlobReader::BlobReadHelper::BlobReadHelper(
     std::unique_ptr<storage::BlobReader> blob_reader,
+    uint64_t offset,
+    uint64_t length,
     const BlobReadHelper::CompletionCallback& callback)
-    : blob_reader_(std::move(blob_reader)), completion_callback_(callback) {}
+    : blob_reader_(std::move(blob_reader)),
+      offset_(offset),
+      length_(length),
+      completion_callback_(callback) {}
 
 AtomBlobReader::BlobReadHelper::~BlobReadHelper() {}
 
@@ -97,27 +109,45 @@ void AtomBlobReader::BlobReadHelper::DidCalculateSize(int result) {
   }
 
   uint64_t total_size = blob_reader_->total_size();
+  uint64_t offset = std::min(offset_, total_size);
+  uint64_t size = std::min(length_, total_size - offset);
+  if (size > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+    DidReadBlobData(nullptr, 0);
+    return;
+  }
+  if (size == 0) {
+    DidReadBlobData(new net::IOBuffer(0), 0);
+    return;
+  }
+  if (blob_reader_->SetReadRange(offset, size) !=
+      storage::BlobReader::Status::DONE) {
+    DidReadBlobData(nullptr, 0);
+    return;
+  }
+
   int bytes_read = 0;
   scoped_refptr<net::IOBuffer> blob_data =
-      new net::IOBuffer(static_cast<size_t>(total_size));
+      new net::IOBuffer(static_cast<size_t>(size));
   auto callback =
       base::Bind(&AtomBlobReader::BlobReadHelper::DidReadBlobData,
                  base::Unretained(this), base::RetainedRef(blob_data));
-  storage::BlobReader::Status read_status =
-      blob_reader_->Read(blob_data.get(), total_size, &bytes_read, callback);
+  storage::BlobReader::Status read_status = blob_reader_->Read(
+      blob_data.get(), static_cast<int>(size), &bytes_read, callback);
   if (read_status != storage::BlobReader::Status::IO_PENDING)
     callback.Run(bytes_read);
 }
 
 void AtomBlobReader::BlobReadHelper::DidReadBlobData(
-    const scoped_refptr<net::IOBuffer>& blob_data,
+    scoped_refptr<net::IOBuffer> blob_data,
     int size) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
-  char* data = new char[size];
-  memcpy(data, blob_data->data(), size);
-  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
-                          base::BindOnce(completion_callback_, data, size));
+  // The failed reads pass a negative |size|.
+  if (size < 0)
+    blob_data = nullptr;
+  BrowserThread::PostTask(
+      BrowserThread::UI, FROM_HERE,
+      base::BindOnce(completion_callback_, blob_data, size));
   delete this;
 }
 
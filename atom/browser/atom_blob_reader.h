@@ -9,6 +9,7 @@
 #include <string>
 
 #include "base/callback.h"
+#include "base/memory/ref_counted.h"
 
 namespace content {
 class ChromeBlobStorageContext;
@@ -40,7 +41,11 @@ class AtomBlobReader {
   explicit AtomBlobReader(content::ChromeBlobStorageContext* blob_context);
   ~AtomBlobReader();
 
+  // Reads at most |length| bytes of the blob from |offset|. The callback gets
+  // null when the blob can't be read, and an empty Buffer past its end.
   void StartReading(const std::string& uuid,
+                    uint64_t offset,
+                    uint64_t length,
                     const AtomBlobReader::CompletionCallback& callback);
 
  private:
@@ -48,9 +53,12 @@ class AtomBlobReader {
   // Must be accessed on IO thread.
   class BlobReadHelper {
    public:
-    using CompletionCallback = base::Callback<void(char*, int)>;
+    using CompletionCallback =
+        base::Callback<void(scoped_refptr<net::IOBuffer>, int)>;
 
     BlobReadHelper(std::unique_ptr<storage::BlobReader> blob_reader,
+                   uint64_t offset,
+                   uint64_t length,
                    const BlobReadHelper::CompletionCallback& callback);
     ~BlobReadHelper();
 
@@ -58,10 +66,12 @@ class AtomBlobReader {
 
    private:
     void DidCalculateSize(int result);
-    void DidReadBlobData(const scoped_refptr<net::IOBuffer>& blob_data,
+    void DidReadBlobData(scoped_refptr<net::IOBuffer> blob_data,
                          int bytes_read);
 
     std::unique_ptr<storage::BlobReader> blob_reader_;
+    uint64_t offset_;
+    uint64_t length_;
     BlobReadHelper::CompletionCallback completion_callback_;
 
     DISALLOW_COPY_AND_ASSIGN(BlobReadHelper);
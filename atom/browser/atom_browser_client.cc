@@ -14,9 +14,12 @@
 #include "atom/browser/api/atom_api_app.h"
 #include "atom/browser/api/atom_api_protocol.h"
 #include "atom/browser/api/atom_api_web_contents.h"
+#include "atom/browser/after_startup_task_utils.h"
+#include "atom/browser/asar_index_distributor.h"
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/atom_navigation_throttle.h"
+#include "atom/browser/atom_paths.h"
 #include "atom/browser/atom_quota_permission_context.h"
 #include "atom/browser/atom_resource_dispatcher_host_delegate.h"
 #include "atom/browser/atom_speech_recognition_manager_delegate.h"
@@ -24,6 +27,7 @@
 #include "atom/browser/font_defaults.h"
 #include "atom/browser/io_thread.h"
 #include "atom/browser/media/media_capture_devices_dispatcher.h"
+#include "atom/browser/memory_metrics_request.h"
 #include "atom/browser/native_window.h"
 #include "atom/browser/notifications/notification_presenter.h"
 #include "atom/browser/notifications/platform_notification_service.h"
@@ -32,8 +36,10 @@
 #include "atom/browser/web_contents_permission_helper.h"
 #include "atom/browser/web_contents_preferences.h"
 #include "atom/browser/window_list.h"
+#include "atom/common/asar/archive.h"
 #include "atom/common/options_switches.h"
 #include "atom/common/platform_util.h"
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/environment.h"
 #include "base/files/file_util.h"
@@ -45,6 +51,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/browser_process.h"
 #include "components/net_log/chrome_net_log.h"
 #include "content/public/browser/browser_ppapi_host.h"
@@ -179,9 +186,15 @@ AtomBrowserClient::~AtomBrowserClient() {
 content::WebContents* AtomBrowserClient::GetWebContentsFromProcessID(
     int process_id) {
   // If the process is a pending process, we should use the web contents
-  // for the frame host passed into OverrideSiteInstanceForNavigation.
-  if (base::ContainsKey(pending_processes_, process_id))
-    return pending_processes_[process_id];
+  // for the frame host passed into OverrideSiteInstanceForNavigation. A
+  // reused process can outlive it, so it is looked up again.
+  auto it = pending_processes_.find(process_id);
+  if (it != pending_processes_.end()) {
+    auto* web_contents = content::WebContents::FromFrameTreeNodeId(it->second);
+    if (web_contents)
+      return web_contents;
+    pending_processes_.erase(it);
+  }
 
   // Certain render process will be created with no associated render view,
   // for example: ServiceWorker.
@@ -220,6 +233,22 @@ bool AtomBrowserClient::ShouldCreateNewSiteInstance(
   return !IsSameWebSite(browser_context, src_url, url);
 }
 
+// static
+AtomBrowserClient::ProcessPreferences AtomBrowserClient::GetPreferencesOf(
+    content::WebContents* web_contents) {
+  ProcessPreferences prefs;
+  auto* web_preferences = WebContentsPreferences::From(web_contents);
+  if (web_preferences) {
+    prefs.sandbox =
+        web_preferences->IsEnabled(WebContentsPreferences::Flag::kSandbox);
+    prefs.native_window_open = web_preferences->IsEnabled(
+        WebContentsPreferences::Flag::kNativeWindowOpen);
+    prefs.disable_popups = web_preferences->IsEnabled(
+        WebContentsPreferences::Flag::kDisablePopups);
+  }
+  return prefs;
+}
+
 void AtomBrowserClient::AddProcessPreferences(
     int process_id,
     AtomBrowserClient::ProcessPreferences prefs) {
@@ -252,6 +281,9 @@ bool AtomBrowserClient::RendererDisablesPopups(int process_id) {
 void AtomBrowserClient::RenderProcessWillLaunch(
     content::RenderProcessHost* host,
     service_manager::mojom::ServiceRequest* service_request) {
+  // A relaunched process has lost the stylesheets it was sent before.
+  SessionPreferences::SendUserStyleSheets(host);
+
   // When a render process is crashed, it might be reused.
   int process_id = host->GetID();
   if (IsProcessObserved(process_id))
@@ -266,16 +298,11 @@ void AtomBrowserClient::RenderProcessWillLaunch(
   host->AddFilter(new TtsMessageFilter(host->GetBrowserContext()));
 #endif
 
-  ProcessPreferences prefs;
-  auto* web_preferences =
-      WebContentsPreferences::From(GetWebContentsFromProcessID(process_id));
-  if (web_preferences) {
-    prefs.sandbox = web_preferences->IsEnabled(options::kSandbox);
-    prefs.native_window_open =
-        web_preferences->IsEnabled(options::kNativeWindowOpen);
-    prefs.disable_popups = web_preferences->IsEnabled("disablePopups");
-  }
-  AddProcessPreferences(host->GetID(), prefs);
+  host->AddFilter(MemoryMetricsRequest::CreateMessageFilter(process_id).get());
+  host->AddFilter(new AsarIndexDistributor);
+
+  AddProcessPreferences(
+      host->GetID(), GetPreferencesOf(GetWebContentsFromProcessID(process_id)));
   // ensure the ProcessPreferences is removed later
   host->AddObserver(this);
 }
@@ -348,7 +375,7 @@ void AtomBrowserClient::OverrideSiteInstanceForNavigation(
       *new_instance = candidate_instance;
       // Remember the original web contents for the pending renderer process.
       auto* pending_process = candidate_instance->GetProcess();
-      pending_processes_[pending_process->GetID()] = web_contents;
+      AddPendingProcess(pending_process->GetID(), web_contents);
     }
   } else {
     // OverrideSiteInstanceForNavigation will be called more than once during a
@@ -365,10 +392,31 @@ void AtomBrowserClient::OverrideSiteInstanceForNavigation(
       return;
     }
 
+    // Use a process that was launched ahead of time when there is one, the
+    // processes picked by a reuse policy are launched on demand.
+    scoped_refptr<content::SiteInstance> spare =
+        renderer_reuse_policy_.IsEnabled()
+            ? nullptr
+            : spare_renderer_pool_.Take(web_contents);
+    if (spare) {
+      *new_instance = spare.get();
+      int process_id = spare->GetProcess()->GetID();
+      AddPendingProcess(process_id, web_contents);
+      // The process was launched without knowing its WebContents.
+      AddProcessPreferences(process_id, GetPreferencesOf(web_contents));
+      // Keep the SiteInstance alive until the caller takes a reference.
+      base::ThreadTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE,
+          base::BindOnce([](scoped_refptr<content::SiteInstance>) {},
+                         std::move(spare)));
+      return;
+    }
+
     *new_instance = candidate_instance;
     // Remember the original web contents for the pending renderer process.
-    auto* pending_process = candidate_instance->GetProcess();
-    pending_processes_[pending_process->GetID()] = web_contents;
+    auto* pending_process =
+        renderer_reuse_policy_.GetProcess(web_contents, candidate_instance);
+    AddPendingProcess(pending_process->GetID(), web_contents);
   }
 }
 
@@ -416,6 +464,19 @@ void AtomBrowserClient::AppendExtraCommandLineSwitches(
     command_line->AppendSwitchPath(switches::kAppPath, app_path);
   }
 
+  base::FilePath asar_cache = asar::Archive::GetExtractionCacheDirectory();
+  if (!asar_cache.empty())
+    command_line->AppendSwitchPath(switches::kAsarExtractionCache, asar_cache);
+
+  base::FilePath user_data;
+  if (base::PathService::Get(DIR_USER_DATA, &user_data))
+    command_line->AppendSwitchPath(
+        switches::kAsarCodeCache,
+        user_data.Append(FILE_PATH_LITERAL("Asar Code Cache")));
+
+  if (spare_renderer_pool_.AppendSwitches(process_id, command_line))
+    return;
+
   content::WebContents* web_contents = GetWebContentsFromProcessID(process_id);
   if (web_contents) {
     auto* web_preferences = WebContentsPreferences::From(web_contents);
@@ -426,6 +487,17 @@ void AtomBrowserClient::AppendExtraCommandLineSwitches(
   }
 }
 
+bool AtomBrowserClient::ShouldTryToUseExistingProcessHost(
+    content::BrowserContext* browser_context,
+    const GURL& url) {
+  return renderer_reuse_policy_.ShouldTryToUseExistingProcessHost();
+}
+
+bool AtomBrowserClient::IsSuitableHost(content::RenderProcessHost* process_host,
+                                       const GURL& site_url) {
+  return renderer_reuse_policy_.IsSuitableHost(process_host, site_url);
+}
+
 void AtomBrowserClient::DidCreatePpapiPlugin(content::BrowserPpapiHost* host) {
 #if BUILDFLAG(ENABLE_PEPPER_FLASH)
   host->GetPpapiHost()->AddHostFactoryFilter(
@@ -649,6 +721,12 @@ void AtomBrowserClient::WebNotificationAllowed(
       base::Bind(callback, web_contents->IsAudioMuted()));
 }
 
+void AtomBrowserClient::AddPendingProcess(int process_id,
+                                          content::WebContents* web_contents) {
+  pending_processes_[process_id] =
+      web_contents->GetMainFrame()->GetFrameTreeNodeId();
+}
+
 void AtomBrowserClient::RenderProcessHostDestroyed(
     content::RenderProcessHost* host) {
   int process_id = host->GetID();
@@ -778,6 +856,17 @@ void AtomBrowserClient::OnNetworkServiceCreated(
       network_service);
 }
 
+void AtomBrowserClient::PostAfterStartupTask(
+    const base::Location& from_here,
+    const scoped_refptr<base::TaskRunner>& task_runner,
+    base::OnceClosure task) {
+  AfterStartupTaskUtils::PostTask(from_here, task_runner, std::move(task));
+}
+
+bool AtomBrowserClient::IsBrowserStartupComplete() {
+  return AfterStartupTaskUtils::IsBrowserStartupComplete();
+}
+
 std::string AtomBrowserClient::GetApplicationLocale() {
   if (BrowserThread::CurrentlyOn(BrowserThread::IO))
     return g_io_thread_application_locale.Get();
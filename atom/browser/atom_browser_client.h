@@ -11,6 +11,8 @@
 #include <string>
 #include <vector>
 
+#include "atom/browser/renderer_reuse_policy.h"
+#include "atom/browser/spare_renderer_pool.h"
 #include "content/public/browser/content_browser_client.h"
 #include "content/public/browser/render_process_host_observer.h"
 #include "net/ssl/client_cert_identity.h"
@@ -54,6 +56,11 @@ class AtomBrowserClient : public content::ContentBrowserClient,
 
   NotificationPresenter* GetNotificationPresenter();
 
+  SpareRendererPool* spare_renderer_pool() { return &spare_renderer_pool_; }
+  RendererReusePolicy* renderer_reuse_policy() {
+    return &renderer_reuse_policy_;
+  }
+
   void WebNotificationAllowed(int render_process_id,
                               const base::Callback<void(bool, bool)>& callback);
 
@@ -81,6 +88,11 @@ class AtomBrowserClient : public content::ContentBrowserClient,
       content::SiteInstance** new_instance) override;
   void AppendExtraCommandLineSwitches(base::CommandLine* command_line,
                                       int child_process_id) override;
+  bool ShouldTryToUseExistingProcessHost(
+      content::BrowserContext* browser_context,
+      const GURL& url) override;
+  bool IsSuitableHost(content::RenderProcessHost* process_host,
+                      const GURL& site_url) override;
   void DidCreatePpapiPlugin(content::BrowserPpapiHost* browser_host) override;
   std::string GetGeolocationApiKey() override;
   content::QuotaPermissionContext* CreateQuotaPermissionContext() override;
@@ -143,6 +155,10 @@ class AtomBrowserClient : public content::ContentBrowserClient,
   GetSystemSharedURLLoaderFactory() override;
   void OnNetworkServiceCreated(
       network::mojom::NetworkService* network_service) override;
+  void PostAfterStartupTask(const base::Location& from_here,
+                            const scoped_refptr<base::TaskRunner>& task_runner,
+                            base::OnceClosure task) override;
+  bool IsBrowserStartupComplete() override;
 
   // content::RenderProcessHostObserver:
   void RenderProcessHostDestroyed(content::RenderProcessHost* host) override;
@@ -166,6 +182,9 @@ class AtomBrowserClient : public content::ContentBrowserClient,
     bool disable_popups = false;
   };
 
+  static ProcessPreferences GetPreferencesOf(
+      content::WebContents* web_contents);
+
   bool ShouldCreateNewSiteInstance(content::RenderFrameHost* render_frame_host,
                                    content::BrowserContext* browser_context,
                                    content::SiteInstance* current_instance,
@@ -177,8 +196,12 @@ class AtomBrowserClient : public content::ContentBrowserClient,
   bool RendererUsesNativeWindowOpen(int process_id);
   bool RendererDisablesPopups(int process_id);
 
-  // pending_render_process => web contents.
-  std::map<int, content::WebContents*> pending_processes_;
+  // Remembers |web_contents| as the owner of the pending |process_id|.
+  void AddPendingProcess(int process_id, content::WebContents* web_contents);
+
+  // pending_render_process => frame tree node of the web contents' main frame,
+  // which does not dangle when the web contents is destroyed first.
+  std::map<int, int> pending_processes_;
 
   std::map<int, ProcessPreferences> process_preferences_;
   std::map<int, base::ProcessId> render_process_host_pids_;
@@ -186,6 +209,9 @@ class AtomBrowserClient : public content::ContentBrowserClient,
   // list of site per affinity. weak_ptr to prevent instance locking
   std::map<std::string, content::SiteInstance*> site_per_affinities;
 
+  SpareRendererPool spare_renderer_pool_;
+  RendererReusePolicy renderer_reuse_policy_;
+
   std::unique_ptr<AtomResourceDispatcherHostDelegate>
       resource_dispatcher_host_delegate_;
 
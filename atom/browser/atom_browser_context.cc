@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "atom/browser/atom_blob_reader.h"
+#include "atom/browser/atom_browser_client.h"
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/atom_download_manager_delegate.h"
 #include "atom/browser/atom_paths.h"
@@ -20,6 +21,7 @@
 #include "atom/browser/web_view_manager.h"
 #include "atom/browser/zoom_level_delegate.h"
 #include "atom/common/application_info.h"
+#include "atom/common/asar/archive.h"
 #include "atom/common/atom_version.h"
 #include "atom/common/options_switches.h"
 #include "base/command_line.h"
@@ -33,6 +35,7 @@
 #include "chrome/common/chrome_version.h"
 #include "chrome/common/pref_names.h"
 #include "components/keyed_service/content/browser_context_dependency_manager.h"
+#include "components/prefs/in_memory_pref_store.h"
 #include "components/prefs/json_pref_store.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
@@ -96,15 +99,27 @@ AtomBrowserContext::AtomBrowserContext(const std::string& partition,
   base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
   use_cache_ = !command_line->HasSwitch(switches::kDisableHttpCache);
   options.GetBoolean("cache", &use_cache_);
+  options.GetInteger("maxSocketsPerGroup", &max_sockets_per_group_);
+  options.GetInteger("maxSocketsPerPool", &max_sockets_per_pool_);
 
   base::StringToInt(command_line->GetSwitchValueASCII(switches::kDiskCacheSize),
                     &max_cache_size_);
+  options.GetInteger("cacheSize", &max_cache_size_);
+  options.GetBoolean("cacheInMemory", &cache_in_memory_);
+  options.GetBoolean("persistHostCache", &persist_host_cache_);
+  options.GetInteger("cookieCommitInterval", &cookie_commit_interval_);
+  options.GetInteger("cookieCommitBatchSize", &cookie_commit_batch_size_);
 
   if (!base::PathService::Get(DIR_USER_DATA, &path_)) {
     base::PathService::Get(DIR_APP_DATA, &path_);
     path_ = path_.Append(base::FilePath::FromUTF8Unsafe(GetApplicationName()));
     base::PathService::Override(DIR_USER_DATA, path_);
   }
+  // The extraction cache follows the user data directory unless the app has
+  // set it explicitly.
+  if (asar::Archive::GetExtractionCacheDirectory().empty())
+    asar::Archive::SetExtractionCacheDirectory(
+        path_.Append(asar::Archive::kExtractionCacheDirectoryName));
 
   if (!in_memory && !partition.empty())
     path_ = path_.Append(FILE_PATH_LITERAL("Partitions"))
@@ -116,15 +131,15 @@ AtomBrowserContext::AtomBrowserContext(const std::string& partition,
   // Initialize Pref Registry.
   InitPrefs();
 
-  proxy_config_monitor_ = std::make_unique<ProxyConfigMonitor>(prefs_.get());
   io_handle_ = new URLRequestContextGetter::Handle(weak_factory_.GetWeakPtr());
-  cookie_change_notifier_ = std::make_unique<CookieChangeNotifier>(this);
 
   BrowserContextDependencyManager::GetInstance()->MarkBrowserContextLive(this);
 }
 
 AtomBrowserContext::~AtomBrowserContext() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (AtomBrowserClient::Get())
+    AtomBrowserClient::Get()->spare_renderer_pool()->DiscardSpares(this);
   NotifyWillBeDestroyed(this);
   ShutdownStoragePartitions();
   io_handle_->ShutdownOnUIThread();
@@ -134,13 +149,19 @@ AtomBrowserContext::~AtomBrowserContext() {
 }
 
 void AtomBrowserContext::InitPrefs() {
-  auto prefs_path = GetPath().Append(FILE_PATH_LITERAL("Preferences"));
-  base::ThreadRestrictions::ScopedAllowIO allow_io;
   PrefServiceFactory prefs_factory;
-  scoped_refptr<JsonPrefStore> pref_store =
-      base::MakeRefCounted<JsonPrefStore>(prefs_path);
-  pref_store->ReadPrefs();  // Synchronous.
-  prefs_factory.set_user_prefs(pref_store);
+  if (in_memory_) {
+    // In-memory partitions share |path_| with the default partition, they
+    // must neither read nor write its Preferences file.
+    prefs_factory.set_user_prefs(base::MakeRefCounted<InMemoryPrefStore>());
+  } else {
+    auto prefs_path = GetPath().Append(FILE_PATH_LITERAL("Preferences"));
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    scoped_refptr<JsonPrefStore> pref_store =
+        base::MakeRefCounted<JsonPrefStore>(prefs_path);
+    pref_store->ReadPrefs();  // Synchronous.
+    prefs_factory.set_user_prefs(pref_store);
+  }
 
   auto registry = WrapRefCounted(new PrefRegistrySimple);
 
@@ -162,6 +183,18 @@ void AtomBrowserContext::InitPrefs() {
   prefs_->UpdateCommandLinePrefStore(new ValueMapPrefStore);
 }
 
+CookieChangeNotifier* AtomBrowserContext::cookie_change_notifier() {
+  if (!cookie_change_notifier_)
+    cookie_change_notifier_ = std::make_unique<CookieChangeNotifier>(this);
+  return cookie_change_notifier_.get();
+}
+
+ProxyConfigMonitor* AtomBrowserContext::proxy_config_monitor() {
+  if (!proxy_config_monitor_)
+    proxy_config_monitor_ = std::make_unique<ProxyConfigMonitor>(prefs_.get());
+  return proxy_config_monitor_.get();
+}
+
 void AtomBrowserContext::SetUserAgent(const std::string& user_agent) {
   user_agent_ = user_agent;
 }
@@ -52,6 +52,16 @@ class AtomBrowserContext
   std::string GetUserAgent() const;
   bool CanUseHttpCache() const;
   int GetMaxCacheSize() const;
+  // Whether the HTTP cache of a persistent session is kept in memory.
+  bool cache_in_memory() const { return cache_in_memory_; }
+  // Whether the resolved host names are resolved again in the next launch.
+  bool persist_host_cache() const { return persist_host_cache_; }
+  // 0 when the default limits of the socket pools are used.
+  int max_sockets_per_group() const { return max_sockets_per_group_; }
+  int max_sockets_per_pool() const { return max_sockets_per_pool_; }
+  // 0 when the cookie store commits on Chromium's schedule.
+  int cookie_commit_interval() const { return cookie_commit_interval_; }
+  int cookie_commit_batch_size() const { return cookie_commit_batch_size_; }
   AtomBlobReader* GetBlobReader();
   network::mojom::NetworkContextPtr GetNetworkContext();
   // Get the request context, if there is none, create it.
@@ -89,12 +99,11 @@ class AtomBrowserContext
       content::URLRequestInterceptorScopedVector request_interceptors) override;
   net::URLRequestContextGetter* CreateMediaRequestContext() override;
 
-  CookieChangeNotifier* cookie_change_notifier() const {
-    return cookie_change_notifier_.get();
-  }
-  ProxyConfigMonitor* proxy_config_monitor() {
-    return proxy_config_monitor_.get();
-  }
+  // Created on first use, listening to cookie changes and tracking the proxy
+  // config need the storage partition and the platform proxy service, which
+  // partitions that never load anything should not pay for.
+  CookieChangeNotifier* cookie_change_notifier();
+  ProxyConfigMonitor* proxy_config_monitor();
   PrefService* prefs() const { return prefs_.get(); }
   void set_in_memory_pref_store(ValueMapPrefStore* pref_store) {
     in_memory_pref_store_ = pref_store;
@@ -165,6 +174,12 @@ class AtomBrowserContext
   bool in_memory_ = false;
   bool use_cache_ = true;
   int max_cache_size_ = 0;
+  bool cache_in_memory_ = false;
+  bool persist_host_cache_ = false;
+  int max_sockets_per_group_ = 0;
+  int max_sockets_per_pool_ = 0;
+  int cookie_commit_interval_ = 0;
+  int cookie_commit_batch_size_ = 0;
 
   base::WeakPtrFactory<AtomBrowserContext> weak_factory_;
 
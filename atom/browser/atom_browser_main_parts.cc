@@ -4,6 +4,7 @@
 
 #include "atom/browser/atom_browser_main_parts.h"
 
+#include <map>
 #include <utility>
 
 #if defined(OS_LINUX)
@@ -13,6 +14,7 @@
 #include "atom/app/atom_main_delegate.h"
 #include "atom/browser/api/atom_api_app.h"
 #include "atom/browser/api/trackable_object.h"
+#include "atom/browser/after_startup_task_utils.h"
 #include "atom/browser/atom_browser_client.h"
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/atom_paths.h"
@@ -21,20 +23,31 @@
 #include "atom/browser/browser_process_impl.h"
 #include "atom/browser/javascript_environment.h"
 #include "atom/browser/media/media_capture_devices_dispatcher.h"
+#include "atom/browser/memory_pressure_hub.h"
 #include "atom/browser/node_debugger.h"
 #include "atom/browser/ui/devtools_manager_delegate.h"
 #include "atom/common/api/atom_bindings.h"
 #include "atom/common/application_info.h"
 #include "atom/common/asar/asar_util.h"
+#include "atom/common/asar/readahead.h"
 #include "atom/common/node_bindings.h"
+#include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
 #include "base/base_switches.h"
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
 #include "base/message_loop/message_loop.h"
+#include "base/metrics/field_trial.h"
+#include "base/metrics/field_trial_params.h"
 #include "base/path_service.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/icon_manager.h"
+#include "components/download/public/common/download_features.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "content/public/browser/web_ui_controller_factory.h"
@@ -62,7 +75,6 @@
 #if defined(USE_X11)
 #include "base/environment.h"
 #include "base/nix/xdg_util.h"
-#include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/ui/libgtkui/gtk_ui.h"
 #include "chrome/browser/ui/libgtkui/gtk_util.h"
 #include "ui/base/x/x11_util.h"
@@ -95,6 +107,20 @@ namespace atom {
 
 namespace {
 
+// How long the reads from asar archives are recorded after startup.
+const int kReadRecordingSeconds = 10;
+
+// Whether |subsystem| is in the list of --defer-initialization.
+bool ShouldDeferInitialization(base::StringPiece subsystem) {
+  std::string value =
+      base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+          switches::kDeferInitialization);
+  return base::ContainsValue(
+      base::SplitStringPiece(value, ",", base::TRIM_WHITESPACE,
+                             base::SPLIT_WANT_NONEMPTY),
+      subsystem);
+}
+
 template <typename T>
 void Erase(T* container, typename T::iterator iter) {
   container->erase(iter);
@@ -213,9 +239,46 @@ void AtomBrowserMainParts::InitializeFeatureList() {
 #endif
   auto feature_list = std::make_unique<base::FeatureList>();
   feature_list->InitializeFromCommandLine(enable_features, disable_features);
+  InitializeParallelDownloadTrial(feature_list.get());
   base::FeatureList::SetInstance(std::move(feature_list));
 }
 
+void AtomBrowserMainParts::InitializeParallelDownloadTrial(
+    base::FeatureList* feature_list) {
+  auto* cmd_line = base::CommandLine::ForCurrentProcess();
+  int connections = 0;
+  if (!base::StringToInt(
+          cmd_line->GetSwitchValueASCII(switches::kParallelDownloadConnections),
+          &connections) ||
+      connections < 2)
+    return;
+
+  // The parameters of Chromium's parallel downloads are only read from a
+  // field trial, so a local one carries the number of connections. The trial
+  // survives the reinitialization of the feature list.
+  if (!field_trial_list_)
+    field_trial_list_ = std::make_unique<base::FieldTrialList>(nullptr);
+  const char kTrialName[] = "ElectronParallelDownload";
+  const char kGroupName[] = "Enabled";
+  base::FieldTrial* trial = base::FieldTrialList::Find(kTrialName);
+  if (!trial) {
+    std::map<std::string, std::string> params;
+    params["enable_parallel_download"] = "true";
+    params["request_count"] = base::IntToString(connections);
+    // Start the extra requests as soon as the first response arrived, also
+    // for downloads that are about to finish.
+    params["parallel_request_delay"] = "0";
+    params["remaining_time"] = "0";
+    base::AssociateFieldTrialParams(kTrialName, kGroupName, params);
+    trial = base::FieldTrialList::CreateFieldTrial(kTrialName, kGroupName);
+  }
+  if (trial) {
+    feature_list->RegisterFieldTrialOverride(
+        download::features::kParallelDownloading.name,
+        base::FeatureList::OVERRIDE_ENABLE_FEATURE, trial);
+  }
+}
+
 #if !defined(OS_MACOSX)
 void AtomBrowserMainParts::OverrideAppLogsPath() {
   base::FilePath path;
@@ -235,7 +298,7 @@ AtomBrowserMainParts::AtomBrowserMainParts(
     : fake_browser_process_(new BrowserProcessImpl),
       browser_(new Browser),
       node_bindings_(NodeBindings::Create(NodeBindings::BROWSER)),
-      atom_bindings_(new AtomBindings(uv_default_loop())),
+      atom_bindings_(new AtomBindings(node_bindings_.get())),
       main_function_params_(params) {
   DCHECK(!self_) << "Cannot have two AtomBrowserMainParts";
   self_ = this;
@@ -288,6 +351,7 @@ bool AtomBrowserMainParts::ShouldContentCreateFeatureList() {
 }
 
 int AtomBrowserMainParts::PreEarlyInitialization() {
+  StartupTimeline::AddMark("preEarlyInitialization");
   InitializeFeatureList();
   OverrideAppLogsPath();
 #if defined(USE_X11)
@@ -308,6 +372,8 @@ int AtomBrowserMainParts::PreEarlyInitialization() {
 }
 
 void AtomBrowserMainParts::PostEarlyInitialization() {
+  StartupTimeline::AddMark("postEarlyInitialization");
+
   // A workaround was previously needed because there was no ThreadTaskRunner
   // set.  If this check is failing we may need to re-add that workaround
   DCHECK(base::ThreadTaskRunnerHandle::IsSet());
@@ -329,6 +395,10 @@ void AtomBrowserMainParts::PostEarlyInitialization() {
   // Add Electron extended APIs.
   atom_bindings_->BindTo(js_env_->isolate(), env->process_object());
 
+  // Record what the app reads from asar archives during startup, so the next
+  // launch can read it ahead.
+  asar::StartReadRecording(base::TimeDelta::FromSeconds(kReadRecordingSeconds));
+
   // Load everything.
   node_bindings_->LoadEnvironment(env);
 
@@ -368,11 +438,13 @@ int AtomBrowserMainParts::PreCreateThreads() {
   // Force MediaCaptureDevicesDispatcher to be created on UI thread.
   MediaCaptureDevicesDispatcher::GetInstance();
 
-  // Force MediaCaptureDevicesDispatcher to be created on UI thread.
-  MediaCaptureDevicesDispatcher::GetInstance();
-
 #if defined(OS_MACOSX)
-  ui::InitIdleMonitor();
+  if (ShouldDeferInitialization("idle-monitor"))
+    AfterStartupTaskUtils::PostTask(FROM_HERE,
+                                    base::ThreadTaskRunnerHandle::Get(),
+                                    base::BindOnce(&ui::InitIdleMonitor));
+  else
+    ui::InitIdleMonitor();
 #endif
 
   fake_browser_process_->PreCreateThreads(main_function_params_.command_line);
@@ -383,7 +455,8 @@ int AtomBrowserMainParts::PreCreateThreads() {
 void AtomBrowserMainParts::PostDestroyThreads() {
 #if defined(OS_LINUX)
   device::BluetoothAdapterFactory::Shutdown();
-  bluez::DBusBluezManagerWrapperLinux::Shutdown();
+  if (bluez_initialized_)
+    bluez::DBusBluezManagerWrapperLinux::Shutdown();
 #endif
   fake_browser_process_->PostDestroyThreads();
 }
@@ -416,6 +489,8 @@ void AtomBrowserMainParts::ToolkitInitialized() {
 }
 
 void AtomBrowserMainParts::PreMainMessageLoopRun() {
+  StartupTimeline::AddMark("preMainMessageLoopRun");
+
   // Run user's main script before most things get initialized, so we can have
   // a chance to setup everything.
   node_bindings_->PrepareMessageLoop();
@@ -450,6 +525,8 @@ void AtomBrowserMainParts::PreMainMessageLoopRun() {
 
   // Notify observers that main thread message loop was initialized.
   Browser::Get()->PreMainMessageLoopRun();
+
+  AfterStartupTaskUtils::StartMonitoringStartup();
 }
 
 bool AtomBrowserMainParts::MainMessageLoopRun(int* result_code) {
@@ -471,11 +548,18 @@ void AtomBrowserMainParts::PostMainMessageLoopStart() {
   ui::SetX11ErrorHandlers(BrowserX11ErrorHandler, BrowserX11IOErrorHandler);
 #endif
 #if defined(OS_LINUX)
-  bluez::DBusBluezManagerWrapperLinux::Initialize();
+  if (ShouldDeferInitialization("bluetooth"))
+    AfterStartupTaskUtils::PostTask(
+        FROM_HERE, base::ThreadTaskRunnerHandle::Get(),
+        base::BindOnce(&AtomBrowserMainParts::InitializeBluez,
+                       base::Unretained(this)));
+  else
+    InitializeBluez();
 #endif
 #if defined(OS_POSIX)
   HandleShutdownSignals();
 #endif
+  MemoryPressureHub::Get()->Start(js_env_->isolate());
 }
 
 void AtomBrowserMainParts::PostMainMessageLoopRun() {
@@ -486,6 +570,7 @@ void AtomBrowserMainParts::PostMainMessageLoopRun() {
   ui::SetX11ErrorHandlers(X11EmptyErrorHandler, X11EmptyIOErrorHandler);
 #endif
 
+  MemoryPressureHub::Get()->Stop();
   js_env_->OnMessageLoopDestroying();
 
 #if defined(OS_MACOSX)
@@ -558,6 +643,13 @@ AtomBrowserMainParts::GetGeolocationControl() {
   return geolocation_control_.get();
 }
 
+#if defined(OS_LINUX)
+void AtomBrowserMainParts::InitializeBluez() {
+  bluez::DBusBluezManagerWrapperLinux::Initialize();
+  bluez_initialized_ = true;
+}
+#endif
+
 IconManager* AtomBrowserMainParts::GetIconManager() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   if (!icon_manager_.get())
@@ -20,6 +20,11 @@
 class BrowserProcess;
 class IconManager;
 
+namespace base {
+class FeatureList;
+class FieldTrialList;
+}
+
 #if defined(USE_AURA)
 namespace wm {
 class WMState;
@@ -70,6 +75,7 @@ class AtomBrowserMainParts : public content::BrowserMainParts {
   IconManager* GetIconManager();
 
   Browser* browser() { return browser_.get(); }
+  JavascriptEnvironment* js_env() { return js_env_.get(); }
 
  protected:
   // content::BrowserMainParts:
@@ -88,6 +94,7 @@ class AtomBrowserMainParts : public content::BrowserMainParts {
 
  private:
   void InitializeFeatureList();
+  void InitializeParallelDownloadTrial(base::FeatureList* feature_list);
   void OverrideAppLogsPath();
   void PreMainMessageLoopStartCommon();
 
@@ -102,6 +109,10 @@ class AtomBrowserMainParts : public content::BrowserMainParts {
   void InitializeMainNib();
 #endif
 
+#if defined(OS_LINUX)
+  void InitializeBluez();
+#endif
+
 #if defined(OS_MACOSX)
   std::unique_ptr<ViewsDelegateMac> views_delegate_;
 #else
@@ -128,9 +139,15 @@ class AtomBrowserMainParts : public content::BrowserMainParts {
   std::unique_ptr<NodeEnvironment> node_env_;
   std::unique_ptr<NodeDebugger> node_debugger_;
   std::unique_ptr<IconManager> icon_manager_;
+  std::unique_ptr<base::FieldTrialList> field_trial_list_;
 
   base::RepeatingTimer gc_timer_;
 
+#if defined(OS_LINUX)
+  // Whether the connection to BlueZ is initialized, it may be deferred.
+  bool bluez_initialized_ = false;
+#endif
+
   // List of callbacks should be executed before destroying JS env.
   std::list<base::OnceClosure> destructors_;
 
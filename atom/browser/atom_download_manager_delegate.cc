@@ -11,7 +11,6 @@
 #include "atom/browser/native_window.h"
 #include "atom/browser/ui/file_dialog.h"
 #include "atom/browser/web_contents_preferences.h"
-#include "atom/common/options_switches.h"
 #include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/task_scheduler/post_task.h"
@@ -102,7 +101,8 @@ void AtomDownloadManagerDelegate::OnDownloadPathGenerated(
 
   auto* web_preferences = WebContentsPreferences::From(web_contents);
   bool offscreen =
-      !web_preferences || web_preferences->IsEnabled(options::kOffscreen);
+      !web_preferences ||
+      web_preferences->IsEnabled(WebContentsPreferences::Flag::kOffscreen);
 
   base::FilePath path;
   GetItemSavePath(item, &path);
@@ -5,7 +5,9 @@
 #include "atom/browser/atom_navigation_throttle.h"
 
 #include "atom/browser/api/atom_api_web_contents.h"
+#include "atom/browser/session_preferences.h"
 #include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/web_contents.h"
 
 namespace atom {
 
@@ -19,6 +21,17 @@ const char* AtomNavigationThrottle::GetNameForLogging() {
   return "AtomNavigationThrottle";
 }
 
+content::NavigationThrottle::ThrottleCheckResult
+AtomNavigationThrottle::WillStartRequest() {
+  auto* handle = navigation_handle();
+  auto* contents = handle->GetWebContents();
+  if (contents && SessionPreferences::EvaluateNavigation(
+                      contents->GetBrowserContext(), handle->GetURL()) ==
+                      NavigationPolicy::Decision::DENY)
+    return CANCEL;
+  return PROCEED;
+}
+
 content::NavigationThrottle::ThrottleCheckResult
 AtomNavigationThrottle::WillRedirectRequest() {
   auto* handle = navigation_handle();
@@ -28,6 +41,17 @@ AtomNavigationThrottle::WillRedirectRequest() {
     return PROCEED;
   }
 
+  // Only the redirects the navigation policy does not match reach JS.
+  switch (SessionPreferences::EvaluateNavigation(contents->GetBrowserContext(),
+                                                 handle->GetURL())) {
+    case NavigationPolicy::Decision::ALLOW:
+      return PROCEED;
+    case NavigationPolicy::Decision::DENY:
+      return CANCEL;
+    case NavigationPolicy::Decision::UNMATCHED:
+      break;
+  }
+
   auto api_contents =
       atom::api::WebContents::From(v8::Isolate::GetCurrent(), contents);
   if (api_contents.IsEmpty()) {
@@ -14,6 +14,7 @@ class AtomNavigationThrottle : public content::NavigationThrottle {
   explicit AtomNavigationThrottle(content::NavigationHandle* handle);
   ~AtomNavigationThrottle() override;
 
+  AtomNavigationThrottle::ThrottleCheckResult WillStartRequest() override;
   AtomNavigationThrottle::ThrottleCheckResult WillRedirectRequest() override;
 
   const char* GetNameForLogging() override;
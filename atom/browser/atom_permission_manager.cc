@@ -5,11 +5,16 @@
 #include "atom/browser/atom_permission_manager.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "atom/browser/atom_browser_client.h"
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/web_contents_preferences.h"
+#include "base/bind.h"
+#include "base/json/json_writer.h"
+#include "base/memory/ptr_util.h"
+#include "base/stl_util.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "content/public/browser/permission_controller.h"
 #include "content/public/browser/permission_type.h"
@@ -22,6 +27,36 @@ namespace atom {
 
 namespace {
 
+// Cached check decisions are dropped once there are more of them.
+const size_t kMaxCheckCacheSize = 1000;
+
+// Gives each WebContents an id that is never reused, so a cached decision can
+// not apply to a new WebContents allocated at the same address.
+class PermissionCheckId : public base::SupportsUserData::Data {
+ public:
+  static int Get(content::WebContents* web_contents) {
+    static int next_id = 0;
+    if (!web_contents)
+      return 0;
+    auto* data =
+        static_cast<PermissionCheckId*>(web_contents->GetUserData(kKey));
+    if (!data) {
+      data = new PermissionCheckId(++next_id);
+      web_contents->SetUserData(kKey, base::WrapUnique(data));
+    }
+    return data->id_;
+  }
+
+ private:
+  explicit PermissionCheckId(int id) : id_(id) {}
+
+  static const char* const kKey;
+
+  int id_;
+};
+
+const char* const PermissionCheckId::kKey = "AtomPermissionCheckId";
+
 bool WebContentsDestroyed(int process_id) {
   content::WebContents* web_contents =
       static_cast<AtomBrowserClient*>(AtomBrowserClient::Get())
@@ -84,7 +119,11 @@ class AtomPermissionManager::PendingRequest {
   size_t remaining_results_;
 };
 
-AtomPermissionManager::AtomPermissionManager() {}
+AtomPermissionManager::AtomPermissionManager()
+    : memory_pressure_subscription_(
+          MemoryPressureHub::Get()->RegisterTrimCallback(
+              base::BindRepeating(&AtomPermissionManager::OnMemoryPressure,
+                                  base::Unretained(this)))) {}
 
 AtomPermissionManager::~AtomPermissionManager() {}
 
@@ -105,6 +144,16 @@ void AtomPermissionManager::SetPermissionRequestHandler(
 void AtomPermissionManager::SetPermissionCheckHandler(
     const CheckHandler& handler) {
   check_handler_ = handler;
+  check_cache_.clear();
+}
+
+void AtomPermissionManager::ClearPermissionCheckCache() {
+  check_cache_.clear();
+}
+
+void AtomPermissionManager::OnMemoryPressure(MemoryPressureHub::Level level) {
+  // The handler decides again, the cache only saves calls into JavaScript.
+  ClearPermissionCheckCache();
 }
 
 int AtomPermissionManager::RequestPermission(
@@ -241,8 +290,32 @@ bool AtomPermissionManager::CheckPermissionWithDetails(
   }
   auto* web_contents =
       content::WebContents::FromRenderFrameHost(render_frame_host);
-  return check_handler_.Run(web_contents, permission, requesting_origin,
-                            *details);
+
+  std::string details_json;
+  base::JSONWriter::Write(*details, &details_json);
+  CheckCacheKey key(PermissionCheckId::Get(web_contents), permission,
+                    requesting_origin.spec(), details_json);
+  base::TimeTicks now = base::TimeTicks::Now();
+  auto it = check_cache_.find(key);
+  if (it != check_cache_.end()) {
+    if (it->second.expiry > now)
+      return it->second.granted;
+    check_cache_.erase(it);
+  }
+
+  CheckResult result = check_handler_.Run(web_contents, permission,
+                                          requesting_origin, *details);
+  if (result.cache_duration > base::TimeDelta()) {
+    if (check_cache_.size() >= kMaxCheckCacheSize) {
+      base::EraseIf(check_cache_, [now](const auto& entry) {
+        return entry.second.expiry <= now;
+      });
+      if (check_cache_.size() >= kMaxCheckCacheSize)
+        check_cache_.clear();
+    }
+    check_cache_[key] = {result.granted, now + result.cache_duration};
+  }
+  return result.granted;
 }
 
 blink::mojom::PermissionStatus
@@ -7,10 +7,14 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
+#include "atom/browser/memory_pressure_hub.h"
 #include "base/callback.h"
 #include "base/containers/id_map.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/permission_controller_delegate.h"
 
@@ -32,15 +36,25 @@ class AtomPermissionManager : public content::PermissionControllerDelegate {
                                              content::PermissionType,
                                              const StatusCallback&,
                                              const base::DictionaryValue&)>;
-  using CheckHandler = base::Callback<bool(content::WebContents*,
-                                           content::PermissionType,
-                                           const GURL& requesting_origin,
-                                           const base::DictionaryValue&)>;
+  // The decision of the check handler, it is reused for the same check
+  // during |cache_duration|.
+  struct CheckResult {
+    bool granted = false;
+    base::TimeDelta cache_duration;
+  };
+  using CheckHandler =
+      base::Callback<CheckResult(content::WebContents*,
+                                 content::PermissionType,
+                                 const GURL& requesting_origin,
+                                 const base::DictionaryValue&)>;
 
   // Handler to dispatch permission requests in JS.
   void SetPermissionRequestHandler(const RequestHandler& handler);
   void SetPermissionCheckHandler(const CheckHandler& handler);
 
+  // Forgets the cached decisions of the check handler.
+  void ClearPermissionCheckCache();
+
   // content::PermissionControllerDelegate:
   int RequestPermission(
       content::PermissionType permission,
@@ -106,9 +120,24 @@ class AtomPermissionManager : public content::PermissionControllerDelegate {
   class PendingRequest;
   using PendingRequestsMap = base::IDMap<std::unique_ptr<PendingRequest>>;
 
+  // WebContents id, permission, requesting origin and details.
+  using CheckCacheKey =
+      std::tuple<int, content::PermissionType, std::string, std::string>;
+  struct CheckCacheEntry {
+    bool granted;
+    base::TimeTicks expiry;
+  };
+
+  void OnMemoryPressure(MemoryPressureHub::Level level);
+
   RequestHandler request_handler_;
   CheckHandler check_handler_;
 
+  // Decisions of |check_handler_| that were marked as cacheable.
+  mutable std::map<CheckCacheKey, CheckCacheEntry> check_cache_;
+  std::unique_ptr<MemoryPressureHub::Subscription>
+      memory_pressure_subscription_;
+
   PendingRequestsMap pending_requests_;
 
   DISALLOW_COPY_AND_ASSIGN(AtomPermissionManager);
@@ -4,6 +4,9 @@
 
 #include "atom/browser/atom_resource_dispatcher_host_delegate.h"
 
+#include <memory>
+#include <utility>
+
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/web_contents_preferences.h"
 #include "base/strings/utf_string_conversions.h"
@@ -15,6 +18,7 @@
 #include "url/gurl.h"
 
 #if BUILDFLAG(ENABLE_PDF_VIEWER)
+#include "atom/browser/ui/webui/pdf_viewer_ui.h"
 #include "atom/common/atom_constants.h"
 #include "base/strings/stringprintf.h"
 #include "content/public/browser/stream_info.h"
@@ -32,14 +36,15 @@ void OnPdfResourceIntercepted(
     const GURL& original_url,
     int render_process_host_id,
     int render_frame_id,
-    const content::ResourceRequestInfo::WebContentsGetter&
-        web_contents_getter) {
+    const content::ResourceRequestInfo::WebContentsGetter& web_contents_getter,
+    std::unique_ptr<content::StreamInfo> stream) {
   content::WebContents* web_contents = web_contents_getter.Run();
   if (!web_contents)
     return;
 
   auto* web_preferences = WebContentsPreferences::From(web_contents);
-  if (!web_preferences || !web_preferences->IsEnabled(options::kPlugins)) {
+  if (!web_preferences ||
+      !web_preferences->IsEnabled(WebContentsPreferences::Flag::kPlugins)) {
     auto* browser_context = web_contents->GetBrowserContext();
     auto* download_manager =
         content::BrowserContext::GetDownloadManager(browser_context);
@@ -50,19 +55,22 @@ void OnPdfResourceIntercepted(
     return;
   }
 
-  // The URL passes the original pdf resource url, that will be requested
-  // by the webui page.
-  // chrome://pdf-viewer/index.html?src=https://somepage/123.pdf
-  content::NavigationController::LoadURLParams params(GURL(base::StringPrintf(
-      "%sindex.html?%s=%s", kPdfViewerUIOrigin, kPdfPluginSrc,
-      net::EscapeUrlEncodedData(original_url.spec(), false).c_str())));
-
   content::RenderFrameHost* frame_host =
       content::RenderFrameHost::FromID(render_process_host_id, render_frame_id);
   if (!frame_host) {
     return;
   }
 
+  // The intercepted response is handed to the webui page so the resource is
+  // not downloaded a second time, the original url is still passed for
+  // display and as a fallback when the stream has already been released.
+  // chrome://pdf-viewer/index.html?src=https://somepage/123.pdf&stream=<id>
+  std::string stream_id = PdfViewerUI::AddInterceptedStream(std::move(stream));
+  content::NavigationController::LoadURLParams params(GURL(base::StringPrintf(
+      "%sindex.html?%s=%s&%s=%s", kPdfViewerUIOrigin, kPdfPluginSrc,
+      net::EscapeUrlEncodedData(original_url.spec(), false).c_str(),
+      kPdfPluginStream, stream_id.c_str())));
+
   params.frame_tree_node_id = frame_host->GetFrameTreeNodeId();
   web_contents->GetController().LoadURLWithParams(params);
 }
@@ -90,15 +98,33 @@ bool AtomResourceDispatcherHostDelegate::ShouldInterceptResourceAsStream(
 
   if (mime_type == "application/pdf") {
     *origin = GURL(kPdfViewerUIOrigin);
-    content::BrowserThread::PostTask(
-        BrowserThread::UI, FROM_HERE,
-        base::Bind(&OnPdfResourceIntercepted, request->url(),
-                   render_process_host_id, render_frame_id,
-                   info->GetWebContentsGetterForRequest()));
     return true;
   }
 #endif  // BUILDFLAG(ENABLE_PDF_VIEWER)
   return false;
 }
 
+void AtomResourceDispatcherHostDelegate::OnStreamCreated(
+    net::URLRequest* request,
+    std::unique_ptr<content::StreamInfo> stream) {
+#if BUILDFLAG(ENABLE_PDF_VIEWER)
+  const content::ResourceRequestInfo* info =
+      content::ResourceRequestInfo::ForRequest(request);
+
+  int render_process_host_id;
+  int render_frame_id;
+  if (!info->GetAssociatedRenderFrame(&render_process_host_id,
+                                      &render_frame_id)) {
+    return;
+  }
+
+  content::BrowserThread::PostTask(
+      BrowserThread::UI, FROM_HERE,
+      base::BindOnce(&OnPdfResourceIntercepted, request->url(),
+                     render_process_host_id, render_frame_id,
+                     info->GetWebContentsGetterForRequest(),
+                     std::move(stream)));
+#endif  // BUILDFLAG(ENABLE_PDF_VIEWER)
+}
+
 }  // namespace atom
@@ -5,6 +5,7 @@
 #ifndef ATOM_BROWSER_ATOM_RESOURCE_DISPATCHER_HOST_DELEGATE_H_
 #define ATOM_BROWSER_ATOM_RESOURCE_DISPATCHER_HOST_DELEGATE_H_
 
+#include <memory>
 #include <string>
 
 #include "content/public/browser/resource_dispatcher_host_delegate.h"
@@ -21,6 +22,8 @@ class AtomResourceDispatcherHostDelegate
                                        const std::string& mime_type,
                                        GURL* origin,
                                        std::string* payload) override;
+  void OnStreamCreated(net::URLRequest* request,
+                       std::unique_ptr<content::StreamInfo> stream) override;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(AtomResourceDispatcherHostDelegate);
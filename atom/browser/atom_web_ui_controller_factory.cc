@@ -71,6 +71,7 @@ AtomWebUIControllerFactory::CreateWebUIControllerForURL(content::WebUI* web_ui,
     base::StringPairs toplevel_params;
     base::SplitStringIntoKeyValuePairs(url.query(), '=', '&', &toplevel_params);
     std::string src;
+    std::string stream_id;
 
     const net::UnescapeRule::Type unescape_rules =
         net::UnescapeRule::SPACES | net::UnescapeRule::PATH_SEPARATORS |
@@ -80,13 +81,15 @@ AtomWebUIControllerFactory::CreateWebUIControllerForURL(content::WebUI* web_ui,
     for (const auto& param : toplevel_params) {
       if (param.first == kPdfPluginSrc) {
         src = net::UnescapeURLComponent(param.second, unescape_rules);
+      } else if (param.first == kPdfPluginStream) {
+        stream_id = param.second;
       }
     }
     if (url.has_ref()) {
       src = src + '#' + url.ref();
     }
     auto browser_context = web_ui->GetWebContents()->GetBrowserContext();
-    return new PdfViewerUI(browser_context, web_ui, src);
+    return new PdfViewerUI(browser_context, web_ui, src, stream_id);
   }
 #endif  // BUILDFLAG(ENABLE_PDF_VIEWER)
   if (url.host() == kChromeUIDevToolsBundledHost) {
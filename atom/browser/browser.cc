@@ -15,6 +15,7 @@
 #include "atom/browser/native_window.h"
 #include "atom/browser/window_list.h"
 #include "atom/common/application_info.h"
+#include "atom/common/startup_timeline.h"
 #include "base/files/file_util.h"
 #include "base/message_loop/message_loop.h"
 #include "base/no_destructor.h"
@@ -160,6 +161,7 @@ void Browser::DidFinishLaunching(const base::DictionaryValue& launch_info) {
     base::CreateDirectoryAndGetError(user_data, nullptr);
 
   is_ready_ = true;
+  StartupTimeline::AddMark("ready");
   if (ready_promise_) {
     ready_promise_->Resolve();
   }
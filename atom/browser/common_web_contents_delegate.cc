@@ -16,7 +16,6 @@
 #include "atom/browser/web_contents_preferences.h"
 #include "atom/browser/web_dialog_helper.h"
 #include "atom/common/atom_constants.h"
-#include "atom/common/options_switches.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/task_scheduler/post_task.h"
@@ -187,7 +186,8 @@ void CommonWebContentsDelegate::InitWithWebContents(
   // Determien whether the WebContents is offscreen.
   auto* web_preferences = WebContentsPreferences::From(web_contents);
   offscreen_ =
-      !web_preferences || web_preferences->IsEnabled(options::kOffscreen);
+      !web_preferences ||
+      web_preferences->IsEnabled(WebContentsPreferences::Flag::kOffscreen);
 
   // Create InspectableWebContents.
   web_contents_.reset(InspectableWebContents::Create(
@@ -47,8 +47,12 @@ void CommonWebContentsDelegate::ShowAutofillPopup(
     return;
 
   auto* window = static_cast<NativeWindowViews*>(owner_window());
-  autofill_popup_->CreateView(frame_host, embedder_frame_host, offscreen,
-                              window->content_view(), bounds);
+  // The renderer shows the popup again on each keystroke, the popup that is
+  // already shown for the element is only given the new suggestions.
+  if (!autofill_popup_->IsShowingFor(frame_host, window->content_view(),
+                                     bounds))
+    autofill_popup_->CreateView(frame_host, embedder_frame_host, offscreen,
+                                window->content_view(), bounds);
   autofill_popup_->SetItems(values, labels);
 }
 
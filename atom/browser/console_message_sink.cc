@@ -0,0 +1,122 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/console_message_sink.h"
+
+#include <utility>
+
+#include "base/files/file.h"
+#include "base/json/json_writer.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/task_scheduler/post_task.h"
+
+namespace atom {
+
+namespace {
+
+// How often the messages are written when only a file is set.
+constexpr base::TimeDelta kDefaultFileInterval =
+    base::TimeDelta::FromSeconds(1);
+
+void AppendToFile(const base::FilePath& path, const std::string& lines) {
+  base::File file(path, base::File::FLAG_OPEN_ALWAYS |
+                            base::File::FLAG_APPEND | base::File::FLAG_WRITE);
+  if (!file.IsValid()) {
+    LOG(ERROR) << "Unable to open console message log " << path.value();
+    return;
+  }
+  file.WriteAtCurrentPos(lines.data(), lines.size());
+}
+
+}  // namespace
+
+ConsoleMessageSink::Options::Options() = default;
+ConsoleMessageSink::Options::Options(const Options&) = default;
+ConsoleMessageSink::Options::~Options() = default;
+
+ConsoleMessageSink::ConsoleMessageSink(const Options& options,
+                                       const BatchCallback& callback)
+    : options_(options), callback_(callback) {
+  if (!options_.path.empty()) {
+    file_task_runner_ = base::CreateSequencedTaskRunnerWithTraits(
+        {base::MayBlock(), base::TaskPriority::BACKGROUND,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  }
+}
+
+ConsoleMessageSink::~ConsoleMessageSink() {
+  // Only the file gets the last messages, the owner is going away.
+  if (file_task_runner_)
+    Flush();
+}
+
+ConsoleMessageSink::Result ConsoleMessageSink::AddMessage(
+    int32_t level,
+    const base::string16& message,
+    int32_t line_no,
+    const base::string16& source_id) {
+  if (level < options_.min_level)
+    return Result::kDropped;
+
+  if (!options_.sources.empty()) {
+    std::string source = base::UTF16ToUTF8(source_id);
+    bool matched = false;
+    for (const auto& prefix : options_.sources) {
+      if (base::StartsWith(source, prefix, base::CompareCase::SENSITIVE)) {
+        matched = true;
+        break;
+      }
+    }
+    if (!matched)
+      return Result::kDropped;
+  }
+
+  if (options_.path.empty() && options_.batch_interval.is_zero())
+    return Result::kPassThrough;
+
+  auto entry = std::make_unique<base::DictionaryValue>();
+  entry->SetInteger("level", level);
+  entry->SetString("message", message);
+  entry->SetInteger("line", line_no);
+  entry->SetString("sourceId", source_id);
+  pending_messages_.Append(std::move(entry));
+
+  if (!flush_timer_.IsRunning()) {
+    base::TimeDelta interval = options_.batch_interval.is_zero()
+                                   ? kDefaultFileInterval
+                                   : options_.batch_interval;
+    flush_timer_.Start(FROM_HERE, interval,
+                       base::Bind(&ConsoleMessageSink::Flush,
+                                  base::Unretained(this)));
+  }
+  return Result::kQueued;
+}
+
+void ConsoleMessageSink::Flush() {
+  if (pending_messages_.GetList().empty())
+    return;
+
+  base::ListValue messages;
+  messages.Swap(&pending_messages_);
+
+  if (!file_task_runner_) {
+    callback_.Run(messages);
+    return;
+  }
+
+  std::string lines;
+  for (const auto& message : messages.GetList()) {
+    std::string line;
+    base::JSONWriter::Write(message, &line);
+    lines += line;
+    lines += '\n';
+  }
+  file_task_runner_->PostTask(FROM_HERE,
+                              base::BindOnce(&AppendToFile, options_.path,
+                                             std::move(lines)));
+}
+
+}  // namespace atom
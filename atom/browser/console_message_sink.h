@@ -0,0 +1,78 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_CONSOLE_MESSAGE_SINK_H_
+#define ATOM_BROWSER_CONSOLE_MESSAGE_SINK_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string16.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "base/values.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace atom {
+
+// Filters the console messages of a WebContents by level and source, and
+// hands the remaining ones to |callback| in batches, or appends them as lines
+// of JSON to a file without running any JavaScript.
+class ConsoleMessageSink {
+ public:
+  struct Options {
+    Options();
+    Options(const Options&);
+    ~Options();
+
+    int min_level = 0;
+    // Prefixes of the source URLs to keep, empty keeps all of them.
+    std::vector<std::string> sources;
+    // Messages are passed one by one when zero and no |path| is set.
+    base::TimeDelta batch_interval;
+    base::FilePath path;
+  };
+
+  enum class Result {
+    // The message did not pass the filters.
+    kDropped,
+    // The message is part of the next batch.
+    kQueued,
+    // The message should be handled as usual.
+    kPassThrough,
+  };
+
+  using BatchCallback = base::Callback<void(const base::ListValue& messages)>;
+
+  ConsoleMessageSink(const Options& options, const BatchCallback& callback);
+  ~ConsoleMessageSink();
+
+  Result AddMessage(int32_t level,
+                    const base::string16& message,
+                    int32_t line_no,
+                    const base::string16& source_id);
+
+ private:
+  void Flush();
+
+  const Options options_;
+  BatchCallback callback_;
+
+  base::ListValue pending_messages_;
+  base::OneShotTimer flush_timer_;
+
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConsoleMessageSink);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_CONSOLE_MESSAGE_SINK_H_
@@ -0,0 +1,301 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/delta_update.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "build/build_config.h"
+#include "crypto/secure_hash.h"
+#include "crypto/sha2.h"
+
+namespace atom {
+
+namespace {
+
+// Blocks are copied in chunks of this size.
+const int kCopyChunkSize = 1024 * 1024;
+
+// Bounds the memory allocated for the manifest of a corrupted delta.
+const uint32_t kMaxManifestSize = 64 * 1024 * 1024;
+
+#if defined(OS_POSIX)
+const int kExecutableMode = 0755;
+#endif
+
+struct Block {
+  bool from_base = false;
+  int64_t offset = 0;
+  int64_t size = 0;
+};
+
+struct DeltaFile {
+  base::FilePath path;
+  int64_t size = 0;
+  std::string sha256;
+  bool executable = false;
+  base::FilePath base_path;
+  int64_t base_size = 0;
+  std::vector<Block> blocks;
+};
+
+// Offsets beyond 2GB are stored as doubles by the JSON reader.
+bool GetInt64(const base::DictionaryValue& dict,
+              const char* key,
+              int64_t* out) {
+  double value = 0;
+  if (!dict.GetDouble(key, &value) || value < 0)
+    return false;
+  *out = static_cast<int64_t>(value);
+  return true;
+}
+
+// Paths of the manifest must stay inside their directory.
+bool GetRelativePath(const base::DictionaryValue& dict,
+                     const char* key,
+                     base::FilePath* out) {
+  std::string path;
+  if (!dict.GetString(key, &path) || path.empty())
+    return false;
+  *out = base::FilePath::FromUTF8Unsafe(path);
+  return !out->IsAbsolute() && !out->ReferencesParent();
+}
+
+bool ParseFile(const base::DictionaryValue& dict, DeltaFile* file) {
+  if (!GetRelativePath(dict, "path", &file->path) ||
+      !GetInt64(dict, "size", &file->size) ||
+      !dict.GetString("sha256", &file->sha256))
+    return false;
+  file->sha256 = base::ToLowerASCII(file->sha256);
+  dict.GetBoolean("executable", &file->executable);
+
+  const base::DictionaryValue* base = nullptr;
+  if (dict.GetDictionary("base", &base) &&
+      (!GetRelativePath(*base, "path", &file->base_path) ||
+       !GetInt64(*base, "size", &file->base_size)))
+    return false;
+
+  const base::ListValue* blocks = nullptr;
+  if (!dict.GetList("blocks", &blocks))
+    return false;
+  for (const base::Value& value : blocks->GetList()) {
+    const base::DictionaryValue* block_dict = nullptr;
+    if (!value.GetAsDictionary(&block_dict))
+      return false;
+    Block block;
+    std::string source;
+    if (!block_dict->GetString("source", &source) ||
+        (source != "base" && source != "delta") ||
+        !GetInt64(*block_dict, "offset", &block.offset) ||
+        !GetInt64(*block_dict, "size", &block.size))
+      return false;
+    block.from_base = source == "base";
+    if (block.from_base && base == nullptr)
+      return false;
+    file->blocks.push_back(block);
+  }
+  return true;
+}
+
+// Reads the manifest, |payload_offset| is set to the start of the payload.
+bool ReadManifest(base::File* delta,
+                  std::vector<DeltaFile>* files,
+                  int64_t* payload_offset) {
+  char size_buf[8];
+  if (delta->Read(0, size_buf, sizeof(size_buf)) != sizeof(size_buf))
+    return false;
+  uint32_t size;
+  if (!base::PickleIterator(base::Pickle(size_buf, sizeof(size_buf)))
+           .ReadUInt32(&size))
+    return false;
+  int64_t length = delta->GetLength();
+  if (size > kMaxManifestSize ||
+      length < static_cast<int64_t>(sizeof(size_buf)) + size)
+    return false;
+
+  std::vector<char> buf(size);
+  int read_size = base::checked_cast<int>(buf.size());
+  if (delta->Read(sizeof(size_buf), buf.data(), read_size) != read_size)
+    return false;
+  base::Pickle pickle(buf.data(), buf.size());
+  base::PickleIterator iter(pickle);
+  base::StringPiece json;
+  if (!iter.ReadStringPiece(&json))
+    return false;
+
+  std::unique_ptr<base::Value> manifest = base::JSONReader::Read(json);
+  const base::DictionaryValue* dict = nullptr;
+  const base::ListValue* list = nullptr;
+  if (!manifest || !manifest->GetAsDictionary(&dict) ||
+      !dict->GetList("files", &list))
+    return false;
+  for (const base::Value& value : list->GetList()) {
+    const base::DictionaryValue* file_dict = nullptr;
+    DeltaFile file;
+    if (!value.GetAsDictionary(&file_dict) || !ParseFile(*file_dict, &file))
+      return false;
+    files->push_back(std::move(file));
+  }
+
+  *payload_offset = sizeof(size_buf) + size;
+  return true;
+}
+
+// Copies |size| bytes at |offset| of |source| to the end of |output|.
+bool CopyRange(base::File* source,
+               int64_t offset,
+               int64_t size,
+               base::File* output,
+               crypto::SecureHash* hash,
+               std::vector<char>* buf) {
+  while (size > 0) {
+    int chunk = static_cast<int>(std::min<int64_t>(size, kCopyChunkSize));
+    if (source->Read(offset, buf->data(), chunk) != chunk ||
+        output->WriteAtCurrentPos(buf->data(), chunk) != chunk)
+      return false;
+    hash->Update(buf->data(), chunk);
+    offset += chunk;
+    size -= chunk;
+  }
+  return true;
+}
+
+// Creates the directories of |path| that do not exist, and appends them to
+// |created| parents first.
+bool CreateParentDirectories(const base::FilePath& path,
+                             std::vector<base::FilePath>* created) {
+  std::vector<base::FilePath> missing;
+  for (base::FilePath dir = path.DirName(); !base::DirectoryExists(dir);
+       dir = dir.DirName()) {
+    missing.push_back(dir);
+    if (dir == dir.DirName())
+      break;
+  }
+  if (!base::CreateDirectory(path.DirName()))
+    return false;
+  created->insert(created->end(), missing.rbegin(), missing.rend());
+  return true;
+}
+
+// Removes the files and directories in |created|, children first.
+void RemoveCreated(const std::vector<base::FilePath>& created) {
+  for (auto it = created.rbegin(); it != created.rend(); ++it)
+    base::DeleteFile(*it, false);
+}
+
+// Writes |file| to |output_path|, whatever it creates is appended to
+// |created|, so it can be removed when the update fails.
+bool WriteFile(const DeltaFile& file,
+               const base::FilePath& base_dir,
+               const base::FilePath& output_path,
+               base::File* delta,
+               int64_t payload_offset,
+               int64_t payload_size,
+               std::vector<base::FilePath>* created,
+               std::string* error) {
+  base::File base;
+  if (!file.base_path.empty()) {
+    base.Initialize(base_dir.Append(file.base_path),
+                    base::File::FLAG_OPEN | base::File::FLAG_READ);
+    if (!base.IsValid() || base.GetLength() != file.base_size) {
+      *error = "The installed file " + file.base_path.AsUTF8Unsafe() +
+               " does not match the delta";
+      return false;
+    }
+  }
+
+  if (!CreateParentDirectories(output_path, created)) {
+    *error = "Failed to create the directory of " + output_path.AsUTF8Unsafe();
+    return false;
+  }
+  base::File output(output_path,
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  if (!output.IsValid()) {
+    *error = "Failed to create " + output_path.AsUTF8Unsafe();
+    return false;
+  }
+  created->push_back(output_path);
+
+  std::unique_ptr<crypto::SecureHash> hash(
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256));
+  std::vector<char> buf(kCopyChunkSize);
+  int64_t written = 0;
+  for (const Block& block : file.blocks) {
+    int64_t limit = block.from_base ? file.base_size : payload_size;
+    if (block.offset > limit || block.size > limit - block.offset) {
+      *error = "A block of " + file.path.AsUTF8Unsafe() + " is out of range";
+      return false;
+    }
+    base::File* source = block.from_base ? &base : delta;
+    int64_t offset =
+        block.from_base ? block.offset : payload_offset + block.offset;
+    if (!CopyRange(source, offset, block.size, &output, hash.get(), &buf)) {
+      *error = "Failed to write " + output_path.AsUTF8Unsafe();
+      return false;
+    }
+    written += block.size;
+  }
+
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  if (written != file.size ||
+      base::ToLowerASCII(base::HexEncode(digest, sizeof(digest))) !=
+          file.sha256) {
+    *error = "The checksum of " + file.path.AsUTF8Unsafe() + " does not match";
+    return false;
+  }
+
+#if defined(OS_POSIX)
+  if (file.executable &&
+      !base::SetPosixFilePermissions(output_path, kExecutableMode)) {
+    *error = "Failed to make " + output_path.AsUTF8Unsafe() + " executable";
+    return false;
+  }
+#endif
+  return true;
+}
+
+}  // namespace
+
+bool ApplyDeltaUpdate(const base::FilePath& base_dir,
+                      const base::FilePath& delta_path,
+                      const base::FilePath& output_dir,
+                      std::string* error) {
+  base::File delta(delta_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!delta.IsValid()) {
+    *error = "Failed to open " + delta_path.AsUTF8Unsafe();
+    return false;
+  }
+
+  std::vector<DeltaFile> files;
+  int64_t payload_offset = 0;
+  if (!ReadManifest(&delta, &files, &payload_offset)) {
+    *error = "Invalid delta " + delta_path.AsUTF8Unsafe();
+    return false;
+  }
+  int64_t payload_size = delta.GetLength() - payload_offset;
+
+  std::vector<base::FilePath> created;
+  for (const DeltaFile& file : files) {
+    if (!WriteFile(file, base_dir, output_dir.Append(file.path), &delta,
+                   payload_offset, payload_size, &created, error)) {
+      RemoveCreated(created);
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace atom
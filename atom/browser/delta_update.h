@@ -0,0 +1,43 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_DELTA_UPDATE_H_
+#define ATOM_BROWSER_DELTA_UPDATE_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+
+namespace atom {
+
+// A delta update rebuilds the files of a new version out of the installed
+// files and the blocks that changed. It is framed like the header of an asar
+// archive: a pickled uint32 with the size of the pickled JSON manifest, then
+// the manifest, then the payload.
+//
+//   {"files": [{"path": "resources/app.asar", "size": 1200,
+//               "sha256": "<hex>", "executable": false,
+//               "base": {"path": "resources/app.asar", "size": 1000},
+//               "blocks": [{"source": "base", "offset": 0, "size": 800},
+//                          {"source": "delta", "offset": 0, "size": 400}]}]}
+//
+// The blocks of a file are written in order. "base" blocks are copied from
+// the installed file, "delta" blocks from the payload, with offsets relative
+// to its start. For an asar archive the blocks naturally follow the offsets
+// of the packed files. Paths are relative to the installation and the output
+// directories.
+//
+// Writes the files of the delta at |delta_path| into |output_dir|, reading
+// the installed files from |base_dir|. Every written file is checked against
+// its size and SHA-256 digest. On failure |error| is set and the files that
+// were written are removed, along with the directories created for them.
+// This blocks.
+bool ApplyDeltaUpdate(const base::FilePath& base_dir,
+                      const base::FilePath& delta_path,
+                      const base::FilePath& output_dir,
+                      std::string* error);
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_DELTA_UPDATE_H_
@@ -0,0 +1,110 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/file_icon_loader.h"
+
+#include "atom/browser/atom_browser_main_parts.h"
+#include "base/bind.h"
+#include "base/strings/string_util.h"
+#include "chrome/browser/icon_manager.h"
+
+namespace atom {
+
+namespace {
+
+// Each load blocks a thread of the pool while the OS resolves the icon.
+const int kMaxConcurrentLoads = 4;
+
+const size_t kMaxCachedIcons = 256;
+
+}  // namespace
+
+FileIconLoader::Request::Request() = default;
+
+FileIconLoader::Request::Request(const Request& other) = default;
+
+FileIconLoader::Request::~Request() = default;
+
+FileIconLoader::FileIconLoader() : cache_(kMaxCachedIcons) {}
+
+FileIconLoader::~FileIconLoader() = default;
+
+void FileIconLoader::LoadIcon(const base::FilePath& path,
+                              IconLoader::IconSize size,
+                              const IconCallback& callback) {
+  Key key(GetIconGroup(path), size);
+  auto cached = cache_.Get(key);
+  if (cached != cache_.end()) {
+    callback.Run(cached->second);
+    return;
+  }
+
+  // Files of the same group wait for the icon that is already requested.
+  auto it = requests_.find(key);
+  if (it == requests_.end()) {
+    it = requests_.emplace(key, Request()).first;
+    it->second.path = path;
+    waiting_.push_back(key);
+  }
+  it->second.callbacks.push_back(callback);
+  StartLoads();
+}
+
+// static
+base::FilePath::StringType FileIconLoader::GetIconGroup(
+    const base::FilePath& path) {
+  base::FilePath::StringType extension = base::ToLowerASCII(path.Extension());
+  if (extension.empty())
+    return path.value();
+#if defined(OS_WIN)
+  // Executables and icons carry their own icon.
+  if (extension == FILE_PATH_LITERAL(".exe") ||
+      extension == FILE_PATH_LITERAL(".dll") ||
+      extension == FILE_PATH_LITERAL(".ico"))
+    return path.value();
+#endif
+  return extension;
+}
+
+void FileIconLoader::StartLoads() {
+  auto* icon_manager = AtomBrowserMainParts::Get()->GetIconManager();
+  while (active_loads_ < kMaxConcurrentLoads && !waiting_.empty()) {
+    Key key = waiting_.front();
+    waiting_.pop_front();
+    ++active_loads_;
+
+    const base::FilePath& path = requests_[key].path;
+    gfx::Image* icon = icon_manager->LookupIconFromFilepath(path, key.second);
+    if (icon) {
+      OnIconLoaded(key, icon);
+      continue;
+    }
+    icon_manager->LoadIcon(path, key.second,
+                           base::Bind(&FileIconLoader::OnIconLoaded,
+                                      base::Unretained(this), key),
+                           &task_tracker_);
+  }
+}
+
+void FileIconLoader::OnIconLoaded(const Key& key, gfx::Image* icon) {
+  --active_loads_;
+
+  auto it = requests_.find(key);
+  if (it == requests_.end())
+    return;
+  std::vector<IconCallback> callbacks = std::move(it->second.callbacks);
+  requests_.erase(it);
+
+  gfx::Image image;
+  if (icon && !icon->IsEmpty()) {
+    image = *icon;
+    cache_.Put(key, image);
+  }
+  for (const auto& callback : callbacks)
+    callback.Run(image);
+
+  StartLoads();
+}
+
+}  // namespace atom
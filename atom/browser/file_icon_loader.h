@@ -0,0 +1,72 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_FILE_ICON_LOADER_H_
+#define ATOM_BROWSER_FILE_ICON_LOADER_H_
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/circular_deque.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/task/cancelable_task_tracker.h"
+#include "chrome/browser/icon_loader.h"
+#include "ui/gfx/image/image.h"
+
+namespace atom {
+
+// Loads the icons of files through the IconManager. Files that share their
+// icon, like the documents with the same extension, are loaded once and then
+// answered from a cache. At most a few icons are loaded at the same time, so
+// a large batch of files does not occupy the blocking thread pool.
+class FileIconLoader {
+ public:
+  // |icon| is empty when the icon could not be loaded.
+  using IconCallback = base::Callback<void(const gfx::Image& icon)>;
+
+  FileIconLoader();
+  ~FileIconLoader();
+
+  // |callback| is called right away when the icon is cached.
+  void LoadIcon(const base::FilePath& path,
+                IconLoader::IconSize size,
+                const IconCallback& callback);
+
+ private:
+  using Key = std::pair<base::FilePath::StringType, IconLoader::IconSize>;
+
+  struct Request {
+    Request();
+    Request(const Request& other);
+    ~Request();
+
+    base::FilePath path;
+    std::vector<IconCallback> callbacks;
+  };
+
+  // Returns the extension of |path| when the icon of the file only depends
+  // on it, otherwise the path itself.
+  static base::FilePath::StringType GetIconGroup(const base::FilePath& path);
+
+  void StartLoads();
+  void OnIconLoaded(const Key& key, gfx::Image* icon);
+
+  base::MRUCache<Key, gfx::Image> cache_;
+  std::map<Key, Request> requests_;
+  base::circular_deque<Key> waiting_;
+  int active_loads_ = 0;
+
+  // Declared last, so pending loads are canceled before the members above
+  // are destroyed.
+  base::CancelableTaskTracker task_tracker_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileIconLoader);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_FILE_ICON_LOADER_H_
@@ -0,0 +1,126 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/idle_task_scheduler.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/threading/thread_task_runner_handle.h"
+
+namespace atom {
+
+namespace {
+
+// A probe that waits longer than this found other work in the queue.
+const int kMaxIdleQueueDelayMs = 2;
+
+// Matches the longest idle period of requestIdleCallback in renderers, so
+// input that arrives meanwhile waits at most this long.
+const int kMaxIdlePeriodMs = 50;
+
+// How often the thread is probed while tasks are waiting.
+const int kProbeIntervalMs = 16;
+
+}  // namespace
+
+IdleTaskScheduler::PendingIdleTask::PendingIdleTask() = default;
+
+IdleTaskScheduler::PendingIdleTask::PendingIdleTask(PendingIdleTask&& other) =
+    default;
+
+IdleTaskScheduler::PendingIdleTask::~PendingIdleTask() = default;
+
+IdleTaskScheduler::IdleTaskScheduler() : weak_factory_(this) {}
+
+IdleTaskScheduler::~IdleTaskScheduler() = default;
+
+void IdleTaskScheduler::Start() {
+  started_ = true;
+  if (!tasks_.empty())
+    PostProbe(base::TimeDelta());
+}
+
+int IdleTaskScheduler::PostIdleTask(IdleTask task, base::TimeDelta timeout) {
+  int id = next_id_++;
+  PendingIdleTask& pending = tasks_[id];
+  pending.task = std::move(task);
+  if (!timeout.is_zero())
+    pending.expiry = base::TimeTicks::Now() + timeout;
+  PostProbe(base::TimeDelta());
+  return id;
+}
+
+void IdleTaskScheduler::CancelIdleTask(int id) {
+  tasks_.erase(id);
+}
+
+void IdleTaskScheduler::PostProbe(base::TimeDelta delay) {
+  if (!started_ || probe_pending_)
+    return;
+  probe_pending_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostNonNestableDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&IdleTaskScheduler::SendProbe,
+                     weak_factory_.GetWeakPtr()),
+      delay);
+}
+
+void IdleTaskScheduler::SendProbe() {
+  // The lateness of a delayed task mostly measures the timer slack, the
+  // queueing delay of an immediate task measures the work ahead of it.
+  base::ThreadTaskRunnerHandle::Get()->PostNonNestableTask(
+      FROM_HERE,
+      base::BindOnce(&IdleTaskScheduler::OnProbe, weak_factory_.GetWeakPtr(),
+                     base::TimeTicks::Now()));
+}
+
+void IdleTaskScheduler::OnProbe(base::TimeTicks post_time) {
+  probe_pending_ = false;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (now - post_time <=
+      base::TimeDelta::FromMilliseconds(kMaxIdleQueueDelayMs)) {
+    RunIdleTasks(now + base::TimeDelta::FromMilliseconds(kMaxIdlePeriodMs));
+  } else {
+    RunExpiredTasks(now);
+  }
+
+  if (!tasks_.empty())
+    PostProbe(base::TimeDelta::FromMilliseconds(kProbeIntervalMs));
+}
+
+void IdleTaskScheduler::RunIdleTasks(base::TimeTicks deadline) {
+  // Tasks posted by the idle tasks wait for the next idle period.
+  int last_id = next_id_ - 1;
+  auto it = tasks_.begin();
+  while (it != tasks_.end() && it->first <= last_id &&
+         base::TimeTicks::Now() < deadline) {
+    int id = it->first;
+    IdleTask task = std::move(it->second.task);
+    tasks_.erase(it);
+    std::move(task).Run(deadline, false);
+    // The task may have cancelled others.
+    it = tasks_.upper_bound(id);
+  }
+}
+
+void IdleTaskScheduler::RunExpiredTasks(base::TimeTicks now) {
+  std::vector<int> expired;
+  for (const auto& pair : tasks_) {
+    if (!pair.second.expiry.is_null() && pair.second.expiry <= now)
+      expired.push_back(pair.first);
+  }
+  for (int id : expired) {
+    auto it = tasks_.find(id);
+    if (it == tasks_.end())
+      continue;
+    IdleTask task = std::move(it->second.task);
+    tasks_.erase(it);
+    std::move(task).Run(now, true);
+  }
+}
+
+}  // namespace atom
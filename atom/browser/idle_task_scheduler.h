@@ -0,0 +1,78 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_IDLE_TASK_SCHEDULER_H_
+#define ATOM_BROWSER_IDLE_TASK_SCHEDULER_H_
+
+#include <map>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+
+namespace atom {
+
+// Runs tasks on the browser main thread when it has nothing else to do.
+//
+// The message loop of the browser process has no idle notifications, so the
+// scheduler periodically posts an immediate probe task and treats the thread
+// as idle when the probe runs without waiting behind other work. Probes are
+// non-nestable, so idle tasks never run inside menus, window moves or modal
+// dialogs.
+class IdleTaskScheduler {
+ public:
+  // Receives the time by which the task should return, and whether it runs
+  // because its timeout expired rather than in an idle period.
+  using IdleTask =
+      base::OnceCallback<void(base::TimeTicks deadline, bool did_timeout)>;
+
+  IdleTaskScheduler();
+  ~IdleTaskScheduler();
+
+  // Starts probing once the main message loop runs, tasks posted before that
+  // wait.
+  void Start();
+
+  // Returns an id for CancelIdleTask. A zero |timeout| waits for an idle
+  // period however long it takes.
+  int PostIdleTask(IdleTask task, base::TimeDelta timeout);
+  void CancelIdleTask(int id);
+
+ private:
+  struct PendingIdleTask {
+    PendingIdleTask();
+    PendingIdleTask(PendingIdleTask&& other);
+    ~PendingIdleTask();
+
+    IdleTask task;
+    // Null when the task has no timeout.
+    base::TimeTicks expiry;
+  };
+
+  // Calls SendProbe after |delay|, which posts the probe itself.
+  void PostProbe(base::TimeDelta delay);
+  void SendProbe();
+  void OnProbe(base::TimeTicks post_time);
+
+  // Runs the tasks posted before the idle period, in posting order, until
+  // |deadline|.
+  void RunIdleTasks(base::TimeTicks deadline);
+  void RunExpiredTasks(base::TimeTicks now);
+
+  // Keyed by id, which also keeps the posting order.
+  std::map<int, PendingIdleTask> tasks_;
+  int next_id_ = 1;
+
+  bool started_ = false;
+  bool probe_pending_ = false;
+
+  base::WeakPtrFactory<IdleTaskScheduler> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleTaskScheduler);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_IDLE_TASK_SCHEDULER_H_
@@ -4,11 +4,16 @@
 
 #include "atom/browser/javascript_environment.h"
 
+#include <algorithm>
 #include <string>
 
 #include "atom/browser/microtasks_runner.h"
+#include "atom/browser/task_duration_monitor.h"
+#include "atom/common/options_switches.h"
 #include "base/command_line.h"
 #include "base/message_loop/message_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/sys_info.h"
 #include "base/task_scheduler/initialization_util.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/public/common/content_switches.h"
@@ -39,7 +44,7 @@ v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop) {
   auto* cmd = base::CommandLine::ForCurrentProcess();
 
   // --js-flags.
-  std::string js_flags = cmd->GetSwitchValueASCII(switches::kJavaScriptFlags);
+  std::string js_flags = cmd->GetSwitchValueASCII(::switches::kJavaScriptFlags);
   if (!js_flags.empty())
     v8::V8::SetFlagsFromString(js_flags.c_str(), js_flags.size());
 
@@ -47,9 +52,7 @@ v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop) {
   // been started at this point, so we have to rely on Node's V8Platform.
   auto* tracing_controller = new v8::TracingController();
   node::tracing::TraceEventHelper::SetTracingController(tracing_controller);
-  platform_ = node::CreatePlatform(
-      base::RecommendedMaxNumberOfThreadsInPool(3, 8, 0.1, 0),
-      tracing_controller);
+  platform_ = node::CreatePlatform(GetWorkerThreadCount(), tracing_controller);
 
   v8::V8::InitializePlatform(platform_);
   gin::IsolateHolder::Initialize(
@@ -63,18 +66,55 @@ v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop) {
   return isolate;
 }
 
+// static
+int JavascriptEnvironment::GetWorkerThreadCount() {
+  // --js-worker-threads.
+  auto* cmd = base::CommandLine::ForCurrentProcess();
+  int count;
+  if (base::StringToInt(cmd->GetSwitchValueASCII(switches::kJsWorkerThreads),
+                        &count) &&
+      count > 0) {
+    // More threads than cores only compete with the ones of Chromium.
+    return std::min(count, base::SysInfo::NumberOfProcessors());
+  }
+  return base::RecommendedMaxNumberOfThreadsInPool(3, 8, 0.1, 0);
+}
+
 void JavascriptEnvironment::OnMessageLoopCreated() {
   DCHECK(!microtasks_runner_);
   microtasks_runner_.reset(new MicrotasksRunner(isolate()));
   base::MessageLoopCurrent::Get()->AddTaskObserver(microtasks_runner_.get());
+  // Observers are notified in order, so the durations include the microtask
+  // checkpoints.
+  task_duration_monitor_.reset(new TaskDurationMonitor);
+  base::MessageLoopCurrent::Get()->AddTaskObserver(
+      task_duration_monitor_.get());
 }
 
 void JavascriptEnvironment::OnMessageLoopDestroying() {
   DCHECK(microtasks_runner_);
+  base::MessageLoopCurrent::Get()->RemoveTaskObserver(
+      task_duration_monitor_.get());
+  task_duration_monitor_.reset();
   base::MessageLoopCurrent::Get()->RemoveTaskObserver(microtasks_runner_.get());
   platform_->UnregisterIsolate(isolate_);
 }
 
+void JavascriptEnvironment::SetMaxOldGenerationSize(size_t size) {
+  if (max_old_generation_size_ == 0)
+    isolate_->AddNearHeapLimitCallback(&OnNearHeapLimit, this);
+  max_old_generation_size_ = size;
+}
+
+// static
+size_t JavascriptEnvironment::OnNearHeapLimit(void* data,
+                                              size_t current_heap_limit,
+                                              size_t initial_heap_limit) {
+  auto* self = static_cast<JavascriptEnvironment*>(data);
+  // Returning the current limit lets V8 fail as it would without us.
+  return std::max(current_heap_limit, self->max_old_generation_size_);
+}
+
 NodeEnvironment::NodeEnvironment(node::Environment* env) : env_(env) {}
 
 NodeEnvironment::~NodeEnvironment() {
@@ -19,6 +19,7 @@ class MultiIsolatePlatform;
 namespace atom {
 
 class MicrotasksRunner;
+class TaskDurationMonitor;
 // Manage the V8 isolate and context automatically.
 class JavascriptEnvironment {
  public:
@@ -28,6 +29,12 @@ class JavascriptEnvironment {
   void OnMessageLoopCreated();
   void OnMessageLoopDestroying();
 
+  // The heap is configured when the isolate is created, before any script
+  // runs, so the limit of the old generation can only be raised afterwards.
+  // Once the heap gets near its limit, the limit is raised to |size| bytes.
+  void SetMaxOldGenerationSize(size_t size);
+  size_t max_old_generation_size() const { return max_old_generation_size_; }
+
   node::MultiIsolatePlatform* platform() const { return platform_; }
   v8::Isolate* isolate() const { return isolate_; }
   v8::Local<v8::Context> context() const {
@@ -36,6 +43,12 @@ class JavascriptEnvironment {
 
  private:
   v8::Isolate* Initialize(uv_loop_t* event_loop);
+  // The size of the thread pool of Node's V8Platform.
+  static int GetWorkerThreadCount();
+  static size_t OnNearHeapLimit(void* data,
+                                size_t current_heap_limit,
+                                size_t initial_heap_limit);
+
   // Leaked on exit.
   node::MultiIsolatePlatform* platform_;
 
@@ -48,6 +61,10 @@ class JavascriptEnvironment {
   v8::Context::Scope context_scope_;
 
   std::unique_ptr<MicrotasksRunner> microtasks_runner_;
+  std::unique_ptr<TaskDurationMonitor> task_duration_monitor_;
+
+  // 0 while V8 decides the limit.
+  size_t max_old_generation_size_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(JavascriptEnvironment);
 };
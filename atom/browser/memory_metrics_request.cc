@@ -0,0 +1,149 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/memory_metrics_request.h"
+
+#include <utility>
+
+#include "atom/common/api/api_messages.h"
+#include "base/bind.h"
+#include "base/lazy_instance.h"
+#include "content/public/browser/browser_message_filter.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/gpu_data_manager.h"
+#include "content/public/browser/render_process_host.h"
+#include "gpu/ipc/common/memory_stats.h"
+
+namespace atom {
+
+namespace {
+
+// Long enough for a busy renderer, short enough to be sampled every second.
+const int kTimeoutMs = 800;
+
+int g_next_request_id = 0;
+
+base::LazyInstance<std::map<int, MemoryMetricsRequest*>>::Leaky g_requests =
+    LAZY_INSTANCE_INITIALIZER;
+
+class MemoryStatsMessageFilter : public content::BrowserMessageFilter {
+ public:
+  explicit MemoryStatsMessageFilter(int process_id)
+      : content::BrowserMessageFilter(ShellMsgStart),
+        process_id_(process_id) {}
+
+  // content::BrowserMessageFilter:
+  void OverrideThreadForMessage(const IPC::Message& message,
+                                content::BrowserThread::ID* thread) override {
+    if (message.type() == AtomHostMsg_MemoryStats::ID)
+      *thread = content::BrowserThread::UI;
+  }
+
+  bool OnMessageReceived(const IPC::Message& message) override {
+    bool handled = true;
+    IPC_BEGIN_MESSAGE_MAP(MemoryStatsMessageFilter, message)
+      IPC_MESSAGE_HANDLER(AtomHostMsg_MemoryStats, OnMemoryStats)
+      IPC_MESSAGE_UNHANDLED(handled = false)
+    IPC_END_MESSAGE_MAP()
+    return handled;
+  }
+
+ private:
+  ~MemoryStatsMessageFilter() override {}
+
+  void OnMemoryStats(int request_id, const base::DictionaryValue& stats) {
+    MemoryMetricsRequest::OnRendererStats(process_id_, request_id, stats);
+  }
+
+  const int process_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryStatsMessageFilter);
+};
+
+}  // namespace
+
+MemoryMetricsRequest::Result::Result() = default;
+
+MemoryMetricsRequest::Result::~Result() = default;
+
+MemoryMetricsRequest::MemoryMetricsRequest(Callback callback)
+    : id_(++g_next_request_id),
+      callback_(std::move(callback)),
+      weak_factory_(this) {}
+
+MemoryMetricsRequest::~MemoryMetricsRequest() = default;
+
+// static
+void MemoryMetricsRequest::Start(Callback callback) {
+  auto* request = new MemoryMetricsRequest(std::move(callback));
+  g_requests.Get()[request->id_] = request;
+  request->Run();
+}
+
+// static
+scoped_refptr<content::BrowserMessageFilter>
+MemoryMetricsRequest::CreateMessageFilter(int process_id) {
+  return new MemoryStatsMessageFilter(process_id);
+}
+
+// static
+void MemoryMetricsRequest::OnRendererStats(int process_id,
+                                           int request_id,
+                                           const base::DictionaryValue& stats) {
+  auto it = g_requests.Get().find(request_id);
+  if (it == g_requests.Get().end())
+    return;
+
+  MemoryMetricsRequest* request = it->second;
+  if (!request->pending_renderers_.erase(process_id))
+    return;
+
+  auto* host = content::RenderProcessHost::FromID(process_id);
+  if (host && host->GetProcess().IsValid())
+    request->result_.renderers[host->GetProcess().Pid()] = stats.Clone();
+  request->MaybeFinish();
+}
+
+void MemoryMetricsRequest::Run() {
+  running_ = true;
+  timeout_.Start(FROM_HERE, base::TimeDelta::FromMilliseconds(kTimeoutMs),
+                 base::Bind(&MemoryMetricsRequest::Finish,
+                            base::Unretained(this)));
+
+  for (auto it = content::RenderProcessHost::AllHostsIterator(); !it.IsAtEnd();
+       it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (host->IsReady() && host->Send(new AtomMsg_RequestMemoryStats(id_)))
+      pending_renderers_.insert(host->GetID());
+  }
+
+  waiting_for_gpu_ = true;
+  content::GpuDataManager::GetInstance()->RequestVideoMemoryUsageStatsUpdate(
+      base::Bind(&MemoryMetricsRequest::OnVideoMemoryUsageStats,
+                 weak_factory_.GetWeakPtr()));
+
+  running_ = false;
+  MaybeFinish();
+}
+
+void MemoryMetricsRequest::OnVideoMemoryUsageStats(
+    const gpu::VideoMemoryUsageStats& stats) {
+  for (const auto& it : stats.process_map)
+    result_.video_memory[it.first] = it.second.video_memory / 1024;
+  waiting_for_gpu_ = false;
+  MaybeFinish();
+}
+
+void MemoryMetricsRequest::MaybeFinish() {
+  if (!running_ && !waiting_for_gpu_ && pending_renderers_.empty())
+    Finish();
+}
+
+void MemoryMetricsRequest::Finish() {
+  g_requests.Get().erase(id_);
+  std::move(callback_).Run(result_);
+  delete this;
+}
+
+}  // namespace atom
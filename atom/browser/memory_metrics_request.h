@@ -0,0 +1,84 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_MEMORY_METRICS_REQUEST_H_
+#define ATOM_BROWSER_MEMORY_METRICS_REQUEST_H_
+
+#include <map>
+#include <set>
+
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/process/process_handle.h"
+#include "base/timer/timer.h"
+#include "base/values.h"
+
+namespace content {
+class BrowserMessageFilter;
+}
+
+namespace gpu {
+struct VideoMemoryUsageStats;
+}
+
+namespace atom {
+
+// Asks the renderers for the memory of their V8 heap and of Blink's memory
+// cache, and the GPU process for the video memory of each process. Processes
+// that do not answer in time are left out.
+class MemoryMetricsRequest {
+ public:
+  struct Result {
+    Result();
+    ~Result();
+
+    // Process ID => the stats sent by the renderer.
+    std::map<base::ProcessId, base::Value> renderers;
+    // Process ID => the video memory of the process, in kilobytes.
+    std::map<base::ProcessId, uint64_t> video_memory;
+  };
+
+  using Callback = base::OnceCallback<void(const Result& result)>;
+
+  // Calls |callback| once all processes have answered.
+  static void Start(Callback callback);
+
+  // The filter that receives the answers of the renderer |process_id|.
+  static scoped_refptr<content::BrowserMessageFilter> CreateMessageFilter(
+      int process_id);
+
+  // Called by the filter with the answer of a renderer.
+  static void OnRendererStats(int process_id,
+                              int request_id,
+                              const base::DictionaryValue& stats);
+
+ private:
+  explicit MemoryMetricsRequest(Callback callback);
+  ~MemoryMetricsRequest();
+
+  void Run();
+  void OnVideoMemoryUsageStats(const gpu::VideoMemoryUsageStats& stats);
+  void MaybeFinish();
+  void Finish();
+
+  const int id_;
+  Callback callback_;
+  Result result_;
+
+  // The renderers that have not answered yet.
+  std::set<int> pending_renderers_;
+  bool waiting_for_gpu_ = false;
+  // Whether requests are still being sent, answers may come synchronously.
+  bool running_ = false;
+  base::OneShotTimer timeout_;
+
+  base::WeakPtrFactory<MemoryMetricsRequest> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryMetricsRequest);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_MEMORY_METRICS_REQUEST_H_
@@ -0,0 +1,68 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/memory_pressure_hub.h"
+
+#include "atom/common/api/native_image_cache.h"
+#include "atom/common/asar/asar_util.h"
+#include "base/bind.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace atom {
+
+// static
+MemoryPressureHub* MemoryPressureHub::Get() {
+  static base::NoDestructor<MemoryPressureHub> hub;
+  return hub.get();
+}
+
+MemoryPressureHub::MemoryPressureHub() {}
+
+MemoryPressureHub::~MemoryPressureHub() {}
+
+std::unique_ptr<MemoryPressureHub::Subscription>
+MemoryPressureHub::RegisterTrimCallback(const TrimCallback& callback) {
+  return callbacks_.Add(callback);
+}
+
+void MemoryPressureHub::Start(v8::Isolate* isolate) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  isolate_ = isolate;
+  listener_ = std::make_unique<base::MemoryPressureListener>(
+      base::BindRepeating(&MemoryPressureHub::OnMemoryPressure,
+                          base::Unretained(this)));
+}
+
+void MemoryPressureHub::Stop() {
+  listener_.reset();
+  isolate_ = nullptr;
+}
+
+// static
+void MemoryPressureHub::Simulate(Level level) {
+  base::MemoryPressureListener::NotifyMemoryPressure(level);
+}
+
+void MemoryPressureHub::OnMemoryPressure(Level level) {
+  if (level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    return;
+  bool critical =
+      level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
+
+  callbacks_.Notify(level);
+
+  // Images and archive headers are read again on demand, which is only worth
+  // it when memory is about to run out.
+  if (critical) {
+    api::NativeImageCache::GetInstance()->Clear();
+    asar::ClearArchives();
+  }
+
+  if (isolate_)
+    isolate_->MemoryPressureNotification(
+        critical ? v8::MemoryPressureLevel::kCritical
+                 : v8::MemoryPressureLevel::kModerate);
+}
+
+}  // namespace atom
@@ -0,0 +1,61 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_MEMORY_PRESSURE_HUB_H_
+#define ATOM_BROWSER_MEMORY_PRESSURE_HUB_H_
+
+#include <memory>
+
+#include "base/callback_list.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/no_destructor.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+// Fans the memory pressure signals of the browser process out to the caches
+// owned by Electron, which Chromium's own listeners know nothing about.
+// Caches register a callback that trims them, the caches shared with the
+// renderer processes and the main process heap are trimmed by the hub.
+class MemoryPressureHub {
+ public:
+  using Level = base::MemoryPressureListener::MemoryPressureLevel;
+  using TrimCallback = base::RepeatingCallback<void(Level)>;
+  using Subscription = base::CallbackList<void(Level)>::Subscription;
+
+  // Never destroyed, so subscriptions can outlive the message loop.
+  static MemoryPressureHub* Get();
+
+  // The callback runs on the UI thread until the returned subscription is
+  // destroyed.
+  std::unique_ptr<Subscription> RegisterTrimCallback(
+      const TrimCallback& callback);
+
+  // Starts listening once the main message loop exists.
+  void Start(v8::Isolate* isolate);
+  void Stop();
+
+  // Sends |level| to every memory pressure listener of the process, as the
+  // system would.
+  static void Simulate(Level level);
+
+ private:
+  friend class base::NoDestructor<MemoryPressureHub>;
+
+  MemoryPressureHub();
+  ~MemoryPressureHub();
+
+  void OnMemoryPressure(Level level);
+
+  std::unique_ptr<base::MemoryPressureListener> listener_;
+  base::CallbackList<void(Level)> callbacks_;
+  v8::Isolate* isolate_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryPressureHub);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_MEMORY_PRESSURE_HUB_H_
@@ -1,18 +1,82 @@
-
 // Copyright (c) 2018 GitHub, Inc.
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
 #include "atom/browser/microtasks_runner.h"
+
+#include "atom/common/options_switches.h"
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "v8/include/v8.h"
 
 namespace atom {
 
-MicrotasksRunner::MicrotasksRunner(v8::Isolate* isolate) : isolate_(isolate) {}
+namespace {
+
+// The runner of the browser process, there is only one isolate that uses the
+// kExplicit policy.
+MicrotasksRunner* g_microtasks_runner = nullptr;
+
+}  // namespace
+
+MicrotasksRunner::MicrotasksRunner(v8::Isolate* isolate)
+    : isolate_(isolate),
+      batch_checkpoints_(base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kBatchMicrotaskCheckpoints)),
+      weak_factory_(this) {
+  DCHECK(!g_microtasks_runner);
+  g_microtasks_runner = this;
+  isolate_->AddCallCompletedCallback(&MicrotasksRunner::OnCallCompleted);
+}
+
+MicrotasksRunner::~MicrotasksRunner() {
+  isolate_->RemoveCallCompletedCallback(&MicrotasksRunner::OnCallCompleted);
+  g_microtasks_runner = nullptr;
+}
+
+// static
+void MicrotasksRunner::NotifyMicrotasksQueued(v8::Isolate* isolate) {
+  if (g_microtasks_runner && g_microtasks_runner->isolate_ == isolate)
+    g_microtasks_runner->microtasks_queued_ = true;
+}
+
+// static
+MicrotasksRunner::Stats MicrotasksRunner::GetStats() {
+  return g_microtasks_runner ? g_microtasks_runner->stats_ : Stats();
+}
+
+// static
+void MicrotasksRunner::OnCallCompleted(v8::Isolate* isolate) {
+  NotifyMicrotasksQueued(isolate);
+}
 
 void MicrotasksRunner::WillProcessTask(const base::PendingTask& pending_task) {}
 
 void MicrotasksRunner::DidProcessTask(const base::PendingTask& pending_task) {
+  if (!microtasks_queued_) {
+    ++stats_.skipped;
+    return;
+  }
+
+  if (!batch_checkpoints_) {
+    PerformCheckpoint();
+    return;
+  }
+
+  if (checkpoint_posted_)
+    return;
+  checkpoint_posted_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&MicrotasksRunner::PerformCheckpoint,
+                                weak_factory_.GetWeakPtr()));
+}
+
+void MicrotasksRunner::PerformCheckpoint() {
+  checkpoint_posted_ = false;
+  // Cleared first, the microtasks may queue more while they run.
+  microtasks_queued_ = false;
+  ++stats_.checkpoints;
   v8::Isolate::Scope scope(isolate_);
   v8::MicrotasksScope::PerformCheckpoint(isolate_);
 }
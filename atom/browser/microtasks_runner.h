@@ -5,6 +5,9 @@
 #ifndef ATOM_BROWSER_MICROTASKS_RUNNER_H_
 #define ATOM_BROWSER_MICROTASKS_RUNNER_H_
 
+#include <stdint.h>
+
+#include "base/memory/weak_ptr.h"
 #include "base/message_loop/message_loop.h"
 
 namespace v8 {
@@ -19,16 +22,52 @@ namespace atom {
 // Node follows the kExplicit MicrotasksPolicy, and we do the same in browser
 // process. Hence, we need to have this task observer to flush the queued
 // microtasks.
+//
+// Microtasks can only be queued by running scripts, or by the native code
+// settling promises, so the checkpoint is skipped after the tasks that did
+// neither.
 class MicrotasksRunner : public base::MessageLoop::TaskObserver {
  public:
+  struct Stats {
+    uint64_t checkpoints = 0;
+    uint64_t skipped = 0;
+  };
+
   explicit MicrotasksRunner(v8::Isolate* isolate);
+  ~MicrotasksRunner() override;
+
+  // Called by the native code that settles a promise outside of a script, so
+  // its reactions are run at the end of the task.
+  static void NotifyMicrotasksQueued(v8::Isolate* isolate);
+
+  // Returns the stats of the runner of the browser process, or empty ones
+  // before the message loop runs.
+  static Stats GetStats();
 
   // base::MessageLoop::TaskObserver
   void WillProcessTask(const base::PendingTask& pending_task) override;
   void DidProcessTask(const base::PendingTask& pending_task) override;
 
  private:
+  static void OnCallCompleted(v8::Isolate* isolate);
+
+  void PerformCheckpoint();
+
   v8::Isolate* isolate_;
+
+  // Whether a script ran or a promise was settled since the last checkpoint.
+  bool microtasks_queued_ = true;
+
+  // With --batch-microtask-checkpoints the checkpoint runs in a task posted
+  // behind the tasks that were already queued, instead of after each task.
+  bool batch_checkpoints_;
+  bool checkpoint_posted_ = false;
+
+  Stats stats_;
+
+  base::WeakPtrFactory<MicrotasksRunner> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(MicrotasksRunner);
 };
 
 }  // namespace atom
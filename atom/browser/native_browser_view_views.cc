@@ -5,7 +5,8 @@
 #include "atom/browser/native_browser_view_views.h"
 
 #include "atom/browser/ui/inspectable_web_contents_view.h"
-#include "ui/gfx/geometry/rect.h"
+#include "base/bind.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "ui/views/background.h"
 #include "ui/views/view.h"
 
@@ -13,7 +14,7 @@ namespace atom {
 
 NativeBrowserViewViews::NativeBrowserViewViews(
     InspectableWebContents* inspectable_web_contents)
-    : NativeBrowserView(inspectable_web_contents) {}
+    : NativeBrowserView(inspectable_web_contents), weak_factory_(this) {}
 
 NativeBrowserViewViews::~NativeBrowserViewViews() {}
 
@@ -22,8 +23,26 @@ void NativeBrowserViewViews::SetAutoResizeFlags(uint8_t flags) {
 }
 
 void NativeBrowserViewViews::SetBounds(const gfx::Rect& bounds) {
+  if (!pending_bounds_) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&NativeBrowserViewViews::ApplyPendingBounds,
+                                  weak_factory_.GetWeakPtr()));
+  }
+  pending_bounds_ = bounds;
+}
+
+gfx::Rect NativeBrowserViewViews::GetBounds() {
+  if (pending_bounds_)
+    return *pending_bounds_;
+  return GetInspectableWebContentsView()->GetView()->bounds();
+}
+
+void NativeBrowserViewViews::ApplyPendingBounds() {
+  if (!pending_bounds_)
+    return;
   auto* view = GetInspectableWebContentsView()->GetView();
-  view->SetBoundsRect(bounds);
+  view->SetBoundsRect(*pending_bounds_);
+  pending_bounds_.reset();
 }
 
 void NativeBrowserViewViews::SetBackgroundColor(SkColor color) {
@@ -6,6 +6,9 @@
 #define ATOM_BROWSER_NATIVE_BROWSER_VIEW_VIEWS_H_
 
 #include "atom/browser/native_browser_view.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "ui/gfx/geometry/rect.h"
 
 namespace atom {
 
@@ -18,10 +21,20 @@ class NativeBrowserViewViews : public NativeBrowserView {
   uint8_t GetAutoResizeFlags() { return auto_resize_flags_; }
   void SetAutoResizeFlags(uint8_t flags) override;
   void SetBounds(const gfx::Rect& bounds) override;
+  gfx::Rect GetBounds() override;
   void SetBackgroundColor(SkColor color) override;
 
+  // Lays the view out with the bounds set in the current task, if any.
+  void ApplyPendingBounds();
+
  private:
-  uint8_t auto_resize_flags_;
+  uint8_t auto_resize_flags_ = 0;
+
+  // Apps moving panes call setBounds many times per task, only the last
+  // bounds are laid out and sent to the renderer.
+  base::Optional<gfx::Rect> pending_bounds_;
+
+  base::WeakPtrFactory<NativeBrowserViewViews> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(NativeBrowserViewViews);
 };
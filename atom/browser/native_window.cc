@@ -13,6 +13,7 @@
 #include "atom/browser/window_list.h"
 #include "atom/common/color_util.h"
 #include "atom/common/options_switches.h"
+#include "base/bind.h"
 #include "native_mate/dictionary.h"
 #include "ui/views/widget/widget.h"
 
@@ -25,6 +26,9 @@ namespace atom {
 
 namespace {
 
+// One frame at 60Hz.
+const int kBoundsEventsIntervalMs = 16;
+
 #if defined(OS_WIN)
 gfx::Size GetExpandedWindowSize(const NativeWindow* window, gfx::Size size) {
   if (!window->transparent() || !ui::win::IsAeroGlassEnabled())
@@ -49,6 +53,8 @@ NativeWindow::NativeWindow(const mate::Dictionary& options,
   options.Get(options::kFrame, &has_frame_);
   options.Get(options::kTransparent, &transparent_);
   options.Get(options::kEnableLargerThanScreen, &enable_larger_than_screen_);
+  options.Get(options::kCoalesceBoundsEvents, &coalesce_bounds_events_);
+  options.Get(options::kOcclusionTracking, &occlusion_tracking_);
 
   if (parent)
     options.Get("modal", &is_modal_);
@@ -456,11 +462,14 @@ void NativeWindow::NotifyWindowUnmaximize() {
 void NativeWindow::NotifyWindowMinimize() {
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowMinimize();
+  SetOccluded(true);
 }
 
 void NativeWindow::NotifyWindowRestore() {
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowRestore();
+  // The platform code reports it again if other windows cover it.
+  SetOccluded(false);
 }
 
 void NativeWindow::NotifyWindowWillResize(const gfx::Rect& new_bounds,
@@ -476,20 +485,79 @@ void NativeWindow::NotifyWindowWillMove(const gfx::Rect& new_bounds,
 }
 
 void NativeWindow::NotifyWindowResize() {
+  if (coalesce_bounds_events_) {
+    resize_pending_ = true;
+    ScheduleBoundsEvents();
+    return;
+  }
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowResize();
 }
 
 void NativeWindow::NotifyWindowMove() {
+  if (coalesce_bounds_events_) {
+    move_pending_ = true;
+    ScheduleBoundsEvents();
+    return;
+  }
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowMove();
 }
 
 void NativeWindow::NotifyWindowMoved() {
+  // The events of the move come before its end.
+  if (bounds_events_timer_.IsRunning()) {
+    bounds_events_timer_.Stop();
+    FlushBoundsEvents();
+  }
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowMoved();
 }
 
+void NativeWindow::ScheduleBoundsEvents() {
+  if (bounds_events_timer_.IsRunning())
+    return;
+  // The first event of a drag is emitted right away, the following ones once
+  // a frame has passed since the last one.
+  base::TimeDelta delay =
+      last_bounds_events_ +
+      base::TimeDelta::FromMilliseconds(kBoundsEventsIntervalMs) -
+      base::TimeTicks::Now();
+  if (delay <= base::TimeDelta()) {
+    FlushBoundsEvents();
+    return;
+  }
+  bounds_events_timer_.Start(FROM_HERE, delay,
+                             base::Bind(&NativeWindow::FlushBoundsEvents,
+                                        base::Unretained(this)));
+}
+
+void NativeWindow::FlushBoundsEvents() {
+  last_bounds_events_ = base::TimeTicks::Now();
+  if (resize_pending_) {
+    resize_pending_ = false;
+    for (NativeWindowObserver& observer : observers_)
+      observer.OnWindowResize();
+  }
+  if (move_pending_) {
+    move_pending_ = false;
+    for (NativeWindowObserver& observer : observers_)
+      observer.OnWindowMove();
+  }
+}
+
+void NativeWindow::NotifyWindowOcclusionChanged() {
+  for (NativeWindowObserver& observer : observers_)
+    observer.OnWindowOcclusionChanged();
+}
+
+void NativeWindow::SetOccluded(bool occluded) {
+  if (!occlusion_tracking_ || is_occluded_ == occluded)
+    return;
+  is_occluded_ = occluded;
+  NotifyWindowOcclusionChanged();
+}
+
 void NativeWindow::NotifyWindowEnterFullScreen() {
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowEnterFullScreen();
@@ -9,12 +9,14 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "atom/browser/native_window_observer.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/supports_user_data.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/web_contents_user_data.h"
 #include "extensions/browser/app_window/size_constraints.h"
 #include "ui/views/widget/widget_delegate.h"
@@ -55,6 +57,11 @@ class NativeWindow : public base::SupportsUserData,
   static NativeWindow* Create(const mate::Dictionary& options,
                               NativeWindow* parent = nullptr);
 
+  // Moves and resizes several windows at once, so the system lays them out
+  // and paints them together instead of one after the other.
+  using BoundsUpdate = std::pair<NativeWindow*, gfx::Rect>;
+  static void SetBoundsForWindows(const std::vector<BoundsUpdate>& updates);
+
   void InitFromOptions(const mate::Dictionary& options);
 
   virtual void SetContentView(views::View* view) = 0;
@@ -261,6 +268,11 @@ class NativeWindow : public base::SupportsUserData,
   void NotifyTouchBarItemInteraction(const std::string& item_id,
                                      const base::DictionaryValue& details);
   void NotifyNewWindowForTab();
+  void NotifyWindowOcclusionChanged();
+
+  // Called by the platform code, with the occlusionTracking option, when the
+  // window gets fully covered or minimized, or becomes visible again.
+  void SetOccluded(bool occluded);
 
 #if defined(OS_WIN)
   void NotifyWindowMessage(UINT message, WPARAM w_param, LPARAM l_param);
@@ -279,6 +291,8 @@ class NativeWindow : public base::SupportsUserData,
 
   bool transparent() const { return transparent_; }
   bool enable_larger_than_screen() const { return enable_larger_than_screen_; }
+  bool occlusion_tracking() const { return occlusion_tracking_; }
+  bool is_occluded() const { return is_occluded_; }
 
   NativeBrowserView* browser_view() const { return browser_view_; }
   NativeWindow* parent() const { return parent_; }
@@ -297,6 +311,10 @@ class NativeWindow : public base::SupportsUserData,
   }
 
  private:
+  // Emits the resize and move events that are pending.
+  void ScheduleBoundsEvents();
+  void FlushBoundsEvents();
+
   std::unique_ptr<views::Widget> widget_;
 
   // The content view, weak ref.
@@ -314,9 +332,22 @@ class NativeWindow : public base::SupportsUserData,
   // Whether window can be resized larger than screen.
   bool enable_larger_than_screen_ = false;
 
+  // Whether the contents stop rendering while the window is covered.
+  bool occlusion_tracking_ = false;
+  bool is_occluded_ = false;
+
   // The windows has been closed.
   bool is_closed_ = false;
 
+  // A drag can move the window hundreds of times per second, so the resize
+  // and move events can be held back until the next frame, when only the
+  // latest bounds matter.
+  bool coalesce_bounds_events_ = false;
+  bool resize_pending_ = false;
+  bool move_pending_ = false;
+  base::TimeTicks last_bounds_events_;
+  base::OneShotTimer bounds_events_timer_;
+
   // Used to display sheets at the appropriate horizontal and vertical offsets
   // on macOS.
   double sheet_offset_x_ = 0.0;
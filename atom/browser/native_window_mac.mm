@@ -26,6 +26,7 @@
 #include "content/public/browser/browser_accessibility_state.h"
 #include "native_mate/dictionary.h"
 #include "skia/ext/skia_utils_mac.h"
+#include "ui/gfx/scoped_cocoa_disable_screen_updates.h"
 #include "ui/gfx/skia_util.h"
 #include "ui/gl/gpu_switching_manager.h"
 #include "ui/views/background.h"
@@ -1497,4 +1498,13 @@ NativeWindow* NativeWindow::Create(const mate::Dictionary& options,
   return new NativeWindowMac(options, parent);
 }
 
+// static
+void NativeWindow::SetBoundsForWindows(
+    const std::vector<BoundsUpdate>& updates) {
+  // The screen is only redrawn once all the frames have changed.
+  gfx::ScopedCocoaDisableScreenUpdates disabler;
+  for (const auto& update : updates)
+    update.first->SetBounds(update.second);
+}
+
 }  // namespace atom
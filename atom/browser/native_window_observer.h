@@ -74,6 +74,8 @@ class NativeWindowObserver {
                                 bool* prevent_default) {}
   virtual void OnWindowMove() {}
   virtual void OnWindowMoved() {}
+  // Called when the window or its browser view were covered or uncovered.
+  virtual void OnWindowOcclusionChanged() {}
   virtual void OnWindowScrollTouchBegin() {}
   virtual void OnWindowScrollTouchEnd() {}
   virtual void OnWindowSwipe(const std::string& direction) {}
@@ -58,6 +58,7 @@
 #include "atom/browser/ui/views/win_frame_view.h"
 #include "atom/browser/ui/win/atom_desktop_native_widget_aura.h"
 #include "atom/browser/ui/win/atom_desktop_window_tree_host_win.h"
+#include "atom/browser/ui/win/window_occlusion_tracker.h"
 #include "skia/ext/skia_utils_win.h"
 #include "ui/base/win/shell.h"
 #include "ui/display/display.h"
@@ -286,6 +287,10 @@ NativeWindowViews::NativeWindowViews(const mate::Dictionary& options,
   else
     last_window_state_ = ui::SHOW_STATE_NORMAL;
   last_normal_bounds_ = GetBounds();
+
+  if (occlusion_tracking())
+    WindowOcclusionTracker::GetInstance()->Track(this,
+                                                 GetAcceleratedWidget());
 #endif
 }
 
@@ -295,6 +300,9 @@ NativeWindowViews::~NativeWindowViews() {
 #if defined(OS_WIN)
   // Disable mouse forwarding to relinquish resources, should any be held.
   SetForwardMouseMessages(false);
+
+  if (occlusion_tracking())
+    WindowOcclusionTracker::GetInstance()->Untrack(this);
 #endif
 }
 
@@ -852,10 +860,14 @@ double NativeWindowViews::GetOpacity() {
 void NativeWindowViews::SetIgnoreMouseEvents(bool ignore, bool forward) {
 #if defined(OS_WIN)
   LONG ex_style = ::GetWindowLong(GetAcceleratedWidget(), GWL_EXSTYLE);
-  if (ignore)
-    ex_style |= (WS_EX_TRANSPARENT | WS_EX_LAYERED);
-  else
-    ex_style &= ~(WS_EX_TRANSPARENT | WS_EX_LAYERED);
+  ex_style &= ~(WS_EX_TRANSPARENT | WS_EX_LAYERED);
+  if (ignore) {
+    ex_style |= WS_EX_LAYERED;
+    // When forwarding, the window only becomes transparent to the mouse once
+    // the cursor is over it, see |OnForwardingHitTest|.
+    if (!forward || forward_mouse_timer_.IsRunning())
+      ex_style |= WS_EX_TRANSPARENT;
+  }
   if (layered_)
     ex_style |= WS_EX_LAYERED;
   ::SetWindowLong(GetAcceleratedWidget(), GWL_EXSTYLE, ex_style);
@@ -1165,8 +1177,11 @@ void NativeWindowViews::OnWidgetBoundsChanged(views::Widget* changed_widget,
   const auto new_bounds = GetBounds();
   if (widget_size_ != new_bounds.size()) {
     if (browser_view()) {
-      const auto flags = static_cast<NativeBrowserViewViews*>(browser_view())
-                             ->GetAutoResizeFlags();
+      auto* native_browser_view =
+          static_cast<NativeBrowserViewViews*>(browser_view());
+      // Auto resizing starts from the bounds the app set last.
+      native_browser_view->ApplyPendingBounds();
+      const auto flags = native_browser_view->GetAutoResizeFlags();
       int width_delta = 0;
       int height_delta = 0;
       if (flags & kAutoResizeWidth) {
@@ -1294,4 +1309,42 @@ NativeWindow* NativeWindow::Create(const mate::Dictionary& options,
   return new NativeWindowViews(options, parent);
 }
 
+// static
+void NativeWindow::SetBoundsForWindows(
+    const std::vector<BoundsUpdate>& updates) {
+#if defined(OS_WIN)
+  // DeferWindowPos only moves windows, the ones that are not resizable also
+  // update their size constraints, and the minimized or maximized ones only
+  // change their restored bounds.
+  std::vector<const BoundsUpdate*> deferred;
+  HDWP hdwp = ::BeginDeferWindowPos(static_cast<int>(updates.size()));
+  for (const auto& update : updates) {
+    auto* window = static_cast<NativeWindowViews*>(update.first);
+    if (hdwp && window->IsResizable() && window->IsNormal()) {
+      HWND hwnd = window->GetAcceleratedWidget();
+      gfx::Rect rect =
+          display::win::ScreenWin::DIPToScreenRect(hwnd, update.second);
+      hdwp = ::DeferWindowPos(hdwp, hwnd, nullptr, rect.x(), rect.y(),
+                              rect.width(), rect.height(),
+                              SWP_NOZORDER | SWP_NOOWNERZORDER |
+                                  SWP_NOACTIVATE);
+      if (hdwp) {
+        deferred.push_back(&update);
+        continue;
+      }
+      // The whole batch is dropped when one window fails.
+      for (const auto* dropped : deferred)
+        dropped->first->SetBounds(dropped->second);
+      deferred.clear();
+    }
+    window->SetBounds(update.second);
+  }
+  if (hdwp)
+    ::EndDeferWindowPos(hdwp);
+#else
+  for (const auto& update : updates)
+    update.first->SetBounds(update.second);
+#endif
+}
+
 }  // namespace atom
@@ -8,7 +8,6 @@
 #include "atom/browser/native_window.h"
 
 #include <memory>
-#include <set>
 #include <string>
 #include <tuple>
 
@@ -17,6 +16,7 @@
 #if defined(OS_WIN)
 #include "atom/browser/ui/win/message_handler_delegate.h"
 #include "atom/browser/ui/win/taskbar_host.h"
+#include "base/timer/timer.h"
 #include "base/win/scoped_gdi_object.h"
 #endif
 
@@ -184,15 +184,18 @@ class NativeWindowViews : public NativeWindow,
                     LRESULT* result) override;
   void HandleSizeEvent(WPARAM w_param, LPARAM l_param);
   void SetForwardMouseMessages(bool forward);
+  // Called when the window is hit-tested while forwarding, i.e. the cursor
+  // entered it.
+  LRESULT OnForwardingHitTest();
+  // Forwards the cursor position while it is over the window.
+  void ForwardMouseMove();
+  void SetMouseTransparent(bool transparent);
   static LRESULT CALLBACK SubclassProc(HWND hwnd,
                                        UINT msg,
                                        WPARAM w_param,
                                        LPARAM l_param,
                                        UINT_PTR subclass_id,
                                        DWORD_PTR ref_data);
-  static LRESULT CALLBACK MouseHookProc(int n_code,
-                                        WPARAM w_param,
-                                        LPARAM l_param);
 #endif
 
   // Enable/disable:
@@ -267,10 +270,11 @@ class NativeWindowViews : public NativeWindow,
   base::win::ScopedHICON window_icon_;
   base::win::ScopedHICON app_icon_;
 
-  // The set of windows currently forwarding mouse messages.
-  static std::set<NativeWindowViews*> forwarding_windows_;
-  static HHOOK mouse_hook_;
   bool forwarding_mouse_messages_ = false;
+  // Polls the cursor while it is over a forwarding window, which is then
+  // transparent to the mouse and does not get any mouse messages.
+  base::RepeatingTimer forward_mouse_timer_;
+  POINT last_forwarded_point_ = {-1, -1};
   HWND legacy_window_ = NULL;
   bool layered_ = false;
 #endif
@@ -4,6 +4,7 @@
 
 #include "atom/browser/browser.h"
 #include "atom/browser/native_window_views.h"
+#include "base/bind.h"
 #include "content/public/browser/browser_accessibility_state.h"
 #include "ui/base/win/accessibility_misc_utils.h"
 
@@ -128,6 +129,9 @@ const char* AppCommandToString(int command_id) {
   }
 }
 
+// How often the cursor is polled while it is over a forwarding window.
+const int kForwardMouseIntervalMs = 16;
+
 bool IsScreenReaderActive() {
   UINT screenReader = 0;
   SystemParametersInfo(SPI_GETSCREENREADER, 0, &screenReader, 0);
@@ -136,9 +140,6 @@ bool IsScreenReaderActive() {
 
 }  // namespace
 
-std::set<NativeWindowViews*> NativeWindowViews::forwarding_windows_;
-HHOOK NativeWindowViews::mouse_hook_ = NULL;
-
 bool NativeWindowViews::ExecuteWindowsCommand(int command_id) {
   std::string command = AppCommandToString(command_id);
   NotifyWindowExecuteWindowsCommand(command);
@@ -234,6 +235,12 @@ bool NativeWindowViews::PreHandleMSG(UINT message,
       }
       return false;
     }
+    case WM_NCHITTEST: {
+      if (!forwarding_mouse_messages_)
+        return false;
+      *result = OnForwardingHitTest();
+      return true;
+    }
     case WM_PARENTNOTIFY: {
       if (LOWORD(w_param) == WM_CREATE) {
         // Because of reasons regarding legacy drivers and stuff, a window that
@@ -307,29 +314,80 @@ void NativeWindowViews::HandleSizeEvent(WPARAM w_param, LPARAM l_param) {
 void NativeWindowViews::SetForwardMouseMessages(bool forward) {
   if (forward && !forwarding_mouse_messages_) {
     forwarding_mouse_messages_ = true;
-    forwarding_windows_.insert(this);
 
     // Subclassing is used to fix some issues when forwarding mouse messages;
     // see comments in |SubclassProc|.
     SetWindowSubclass(legacy_window_, SubclassProc, 1,
                       reinterpret_cast<DWORD_PTR>(this));
-
-    if (!mouse_hook_) {
-      mouse_hook_ = SetWindowsHookEx(WH_MOUSE_LL, MouseHookProc, NULL, 0);
-    }
   } else if (!forward && forwarding_mouse_messages_) {
     forwarding_mouse_messages_ = false;
-    forwarding_windows_.erase(this);
+    forward_mouse_timer_.Stop();
 
     RemoveWindowSubclass(legacy_window_, SubclassProc, 1);
+  }
+}
 
-    if (forwarding_windows_.size() == 0) {
-      UnhookWindowsHookEx(mouse_hook_);
-      mouse_hook_ = NULL;
-    }
+LRESULT NativeWindowViews::OnForwardingHitTest() {
+  // While the cursor is outside, the window is not transparent to the mouse
+  // and is hit-tested like any other window, so it costs nothing. Once the
+  // cursor enters, the window is made transparent so that clicks go to
+  // whatever is below it, including windows of other processes, and the
+  // cursor is polled until it leaves again. This avoids a low-level mouse
+  // hook, which would route every mouse move of the desktop through our UI
+  // thread.
+  ForwardMouseMove();
+  if (!forward_mouse_timer_.IsRunning()) {
+    SetMouseTransparent(true);
+    forward_mouse_timer_.Start(
+        FROM_HERE, base::TimeDelta::FromMilliseconds(kForwardMouseIntervalMs),
+        base::Bind(&NativeWindowViews::ForwardMouseMove,
+                   base::Unretained(this)));
+  }
+  return HTTRANSPARENT;
+}
+
+void NativeWindowViews::ForwardMouseMove() {
+  POINT p;
+  RECT window_rect;
+  if (!::GetCursorPos(&p) ||
+      !::GetWindowRect(GetAcceleratedWidget(), &window_rect))
+    return;
+
+  if (!::PtInRect(&window_rect, p)) {
+    // Hit-test the window again to notice when the cursor comes back.
+    forward_mouse_timer_.Stop();
+    SetMouseTransparent(false);
+    last_forwarded_point_ = {-1, -1};
+    return;
+  }
+
+  if (p.x == last_forwarded_point_.x && p.y == last_forwarded_point_.y)
+    return;
+  last_forwarded_point_ = p;
+
+  // Post a WM_MOUSEMOVE message since the window is in a state where it would
+  // otherwise ignore all mouse input. Nothing bad seems to happen if we post
+  // the message even if some other window occludes it.
+  RECT client_rect;
+  GetClientRect(legacy_window_, &client_rect);
+  ScreenToClient(legacy_window_, &p);
+  if (PtInRect(&client_rect, p)) {
+    WPARAM w = 0;  // No virtual keys pressed for our purposes
+    LPARAM l = MAKELPARAM(p.x, p.y);
+    PostMessage(legacy_window_, WM_MOUSEMOVE, w, l);
   }
 }
 
+void NativeWindowViews::SetMouseTransparent(bool transparent) {
+  HWND hwnd = GetAcceleratedWidget();
+  LONG ex_style = ::GetWindowLong(hwnd, GWL_EXSTYLE);
+  if (transparent)
+    ex_style |= WS_EX_TRANSPARENT;
+  else
+    ex_style &= ~WS_EX_TRANSPARENT;
+  ::SetWindowLong(hwnd, GWL_EXSTYLE, ex_style);
+}
+
 LRESULT CALLBACK NativeWindowViews::SubclassProc(HWND hwnd,
                                                  UINT msg,
                                                  WPARAM w_param,
@@ -338,6 +396,13 @@ LRESULT CALLBACK NativeWindowViews::SubclassProc(HWND hwnd,
                                                  DWORD_PTR ref_data) {
   NativeWindowViews* window = reinterpret_cast<NativeWindowViews*>(ref_data);
   switch (msg) {
+    case WM_NCHITTEST: {
+      // The legacy window covers the client area, so it is hit-tested
+      // instead of the browser window most of the time.
+      if (window->forwarding_mouse_messages_)
+        return window->OnForwardingHitTest();
+      break;
+    }
     case WM_MOUSELEAVE: {
       // When input is forwarded to underlying windows, this message is posted.
       // If not handled, it interferes with Chromium logic, causing for example
@@ -359,35 +424,4 @@ LRESULT CALLBACK NativeWindowViews::SubclassProc(HWND hwnd,
   return DefSubclassProc(hwnd, msg, w_param, l_param);
 }
 
-LRESULT CALLBACK NativeWindowViews::MouseHookProc(int n_code,
-                                                  WPARAM w_param,
-                                                  LPARAM l_param) {
-  if (n_code < 0) {
-    return CallNextHookEx(NULL, n_code, w_param, l_param);
-  }
-
-  // Post a WM_MOUSEMOVE message for those windows whose client area contains
-  // the cursor since they are in a state where they would otherwise ignore all
-  // mouse input.
-  if (w_param == WM_MOUSEMOVE) {
-    for (auto* window : forwarding_windows_) {
-      // At first I considered enumerating windows to check whether the cursor
-      // was directly above the window, but since nothing bad seems to happen
-      // if we post the message even if some other window occludes it I have
-      // just left it as is.
-      RECT client_rect;
-      GetClientRect(window->legacy_window_, &client_rect);
-      POINT p = reinterpret_cast<MSLLHOOKSTRUCT*>(l_param)->pt;
-      ScreenToClient(window->legacy_window_, &p);
-      if (PtInRect(&client_rect, p)) {
-        WPARAM w = 0;  // No virtual keys pressed for our purposes
-        LPARAM l = MAKELPARAM(p.x, p.y);
-        PostMessage(window->legacy_window_, WM_MOUSEMOVE, w, l);
-      }
-    }
-  }
-
-  return CallNextHookEx(NULL, n_code, w_param, l_param);
-}
-
 }  // namespace atom
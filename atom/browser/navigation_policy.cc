@@ -0,0 +1,121 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/navigation_policy.h"
+
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "url/gurl.h"
+
+namespace atom {
+
+namespace {
+
+// The syntax of RFC 3986, GURL would accept more.
+bool IsValidScheme(base::StringPiece scheme) {
+  if (scheme.empty() || !base::IsAsciiAlpha(scheme[0]))
+    return false;
+  for (char c : scheme) {
+    if (!base::IsAsciiAlpha(c) && !base::IsAsciiDigit(c) && c != '+' &&
+        c != '-' && c != '.')
+      return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<NavigationPolicy> NavigationPolicy::Create(
+    const std::vector<std::string>& allow,
+    const std::vector<std::string>& deny,
+    std::string* error) {
+  std::unique_ptr<NavigationPolicy> policy(new NavigationPolicy);
+  if (!AddEntries(allow, &policy->allowed_domains_, &policy->allowed_schemes_,
+                  &policy->allow_all_, error) ||
+      !AddEntries(deny, &policy->denied_domains_, &policy->denied_schemes_,
+                  &policy->deny_all_, error))
+    return nullptr;
+  return policy;
+}
+
+NavigationPolicy::NavigationPolicy() = default;
+
+NavigationPolicy::~NavigationPolicy() = default;
+
+NavigationPolicy::Decision NavigationPolicy::Evaluate(const GURL& url) const {
+  base::StringPiece host = url.has_host() ? url.host_piece() : "";
+  if (host.ends_with("."))
+    host.remove_suffix(1);
+  // The labels of an IP address are not subdomains.
+  bool match_suffixes = !url.HostIsIPAddress();
+  while (!host.empty()) {
+    std::string domain = host.as_string();
+    if (denied_domains_.count(domain))
+      return Decision::DENY;
+    if (allowed_domains_.count(domain))
+      return Decision::ALLOW;
+    size_t dot = host.find('.');
+    if (!match_suffixes || dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+
+  // GURL lowers the case of schemes.
+  std::string scheme = url.scheme();
+  if (denied_schemes_.count(scheme))
+    return Decision::DENY;
+  if (allowed_schemes_.count(scheme))
+    return Decision::ALLOW;
+
+  if (deny_all_)
+    return Decision::DENY;
+  if (allow_all_)
+    return Decision::ALLOW;
+  return Decision::UNMATCHED;
+}
+
+// static
+bool NavigationPolicy::AddEntries(const std::vector<std::string>& entries,
+                                  std::unordered_set<std::string>* domains,
+                                  std::unordered_set<std::string>* schemes,
+                                  bool* all,
+                                  std::string* error) {
+  for (const auto& entry : entries) {
+    base::StringPiece domain =
+        base::TrimWhitespaceASCII(entry, base::TRIM_ALL);
+    if (domain == "*") {
+      *all = true;
+      continue;
+    }
+    if (domain.ends_with(":")) {
+      base::StringPiece scheme = domain.substr(0, domain.size() - 1);
+      if (!IsValidScheme(scheme)) {
+        *error = "Invalid scheme: " + entry;
+        return false;
+      }
+      schemes->insert(base::ToLowerASCII(scheme));
+      continue;
+    }
+    if (domain.starts_with("*."))
+      domain.remove_prefix(2);
+    else if (domain.starts_with("."))
+      domain.remove_prefix(1);
+
+    // Let GURL lower the case and encode international domains, so entries
+    // compare with the hosts of canonical URLs.
+    GURL url("http://" + domain.as_string() + "/");
+    base::StringPiece host = url.is_valid() ? url.host_piece() : "";
+    if (host.ends_with("."))
+      host.remove_suffix(1);
+    if (host.empty() || url.path_piece() != "/" || url.has_port()) {
+      *error = "Invalid domain: " + entry;
+      return false;
+    }
+    domains->insert(host.as_string());
+  }
+  return true;
+}
+
+}  // namespace atom
@@ -0,0 +1,67 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NAVIGATION_POLICY_H_
+#define ATOM_BROWSER_NAVIGATION_POLICY_H_
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/macros.h"
+
+class GURL;
+
+namespace atom {
+
+// Lists of domains whose navigations are allowed or denied without asking
+// JavaScript. An entry matches its domain and all of its subdomains, an entry
+// like "file:" matches every URL of the scheme, and "*" matches every URL. The
+// most specific entry wins, domains before schemes, and deny wins between
+// equal entries. URLs without a host, like file: and data: URLs, are only
+// matched by scheme entries and "*".
+class NavigationPolicy {
+ public:
+  enum class Decision {
+    ALLOW,
+    DENY,
+    // Neither list matches, JavaScript decides.
+    UNMATCHED,
+  };
+
+  // Returns null and sets |error| when an entry is not a valid domain.
+  static std::unique_ptr<NavigationPolicy> Create(
+      const std::vector<std::string>& allow,
+      const std::vector<std::string>& deny,
+      std::string* error);
+
+  ~NavigationPolicy();
+
+  // Costs one hash lookup per label of the host and one for the scheme.
+  Decision Evaluate(const GURL& url) const;
+
+ private:
+  NavigationPolicy();
+
+  // Adds the canonical form of each entry to |domains| or |schemes|.
+  static bool AddEntries(const std::vector<std::string>& entries,
+                         std::unordered_set<std::string>* domains,
+                         std::unordered_set<std::string>* schemes,
+                         bool* all,
+                         std::string* error);
+
+  std::unordered_set<std::string> allowed_domains_;
+  std::unordered_set<std::string> denied_domains_;
+  std::unordered_set<std::string> allowed_schemes_;
+  std::unordered_set<std::string> denied_schemes_;
+  bool allow_all_ = false;
+  bool deny_all_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(NavigationPolicy);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NAVIGATION_POLICY_H_
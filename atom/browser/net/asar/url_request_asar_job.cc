@@ -4,6 +4,7 @@
 
 #include "atom/browser/net/asar/url_request_asar_job.h"
 
+#include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,6 +24,7 @@
 #include "net/base/load_flags.h"
 #include "net/base/mime_util.h"
 #include "net/base/net_errors.h"
+#include "net/filter/brotli_source_stream.h"
 #include "net/filter/gzip_source_stream.h"
 #include "net/http/http_util.h"
 #include "net/url_request/url_request_status.h"
@@ -75,10 +77,12 @@ void URLRequestAsarJob::InitializeAsarJob(
     const Archive::FileInfo& file_info) {
   type_ = TYPE_ASAR;
   file_task_runner_ = file_task_runner;
-  stream_.reset(new net::FileStream(file_task_runner_));
   archive_ = archive;
   file_path_ = file_path;
   file_info_ = file_info;
+  use_mapped_content_ = archive_->GetFileContent(file_info_, &mapped_content_);
+  if (!use_mapped_content_)
+    stream_.reset(new net::FileStream(file_task_runner_));
 }
 
 void URLRequestAsarJob::InitializeFileJob(
@@ -129,12 +133,25 @@ int URLRequestAsarJob::ReadRawData(net::IOBuffer* dest, int dest_size) {
   if (!dest_size)
     return 0;
 
+  // Only the blocks that are actually served get verified.
+  if (type_ == TYPE_ASAR &&
+      !archive_->VerifyRange(file_info_, read_position_, dest_size))
+    return net::ERR_INVALID_RESPONSE;
+
+  if (use_mapped_content_) {
+    memcpy(dest->data(), mapped_content_.data() + read_position_, dest_size);
+    read_position_ += dest_size;
+    remaining_bytes_ -= dest_size;
+    return dest_size;
+  }
+
   int rv = stream_->Read(
       dest, dest_size,
       base::Bind(&URLRequestAsarJob::DidRead, weak_ptr_factory_.GetWeakPtr(),
                  WrapRefCounted(dest)));
   if (rv >= 0) {
     remaining_bytes_ -= rv;
+    read_position_ += rv;
     DCHECK_GE(remaining_bytes_, 0);
   }
 
@@ -172,6 +189,9 @@ bool URLRequestAsarJob::IsRedirectResponse(GURL* location,
 std::unique_ptr<net::SourceStream> URLRequestAsarJob::SetUpSourceStream() {
   std::unique_ptr<net::SourceStream> source =
       net::URLRequestJob::SetUpSourceStream();
+  // Compressed files in archive are inflated incrementally as they are read.
+  if (type_ == TYPE_ASAR && file_info_.compressed)
+    source = net::CreateBrotliSourceStream(std::move(source));
   // Bug 9936 - .svgz files needs to be decompressed.
   return base::LowerCaseEqualsASCII(file_path_.Extension(), ".svgz")
              ? net::GzipSourceStream::Create(std::move(source),
@@ -255,6 +275,12 @@ void URLRequestAsarJob::DidFetchMetaInfo(const FileMetaInfo* meta_info) {
     return;
   }
 
+  // Nothing to open when reading from the mapped archive.
+  if (use_mapped_content_) {
+    DidOpen(net::OK);
+    return;
+  }
+
   int flags =
       base::File::FLAG_OPEN | base::File::FLAG_READ | base::File::FLAG_ASYNC;
   int rv = stream_->Open(
@@ -281,6 +307,10 @@ void URLRequestAsarJob::DidOpen(int result) {
   if (type_ == TYPE_ASAR) {
     file_size = file_info_.size;
     read_offset = file_info_.offset;
+    // The range can not be mapped to the compressed bytes, so always serve
+    // the whole file.
+    if (file_info_.compressed)
+      byte_range_ = net::HttpByteRange();
   } else {
     file_size = meta_info_.file_size;
     read_offset = 0;
@@ -295,8 +325,9 @@ void URLRequestAsarJob::DidOpen(int result) {
   remaining_bytes_ =
       byte_range_.last_byte_position() - byte_range_.first_byte_position() + 1;
   seek_offset_ = byte_range_.first_byte_position() + read_offset;
+  read_position_ = byte_range_.first_byte_position();
 
-  if (remaining_bytes_ > 0 && seek_offset_ != 0) {
+  if (remaining_bytes_ > 0 && seek_offset_ != 0 && !use_mapped_content_) {
     int rv =
         stream_->Seek(seek_offset_, base::Bind(&URLRequestAsarJob::DidSeek,
                                                weak_ptr_factory_.GetWeakPtr()));
@@ -326,6 +357,7 @@ void URLRequestAsarJob::DidSeek(int64_t result) {
 void URLRequestAsarJob::DidRead(scoped_refptr<net::IOBuffer> buf, int result) {
   if (result >= 0) {
     remaining_bytes_ -= result;
+    read_position_ += result;
     DCHECK_GE(remaining_bytes_, 0);
   }
 
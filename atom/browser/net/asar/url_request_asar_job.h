@@ -117,6 +117,11 @@ class URLRequestAsarJob : public net::URLRequestJob {
   base::FilePath file_path_;
   Archive::FileInfo file_info_;
 
+  // When the archive is memory-mapped, reads are served directly from the
+  // mapped pages instead of going through |stream_|.
+  bool use_mapped_content_ = false;
+  base::StringPiece mapped_content_;
+
   std::unique_ptr<net::FileStream> stream_;
   FileMetaInfo meta_info_;
   scoped_refptr<base::TaskRunner> file_task_runner_;
@@ -124,6 +129,8 @@ class URLRequestAsarJob : public net::URLRequestJob {
   net::HttpByteRange byte_range_;
   int64_t remaining_bytes_ = 0;
   int64_t seek_offset_ = 0;
+  // Position of the next byte to read, relative to the start of the file.
+  int64_t read_position_ = 0;
 
   net::Error range_parse_result_ = net::OK;
 
@@ -4,6 +4,7 @@
 
 #include "atom/browser/net/atom_cert_verifier.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "atom/browser/browser.h"
@@ -11,6 +12,7 @@
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "base/containers/linked_list.h"
 #include "base/memory/weak_ptr.h"
+#include "base/stl_util.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/net_errors.h"
 #include "net/cert/cert_verify_result.h"
@@ -27,6 +29,9 @@ VerifyRequestParams::VerifyRequestParams(const VerifyRequestParams&) = default;
 
 namespace {
 
+// The most results of the verify proc that are cached.
+const size_t kMaxCachedResults = 256;
+
 class Response : public base::LinkNode<Response> {
  public:
   Response(net::CertVerifyResult* verify_result,
@@ -66,19 +71,14 @@ class CertVerifierRequest : public AtomCertVerifier::Request {
   }
 
   void RunResponse(Response* response) {
-    if (custom_response_ == net::ERR_ABORTED) {
-      *(response->verify_result()) = result_;
-      response->callback().Run(error_);
-    } else {
-      response->verify_result()->Reset();
-      response->verify_result()->verified_cert = params_.certificate();
-      cert_verifier_->ct_delegate()->AddCTExcludedHost(params_.hostname());
-      response->callback().Run(custom_response_);
-    }
+    int result = cert_verifier_->ApplyResult(
+        params_, custom_response_, error_, result_, response->verify_result());
+    response->callback().Run(result);
     delete response;
   }
 
   void Start(net::CRLSet* crl_set, const net::NetLogWithSource& net_log) {
+    proc_generation_ = cert_verifier_->proc_generation();
     int error = cert_verifier_->default_verifier()->Verify(
         params_, crl_set, &result_,
         base::Bind(&CertVerifierRequest::OnDefaultVerificationDone,
@@ -121,6 +121,8 @@ class CertVerifierRequest : public AtomCertVerifier::Request {
   void NotifyResponseInIO(int result) {
     custom_response_ = result;
     first_response_ = false;
+    cert_verifier_->CacheResult(params_, proc_generation_, custom_response_,
+                                error_, result_);
     // Responding to first request in the list will initiate destruction of
     // the class, respond to others in the list inside destructor.
     base::LinkNode<Response>* response_node = response_list_.head();
@@ -143,6 +145,7 @@ class CertVerifierRequest : public AtomCertVerifier::Request {
   AtomCertVerifier* cert_verifier_;
   int error_ = net::ERR_IO_PENDING;
   int custom_response_ = net::ERR_IO_PENDING;
+  int proc_generation_ = 0;
   bool first_response_ = true;
   ResponseList response_list_;
   net::CertVerifyResult result_;
@@ -156,8 +159,13 @@ AtomCertVerifier::AtomCertVerifier(RequireCTDelegate* ct_delegate)
 
 AtomCertVerifier::~AtomCertVerifier() {}
 
-void AtomCertVerifier::SetVerifyProc(const VerifyProc& proc) {
+void AtomCertVerifier::SetVerifyProc(const VerifyProc& proc,
+                                     base::TimeDelta cache_duration) {
   verify_proc_ = proc;
+  cache_duration_ = cache_duration;
+  // Results of the previous proc are not valid anymore.
+  cached_results_.clear();
+  ++proc_generation_;
 }
 
 int AtomCertVerifier::Verify(const RequestParams& params,
@@ -173,6 +181,17 @@ int AtomCertVerifier::Verify(const RequestParams& params,
     return default_cert_verifier_->Verify(
         params, crl_set, verify_result, std::move(callback), out_req, net_log);
   } else {
+    auto cached = cached_results_.find(params);
+    if (cached != cached_results_.end()) {
+      if (cached->second.expiry > base::TimeTicks::Now()) {
+        return ApplyResult(params, cached->second.custom_response,
+                           cached->second.error, cached->second.result,
+                           verify_result);
+      }
+      cached_results_.erase(cached);
+    }
+
+    // Concurrent verifications of the same certificate share one request.
     CertVerifierRequest* request = FindRequest(params);
     if (!request) {
       out_req->reset();
@@ -194,6 +213,49 @@ void AtomCertVerifier::RemoveRequest(const RequestParams& params) {
     inflight_requests_.erase(it);
 }
 
+void AtomCertVerifier::CacheResult(const RequestParams& params,
+                                   int proc_generation,
+                                   int custom_response,
+                                   int error,
+                                   const net::CertVerifyResult& result) {
+  if (cache_duration_ <= base::TimeDelta() ||
+      proc_generation != proc_generation_)
+    return;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (cached_results_.size() >= kMaxCachedResults) {
+    base::EraseIf(cached_results_, [now](const auto& entry) {
+      return entry.second.expiry <= now;
+    });
+  }
+  if (cached_results_.size() >= kMaxCachedResults) {
+    // Make room by dropping the result that would expire first.
+    auto oldest = std::min_element(
+        cached_results_.begin(), cached_results_.end(),
+        [](const auto& a, const auto& b) {
+          return a.second.expiry < b.second.expiry;
+        });
+    cached_results_.erase(oldest);
+  }
+  cached_results_[params] = {custom_response, error, result,
+                             now + cache_duration_};
+}
+
+int AtomCertVerifier::ApplyResult(const RequestParams& params,
+                                  int custom_response,
+                                  int error,
+                                  const net::CertVerifyResult& result,
+                                  net::CertVerifyResult* verify_result) {
+  if (custom_response == net::ERR_ABORTED) {
+    *verify_result = result;
+    return error;
+  }
+  verify_result->Reset();
+  verify_result->verified_cert = params.certificate();
+  ct_delegate_->AddCTExcludedHost(params.hostname());
+  return custom_response;
+}
+
 CertVerifierRequest* AtomCertVerifier::FindRequest(
     const RequestParams& params) {
   auto it = inflight_requests_.find(params);
@@ -9,7 +9,9 @@
 #include <memory>
 #include <string>
 
+#include "base/time/time.h"
 #include "net/cert/cert_verifier.h"
+#include "net/cert/cert_verify_result.h"
 
 namespace atom {
 
@@ -35,7 +37,9 @@ class AtomCertVerifier : public net::CertVerifier {
   using VerifyProc = base::Callback<void(const VerifyRequestParams& request,
                                          net::CompletionOnceCallback)>;
 
-  void SetVerifyProc(const VerifyProc& proc);
+  // The results of |proc| are reused for the same certificate chain and
+  // hostname during |cache_duration|.
+  void SetVerifyProc(const VerifyProc& proc, base::TimeDelta cache_duration);
 
   const VerifyProc verify_proc() const { return verify_proc_; }
   RequireCTDelegate* ct_delegate() const { return ct_delegate_; }
@@ -55,11 +59,39 @@ class AtomCertVerifier : public net::CertVerifier {
  private:
   friend class CertVerifierRequest;
 
+  struct CachedResult {
+    int custom_response;
+    int error;
+    net::CertVerifyResult result;
+    base::TimeTicks expiry;
+  };
+
   void RemoveRequest(const RequestParams& params);
   CertVerifierRequest* FindRequest(const RequestParams& params);
 
+  // Keeps the outcome of a verification that was started with the current
+  // verify proc, |proc_generation| tells which proc it was started with.
+  void CacheResult(const RequestParams& params,
+                   int proc_generation,
+                   int custom_response,
+                   int error,
+                   const net::CertVerifyResult& result);
+
+  // Fills |verify_result| with the outcome of a verification and returns its
+  // error code.
+  int ApplyResult(const RequestParams& params,
+                  int custom_response,
+                  int error,
+                  const net::CertVerifyResult& result,
+                  net::CertVerifyResult* verify_result);
+
+  int proc_generation() const { return proc_generation_; }
+
   std::map<RequestParams, CertVerifierRequest*> inflight_requests_;
+  std::map<RequestParams, CachedResult> cached_results_;
   VerifyProc verify_proc_;
+  base::TimeDelta cache_duration_;
+  int proc_generation_ = 0;
   std::unique_ptr<net::CertVerifier> default_cert_verifier_;
   RequireCTDelegate* ct_delegate_;
 
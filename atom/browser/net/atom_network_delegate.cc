@@ -5,19 +5,23 @@
 #include "atom/browser/net/atom_network_delegate.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "atom/browser/api/atom_api_web_contents.h"
 #include "atom/browser/login_handler.h"
+#include "atom/browser/net/request_log_writer.h"
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "atom/common/options_switches.h"
 #include "base/command_line.h"
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/resource_request_info.h"
 #include "net/base/load_flags.h"
+#include "net/base/load_timing_info.h"
 #include "net/base/net_errors.h"
 #include "net/url_request/url_request.h"
 
@@ -58,117 +62,98 @@ using ResponseHeadersContainer =
     std::pair<scoped_refptr<net::HttpResponseHeaders>*, const std::string&>;
 
 void RunSimpleListener(const AtomNetworkDelegate::SimpleListener& listener,
-                       std::unique_ptr<base::DictionaryValue> details,
+                       std::unique_ptr<WebRequestDetails> details,
                        int render_process_id,
                        int render_frame_id) {
+  TRACE_EVENT0("electron", "AtomNetworkDelegate::RunSimpleListener");
   int32_t id = GetWebContentsID(render_process_id, render_frame_id);
   // id must be greater than zero
   if (id)
-    details->SetInteger("webContentsId", id);
+    details->dict()->SetInteger("webContentsId", id);
   return listener.Run(*(details.get()));
 }
 
 void RunResponseListener(
     const AtomNetworkDelegate::ResponseListener& listener,
-    std::unique_ptr<base::DictionaryValue> details,
+    std::unique_ptr<WebRequestDetails> details,
     int render_process_id,
     int render_frame_id,
     const AtomNetworkDelegate::ResponseCallback& callback) {
+  TRACE_EVENT0("electron", "AtomNetworkDelegate::RunResponseListener");
   int32_t id = GetWebContentsID(render_process_id, render_frame_id);
   // id must be greater than zero
   if (id)
-    details->SetInteger("webContentsId", id);
+    details->dict()->SetInteger("webContentsId", id);
   return listener.Run(*(details.get()), callback);
 }
 
-// Test whether the URL of |request| matches |patterns|.
-bool MatchesFilterCondition(net::URLRequest* request,
-                            const URLPatterns& patterns) {
-  if (patterns.empty())
-    return true;
-
-  for (const auto& pattern : patterns) {
-    if (pattern.MatchesURL(request->url()))
-      return true;
-  }
-  return false;
-}
-
 // Overloaded by multiple types to fill the |details| object.
-void ToDictionary(base::DictionaryValue* details, net::URLRequest* request) {
-  FillRequestDetails(details, request);
-  details->SetInteger("id", request->identifier());
-  details->SetDouble("timestamp", base::Time::Now().ToDoubleT() * 1000);
+void ToDictionary(WebRequestDetails* details, net::URLRequest* request) {
+  auto* dict = details->dict();
+  dict->SetString("method", request->method());
+  std::string url;
+  if (!request->url_chain().empty())
+    url = request->url().spec();
+  dict->SetKey("url", base::Value(url));
+  dict->SetString("referrer", request->referrer());
+  auto list = std::make_unique<base::ListValue>();
+  GetUploadData(list.get(), request);
+  if (!list->empty())
+    dict->Set("uploadData", std::move(list));
+  details->SetRequestHeaders("headers", request->extra_request_headers());
+  dict->SetInteger("id", request->identifier());
+  dict->SetDouble("timestamp", base::Time::Now().ToDoubleT() * 1000);
   const auto* info = content::ResourceRequestInfo::ForRequest(request);
   if (info) {
-    details->SetString("resourceType",
-                       ResourceTypeToString(info->GetResourceType()));
+    dict->SetString("resourceType",
+                    ResourceTypeToString(info->GetResourceType()));
   } else {
-    details->SetString("resourceType", "other");
+    dict->SetString("resourceType", "other");
   }
 }
 
-void ToDictionary(base::DictionaryValue* details,
+void ToDictionary(WebRequestDetails* details,
                   const net::HttpRequestHeaders& headers) {
-  auto dict = std::make_unique<base::DictionaryValue>();
-  net::HttpRequestHeaders::Iterator it(headers);
-  while (it.GetNext())
-    dict->SetKey(it.name(), base::Value(it.value()));
-  details->Set("requestHeaders", std::move(dict));
+  details->SetRequestHeaders("requestHeaders", headers);
 }
 
-void ToDictionary(base::DictionaryValue* details,
+void ToDictionary(WebRequestDetails* details,
                   const net::HttpResponseHeaders* headers) {
   if (!headers)
     return;
 
-  auto dict = std::make_unique<base::DictionaryValue>();
-  size_t iter = 0;
-  std::string key;
-  std::string value;
-  while (headers->EnumerateHeaderLines(&iter, &key, &value)) {
-    if (dict->FindKey(key)) {
-      base::ListValue* values = nullptr;
-      if (dict->GetList(key, &values))
-        values->AppendString(value);
-    } else {
-      auto values = std::make_unique<base::ListValue>();
-      values->AppendString(value);
-      dict->Set(key, std::move(values));
-    }
-  }
-  details->Set("responseHeaders", std::move(dict));
-  details->SetString("statusLine", headers->GetStatusLine());
-  details->SetInteger("statusCode", headers->response_code());
+  details->SetResponseHeaders("responseHeaders", *headers);
+  details->dict()->SetString("statusLine", headers->GetStatusLine());
+  details->dict()->SetInteger("statusCode", headers->response_code());
 }
 
-void ToDictionary(base::DictionaryValue* details, const GURL& location) {
-  details->SetString("redirectURL", location.spec());
+void ToDictionary(WebRequestDetails* details, const GURL& location) {
+  details->dict()->SetString("redirectURL", location.spec());
 }
 
-void ToDictionary(base::DictionaryValue* details,
+void ToDictionary(WebRequestDetails* details,
                   const net::HostPortPair& host_port) {
   if (host_port.host().empty())
-    details->SetString("ip", host_port.host());
+    details->dict()->SetString("ip", host_port.host());
 }
 
-void ToDictionary(base::DictionaryValue* details, bool from_cache) {
-  details->SetBoolean("fromCache", from_cache);
+void ToDictionary(WebRequestDetails* details, bool from_cache) {
+  details->dict()->SetBoolean("fromCache", from_cache);
 }
 
-void ToDictionary(base::DictionaryValue* details,
+void ToDictionary(WebRequestDetails* details,
                   const net::URLRequestStatus& status) {
-  details->SetString("error", net::ErrorToString(status.error()));
+  details->dict()->SetString("error", net::ErrorToString(status.error()));
 }
 
 // Helper function to fill |details| with arbitrary |args|.
 template <typename Arg>
-void FillDetailsObject(base::DictionaryValue* details, Arg arg) {
+void FillDetailsObject(WebRequestDetails* details, Arg arg) {
   ToDictionary(details, arg);
 }
 
 template <typename Arg, typename... Args>
-void FillDetailsObject(base::DictionaryValue* details, Arg arg, Args... args) {
+void FillDetailsObject(WebRequestDetails* details, Arg arg, Args... args) {
   ToDictionary(details, arg);
   FillDetailsObject(details, args...);
 }
@@ -224,16 +209,16 @@ void ReadFromResponseObject(const base::DictionaryValue& response,
 }  // namespace
 
 AtomNetworkDelegate::SimpleListenerInfo::SimpleListenerInfo(
-    URLPatterns patterns_,
+    const URLPatterns& patterns_,
     SimpleListener listener_)
-    : url_patterns(patterns_), listener(listener_) {}
+    : url_matcher(patterns_), listener(listener_) {}
 AtomNetworkDelegate::SimpleListenerInfo::SimpleListenerInfo() = default;
 AtomNetworkDelegate::SimpleListenerInfo::~SimpleListenerInfo() = default;
 
 AtomNetworkDelegate::ResponseListenerInfo::ResponseListenerInfo(
-    URLPatterns patterns_,
+    const URLPatterns& patterns_,
     ResponseListener listener_)
-    : url_patterns(patterns_), listener(listener_) {}
+    : url_matcher(patterns_), listener(listener_) {}
 AtomNetworkDelegate::ResponseListenerInfo::ResponseListenerInfo() = default;
 AtomNetworkDelegate::ResponseListenerInfo::~ResponseListenerInfo() = default;
 
@@ -255,7 +240,7 @@ void AtomNetworkDelegate::SetSimpleListenerInIO(SimpleEvent type,
   if (callback.is_null())
     simple_listeners_.erase(type);
   else
-    simple_listeners_[type] = {std::move(patterns), std::move(callback)};
+    simple_listeners_[type] = {patterns, std::move(callback)};
 }
 
 void AtomNetworkDelegate::SetResponseListenerInIO(ResponseEvent type,
@@ -264,13 +249,26 @@ void AtomNetworkDelegate::SetResponseListenerInIO(ResponseEvent type,
   if (callback.is_null())
     response_listeners_.erase(type);
   else
-    response_listeners_[type] = {std::move(patterns), std::move(callback)};
+    response_listeners_[type] = {patterns, std::move(callback)};
+}
+
+void AtomNetworkDelegate::SetRulesInIO(WebRequestRules rules) {
+  rules_ = std::move(rules);
+}
+
+void AtomNetworkDelegate::SetRequestLogInIO(
+    std::unique_ptr<RequestLogWriter> request_log) {
+  request_log_ = std::move(request_log);
 }
 
 int AtomNetworkDelegate::OnBeforeURLRequest(
     net::URLRequest* request,
     net::CompletionOnceCallback callback,
     GURL* new_url) {
+  int result = ApplyRequestRules(rules_, request, new_url);
+  if (result != net::OK || !new_url->is_empty())
+    return result;
+
   if (!base::ContainsKey(response_listeners_, kOnBeforeRequest)) {
     for (const auto& domain : ignore_connections_limit_domains_) {
       if (request->url().DomainIs(domain)) {
@@ -291,6 +289,7 @@ int AtomNetworkDelegate::OnBeforeStartTransaction(
     net::URLRequest* request,
     net::CompletionOnceCallback callback,
     net::HttpRequestHeaders* headers) {
+  ApplyRequestHeaderRules(rules_, request, headers);
   if (!base::ContainsKey(response_listeners_, kOnBeforeSendHeaders))
     return net::OK;
 
@@ -313,12 +312,16 @@ int AtomNetworkDelegate::OnHeadersReceived(
     const net::HttpResponseHeaders* original,
     scoped_refptr<net::HttpResponseHeaders>* override,
     GURL* allowed) {
+  ApplyResponseHeaderRules(rules_, request, original, override);
   if (!base::ContainsKey(response_listeners_, kOnHeadersReceived))
     return net::OK;
 
+  // The listener sees the headers changed by the rules.
+  const net::HttpResponseHeaders* headers =
+      override->get() ? override->get() : original;
   return HandleResponseEvent(
       kOnHeadersReceived, request, std::move(callback),
-      std::make_pair(override, original->GetStatusLine()), original);
+      std::make_pair(override, headers->GetStatusLine()), headers);
 }
 
 void AtomNetworkDelegate::OnBeforeRedirect(net::URLRequest* request,
@@ -349,6 +352,28 @@ void AtomNetworkDelegate::OnCompleted(net::URLRequest* request,
   // OnCompleted may happen before other events.
   callbacks_.erase(request->identifier());
 
+  if (request_log_)
+    request_log_->OnRequestCompleted(request, net_error);
+
+  if (started && net_error == net::OK && !request->was_cached() &&
+      request->url().SchemeIsHTTPOrHTTPS()) {
+    net::LoadTimingInfo load_timing_info;
+    request->GetLoadTimingInfo(&load_timing_info);
+    ++network_request_count_;
+    if (load_timing_info.socket_reused)
+      ++reused_socket_count_;
+  }
+
+  if (started && net_error == net::OK && request->method() == "GET" &&
+      request->url().SchemeIsHTTPOrHTTPS() &&
+      !(request->load_flags() &
+        (net::LOAD_DISABLE_CACHE | net::LOAD_BYPASS_CACHE))) {
+    if (request->was_cached())
+      ++cache_hit_count_;
+    else
+      ++cache_miss_count_;
+  }
+
   if (request->status().status() == net::URLRequestStatus::FAILED ||
       request->status().status() == net::URLRequestStatus::CANCELED) {
     // Error event.
@@ -471,10 +496,10 @@ int AtomNetworkDelegate::HandleResponseEvent(
     Out out,
     Args... args) {
   const auto& info = response_listeners_[type];
-  if (!MatchesFilterCondition(request, info.url_patterns))
+  if (!info.url_matcher.MatchesURL(request->url()))
     return net::OK;
 
-  auto details = std::make_unique<base::DictionaryValue>();
+  auto details = std::make_unique<WebRequestDetails>();
   FillDetailsObject(details.get(), request, args...);
 
   int render_process_id, render_frame_id;
@@ -499,10 +524,10 @@ void AtomNetworkDelegate::HandleSimpleEvent(SimpleEvent type,
                                             net::URLRequest* request,
                                             Args... args) {
   const auto& info = simple_listeners_[type];
-  if (!MatchesFilterCondition(request, info.url_patterns))
+  if (!info.url_matcher.MatchesURL(request->url()))
     return;
 
-  auto details = std::make_unique<base::DictionaryValue>();
+  auto details = std::make_unique<WebRequestDetails>();
   FillDetailsObject(details.get(), request, args...);
 
   int render_process_id, render_frame_id;
@@ -11,6 +11,9 @@
 #include <string>
 #include <vector>
 
+#include "atom/browser/net/url_pattern_matcher.h"
+#include "atom/browser/net/web_request_details.h"
+#include "atom/browser/net/web_request_rule.h"
 #include "base/callback.h"
 #include "base/synchronization/lock.h"
 #include "base/values.h"
@@ -29,12 +32,13 @@ using URLPatterns = std::set<URLPattern>;
 const char* ResourceTypeToString(content::ResourceType type);
 
 class LoginHandler;
+class RequestLogWriter;
 
 class AtomNetworkDelegate : public net::NetworkDelegate {
  public:
   using ResponseCallback = base::Callback<void(const base::DictionaryValue&)>;
-  using SimpleListener = base::Callback<void(const base::DictionaryValue&)>;
-  using ResponseListener = base::Callback<void(const base::DictionaryValue&,
+  using SimpleListener = base::Callback<void(const WebRequestDetails&)>;
+  using ResponseListener = base::Callback<void(const WebRequestDetails&,
                                                const ResponseCallback&)>;
 
   enum SimpleEvent {
@@ -52,19 +56,19 @@ class AtomNetworkDelegate : public net::NetworkDelegate {
   };
 
   struct SimpleListenerInfo {
-    URLPatterns url_patterns;
+    URLPatternMatcher url_matcher;
     SimpleListener listener;
 
-    SimpleListenerInfo(URLPatterns, SimpleListener);
+    SimpleListenerInfo(const URLPatterns&, SimpleListener);
     SimpleListenerInfo();
     ~SimpleListenerInfo();
   };
 
   struct ResponseListenerInfo {
-    URLPatterns url_patterns;
+    URLPatternMatcher url_matcher;
     ResponseListener listener;
 
-    ResponseListenerInfo(URLPatterns, ResponseListener);
+    ResponseListenerInfo(const URLPatterns&, ResponseListener);
     ResponseListenerInfo();
     ~ResponseListenerInfo();
   };
@@ -78,6 +82,21 @@ class AtomNetworkDelegate : public net::NetworkDelegate {
   void SetResponseListenerInIO(ResponseEvent type,
                                URLPatterns patterns,
                                ResponseListener callback);
+  // The rules are evaluated before the listeners of the same event.
+  void SetRulesInIO(WebRequestRules rules);
+  // Logs the completed requests without involving the listeners, nullptr
+  // stops logging.
+  void SetRequestLogInIO(std::unique_ptr<RequestLogWriter> request_log);
+
+  // The HTTP(S) requests that completed over the network, and how many of
+  // them reused a socket or an HTTP/2 session.
+  int network_request_count() const { return network_request_count_; }
+  int reused_socket_count() const { return reused_socket_count_; }
+
+  // The completed GET requests that were served from the HTTP cache, and the
+  // ones that could have been but went to the network.
+  int cache_hit_count() const { return cache_hit_count_; }
+  int cache_miss_count() const { return cache_miss_count_; }
 
  protected:
   // net::NetworkDelegate:
@@ -170,7 +189,13 @@ class AtomNetworkDelegate : public net::NetworkDelegate {
   std::map<SimpleEvent, SimpleListenerInfo> simple_listeners_;
   std::map<ResponseEvent, ResponseListenerInfo> response_listeners_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  WebRequestRules rules_;
+  std::unique_ptr<RequestLogWriter> request_log_;
   std::vector<std::string> ignore_connections_limit_domains_;
+  int network_request_count_ = 0;
+  int reused_socket_count_ = 0;
+  int cache_hit_count_ = 0;
+  int cache_miss_count_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(AtomNetworkDelegate);
 };
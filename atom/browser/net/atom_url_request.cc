@@ -13,6 +13,8 @@
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/net/atom_url_request_job_factory.h"
 #include "base/callback.h"
+#include "base/task_runner_util.h"
+#include "base/task_scheduler/post_task.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/elements_upload_data_stream.h"
 #include "net/base/io_buffer.h"
@@ -21,7 +23,36 @@
 #include "net/url_request/redirect_info.h"
 
 namespace {
-const int kBufferSize = 4096;
+
+// Reading pauses while this much of the response waits to be written to the
+// file, so a slow disk doesn't end up with the whole download in memory.
+const int kMaxPendingWriteSize = 4 * 1024 * 1024;
+
+const char kFileWriteError[] = "Failed to write the response to the file.";
+
+// Runs on the file task runner.
+bool OpenFile(base::File* file, const base::FilePath& path) {
+  if (!file->IsValid())
+    file->Initialize(path,
+                     base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  return file->IsValid();
+}
+
+bool WriteToFile(base::File* file,
+                 const base::FilePath& path,
+                 scoped_refptr<net::IOBuffer> buffer,
+                 int size) {
+  return OpenFile(file, path) &&
+         file->WriteAtCurrentPos(buffer->data(), size) == size;
+}
+
+bool CloseFile(base::File* file, const base::FilePath& path) {
+  // An empty response still creates the file.
+  bool success = OpenFile(file, path);
+  file->Close();
+  return success;
+}
+
 }  // namespace
 
 namespace atom {
@@ -50,9 +81,21 @@ class UploadOwnedIOBufferElementReader : public net::UploadBytesElementReader {
 
 }  // namespace internal
 
-AtomURLRequest::AtomURLRequest(api::URLRequest* delegate)
+AtomURLRequest::AtomURLRequest(api::URLRequest* delegate,
+                               int buffer_size,
+                               const base::FilePath& save_path)
     : delegate_(delegate),
-      response_read_buffer_(new net::IOBuffer(kBufferSize)) {}
+      buffer_size_(buffer_size),
+      save_path_(save_path),
+      file_(nullptr, base::OnTaskRunnerDeleter(nullptr)) {
+  if (!save_path_.empty()) {
+    file_task_runner_ = base::CreateSequencedTaskRunnerWithTraits(
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+    file_ = std::unique_ptr<base::File, base::OnTaskRunnerDeleter>(
+        new base::File, base::OnTaskRunnerDeleter(file_task_runner_));
+  }
+}
 
 AtomURLRequest::~AtomURLRequest() {
   DCHECK(!request_context_getter_);
@@ -64,10 +107,13 @@ scoped_refptr<AtomURLRequest> AtomURLRequest::Create(
     const std::string& method,
     const std::string& url,
     const std::string& redirect_policy,
+    int buffer_size,
+    const base::FilePath& save_path,
     api::URLRequest* delegate) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
   DCHECK(browser_context);
+  DCHECK_GT(buffer_size, 0);
   DCHECK(!url.empty());
   DCHECK(delegate);
   if (!browser_context || url.empty() || !delegate) {
@@ -76,7 +122,8 @@ scoped_refptr<AtomURLRequest> AtomURLRequest::Create(
   scoped_refptr<net::URLRequestContextGetter> request_context_getter(
       browser_context->GetRequestContext());
   DCHECK(request_context_getter);
-  scoped_refptr<AtomURLRequest> atom_url_request(new AtomURLRequest(delegate));
+  scoped_refptr<AtomURLRequest> atom_url_request(
+      new AtomURLRequest(delegate, buffer_size, save_path));
   if (content::BrowserThread::PostTask(
           content::BrowserThread::IO, FROM_HERE,
           base::BindOnce(&AtomURLRequest::DoInitialize, atom_url_request,
@@ -205,6 +252,13 @@ void AtomURLRequest::SetLoadFlags(int flags) const {
       base::BindOnce(&AtomURLRequest::DoSetLoadFlags, this, flags));
 }
 
+void AtomURLRequest::SetPriority(net::RequestPriority priority) const {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  content::BrowserThread::PostTask(
+      content::BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&AtomURLRequest::DoSetPriority, this, priority));
+}
+
 void AtomURLRequest::DoWriteBuffer(
     scoped_refptr<const net::IOBufferWithSize> buffer,
     bool is_last) {
@@ -323,6 +377,16 @@ void AtomURLRequest::DoSetLoadFlags(int flags) const {
   request_->SetLoadFlags(request_->load_flags() | flags);
 }
 
+void AtomURLRequest::DoSetPriority(net::RequestPriority priority) const {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  if (!request_) {
+    return;
+  }
+  // Also reorders the request in the queue of its socket pool group when it
+  // is waiting for a connection.
+  request_->SetPriority(priority);
+}
+
 void AtomURLRequest::OnReceivedRedirect(net::URLRequest* request,
                                         const net::RedirectInfo& info,
                                         bool* defer_redirect) {
@@ -385,11 +449,20 @@ void AtomURLRequest::ReadResponse() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
 
   int bytes_read = -1;
-  if (request_->Read(response_read_buffer_.get(), kBufferSize, &bytes_read)) {
+  if (ReadBuffer(&bytes_read)) {
     OnReadCompleted(request_.get(), bytes_read);
   }
 }
 
+bool AtomURLRequest::ReadBuffer(int* bytes_read) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+
+  // The previous buffer is gone when it was handed over by PostBuffer.
+  if (!response_read_buffer_)
+    response_read_buffer_ = new net::IOBuffer(buffer_size_);
+  return request_->Read(response_read_buffer_.get(), buffer_size_, bytes_read);
+}
+
 void AtomURLRequest::OnReadCompleted(net::URLRequest* request, int bytes_read) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
   if (!request_) {
@@ -419,18 +492,32 @@ void AtomURLRequest::OnReadCompleted(net::URLRequest* request, int bytes_read) {
       data_ended = true;
       break;
     }
-    if (bytes_read < 0 || !CopyAndPostBuffer(bytes_read)) {
+    if (bytes_read < 0 || !PostBuffer(bytes_read)) {
       data_transfer_error = true;
       break;
     }
-  } while (
-      request_->Read(response_read_buffer_.get(), kBufferSize, &bytes_read));
+    if (pending_write_size_ >= kMaxPendingWriteSize) {
+      // OnFileWritten resumes reading.
+      read_paused_ = true;
+      break;
+    }
+  } while (ReadBuffer(&bytes_read));
   if (response_error) {
     DoCancelWithError(net::ErrorToString(status.ToNetError()), false);
   } else if (data_ended) {
-    content::BrowserThread::PostTask(
-        content::BrowserThread::UI, FROM_HERE,
-        base::BindOnce(&AtomURLRequest::InformDelegateResponseCompleted, this));
+    if (file_) {
+      // The delegate is informed once all the data is in the file.
+      base::PostTaskAndReplyWithResult(
+          file_task_runner_.get(), FROM_HERE,
+          base::BindOnce(&CloseFile, base::Unretained(file_.get()),
+                         save_path_),
+          base::BindOnce(&AtomURLRequest::OnFileClosed, this));
+    } else {
+      content::BrowserThread::PostTask(
+          content::BrowserThread::UI, FROM_HERE,
+          base::BindOnce(&AtomURLRequest::InformDelegateResponseCompleted,
+                         this));
+    }
     DoTerminate();
   } else if (data_transfer_error) {
     // We abort the request on corrupted data transfer.
@@ -443,18 +530,68 @@ void AtomURLRequest::OnContextShuttingDown() {
   DoCancel();
 }
 
-bool AtomURLRequest::CopyAndPostBuffer(int bytes_read) {
+bool AtomURLRequest::PostBuffer(int bytes_read) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
 
-  // data is only a wrapper for the asynchronous response_read_buffer_.
-  // Make a deep copy of payload and transfer ownership to the UI thread.
-  auto buffer_copy = WrapRefCounted(new net::IOBufferWithSize(bytes_read));
-  memcpy(buffer_copy->data(), response_read_buffer_->data(), bytes_read);
+  // The read buffer is handed over as it is, and a new one is allocated for
+  // the next read. Only reads that leave most of the buffer unused are
+  // copied, so a small chunk doesn't keep a large buffer alive in JavaScript.
+  scoped_refptr<net::IOBuffer> buffer;
+  if (!file_ && bytes_read * 2 < buffer_size_) {
+    buffer = new net::IOBuffer(bytes_read);
+    memcpy(buffer->data(), response_read_buffer_->data(), bytes_read);
+  } else {
+    buffer = std::move(response_read_buffer_);
+  }
+
+  if (file_) {
+    // |file_| is deleted on the file task runner, after this task.
+    pending_write_size_ += bytes_read;
+    return base::PostTaskAndReplyWithResult(
+        file_task_runner_.get(), FROM_HERE,
+        base::BindOnce(&WriteToFile, base::Unretained(file_.get()), save_path_,
+                       buffer, bytes_read),
+        base::BindOnce(&AtomURLRequest::OnFileWritten, this, bytes_read));
+  }
 
   return content::BrowserThread::PostTask(
       content::BrowserThread::UI, FROM_HERE,
-      base::BindOnce(&AtomURLRequest::InformDelegateResponseData, this,
-                     buffer_copy));
+      base::BindOnce(&AtomURLRequest::InformDelegateResponseData, this, buffer,
+                     bytes_read));
+}
+
+void AtomURLRequest::OnFileWritten(int size, bool success) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  pending_write_size_ -= size;
+  if (file_error_)
+    return;
+
+  if (!success) {
+    file_error_ = true;
+    DoCancelWithError(kFileWriteError, false);
+    return;
+  }
+
+  if (read_paused_ && request_ && pending_write_size_ < kMaxPendingWriteSize) {
+    read_paused_ = false;
+    ReadResponse();
+  }
+}
+
+void AtomURLRequest::OnFileClosed(bool success) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  if (file_error_)
+    return;
+
+  if (!success) {
+    file_error_ = true;
+    DoCancelWithError(kFileWriteError, false);
+    return;
+  }
+
+  content::BrowserThread::PostTask(
+      content::BrowserThread::UI, FROM_HERE,
+      base::BindOnce(&AtomURLRequest::InformDelegateResponseCompleted, this));
 }
 
 void AtomURLRequest::InformDelegateReceivedRedirect(
@@ -482,13 +619,14 @@ void AtomURLRequest::InformDelegateResponseStarted(
 }
 
 void AtomURLRequest::InformDelegateResponseData(
-    scoped_refptr<net::IOBufferWithSize> data) const {
+    scoped_refptr<net::IOBuffer> data,
+    int size) const {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
   // Transfer ownership of the data buffer, data will be released
   // by the delegate's OnResponseData.
   if (delegate_)
-    delegate_->OnResponseData(data);
+    delegate_->OnResponseData(data, size);
 }
 
 void AtomURLRequest::InformDelegateResponseCompleted() const {
@@ -12,11 +12,15 @@
 
 #include "atom/browser/api/atom_api_url_request.h"
 #include "atom/browser/atom_browser_context.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "net/base/auth.h"
 #include "net/base/chunked_upload_data_stream.h"
 #include "net/base/io_buffer.h"
+#include "net/base/request_priority.h"
 #include "net/base/upload_element_reader.h"
 #include "net/http/http_response_headers.h"
 #include "net/url_request/url_request.h"
@@ -33,6 +37,8 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
       const std::string& method,
       const std::string& url,
       const std::string& redirect_policy,
+      int buffer_size,
+      const base::FilePath& save_path,
       api::URLRequest* delegate);
   void Terminate();
 
@@ -45,6 +51,7 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
   void PassLoginInformation(const base::string16& username,
                             const base::string16& password) const;
   void SetLoadFlags(int flags) const;
+  void SetPriority(net::RequestPriority priority) const;
   void GetUploadProgress(mate::Dictionary* progress) const;
 
  protected:
@@ -63,7 +70,9 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
  private:
   friend class base::RefCountedThreadSafe<AtomURLRequest>;
 
-  explicit AtomURLRequest(api::URLRequest* delegate);
+  AtomURLRequest(api::URLRequest* delegate,
+                 int buffer_size,
+                 const base::FilePath& save_path);
   ~AtomURLRequest() override;
 
   void DoInitialize(scoped_refptr<net::URLRequestContextGetter>,
@@ -83,9 +92,13 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
   void DoCancelAuth() const;
   void DoCancelWithError(const std::string& error, bool isRequestError);
   void DoSetLoadFlags(int flags) const;
+  void DoSetPriority(net::RequestPriority priority) const;
 
   void ReadResponse();
-  bool CopyAndPostBuffer(int bytes_read);
+  bool ReadBuffer(int* bytes_read);
+  bool PostBuffer(int bytes_read);
+  void OnFileWritten(int size, bool success);
+  void OnFileClosed(bool success);
 
   void InformDelegateReceivedRedirect(
       int status_code,
@@ -96,8 +109,8 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
       scoped_refptr<net::AuthChallengeInfo> auth_info) const;
   void InformDelegateResponseStarted(
       scoped_refptr<net::HttpResponseHeaders>) const;
-  void InformDelegateResponseData(
-      scoped_refptr<net::IOBufferWithSize> data) const;
+  void InformDelegateResponseData(scoped_refptr<net::IOBuffer> data,
+                                  int size) const;
   void InformDelegateResponseCompleted() const;
   void InformDelegateErrorOccured(const std::string& error,
                                   bool isRequestError) const;
@@ -113,6 +126,16 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
   std::vector<std::unique_ptr<net::UploadElementReader>>
       upload_element_readers_;
   scoped_refptr<net::IOBuffer> response_read_buffer_;
+  const int buffer_size_;
+
+  // When |save_path_| is set the response body is written to it on
+  // |file_task_runner_| instead of being sent to the delegate.
+  const base::FilePath save_path_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  std::unique_ptr<base::File, base::OnTaskRunnerDeleter> file_;
+  int pending_write_size_ = 0;
+  bool read_paused_ = false;
+  bool file_error_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(AtomURLRequest);
 };
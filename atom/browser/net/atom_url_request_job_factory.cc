@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "atom/browser/net/file_protocol_rules.h"
 #include "base/memory/ptr_util.h"
 #include "base/stl_util.h"
 #include "content/public/browser/browser_thread.h"
@@ -50,6 +51,7 @@ bool AtomURLRequestJobFactory::SetProtocolHandler(
 
     delete it->second;
     protocol_handler_map_.erase(it);
+    file_protocol_rules_.erase(scheme);
     return true;
   }
 
@@ -85,11 +87,21 @@ bool AtomURLRequestJobFactory::HasProtocolHandler(
   return base::ContainsKey(protocol_handler_map_, scheme);
 }
 
+void AtomURLRequestJobFactory::SetFileProtocolRules(
+    const std::string& scheme,
+    std::unique_ptr<FileProtocolRules> rules) {
+  if (rules)
+    file_protocol_rules_[scheme] = std::move(rules);
+  else
+    file_protocol_rules_.erase(scheme);
+}
+
 void AtomURLRequestJobFactory::Clear() {
   for (auto& it : protocol_handler_map_)
     delete it.second;
   protocol_handler_map_.clear();
   original_protocols_.clear();
+  file_protocol_rules_.clear();
 }
 
 net::URLRequestJob* AtomURLRequestJobFactory::MaybeCreateJobWithProtocolHandler(
@@ -110,6 +122,13 @@ net::URLRequestJob* AtomURLRequestJobFactory::MaybeCreateJobWithProtocolHandler(
   if (request->GetUserData(DisableProtocolInterceptFlagKey()))
     return nullptr;
 
+  auto rules = file_protocol_rules_.find(scheme);
+  if (rules != file_protocol_rules_.end()) {
+    job = rules->second->MaybeCreateJob(request, network_delegate);
+    if (job)
+      return job;
+  }
+
   return it->second->MaybeCreateJob(request, network_delegate);
 }
 
@@ -16,6 +16,8 @@
 
 namespace atom {
 
+class FileProtocolRules;
+
 const void* DisableProtocolInterceptFlagKey();
 
 class AtomURLRequestJobFactory : public net::URLRequestJobFactory {
@@ -40,6 +42,12 @@ class AtomURLRequestJobFactory : public net::URLRequestJobFactory {
   // Whether the protocol handler is registered by the job factory.
   bool HasProtocolHandler(const std::string& scheme) const;
 
+  // Sets the rules that are evaluated before the protocol handler of
+  // |scheme|, passing nullptr removes them. The rules are also removed when
+  // the protocol handler is unregistered.
+  void SetFileProtocolRules(const std::string& scheme,
+                            std::unique_ptr<FileProtocolRules> rules);
+
   // Clear all protocol handlers.
   void Clear();
 
@@ -69,6 +77,10 @@ class AtomURLRequestJobFactory : public net::URLRequestJobFactory {
   // Can only be accessed in IO thread.
   OriginalProtocolsMap original_protocols_;
 
+  // Can only be accessed in IO thread.
+  std::map<std::string, std::unique_ptr<FileProtocolRules>>
+      file_protocol_rules_;
+
   std::unique_ptr<net::URLRequestJobFactory> job_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(AtomURLRequestJobFactory);
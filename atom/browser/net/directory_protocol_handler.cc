@@ -0,0 +1,86 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/directory_protocol_handler.h"
+
+#include <string>
+
+#include "atom/browser/net/asar/url_request_asar_job.h"
+#include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/task_runner.h"
+#include "net/base/escape.h"
+#include "net/base/net_errors.h"
+#include "net/url_request/url_request.h"
+#include "net/url_request/url_request_error_job.h"
+
+namespace atom {
+
+void SplitHostAndPath(const GURL& url, std::string* host, std::string* path) {
+  *host = url.host();
+  *path = url.path();
+  if (!url.IsStandard() &&
+      base::StartsWith(*path, "//", base::CompareCase::SENSITIVE)) {
+    size_t end_of_host = path->find('/', 2);
+    *host = path->substr(2, end_of_host == std::string::npos
+                                ? std::string::npos
+                                : end_of_host - 2);
+    *path = end_of_host == std::string::npos ? std::string()
+                                             : path->substr(end_of_host);
+  }
+}
+
+bool ResolvePathInDirectory(const base::FilePath& directory,
+                            const std::string& url_path,
+                            base::FilePath* file_path) {
+  std::string path = net::UnescapeURLComponent(
+      url_path,
+      net::UnescapeRule::SPACES |
+          net::UnescapeRule::URL_SPECIAL_CHARS_EXCEPT_PATH_SEPARATORS);
+  base::TrimString(path, "/", &path);
+  if (path.empty())
+    path = "index.html";
+  else if (base::EndsWith(url_path, "/", base::CompareCase::SENSITIVE))
+    path += "/index.html";
+
+#if defined(OS_WIN)
+  base::FilePath relative_path(base::UTF8ToUTF16(path));
+#else
+  base::FilePath relative_path(path);
+#endif
+  if (relative_path.IsAbsolute() || relative_path.ReferencesParent())
+    return false;
+
+  *file_path = directory.Append(relative_path);
+  return true;
+}
+
+DirectoryProtocolHandler::DirectoryProtocolHandler(
+    const base::FilePath& directory,
+    const scoped_refptr<base::TaskRunner>& file_task_runner)
+    : directory_(directory), file_task_runner_(file_task_runner) {}
+
+DirectoryProtocolHandler::~DirectoryProtocolHandler() = default;
+
+net::URLRequestJob* DirectoryProtocolHandler::MaybeCreateJob(
+    net::URLRequest* request,
+    net::NetworkDelegate* network_delegate) const {
+  std::string host, url_path;
+  SplitHostAndPath(request->url(), &host, &url_path);
+  base::FilePath file_path;
+  if (!ResolvePathInDirectory(directory_, url_path, &file_path))
+    return new net::URLRequestErrorJob(request, network_delegate,
+                                       net::ERR_ACCESS_DENIED);
+
+  auto* job = new asar::URLRequestAsarJob(request, network_delegate);
+  job->Initialize(file_task_runner_, file_path);
+  return job;
+}
+
+bool DirectoryProtocolHandler::IsSafeRedirectTarget(
+    const GURL& location) const {
+  return false;
+}
+
+}  // namespace atom
@@ -0,0 +1,61 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_DIRECTORY_PROTOCOL_HANDLER_H_
+#define ATOM_BROWSER_NET_DIRECTORY_PROTOCOL_HANDLER_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "net/url_request/url_request_job_factory.h"
+#include "url/gurl.h"
+
+namespace base {
+class TaskRunner;
+}
+
+namespace atom {
+
+// Splits |url| into its host and path, the host is part of the path of the
+// schemes that are not standard.
+void SplitHostAndPath(const GURL& url, std::string* host, std::string* path);
+
+// Resolves the URL path |url_path| against |directory|, paths ending with "/"
+// map to their "index.html". Returns false when the path is outside of
+// |directory|.
+bool ResolvePathInDirectory(const base::FilePath& directory,
+                            const std::string& url_path,
+                            base::FilePath* file_path);
+
+// Serves the files of a directory, or of an asar archive, without running any
+// JavaScript: the path of the URL is resolved on the IO thread and the file
+// is read on |file_task_runner|. This is not a way to run handler scripts off
+// the main thread, the JavaScript handlers of the other protocols still run
+// on the UI thread of the main process. "scheme://host/a/b.js" maps to
+// "directory/a/b.js", and paths ending with "/" map to their "index.html".
+class DirectoryProtocolHandler
+    : public net::URLRequestJobFactory::ProtocolHandler {
+ public:
+  DirectoryProtocolHandler(
+      const base::FilePath& directory,
+      const scoped_refptr<base::TaskRunner>& file_task_runner);
+  ~DirectoryProtocolHandler() override;
+
+  // net::URLRequestJobFactory::ProtocolHandler:
+  net::URLRequestJob* MaybeCreateJob(
+      net::URLRequest* request,
+      net::NetworkDelegate* network_delegate) const override;
+  bool IsSafeRedirectTarget(const GURL& location) const override;
+
+ private:
+  const base::FilePath directory_;
+  const scoped_refptr<base::TaskRunner> file_task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(DirectoryProtocolHandler);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_DIRECTORY_PROTOCOL_HANDLER_H_
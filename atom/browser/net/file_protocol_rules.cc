@@ -0,0 +1,105 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/file_protocol_rules.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "atom/browser/net/asar/url_request_asar_job.h"
+#include "atom/browser/net/directory_protocol_handler.h"
+#include "base/strings/string_util.h"
+#include "base/task_runner.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_response_info.h"
+#include "net/url_request/url_request.h"
+#include "net/url_request/url_request_error_job.h"
+
+namespace atom {
+
+namespace {
+
+// Serves a file with the MIME type and headers of the rule that matched.
+class URLRequestMappedFileJob : public asar::URLRequestAsarJob {
+ public:
+  URLRequestMappedFileJob(net::URLRequest* request,
+                          net::NetworkDelegate* network_delegate,
+                          const FileProtocolRule& rule)
+      : asar::URLRequestAsarJob(request, network_delegate),
+        mime_type_(rule.mime_type),
+        headers_(rule.headers) {}
+
+  // net::URLRequestJob:
+  bool GetMimeType(std::string* mime_type) const override {
+    if (mime_type_.empty())
+      return asar::URLRequestAsarJob::GetMimeType(mime_type);
+    *mime_type = mime_type_;
+    return true;
+  }
+
+  void GetResponseInfo(net::HttpResponseInfo* info) override {
+    asar::URLRequestAsarJob::GetResponseInfo(info);
+    for (const auto& header : headers_)
+      info->headers->AddHeader(header.first + ": " + header.second);
+  }
+
+ private:
+  ~URLRequestMappedFileJob() override {}
+
+  const std::string mime_type_;
+  const std::vector<std::pair<std::string, std::string>> headers_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLRequestMappedFileJob);
+};
+
+bool MatchesPathPrefix(const std::string& path, const std::string& prefix) {
+  return base::StartsWith(path, prefix, base::CompareCase::SENSITIVE) ||
+         path + "/" == prefix;
+}
+
+}  // namespace
+
+FileProtocolRule::FileProtocolRule() = default;
+FileProtocolRule::FileProtocolRule(const FileProtocolRule&) = default;
+FileProtocolRule::~FileProtocolRule() = default;
+
+FileProtocolRules::FileProtocolRules(
+    const std::vector<FileProtocolRule>& rules,
+    const scoped_refptr<base::TaskRunner>& file_task_runner)
+    : rules_(rules), file_task_runner_(file_task_runner) {}
+
+FileProtocolRules::~FileProtocolRules() = default;
+
+net::URLRequestJob* FileProtocolRules::MaybeCreateJob(
+    net::URLRequest* request,
+    net::NetworkDelegate* network_delegate) const {
+  std::string host, url_path;
+  SplitHostAndPath(request->url(), &host, &url_path);
+
+  for (const auto& rule : rules_) {
+    if (!rule.host.empty() && rule.host != host)
+      continue;
+    if (!MatchesPathPrefix(url_path, rule.path_prefix))
+      continue;
+
+    base::FilePath file_path;
+    std::string relative_path =
+        url_path.size() > rule.path_prefix.size()
+            ? url_path.substr(rule.path_prefix.size())
+            : std::string();
+    if (!ResolvePathInDirectory(rule.directory, relative_path, &file_path)) {
+      return new net::URLRequestErrorJob(request, network_delegate,
+                                         net::ERR_ACCESS_DENIED);
+    }
+
+    auto* job = new URLRequestMappedFileJob(request, network_delegate, rule);
+    job->Initialize(file_task_runner_, file_path);
+    return job;
+  }
+  return nullptr;
+}
+
+}  // namespace atom
@@ -0,0 +1,68 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_FILE_PROTOCOL_RULES_H_
+#define ATOM_BROWSER_NET_FILE_PROTOCOL_RULES_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+
+namespace base {
+class TaskRunner;
+}
+
+namespace net {
+class NetworkDelegate;
+class URLRequest;
+class URLRequestJob;
+}  // namespace net
+
+namespace atom {
+
+// Maps the URLs of a host and path prefix to the files of a directory, or of
+// an asar archive.
+struct FileProtocolRule {
+  FileProtocolRule();
+  FileProtocolRule(const FileProtocolRule&);
+  ~FileProtocolRule();
+
+  // Empty to match any host.
+  std::string host;
+  // Always ends with "/".
+  std::string path_prefix = "/";
+  base::FilePath directory;
+  // Overrides the MIME type derived from the file extension when not empty.
+  std::string mime_type;
+  std::vector<std::pair<std::string, std::string>> headers;
+};
+
+// The rules of a scheme, they are evaluated on the IO thread before its
+// protocol handler so the matching requests are answered without asking
+// JavaScript for the file path.
+class FileProtocolRules {
+ public:
+  FileProtocolRules(const std::vector<FileProtocolRule>& rules,
+                    const scoped_refptr<base::TaskRunner>& file_task_runner);
+  ~FileProtocolRules();
+
+  // Returns the job of the first rule that matches |request|, or nullptr when
+  // none does.
+  net::URLRequestJob* MaybeCreateJob(
+      net::URLRequest* request,
+      net::NetworkDelegate* network_delegate) const;
+
+ private:
+  const std::vector<FileProtocolRule> rules_;
+  const scoped_refptr<base::TaskRunner> file_task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileProtocolRules);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_FILE_PROTOCOL_RULES_H_
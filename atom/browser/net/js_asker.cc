@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "atom/common/native_mate_converters/callback.h"
+#include "base/trace_event/trace_event.h"
 
 namespace atom {
 
@@ -17,10 +18,12 @@ JsAsker::~JsAsker() = default;
 void JsAsker::SetHandlerInfo(
     v8::Isolate* isolate,
     net::URLRequestContextGetter* request_context_getter,
-    const JavaScriptHandler& handler) {
+    const JavaScriptHandler& handler,
+    ProtocolResponseCache* response_cache) {
   isolate_ = isolate;
   request_context_getter_ = request_context_getter;
   handler_ = handler;
+  response_cache_ = response_cache;
 }
 
 // static
@@ -30,6 +33,7 @@ void JsAsker::AskForOptions(
     std::unique_ptr<base::DictionaryValue> request_details,
     const BeforeStartCallback& before_start) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  TRACE_EVENT0("electron", "JsAsker::AskForOptions");
   v8::Locker locker(isolate);
   v8::HandleScope handle_scope(isolate);
   v8::Local<v8::Context> context = isolate->GetCurrentContext();
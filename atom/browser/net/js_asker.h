@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "atom/browser/net/protocol_response_cache.h"
 #include "base/callback.h"
 #include "base/values.h"
 #include "native_mate/arguments.h"
@@ -27,7 +28,8 @@ class JsAsker {
   // Called by |CustomProtocolHandler| to store handler related information.
   void SetHandlerInfo(v8::Isolate* isolate,
                       net::URLRequestContextGetter* request_context_getter,
-                      const JavaScriptHandler& handler);
+                      const JavaScriptHandler& handler,
+                      ProtocolResponseCache* response_cache);
 
   // Ask handler for options in UI thread.
   static void AskForOptions(
@@ -44,11 +46,14 @@ class JsAsker {
   }
   v8::Isolate* isolate() { return isolate_; }
   JavaScriptHandler handler() { return handler_; }
+  // Shared by the jobs of the same protocol handler.
+  ProtocolResponseCache* response_cache() { return response_cache_.get(); }
 
  private:
   v8::Isolate* isolate_;
   net::URLRequestContextGetter* request_context_getter_;
   JavaScriptHandler handler_;
+  scoped_refptr<ProtocolResponseCache> response_cache_;
 
   DISALLOW_COPY_AND_ASSIGN(JsAsker);
 };
@@ -0,0 +1,96 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/protocol_response_cache.h"
+
+#include "base/values.h"
+#include "net/url_request/url_request.h"
+
+namespace atom {
+
+namespace {
+
+// Enough for the static assets of an app, which is what the cache is for.
+const size_t kMaxSize = 64 * 1024 * 1024;
+
+bool IsCacheable(const net::URLRequest* request) {
+  return request->method() == "GET" && !request->get_upload();
+}
+
+}  // namespace
+
+ProtocolResponseCache::Response::Response() = default;
+
+ProtocolResponseCache::Response::Response(const Response& other) = default;
+
+ProtocolResponseCache::Response::~Response() = default;
+
+ProtocolResponseCache::ProtocolResponseCache()
+    : entries_(base::MRUCache<std::string, Entry>::NO_AUTO_EVICT) {}
+
+ProtocolResponseCache::~ProtocolResponseCache() = default;
+
+bool ProtocolResponseCache::Get(const net::URLRequest* request,
+                                Response* response) {
+  if (entries_.empty() || !IsCacheable(request))
+    return false;
+
+  auto it = entries_.Get(request->url().spec());
+  if (it == entries_.end())
+    return false;
+
+  if (it->second.expires <= base::TimeTicks::Now()) {
+    size_ -= it->second.response.data->size();
+    entries_.Erase(it);
+    return false;
+  }
+
+  *response = it->second.response;
+  return true;
+}
+
+void ProtocolResponseCache::PutFromOptions(const net::URLRequest* request,
+                                           const base::Value& options,
+                                           Response* response) {
+  if (!options.is_dict() || !response->data || !IsCacheable(request))
+    return;
+
+  const base::Value* cache = options.FindKey("cache");
+  if (!cache || !cache->is_dict())
+    return;
+
+  const base::Value* etag = cache->FindKey("etag");
+  if (etag && etag->is_string())
+    response->etag = etag->GetString();
+
+  const base::Value* max_age = cache->FindKey("maxAge");
+  if (!max_age || !(max_age->is_int() || max_age->is_double()) ||
+      max_age->GetDouble() <= 0 || response->data->size() > kMaxSize)
+    return;
+
+  std::string key = request->url().spec();
+  auto it = entries_.Peek(key);
+  if (it != entries_.end()) {
+    size_ -= it->second.response.data->size();
+    entries_.Erase(it);
+  }
+
+  Entry entry;
+  entry.response = *response;
+  entry.expires = base::TimeTicks::Now() +
+                  base::TimeDelta::FromSecondsD(max_age->GetDouble());
+  size_ += response->data->size();
+  entries_.Put(key, entry);
+  Shrink();
+}
+
+void ProtocolResponseCache::Shrink() {
+  while (size_ > kMaxSize && !entries_.empty()) {
+    auto oldest = entries_.rbegin();
+    size_ -= oldest->second.response.data->size();
+    entries_.Erase(oldest);
+  }
+}
+
+}  // namespace atom
@@ -0,0 +1,73 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+#define ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/time/time.h"
+
+namespace base {
+class Value;
+}
+
+namespace net {
+class URLRequest;
+}
+
+namespace atom {
+
+// Responses of a custom protocol handler that it marked as cacheable. The
+// cache is only used on the IO thread, and answers repeated GET requests
+// of the same URL without asking the handler again.
+class ProtocolResponseCache : public base::RefCounted<ProtocolResponseCache> {
+ public:
+  struct Response {
+    Response();
+    Response(const Response& other);
+    ~Response();
+
+    std::string mime_type;
+    std::string charset;
+    std::string etag;
+    scoped_refptr<base::RefCountedMemory> data;
+  };
+
+  ProtocolResponseCache();
+
+  // Returns false when there is no fresh response cached for |request|.
+  bool Get(const net::URLRequest* request, Response* response);
+
+  // Caches |response| when the |options| passed to the handler's callback
+  // have a "cache" object with a positive "maxAge" in seconds. The "etag" of
+  // the object is stored in |response|.
+  void PutFromOptions(const net::URLRequest* request,
+                      const base::Value& options,
+                      Response* response);
+
+ private:
+  friend class base::RefCounted<ProtocolResponseCache>;
+
+  struct Entry {
+    Response response;
+    base::TimeTicks expires;
+  };
+
+  ~ProtocolResponseCache();
+
+  void Shrink();
+
+  base::MRUCache<std::string, Entry> entries_;
+  size_t size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtocolResponseCache);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
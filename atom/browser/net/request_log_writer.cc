@@ -0,0 +1,223 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/request_log_writer.h"
+
+#include <utility>
+
+#include "atom/browser/net/atom_network_delegate.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/json/json_writer.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/values.h"
+#include "content/public/browser/resource_request_info.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_response_headers.h"
+#include "net/url_request/url_request.h"
+
+namespace atom {
+
+namespace {
+
+// How long the lines are collected before they are written.
+constexpr base::TimeDelta kFlushInterval = base::TimeDelta::FromSeconds(1);
+
+// The lines are written right away when there are more than this.
+const size_t kMaxPendingBytes = 64 * 1024;
+
+const struct {
+  const char* name;
+  RequestLogWriter::Field field;
+} kFieldNames[] = {
+    {"id", RequestLogWriter::Field::kId},
+    {"timestamp", RequestLogWriter::Field::kTimestamp},
+    {"method", RequestLogWriter::Field::kMethod},
+    {"url", RequestLogWriter::Field::kUrl},
+    {"referrer", RequestLogWriter::Field::kReferrer},
+    {"resourceType", RequestLogWriter::Field::kResourceType},
+    {"statusCode", RequestLogWriter::Field::kStatusCode},
+    {"fromCache", RequestLogWriter::Field::kFromCache},
+    {"ip", RequestLogWriter::Field::kIp},
+    {"error", RequestLogWriter::Field::kError},
+};
+
+}  // namespace
+
+// Appends to the log file and rotates it, used on the file sequence only.
+class RequestLogWriter::LogFile {
+ public:
+  LogFile(const base::FilePath& path, int64_t max_file_size, int max_files)
+      : path_(path), max_file_size_(max_file_size), max_files_(max_files) {}
+
+  void Append(const std::string& lines) {
+    if (!file_.IsValid() && !Open())
+      return;
+    if (size_ > 0 &&
+        size_ + static_cast<int64_t>(lines.size()) > max_file_size_) {
+      Rotate();
+      if (!Open())
+        return;
+    }
+    int written = file_.WriteAtCurrentPos(lines.data(), lines.size());
+    if (written > 0)
+      size_ += written;
+  }
+
+ private:
+  bool Open() {
+    file_.Initialize(path_, base::File::FLAG_OPEN_ALWAYS |
+                                base::File::FLAG_APPEND |
+                                base::File::FLAG_WRITE);
+    if (!file_.IsValid()) {
+      LOG(ERROR) << "Unable to open request log " << path_.value();
+      return false;
+    }
+    size_ = file_.GetLength();
+    return true;
+  }
+
+  base::FilePath GetRotatedPath(int index) const {
+    if (index == 0)
+      return path_;
+    return path_.AddExtensionASCII(base::IntToString(index));
+  }
+
+  void Rotate() {
+    file_.Close();
+    if (max_files_ <= 1) {
+      base::DeleteFile(path_, false);
+      return;
+    }
+    for (int i = max_files_ - 1; i > 0; --i) {
+      base::FilePath from = GetRotatedPath(i - 1);
+      if (base::PathExists(from))
+        base::ReplaceFile(from, GetRotatedPath(i), nullptr);
+    }
+  }
+
+  const base::FilePath path_;
+  const int64_t max_file_size_;
+  const int max_files_;
+
+  base::File file_;
+  int64_t size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(LogFile);
+};
+
+RequestLogWriter::Options::Options() = default;
+RequestLogWriter::Options::Options(const Options&) = default;
+RequestLogWriter::Options::~Options() = default;
+
+// static
+bool RequestLogWriter::FieldFromString(const std::string& name, Field* field) {
+  for (const auto& field_name : kFieldNames) {
+    if (name == field_name.name) {
+      *field = field_name.field;
+      return true;
+    }
+  }
+  return false;
+}
+
+RequestLogWriter::RequestLogWriter(const Options& options)
+    : fields_(options.fields),
+      file_task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::BACKGROUND,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
+      log_file_(new LogFile(options.path,
+                            options.max_file_size,
+                            options.max_files),
+                base::OnTaskRunnerDeleter(file_task_runner_)),
+      weak_factory_(this) {}
+
+RequestLogWriter::~RequestLogWriter() {
+  // The file is deleted on its sequence after the last lines are written.
+  Flush();
+}
+
+void RequestLogWriter::OnRequestCompleted(net::URLRequest* request,
+                                          int net_error) {
+  base::DictionaryValue record;
+  for (Field field : fields_) {
+    switch (field) {
+      case Field::kId:
+        record.SetKey("id", base::Value(static_cast<double>(
+                                request->identifier())));
+        break;
+      case Field::kTimestamp:
+        record.SetKey("timestamp",
+                      base::Value(base::Time::Now().ToDoubleT() * 1000));
+        break;
+      case Field::kMethod:
+        record.SetKey("method", base::Value(request->method()));
+        break;
+      case Field::kUrl:
+        record.SetKey("url", base::Value(request->url().spec()));
+        break;
+      case Field::kReferrer:
+        record.SetKey("referrer", base::Value(request->referrer()));
+        break;
+      case Field::kResourceType: {
+        const auto* info = content::ResourceRequestInfo::ForRequest(request);
+        record.SetKey("resourceType",
+                      base::Value(info ? ResourceTypeToString(
+                                             info->GetResourceType())
+                                       : "other"));
+        break;
+      }
+      case Field::kStatusCode:
+        if (request->response_headers()) {
+          record.SetKey(
+              "statusCode",
+              base::Value(request->response_headers()->response_code()));
+        }
+        break;
+      case Field::kFromCache:
+        record.SetKey("fromCache", base::Value(request->was_cached()));
+        break;
+      case Field::kIp:
+        if (!request->GetSocketAddress().host().empty()) {
+          record.SetKey("ip",
+                        base::Value(request->GetSocketAddress().host()));
+        }
+        break;
+      case Field::kError:
+        if (net_error != net::OK)
+          record.SetKey("error", base::Value(net::ErrorToString(net_error)));
+        break;
+    }
+  }
+
+  std::string line;
+  base::JSONWriter::Write(record, &line);
+
+  // The first line of a batch schedules its flush.
+  if (pending_lines_.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+        FROM_HERE,
+        base::BindOnce(&RequestLogWriter::Flush, weak_factory_.GetWeakPtr()),
+        kFlushInterval);
+  }
+  pending_lines_ += line;
+  pending_lines_ += '\n';
+  if (pending_lines_.size() > kMaxPendingBytes)
+    Flush();
+}
+
+void RequestLogWriter::Flush() {
+  if (pending_lines_.empty())
+    return;
+  std::string lines;
+  lines.swap(pending_lines_);
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&LogFile::Append,
+                                base::Unretained(log_file_.get()),
+                                std::move(lines)));
+}
+
+}  // namespace atom
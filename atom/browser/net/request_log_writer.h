@@ -0,0 +1,81 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_REQUEST_LOG_WRITER_H_
+#define ATOM_BROWSER_NET_REQUEST_LOG_WRITER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+
+namespace net {
+class URLRequest;
+}
+
+namespace atom {
+
+// Writes a line of JSON for each completed request to a file without running
+// any JavaScript. It lives on the IO thread, the lines are written in batches
+// on a background sequence and the file is rotated when it grows past
+// |max_file_size|: "log" is moved to "log.1", "log.1" to "log.2" and so on,
+// keeping at most |max_files| files.
+class RequestLogWriter {
+ public:
+  enum class Field {
+    kId,
+    kTimestamp,
+    kMethod,
+    kUrl,
+    kReferrer,
+    kResourceType,
+    kStatusCode,
+    kFromCache,
+    kIp,
+    kError,
+  };
+
+  struct Options {
+    Options();
+    Options(const Options&);
+    ~Options();
+
+    base::FilePath path;
+    std::vector<Field> fields;
+    int64_t max_file_size = 10 * 1024 * 1024;
+    int max_files = 3;
+  };
+
+  // Returns false when |name| is not the name of a field.
+  static bool FieldFromString(const std::string& name, Field* field);
+
+  explicit RequestLogWriter(const Options& options);
+  ~RequestLogWriter();
+
+  void OnRequestCompleted(net::URLRequest* request, int net_error);
+
+ private:
+  class LogFile;
+
+  void Flush();
+
+  const std::vector<Field> fields_;
+
+  // The lines that are not handed to |log_file_| yet.
+  std::string pending_lines_;
+
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  std::unique_ptr<LogFile, base::OnTaskRunnerDeleter> log_file_;
+
+  base::WeakPtrFactory<RequestLogWriter> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(RequestLogWriter);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_REQUEST_LOG_WRITER_H_
@@ -4,14 +4,31 @@
 
 #include "atom/browser/net/resolve_proxy_helper.h"
 
+#include <utility>
+
 #include "atom/browser/atom_browser_context.h"
 #include "base/bind.h"
+#include "base/memory/ptr_util.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "net/url_request/url_request_context.h"
 #include "net/url_request/url_request_context_getter.h"
 
 namespace atom {
 
+namespace {
+
+// How long a resolved proxy is reused for other URLs of the same origin.
+constexpr base::TimeDelta kCacheDuration = base::TimeDelta::FromSeconds(5);
+
+void RunResolveProxyCallback(
+    const ResolveProxyHelper::ResolveProxyCallback& callback,
+    const std::vector<std::string>& proxies) {
+  if (!callback.is_null())
+    callback.Run(proxies.front());
+}
+
+}  // namespace
+
 ResolveProxyHelper::ResolveProxyHelper(AtomBrowserContext* browser_context)
     : context_getter_(browser_context->GetRequestContext()),
       original_thread_(base::ThreadTaskRunnerHandle::Get()) {}
@@ -23,66 +40,135 @@ ResolveProxyHelper::~ResolveProxyHelper() {
 
 void ResolveProxyHelper::ResolveProxy(const GURL& url,
                                       const ResolveProxyCallback& callback) {
-  // Enqueue the pending request.
-  pending_requests_.push_back(PendingRequest(url, callback));
-
-  // If nothing is in progress, start.
-  if (pending_requests_.size() == 1)
-    StartPendingRequest();
+  ResolveProxies(std::vector<GURL>{url},
+                 base::Bind(&RunResolveProxyCallback, callback));
 }
 
-void ResolveProxyHelper::StartPendingRequest() {
-  auto& pending_request = pending_requests_.front();
+void ResolveProxyHelper::ResolveProxies(
+    const std::vector<GURL>& urls,
+    const ResolveProxiesCallback& callback) {
+  int request_id = ++next_request_id_;
+  PendingRequest pending_request(urls, callback, cache_generation_);
+
+  // Only the URLs without a fresh cached result are resolved.
+  std::vector<GURL> unresolved_urls;
+  base::TimeTicks now = base::TimeTicks::Now();
+  for (size_t i = 0; i < urls.size(); ++i) {
+    auto it = cache_.find(urls[i].GetOrigin());
+    if (it != cache_.end() && it->second.expiry > now) {
+      pending_request.results[i] = it->second.proxy;
+    } else {
+      pending_request.unresolved.push_back(i);
+      unresolved_urls.push_back(urls[i]);
+    }
+  }
+  pending_requests_.emplace(request_id, std::move(pending_request));
+
+  if (unresolved_urls.empty()) {
+    original_thread_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&ResolveProxyHelper::SendProxyResults,
+                       base::RetainedRef(this), request_id,
+                       std::vector<std::string>()));
+    return;
+  }
+
   context_getter_->GetNetworkTaskRunner()->PostTask(
-      FROM_HERE, base::BindOnce(&ResolveProxyHelper::StartPendingRequestInIO,
-                                base::Unretained(this), pending_request.url));
+      FROM_HERE,
+      base::BindOnce(&ResolveProxyHelper::StartRequestsInIO,
+                     base::RetainedRef(this), request_id,
+                     std::move(unresolved_urls)));
 }
 
-void ResolveProxyHelper::StartPendingRequestInIO(const GURL& url) {
+void ResolveProxyHelper::ClearCache() {
+  cache_.clear();
+  // Results of requests started before this call are not cached.
+  ++cache_generation_;
+}
+
+void ResolveProxyHelper::StartRequestsInIO(int request_id,
+                                           const std::vector<GURL>& urls) {
   auto* proxy_service =
       context_getter_->GetURLRequestContext()->proxy_resolution_service();
-  // Start the request.
-  int result = proxy_service->ResolveProxy(
-      url, std::string(), &proxy_info_,
-      base::Bind(&ResolveProxyHelper::OnProxyResolveComplete,
-                 base::RetainedRef(this)),
-      nullptr, nullptr, net::NetLogWithSource());
-  // Completed synchronously.
-  if (result != net::ERR_IO_PENDING)
-    OnProxyResolveComplete(result);
+  IOBatch* batch = new IOBatch(urls.size());
+  io_batches_[request_id] = base::WrapUnique(batch);
+
+  // Start all the requests, the batch is released when the last one
+  // completes, which may happen synchronously.
+  for (size_t i = 0; i < urls.size(); ++i) {
+    int result = proxy_service->ResolveProxy(
+        urls[i], std::string(), &batch->proxy_infos[i],
+        base::Bind(&ResolveProxyHelper::OnProxyResolveComplete,
+                   base::RetainedRef(this), request_id, i),
+        nullptr, nullptr, net::NetLogWithSource());
+    // Completed synchronously.
+    if (result != net::ERR_IO_PENDING)
+      OnProxyResolveComplete(request_id, i, result);
+  }
 }
 
-void ResolveProxyHelper::OnProxyResolveComplete(int result) {
-  DCHECK(!pending_requests_.empty());
+void ResolveProxyHelper::OnProxyResolveComplete(int request_id,
+                                                size_t index,
+                                                int result) {
+  auto it = io_batches_.find(request_id);
+  DCHECK(it != io_batches_.end());
+  IOBatch* batch = it->second.get();
 
-  std::string proxy;
   if (result == net::OK)
-    proxy = proxy_info_.ToPacString();
+    batch->results[index] = batch->proxy_infos[index].ToPacString();
+  if (--batch->remaining > 0)
+    return;
 
   original_thread_->PostTask(
-      FROM_HERE, base::BindOnce(&ResolveProxyHelper::SendProxyResult,
-                                base::RetainedRef(this), proxy));
+      FROM_HERE, base::BindOnce(&ResolveProxyHelper::SendProxyResults,
+                                base::RetainedRef(this), request_id,
+                                std::move(batch->results)));
+  io_batches_.erase(it);
 }
 
-void ResolveProxyHelper::SendProxyResult(const std::string& proxy) {
-  DCHECK(!pending_requests_.empty());
-
-  const auto& completed_request = pending_requests_.front();
-  if (!completed_request.callback.is_null())
-    completed_request.callback.Run(proxy);
-
-  // Clear the current (completed) request.
-  pending_requests_.pop_front();
-
-  // Start the next request.
-  if (!pending_requests_.empty())
-    StartPendingRequest();
+void ResolveProxyHelper::SendProxyResults(
+    int request_id,
+    const std::vector<std::string>& results) {
+  auto it = pending_requests_.find(request_id);
+  DCHECK(it != pending_requests_.end());
+  PendingRequest& pending_request = it->second;
+  DCHECK_EQ(results.size(), pending_request.unresolved.size());
+
+  // Drop the expired entries before caching the new results.
+  base::TimeTicks now = base::TimeTicks::Now();
+  for (auto cached = cache_.begin(); cached != cache_.end();) {
+    if (cached->second.expiry <= now)
+      cached = cache_.erase(cached);
+    else
+      ++cached;
+  }
+
+  bool cacheable = pending_request.cache_generation == cache_generation_;
+  for (size_t i = 0; i < results.size(); ++i) {
+    size_t index = pending_request.unresolved[i];
+    pending_request.results[index] = results[i];
+    if (cacheable && !results[i].empty()) {
+      cache_[pending_request.urls[index].GetOrigin()] = {results[i],
+                                                         now + kCacheDuration};
+    }
+  }
+
+  ResolveProxiesCallback callback = pending_request.callback;
+  std::vector<std::string> proxies = std::move(pending_request.results);
+  pending_requests_.erase(it);
+
+  if (!callback.is_null())
+    callback.Run(proxies);
 }
 
 ResolveProxyHelper::PendingRequest::PendingRequest(
-    const GURL& url,
-    const ResolveProxyCallback& callback)
-    : url(url), callback(callback) {}
+    const std::vector<GURL>& urls,
+    const ResolveProxiesCallback& callback,
+    int cache_generation)
+    : urls(urls),
+      results(urls.size()),
+      callback(callback),
+      cache_generation(cache_generation) {}
 
 ResolveProxyHelper::PendingRequest::PendingRequest(
     ResolveProxyHelper::PendingRequest&& pending_request) = default;
@@ -93,4 +179,9 @@ ResolveProxyHelper::PendingRequest& ResolveProxyHelper::PendingRequest::
 operator=(ResolveProxyHelper::PendingRequest&& pending_request) noexcept =
     default;
 
+ResolveProxyHelper::IOBatch::IOBatch(size_t size)
+    : proxy_infos(size), results(size), remaining(size) {}
+
+ResolveProxyHelper::IOBatch::~IOBatch() = default;
+
 }  // namespace atom
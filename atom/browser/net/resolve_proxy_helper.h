@@ -5,10 +5,13 @@
 #ifndef ATOM_BROWSER_NET_RESOLVE_PROXY_HELPER_H_
 #define ATOM_BROWSER_NET_RESOLVE_PROXY_HELPER_H_
 
-#include <deque>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "net/proxy_resolution/proxy_resolution_service.h"
 #include "url/gurl.h"
 
@@ -24,39 +27,77 @@ class ResolveProxyHelper
     : public base::RefCountedThreadSafe<ResolveProxyHelper> {
  public:
   using ResolveProxyCallback = base::Callback<void(std::string)>;
+  using ResolveProxiesCallback =
+      base::Callback<void(const std::vector<std::string>&)>;
 
   explicit ResolveProxyHelper(AtomBrowserContext* browser_context);
 
   void ResolveProxy(const GURL& url, const ResolveProxyCallback& callback);
 
+  // Resolves all of |urls| concurrently with a single hop to the IO thread,
+  // the results are passed to |callback| in the same order as |urls|.
+  void ResolveProxies(const std::vector<GURL>& urls,
+                      const ResolveProxiesCallback& callback);
+
+  // Drops the cached results, called when the proxy settings change.
+  void ClearCache();
+
  private:
   friend class base::RefCountedThreadSafe<ResolveProxyHelper>;
-  // A PendingRequest is a resolve request that is in progress, or queued.
+  // A PendingRequest is a ResolveProxies call that is in progress.
   struct PendingRequest {
    public:
-    PendingRequest(const GURL& url, const ResolveProxyCallback& callback);
+    PendingRequest(const std::vector<GURL>& urls,
+                   const ResolveProxiesCallback& callback,
+                   int cache_generation);
     PendingRequest(PendingRequest&& pending_request) noexcept;
     ~PendingRequest();
 
     PendingRequest& operator=(PendingRequest&& pending_request) noexcept;
 
-    GURL url;
-    ResolveProxyCallback callback;
+    std::vector<GURL> urls;
+    std::vector<std::string> results;
+    // Indices in |urls| of the entries that are resolved on the IO thread.
+    std::vector<size_t> unresolved;
+    ResolveProxiesCallback callback;
+    int cache_generation;
 
    private:
     DISALLOW_COPY_AND_ASSIGN(PendingRequest);
   };
 
+  // The resolutions started on the IO thread for a PendingRequest, each one
+  // with its own ProxyInfo.
+  struct IOBatch {
+    explicit IOBatch(size_t size);
+    ~IOBatch();
+
+    std::vector<net::ProxyInfo> proxy_infos;
+    std::vector<std::string> results;
+    size_t remaining;
+  };
+
+  struct CachedProxy {
+    std::string proxy;
+    base::TimeTicks expiry;
+  };
+
   ~ResolveProxyHelper();
 
-  // Starts the first pending request.
-  void StartPendingRequest();
-  void StartPendingRequestInIO(const GURL& url);
-  void OnProxyResolveComplete(int result);
-  void SendProxyResult(const std::string& proxy);
+  void StartRequestsInIO(int request_id, const std::vector<GURL>& urls);
+  void OnProxyResolveComplete(int request_id, size_t index, int result);
+  void SendProxyResults(int request_id,
+                        const std::vector<std::string>& results);
+
+  // Accessed on the original thread.
+  int next_request_id_ = 0;
+  std::map<int, PendingRequest> pending_requests_;
+  std::map<GURL, CachedProxy> cache_;
+  int cache_generation_ = 0;
+
+  // Accessed on the IO thread.
+  std::map<int, std::unique_ptr<IOBatch>> io_batches_;
 
-  net::ProxyInfo proxy_info_;
-  std::deque<PendingRequest> pending_requests_;
   scoped_refptr<net::URLRequestContextGetter> context_getter_;
   scoped_refptr<base::SingleThreadTaskRunner> original_thread_;
 
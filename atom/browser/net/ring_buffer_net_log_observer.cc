@@ -0,0 +1,90 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/ring_buffer_net_log_observer.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/files/important_file_writer.h"
+#include "base/json/json_writer.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/values.h"
+#include "components/net_log/chrome_net_log.h"
+
+namespace atom {
+
+namespace {
+
+bool WriteEvents(const base::FilePath& path,
+                 const std::string& constants,
+                 const std::vector<std::string>& events) {
+  std::string contents = "{\"constants\":" + constants + ",\"events\":[";
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (i > 0)
+      contents += ",\n";
+    contents += events[i];
+  }
+  contents += "]}\n";
+  return base::ImportantFileWriter::WriteFileAtomically(path, contents);
+}
+
+}  // namespace
+
+RingBufferNetLogObserver::RingBufferNetLogObserver(size_t max_size)
+    : max_size_(max_size) {}
+
+RingBufferNetLogObserver::~RingBufferNetLogObserver() {
+  StopObserving();
+}
+
+void RingBufferNetLogObserver::StartObserving(net::NetLog* net_log,
+                                              net::NetLogCaptureMode mode) {
+  net_log->AddObserver(this, mode);
+}
+
+void RingBufferNetLogObserver::StopObserving() {
+  if (net_log())
+    net_log()->RemoveObserver(this);
+}
+
+void RingBufferNetLogObserver::Dump(const base::FilePath& path,
+                                    DumpCallback callback) {
+  std::vector<std::string> events;
+  {
+    base::AutoLock auto_lock(lock_);
+    events.assign(events_.begin(), events_.end());
+  }
+
+  std::unique_ptr<base::Value> constants = net_log::ChromeNetLog::GetConstants(
+      base::CommandLine::ForCurrentProcess()->GetCommandLineString(),
+      std::string());
+  std::string constants_json;
+  base::JSONWriter::Write(*constants, &constants_json);
+
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BACKGROUND,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&WriteEvents, path, std::move(constants_json),
+                     std::move(events)),
+      std::move(callback));
+}
+
+void RingBufferNetLogObserver::OnAddEntry(const net::NetLogEntry& entry) {
+  std::string event;
+  base::JSONWriter::Write(*entry.ToValue(), &event);
+
+  base::AutoLock auto_lock(lock_);
+  size_ += event.size();
+  events_.push_back(std::move(event));
+  while (size_ > max_size_ && !events_.empty()) {
+    size_ -= events_.front().size();
+    events_.pop_front();
+  }
+}
+
+}  // namespace atom
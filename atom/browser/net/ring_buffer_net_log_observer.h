@@ -0,0 +1,51 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_RING_BUFFER_NET_LOG_OBSERVER_H_
+#define ATOM_BROWSER_NET_RING_BUFFER_NET_LOG_OBSERVER_H_
+
+#include <deque>
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/synchronization/lock.h"
+#include "net/log/net_log.h"
+
+namespace atom {
+
+// Keeps the most recent events of the NetLog in memory, up to |max_size|
+// bytes of serialized JSON, and writes them into a file on demand. Unlike the
+// file observers nothing is written while capturing, so it can be left on.
+class RingBufferNetLogObserver : public net::NetLog::ThreadSafeObserver {
+ public:
+  using DumpCallback = base::OnceCallback<void(bool success)>;
+
+  explicit RingBufferNetLogObserver(size_t max_size);
+  ~RingBufferNetLogObserver() override;
+
+  void StartObserving(net::NetLog* net_log, net::NetLogCaptureMode mode);
+  void StopObserving();
+
+  // Writes the events captured so far to |path| in the format of the
+  // net-export files, |callback| is called on the current sequence.
+  void Dump(const base::FilePath& path, DumpCallback callback);
+
+  // net::NetLog::ThreadSafeObserver:
+  void OnAddEntry(const net::NetLogEntry& entry) override;
+
+ private:
+  const size_t max_size_;
+
+  // Guards the members below, the events are added from any thread.
+  base::Lock lock_;
+  std::deque<std::string> events_;
+  size_t size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(RingBufferNetLogObserver);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_RING_BUFFER_NET_LOG_OBSERVER_H_
@@ -0,0 +1,63 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/streaming_net_log_observer.h"
+
+#include <memory>
+#include <utility>
+
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace atom {
+
+StreamingNetLogObserver::StreamingNetLogObserver(
+    const EventsCallback& callback,
+    base::TimeDelta interval)
+    : callback_(callback), interval_(interval), weak_factory_(this) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  weak_this_ = weak_factory_.GetWeakPtr();
+}
+
+StreamingNetLogObserver::~StreamingNetLogObserver() {
+  StopObserving();
+}
+
+void StreamingNetLogObserver::StartObserving(net::NetLog* net_log,
+                                             net::NetLogCaptureMode mode) {
+  net_log->AddObserver(this, mode);
+}
+
+void StreamingNetLogObserver::StopObserving() {
+  if (net_log())
+    net_log()->RemoveObserver(this);
+}
+
+void StreamingNetLogObserver::OnAddEntry(const net::NetLogEntry& entry) {
+  std::unique_ptr<base::Value> event = entry.ToValue();
+
+  base::AutoLock auto_lock(lock_);
+  // The first event of a batch schedules its flush.
+  if (events_.GetList().empty()) {
+    BrowserThread::PostDelayedTask(
+        BrowserThread::UI, FROM_HERE,
+        base::BindOnce(&StreamingNetLogObserver::Flush, weak_this_),
+        interval_);
+  }
+  events_.GetList().push_back(std::move(*event));
+}
+
+void StreamingNetLogObserver::Flush() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  base::ListValue events;
+  {
+    base::AutoLock auto_lock(lock_);
+    events.Swap(&events_);
+  }
+  if (!events.GetList().empty())
+    callback_.Run(events);
+}
+
+}  // namespace atom
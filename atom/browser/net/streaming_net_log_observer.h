@@ -0,0 +1,52 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_STREAMING_NET_LOG_OBSERVER_H_
+#define ATOM_BROWSER_NET_STREAMING_NET_LOG_OBSERVER_H_
+
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "net/log/net_log.h"
+
+namespace atom {
+
+// Collects the events of the NetLog and hands them to |callback| on the UI
+// thread in batches, at most once every |interval|.
+class StreamingNetLogObserver : public net::NetLog::ThreadSafeObserver {
+ public:
+  using EventsCallback = base::Callback<void(const base::ListValue& events)>;
+
+  StreamingNetLogObserver(const EventsCallback& callback,
+                          base::TimeDelta interval);
+  ~StreamingNetLogObserver() override;
+
+  void StartObserving(net::NetLog* net_log, net::NetLogCaptureMode mode);
+  void StopObserving();
+
+  // net::NetLog::ThreadSafeObserver:
+  void OnAddEntry(const net::NetLogEntry& entry) override;
+
+ private:
+  void Flush();
+
+  EventsCallback callback_;
+  const base::TimeDelta interval_;
+
+  // Guards |events_|, the events are added from any thread.
+  base::Lock lock_;
+  base::ListValue events_;
+
+  // Only dereferenced on the UI thread.
+  base::WeakPtr<StreamingNetLogObserver> weak_this_;
+  base::WeakPtrFactory<StreamingNetLogObserver> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingNetLogObserver);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_STREAMING_NET_LOG_OBSERVER_H_
@@ -0,0 +1,70 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/url_pattern_matcher.h"
+
+#include "url/gurl.h"
+
+namespace atom {
+
+URLPatternMatcher::URLPatternMatcher() = default;
+
+URLPatternMatcher::URLPatternMatcher(const std::set<URLPattern>& patterns)
+    : size_(patterns.size()) {
+  for (const auto& pattern : patterns) {
+    if (pattern.match_all_urls() || pattern.host().empty())
+      any_host_.push_back(pattern);
+    else if (pattern.match_subdomains())
+      domains_[pattern.host()].push_back(pattern);
+    else
+      hosts_[pattern.host()].push_back(pattern);
+  }
+}
+
+URLPatternMatcher::URLPatternMatcher(const URLPatternMatcher& other) = default;
+
+URLPatternMatcher& URLPatternMatcher::operator=(
+    const URLPatternMatcher& other) = default;
+
+URLPatternMatcher::~URLPatternMatcher() = default;
+
+bool URLPatternMatcher::MatchesURL(const GURL& url) const {
+  if (empty())
+    return true;
+
+  if (MatchesAny(any_host_, url))
+    return true;
+
+  const std::string& host = url.host();
+  auto it = hosts_.find(host);
+  if (it != hosts_.end() && MatchesAny(it->second, url))
+    return true;
+
+  // Look up "a.b.example.com", "b.example.com", "example.com" and "com".
+  if (!domains_.empty()) {
+    size_t start = 0;
+    while (start < host.size()) {
+      auto domain = domains_.find(host.substr(start));
+      if (domain != domains_.end() && MatchesAny(domain->second, url))
+        return true;
+      size_t dot = host.find('.', start);
+      if (dot == std::string::npos)
+        break;
+      start = dot + 1;
+    }
+  }
+
+  return false;
+}
+
+// static
+bool URLPatternMatcher::MatchesAny(const Patterns& patterns, const GURL& url) {
+  for (const auto& pattern : patterns) {
+    if (pattern.MatchesURL(url))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace atom
@@ -0,0 +1,53 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_URL_PATTERN_MATCHER_H_
+#define ATOM_BROWSER_NET_URL_PATTERN_MATCHER_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace atom {
+
+// Matches URLs against a set of patterns without testing every pattern.
+// The patterns are indexed by host, so a URL is only tested against the
+// patterns of its host, of the domains it belongs to, and the patterns that
+// match any host.
+class URLPatternMatcher {
+ public:
+  URLPatternMatcher();
+  explicit URLPatternMatcher(const std::set<URLPattern>& patterns);
+  URLPatternMatcher(const URLPatternMatcher& other);
+  URLPatternMatcher& operator=(const URLPatternMatcher& other);
+  ~URLPatternMatcher();
+
+  // An empty matcher matches every URL.
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  bool MatchesURL(const GURL& url) const;
+
+ private:
+  using Patterns = std::vector<URLPattern>;
+
+  static bool MatchesAny(const Patterns& patterns, const GURL& url);
+
+  // Patterns like "*://example.com/*".
+  std::unordered_map<std::string, Patterns> hosts_;
+  // Patterns like "*://*.example.com/*", keyed by "example.com".
+  std::unordered_map<std::string, Patterns> domains_;
+  // Patterns like "<all_urls>", "*://*/*" and "file:///*".
+  Patterns any_host_;
+  size_t size_ = 0;
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_URL_PATTERN_MATCHER_H_
@@ -12,10 +12,12 @@
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "atom/common/native_mate_converters/v8_value_converter.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/mime_util.h"
 #include "net/base/net_errors.h"
+#include "net/http/http_byte_range.h"
 
 namespace atom {
 
@@ -64,6 +66,17 @@ URLRequestBufferJob::URLRequestBufferJob(net::URLRequest* request,
 URLRequestBufferJob::~URLRequestBufferJob() = default;
 
 void URLRequestBufferJob::Start() {
+  ProtocolResponseCache::Response cached;
+  if (response_cache() && response_cache()->Get(request(), &cached)) {
+    mime_type_ = cached.mime_type;
+    charset_ = cached.charset;
+    etag_ = cached.etag;
+    data_ = cached.data;
+    status_code_ = net::HTTP_OK;
+    net::URLRequestSimpleJob::Start();
+    return;
+  }
+
   auto request_details = std::make_unique<base::DictionaryValue>();
   FillRequestDetails(request_details.get(), request());
   content::BrowserThread::PostTask(
@@ -111,6 +124,15 @@ void URLRequestBufferJob::StartAsync(std::unique_ptr<base::Value> options,
       reinterpret_cast<const unsigned char*>(binary->GetBlob().data()),
       binary->GetBlob().size());
   status_code_ = net::HTTP_OK;
+
+  if (response_cache()) {
+    ProtocolResponseCache::Response response;
+    response.mime_type = mime_type_;
+    response.charset = charset_;
+    response.data = data_;
+    response_cache()->PutFromOptions(request(), *options, &response);
+    etag_ = response.etag;
+  }
   net::URLRequestSimpleJob::Start();
 }
 
@@ -120,14 +142,24 @@ void URLRequestBufferJob::Kill() {
 }
 
 void URLRequestBufferJob::GetResponseInfo(net::HttpResponseInfo* info) {
-  std::string status("HTTP/1.1 200 OK");
-  status.append(base::IntToString(status_code_));
+  // URLRequestSimpleJob only sends the requested range of the data, but does
+  // not add the headers of a partial response.
+  net::HttpByteRange range;
+  if (ranges().size() == 1)
+    range = ranges()[0];
+  bool partial = data_ && range.IsValid() && range.ComputeBounds(data_->size());
+  net::HttpStatusCode status_code =
+      partial ? net::HTTP_PARTIAL_CONTENT : status_code_;
+
+  std::string status("HTTP/1.1 ");
+  status.append(base::IntToString(status_code));
   status.append(" ");
-  status.append(net::GetHttpReasonPhrase(status_code_));
+  status.append(net::GetHttpReasonPhrase(status_code));
   status.append("\0\0", 2);
   auto* headers = new net::HttpResponseHeaders(status);
 
   headers->AddHeader(kCORSHeader);
+  headers->AddHeader("Accept-Ranges: bytes");
 
   if (!mime_type_.empty()) {
     std::string content_type_header(net::HttpRequestHeaders::kContentType);
@@ -136,6 +168,19 @@ void URLRequestBufferJob::GetResponseInfo(net::HttpResponseInfo* info) {
     headers->AddHeader(content_type_header);
   }
 
+  if (partial) {
+    headers->AddHeader(base::StringPrintf(
+        "Content-Range: bytes %" PRId64 "-%" PRId64 "/%" PRIuS,
+        range.first_byte_position(), range.last_byte_position(),
+        data_->size()));
+    headers->AddHeader(base::StringPrintf(
+        "Content-Length: %" PRId64,
+        range.last_byte_position() - range.first_byte_position() + 1));
+  }
+
+  if (!etag_.empty())
+    headers->AddHeader("ETag: " + etag_);
+
   info->headers = headers;
 }
 
@@ -36,7 +36,8 @@ class URLRequestBufferJob : public JsAsker, public net::URLRequestSimpleJob {
  private:
   std::string mime_type_;
   std::string charset_;
-  scoped_refptr<base::RefCountedBytes> data_;
+  std::string etag_;
+  scoped_refptr<base::RefCountedMemory> data_;
   net::HttpStatusCode status_code_;
 
   base::WeakPtrFactory<URLRequestBufferJob> weak_factory_;
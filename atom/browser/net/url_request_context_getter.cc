@@ -21,6 +21,10 @@
 #include "atom/browser/net/require_ct_delegate.h"
 #include "atom/browser/net/system_network_context_manager.h"
 #include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/strings/string_util.h"
 #include "base/task_scheduler/post_task.h"
 #include "chrome/common/chrome_constants.h"
@@ -31,15 +35,21 @@
 #include "content/public/browser/devtools_network_transaction_factory.h"
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/resource_context.h"
+#include "net/base/address_list.h"
 #include "net/base/host_mapping_rules.h"
 #include "net/cert/multi_log_ct_verifier.h"
 #include "net/cookies/cookie_monster.h"
+#include "net/dns/host_cache.h"
+#include "net/dns/host_resolver.h"
 #include "net/dns/mapped_host_resolver.h"
+#include "net/extras/sqlite/sqlite_persistent_cookie_store.h"
 #include "net/http/http_auth_handler_factory.h"
 #include "net/http/http_auth_preferences.h"
 #include "net/http/http_auth_scheme.h"
 #include "net/http/http_transaction_factory.h"
 #include "net/log/net_log.h"
+#include "net/log/net_log_with_source.h"
+#include "net/socket/client_socket_pool_manager.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 #include "net/url_request/data_protocol_handler.h"
 #include "net/url_request/static_http_user_agent_settings.h"
@@ -61,6 +71,136 @@ namespace atom {
 
 namespace {
 
+struct SocketPoolLimits {
+  int per_group;
+  int per_pool;
+  int per_proxy_server;
+};
+
+SocketPoolLimits GetSocketPoolLimits() {
+  const auto type = net::HttpNetworkSession::NORMAL_SOCKET_POOL;
+  return {net::ClientSocketPoolManager::max_sockets_per_group(type),
+          net::ClientSocketPoolManager::max_sockets_per_pool(type),
+          net::ClientSocketPoolManager::max_sockets_per_proxy_server(type)};
+}
+
+// The limits are checked against each other as they are set, so the ones that
+// bound the per group limit are raised before it changes.
+void SetSocketPoolLimits(const SocketPoolLimits& limits) {
+  using net::ClientSocketPoolManager;
+  const auto type = net::HttpNetworkSession::NORMAL_SOCKET_POOL;
+  int per_group = ClientSocketPoolManager::max_sockets_per_group(type);
+  ClientSocketPoolManager::set_max_sockets_per_pool(
+      type, std::max(limits.per_pool, per_group));
+  ClientSocketPoolManager::set_max_sockets_per_proxy_server(
+      type, std::max(limits.per_proxy_server, per_group));
+  ClientSocketPoolManager::set_max_sockets_per_group(type, limits.per_group);
+  ClientSocketPoolManager::set_max_sockets_per_pool(type, limits.per_pool);
+  ClientSocketPoolManager::set_max_sockets_per_proxy_server(
+      type, limits.per_proxy_server);
+}
+
+// net only has process wide limits, which the socket pools read when they are
+// created. The session's own limits are set while its HttpNetworkSession is
+// built, so only that session uses them.
+class ScopedSocketPoolLimits {
+ public:
+  ScopedSocketPoolLimits(int per_group, int per_pool)
+      : default_limits_(GetSocketPoolLimits()) {
+    if (per_group <= 0 && per_pool <= 0)
+      return;
+
+    SocketPoolLimits limits = default_limits_;
+    if (per_group > 0)
+      limits.per_group = std::min(per_group, 99);
+    if (per_pool > 0)
+      limits.per_pool = std::min(per_pool, 999);
+    limits.per_pool = std::max(limits.per_pool, limits.per_group);
+    limits.per_proxy_server =
+        std::max(limits.per_proxy_server, limits.per_group);
+    SetSocketPoolLimits(limits);
+    changed_ = true;
+  }
+
+  ~ScopedSocketPoolLimits() {
+    if (changed_)
+      SetSocketPoolLimits(default_limits_);
+  }
+
+ private:
+  const SocketPoolLimits default_limits_;
+  bool changed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedSocketPoolLimits);
+};
+
+// The cookie store reads its commit policy when it is created, the session's
+// own policy is set while its NetworkContext is built like the socket pool
+// limits are.
+class ScopedCookieCommitPolicy {
+ public:
+  // Chromium's policy.
+  static constexpr int kDefaultIntervalMs = 30 * 1000;
+  static constexpr int kDefaultBatchSize = 512;
+
+  ScopedCookieCommitPolicy(int interval_ms, int batch_size) {
+    if (interval_ms <= 0 && batch_size <= 0)
+      return;
+    net::SQLitePersistentCookieStore::SetCommitPolicyForNewStores(
+        base::TimeDelta::FromMilliseconds(interval_ms > 0 ? interval_ms
+                                                          : kDefaultIntervalMs),
+        batch_size > 0 ? batch_size : kDefaultBatchSize);
+    changed_ = true;
+  }
+
+  ~ScopedCookieCommitPolicy() {
+    if (changed_)
+      net::SQLitePersistentCookieStore::SetCommitPolicyForNewStores(
+          base::TimeDelta::FromMilliseconds(kDefaultIntervalMs),
+          kDefaultBatchSize);
+  }
+
+ private:
+  bool changed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedCookieCommitPolicy);
+};
+
+const base::FilePath::CharType kHostCacheFilename[] =
+    FILE_PATH_LITERAL("Host Cache");
+
+// The most host names that are resolved again at startup.
+const size_t kMaxPersistedHosts = 100;
+
+// Keeps the result and the request of a DNS prefetch alive until it is done.
+struct DNSPrefetch {
+  net::AddressList addresses;
+  std::unique_ptr<net::HostResolver::Request> request;
+};
+
+void OnDNSPrefetched(DNSPrefetch* prefetch, int result) {
+  delete prefetch;
+}
+
+std::vector<std::string> ReadHostCache(const base::FilePath& path) {
+  std::vector<std::string> hosts;
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return hosts;
+  std::unique_ptr<base::Value> list = base::JSONReader::Read(contents);
+  if (!list || !list->is_list())
+    return hosts;
+  for (const auto& host : list->GetList()) {
+    if (host.is_string() && hosts.size() < kMaxPersistedHosts)
+      hosts.push_back(host.GetString());
+  }
+  return hosts;
+}
+
+void WriteHostCache(const base::FilePath& path, const std::string& contents) {
+  base::ImportantFileWriter::WriteFileAtomically(path, contents);
+}
+
 void SetupAtomURLRequestJobFactory(
     content::ProtocolHandlerMap* protocol_handlers,
     net::URLRequestContext* url_request_context,
@@ -167,6 +307,8 @@ URLRequestContextGetter::Handle::CreateNetworkContextParams() {
 
   network_context_params->http_cache_enabled =
       browser_context_->CanUseHttpCache();
+  network_context_params->http_cache_max_size =
+      browser_context_->GetMaxCacheSize();
 
   network_context_params->accept_language =
       net::HttpUtil::GenerateAcceptLanguageHeader(
@@ -176,10 +318,10 @@ URLRequestContextGetter::Handle::CreateNetworkContextParams() {
 
   if (!browser_context_->IsOffTheRecord()) {
     auto base_path = browser_context_->GetPath();
-    network_context_params->http_cache_path =
-        base_path.Append(chrome::kCacheDirname);
-    network_context_params->http_cache_max_size =
-        browser_context_->GetMaxCacheSize();
+    // The network service keeps the cache in memory when it has no path.
+    if (!browser_context_->cache_in_memory())
+      network_context_params->http_cache_path =
+          base_path.Append(chrome::kCacheDirname);
     network_context_params->http_server_properties_path =
         base_path.Append(chrome::kNetworkPersistentStateFilename);
     network_context_params->cookie_path =
@@ -204,6 +346,13 @@ void URLRequestContextGetter::Handle::LazyInitialize() {
 
   initialized_ = true;
   main_network_context_params_ = CreateNetworkContextParams();
+  max_sockets_per_group_ = browser_context_->max_sockets_per_group();
+  max_sockets_per_pool_ = browser_context_->max_sockets_per_pool();
+  cookie_commit_interval_ = browser_context_->cookie_commit_interval();
+  cookie_commit_batch_size_ = browser_context_->cookie_commit_batch_size();
+  if (!browser_context_->IsOffTheRecord() &&
+      browser_context_->persist_host_cache())
+    host_cache_path_ = browser_context_->GetPath().Append(kHostCacheFilename);
 
   browser_context_->proxy_config_monitor()->AddToNetworkContextParams(
       main_network_context_params_.get());
@@ -259,6 +408,9 @@ void URLRequestContextGetter::NotifyContextShuttingDown(
     std::unique_ptr<ResourceContext> resource_context) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
+  if (url_request_context_ && !context_handle_->host_cache_path_.empty())
+    SaveHostCache(context_handle_->host_cache_path_);
+
   context_shutting_down_ = true;
   resource_context.reset();
   net::URLRequestContextGetter::NotifyContextShuttingDown();
@@ -287,10 +439,18 @@ net::URLRequestContext* URLRequestContextGetter::GetURLRequestContext() {
     builder->set_ct_verifier(std::make_unique<net::MultiLogCTVerifier>());
 
     auto* network_service = content::GetNetworkServiceImpl();
-    network_context_ = network_service->CreateNetworkContextWithBuilder(
-        std::move(context_handle_->main_network_context_request_),
-        std::move(context_handle_->main_network_context_params_),
-        std::move(builder), &url_request_context_);
+    {
+      ScopedSocketPoolLimits socket_pool_limits(
+          context_handle_->max_sockets_per_group_,
+          context_handle_->max_sockets_per_pool_);
+      ScopedCookieCommitPolicy cookie_commit_policy(
+          context_handle_->cookie_commit_interval_,
+          context_handle_->cookie_commit_batch_size_);
+      network_context_ = network_service->CreateNetworkContextWithBuilder(
+          std::move(context_handle_->main_network_context_request_),
+          std::move(context_handle_->main_network_context_params_),
+          std::move(builder), &url_request_context_);
+    }
 
     net::TransportSecurityState* transport_security_state =
         url_request_context_->transport_security_state();
@@ -325,11 +485,76 @@ net::URLRequestContext* URLRequestContextGetter::GetURLRequestContext() {
     url_request_context_->set_job_factory(top_job_factory_.get());
 
     context_handle_->resource_context_->request_context_ = url_request_context_;
+
+    // The addresses are not restored, they might be stale, but the hosts that
+    // were resolved in the last launch are resolved again in the background,
+    // so the first requests to them find fresh entries with their real TTLs.
+    if (!context_handle_->host_cache_path_.empty()) {
+      base::PostTaskWithTraitsAndReplyWithResult(
+          FROM_HERE,
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+          base::BindOnce(&ReadHostCache, context_handle_->host_cache_path_),
+          base::BindOnce(&URLRequestContextGetter::PrefetchDNS,
+                         base::WrapRefCounted(this)));
+    }
   }
 
   return url_request_context_;
 }
 
+void URLRequestContextGetter::PrefetchDNS(
+    const std::vector<std::string>& hosts) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  net::URLRequestContext* request_context = GetURLRequestContext();
+  if (!request_context)
+    return;
+
+  auto* host_resolver = request_context->host_resolver();
+  for (const auto& host : hosts) {
+    // The port does not change the result, the host cache is keyed by host.
+    net::HostResolver::RequestInfo info(net::HostPortPair(host, 80));
+    info.set_is_speculative(true);
+    auto* prefetch = new DNSPrefetch;
+    int rv = host_resolver->Resolve(
+        info, net::IDLE, &prefetch->addresses,
+        base::BindOnce(&OnDNSPrefetched, base::Unretained(prefetch)),
+        &prefetch->request, net::NetLogWithSource());
+    if (rv != net::ERR_IO_PENDING)
+      delete prefetch;
+  }
+}
+
+void URLRequestContextGetter::SaveHostCache(const base::FilePath& path) {
+  net::HostCache* host_cache = url_request_context_->host_resolver()
+                                   ? url_request_context_->host_resolver()
+                                         ->GetHostCache()
+                                   : nullptr;
+  if (!host_cache)
+    return;
+
+  // Only the hosts that resolved to addresses are kept.
+  base::ListValue entries;
+  host_cache->GetAsListValue(&entries, false);
+  base::ListValue hosts;
+  for (const auto& entry : entries.GetList()) {
+    const base::Value* hostname = entry.FindKey("hostname");
+    if (!hostname || !hostname->is_string() || !entry.FindKey("addresses"))
+      continue;
+    if (hosts.GetList().size() >= kMaxPersistedHosts)
+      break;
+    hosts.GetList().push_back(hostname->Clone());
+  }
+
+  std::string contents;
+  base::JSONWriter::Write(hosts, &contents);
+  base::PostTaskWithTraits(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BACKGROUND,
+       base::TaskShutdownBehavior::BLOCK_SHUTDOWN},
+      base::BindOnce(&WriteHostCache, path, contents));
+}
+
 scoped_refptr<base::SingleThreadTaskRunner>
 URLRequestContextGetter::GetNetworkTaskRunner() const {
   return BrowserThread::GetTaskRunnerForThread(BrowserThread::IO);
@@ -44,6 +44,9 @@ class URLRequestContextGetter : public net::URLRequestContextGetter {
 
   AtomNetworkDelegate* network_delegate() const { return network_delegate_; }
 
+  // Resolves |hosts| into the host cache in the background.
+  void PrefetchDNS(const std::vector<std::string>& hosts);
+
  private:
   friend class AtomBrowserContext;
 
@@ -79,6 +82,13 @@ class URLRequestContextGetter : public net::URLRequestContextGetter {
     // is passed to network service.
     network::mojom::NetworkContextRequest main_network_context_request_;
     network::mojom::NetworkContextParamsPtr main_network_context_params_;
+    int max_sockets_per_group_ = 0;
+    int max_sockets_per_pool_ = 0;
+    int cookie_commit_interval_ = 0;
+    int cookie_commit_batch_size_ = 0;
+    // Where the host names of the host cache are kept across launches, empty
+    // when they are not.
+    base::FilePath host_cache_path_;
     bool initialized_;
 
     DISALLOW_COPY_AND_ASSIGN(Handle);
@@ -90,6 +100,9 @@ class URLRequestContextGetter : public net::URLRequestContextGetter {
       content::URLRequestInterceptorScopedVector protocol_interceptors);
   ~URLRequestContextGetter() override;
 
+  // Writes the host names of the host cache to |path|.
+  void SaveHostCache(const base::FilePath& path);
+
 #if DCHECK_IS_ON()
   base::debug::LeakTracker<URLRequestContextGetter> leak_tracker_;
 #endif
@@ -9,22 +9,30 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/atom_constants.h"
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "atom/common/node_includes.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/string_util.h"
 #include "base/time/time.h"
 #include "native_mate/dictionary.h"
 #include "net/base/net_errors.h"
 #include "net/filter/gzip_source_stream.h"
+#include "net/http/http_util.h"
 
 namespace atom {
 
 namespace {
 
+// The stream is paused when more than |kHighWaterMark| bytes are waiting to
+// be read, and resumed when less than |kLowWaterMark| bytes are left.
+const size_t kHighWaterMark = 1024 * 1024;
+const size_t kLowWaterMark = 256 * 1024;
+
 void BeforeStartInUI(base::WeakPtr<URLRequestStreamJob> job,
                      mate::Arguments* args) {
   v8::Local<v8::Value> value;
@@ -68,7 +76,8 @@ void BeforeStartInUI(base::WeakPtr<URLRequestStreamJob> job,
     content::BrowserThread::PostTask(
         content::BrowserThread::IO, FROM_HERE,
         base::BindOnce(&URLRequestStreamJob::StartAsync, job, nullptr,
-                       base::RetainedRef(response_headers), ended, error));
+                       nullptr, base::RetainedRef(response_headers), ended,
+                       error));
     return;
   }
 
@@ -84,12 +93,13 @@ void BeforeStartInUI(base::WeakPtr<URLRequestStreamJob> job,
 
   auto subscriber = std::make_unique<mate::StreamSubscriber>(
       args->isolate(), data.GetHandle(), job);
+  auto weak_subscriber = subscriber->GetWeakPtr();
 
   content::BrowserThread::PostTask(
       content::BrowserThread::IO, FROM_HERE,
       base::BindOnce(&URLRequestStreamJob::StartAsync, job,
-                     std::move(subscriber), base::RetainedRef(response_headers),
-                     ended, error));
+                     std::move(subscriber), weak_subscriber,
+                     base::RetainedRef(response_headers), ended, error));
 }
 
 }  // namespace
@@ -113,6 +123,17 @@ URLRequestStreamJob::~URLRequestStreamJob() {
 void URLRequestStreamJob::Start() {
   auto request_details = std::make_unique<base::DictionaryValue>();
   FillRequestDetails(request_details.get(), request());
+  if (byte_range_.IsValid()) {
+    auto range = std::make_unique<base::DictionaryValue>();
+    if (byte_range_.IsSuffixByteRange()) {
+      range->SetDouble("suffixLength", byte_range_.suffix_length());
+    } else {
+      range->SetDouble("start", byte_range_.first_byte_position());
+      if (byte_range_.HasLastBytePosition())
+        range->SetDouble("end", byte_range_.last_byte_position());
+    }
+    request_details->Set("range", std::move(range));
+  }
   content::BrowserThread::PostTask(
       content::BrowserThread::UI, FROM_HERE,
       base::BindOnce(&JsAsker::AskForOptions, base::Unretained(isolate()),
@@ -122,6 +143,7 @@ void URLRequestStreamJob::Start() {
 
 void URLRequestStreamJob::StartAsync(
     std::unique_ptr<mate::StreamSubscriber> subscriber,
+    base::WeakPtr<mate::StreamSubscriber> weak_subscriber,
     scoped_refptr<net::HttpResponseHeaders> response_headers,
     bool ended,
     int error) {
@@ -134,29 +156,49 @@ void URLRequestStreamJob::StartAsync(
   ended_ = ended;
   response_headers_ = response_headers;
   subscriber_ = std::move(subscriber);
+  weak_subscriber_ = weak_subscriber;
+  if (!ApplyByteRange()) {
+    NotifyStartError(net::URLRequestStatus(
+        net::URLRequestStatus::FAILED, net::ERR_REQUEST_RANGE_NOT_SATISFIABLE));
+    return;
+  }
   request_start_time_ = base::TimeTicks::Now();
   NotifyHeadersComplete();
 }
 
-void URLRequestStreamJob::OnData(std::vector<char>&& buffer) {  // NOLINT
-  if (write_buffer_.empty()) {
-    // Quick branch without copying.
-    write_buffer_ = std::move(buffer);
-  } else {
-    // write_buffer_ += buffer
-    size_t len = write_buffer_.size();
-    write_buffer_.resize(len + buffer.size());
-    std::copy(buffer.begin(), buffer.end(), write_buffer_.begin() + len);
+void URLRequestStreamJob::OnData(scoped_refptr<net::IOBuffer> buffer,
+                                 int size) {
+  // Drop the parts of the stream outside of the requested range.
+  int offset = 0;
+  if (skip_bytes_ > 0) {
+    offset = static_cast<int>(std::min<int64_t>(skip_bytes_, size));
+    skip_bytes_ -= offset;
+  }
+  int length = size - offset;
+  if (remaining_bytes_ >= 0) {
+    length = static_cast<int>(std::min<int64_t>(remaining_bytes_, length));
+    remaining_bytes_ -= length;
+    if (remaining_bytes_ == 0)
+      ended_ = true;
+  }
+
+  if (length > 0) {
+    auto drainable = base::MakeRefCounted<net::DrainableIOBuffer>(
+        buffer.get(), offset + length);
+    drainable->DidConsume(offset);
+    write_buffers_.push_back(std::move(drainable));
+    buffered_size_ += length;
   }
 
   // Copy to output.
-  if (pending_buf_) {
-    int len = BufferCopy(&write_buffer_, pending_buf_.get(), pending_buf_size_);
-    write_buffer_.erase(write_buffer_.begin(), write_buffer_.begin() + len);
+  if (pending_buf_ && (!write_buffers_.empty() || ended_)) {
+    int len = BufferCopy(pending_buf_.get(), pending_buf_size_);
     pending_buf_ = nullptr;
     pending_buf_size_ = 0;
     ReadRawDataComplete(len);
   }
+
+  UpdateFlowControl();
 }
 
 void URLRequestStreamJob::OnEnd() {
@@ -173,33 +215,45 @@ void URLRequestStreamJob::OnError(int error) {
 int URLRequestStreamJob::ReadRawData(net::IOBuffer* dest, int dest_size) {
   response_start_time_ = base::TimeTicks::Now();
 
-  if (ended_)
-    return 0;
+  // The data written before the end of the stream is still read.
+  if (write_buffers_.empty()) {
+    if (ended_)
+      return 0;
 
-  // When write_buffer_ is empty, there is no data valable yet, we have to save
-  // the dest buffer util DataAvailable.
-  if (write_buffer_.empty()) {
+    // There is no data valable yet, we have to save the dest buffer util
+    // DataAvailable.
     pending_buf_ = dest;
     pending_buf_size_ = dest_size;
     return net::ERR_IO_PENDING;
   }
 
-  // Read from the write buffer and clear them after reading.
-  int len = BufferCopy(&write_buffer_, dest, dest_size);
-  write_buffer_.erase(write_buffer_.begin(), write_buffer_.begin() + len);
+  int len = BufferCopy(dest, dest_size);
+  UpdateFlowControl();
   return len;
 }
 
 void URLRequestStreamJob::DoneReading() {
   content::BrowserThread::DeleteSoon(content::BrowserThread::UI, FROM_HERE,
                                      std::move(subscriber_));
-  write_buffer_.clear();
+  write_buffers_.clear();
+  buffered_size_ = 0;
 }
 
 void URLRequestStreamJob::DoneReadingRedirectResponse() {
   DoneReading();
 }
 
+void URLRequestStreamJob::SetExtraRequestHeaders(
+    const net::HttpRequestHeaders& headers) {
+  std::string range_header;
+  std::vector<net::HttpByteRange> ranges;
+  // Multiple ranges are not supported, the whole stream is sent instead.
+  if (headers.GetHeader(net::HttpRequestHeaders::kRange, &range_header) &&
+      net::HttpUtil::ParseRangeHeader(range_header, &ranges) &&
+      ranges.size() == 1)
+    byte_range_ = ranges[0];
+}
+
 std::unique_ptr<net::SourceStream> URLRequestStreamJob::SetUpSourceStream() {
   std::unique_ptr<net::SourceStream> source =
       net::URLRequestJob::SetUpSourceStream();
@@ -243,12 +297,65 @@ void URLRequestStreamJob::Kill() {
   net::URLRequestJob::Kill();
 }
 
-int URLRequestStreamJob::BufferCopy(std::vector<char>* source,
-                                    net::IOBuffer* target,
-                                    int target_size) {
-  int bytes_written = std::min(static_cast<int>(source->size()), target_size);
-  memcpy(target->data(), source->data(), bytes_written);
+int URLRequestStreamJob::BufferCopy(net::IOBuffer* target, int target_size) {
+  int bytes_written = 0;
+  while (bytes_written < target_size && !write_buffers_.empty()) {
+    net::DrainableIOBuffer* source = write_buffers_.front().get();
+    int len = std::min(source->BytesRemaining(), target_size - bytes_written);
+    memcpy(target->data() + bytes_written, source->data(), len);
+    source->DidConsume(len);
+    bytes_written += len;
+    // Release the memory of the stream as soon as it has been read.
+    if (source->BytesRemaining() == 0)
+      write_buffers_.pop_front();
+  }
+  buffered_size_ -= bytes_written;
   return bytes_written;
 }
 
+bool URLRequestStreamJob::ApplyByteRange() {
+  // The handler has already answered with the range, or can not provide the
+  // length needed to slice the stream.
+  int64_t length = response_headers_->GetContentLength();
+  if (response_headers_->response_code() != net::HTTP_OK || length < 0 ||
+      response_headers_->HasHeader("Content-Encoding"))
+    return true;
+
+  response_headers_->AddHeader("Accept-Ranges: bytes");
+  if (!byte_range_.IsValid())
+    return true;
+  if (!byte_range_.ComputeBounds(length))
+    return false;
+
+  int64_t first = byte_range_.first_byte_position();
+  int64_t last = byte_range_.last_byte_position();
+  response_headers_->ReplaceStatusLine("HTTP/1.1 206 Partial Content");
+  response_headers_->RemoveHeader("Content-Length");
+  response_headers_->AddHeader(
+      base::StringPrintf("Content-Length: %" PRId64, last - first + 1));
+  response_headers_->AddHeader(base::StringPrintf(
+      "Content-Range: bytes %" PRId64 "-%" PRId64 "/%" PRId64, first, last,
+      length));
+  skip_bytes_ = first;
+  remaining_bytes_ = last - first + 1;
+  return true;
+}
+
+void URLRequestStreamJob::UpdateFlowControl() {
+  if (!subscriber_)
+    return;
+
+  if (!paused_ && buffered_size_ > kHighWaterMark) {
+    paused_ = true;
+    content::BrowserThread::PostTask(
+        content::BrowserThread::UI, FROM_HERE,
+        base::BindOnce(&mate::StreamSubscriber::Pause, weak_subscriber_));
+  } else if (paused_ && buffered_size_ < kLowWaterMark) {
+    paused_ = false;
+    content::BrowserThread::PostTask(
+        content::BrowserThread::UI, FROM_HERE,
+        base::BindOnce(&mate::StreamSubscriber::Resume, weak_subscriber_));
+  }
+}
+
 }  // namespace atom
@@ -7,12 +7,13 @@
 
 #include <memory>
 #include <string>
-#include <vector>
 
 #include "atom/browser/api/stream_subscriber.h"
 #include "atom/browser/net/js_asker.h"
+#include "base/containers/circular_deque.h"
 #include "base/memory/scoped_refptr.h"
 #include "net/base/io_buffer.h"
+#include "net/http/http_byte_range.h"
 #include "net/http/http_status_code.h"
 #include "net/url_request/url_request_job.h"
 
@@ -25,17 +26,21 @@ class URLRequestStreamJob : public JsAsker, public net::URLRequestJob {
   ~URLRequestStreamJob() override;
 
   void StartAsync(std::unique_ptr<mate::StreamSubscriber> subscriber,
+                  base::WeakPtr<mate::StreamSubscriber> weak_subscriber,
                   scoped_refptr<net::HttpResponseHeaders> response_headers,
                   bool ended,
                   int error);
 
-  void OnData(std::vector<char>&& buffer);  // NOLINT
+  // |buffer| is not copied, it is kept until all of its |size| bytes are
+  // read.
+  void OnData(scoped_refptr<net::IOBuffer> buffer, int size);
   void OnEnd();
   void OnError(int error);
 
  protected:
   // URLRequestJob
   void Start() override;
+  void SetExtraRequestHeaders(const net::HttpRequestHeaders& headers) override;
   int ReadRawData(net::IOBuffer* buf, int buf_size) override;
   void DoneReading() override;
   void DoneReadingRedirectResponse() override;
@@ -47,22 +52,37 @@ class URLRequestStreamJob : public JsAsker, public net::URLRequestJob {
   void Kill() override;
 
  private:
-  int BufferCopy(std::vector<char>* source,
-                 net::IOBuffer* target,
-                 int target_size);
+  // Moves up to |target_size| bytes of the written buffers to |target|.
+  int BufferCopy(net::IOBuffer* target, int target_size);
+  // Pauses the stream when too much data is waiting to be read, and resumes
+  // it once the reader catches up.
+  void UpdateFlowControl();
+  // Turns a full response into the partial response of |byte_range_|, when
+  // its length is known. Returns false when the range can not be satisfied.
+  bool ApplyByteRange();
 
   // Saved arguments passed to ReadRawData.
   scoped_refptr<net::IOBuffer> pending_buf_;
   int pending_buf_size_;
 
   // Saved arguments passed to OnData.
-  std::vector<char> write_buffer_;
+  base::circular_deque<scoped_refptr<net::DrainableIOBuffer>> write_buffers_;
+  size_t buffered_size_ = 0;
+  bool paused_ = false;
+
+  // The requested range, and the part of the stream it selects when the
+  // job has to slice a full response itself.
+  net::HttpByteRange byte_range_;
+  int64_t skip_bytes_ = 0;
+  int64_t remaining_bytes_ = -1;
 
   bool ended_;
   base::TimeTicks request_start_time_;
   base::TimeTicks response_start_time_;
   scoped_refptr<net::HttpResponseHeaders> response_headers_;
   std::unique_ptr<mate::StreamSubscriber> subscriber_;
+  // Only dereferenced on the UI thread.
+  base::WeakPtr<mate::StreamSubscriber> weak_subscriber_;
 
   base::WeakPtrFactory<URLRequestStreamJob> weak_factory_;
 
@@ -11,6 +11,7 @@
 #include "atom/common/atom_constants.h"
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "atom/common/native_mate_converters/v8_value_converter.h"
+#include "base/memory/ref_counted_memory.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/net_errors.h"
 
@@ -52,6 +53,16 @@ URLRequestStringJob::URLRequestStringJob(net::URLRequest* request,
 URLRequestStringJob::~URLRequestStringJob() = default;
 
 void URLRequestStringJob::Start() {
+  ProtocolResponseCache::Response cached;
+  if (response_cache() && response_cache()->Get(request(), &cached)) {
+    mime_type_ = cached.mime_type;
+    charset_ = cached.charset;
+    etag_ = cached.etag;
+    data_.assign(cached.data->front_as<char>(), cached.data->size());
+    net::URLRequestSimpleJob::Start();
+    return;
+  }
+
   auto request_details = std::make_unique<base::DictionaryValue>();
   FillRequestDetails(request_details.get(), request());
   content::BrowserThread::PostTask(
@@ -78,6 +89,17 @@ void URLRequestStringJob::StartAsync(std::unique_ptr<base::Value> options,
   } else if (options->is_string()) {
     data_ = options->GetString();
   }
+
+  // Only copy the data when the handler asks for it to be cached.
+  if (response_cache() && options->is_dict() && options->FindKey("cache")) {
+    std::string data = data_;
+    ProtocolResponseCache::Response response;
+    response.mime_type = mime_type_;
+    response.charset = charset_;
+    response.data = base::RefCountedString::TakeString(&data);
+    response_cache()->PutFromOptions(request(), *options, &response);
+    etag_ = response.etag;
+  }
   net::URLRequestSimpleJob::Start();
 }
 
@@ -99,6 +121,9 @@ void URLRequestStringJob::GetResponseInfo(net::HttpResponseInfo* info) {
     headers->AddHeader(content_type_header);
   }
 
+  if (!etag_.empty())
+    headers->AddHeader("ETag: " + etag_);
+
   info->headers = headers;
 }
 
@@ -34,6 +34,7 @@ class URLRequestStringJob : public JsAsker, public net::URLRequestSimpleJob {
  private:
   std::string mime_type_;
   std::string charset_;
+  std::string etag_;
   std::string data_;
 
   base::WeakPtrFactory<URLRequestStringJob> weak_factory_;
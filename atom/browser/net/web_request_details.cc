@@ -0,0 +1,61 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/web_request_details.h"
+
+#include "base/memory/ref_counted.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+
+namespace atom {
+
+WebRequestDetails::WebRequestDetails() = default;
+
+WebRequestDetails::~WebRequestDetails() = default;
+
+void WebRequestDetails::SetRequestHeaders(
+    const std::string& key,
+    const net::HttpRequestHeaders& headers) {
+  lazy_headers_.push_back({key, HeadersType::REQUEST, headers.ToString()});
+}
+
+void WebRequestDetails::SetResponseHeaders(
+    const std::string& key,
+    const net::HttpResponseHeaders& headers) {
+  lazy_headers_.push_back({key, HeadersType::RESPONSE, headers.raw_headers()});
+}
+
+// static
+std::unique_ptr<base::DictionaryValue> WebRequestDetails::ParseHeaders(
+    HeadersType type,
+    const std::string& raw) {
+  auto dict = std::make_unique<base::DictionaryValue>();
+  if (type == HeadersType::REQUEST) {
+    net::HttpRequestHeaders headers;
+    headers.AddHeadersFromString(raw);
+    net::HttpRequestHeaders::Iterator it(headers);
+    while (it.GetNext())
+      dict->SetKey(it.name(), base::Value(it.value()));
+    return dict;
+  }
+
+  auto headers = base::MakeRefCounted<net::HttpResponseHeaders>(raw);
+  size_t iter = 0;
+  std::string key;
+  std::string value;
+  while (headers->EnumerateHeaderLines(&iter, &key, &value)) {
+    if (dict->FindKey(key)) {
+      base::ListValue* values = nullptr;
+      if (dict->GetList(key, &values))
+        values->AppendString(value);
+    } else {
+      auto values = std::make_unique<base::ListValue>();
+      values->AppendString(value);
+      dict->Set(key, std::move(values));
+    }
+  }
+  return dict;
+}
+
+}  // namespace atom
@@ -0,0 +1,61 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_WEB_REQUEST_DETAILS_H_
+#define ATOM_BROWSER_NET_WEB_REQUEST_DETAILS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/values.h"
+
+namespace net {
+class HttpRequestHeaders;
+class HttpResponseHeaders;
+}  // namespace net
+
+namespace atom {
+
+// The details object of a webRequest event. The headers are kept in their
+// wire format and are only turned into objects when the listener reads
+// them, so the IO thread does not build dictionaries nobody looks at.
+class WebRequestDetails {
+ public:
+  enum class HeadersType { REQUEST, RESPONSE };
+
+  struct LazyHeaders {
+    std::string key;
+    HeadersType type;
+    std::string raw;
+  };
+
+  WebRequestDetails();
+  ~WebRequestDetails();
+
+  base::DictionaryValue* dict() { return &dict_; }
+  const base::DictionaryValue& dict() const { return dict_; }
+  const std::vector<LazyHeaders>& lazy_headers() const { return lazy_headers_; }
+
+  void SetRequestHeaders(const std::string& key,
+                         const net::HttpRequestHeaders& headers);
+  void SetResponseHeaders(const std::string& key,
+                          const net::HttpResponseHeaders& headers);
+
+  // Parses the headers stored by SetRequestHeaders and SetResponseHeaders.
+  static std::unique_ptr<base::DictionaryValue> ParseHeaders(
+      HeadersType type,
+      const std::string& raw);
+
+ private:
+  base::DictionaryValue dict_;
+  std::vector<LazyHeaders> lazy_headers_;
+
+  DISALLOW_COPY_AND_ASSIGN(WebRequestDetails);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_WEB_REQUEST_DETAILS_H_
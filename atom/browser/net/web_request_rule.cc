@@ -0,0 +1,93 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/web_request_rule.h"
+
+#include "atom/browser/net/atom_network_delegate.h"
+#include "base/stl_util.h"
+#include "content/public/browser/resource_request_info.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/url_request/url_request.h"
+
+namespace atom {
+
+WebRequestRule::WebRequestRule() = default;
+
+WebRequestRule::WebRequestRule(const WebRequestRule& other) = default;
+
+WebRequestRule::~WebRequestRule() = default;
+
+bool WebRequestRule::Matches(net::URLRequest* request) const {
+  if (!resource_types.empty()) {
+    const auto* info = content::ResourceRequestInfo::ForRequest(request);
+    const char* type =
+        info ? ResourceTypeToString(info->GetResourceType()) : "other";
+    if (!base::ContainsKey(resource_types, type))
+      return false;
+  }
+
+  return url_matcher.MatchesURL(request->url());
+}
+
+int ApplyRequestRules(const WebRequestRules& rules,
+                      net::URLRequest* request,
+                      GURL* new_url) {
+  for (const auto& rule : rules) {
+    if (!rule.cancel && rule.redirect_url.is_empty())
+      continue;
+    if (!rule.Matches(request))
+      continue;
+    if (rule.cancel)
+      return net::ERR_BLOCKED_BY_CLIENT;
+    // Do not redirect a request that has already been redirected by the rule.
+    if (rule.redirect_url != request->url()) {
+      *new_url = rule.redirect_url;
+      break;
+    }
+  }
+  return net::OK;
+}
+
+void ApplyRequestHeaderRules(const WebRequestRules& rules,
+                             net::URLRequest* request,
+                             net::HttpRequestHeaders* headers) {
+  for (const auto& rule : rules) {
+    if (rule.set_request_headers.empty() && rule.remove_request_headers.empty())
+      continue;
+    if (!rule.Matches(request))
+      continue;
+    for (const auto& name : rule.remove_request_headers)
+      headers->RemoveHeader(name);
+    for (const auto& header : rule.set_request_headers)
+      headers->SetHeader(header.first, header.second);
+  }
+}
+
+void ApplyResponseHeaderRules(
+    const WebRequestRules& rules,
+    net::URLRequest* request,
+    const net::HttpResponseHeaders* original_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_headers) {
+  for (const auto& rule : rules) {
+    if (rule.set_response_headers.empty() &&
+        rule.remove_response_headers.empty())
+      continue;
+    if (!rule.Matches(request))
+      continue;
+    // Only copy the headers once a rule actually changes them.
+    if (!*override_headers)
+      *override_headers =
+          new net::HttpResponseHeaders(original_headers->raw_headers());
+    for (const auto& name : rule.remove_response_headers)
+      (*override_headers)->RemoveHeader(name);
+    for (const auto& header : rule.set_response_headers) {
+      (*override_headers)->RemoveHeader(header.first);
+      (*override_headers)->AddHeader(header.first + ": " + header.second);
+    }
+  }
+}
+
+}  // namespace atom
@@ -0,0 +1,72 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_WEB_REQUEST_RULE_H_
+#define ATOM_BROWSER_NET_WEB_REQUEST_RULE_H_
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "atom/browser/net/url_pattern_matcher.h"
+#include "base/memory/ref_counted.h"
+#include "url/gurl.h"
+
+namespace net {
+class HttpRequestHeaders;
+class HttpResponseHeaders;
+class URLRequest;
+}  // namespace net
+
+namespace atom {
+
+// A declarative rule of the webRequest API. Rules are evaluated on the IO
+// thread, so the requests they match never wait for the UI thread.
+struct WebRequestRule {
+  using Headers = std::vector<std::pair<std::string, std::string>>;
+
+  WebRequestRule();
+  WebRequestRule(const WebRequestRule& other);
+  ~WebRequestRule();
+
+  // Whether |request| passes the URL and resource type filters of the rule.
+  bool Matches(net::URLRequest* request) const;
+
+  // Empty for all URLs.
+  URLPatternMatcher url_matcher;
+  // Values returned by ResourceTypeToString, empty for all types.
+  std::set<std::string> resource_types;
+
+  bool cancel = false;
+  GURL redirect_url;
+  Headers set_request_headers;
+  std::vector<std::string> remove_request_headers;
+  Headers set_response_headers;
+  std::vector<std::string> remove_response_headers;
+};
+
+using WebRequestRules = std::vector<WebRequestRule>;
+
+// Returns net::ERR_BLOCKED_BY_CLIENT when a rule cancels |request|, otherwise
+// net::OK with |new_url| set by the first matching redirect rule.
+int ApplyRequestRules(const WebRequestRules& rules,
+                      net::URLRequest* request,
+                      GURL* new_url);
+
+// Applies the header changes of the matching rules in order.
+void ApplyRequestHeaderRules(const WebRequestRules& rules,
+                             net::URLRequest* request,
+                             net::HttpRequestHeaders* headers);
+
+// Leaves |override_headers| untouched when no rule changes the headers.
+void ApplyResponseHeaderRules(
+    const WebRequestRules& rules,
+    net::URLRequest* request,
+    const net::HttpResponseHeaders* original_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_headers);
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_WEB_REQUEST_RULE_H_
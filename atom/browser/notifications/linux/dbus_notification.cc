@@ -0,0 +1,60 @@
+// Copyright (c) 2015 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/notifications/linux/dbus_notification.h"
+
+#include "atom/browser/notifications/linux/notification_presenter_linux.h"
+#include "atom/browser/notifications/notification_delegate.h"
+
+namespace atom {
+
+DBusNotification::DBusNotification(NotificationDelegate* delegate,
+                                   NotificationPresenterLinux* presenter)
+    : Notification(delegate, presenter),
+      presenter_(presenter->GetWeakPtr()) {}
+
+DBusNotification::~DBusNotification() {
+  // The presenter is gone when it destroys its remaining notifications.
+  if (presenter_)
+    presenter_->ForgetNotification(this);
+}
+
+void DBusNotification::Show(const NotificationOptions& options) {
+  shown_ = true;
+  presenter_->Notify(this, options);
+}
+
+void DBusNotification::Dismiss() {
+  if (!shown_) {
+    Destroy();
+    return;
+  }
+  if (dismissed_)
+    return;
+  dismissed_ = true;
+  // Closed once the server has told its ID.
+  if (id_ == 0)
+    return;
+  presenter_->CloseNotification(id_);
+}
+
+void DBusNotification::OnShown(uint32_t id) {
+  id_ = id;
+  if (dismissed_) {
+    dismissed_ = false;
+    Dismiss();
+    return;
+  }
+  if (delegate())
+    delegate()->NotificationDisplayed();
+}
+
+void DBusNotification::OnShowFailed() {
+  if (dismissed_)
+    NotificationDismissed();
+  else
+    NotificationFailed();
+}
+
+}  // namespace atom
@@ -0,0 +1,47 @@
+// Copyright (c) 2015 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NOTIFICATIONS_LINUX_DBUS_NOTIFICATION_H_
+#define ATOM_BROWSER_NOTIFICATIONS_LINUX_DBUS_NOTIFICATION_H_
+
+#include "atom/browser/notifications/notification.h"
+#include "base/memory/weak_ptr.h"
+
+namespace atom {
+
+class NotificationPresenterLinux;
+
+// A notification of the org.freedesktop.Notifications server, shown through
+// NotificationPresenterLinux.
+class DBusNotification : public Notification {
+ public:
+  DBusNotification(NotificationDelegate* delegate,
+                   NotificationPresenterLinux* presenter);
+  ~DBusNotification() override;
+
+  // Notification:
+  void Show(const NotificationOptions& options) override;
+  void Dismiss() override;
+
+  // Called by the presenter.
+  void OnShown(uint32_t id);
+  void OnShowFailed();
+
+  uint32_t id() const { return id_; }
+
+ private:
+  base::WeakPtr<NotificationPresenterLinux> presenter_;
+
+  bool shown_ = false;
+  // The ID on the server, 0 until the server has replied.
+  uint32_t id_ = 0;
+  // Whether the notification was dismissed before the server replied.
+  bool dismissed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(DBusNotification);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NOTIFICATIONS_LINUX_DBUS_NOTIFICATION_H_
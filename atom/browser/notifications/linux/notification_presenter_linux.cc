@@ -5,24 +5,395 @@
 
 #include "atom/browser/notifications/linux/notification_presenter_linux.h"
 
-#include "atom/browser/notifications/linux/libnotify_notification.h"
+#include <stdlib.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "atom/browser/notifications/linux/dbus_notification.h"
+#include "atom/common/application_info.h"
+#include "atom/common/platform_util.h"
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/message_loop/message_loop.h"
+#include "base/stl_util.h"
+#include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread.h"
+#include "dbus/bus.h"
+#include "dbus/message.h"
+#include "dbus/object_path.h"
+#include "dbus/object_proxy.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
 
 namespace atom {
 
+namespace {
+
+const char kNotificationsService[] = "org.freedesktop.Notifications";
+const char kNotificationsPath[] = "/org/freedesktop/Notifications";
+const char kNotificationsInterface[] = "org.freedesktop.Notifications";
+
+const char kDBusService[] = "org.freedesktop.DBus";
+const char kDBusPath[] = "/org/freedesktop/DBus";
+const char kDBusInterface[] = "org.freedesktop.DBus";
+
+const char kDefaultAction[] = "default";
+
+// Appends the "image-data" hint, which is the (iiibiiay) struct of the
+// specification holding non-premultiplied RGBA pixels.
+void AppendImageHint(dbus::MessageWriter* hints, const SkBitmap& bitmap) {
+  SkImageInfo info =
+      SkImageInfo::Make(bitmap.width(), bitmap.height(),
+                        kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);
+  std::vector<uint8_t> pixels(info.computeMinByteSize());
+  if (pixels.empty() ||
+      !bitmap.readPixels(info, pixels.data(), info.minRowBytes(), 0, 0))
+    return;
+
+  dbus::MessageWriter entry(nullptr);
+  hints->OpenDictEntry(&entry);
+  entry.AppendString("image-data");
+  dbus::MessageWriter variant(nullptr);
+  entry.OpenVariant("(iiibiiay)", &variant);
+  dbus::MessageWriter image(nullptr);
+  variant.OpenStruct(&image);
+  image.AppendInt32(info.width());
+  image.AppendInt32(info.height());
+  image.AppendInt32(info.minRowBytes());
+  image.AppendBool(true);  // has_alpha
+  image.AppendInt32(8);    // bits_per_sample
+  image.AppendInt32(4);    // channels
+  image.AppendArrayOfBytes(pixels.data(), pixels.size());
+  variant.CloseContainer(&image);
+  entry.CloseContainer(&variant);
+  hints->CloseContainer(&entry);
+}
+
+void AppendStringHint(dbus::MessageWriter* hints,
+                      const std::string& key,
+                      const std::string& value) {
+  dbus::MessageWriter entry(nullptr);
+  hints->OpenDictEntry(&entry);
+  entry.AppendString(key);
+  entry.AppendVariantOfString(value);
+  hints->CloseContainer(&entry);
+}
+
+}  // namespace
+
 // static
 NotificationPresenter* NotificationPresenter::Create() {
-  if (!LibnotifyNotification::Initialize())
-    return nullptr;
   return new NotificationPresenterLinux;
 }
 
-NotificationPresenterLinux::NotificationPresenterLinux() {}
+NotificationPresenterLinux::NotificationPresenterLinux()
+    : dbus_thread_(new base::Thread("Notifications D-Bus")),
+      weak_factory_(this) {
+  base::Thread::Options thread_options;
+  thread_options.message_loop_type = base::MessageLoop::TYPE_IO;
+  dbus_thread_->StartWithOptions(thread_options);
 
-NotificationPresenterLinux::~NotificationPresenterLinux() {}
+  dbus::Bus::Options bus_options;
+  bus_options.bus_type = dbus::Bus::SESSION;
+  bus_options.connection_type = dbus::Bus::PRIVATE;
+  bus_options.dbus_task_runner = dbus_thread_->task_runner();
+  bus_ = new dbus::Bus(bus_options);
+  proxy_ = bus_->GetObjectProxy(kNotificationsService,
+                                dbus::ObjectPath(kNotificationsPath));
+  bus_proxy_ = bus_->GetObjectProxy(kDBusService, dbus::ObjectPath(kDBusPath));
+
+  RequestCapabilities();
+
+  // The bus daemon tells whether the server is running, or can be started by
+  // D-Bus activation on the first notification, and when that changes.
+  bus_proxy_->ConnectToSignal(
+      kDBusInterface, "NameOwnerChanged",
+      base::BindRepeating(&NotificationPresenterLinux::OnNameOwnerChanged,
+                          weak_factory_.GetWeakPtr()),
+      base::BindOnce(&NotificationPresenterLinux::OnSignalConnected,
+                     weak_factory_.GetWeakPtr()));
+  dbus::MethodCall has_owner_call(kDBusInterface, "NameHasOwner");
+  dbus::MessageWriter writer(&has_owner_call);
+  writer.AppendString(kNotificationsService);
+  bus_proxy_->CallMethod(
+      &has_owner_call, dbus::ObjectProxy::TIMEOUT_USE_DEFAULT,
+      base::BindOnce(&NotificationPresenterLinux::OnNameHasOwner,
+                     weak_factory_.GetWeakPtr()));
+  dbus::MethodCall activatable_call(kDBusInterface, "ListActivatableNames");
+  bus_proxy_->CallMethod(
+      &activatable_call, dbus::ObjectProxy::TIMEOUT_USE_DEFAULT,
+      base::BindOnce(&NotificationPresenterLinux::OnActivatableNames,
+                     weak_factory_.GetWeakPtr()));
+
+  proxy_->ConnectToSignal(
+      kNotificationsInterface, "ActionInvoked",
+      base::BindRepeating(&NotificationPresenterLinux::OnActionInvoked,
+                          weak_factory_.GetWeakPtr()),
+      base::BindOnce(&NotificationPresenterLinux::OnSignalConnected,
+                     weak_factory_.GetWeakPtr()));
+  proxy_->ConnectToSignal(
+      kNotificationsInterface, "NotificationClosed",
+      base::BindRepeating(&NotificationPresenterLinux::OnNotificationClosed,
+                          weak_factory_.GetWeakPtr()),
+      base::BindOnce(&NotificationPresenterLinux::OnSignalConnected,
+                     weak_factory_.GetWeakPtr()));
+}
+
+NotificationPresenterLinux::~NotificationPresenterLinux() {
+  bus_->ShutdownOnDBusThreadAndBlock();
+  dbus_thread_->Stop();
+}
+
+void NotificationPresenterLinux::Notify(DBusNotification* notification,
+                                        const NotificationOptions& options) {
+  // The server might not have been running when it was first asked.
+  if (capabilities_failed_)
+    RequestCapabilities();
+
+  if (!capabilities_received_) {
+    pending_notifications_.push_back(base::BindOnce(
+        [](base::WeakPtr<NotificationPresenterLinux> self,
+           base::WeakPtr<Notification> notification,
+           const NotificationOptions& options) {
+          if (self && notification)
+            self->Notify(static_cast<DBusNotification*>(notification.get()),
+                         options);
+        },
+        weak_factory_.GetWeakPtr(), notification->GetWeakPtr(), options));
+    return;
+  }
+
+  dbus::MethodCall method_call(kNotificationsInterface, "Notify");
+  dbus::MessageWriter writer(&method_call);
+  writer.AppendString(GetApplicationName());
+
+  // A notification replaces the last one shown with the same tag.
+  uint32_t replaces_id = 0;
+  if (!options.tag.empty()) {
+    auto iter = ids_by_tag_.find(options.tag);
+    if (iter != ids_by_tag_.end())
+      replaces_id = iter->second;
+  }
+  writer.AppendUint32(replaces_id);
+
+  writer.AppendString("");  // app_icon
+  writer.AppendString(base::UTF16ToUTF8(options.title));
+  writer.AppendString(base::UTF16ToUTF8(options.msg));
+
+  // NB: On Unity and on any other DE using Notify-OSD, adding a notification
+  // action will cause the notification to display as a modal dialog box.
+  std::vector<std::string> actions;
+  if (!getenv("ELECTRON_USE_UBUNTU_NOTIFIER") && HasCapability("actions")) {
+    actions.push_back(kDefaultAction);
+    actions.push_back("View");
+  }
+  writer.AppendArrayOfStrings(actions);
+
+  dbus::MessageWriter hints(nullptr);
+  writer.OpenArray("{sv}", &hints);
+  // Always try to append notifications.
+  // Unique tags can be used to prevent this.
+  if (HasCapability("append"))
+    AppendStringHint(&hints, "append", "true");
+  else if (HasCapability("x-canonical-append"))
+    AppendStringHint(&hints, "x-canonical-append", "true");
+
+  // Send the desktop name to identify the application
+  // The desktop-entry is the part before the .desktop
+  std::string desktop_id;
+  if (platform_util::GetDesktopName(&desktop_id)) {
+    const std::string suffix{".desktop"};
+    if (base::EndsWith(desktop_id, suffix,
+                       base::CompareCase::INSENSITIVE_ASCII)) {
+      desktop_id.resize(desktop_id.size() - suffix.size());
+    }
+    AppendStringHint(&hints, "desktop-entry", desktop_id);
+  }
+
+  if (!options.icon.drawsNothing())
+    AppendImageHint(&hints, options.icon);
+  writer.CloseContainer(&hints);
+
+  writer.AppendInt32(-1);  // expire_timeout, the default of the server
+
+  proxy_->CallMethod(
+      &method_call, dbus::ObjectProxy::TIMEOUT_USE_DEFAULT,
+      base::BindOnce(&NotificationPresenterLinux::OnNotifyResponse,
+                     weak_factory_.GetWeakPtr(), notification->GetWeakPtr(),
+                     options.tag));
+}
+
+void NotificationPresenterLinux::CloseNotification(uint32_t id) {
+  dbus::MethodCall method_call(kNotificationsInterface, "CloseNotification");
+  dbus::MessageWriter writer(&method_call);
+  writer.AppendUint32(id);
+  proxy_->CallMethod(
+      &method_call, dbus::ObjectProxy::TIMEOUT_USE_DEFAULT,
+      base::BindOnce(&NotificationPresenterLinux::OnCloseResponse,
+                     weak_factory_.GetWeakPtr(), id));
+}
+
+bool NotificationPresenterLinux::IsAvailable() {
+  // Until the bus daemon has answered the server is assumed to be there, a
+  // notification shown meanwhile fails like one shown after it went away.
+  if (!has_owner_received_ || !activatable_received_)
+    return true;
+  return has_owner_ || activatable_;
+}
+
+void NotificationPresenterLinux::ForgetNotification(
+    DBusNotification* notification) {
+  auto iter = notifications_by_id_.find(notification->id());
+  if (iter != notifications_by_id_.end() && iter->second == notification)
+    notifications_by_id_.erase(iter);
+}
 
 Notification* NotificationPresenterLinux::CreateNotificationObject(
     NotificationDelegate* delegate) {
-  return new LibnotifyNotification(delegate, this);
+  return new DBusNotification(delegate, this);
+}
+
+bool NotificationPresenterLinux::HasCapability(
+    const std::string& capability) const {
+  return capabilities_.count(capability) != 0;
+}
+
+void NotificationPresenterLinux::RequestCapabilities() {
+  capabilities_received_ = false;
+  capabilities_failed_ = false;
+  dbus::MethodCall method_call(kNotificationsInterface, "GetCapabilities");
+  proxy_->CallMethod(
+      &method_call, dbus::ObjectProxy::TIMEOUT_USE_DEFAULT,
+      base::BindOnce(&NotificationPresenterLinux::OnCapabilities,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void NotificationPresenterLinux::OnCapabilities(dbus::Response* response) {
+  std::vector<std::string> capabilities;
+  dbus::MessageReader reader(response);
+  if (!response || !reader.PopArrayOfStrings(&capabilities)) {
+    LOG(WARNING) << "Unable to get the capabilities of the notification server";
+    // The pending notifications are still sent, they fail if the server is
+    // gone, and the capabilities are asked for again with the next one.
+    capabilities_failed_ = true;
+  }
+  capabilities_ = std::set<std::string>(capabilities.begin(),
+                                        capabilities.end());
+  capabilities_received_ = true;
+
+  std::vector<base::OnceClosure> pending;
+  pending.swap(pending_notifications_);
+  for (auto& notify : pending)
+    std::move(notify).Run();
+}
+
+void NotificationPresenterLinux::OnNotifyResponse(
+    base::WeakPtr<Notification> notification,
+    const std::string& tag,
+    dbus::Response* response) {
+  uint32_t id = 0;
+  dbus::MessageReader reader(response);
+  if (!response || !reader.PopUint32(&id) || id == 0) {
+    LOG(ERROR) << "Unable to show the notification";
+    if (notification)
+      static_cast<DBusNotification*>(notification.get())->OnShowFailed();
+    return;
+  }
+
+  // The server does not tell when it replaces a notification, to the app the
+  // old one is gone.
+  auto iter = notifications_by_id_.find(id);
+  if (iter != notifications_by_id_.end()) {
+    DBusNotification* replaced = iter->second;
+    notifications_by_id_.erase(iter);
+    if (replaced != notification.get())
+      replaced->NotificationDismissed();
+  }
+
+  if (!tag.empty())
+    ids_by_tag_[tag] = id;
+  if (!notification) {
+    CloseNotification(id);
+    return;
+  }
+  auto* dbus_notification = static_cast<DBusNotification*>(notification.get());
+  notifications_by_id_[id] = dbus_notification;
+  dbus_notification->OnShown(id);
+}
+
+void NotificationPresenterLinux::OnCloseResponse(uint32_t id,
+                                                 dbus::Response* response) {
+  // Otherwise the server emits "NotificationClosed".
+  if (response)
+    return;
+  auto iter = notifications_by_id_.find(id);
+  if (iter != notifications_by_id_.end())
+    iter->second->Destroy();
+}
+
+void NotificationPresenterLinux::OnActionInvoked(dbus::Signal* signal) {
+  uint32_t id;
+  std::string action;
+  dbus::MessageReader reader(signal);
+  if (!reader.PopUint32(&id) || !reader.PopString(&action))
+    return;
+  auto iter = notifications_by_id_.find(id);
+  if (iter != notifications_by_id_.end() && action == kDefaultAction)
+    iter->second->NotificationClicked();
+}
+
+void NotificationPresenterLinux::OnNotificationClosed(dbus::Signal* signal) {
+  uint32_t id;
+  dbus::MessageReader reader(signal);
+  if (!reader.PopUint32(&id))
+    return;
+  auto iter = notifications_by_id_.find(id);
+  if (iter != notifications_by_id_.end())
+    iter->second->NotificationDismissed();
+}
+
+void NotificationPresenterLinux::OnNameHasOwner(dbus::Response* response) {
+  dbus::MessageReader reader(response);
+  if (!response || !reader.PopBool(&has_owner_))
+    has_owner_ = false;
+  has_owner_received_ = true;
+}
+
+void NotificationPresenterLinux::OnActivatableNames(dbus::Response* response) {
+  std::vector<std::string> names;
+  dbus::MessageReader reader(response);
+  activatable_ = response && reader.PopArrayOfStrings(&names) &&
+                 base::ContainsValue(names, kNotificationsService);
+  activatable_received_ = true;
+}
+
+void NotificationPresenterLinux::OnNameOwnerChanged(dbus::Signal* signal) {
+  std::string name;
+  std::string old_owner;
+  std::string new_owner;
+  dbus::MessageReader reader(signal);
+  if (!reader.PopString(&name) || !reader.PopString(&old_owner) ||
+      !reader.PopString(&new_owner) || name != kNotificationsService)
+    return;
+  has_owner_ = !new_owner.empty();
+  has_owner_received_ = true;
+  // A server that was started after the first request has its own
+  // capabilities.
+  if (has_owner_ && (capabilities_failed_ || !old_owner.empty()))
+    RequestCapabilities();
+}
+
+void NotificationPresenterLinux::OnSignalConnected(
+    const std::string& interface_name,
+    const std::string& signal_name,
+    bool success) {
+  if (!success)
+    LOG(WARNING) << "Unable to connect to " << interface_name << "."
+                 << signal_name;
 }
 
 }  // namespace atom
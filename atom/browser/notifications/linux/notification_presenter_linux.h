@@ -6,19 +6,106 @@
 #ifndef ATOM_BROWSER_NOTIFICATIONS_LINUX_NOTIFICATION_PRESENTER_LINUX_H_
 #define ATOM_BROWSER_NOTIFICATIONS_LINUX_NOTIFICATION_PRESENTER_LINUX_H_
 
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "atom/browser/notifications/notification_presenter.h"
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+
+namespace base {
+class Thread;
+}
+
+namespace dbus {
+class Bus;
+class ObjectProxy;
+class Response;
+class Signal;
+}  // namespace dbus
 
 namespace atom {
 
+class DBusNotification;
+
+// Talks to the notification server over D-Bus. The connection lives on its
+// own thread, the calls do not wait for their replies, and the replies and
+// signals of the server are posted back to the UI thread.
 class NotificationPresenterLinux : public NotificationPresenter {
  public:
   NotificationPresenterLinux();
   ~NotificationPresenterLinux() override;
 
+  // Asks the server to show |notification|, which is told its ID once the
+  // server has replied.
+  void Notify(DBusNotification* notification,
+              const NotificationOptions& options);
+  // Asks the server to close the notification |id|.
+  void CloseNotification(uint32_t id);
+  // Called when |notification| is destroyed.
+  void ForgetNotification(DBusNotification* notification);
+
+  base::WeakPtr<NotificationPresenterLinux> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+  // NotificationPresenter:
+  bool IsAvailable() override;
+
  private:
   Notification* CreateNotificationObject(
       NotificationDelegate* delegate) override;
 
+  bool HasCapability(const std::string& capability) const;
+
+  // Asks the server for its capabilities, the notifications wait for them.
+  void RequestCapabilities();
+
+  void OnCapabilities(dbus::Response* response);
+  void OnNotifyResponse(base::WeakPtr<Notification> notification,
+                        const std::string& tag,
+                        dbus::Response* response);
+  void OnCloseResponse(uint32_t id, dbus::Response* response);
+  void OnActionInvoked(dbus::Signal* signal);
+  void OnNotificationClosed(dbus::Signal* signal);
+  void OnNameHasOwner(dbus::Response* response);
+  void OnActivatableNames(dbus::Response* response);
+  void OnNameOwnerChanged(dbus::Signal* signal);
+  void OnSignalConnected(const std::string& interface_name,
+                         const std::string& signal_name,
+                         bool success);
+
+  std::unique_ptr<base::Thread> dbus_thread_;
+  scoped_refptr<dbus::Bus> bus_;
+  dbus::ObjectProxy* proxy_;      // owned by |bus_|
+  dbus::ObjectProxy* bus_proxy_;  // owned by |bus_|
+
+  // Whether the server is running, and whether the bus daemon can start it,
+  // as last reported by the bus daemon.
+  bool has_owner_ = false;
+  bool has_owner_received_ = false;
+  bool activatable_ = false;
+  bool activatable_received_ = false;
+
+  // The notifications are sent once the capabilities of the server are known.
+  std::set<std::string> capabilities_;
+  bool capabilities_received_ = false;
+  // Whether the server did not answer the last request for its capabilities.
+  bool capabilities_failed_ = false;
+  std::vector<base::OnceClosure> pending_notifications_;
+
+  // The shown notifications, by their ID on the server.
+  std::map<uint32_t, DBusNotification*> notifications_by_id_;
+  // The ID of the last notification shown with each tag, a notification with
+  // the same tag replaces it.
+  std::map<std::string, uint32_t> ids_by_tag_;
+
+  base::WeakPtrFactory<NotificationPresenterLinux> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(NotificationPresenterLinux);
 };
 
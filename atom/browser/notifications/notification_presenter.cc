@@ -7,9 +7,32 @@
 #include <algorithm>
 
 #include "atom/browser/notifications/notification.h"
+#include "base/bind.h"
+#include "base/strings/utf_string_conversions.h"
 
 namespace atom {
 
+namespace {
+
+// Bursts of notifications, e.g. from a chat, are spread over time instead of
+// flooding the screen and the notification service.
+const size_t kMaxShowsPerSecond = 4;
+
+// The merged text of notifications with the same tag keeps its newest part.
+const size_t kMaxMergedTextLength = 1000;
+
+base::string16 MergeText(const base::string16& older,
+                         const base::string16& newer) {
+  if (older.empty() || older == newer)
+    return newer;
+  base::string16 merged = older + base::ASCIIToUTF16("\n") + newer;
+  if (merged.size() > kMaxMergedTextLength)
+    merged.erase(0, merged.size() - kMaxMergedTextLength);
+  return merged;
+}
+
+}  // namespace
+
 NotificationPresenter::NotificationPresenter() {}
 
 NotificationPresenter::~NotificationPresenter() {
@@ -31,6 +54,85 @@ void NotificationPresenter::RemoveNotification(Notification* notification) {
   delete notification;
 }
 
+void NotificationPresenter::ShowNotification(
+    Notification* notification,
+    const NotificationOptions& options) {
+  base::TimeDelta delay;
+  if (queue_.empty() && CanShowNotification(&delay)) {
+    recent_shows_.push_back(base::TimeTicks::Now());
+    notification->Show(options);
+    return;
+  }
+
+  if (!options.tag.empty()) {
+    for (auto& queued : queue_) {
+      if (!queued.notification || queued.options.tag != options.tag)
+        continue;
+      NotificationOptions merged = options;
+      merged.msg = MergeText(queued.options.msg, options.msg);
+      // The replaced notification is closed as if it had been shown.
+      base::WeakPtr<Notification> replaced = queued.notification;
+      queued.notification = notification->GetWeakPtr();
+      queued.options = merged;
+      replaced->NotificationDismissed();
+      return;
+    }
+  }
+
+  queue_.push_back({notification->GetWeakPtr(), options});
+  if (!queue_timer_.IsRunning() && !CanShowNotification(&delay)) {
+    queue_timer_.Start(
+        FROM_HERE, delay,
+        base::Bind(&NotificationPresenter::ShowQueuedNotifications,
+                   base::Unretained(this)));
+  }
+}
+
+void NotificationPresenter::DismissNotification(Notification* notification) {
+  auto it = std::find_if(queue_.begin(), queue_.end(),
+                         [notification](const QueuedNotification& queued) {
+                           return queued.notification.get() == notification;
+                         });
+  if (it == queue_.end()) {
+    notification->Dismiss();
+    return;
+  }
+  queue_.erase(it);
+  notification->NotificationDismissed();
+}
+
+bool NotificationPresenter::CanShowNotification(base::TimeDelta* delay) {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::TimeDelta window = base::TimeDelta::FromSeconds(1);
+  while (!recent_shows_.empty() && now - recent_shows_.front() >= window)
+    recent_shows_.pop_front();
+  if (recent_shows_.size() < kMaxShowsPerSecond)
+    return true;
+  *delay = recent_shows_.front() + window - now;
+  return false;
+}
+
+void NotificationPresenter::ShowQueuedNotifications() {
+  base::TimeDelta delay;
+  while (!queue_.empty()) {
+    if (!queue_.front().notification) {
+      queue_.pop_front();
+      continue;
+    }
+    if (!CanShowNotification(&delay)) {
+      queue_timer_.Start(
+          FROM_HERE, delay,
+          base::Bind(&NotificationPresenter::ShowQueuedNotifications,
+                     base::Unretained(this)));
+      return;
+    }
+    QueuedNotification queued = std::move(queue_.front());
+    queue_.pop_front();
+    recent_shows_.push_back(base::TimeTicks::Now());
+    queued.notification->Show(queued.options);
+  }
+}
+
 void NotificationPresenter::CloseNotificationWithId(
     const std::string& notification_id) {
   auto it = std::find_if(notifications_.begin(), notifications_.end(),
@@ -38,7 +140,11 @@ void NotificationPresenter::CloseNotificationWithId(
                            return n->notification_id() == notification_id;
                          });
   if (it != notifications_.end())
-    (*it)->Dismiss();
+    DismissNotification(*it);
+}
+
+bool NotificationPresenter::IsAvailable() {
+  return true;
 }
 
 }  // namespace atom
@@ -8,11 +8,14 @@
 #include <set>
 #include <string>
 
+#include "atom/browser/notifications/notification.h"
+#include "base/containers/circular_deque.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 
 namespace atom {
 
-class Notification;
 class NotificationDelegate;
 
 class NotificationPresenter {
@@ -26,8 +29,19 @@ class NotificationPresenter {
       const std::string& notification_id);
   void CloseNotificationWithId(const std::string& notification_id);
 
+  // Shows |notification| at once, unless too many notifications were shown in
+  // the last second, in which case it is queued. A queued notification with
+  // the same tag is replaced by it, and their texts are merged.
+  void ShowNotification(Notification* notification,
+                        const NotificationOptions& options);
+  // Dismisses |notification|, or drops it from the queue.
+  void DismissNotification(Notification* notification);
+
   std::set<Notification*> notifications() const { return notifications_; }
 
+  // Whether the notifications can be shown on the system right now.
+  virtual bool IsAvailable();
+
  protected:
   NotificationPresenter();
   virtual Notification* CreateNotificationObject(
@@ -36,10 +50,24 @@ class NotificationPresenter {
  private:
   friend class Notification;
 
+  struct QueuedNotification {
+    base::WeakPtr<Notification> notification;
+    NotificationOptions options;
+  };
+
   void RemoveNotification(Notification* notification);
 
+  // Whether another notification can be shown now, otherwise |delay| is set
+  // to when it can.
+  bool CanShowNotification(base::TimeDelta* delay);
+  void ShowQueuedNotifications();
+
   std::set<Notification*> notifications_;
 
+  base::circular_deque<QueuedNotification> queue_;
+  base::circular_deque<base::TimeTicks> recent_shows_;
+  base::OneShotTimer queue_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(NotificationPresenter);
 };
 
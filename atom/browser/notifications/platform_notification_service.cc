@@ -35,7 +35,7 @@ void OnWebNotificationAllowed(base::WeakPtr<Notification> notification,
     options.icon = icon;
     options.silent = audio_muted ? true : data.silent;
     options.has_reply = false;
-    notification->Show(options);
+    notification->presenter()->ShowNotification(notification.get(), options);
   } else {
     notification->Destroy();
   }
@@ -112,6 +112,11 @@ LRESULT CALLBACK DesktopNotificationController::WndProc(HWND hwnd,
     case WM_DISPLAYCHANGE: {
       auto* inst = Get(hwnd);
       inst->ClearAssets();
+      // The toasts measure their layout again with the new fonts.
+      for (auto&& toast : inst->instances_) {
+        if (toast.hwnd)
+          Toast::Get(toast.hwnd)->ResetContents();
+      }
       inst->AnimateAll();
     } break;
 
@@ -497,6 +497,7 @@ void DesktopNotificationController::Toast::Draw() {
   }
 
   is_content_updated_ = true;
+  is_content_uploaded_ = false;
 }
 
 void DesktopNotificationController::Toast::Invalidate() {
@@ -508,7 +509,9 @@ bool DesktopNotificationController::Toast::IsRedrawNeeded() const {
 }
 
 void DesktopNotificationController::Toast::UpdateBufferSize() {
-  if (hdc_) {
+  // The layout only changes with the contents or the fonts, see
+  // ResetContents(), so it is not measured again on every animation step.
+  if (hdc_ && !is_layout_updated_) {
     SIZE new_size;
     {
       TEXTMETRIC tm_cap = {};
@@ -571,6 +574,10 @@ void DesktopNotificationController::Toast::UpdateBufferSize() {
       }
     }
 
+    // A failed resize is tried again on the next animation step.
+    is_layout_updated_ = new_size.cx == toast_size_.cx &&
+                         new_size.cy == toast_size_.cy;
+
     if (new_size.cx != this->toast_size_.cx ||
         new_size.cy != this->toast_size_.cy) {
       HDC hdc_screen = GetDC(NULL);
@@ -593,6 +600,7 @@ void DesktopNotificationController::Toast::UpdateBufferSize() {
           this->bitmap_ = new_bitmap;
           this->toast_size_ = new_size;
 
+          is_layout_updated_ = true;
           Invalidate();
 
           // Resize also the DWM buffer to prevent flicker during
@@ -645,8 +653,11 @@ void DesktopNotificationController::Toast::UpdateContents() {
     GetWindowRect(hwnd_, &rc);
     POINT origin = {0, 0};
     SIZE size = {rc.right - rc.left, rc.bottom - rc.top};
-    UpdateLayeredWindow(hwnd_, NULL, nullptr, &size, hdc_, &origin, 0, nullptr,
-                        0);
+    if (UpdateLayeredWindow(hwnd_, NULL, nullptr, &size, hdc_, &origin, 0,
+                            nullptr, 0)) {
+      is_content_uploaded_ = true;
+      uploaded_size_ = size;
+    }
   }
 }
 
@@ -686,6 +697,7 @@ void DesktopNotificationController::Toast::ResetContents() {
     scaled_image_ = NULL;
   }
 
+  is_layout_updated_ = false;
   Invalidate();
 }
 
@@ -751,6 +763,20 @@ HDWP DesktopNotificationController::Toast::Animate(HDWP hdwp,
   ulw.pptDst = &pt;
   ulw.psize = &size;
 
+  // The rendered contents are kept by DWM, so the bitmap is only uploaded
+  // again when it was redrawn or the visible part of it changes, e.g. while
+  // easing in. Otherwise only the position and the alpha are updated.
+  bool upload_contents = !is_content_uploaded_ ||
+                         size.cx != uploaded_size_.cx ||
+                         size.cy != uploaded_size_.cy;
+  if (!upload_contents) {
+    // The size can only be given along with the contents, it is unchanged
+    // here anyway.
+    ulw.hdcSrc = NULL;
+    ulw.pptSrc = nullptr;
+    ulw.psize = nullptr;
+  }
+
   if (ease_in_active_ && ease_in_pos == 1.0f) {
     ease_in_active_ = false;
     ScheduleDismissal();
@@ -787,7 +813,10 @@ HDWP DesktopNotificationController::Toast::Animate(HDWP hdwp,
   // ULWI fails, which can happen when one of the dimensions is zero (e.g.
   // at the beginning of ease-in).
 
-  UpdateLayeredWindowIndirect(hwnd_, &ulw);
+  if (UpdateLayeredWindowIndirect(hwnd_, &ulw) && upload_contents) {
+    is_content_uploaded_ = true;
+    uploaded_size_ = size;
+  }
   hdwp = DeferWindowPos(hdwp, hwnd_, HWND_TOPMOST, pt.x, pt.y, size.cx, size.cy,
                         dwpFlags);
   return hdwp;
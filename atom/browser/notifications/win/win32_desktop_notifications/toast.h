@@ -86,6 +86,7 @@ class DesktopNotificationController::Toast {
   SIZE toast_size_ = {};
   SIZE margin_ = {};
   RECT close_button_rect_ = {};
+  SIZE uploaded_size_ = {};
   HBITMAP scaled_image_ = NULL;
 
   int vertical_pos_ = 0;
@@ -94,6 +95,8 @@ class DesktopNotificationController::Toast {
   bool ease_in_active_ = false;
   bool ease_out_active_ = false;
   bool is_content_updated_ = false;
+  bool is_content_uploaded_ = false;
+  bool is_layout_updated_ = false;
   bool is_highlighted_ = false;
   bool is_close_hot_ = false;
   DWORD ease_in_start_, ease_out_start_, stack_collapse_start_;
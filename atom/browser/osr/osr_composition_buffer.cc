@@ -0,0 +1,151 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/osr/osr_composition_buffer.h"
+
+#include <utility>
+
+#include "base/trace_event/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "ui/gfx/skia_util.h"
+
+namespace atom {
+
+namespace {
+
+// Double buffered, the app may still hold the last frame while the next one
+// is composed.
+const size_t kMaxFrames = 2;
+
+// Frames older than this many compositions are copied completely.
+const size_t kMaxHistory = 8;
+
+gfx::Rect GetBitmapRect(const SkBitmap& bitmap, const gfx::Point& origin) {
+  return gfx::Rect(origin, gfx::Size(bitmap.width(), bitmap.height()));
+}
+
+// Copies the part of |bitmap| drawn at |origin| that lies in |rect|.
+void CopyRect(SkCanvas* canvas,
+              const SkBitmap& bitmap,
+              const gfx::Point& origin,
+              const gfx::Rect& rect) {
+  gfx::Rect area = gfx::IntersectRects(GetBitmapRect(bitmap, origin), rect);
+  if (area.IsEmpty())
+    return;
+  SkBitmap subset;
+  area.Offset(-origin.x(), -origin.y());
+  if (!bitmap.extractSubset(&subset, gfx::RectToSkIRect(area)))
+    return;
+  canvas->writePixels(subset, area.x() + origin.x(), area.y() + origin.y());
+}
+
+}  // namespace
+
+OffScreenCompositionBuffer::OffScreenCompositionBuffer() {}
+
+OffScreenCompositionBuffer::~OffScreenCompositionBuffer() {}
+
+const SkBitmap& OffScreenCompositionBuffer::Compose(
+    const gfx::Size& size,
+    const SkBitmap& source,
+    const gfx::Rect& damage_rect,
+    const std::vector<Overlay>& overlays,
+    gfx::Rect* damage) {
+  TRACE_EVENT0("electron", "OffScreenCompositionBuffer::Compose");
+
+  gfx::Rect bounds(size);
+
+  // The paints of the overlays are part of |damage_rect| already, so they are
+  // only redrawn where they are and cleared where they were when they moved,
+  // appeared or went away.
+  std::vector<gfx::Rect> overlay_rects;
+  for (const auto& overlay : overlays) {
+    if (!overlay.bitmap->drawsNothing())
+      overlay_rects.push_back(GetBitmapRect(*overlay.bitmap, overlay.origin));
+  }
+
+  std::vector<gfx::Rect> changed;
+  if (overlay_rects != overlay_rects_) {
+    changed = overlay_rects;
+    changed.insert(changed.end(), overlay_rects_.begin(), overlay_rects_.end());
+  }
+  changed.push_back(damage_rect);
+
+  *damage = gfx::Rect();
+  for (const auto& rect : changed)
+    damage->Union(rect);
+  damage->Intersect(bounds);
+
+  ++number_;
+  history_.push_back(changed);
+  if (history_.size() > kMaxHistory)
+    history_.pop_front();
+  overlay_rects_ = std::move(overlay_rects);
+
+  Frame* frame = GetReusableFrame(bounds.size());
+
+  // Collect what changed since |frame| was composed.
+  std::vector<gfx::Rect> copy_rects;
+  if (frame->number == 0 || number_ - frame->number > history_.size()) {
+    copy_rects.push_back(bounds);
+  } else {
+    for (size_t i = history_.size() - (number_ - frame->number);
+         i < history_.size(); ++i) {
+      for (const auto& rect : history_[i]) {
+        gfx::Rect clipped = gfx::IntersectRects(rect, bounds);
+        if (!clipped.IsEmpty())
+          copy_rects.push_back(clipped);
+      }
+    }
+  }
+
+  SkCanvas canvas(frame->bitmap);
+  for (const auto& rect : copy_rects)
+    CopyRect(&canvas, source, gfx::Point(), rect);
+  for (const auto& overlay : overlays) {
+    if (overlay.bitmap->drawsNothing())
+      continue;
+    for (const auto& rect : copy_rects)
+      CopyRect(&canvas, *overlay.bitmap, overlay.origin, rect);
+  }
+
+  frame->number = number_;
+  return frame->bitmap;
+}
+
+OffScreenCompositionBuffer::Frame* OffScreenCompositionBuffer::GetReusableFrame(
+    const gfx::Size& size) {
+  // Prefer the most recent frame nobody else holds, it needs the least
+  // copying.
+  Frame* reusable = nullptr;
+  for (auto& frame : frames_) {
+    if (!frame.bitmap.pixelRef() || frame.bitmap.width() != size.width() ||
+        frame.bitmap.height() != size.height() ||
+        !frame.bitmap.pixelRef()->unique())
+      continue;
+    if (!reusable || frame.number > reusable->number)
+      reusable = &frame;
+  }
+  if (reusable)
+    return reusable;
+
+  // Every frame is still referenced by an image or has the wrong size, let
+  // the oldest one go and allocate a new bitmap in its place.
+  if (frames_.size() < kMaxFrames) {
+    frames_.emplace_back();
+    reusable = &frames_.back();
+  } else {
+    reusable = &frames_[0];
+    for (auto& frame : frames_) {
+      if (frame.number < reusable->number)
+        reusable = &frame;
+    }
+  }
+  reusable->bitmap = SkBitmap();
+  reusable->bitmap.allocN32Pixels(size.width(), size.height(), false);
+  reusable->number = 0;
+  return reusable;
+}
+
+}  // namespace atom
@@ -0,0 +1,64 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_OSR_OSR_COMPOSITION_BUFFER_H_
+#define ATOM_BROWSER_OSR_OSR_COMPOSITION_BUFFER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/macros.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace atom {
+
+// Composes the page bitmap with the popup and the proxy views into the frames
+// handed to the "paint" event. Frames are kept in a small pool and reused
+// once no NativeImage refers to them anymore, then only the parts changed
+// since that frame was composed are copied into it.
+class OffScreenCompositionBuffer {
+ public:
+  struct Overlay {
+    const SkBitmap* bitmap;
+    gfx::Point origin;
+  };
+
+  OffScreenCompositionBuffer();
+  ~OffScreenCompositionBuffer();
+
+  // Returns a frame of |size| with |source| and then |overlays| drawn at its
+  // top left. |damage_rect| is the part of |source| that changed since the
+  // last call, |damage| receives the part of the frame that changed.
+  const SkBitmap& Compose(const gfx::Size& size,
+                          const SkBitmap& source,
+                          const gfx::Rect& damage_rect,
+                          const std::vector<Overlay>& overlays,
+                          gfx::Rect* damage);
+
+ private:
+  struct Frame {
+    SkBitmap bitmap;
+    // Number of the composition this frame holds, 0 when it holds nothing.
+    uint64_t number = 0;
+  };
+
+  Frame* GetReusableFrame(const gfx::Size& size);
+
+  std::vector<Frame> frames_;
+
+  // The rects changed by each of the last compositions, newest last.
+  base::circular_deque<std::vector<gfx::Rect>> history_;
+  uint64_t number_ = 0;
+
+  // Where the overlays were drawn by the last composition.
+  std::vector<gfx::Rect> overlay_rects_;
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenCompositionBuffer);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_OSR_OSR_COMPOSITION_BUFFER_H_
@@ -11,9 +11,13 @@
 
 namespace atom {
 
-OffScreenOutputDevice::OffScreenOutputDevice(bool transparent,
-                                             const OnPaintCallback& callback)
-    : transparent_(transparent), callback_(callback) {
+OffScreenOutputDevice::OffScreenOutputDevice(
+    bool transparent,
+    const OnPaintCallback& callback,
+    const base::Closure& drop_callback)
+    : transparent_(transparent),
+      callback_(callback),
+      drop_callback_(drop_callback) {
   DCHECK(!callback_.is_null());
 }
 
@@ -71,8 +75,8 @@ void OffScreenOutputDevice::EndPaint() {
 
   viz::SoftwareOutputDevice::EndPaint();
 
-  if (active_)
-    OnPaint(damage_rect_);
+  if (!active_ || !OnPaint(damage_rect_))
+    drop_callback_.Run();
 }
 
 void OffScreenOutputDevice::SetActive(bool active, bool paint) {
@@ -84,7 +88,7 @@ void OffScreenOutputDevice::SetActive(bool active, bool paint) {
     OnPaint(gfx::Rect(viewport_pixel_size_));
 }
 
-void OffScreenOutputDevice::OnPaint(const gfx::Rect& damage_rect) {
+bool OffScreenOutputDevice::OnPaint(const gfx::Rect& damage_rect) {
   gfx::Rect rect = damage_rect;
   if (!pending_damage_rect_.IsEmpty()) {
     rect.Union(pending_damage_rect_);
@@ -93,9 +97,10 @@ void OffScreenOutputDevice::OnPaint(const gfx::Rect& damage_rect) {
 
   rect.Intersect(gfx::Rect(viewport_pixel_size_));
   if (rect.IsEmpty())
-    return;
+    return false;
 
   callback_.Run(rect, *bitmap_);
+  return true;
 }
 
 }  // namespace atom
@@ -6,6 +6,7 @@
 #define ATOM_BROWSER_OSR_OSR_OUTPUT_DEVICE_H_
 
 #include <memory>
+#include <vector>
 
 #include "base/callback.h"
 #include "components/viz/service/display/software_output_device.h"
@@ -16,9 +17,21 @@ namespace atom {
 
 typedef base::Callback<void(const gfx::Rect&, const SkBitmap&)> OnPaintCallback;
 
+// The pixels of a dirty region of the frame, |bitmap| has the size of |rect|.
+struct OffScreenPaintRegion {
+  gfx::Rect rect;
+  SkBitmap bitmap;
+};
+
+typedef base::Callback<void(const std::vector<OffScreenPaintRegion>&)>
+    OnPaintRegionsCallback;
+
 class OffScreenOutputDevice : public viz::SoftwareOutputDevice {
  public:
-  OffScreenOutputDevice(bool transparent, const OnPaintCallback& callback);
+  // |drop_callback| is called for the frames that are not painted.
+  OffScreenOutputDevice(bool transparent,
+                        const OnPaintCallback& callback,
+                        const base::Closure& drop_callback);
   ~OffScreenOutputDevice() override;
 
   // viz::SoftwareOutputDevice:
@@ -27,11 +40,13 @@ class OffScreenOutputDevice : public viz::SoftwareOutputDevice {
   void EndPaint() override;
 
   void SetActive(bool active, bool paint);
-  void OnPaint(const gfx::Rect& damage_rect);
+  // Returns false when there was nothing to paint.
+  bool OnPaint(const gfx::Rect& damage_rect);
 
  private:
   const bool transparent_;
   OnPaintCallback callback_;
+  base::Closure drop_callback_;
 
   bool active_ = false;
 
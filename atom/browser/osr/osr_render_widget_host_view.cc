@@ -28,7 +28,6 @@
 #include "content/public/browser/render_process_host.h"
 #include "media/base/video_frame.h"
 #include "third_party/blink/public/platform/web_input_event.h"
-#include "third_party/skia/include/core/SkCanvas.h"
 #include "ui/compositor/compositor.h"
 #include "ui/compositor/layer.h"
 #include "ui/compositor/layer_type.h"
@@ -48,6 +47,18 @@ namespace {
 const float kDefaultScaleFactor = 1.0;
 const int kFrameRetryLimit = 2;
 
+// Frames that have been submitted but not painted yet, begin frames are
+// skipped beyond this so a slow consumer does not build up a backlog.
+const int kMaxPendingFrames = 2;
+
+// Frames can be dropped without being painted, so the begin frames are sent
+// again after this many have been skipped.
+const int kMaxSkippedBeginFrames = 4;
+
+// Bounds the vsync period derived from the external begin frames.
+const int kMaxFrameRate = 240;
+const int kMinFrameRate = 1;
+
 ui::MouseEvent UiMouseEventFromWebMouseEvent(blink::WebMouseEvent event) {
   ui::EventType type = ui::EventType::ET_UNKNOWN;
   switch (event.GetType()) {
@@ -107,6 +118,26 @@ ui::MouseEvent UiMouseEventFromWebMouseEvent(blink::WebMouseEvent event) {
   return ui_event;
 }
 
+// Copies the part of |source| drawn at |origin| that intersects |rect| into a
+// new region of |regions|.
+void AppendPaintRegion(const SkBitmap& source,
+                       const gfx::Point& origin,
+                       const gfx::Rect& rect,
+                       std::vector<OffScreenPaintRegion>* regions) {
+  gfx::Rect bounds = gfx::IntersectRects(
+      rect, gfx::Rect(origin, gfx::Size(source.width(), source.height())));
+  if (bounds.IsEmpty())
+    return;
+
+  OffScreenPaintRegion region;
+  region.rect = bounds;
+  region.bitmap.allocN32Pixels(bounds.width(), bounds.height(), false);
+  if (source.readPixels(region.bitmap.info(), region.bitmap.getPixels(),
+                        region.bitmap.rowBytes(), bounds.x() - origin.x(),
+                        bounds.y() - origin.y()))
+    regions->push_back(std::move(region));
+}
+
 ui::MouseWheelEvent UiMouseWheelEventFromWebMouseEvent(
     blink::WebMouseWheelEvent event) {
   return ui::MouseWheelEvent(UiMouseEventFromWebMouseEvent(event),
@@ -119,17 +150,18 @@ ui::MouseWheelEvent UiMouseWheelEventFromWebMouseEvent(
 class AtomCopyFrameGenerator {
  public:
   AtomCopyFrameGenerator(OffScreenRenderWidgetHostView* view,
-                         int frame_rate_threshold_us)
+                         base::TimeDelta frame_duration)
       : view_(view),
-        frame_duration_(
-            base::TimeDelta::FromMicroseconds(frame_rate_threshold_us)),
+        frame_duration_(frame_duration),
         weak_ptr_factory_(this) {
     last_time_ = base::Time::Now();
   }
 
   void GenerateCopyFrame(const gfx::Rect& damage_rect) {
-    if (!view_->render_widget_host() || !view_->IsPainting())
+    if (!view_->render_widget_host() || !view_->IsPainting()) {
+      view_->OnFrameDropped();
       return;
+    }
 
     auto request = std::make_unique<viz::CopyOutputRequest>(
         viz::CopyOutputRequest::ResultFormat::RGBA_BITMAP,
@@ -141,9 +173,8 @@ class AtomCopyFrameGenerator {
     view_->GetRootLayer()->RequestCopyOfOutput(std::move(request));
   }
 
-  void set_frame_rate_threshold_us(int frame_rate_threshold_us) {
-    frame_duration_ =
-        base::TimeDelta::FromMicroseconds(frame_rate_threshold_us);
+  void set_frame_duration(base::TimeDelta frame_duration) {
+    frame_duration_ = frame_duration;
   }
 
  private:
@@ -191,6 +222,8 @@ class AtomCopyFrameGenerator {
           content::BrowserThread::UI, FROM_HERE,
           base::BindOnce(&AtomCopyFrameGenerator::GenerateCopyFrame,
                          weak_ptr_factory_.GetWeakPtr(), damage_rect));
+    } else {
+      view_->OnFrameDropped();
     }
   }
 
@@ -217,16 +250,13 @@ class AtomCopyFrameGenerator {
 
 class AtomBeginFrameTimer : public viz::DelayBasedTimeSourceClient {
  public:
-  AtomBeginFrameTimer(int frame_rate_threshold_us,
-                      const base::Closure& callback)
+  AtomBeginFrameTimer(base::TimeDelta interval, const base::Closure& callback)
       : callback_(callback) {
     time_source_.reset(new viz::DelayBasedTimeSource(
         content::BrowserThread::GetTaskRunnerForThread(
             content::BrowserThread::UI)
             .get()));
-    time_source_->SetTimebaseAndInterval(
-        base::TimeTicks(),
-        base::TimeDelta::FromMicroseconds(frame_rate_threshold_us));
+    time_source_->SetTimebaseAndInterval(base::TimeTicks(), interval);
     time_source_->SetClient(this);
   }
 
@@ -234,10 +264,8 @@ class AtomBeginFrameTimer : public viz::DelayBasedTimeSourceClient {
 
   bool IsActive() const { return time_source_->Active(); }
 
-  void SetFrameRateThresholdUs(int frame_rate_threshold_us) {
-    time_source_->SetTimebaseAndInterval(
-        base::TimeTicks::Now(),
-        base::TimeDelta::FromMicroseconds(frame_rate_threshold_us));
+  void SetInterval(base::TimeDelta interval) {
+    time_source_->SetTimebaseAndInterval(base::TimeTicks::Now(), interval);
   }
 
  private:
@@ -252,8 +280,10 @@ class AtomBeginFrameTimer : public viz::DelayBasedTimeSourceClient {
 OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
     bool transparent,
     bool painting,
-    int frame_rate,
+    double frame_rate,
     const OnPaintCallback& callback,
+    const OnTexturePaintCallback& texture_callback,
+    const OnPaintRegionsCallback& regions_callback,
     content::RenderWidgetHost* host,
     OffScreenRenderWidgetHostView* parent_host_view,
     NativeWindow* native_window)
@@ -263,6 +293,7 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
       native_window_(native_window),
       transparent_(transparent),
       callback_(callback),
+      regions_callback_(regions_callback),
       frame_rate_(frame_rate),
       scale_factor_(kDefaultScaleFactor),
       size_(native_window ? native_window->GetSize() : gfx::Size()),
@@ -273,6 +304,16 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
       weak_ptr_factory_(this) {
   DCHECK(render_widget_host_);
   bool is_guest_view_hack = parent_host_view_ != nullptr;
+  // Popups and guests are composited into the frame of their parent, which
+  // is only possible with bitmaps.
+  if (texture_callback && !parent_host_view_) {
+    shared_texture_.reset(new OffScreenSharedTexture(
+        base::Bind(&OffScreenRenderWidgetHostView::OnTexturePaint,
+                   base::Unretained(this)),
+        base::Bind(&OffScreenRenderWidgetHostView::OnFrameDropped,
+                   base::Unretained(this))));
+    texture_callback_ = texture_callback;
+  }
 #if !defined(OS_MACOSX)
   delegated_frame_host_ = std::make_unique<content::DelegatedFrameHost>(
       AllocateFrameSinkId(is_guest_view_hack), this,
@@ -337,6 +378,7 @@ OffScreenRenderWidgetHostView::~OffScreenRenderWidgetHostView() {
 
   if (copy_frame_generator_.get())
     copy_frame_generator_.reset(NULL);
+  shared_texture_.reset();
 
 #if defined(OS_MACOSX)
   DestroyPlatformWidget();
@@ -368,12 +410,61 @@ void OffScreenRenderWidgetHostView::OnWindowClosed() {
 }
 
 void OffScreenRenderWidgetHostView::OnBeginFrameTimerTick() {
+  SendBeginFrameIfReady(base::TimeTicks::Now(), frame_interval_);
+}
+
+void OffScreenRenderWidgetHostView::SendExternalBeginFrame() {
+  for (auto* guest_host_view : guest_host_views_)
+    guest_host_view->SendExternalBeginFrame();
+
+  if (!external_begin_frames_ || !needs_begin_frames_ || !painting_)
+    return;
+
+  // The vsync period is measured from the calls, so the renderer can schedule
+  // its work for the real rate of the consumer.
   const base::TimeTicks frame_time = base::TimeTicks::Now();
-  const base::TimeDelta vsync_period =
-      base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_);
+  base::TimeDelta vsync_period = frame_interval_;
+  if (!last_external_begin_frame_.is_null()) {
+    vsync_period = std::max(
+        std::min(frame_time - last_external_begin_frame_,
+                 base::TimeDelta::FromSecondsD(1.0 / kMinFrameRate)),
+        base::TimeDelta::FromSecondsD(1.0 / kMaxFrameRate));
+  }
+  last_external_begin_frame_ = frame_time;
+  SendBeginFrameIfReady(frame_time, vsync_period);
+}
+
+void OffScreenRenderWidgetHostView::SetExternalBeginFrames(bool enabled) {
+  external_begin_frames_ = enabled;
+  last_external_begin_frame_ = base::TimeTicks();
+  UpdateBeginFrameTimer();
+
+  for (auto* guest_host_view : guest_host_views_)
+    guest_host_view->SetExternalBeginFrames(enabled);
+}
+
+void OffScreenRenderWidgetHostView::SendBeginFrameIfReady(
+    base::TimeTicks frame_time,
+    base::TimeDelta vsync_period) {
+  if (pending_frames_ >= kMaxPendingFrames) {
+    if (++skipped_begin_frames_ <= kMaxSkippedBeginFrames)
+      return;
+    // The pending frames were dropped without being painted.
+    pending_frames_ = 0;
+  }
+  skipped_begin_frames_ = 0;
   SendBeginFrame(frame_time, vsync_period);
 }
 
+void OffScreenRenderWidgetHostView::UpdateBeginFrameTimer() {
+  // Nothing is scheduled while the renderer is idle or the frames would not
+  // be painted anyway.
+  if (begin_frame_timer_) {
+    begin_frame_timer_->SetActive(needs_begin_frames_ && painting_ &&
+                                  !external_begin_frames_);
+  }
+}
+
 void OffScreenRenderWidgetHostView::SendBeginFrame(
     base::TimeTicks frame_time,
     base::TimeDelta vsync_period) {
@@ -544,6 +635,8 @@ void OffScreenRenderWidgetHostView::TakeFallbackContentFrom(
 void OffScreenRenderWidgetHostView::DidCreateNewRendererCompositorFrameSink(
     viz::mojom::CompositorFrameSinkClient* renderer_compositor_frame_sink) {
   renderer_compositor_frame_sink_ = renderer_compositor_frame_sink;
+  // The frames of the previous sink are never completed.
+  pending_frames_ = 0;
   if (GetDelegatedFrameHost()) {
     GetDelegatedFrameHost()->DidCreateNewRendererCompositorFrameSink(
         renderer_compositor_frame_sink_);
@@ -566,6 +659,9 @@ void OffScreenRenderWidgetHostView::SubmitCompositorFrame(
   }
 
   if (!frame.render_pass_list.empty()) {
+    if (painting_)
+      ++pending_frames_;
+
     if (software_output_device_) {
       if (!begin_frame_timer_.get() || IsPopupWidget()) {
         software_output_device_->SetActive(painting_, false);
@@ -581,7 +677,7 @@ void OffScreenRenderWidgetHostView::SubmitCompositorFrame(
     } else {
       if (!copy_frame_generator_.get()) {
         copy_frame_generator_.reset(
-            new AtomCopyFrameGenerator(this, frame_rate_threshold_us_));
+            new AtomCopyFrameGenerator(this, frame_interval_));
       }
 
       // Determine the damage rectangle for the current frame. This is the same
@@ -599,8 +695,8 @@ void OffScreenRenderWidgetHostView::SubmitCompositorFrame(
           local_surface_id, std::move(frame), std::move(hit_test_region_list));
 
       // Request a copy of the last compositor frame which will eventually call
-      // OnPaint asynchronously.
-      copy_frame_generator_->GenerateCopyFrame(damage_rect);
+      // OnPaint or OnTexturePaint asynchronously.
+      GenerateCopyFrame(damage_rect);
     }
   }
 }
@@ -754,9 +850,12 @@ OffScreenRenderWidgetHostView::CreateViewForWidget(
         embedder_render_widget_host->GetView());
   }
 
-  return new OffScreenRenderWidgetHostView(
+  auto* view = new OffScreenRenderWidgetHostView(
       transparent_, true, embedder_host_view->GetFrameRate(), callback_,
-      render_widget_host, embedder_host_view, native_window_);
+      OnTexturePaintCallback(), OnPaintRegionsCallback(), render_widget_host,
+      embedder_host_view, native_window_);
+  view->SetExternalBeginFrames(embedder_host_view->external_begin_frames_);
+  return view;
 }
 
 #if !defined(OS_MACOSX)
@@ -921,8 +1020,11 @@ OffScreenRenderWidgetHostView::CreateSoftwareOutputDevice(
   ResizeRootLayer(false);
 
   software_output_device_ = new OffScreenOutputDevice(
-      transparent_, base::Bind(&OffScreenRenderWidgetHostView::OnPaint,
-                               weak_ptr_factory_.GetWeakPtr()));
+      transparent_,
+      base::Bind(&OffScreenRenderWidgetHostView::OnPaint,
+                 weak_ptr_factory_.GetWeakPtr()),
+      base::Bind(&OffScreenRenderWidgetHostView::OnFrameDropped,
+                 weak_ptr_factory_.GetWeakPtr()));
   return base::WrapUnique(software_output_device_);
 }
 
@@ -943,7 +1045,8 @@ void OffScreenRenderWidgetHostView::SetNeedsBeginFrames(
     bool needs_begin_frames) {
   SetupFrameRate(true);
 
-  begin_frame_timer_->SetActive(needs_begin_frames);
+  needs_begin_frames_ = needs_begin_frames;
+  UpdateBeginFrameTimer();
 
   if (software_output_device_) {
     software_output_device_->SetActive(needs_begin_frames && painting_, false);
@@ -960,41 +1063,89 @@ void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
                                             const SkBitmap& bitmap) {
   TRACE_EVENT0("electron", "OffScreenRenderWidgetHostView::OnPaint");
 
+  pending_frames_ = std::max(pending_frames_ - 1, 0);
   HoldResize();
 
   if (parent_callback_) {
     parent_callback_.Run(damage_rect, bitmap);
-  } else {
-    gfx::Rect damage(damage_rect);
-
-    gfx::Size size = GetViewBounds().size();
-    SkBitmap backing;
-    backing.allocN32Pixels(size.width(), size.height(), false);
-    SkCanvas canvas(backing);
-
-    canvas.writePixels(bitmap, 0, 0);
+  } else if (regions_callback_) {
+    // Only the dirty pixels are copied, the popup and the proxy views are
+    // sent as separate regions to be drawn over the page. Their own paints
+    // invalidate their bounds, so the damage also covers them when they
+    // changed and only the part drawn over the dirty page is sent otherwise.
+    gfx::Rect dirty = gfx::IntersectRects(damage_rect, GetViewBounds());
+    std::vector<OffScreenPaintRegion> regions;
+    AppendPaintRegion(bitmap, gfx::Point(), dirty, &regions);
 
     if (popup_host_view_ && popup_bitmap_.get()) {
       gfx::Rect pos = popup_host_view_->popup_position_;
-      damage.Union(pos);
-      canvas.writePixels(*popup_bitmap_.get(), pos.x(), pos.y());
+      AppendPaintRegion(*popup_bitmap_.get(), pos.origin(),
+                        gfx::IntersectRects(pos, dirty), &regions);
     }
 
     for (auto* proxy_view : proxy_views_) {
       gfx::Rect pos = proxy_view->GetBounds();
-      damage.Union(pos);
-      canvas.writePixels(*proxy_view->GetBitmap(), pos.x(), pos.y());
+      AppendPaintRegion(*proxy_view->GetBitmap(), pos.origin(),
+                        gfx::IntersectRects(pos, dirty), &regions);
     }
 
-    damage.Intersect(GetViewBounds());
     paint_callback_running_ = true;
-    callback_.Run(damage, backing);
+    regions_callback_.Run(regions);
+    paint_callback_running_ = false;
+  } else {
+    std::vector<OffScreenCompositionBuffer::Overlay> overlays;
+    if (popup_host_view_ && popup_bitmap_.get()) {
+      overlays.push_back(
+          {popup_bitmap_.get(), popup_host_view_->popup_position_.origin()});
+    }
+    for (auto* proxy_view : proxy_views_) {
+      overlays.push_back(
+          {proxy_view->GetBitmap(), proxy_view->GetBounds().origin()});
+    }
+
+    gfx::Rect damage;
+    const SkBitmap& frame = composition_buffer_.Compose(
+        GetViewBounds().size(), bitmap, damage_rect, overlays, &damage);
+    paint_callback_running_ = true;
+    callback_.Run(damage, frame);
     paint_callback_running_ = false;
   }
 
   ReleaseResize();
 }
 
+void OffScreenRenderWidgetHostView::OnTexturePaint(
+    const gfx::Rect& damage_rect,
+    const OffScreenSharedTextureFrame& frame,
+    const base::Closure& release) {
+  TRACE_EVENT0("electron", "OffScreenRenderWidgetHostView::OnTexturePaint");
+
+  pending_frames_ = std::max(pending_frames_ - 1, 0);
+  HoldResize();
+  paint_callback_running_ = true;
+  texture_callback_.Run(damage_rect, frame, release);
+  paint_callback_running_ = false;
+  ReleaseResize();
+}
+
+void OffScreenRenderWidgetHostView::OnFrameDropped() {
+  pending_frames_ = std::max(pending_frames_ - 1, 0);
+}
+
+void OffScreenRenderWidgetHostView::GenerateCopyFrame(
+    const gfx::Rect& damage_rect) {
+  if (shared_texture_ && shared_texture_->is_supported()) {
+    if (render_widget_host_ && painting_) {
+      shared_texture_->GenerateFrame(
+          GetRootLayer(), GetCompositorViewportPixelSize(), damage_rect);
+    } else {
+      OnFrameDropped();
+    }
+  } else {
+    copy_frame_generator_->GenerateCopyFrame(damage_rect);
+  }
+}
+
 void OffScreenRenderWidgetHostView::OnPopupPaint(const gfx::Rect& damage_rect,
                                                  const SkBitmap& bitmap) {
   if (popup_host_view_ && popup_bitmap_.get())
@@ -1160,6 +1311,9 @@ void OffScreenRenderWidgetHostView::SendMouseWheelEvent(
 
 void OffScreenRenderWidgetHostView::SetPainting(bool painting) {
   painting_ = painting;
+  if (!painting_)
+    pending_frames_ = 0;
+  UpdateBeginFrameTimer();
 
   if (software_output_device_) {
     software_output_device_->SetActive(painting_, !paint_callback_running_);
@@ -1170,19 +1324,15 @@ bool OffScreenRenderWidgetHostView::IsPainting() const {
   return painting_;
 }
 
-void OffScreenRenderWidgetHostView::SetFrameRate(int frame_rate) {
+void OffScreenRenderWidgetHostView::SetFrameRate(double frame_rate) {
   if (parent_host_view_) {
     if (parent_host_view_->GetFrameRate() == GetFrameRate())
       return;
 
     frame_rate_ = parent_host_view_->GetFrameRate();
   } else {
-    if (frame_rate <= 0)
-      frame_rate = 1;
-    if (frame_rate > 240)
-      frame_rate = 240;
-
-    frame_rate_ = frame_rate;
+    frame_rate_ = std::max(std::min(frame_rate, double{kMaxFrameRate}),
+                           double{kMinFrameRate});
   }
 
   SetupFrameRate(true);
@@ -1191,7 +1341,7 @@ void OffScreenRenderWidgetHostView::SetFrameRate(int frame_rate) {
     guest_host_view->SetFrameRate(frame_rate);
 }
 
-int OffScreenRenderWidgetHostView::GetFrameRate() const {
+double OffScreenRenderWidgetHostView::GetFrameRate() const {
   return frame_rate_;
 }
 
@@ -1211,28 +1361,26 @@ OffScreenRenderWidgetHostView::GetDelegatedFrameHost() const {
 #endif
 
 void OffScreenRenderWidgetHostView::SetupFrameRate(bool force) {
-  if (!force && frame_rate_threshold_us_ != 0)
+  if (!force && !frame_interval_.is_zero())
     return;
 
-  frame_rate_threshold_us_ = 1000000 / frame_rate_;
+  // Kept in a TimeDelta so fractional rates like 59.94 do not drift.
+  frame_interval_ = base::TimeDelta::FromSecondsD(1.0 / frame_rate_);
 
-  if (GetCompositor()) {
-    GetCompositor()->SetAuthoritativeVSyncInterval(
-        base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_));
-  }
+  if (GetCompositor())
+    GetCompositor()->SetAuthoritativeVSyncInterval(frame_interval_);
 
-  if (copy_frame_generator_.get()) {
-    copy_frame_generator_->set_frame_rate_threshold_us(
-        frame_rate_threshold_us_);
-  }
+  if (copy_frame_generator_.get())
+    copy_frame_generator_->set_frame_duration(frame_interval_);
 
   if (begin_frame_timer_.get()) {
-    begin_frame_timer_->SetFrameRateThresholdUs(frame_rate_threshold_us_);
+    begin_frame_timer_->SetInterval(frame_interval_);
   } else {
     begin_frame_timer_.reset(new AtomBeginFrameTimer(
-        frame_rate_threshold_us_,
+        frame_interval_,
         base::Bind(&OffScreenRenderWidgetHostView::OnBeginFrameTimerTick,
                    weak_ptr_factory_.GetWeakPtr())));
+    UpdateBeginFrameTimer();
   }
 }
 
@@ -1244,7 +1392,7 @@ void OffScreenRenderWidgetHostView::InvalidateBounds(const gfx::Rect& bounds) {
   if (software_output_device_) {
     software_output_device_->OnPaint(bounds);
   } else if (copy_frame_generator_) {
-    copy_frame_generator_->GenerateCopyFrame(bounds);
+    GenerateCopyFrame(bounds);
   }
 }
 
@@ -1276,6 +1424,9 @@ void OffScreenRenderWidgetHostView::ResizeRootLayer(bool force) {
       size == GetRootLayer()->bounds().size())
     return;
 
+  // Frames of the old size may be dropped by the compositor.
+  pending_frames_ = 0;
+
   const gfx::Size& size_in_pixels =
       gfx::ConvertSizeToPixel(scale_factor_, size);
 
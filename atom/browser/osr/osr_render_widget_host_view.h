@@ -16,7 +16,9 @@
 
 #include "atom/browser/native_window.h"
 #include "atom/browser/native_window_observer.h"
+#include "atom/browser/osr/osr_composition_buffer.h"
 #include "atom/browser/osr/osr_output_device.h"
+#include "atom/browser/osr/osr_shared_texture.h"
 #include "atom/browser/osr/osr_view_proxy.h"
 #include "base/process/kill.h"
 #include "base/threading/thread.h"
@@ -80,8 +82,10 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
  public:
   OffScreenRenderWidgetHostView(bool transparent,
                                 bool painting,
-                                int frame_rate,
+                                double frame_rate,
                                 const OnPaintCallback& callback,
+                                const OnTexturePaintCallback& texture_callback,
+                                const OnPaintRegionsCallback& regions_callback,
                                 content::RenderWidgetHost* render_widget_host,
                                 OffScreenRenderWidgetHostView* parent_host_view,
                                 NativeWindow* native_window);
@@ -212,6 +216,11 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void OnBeginFrameTimerTick();
   void SendBeginFrame(base::TimeTicks frame_time, base::TimeDelta vsync_period);
 
+  // Replaces the begin frame timer with the calls of SendExternalBeginFrame,
+  // which lets the frames follow the vsync of the consumer.
+  void SetExternalBeginFrames(bool enabled);
+  void SendExternalBeginFrame();
+
 #if defined(OS_MACOSX)
   void CreatePlatformWidget(bool is_guest_view_hack);
   void DestroyPlatformWidget();
@@ -233,7 +242,12 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
       content::RenderWidgetHostViewGuest* guest_host_view);
 
   void OnPaint(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
+  void OnTexturePaint(const gfx::Rect& damage_rect,
+                      const OffScreenSharedTextureFrame& frame,
+                      const base::Closure& release);
   void OnPopupPaint(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
+  // Called when a submitted frame ends without being painted.
+  void OnFrameDropped();
   void OnProxyViewPaint(const gfx::Rect& damage_rect) override;
 
   bool IsPopupWidget() const { return popup_type_ != blink::kWebPopupTypeNone; }
@@ -248,8 +262,8 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetPainting(bool painting);
   bool IsPainting() const;
 
-  void SetFrameRate(int frame_rate);
-  int GetFrameRate() const;
+  void SetFrameRate(double frame_rate);
+  double GetFrameRate() const;
 
   ui::Compositor* GetCompositor() const;
   ui::Layer* GetRootLayer() const;
@@ -289,6 +303,10 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 #endif
 
   void SetupFrameRate(bool force);
+  void UpdateBeginFrameTimer();
+  void SendBeginFrameIfReady(base::TimeTicks frame_time,
+                             base::TimeDelta vsync_period);
+  void GenerateCopyFrame(const gfx::Rect& damage_rect);
   void ResizeRootLayer(bool force);
 
   viz::FrameSinkId AllocateFrameSinkId(bool is_guest_view_hack);
@@ -303,6 +321,7 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   OffScreenRenderWidgetHostView* parent_host_view_ = nullptr;
   OffScreenRenderWidgetHostView* popup_host_view_ = nullptr;
   std::unique_ptr<SkBitmap> popup_bitmap_;
+  OffScreenCompositionBuffer composition_buffer_;
   OffScreenRenderWidgetHostView* child_host_view_ = nullptr;
   std::set<OffScreenRenderWidgetHostView*> guest_host_views_;
   std::set<OffscreenViewProxy*> proxy_views_;
@@ -313,9 +332,17 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   const bool transparent_;
   OnPaintCallback callback_;
   OnPaintCallback parent_callback_;
+  OnTexturePaintCallback texture_callback_;
+  OnPaintRegionsCallback regions_callback_;
+
+  double frame_rate_ = 0;
+  base::TimeDelta frame_interval_;
 
-  int frame_rate_ = 0;
-  int frame_rate_threshold_us_ = 0;
+  bool needs_begin_frames_ = false;
+  bool external_begin_frames_ = false;
+  base::TimeTicks last_external_begin_frame_;
+  int pending_frames_ = 0;
+  int skipped_begin_frames_ = 0;
 
   base::Time last_time_ = base::Time::Now();
 
@@ -343,6 +370,8 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   std::unique_ptr<content::CursorManager> cursor_manager_;
 
   std::unique_ptr<AtomCopyFrameGenerator> copy_frame_generator_;
+  // Replaces |copy_frame_generator_| when the frames are shared as textures.
+  std::unique_ptr<OffScreenSharedTexture> shared_texture_;
   std::unique_ptr<AtomBeginFrameTimer> begin_frame_timer_;
 
   // Provides |source_id| for BeginFrameArgs that we create.
@@ -0,0 +1,288 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/osr/osr_shared_texture.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "components/viz/common/frame_sinks/copy_output_request.h"
+#include "components/viz/common/frame_sinks/copy_output_result.h"
+#include "components/viz/common/gpu/context_provider.h"
+#include "content/browser/compositor/image_transport_factory.h"
+#include "content/browser/gpu/browser_gpu_memory_buffer_manager.h"
+#include "gpu/command_buffer/client/context_support.h"
+#include "gpu/command_buffer/client/gles2_interface.h"
+#include "gpu/command_buffer/common/gpu_memory_buffer_support.h"
+#include "gpu/ipc/common/surface_handle.h"
+#include "ui/compositor/compositor.h"
+#include "ui/compositor/layer.h"
+
+#if defined(OS_MACOSX)
+#include <IOSurface/IOSurface.h>
+
+#include "base/mac/scoped_cftyperef.h"
+#elif defined(OS_POSIX)
+#include "base/files/scoped_file.h"
+#endif
+
+namespace atom {
+
+namespace {
+
+// Two buffers in JavaScript and one being written by the GPU.
+const size_t kMaxBuffers = 3;
+
+const gfx::BufferFormat kBufferFormat = gfx::BufferFormat::BGRA_8888;
+const gfx::BufferUsage kBufferUsage = gfx::BufferUsage::SCANOUT;
+
+// The shared context is replaced after a lost context, so it is not cached.
+scoped_refptr<viz::ContextProvider> GetContextProvider() {
+  return content::ImageTransportFactory::GetInstance()
+      ->GetContextFactory()
+      ->SharedMainThreadContextProvider();
+}
+
+template <typename T>
+void ToBytes(T value, std::vector<char>* bytes) {
+  const char* data = reinterpret_cast<const char*>(&value);
+  bytes->assign(data, data + sizeof(T));
+}
+
+// Fills the platform part of |frame|, returns false if |handle| can not be
+// opened by other processes.
+bool GetSharedHandle(const gfx::GpuMemoryBufferHandle& handle,
+                     OffScreenSharedTextureFrame* frame) {
+  switch (handle.type) {
+#if defined(OS_MACOSX)
+    case gfx::IO_SURFACE_BUFFER: {
+      base::ScopedCFTypeRef<IOSurfaceRef> io_surface(
+          IOSurfaceLookupFromMachPort(handle.mach_port.get()));
+      if (!io_surface)
+        return false;
+      frame->type = "ioSurface";
+      ToBytes(IOSurfaceGetID(io_surface), &frame->handle);
+      return true;
+    }
+#elif defined(OS_WIN)
+    case gfx::DXGI_SHARED_HANDLE:
+      frame->type = "dxgiSharedHandle";
+      ToBytes(handle.handle.GetHandle(), &frame->handle);
+      return true;
+#elif defined(USE_OZONE)
+    case gfx::NATIVE_PIXMAP:
+      if (handle.native_pixmap_handle.fds.empty())
+        return false;
+      frame->type = "dmabuf";
+      ToBytes(handle.native_pixmap_handle.fds[0].fd, &frame->handle);
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+void CloseSharedHandle(gfx::GpuMemoryBufferHandle* handle) {
+#if defined(OS_WIN)
+  if (handle->type == gfx::DXGI_SHARED_HANDLE)
+    handle->handle.Close();
+#elif defined(USE_OZONE)
+  for (const auto& fd : handle->native_pixmap_handle.fds)
+    base::ScopedFD scoped_fd(fd.fd);
+#endif
+}
+
+}  // namespace
+
+OffScreenSharedTextureFrame::OffScreenSharedTextureFrame() = default;
+
+OffScreenSharedTextureFrame::OffScreenSharedTextureFrame(
+    const OffScreenSharedTextureFrame& other) = default;
+
+OffScreenSharedTextureFrame::~OffScreenSharedTextureFrame() = default;
+
+struct OffScreenSharedTexture::Buffer {
+  int id = 0;
+  std::unique_ptr<gfx::GpuMemoryBuffer> gpu_memory_buffer;
+  gfx::GpuMemoryBufferHandle handle;
+  OffScreenSharedTextureFrame frame;
+  GLuint image_id = 0;
+  GLuint texture_id = 0;
+  GLenum texture_target = 0;
+  bool in_use = false;
+};
+
+OffScreenSharedTexture::OffScreenSharedTexture(
+    const OnTexturePaintCallback& callback,
+    const base::Closure& drop_callback)
+    : callback_(callback),
+      drop_callback_(drop_callback),
+      weak_ptr_factory_(this) {}
+
+OffScreenSharedTexture::~OffScreenSharedTexture() {
+  // Buffers still held by JavaScript are destroyed too, the frames it has not
+  // released yet are undefined afterwards.
+  while (!buffers_.empty()) {
+    std::unique_ptr<Buffer> buffer = std::move(buffers_.begin()->second);
+    buffers_.erase(buffers_.begin());
+    DestroyBuffer(std::move(buffer));
+  }
+}
+
+void OffScreenSharedTexture::GenerateFrame(ui::Layer* layer,
+                                           const gfx::Size& pixel_size,
+                                           const gfx::Rect& damage_rect) {
+  auto request = std::make_unique<viz::CopyOutputRequest>(
+      viz::CopyOutputRequest::ResultFormat::RGBA_TEXTURE,
+      base::BindOnce(&OffScreenSharedTexture::OnCopyResult,
+                     weak_ptr_factory_.GetWeakPtr(), damage_rect));
+  request->set_area(gfx::Rect(pixel_size));
+  layer->RequestCopyOfOutput(std::move(request));
+}
+
+void OffScreenSharedTexture::OnCopyResult(
+    const gfx::Rect& damage_rect,
+    std::unique_ptr<viz::CopyOutputResult> result) {
+  if (result->IsEmpty() || result->size().IsEmpty()) {
+    drop_callback_.Run();
+    return;
+  }
+
+  const viz::CopyOutputResult::TextureResult* texture =
+      result->GetTextureResult();
+  std::unique_ptr<viz::SingleReleaseCallback> release_callback =
+      result->TakeTextureOwnership();
+
+  scoped_refptr<viz::ContextProvider> context_provider = GetContextProvider();
+  Buffer* buffer = context_provider ? AcquireBuffer(result->size()) : nullptr;
+  if (!buffer) {
+    release_callback->Run(gpu::SyncToken(), false);
+    drop_callback_.Run();
+    return;
+  }
+
+  gpu::gles2::GLES2Interface* gl = context_provider->ContextGL();
+  gl->WaitSyncTokenCHROMIUM(texture->sync_token.GetConstData());
+  GLuint source_id = gl->CreateAndConsumeTextureCHROMIUM(texture->mailbox.name);
+  gl->CopySubTextureCHROMIUM(source_id, 0, buffer->texture_target,
+                             buffer->texture_id, 0, 0, 0, 0, 0,
+                             result->size().width(), result->size().height(),
+                             false, false, false);
+  gl->DeleteTextures(1, &source_id);
+
+  gpu::SyncToken sync_token;
+  gl->GenSyncTokenCHROMIUM(sync_token.GetData());
+  release_callback->Run(sync_token, false);
+
+  buffer->in_use = true;
+  context_provider->ContextSupport()->SignalSyncToken(
+      sync_token,
+      base::BindOnce(&OffScreenSharedTexture::OnCopyDone,
+                     weak_ptr_factory_.GetWeakPtr(), buffer->id, damage_rect));
+}
+
+void OffScreenSharedTexture::OnCopyDone(int buffer_id,
+                                        const gfx::Rect& damage_rect) {
+  auto it = buffers_.find(buffer_id);
+  if (it == buffers_.end()) {
+    drop_callback_.Run();
+    return;
+  }
+
+  callback_.Run(damage_rect, it->second->frame,
+                base::Bind(&OffScreenSharedTexture::ReleaseBuffer,
+                           weak_ptr_factory_.GetWeakPtr(), buffer_id));
+}
+
+void OffScreenSharedTexture::ReleaseBuffer(int buffer_id) {
+  auto it = buffers_.find(buffer_id);
+  if (it == buffers_.end())
+    return;
+
+  it->second->in_use = false;
+  // The buffers of the old size are only destroyed once they are released.
+  if (it->second->frame.size != size_) {
+    std::unique_ptr<Buffer> buffer = std::move(it->second);
+    buffers_.erase(it);
+    DestroyBuffer(std::move(buffer));
+  }
+}
+
+OffScreenSharedTexture::Buffer* OffScreenSharedTexture::AcquireBuffer(
+    const gfx::Size& size) {
+  if (size != size_) {
+    size_ = size;
+    for (auto it = buffers_.begin(); it != buffers_.end();) {
+      if (it->second->in_use) {
+        ++it;
+      } else {
+        DestroyBuffer(std::move(it->second));
+        it = buffers_.erase(it);
+      }
+    }
+  }
+
+  for (const auto& it : buffers_) {
+    if (!it.second->in_use && it.second->frame.size == size)
+      return it.second.get();
+  }
+
+  if (buffers_.size() >= kMaxBuffers)
+    return nullptr;
+
+  std::unique_ptr<Buffer> buffer = CreateBuffer(size);
+  if (!buffer)
+    return nullptr;
+  Buffer* result = buffer.get();
+  buffers_[buffer->id] = std::move(buffer);
+  return result;
+}
+
+std::unique_ptr<OffScreenSharedTexture::Buffer>
+OffScreenSharedTexture::CreateBuffer(const gfx::Size& size) {
+  auto buffer = std::make_unique<Buffer>();
+  buffer->gpu_memory_buffer =
+      content::BrowserGpuMemoryBufferManager::current()->CreateGpuMemoryBuffer(
+          size, kBufferFormat, kBufferUsage, gpu::kNullSurfaceHandle);
+  if (!buffer->gpu_memory_buffer)
+    return nullptr;
+
+  buffer->handle = buffer->gpu_memory_buffer->GetHandle();
+  if (!GetSharedHandle(buffer->handle, &buffer->frame)) {
+    LOG(WARNING) << "Native GPU memory buffers are not available, the "
+                    "offscreen frames are read back instead of being shared.";
+    is_supported_ = false;
+    CloseSharedHandle(&buffer->handle);
+    return nullptr;
+  }
+
+  scoped_refptr<viz::ContextProvider> context_provider = GetContextProvider();
+  gpu::gles2::GLES2Interface* gl = context_provider->ContextGL();
+  buffer->texture_target = gpu::GetBufferTextureTarget(
+      kBufferUsage, kBufferFormat, context_provider->ContextCapabilities());
+  buffer->image_id = gl->CreateImageCHROMIUM(
+      buffer->gpu_memory_buffer->AsClientBuffer(), size.width(), size.height(),
+      GL_BGRA_EXT);
+  gl->GenTextures(1, &buffer->texture_id);
+  gl->BindTexture(buffer->texture_target, buffer->texture_id);
+  gl->BindTexImage2DCHROMIUM(buffer->texture_target, buffer->image_id);
+  gl->BindTexture(buffer->texture_target, 0);
+
+  buffer->id = next_buffer_id_++;
+  buffer->frame.size = size;
+  return buffer;
+}
+
+void OffScreenSharedTexture::DestroyBuffer(std::unique_ptr<Buffer> buffer) {
+  scoped_refptr<viz::ContextProvider> context_provider = GetContextProvider();
+  if (context_provider) {
+    gpu::gles2::GLES2Interface* gl = context_provider->ContextGL();
+    gl->DeleteTextures(1, &buffer->texture_id);
+    gl->DestroyImageCHROMIUM(buffer->image_id);
+  }
+  CloseSharedHandle(&buffer->handle);
+}
+
+}  // namespace atom
@@ -0,0 +1,95 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_OSR_OSR_SHARED_TEXTURE_H_
+#define ATOM_BROWSER_OSR_OSR_SHARED_TEXTURE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/gpu_memory_buffer.h"
+
+namespace ui {
+class Layer;
+}
+
+namespace viz {
+class CopyOutputResult;
+}
+
+namespace atom {
+
+// A frame that has been copied into a GPU buffer which can be opened by other
+// processes.
+struct OffScreenSharedTextureFrame {
+  OffScreenSharedTextureFrame();
+  OffScreenSharedTextureFrame(const OffScreenSharedTextureFrame& other);
+  ~OffScreenSharedTextureFrame();
+
+  gfx::Size size;
+  // "ioSurface", "dxgiSharedHandle" or "dmabuf".
+  std::string type;
+  // The IOSurfaceID, the HANDLE or the file descriptor of the buffer in the
+  // byte order of the machine.
+  std::vector<char> handle;
+};
+
+// The buffer of the frame is reused once |release| has been called.
+typedef base::Callback<void(const gfx::Rect& damage_rect,
+                            const OffScreenSharedTextureFrame& frame,
+                            const base::Closure& release)>
+    OnTexturePaintCallback;
+
+// Copies the output of the compositor into a small pool of native GPU memory
+// buffers, so the frames never have to be read back into the CPU.
+class OffScreenSharedTexture {
+ public:
+  // |drop_callback| is called for the frames that are dropped.
+  OffScreenSharedTexture(const OnTexturePaintCallback& callback,
+                         const base::Closure& drop_callback);
+  ~OffScreenSharedTexture();
+
+  // Requests a copy of |layer|, |callback| is called once the GPU has finished
+  // writing the frame. The frame is dropped when every buffer is still in use.
+  void GenerateFrame(ui::Layer* layer,
+                     const gfx::Size& pixel_size,
+                     const gfx::Rect& damage_rect);
+
+  // Returns false once the platform turned out to have no native GPU memory
+  // buffers, the caller should then read the frames back instead.
+  bool is_supported() const { return is_supported_; }
+
+ private:
+  struct Buffer;
+
+  void OnCopyResult(const gfx::Rect& damage_rect,
+                    std::unique_ptr<viz::CopyOutputResult> result);
+  void OnCopyDone(int buffer_id, const gfx::Rect& damage_rect);
+  void ReleaseBuffer(int buffer_id);
+
+  Buffer* AcquireBuffer(const gfx::Size& size);
+  std::unique_ptr<Buffer> CreateBuffer(const gfx::Size& size);
+  void DestroyBuffer(std::unique_ptr<Buffer> buffer);
+
+  OnTexturePaintCallback callback_;
+  base::Closure drop_callback_;
+  bool is_supported_ = true;
+
+  gfx::Size size_;
+  int next_buffer_id_ = 1;
+  std::map<int, std::unique_ptr<Buffer>> buffers_;
+
+  base::WeakPtrFactory<OffScreenSharedTexture> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenSharedTexture);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_OSR_OSR_SHARED_TEXTURE_H_
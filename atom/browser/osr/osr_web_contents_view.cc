@@ -14,8 +14,13 @@ namespace atom {
 
 OffScreenWebContentsView::OffScreenWebContentsView(
     bool transparent,
-    const OnPaintCallback& callback)
-    : transparent_(transparent), callback_(callback) {
+    const OnPaintCallback& callback,
+    const OnTexturePaintCallback& texture_callback,
+    const OnPaintRegionsCallback& regions_callback)
+    : transparent_(transparent),
+      callback_(callback),
+      texture_callback_(texture_callback),
+      regions_callback_(regions_callback) {
 #if defined(OS_MACOSX)
   PlatformCreate();
 #endif
@@ -102,9 +107,11 @@ OffScreenWebContentsView::CreateViewForWidget(
         render_widget_host->GetView());
   }
 
-  return new OffScreenRenderWidgetHostView(
-      transparent_, painting_, GetFrameRate(), callback_, render_widget_host,
-      nullptr, nullptr);
+  auto* view = new OffScreenRenderWidgetHostView(
+      transparent_, painting_, GetFrameRate(), callback_, texture_callback_,
+      regions_callback_, render_widget_host, nullptr, nullptr);
+  view->SetExternalBeginFrames(external_begin_frames_);
+  return view;
 }
 
 content::RenderWidgetHostViewBase*
@@ -122,6 +129,8 @@ OffScreenWebContentsView::CreateViewForPopupWidget(
 
   return new OffScreenRenderWidgetHostView(transparent_, true,
                                            view->GetFrameRate(), callback_,
+                                           OnTexturePaintCallback(),
+                                           OnPaintRegionsCallback(),
                                            render_widget_host, view, nullptr);
 }
 
@@ -191,7 +200,7 @@ bool OffScreenWebContentsView::IsPainting() const {
   }
 }
 
-void OffScreenWebContentsView::SetFrameRate(int frame_rate) {
+void OffScreenWebContentsView::SetFrameRate(double frame_rate) {
   auto* view = GetView();
   if (view != nullptr) {
     view->SetFrameRate(frame_rate);
@@ -200,7 +209,7 @@ void OffScreenWebContentsView::SetFrameRate(int frame_rate) {
   }
 }
 
-int OffScreenWebContentsView::GetFrameRate() const {
+double OffScreenWebContentsView::GetFrameRate() const {
   auto* view = GetView();
   if (view != nullptr) {
     return view->GetFrameRate();
@@ -209,6 +218,19 @@ int OffScreenWebContentsView::GetFrameRate() const {
   }
 }
 
+void OffScreenWebContentsView::SetExternalBeginFrames(bool enabled) {
+  external_begin_frames_ = enabled;
+  auto* view = GetView();
+  if (view != nullptr)
+    view->SetExternalBeginFrames(enabled);
+}
+
+void OffScreenWebContentsView::SendExternalBeginFrame() {
+  auto* view = GetView();
+  if (view != nullptr)
+    view->SendExternalBeginFrame();
+}
+
 OffScreenRenderWidgetHostView* OffScreenWebContentsView::GetView() const {
   if (web_contents_) {
     return static_cast<OffScreenRenderWidgetHostView*>(
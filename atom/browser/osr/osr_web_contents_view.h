@@ -23,7 +23,12 @@ namespace atom {
 class OffScreenWebContentsView : public content::WebContentsView,
                                  public content::RenderViewHostDelegateView {
  public:
-  OffScreenWebContentsView(bool transparent, const OnPaintCallback& callback);
+  // Frames are shared as GPU textures with |texture_callback| when it is set,
+  // and only their dirty regions are passed to |regions_callback| when it is.
+  OffScreenWebContentsView(bool transparent,
+                           const OnPaintCallback& callback,
+                           const OnTexturePaintCallback& texture_callback,
+                           const OnPaintRegionsCallback& regions_callback);
   ~OffScreenWebContentsView() override;
 
   void SetWebContents(content::WebContents*);
@@ -73,8 +78,10 @@ class OffScreenWebContentsView : public content::WebContentsView,
 
   void SetPainting(bool painting);
   bool IsPainting() const;
-  void SetFrameRate(int frame_rate);
-  int GetFrameRate() const;
+  void SetFrameRate(double frame_rate);
+  double GetFrameRate() const;
+  void SetExternalBeginFrames(bool enabled);
+  void SendExternalBeginFrame();
 
  private:
 #if defined(OS_MACOSX)
@@ -86,8 +93,11 @@ class OffScreenWebContentsView : public content::WebContentsView,
 
   const bool transparent_;
   bool painting_ = true;
-  int frame_rate_ = 60;
+  double frame_rate_ = 60;
+  bool external_begin_frames_ = false;
   OnPaintCallback callback_;
+  OnTexturePaintCallback texture_callback_;
+  OnPaintRegionsCallback regions_callback_;
 
   // Weak refs.
   content::WebContents* web_contents_ = nullptr;
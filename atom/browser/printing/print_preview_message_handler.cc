@@ -8,9 +8,11 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/files/file_util.h"
 #include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/ref_counted_memory.h"
+#include "base/task_scheduler/post_task.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/printing/print_job_manager.h"
 #include "chrome/browser/printing/printer_query.h"
@@ -58,6 +60,20 @@ scoped_refptr<base::RefCountedMemory> GetDataFromHandle(
       std::move(shared_buf), data_size);
 }
 
+bool WritePDFFile(const base::FilePath& path,
+                  scoped_refptr<base::RefCountedMemory> data_bytes) {
+  int size = static_cast<int>(data_bytes->size());
+  return base::WriteFile(path, data_bytes->front_as<char>(), size) == size;
+}
+
+void RunCallbackWithError(
+    const PrintPreviewMessageHandler::PrintToPDFCallback& callback) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Local<v8::String> error_message =
+      v8::String::NewFromUtf8(isolate, "Failed to generate PDF");
+  callback.Run(v8::Exception::Error(error_message), v8::Null(isolate));
+}
+
 }  // namespace
 
 PrintPreviewMessageHandler::PrintPreviewMessageHandler(
@@ -158,10 +174,11 @@ void PrintPreviewMessageHandler::OnPrintPreviewCancelled(
 
 void PrintPreviewMessageHandler::PrintToPDF(
     const base::DictionaryValue& options,
+    const base::FilePath& output_path,
     const PrintToPDFCallback& callback) {
   int request_id;
   options.GetInteger(printing::kPreviewRequestID, &request_id);
-  print_to_pdf_callback_map_[request_id] = callback;
+  print_to_pdf_request_map_[request_id] = {callback, output_path};
 
   auto* focused_frame = web_contents()->GetFocusedFrame();
   auto* rfh = focused_frame && focused_frame->HasSelection()
@@ -175,6 +192,26 @@ void PrintPreviewMessageHandler::RunPrintToPDFCallback(
     scoped_refptr<base::RefCountedMemory> data_bytes) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
 
+  auto it = print_to_pdf_request_map_.find(request_id);
+  if (it == print_to_pdf_request_map_.end())
+    return;
+
+  // Large documents go straight from the compositor's shared memory to the
+  // file, without a copy in the JavaScript heap.
+  if (!it->second.output_path.empty() && data_bytes && data_bytes->size()) {
+    base::PostTaskWithTraitsAndReplyWithResult(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::BLOCK_SHUTDOWN},
+        base::BindOnce(&WritePDFFile, it->second.output_path, data_bytes),
+        base::BindOnce(&PrintPreviewMessageHandler::OnPDFFileWritten,
+                       weak_ptr_factory_.GetWeakPtr(), request_id));
+    return;
+  }
+
+  PrintToPDFCallback callback = it->second.callback;
+  print_to_pdf_request_map_.erase(it);
+
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::Locker locker(isolate);
   v8::HandleScope handle_scope(isolate);
@@ -184,14 +221,27 @@ void PrintPreviewMessageHandler::RunPrintToPDFCallback(
                            reinterpret_cast<const char*>(data_bytes->front()),
                            data_bytes->size())
             .ToLocalChecked();
-    print_to_pdf_callback_map_[request_id].Run(v8::Null(isolate), buffer);
+    callback.Run(v8::Null(isolate), buffer);
   } else {
-    v8::Local<v8::String> error_message =
-        v8::String::NewFromUtf8(isolate, "Failed to generate PDF");
-    print_to_pdf_callback_map_[request_id].Run(
-        v8::Exception::Error(error_message), v8::Null(isolate));
+    RunCallbackWithError(callback);
   }
-  print_to_pdf_callback_map_.erase(request_id);
+}
+
+void PrintPreviewMessageHandler::OnPDFFileWritten(int request_id,
+                                                  bool success) {
+  auto it = print_to_pdf_request_map_.find(request_id);
+  if (it == print_to_pdf_request_map_.end())
+    return;
+  PrintToPDFCallback callback = it->second.callback;
+  print_to_pdf_request_map_.erase(it);
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  if (success)
+    callback.Run(v8::Null(isolate), v8::Null(isolate));
+  else
+    RunCallbackWithError(callback);
 }
 
 }  // namespace atom
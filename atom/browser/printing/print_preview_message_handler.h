@@ -7,6 +7,7 @@
 
 #include <map>
 
+#include "base/files/file_path.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "components/services/pdf_compositor/public/interfaces/pdf_compositor.mojom.h"
@@ -33,7 +34,10 @@ class PrintPreviewMessageHandler
 
   ~PrintPreviewMessageHandler() override;
 
+  // When |output_path| is not empty the PDF is written to it on a blocking
+  // task runner, and |callback| gets no Buffer.
   void PrintToPDF(const base::DictionaryValue& options,
+                  const base::FilePath& output_path,
                   const PrintToPDFCallback& callback);
 
  protected:
@@ -60,9 +64,15 @@ class PrintPreviewMessageHandler
                                const PrintHostMsg_PreviewIds& ids);
   void RunPrintToPDFCallback(int request_id,
                              scoped_refptr<base::RefCountedMemory> data_bytes);
+  void OnPDFFileWritten(int request_id, bool success);
 
-  using PrintToPDFCallbackMap = std::map<int, PrintToPDFCallback>;
-  PrintToPDFCallbackMap print_to_pdf_callback_map_;
+  struct PrintToPDFRequest {
+    PrintToPDFCallback callback;
+    base::FilePath output_path;
+  };
+
+  using PrintToPDFRequestMap = std::map<int, PrintToPDFRequest>;
+  PrintToPDFRequestMap print_to_pdf_request_map_;
 
   base::WeakPtrFactory<PrintPreviewMessageHandler> weak_ptr_factory_;
 
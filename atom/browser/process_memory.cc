@@ -0,0 +1,119 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/process_memory.h"
+
+#if defined(OS_WIN)
+#include <windows.h>  // windows.h must be included first
+
+#include <psapi.h>
+
+#include "base/win/scoped_handle.h"
+#elif defined(OS_MACOSX)
+#include <mach/mach.h>
+
+#include "base/process/port_provider_mac.h"
+#include "content/public/browser/browser_child_process_host.h"
+#else
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread_restrictions.h"
+#endif
+
+namespace atom {
+
+#if defined(OS_WIN)
+
+bool GetProcessMemory(base::ProcessId pid, ProcessMemory* memory) {
+  base::win::ScopedHandle process(
+      ::OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid));
+  if (!process.IsValid())
+    return false;
+
+  PROCESS_MEMORY_COUNTERS_EX counters = {};
+  if (!::GetProcessMemoryInfo(
+          process.Get(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters),
+          sizeof(counters)))
+    return false;
+
+  // Telling shared pages apart needs a walk of the working set, which is too
+  // slow to be sampled often.
+  memory->working_set_size = counters.WorkingSetSize / 1024;
+  memory->peak_working_set_size = counters.PeakWorkingSetSize / 1024;
+  memory->private_bytes = counters.PrivateUsage / 1024;
+  memory->shared_bytes = 0;
+  return true;
+}
+
+#elif defined(OS_MACOSX)
+
+bool GetProcessMemory(base::ProcessId pid, ProcessMemory* memory) {
+  mach_port_t task =
+      pid == base::GetCurrentProcId()
+          ? mach_task_self()
+          : content::BrowserChildProcessHost::GetPortProvider()->TaskForPid(
+                pid);
+  if (task == MACH_PORT_NULL)
+    return false;
+
+  task_vm_info_data_t info;
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  if (task_info(task, TASK_VM_INFO, reinterpret_cast<task_info_t>(&info),
+                &count) != KERN_SUCCESS)
+    return false;
+
+  // The internal memory is the anonymous memory of the process, the rest of
+  // its resident pages are mapped from files and may be shared.
+  uint64_t internal = info.internal + info.compressed;
+  memory->working_set_size = info.resident_size / 1024;
+  memory->peak_working_set_size = info.resident_size_peak / 1024;
+  memory->private_bytes = internal / 1024;
+  memory->shared_bytes =
+      info.resident_size > info.internal
+          ? (info.resident_size - info.internal) / 1024
+          : 0;
+  return true;
+}
+
+#else
+
+bool GetProcessMemory(base::ProcessId pid, ProcessMemory* memory) {
+  std::string statm;
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    base::FilePath path(base::StringPrintf("/proc/%d/statm", pid));
+    if (!base::ReadFileToString(path, &statm))
+      return false;
+  }
+
+  // size resident shared text lib data dt, in pages.
+  std::vector<base::StringPiece> fields = base::SplitStringPiece(
+      statm, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  size_t resident, shared;
+  if (fields.size() < 3 || !base::StringToSizeT(fields[1], &resident) ||
+      !base::StringToSizeT(fields[2], &shared))
+    return false;
+
+  // The kernel only keeps the peak in /proc/<pid>/status, which is too large
+  // to be parsed often.
+  const size_t page_size = getpagesize() / 1024;
+  memory->working_set_size = resident * page_size;
+  memory->peak_working_set_size = 0;
+  memory->shared_bytes = shared * page_size;
+  memory->private_bytes = resident > shared ? (resident - shared) * page_size
+                                            : 0;
+  return true;
+}
+
+#endif
+
+}  // namespace atom
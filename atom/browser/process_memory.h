@@ -0,0 +1,29 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_PROCESS_MEMORY_H_
+#define ATOM_BROWSER_PROCESS_MEMORY_H_
+
+#include <stddef.h>
+
+#include "base/process/process_handle.h"
+
+namespace atom {
+
+// The memory of a process in kilobytes, as counted by the OS.
+struct ProcessMemory {
+  size_t working_set_size = 0;
+  size_t peak_working_set_size = 0;
+  size_t private_bytes = 0;
+  size_t shared_bytes = 0;
+};
+
+// Reads the memory of the process |pid|, which only asks the OS for its
+// counters and is cheap enough to be done every second. Returns false when
+// the process can not be queried.
+bool GetProcessMemory(base::ProcessId pid, ProcessMemory* memory);
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_PROCESS_MEMORY_H_
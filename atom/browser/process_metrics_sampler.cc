@@ -0,0 +1,126 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/process_metrics_sampler.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/process/process_metrics.h"
+#include "base/sys_info.h"
+#include "base/task_runner_util.h"
+#include "base/task_scheduler/post_task.h"
+
+namespace atom {
+
+namespace {
+
+const int kDefaultIntervalMs = 1000;
+
+// Sampling stops when the samples have not been read for this many intervals.
+const int kIdleIntervals = 10;
+
+}  // namespace
+
+// Owns the metrics of the processes, lives on the background sequence.
+class ProcessMetricsSampler::Core {
+ public:
+  Core() : processor_count_(base::SysInfo::NumberOfProcessors()) {}
+
+  void AddProcess(base::ProcessId pid,
+                  std::unique_ptr<base::ProcessMetrics> metrics) {
+    // The first call only records the times the next sample is measured from.
+    metrics->GetPlatformIndependentCPUUsage();
+    metrics_[pid] = std::move(metrics);
+  }
+
+  void RemoveProcess(base::ProcessId pid) { metrics_.erase(pid); }
+
+  SampleMap Sample() {
+    SampleMap samples;
+    for (const auto& metrics : metrics_) {
+      ProcessMetricsSampler::Sample& sample = samples[metrics.first];
+      sample.cpu_usage =
+          metrics.second->GetPlatformIndependentCPUUsage() / processor_count_;
+#if !defined(OS_WIN)
+      sample.idle_wakeups_per_second =
+          metrics.second->GetIdleWakeupsPerSecond();
+#endif
+    }
+    return samples;
+  }
+
+ private:
+  const int processor_count_;
+  std::unordered_map<base::ProcessId, std::unique_ptr<base::ProcessMetrics>>
+      metrics_;
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
+ProcessMetricsSampler::ProcessMetricsSampler()
+    : interval_(base::TimeDelta::FromMilliseconds(kDefaultIntervalMs)),
+      task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      core_(new Core, base::OnTaskRunnerDeleter(task_runner_)),
+      weak_factory_(this) {}
+
+ProcessMetricsSampler::~ProcessMetricsSampler() = default;
+
+void ProcessMetricsSampler::AddProcess(
+    base::ProcessId pid,
+    std::unique_ptr<base::ProcessMetrics> metrics) {
+  // The core is deleted on its sequence after the tasks posted before.
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Core::AddProcess, base::Unretained(core_.get()), pid,
+                     std::move(metrics)));
+}
+
+void ProcessMetricsSampler::RemoveProcess(base::ProcessId pid) {
+  samples_.erase(pid);
+  task_runner_->PostTask(FROM_HERE,
+                         base::BindOnce(&Core::RemoveProcess,
+                                        base::Unretained(core_.get()), pid));
+}
+
+const ProcessMetricsSampler::SampleMap& ProcessMetricsSampler::GetSamples() {
+  last_read_ = base::TimeTicks::Now();
+  if (!timer_.IsRunning())
+    Start();
+  return samples_;
+}
+
+void ProcessMetricsSampler::SetInterval(base::TimeDelta interval) {
+  interval_ = interval;
+  if (timer_.IsRunning())
+    Start();
+}
+
+void ProcessMetricsSampler::Start() {
+  timer_.Start(FROM_HERE, interval_,
+               base::BindRepeating(&ProcessMetricsSampler::OnTimer,
+                                   base::Unretained(this)));
+}
+
+void ProcessMetricsSampler::OnTimer() {
+  if (base::TimeTicks::Now() - last_read_ > interval_ * kIdleIntervals) {
+    timer_.Stop();
+    // The samples would be stale by the next read.
+    samples_.clear();
+    return;
+  }
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&Core::Sample, base::Unretained(core_.get())),
+      base::BindOnce(&ProcessMetricsSampler::OnSampled,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void ProcessMetricsSampler::OnSampled(SampleMap samples) {
+  samples_ = std::move(samples);
+}
+
+}  // namespace atom
@@ -0,0 +1,73 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_PROCESS_METRICS_SAMPLER_H_
+#define ATOM_BROWSER_PROCESS_METRICS_SAMPLER_H_
+
+#include <memory>
+#include <unordered_map>
+
+#include "base/memory/weak_ptr.h"
+#include "base/process/process_handle.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace base {
+class ProcessMetrics;
+}
+
+namespace atom {
+
+// Samples the CPU usage of the processes of the app on a background sequence,
+// so reading it never blocks the UI thread. Each process keeps its
+// base::ProcessMetrics from launch to exit, the usage is measured between two
+// samples. The latest samples are cached on the UI thread, sampling starts
+// with the first read and stops once the samples are no longer read.
+class ProcessMetricsSampler {
+ public:
+  struct Sample {
+    // Percentage of all the processors.
+    double cpu_usage = 0;
+    int idle_wakeups_per_second = 0;
+  };
+
+  using SampleMap = std::unordered_map<base::ProcessId, Sample>;
+
+  ProcessMetricsSampler();
+  ~ProcessMetricsSampler();
+
+  void AddProcess(base::ProcessId pid,
+                  std::unique_ptr<base::ProcessMetrics> metrics);
+  void RemoveProcess(base::ProcessId pid);
+
+  // Returns the latest samples, a process is missing until it has been
+  // sampled twice.
+  const SampleMap& GetSamples();
+
+  void SetInterval(base::TimeDelta interval);
+
+ private:
+  class Core;
+
+  void Start();
+  void OnTimer();
+  void OnSampled(SampleMap samples);
+
+  base::TimeDelta interval_;
+  base::TimeTicks last_read_;
+  SampleMap samples_;
+  base::RepeatingTimer timer_;
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  std::unique_ptr<Core, base::OnTaskRunnerDeleter> core_;
+
+  base::WeakPtrFactory<ProcessMetricsSampler> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessMetricsSampler);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_PROCESS_METRICS_SAMPLER_H_
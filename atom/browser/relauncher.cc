@@ -4,23 +4,39 @@
 
 #include "atom/browser/relauncher.h"
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "atom/common/atom_command_line.h"
+#include "base/environment.h"
 #include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/path_service.h"
 #include "base/process/launch.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
 #include "content/public/common/content_paths.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/common/main_function_params.h"
 
 #if defined(OS_POSIX)
+#include <fcntl.h>
+
+#include "base/files/scoped_file.h"
 #include "base/posix/eintr_wrapper.h"
 #endif
 
+#if defined(OS_LINUX)
+#include "base/threading/platform_thread.h"
+#endif
+
+#if defined(OS_WIN)
+#include "base/strings/utf_string_conversions.h"
+#endif
+
 namespace relauncher {
 
 namespace internal {
@@ -34,6 +50,17 @@ const CharType* kRelauncherArgSeparator = FILE_PATH_LITERAL("---");
 
 }  // namespace internal
 
+namespace {
+
+// Carries the pid of the instance that launched this one in parallel.
+const char kParallelParentEnvVar[] = "ELECTRON_RELAUNCH_PARENT_PID";
+
+// The instance being replaced only has its shutdown left to run.
+constexpr base::TimeDelta kParallelParentTimeout =
+    base::TimeDelta::FromSeconds(30);
+
+}  // namespace
+
 bool RelaunchApp(const StringVector& argv) {
   // Use the currently-running application's helper process. The automatic
   // update feature is careful to leave the currently-running version alone,
@@ -137,6 +164,64 @@ bool RelaunchAppWithHelper(const base::FilePath& helper,
   return true;
 }
 
+base::Process LaunchAppInParallel(const StringVector& argv,
+                                  base::LaunchOptions options) {
+#if defined(OS_WIN)
+  options.environment[base::UTF8ToUTF16(kParallelParentEnvVar)] =
+      base::UintToString16(base::GetCurrentProcId());
+#else
+  options.environment[kParallelParentEnvVar] =
+      base::IntToString(base::GetCurrentProcId());
+#endif
+#if defined(OS_POSIX)
+  // Like a relaunched process, the new instance is detached and does not
+  // write to the stdout of the current one.
+  base::ScopedFD devnull(HANDLE_EINTR(open("/dev/null", O_WRONLY)));
+  options.new_process_group = true;
+  options.fds_to_remap.push_back(std::make_pair(devnull.get(), STDERR_FILENO));
+  options.fds_to_remap.push_back(std::make_pair(devnull.get(), STDOUT_FILENO));
+#if defined(OS_LINUX)
+  options.allow_new_privs = true;
+#endif
+  return base::LaunchProcess(argv, options);
+#elif defined(OS_WIN)
+  return base::LaunchProcess(internal::ArgvToCommandLineString(argv), options);
+#endif
+}
+
+void WaitForParallelParent() {
+  std::unique_ptr<base::Environment> env(base::Environment::Create());
+  std::string value;
+  if (!env->GetVar(kParallelParentEnvVar, &value))
+    return;
+  // The processes launched by this one do not wait for it.
+  env->UnSetVar(kParallelParentEnvVar);
+
+  int pid;
+  if (!base::StringToInt(value, &pid) || pid <= 0) {
+    LOG(ERROR) << "Invalid " << kParallelParentEnvVar << ": " << value;
+    return;
+  }
+
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::ScopedAllowBaseSyncPrimitivesForTesting allow_sync;
+  bool exited;
+#if defined(OS_LINUX)
+  // waitpid() only waits for children, but the parent can be watched from
+  // this side: once it has exited this process is reparented.
+  base::TimeTicks deadline = base::TimeTicks::Now() + kParallelParentTimeout;
+  while (getppid() == pid && base::TimeTicks::Now() < deadline)
+    base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(10));
+  exited = getppid() != pid;
+#else
+  base::Process parent = base::Process::Open(pid);
+  exited = !parent.IsValid() ||
+           parent.WaitForExitWithTimeout(kParallelParentTimeout, nullptr);
+#endif
+  if (!exited)
+    LOG(ERROR) << "The relaunching instance did not exit in time.";
+}
+
 int RelauncherMain(const content::MainFunctionParams& main_parameters) {
   const StringVector& argv = atom::AtomCommandLine::argv();
 
@@ -33,6 +33,8 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/process/launch.h"
+#include "base/process/process.h"
 
 #if defined(OS_WIN)
 #include "base/process/process_handle.h"
@@ -74,6 +76,18 @@ bool RelaunchAppWithHelper(const base::FilePath& helper,
                            const StringVector& relauncher_args,
                            const StringVector& args);
 
+// Launches the relaunched process right away instead of once the parent has
+// exited, so the new instance starts while the current one shuts down. No
+// relauncher process is involved, |options| can be used to hand handles over
+// to the new process. Returns an invalid process when the launch failed.
+base::Process LaunchAppInParallel(const StringVector& argv,
+                                  base::LaunchOptions options);
+
+// Called in a process started by LaunchAppInParallel, blocks until the
+// instance that launched it has exited, so both never use the user data
+// directory at the same time. Returns right away in other processes.
+void WaitForParallelParent();
+
 // The entry point from ChromeMain into the relauncher process.
 int RelauncherMain(const content::MainFunctionParams& main_parameters);
 
@@ -5,6 +5,7 @@
 #include "atom/browser/render_process_preferences.h"
 
 #include "atom/common/api/api_messages.h"
+#include "base/bind.h"
 #include "content/public/browser/notification_service.h"
 #include "content/public/browser/notification_types.h"
 #include "content/public/browser/render_process_host.h"
@@ -15,21 +16,33 @@ RenderProcessPreferences::RenderProcessPreferences(const Predicate& predicate)
     : predicate_(predicate) {
   registrar_.Add(this, content::NOTIFICATION_RENDERER_PROCESS_CREATED,
                  content::NotificationService::AllBrowserContextsAndSources());
+  memory_pressure_subscription_ =
+      MemoryPressureHub::Get()->RegisterTrimCallback(
+          base::BindRepeating(&RenderProcessPreferences::OnMemoryPressure,
+                              base::Unretained(this)));
 }
 
-RenderProcessPreferences::~RenderProcessPreferences() {}
+RenderProcessPreferences::~RenderProcessPreferences() {
+  for (auto* process : processes_)
+    process->RemoveObserver(this);
+}
 
 int RenderProcessPreferences::AddEntry(const base::DictionaryValue& entry) {
   int id = ++next_id_;
   entries_[id] =
       base::DictionaryValue::From(base::Value::ToUniquePtrValue(entry.Clone()));
   cache_needs_update_ = true;
+  ++version_;
+  SendToProcesses(AtomMsg_SetPreference(version_, id, entry));
   return id;
 }
 
 void RenderProcessPreferences::RemoveEntry(int id) {
+  if (!entries_.erase(id))
+    return;
   cache_needs_update_ = true;
-  entries_.erase(id);
+  ++version_;
+  SendToProcesses(AtomMsg_RemovePreference(version_, id));
 }
 
 void RenderProcessPreferences::Observe(
@@ -43,18 +56,49 @@ void RenderProcessPreferences::Observe(
   if (!predicate_.Run(process))
     return;
 
+  // A host that is reused for a new process is sent all the entries again.
+  if (processes_.insert(process).second)
+    process->AddObserver(this);
+
   UpdateCache();
-  process->Send(new AtomMsg_UpdatePreferences(cached_entries_));
+  process->Send(
+      new AtomMsg_UpdatePreferences(version_, cached_ids_, cached_entries_));
+}
+
+void RenderProcessPreferences::RenderProcessHostDestroyed(
+    content::RenderProcessHost* host) {
+  host->RemoveObserver(this);
+  processes_.erase(host);
 }
 
 void RenderProcessPreferences::UpdateCache() {
   if (!cache_needs_update_)
     return;
 
+  cached_ids_.clear();
   cached_entries_.Clear();
-  for (const auto& iter : entries_)
+  for (const auto& iter : entries_) {
+    cached_ids_.push_back(iter.first);
     cached_entries_.Append(base::Value::ToUniquePtrValue(iter.second->Clone()));
+  }
   cache_needs_update_ = false;
 }
 
+void RenderProcessPreferences::SendToProcesses(const IPC::Message& message) {
+  for (auto* process : processes_) {
+    // The processes that have not launched yet get all the entries once they
+    // are created.
+    if (process->IsInitializedAndNotDead())
+      process->Send(new IPC::Message(message));
+  }
+}
+
+void RenderProcessPreferences::OnMemoryPressure(
+    MemoryPressureHub::Level level) {
+  // Rebuilt from |entries_| when the next process is created.
+  cached_ids_.clear();
+  cached_entries_.Clear();
+  cache_needs_update_ = true;
+}
+
 }  // namespace atom
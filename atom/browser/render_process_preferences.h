@@ -5,22 +5,31 @@
 #ifndef ATOM_BROWSER_RENDER_PROCESS_PREFERENCES_H_
 #define ATOM_BROWSER_RENDER_PROCESS_PREFERENCES_H_
 
+#include <map>
 #include <memory>
-#include <unordered_map>
+#include <set>
+#include <vector>
 
+#include "atom/browser/memory_pressure_hub.h"
 #include "base/callback.h"
 #include "base/values.h"
 #include "content/public/browser/notification_observer.h"
 #include "content/public/browser/notification_registrar.h"
+#include "content/public/browser/render_process_host_observer.h"
 
 namespace content {
 class RenderProcessHost;
 }
 
+namespace IPC {
+class Message;
+}
+
 namespace atom {
 
 // Sets user preferences for render processes.
-class RenderProcessPreferences : public content::NotificationObserver {
+class RenderProcessPreferences : public content::NotificationObserver,
+                                 public content::RenderProcessHostObserver {
  public:
   using Predicate = base::Callback<bool(content::RenderProcessHost*)>;
 
@@ -38,7 +47,14 @@ class RenderProcessPreferences : public content::NotificationObserver {
                const content::NotificationSource& source,
                const content::NotificationDetails& details) override;
 
+  // content::RenderProcessHostObserver:
+  void RenderProcessHostDestroyed(content::RenderProcessHost* host) override;
+
   void UpdateCache();
+  void OnMemoryPressure(MemoryPressureHub::Level level);
+
+  // Sends |message| to the processes that got the full set of entries.
+  void SendToProcesses(const IPC::Message& message);
 
   // Manages our notification registrations.
   content::NotificationRegistrar registrar_;
@@ -46,13 +62,24 @@ class RenderProcessPreferences : public content::NotificationObserver {
   Predicate predicate_;
 
   int next_id_ = 0;
-  std::unordered_map<int, std::unique_ptr<base::DictionaryValue>> entries_;
+  std::map<int, std::unique_ptr<base::DictionaryValue>> entries_;
+
+  // Increased by every change to |entries_|, so processes can tell the changes
+  // that are already part of the entries they got.
+  uint64_t version_ = 0;
+
+  // The processes that got the entries, and are sent the changes to them.
+  std::set<content::RenderProcessHost*> processes_;
 
   // We need to convert the |entries_| to ListValue for multiple times, this
   // caches is only updated when we are sending messages.
   bool cache_needs_update_ = true;
+  std::vector<int> cached_ids_;
   base::ListValue cached_entries_;
 
+  std::unique_ptr<MemoryPressureHub::Subscription>
+      memory_pressure_subscription_;
+
   DISALLOW_COPY_AND_ASSIGN(RenderProcessPreferences);
 };
 
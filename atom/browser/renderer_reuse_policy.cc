@@ -0,0 +1,84 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/renderer_reuse_policy.h"
+
+#include <algorithm>
+
+#include "atom/browser/web_contents_preferences.h"
+#include "base/auto_reset.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+#include "content/public/browser/web_contents.h"
+
+namespace atom {
+
+RendererReusePolicy::RendererReusePolicy() = default;
+
+RendererReusePolicy::~RendererReusePolicy() {
+  for (const auto& it : kinds_) {
+    auto* host = content::RenderProcessHost::FromID(it.first);
+    if (host)
+      host->RemoveObserver(this);
+  }
+}
+
+void RendererReusePolicy::SetShareProcesses(bool share) {
+  share_processes_ = share;
+}
+
+void RendererReusePolicy::SetMaxProcesses(int count) {
+  max_processes_ = std::max(count, 0);
+  content::RenderProcessHost::SetMaxRendererProcessCount(max_processes_);
+}
+
+content::RenderProcessHost* RendererReusePolicy::GetProcess(
+    content::WebContents* web_contents,
+    content::SiteInstance* site_instance) {
+  if (!IsEnabled())
+    return site_instance->GetProcess();
+
+  base::CommandLine switches(base::CommandLine::NO_PROGRAM);
+  if (site_instance->HasProcess() ||
+      !WebContentsPreferences::GetProcessSwitches(web_contents, &switches))
+    return site_instance->GetProcess();
+
+  Kind kind;
+  kind.site = site_instance->GetSiteURL();
+  kind.switches = switches.GetArgumentsString();
+
+  content::RenderProcessHost* host;
+  {
+    base::AutoReset<const Kind*> auto_reset(&selecting_, &kind);
+    host = site_instance->GetProcess();
+  }
+  if (kinds_.emplace(host->GetID(), kind).second)
+    host->AddObserver(this);
+  return host;
+}
+
+bool RendererReusePolicy::ShouldTryToUseExistingProcessHost() const {
+  return share_processes_ && selecting_;
+}
+
+bool RendererReusePolicy::IsSuitableHost(content::RenderProcessHost* host,
+                                         const GURL& site_url) const {
+  if (!IsEnabled())
+    return true;
+  // Processes are only shared by the windows that GetProcess knows.
+  if (!selecting_)
+    return false;
+
+  auto it = kinds_.find(host->GetID());
+  return it != kinds_.end() && it->second.site == selecting_->site &&
+         it->second.switches == selecting_->switches;
+}
+
+void RendererReusePolicy::RenderProcessHostDestroyed(
+    content::RenderProcessHost* host) {
+  host->RemoveObserver(this);
+  kinds_.erase(host->GetID());
+}
+
+}  // namespace atom
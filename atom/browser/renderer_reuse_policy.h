@@ -0,0 +1,77 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_RENDERER_REUSE_POLICY_H_
+#define ATOM_BROWSER_RENDERER_REUSE_POLICY_H_
+
+#include <map>
+
+#include "base/command_line.h"
+#include "content/public/browser/render_process_host_observer.h"
+#include "url/gurl.h"
+
+namespace content {
+class RenderProcessHost;
+class SiteInstance;
+class WebContents;
+}  // namespace content
+
+namespace atom {
+
+// Lets windows that navigate to the same site with the same web preferences
+// share render processes. Chromium picks an existing process for them when
+// sharing is enabled, or once the number of processes is over the limit, and
+// only the processes launched with the same switches are suitable.
+class RendererReusePolicy : public content::RenderProcessHostObserver {
+ public:
+  RendererReusePolicy();
+  ~RendererReusePolicy() override;
+
+  // Whether processes are picked by the policy.
+  bool IsEnabled() const { return share_processes_ || max_processes_ > 0; }
+
+  void SetShareProcesses(bool share);
+  bool share_processes() const { return share_processes_; }
+
+  // The soft limit of render processes, 0 restores Chromium's default.
+  void SetMaxProcesses(int count);
+  int max_processes() const { return max_processes_; }
+
+  // Returns the process of |site_instance|, which |web_contents| navigates
+  // to. An existing process may be picked for it while this runs.
+  content::RenderProcessHost* GetProcess(content::WebContents* web_contents,
+                                         content::SiteInstance* site_instance);
+
+  // Whether an existing process should be picked even when the limit of
+  // processes has not been reached.
+  bool ShouldTryToUseExistingProcessHost() const;
+
+  // Whether |host| can be picked for the navigation in GetProcess.
+  bool IsSuitableHost(content::RenderProcessHost* host,
+                      const GURL& site_url) const;
+
+ private:
+  struct Kind {
+    GURL site;
+    base::CommandLine::StringType switches;
+  };
+
+  // content::RenderProcessHostObserver:
+  void RenderProcessHostDestroyed(content::RenderProcessHost* host) override;
+
+  bool share_processes_ = false;
+  int max_processes_ = 0;
+
+  // Process ID => the kind of windows it was picked for.
+  std::map<int, Kind> kinds_;
+
+  // The kind of the window that GetProcess picks a process for.
+  const Kind* selecting_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(RendererReusePolicy);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_RENDERER_REUSE_POLICY_H_
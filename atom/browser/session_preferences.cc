@@ -4,9 +4,14 @@
 
 #include "atom/browser/session_preferences.h"
 
+#include <cstring>
+#include <utility>
+
+#include "atom/common/api/api_messages.h"
 #include "atom/common/options_switches.h"
 #include "base/command_line.h"
 #include "base/memory/ptr_util.h"
+#include "content/public/browser/render_process_host.h"
 
 namespace atom {
 
@@ -23,7 +28,8 @@ const base::FilePath::CharType kPathDelimiter = FILE_PATH_LITERAL(':');
 // static
 int SessionPreferences::kLocatorKey = 0;
 
-SessionPreferences::SessionPreferences(content::BrowserContext* context) {
+SessionPreferences::SessionPreferences(content::BrowserContext* context)
+    : context_(context) {
   context->SetUserData(&kLocatorKey, base::WrapUnique(this));
 }
 
@@ -58,4 +64,66 @@ void SessionPreferences::AppendExtraCommandLineSwitches(
     command_line->AppendSwitchNative(switches::kPreloadScripts, preloads);
 }
 
+// static
+NavigationPolicy::Decision SessionPreferences::EvaluateNavigation(
+    content::BrowserContext* context,
+    const GURL& url) {
+  SessionPreferences* self = FromBrowserContext(context);
+  if (!self || !self->navigation_policy_)
+    return NavigationPolicy::Decision::UNMATCHED;
+  return self->navigation_policy_->Evaluate(url);
+}
+
+// static
+void SessionPreferences::SendUserStyleSheets(
+    content::RenderProcessHost* host) {
+  SessionPreferences* self = FromBrowserContext(host->GetBrowserContext());
+  if (!self)
+    return;
+
+  for (const auto& iter : self->user_style_sheets_) {
+    host->Send(new AtomMsg_AddUserStyleSheet(iter.first,
+                                             iter.second.region.Duplicate(),
+                                             iter.second.main_frame_only));
+  }
+}
+
+int SessionPreferences::AddUserStyleSheet(const std::string& css,
+                                          bool main_frame_only) {
+  base::MappedReadOnlyRegion mapped =
+      base::ReadOnlySharedMemoryRegion::Create(css.size());
+  if (!mapped.IsValid())
+    return 0;
+  memcpy(mapped.mapping.memory(), css.data(), css.size());
+
+  int id = next_style_sheet_id_++;
+  UserStyleSheet& style_sheet = user_style_sheets_[id];
+  style_sheet.region = std::move(mapped.region);
+  style_sheet.main_frame_only = main_frame_only;
+
+  // Processes that are launched later get it from SendUserStyleSheets.
+  for (auto it = content::RenderProcessHost::AllHostsIterator(); !it.IsAtEnd();
+       it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (host->GetBrowserContext() == context_) {
+      host->Send(new AtomMsg_AddUserStyleSheet(
+          id, style_sheet.region.Duplicate(), main_frame_only));
+    }
+  }
+  return id;
+}
+
+bool SessionPreferences::RemoveUserStyleSheet(int id) {
+  if (!user_style_sheets_.erase(id))
+    return false;
+
+  for (auto it = content::RenderProcessHost::AllHostsIterator(); !it.IsAtEnd();
+       it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (host->GetBrowserContext() == context_)
+      host->Send(new AtomMsg_RemoveUserStyleSheet(id));
+  }
+  return true;
+}
+
 }  // namespace atom
@@ -5,9 +5,15 @@
 #ifndef ATOM_BROWSER_SESSION_PREFERENCES_H_
 #define ATOM_BROWSER_SESSION_PREFERENCES_H_
 
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "atom/browser/navigation_policy.h"
 #include "base/files/file_path.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/supports_user_data.h"
 #include "content/public/browser/browser_context.h"
 
@@ -15,6 +21,10 @@ namespace base {
 class CommandLine;
 }
 
+namespace content {
+class RenderProcessHost;
+}
+
 namespace atom {
 
 class SessionPreferences : public base::SupportsUserData::Data {
@@ -23,6 +33,12 @@ class SessionPreferences : public base::SupportsUserData::Data {
       content::BrowserContext* context);
   static void AppendExtraCommandLineSwitches(content::BrowserContext* context,
                                              base::CommandLine* command_line);
+  // Sends the user stylesheets of the session to a new render process.
+  static void SendUserStyleSheets(content::RenderProcessHost* host);
+  // Evaluates the navigation policy of |context|.
+  static NavigationPolicy::Decision EvaluateNavigation(
+      content::BrowserContext* context,
+      const GURL& url);
 
   explicit SessionPreferences(content::BrowserContext* context);
   ~SessionPreferences() override;
@@ -34,11 +50,38 @@ class SessionPreferences : public base::SupportsUserData::Data {
     return preloads_;
   }
 
+  // Adds a stylesheet to the documents created from now on in the session's
+  // render processes, returns its id or 0 on failure.
+  int AddUserStyleSheet(const std::string& css, bool main_frame_only);
+  bool RemoveUserStyleSheet(int id);
+
+  // Null when every navigation is decided by JavaScript.
+  void set_navigation_policy(std::unique_ptr<NavigationPolicy> policy) {
+    navigation_policy_ = std::move(policy);
+  }
+  const NavigationPolicy* navigation_policy() const {
+    return navigation_policy_.get();
+  }
+
  private:
+  struct UserStyleSheet {
+    base::ReadOnlySharedMemoryRegion region;
+    bool main_frame_only = false;
+  };
+
   // The user data key.
   static int kLocatorKey;
 
+  content::BrowserContext* context_;
+
   std::vector<base::FilePath::StringType> preloads_;
+
+  // The text of each stylesheet is copied once into read-only shared memory,
+  // which is duplicated for each render process.
+  std::map<int, UserStyleSheet> user_style_sheets_;
+  int next_style_sheet_id_ = 1;
+
+  std::unique_ptr<NavigationPolicy> navigation_policy_;
 };
 
 }  // namespace atom
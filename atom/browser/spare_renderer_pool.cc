@@ -0,0 +1,178 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/spare_renderer_pool.h"
+
+#include <algorithm>
+
+#include "atom/browser/web_contents_preferences.h"
+#include "atom/common/options_switches.h"
+#include "base/bind.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+#include "content/public/browser/web_contents.h"
+
+namespace atom {
+
+namespace {
+
+// Spares are launched a while after a window takes one, so they do not slow
+// down the page that is loading in it. Processes without visible widgets run
+// at background priority.
+const int kReplenishDelayMs = 2000;
+
+}  // namespace
+
+SpareRendererPool::Kind::Kind(content::BrowserContext* browser_context,
+                              const base::CommandLine& switches)
+    : browser_context(browser_context), switches(switches) {}
+
+SpareRendererPool::Kind::~Kind() = default;
+
+SpareRendererPool::SpareRendererPool() = default;
+
+SpareRendererPool::~SpareRendererPool() = default;
+
+void SpareRendererPool::SetSize(int size) {
+  size_ = std::max(size, 0);
+  for (auto& it : kinds_) {
+    auto& spares = it.second->spares;
+    while (spares.size() > static_cast<size_t>(size_)) {
+      RemoveSpare(spares.back().host);
+    }
+  }
+  if (size_ == 0)
+    kinds_.clear();
+  else
+    ScheduleReplenish();
+}
+
+scoped_refptr<content::SiteInstance> SpareRendererPool::Take(
+    content::WebContents* web_contents) {
+  if (size_ == 0)
+    return nullptr;
+
+  base::CommandLine switches(base::CommandLine::NO_PROGRAM);
+  if (!WebContentsPreferences::GetProcessSwitches(web_contents, &switches))
+    return nullptr;
+
+  content::BrowserContext* browser_context = web_contents->GetBrowserContext();
+  Key key(browser_context, switches.GetArgumentsString());
+  auto it = kinds_.find(key);
+  if (it == kinds_.end()) {
+    it = kinds_
+             .emplace(key, std::make_unique<Kind>(browser_context, switches))
+             .first;
+  }
+  ScheduleReplenish();
+
+  auto& spares = it->second->spares;
+  if (spares.empty())
+    return nullptr;
+
+  Spare spare = std::move(spares.front());
+  spares.erase(spares.begin());
+  spare.host->RemoveObserver(this);
+  spare_processes_.erase(spare.host->GetID());
+  return spare.site_instance;
+}
+
+bool SpareRendererPool::AppendSwitches(int process_id,
+                                       base::CommandLine* command_line) {
+  auto it = spare_processes_.find(process_id);
+  if (it == spare_processes_.end())
+    return false;
+
+  const base::CommandLine& switches = it->second->switches;
+  for (const auto& pair : switches.GetSwitches()) {
+    if (!command_line->HasSwitch(pair.first))
+      command_line->AppendSwitchNative(pair.first, pair.second);
+  }
+  for (const auto& arg : switches.GetArgs())
+    command_line->AppendArgNative(arg);
+  command_line->AppendSwitch(switches::kSpareRenderer);
+  return true;
+}
+
+void SpareRendererPool::DiscardSpares(
+    content::BrowserContext* browser_context) {
+  for (auto it = kinds_.begin(); it != kinds_.end();) {
+    if (it->first.first != browser_context) {
+      ++it;
+      continue;
+    }
+    while (!it->second->spares.empty())
+      RemoveSpare(it->second->spares.back().host);
+    it = kinds_.erase(it);
+  }
+}
+
+void SpareRendererPool::ScheduleReplenish() {
+  if (size_ == 0 || replenish_timer_.IsRunning())
+    return;
+  replenish_timer_.Start(
+      FROM_HERE, base::TimeDelta::FromMilliseconds(kReplenishDelayMs),
+      base::Bind(&SpareRendererPool::Replenish, base::Unretained(this)));
+}
+
+void SpareRendererPool::Replenish() {
+  for (auto& it : kinds_) {
+    Kind* kind = it.second.get();
+    if (kind->spares.size() >= static_cast<size_t>(size_))
+      continue;
+    // One process at a time, the others are launched by the next run.
+    if (LaunchSpare(kind))
+      ScheduleReplenish();
+    return;
+  }
+}
+
+bool SpareRendererPool::LaunchSpare(Kind* kind) {
+  scoped_refptr<content::SiteInstance> site_instance =
+      content::SiteInstance::Create(kind->browser_context);
+  content::RenderProcessHost* host = site_instance->GetProcess();
+  // Over the process limit a running process is shared instead.
+  if (host->IsInitializedAndNotDead())
+    return false;
+
+  spare_processes_[host->GetID()] = kind;
+  host->AddObserver(this);
+  if (!host->Init()) {
+    host->RemoveObserver(this);
+    spare_processes_.erase(host->GetID());
+    return false;
+  }
+  kind->spares.push_back({std::move(site_instance), host});
+  return true;
+}
+
+void SpareRendererPool::RemoveSpare(content::RenderProcessHost* host) {
+  auto it = spare_processes_.find(host->GetID());
+  if (it == spare_processes_.end())
+    return;
+
+  auto& spares = it->second->spares;
+  spare_processes_.erase(it);
+  host->RemoveObserver(this);
+  // Releasing the SiteInstance shuts down its unused process.
+  spares.erase(std::remove_if(spares.begin(), spares.end(),
+                              [host](const Spare& spare) {
+                                return spare.host == host;
+                              }),
+               spares.end());
+}
+
+void SpareRendererPool::RenderProcessExited(
+    content::RenderProcessHost* host,
+    const content::ChildProcessTerminationInfo& info) {
+  RemoveSpare(host);
+  ScheduleReplenish();
+}
+
+void SpareRendererPool::RenderProcessHostDestroyed(
+    content::RenderProcessHost* host) {
+  RemoveSpare(host);
+}
+
+}  // namespace atom
@@ -0,0 +1,97 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_SPARE_RENDERER_POOL_H_
+#define ATOM_BROWSER_SPARE_RENDERER_POOL_H_
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/memory/ref_counted.h"
+#include "base/timer/timer.h"
+#include "content/public/browser/render_process_host_observer.h"
+
+namespace content {
+class BrowserContext;
+class SiteInstance;
+class WebContents;
+}  // namespace content
+
+namespace atom {
+
+// Render processes that are launched ahead of time, so opening a window does
+// not wait for a process to start. The command line of a renderer depends on
+// the web preferences of its WebContents, so spares are kept for each session
+// and set of switches that the app's windows have used.
+class SpareRendererPool : public content::RenderProcessHostObserver {
+ public:
+  SpareRendererPool();
+  ~SpareRendererPool() override;
+
+  // The number of spares kept for each kind of renderer, 0 disables the pool.
+  void SetSize(int size);
+  int size() const { return size_; }
+
+  // Returns a SiteInstance whose process was launched with the switches that
+  // |web_contents| needs, or nullptr. The kind of |web_contents| is
+  // remembered, and its spares are launched again in the background.
+  scoped_refptr<content::SiteInstance> Take(content::WebContents* web_contents);
+
+  // Appends the switches of its kind to a spare process that is launching,
+  // returns false for the other processes.
+  bool AppendSwitches(int process_id, base::CommandLine* command_line);
+
+  // Drops the spares of |browser_context|, which is being destroyed.
+  void DiscardSpares(content::BrowserContext* browser_context);
+
+ private:
+  using Key =
+      std::pair<content::BrowserContext*, base::CommandLine::StringType>;
+
+  struct Spare {
+    scoped_refptr<content::SiteInstance> site_instance;
+    // Kept because SiteInstance::GetProcess() launches a new process after
+    // the old one is gone.
+    content::RenderProcessHost* host;
+  };
+
+  struct Kind {
+    Kind(content::BrowserContext* browser_context,
+         const base::CommandLine& switches);
+    ~Kind();
+
+    content::BrowserContext* browser_context;
+    base::CommandLine switches;
+    std::vector<Spare> spares;
+  };
+
+  void ScheduleReplenish();
+
+  // Launches one spare for a kind that lacks them.
+  void Replenish();
+  bool LaunchSpare(Kind* kind);
+
+  void RemoveSpare(content::RenderProcessHost* host);
+
+  // content::RenderProcessHostObserver:
+  void RenderProcessExited(
+      content::RenderProcessHost* host,
+      const content::ChildProcessTerminationInfo& info) override;
+  void RenderProcessHostDestroyed(content::RenderProcessHost* host) override;
+
+  int size_ = 0;
+  std::map<Key, std::unique_ptr<Kind>> kinds_;
+  // Process ID of spares => their kind.
+  std::map<int, Kind*> spare_processes_;
+  base::OneShotTimer replenish_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpareRendererPool);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_SPARE_RENDERER_POOL_H_
@@ -0,0 +1,111 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/task_duration_monitor.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/pending_task.h"
+#include "base/threading/thread_task_runner_handle.h"
+
+namespace atom {
+
+namespace {
+
+// Bounds the reports that are queued when the main thread is very busy.
+const size_t kMaxPendingLongTasks = 100;
+
+TaskDurationMonitor* g_task_duration_monitor = nullptr;
+
+}  // namespace
+
+TaskDurationMonitor::Histogram::Histogram() {
+  buckets.fill(0);
+}
+
+TaskDurationMonitor::Histogram::Histogram(const Histogram& other) = default;
+
+TaskDurationMonitor::Histogram::~Histogram() = default;
+
+void TaskDurationMonitor::Histogram::Add(base::TimeDelta duration) {
+  ++count;
+  total += duration;
+  max = std::max(max, duration);
+
+  size_t bucket = 0;
+  int64_t ms = duration.InMilliseconds();
+  while (ms > 0 && bucket < kBucketCount - 1) {
+    ms >>= 1;
+    ++bucket;
+  }
+  ++buckets[bucket];
+}
+
+TaskDurationMonitor::TaskDurationMonitor() : weak_factory_(this) {
+  DCHECK(!g_task_duration_monitor);
+  g_task_duration_monitor = this;
+}
+
+TaskDurationMonitor::~TaskDurationMonitor() {
+  g_task_duration_monitor = nullptr;
+}
+
+// static
+TaskDurationMonitor* TaskDurationMonitor::Get() {
+  return g_task_duration_monitor;
+}
+
+// static
+void TaskDurationMonitor::RecordUvRun(base::TimeDelta duration) {
+  if (g_task_duration_monitor)
+    g_task_duration_monitor->uv_runs_.Add(duration);
+}
+
+void TaskDurationMonitor::SetLongTaskThreshold(base::TimeDelta threshold) {
+  long_task_threshold_ = threshold;
+}
+
+void TaskDurationMonitor::SetLongTaskCallback(
+    const LongTaskCallback& callback) {
+  long_task_callback_ = callback;
+}
+
+void TaskDurationMonitor::WillProcessTask(
+    const base::PendingTask& pending_task) {
+  task_starts_.push_back(base::TimeTicks::Now());
+}
+
+void TaskDurationMonitor::DidProcessTask(
+    const base::PendingTask& pending_task) {
+  if (task_starts_.empty())
+    return;
+  base::TimeDelta duration = base::TimeTicks::Now() - task_starts_.back();
+  task_starts_.pop_back();
+  tasks_.Add(duration);
+
+  if (long_task_threshold_.is_zero() || duration < long_task_threshold_ ||
+      long_task_callback_.is_null() ||
+      pending_long_tasks_.size() >= kMaxPendingLongTasks)
+    return;
+
+  if (pending_long_tasks_.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&TaskDurationMonitor::ReportLongTasks,
+                                  weak_factory_.GetWeakPtr()));
+  }
+  pending_long_tasks_.push_back({duration, pending_task.posted_from});
+}
+
+void TaskDurationMonitor::ReportLongTasks() {
+  std::vector<LongTask> long_tasks;
+  long_tasks.swap(pending_long_tasks_);
+  for (const auto& long_task : long_tasks) {
+    if (long_task_callback_.is_null())
+      break;
+    long_task_callback_.Run(long_task);
+  }
+}
+
+}  // namespace atom
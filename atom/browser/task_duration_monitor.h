@@ -0,0 +1,93 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_TASK_DURATION_MONITOR_H_
+#define ATOM_BROWSER_TASK_DURATION_MONITOR_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/location.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/time/time.h"
+
+namespace atom {
+
+// Records how long the tasks of the browser main thread take, including the
+// microtask checkpoints that run after them, and reports the tasks that take
+// longer than a threshold.
+class TaskDurationMonitor : public base::MessageLoop::TaskObserver {
+ public:
+  // Bucket i counts the durations from 2^(i-1) ms up to 2^i ms, the first
+  // bucket has the durations under 1ms and the last one has the rest.
+  static const size_t kBucketCount = 12;
+
+  struct Histogram {
+    Histogram();
+    Histogram(const Histogram& other);
+    ~Histogram();
+
+    void Add(base::TimeDelta duration);
+
+    uint64_t count = 0;
+    base::TimeDelta total;
+    base::TimeDelta max;
+    std::array<uint64_t, kBucketCount> buckets;
+  };
+
+  struct LongTask {
+    base::TimeDelta duration;
+    base::Location posted_from;
+  };
+
+  using LongTaskCallback = base::RepeatingCallback<void(const LongTask&)>;
+
+  TaskDurationMonitor();
+  ~TaskDurationMonitor() override;
+
+  // Returns the monitor of the browser process, or null before the message
+  // loop runs.
+  static TaskDurationMonitor* Get();
+
+  // Called by NodeBindings with the time spent in uv_run.
+  static void RecordUvRun(base::TimeDelta duration);
+
+  // A zero |threshold| stops the reports. The callback runs in a task of its
+  // own, after the long task.
+  void SetLongTaskThreshold(base::TimeDelta threshold);
+  void SetLongTaskCallback(const LongTaskCallback& callback);
+
+  base::TimeDelta long_task_threshold() const { return long_task_threshold_; }
+  const Histogram& tasks() const { return tasks_; }
+  const Histogram& uv_runs() const { return uv_runs_; }
+
+  // base::MessageLoop::TaskObserver
+  void WillProcessTask(const base::PendingTask& pending_task) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  void ReportLongTasks();
+
+  Histogram tasks_;
+  Histogram uv_runs_;
+
+  // Tasks run by nested loops start while the outer task is running.
+  std::vector<base::TimeTicks> task_starts_;
+
+  base::TimeDelta long_task_threshold_;
+  LongTaskCallback long_task_callback_;
+  std::vector<LongTask> pending_long_tasks_;
+
+  base::WeakPtrFactory<TaskDurationMonitor> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskDurationMonitor);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_TASK_DURATION_MONITOR_H_
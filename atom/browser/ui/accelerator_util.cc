@@ -7,9 +7,11 @@
 #include <stdio.h>
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "atom/common/keyboard_util.h"
+#include "base/lazy_instance.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
@@ -17,8 +19,20 @@
 
 namespace accelerator_util {
 
-bool StringToAccelerator(const std::string& shortcut,
-                         ui::Accelerator* accelerator) {
+namespace {
+
+// Menus are rebuilt often with the same accelerators, so the parsed
+// accelerators are kept by their description. Invalid descriptions are kept
+// as VKEY_UNKNOWN. The cache is only used on the UI thread.
+using AcceleratorCache = std::unordered_map<std::string, ui::Accelerator>;
+base::LazyInstance<AcceleratorCache>::Leaky g_accelerator_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Apps that generate accelerators should not grow the cache unbounded.
+const size_t kMaxCachedAccelerators = 4096;
+
+bool ParseAccelerator(const std::string& shortcut,
+                      ui::Accelerator* accelerator) {
   if (!base::IsStringASCII(shortcut)) {
     LOG(ERROR) << "The accelerator string can only contain ASCII characters";
     return false;
@@ -67,6 +81,25 @@ bool StringToAccelerator(const std::string& shortcut,
   return true;
 }
 
+}  // namespace
+
+bool StringToAccelerator(const std::string& shortcut,
+                         ui::Accelerator* accelerator) {
+  AcceleratorCache& cache = g_accelerator_cache.Get();
+  auto it = cache.find(shortcut);
+  if (it == cache.end()) {
+    ui::Accelerator parsed;
+    ParseAccelerator(shortcut, &parsed);
+    if (cache.size() >= kMaxCachedAccelerators)
+      cache.clear();
+    it = cache.emplace(shortcut, parsed).first;
+  }
+  if (it->second.key_code() == ui::VKEY_UNKNOWN)
+    return false;
+  *accelerator = it->second;
+  return true;
+}
+
 void GenerateAcceleratorTable(AcceleratorTable* table,
                               atom::AtomMenuModel* model) {
   int count = model->GetItemCount();
@@ -19,7 +19,7 @@ typedef struct {
 } MenuItem;
 typedef std::map<ui::Accelerator, MenuItem> AcceleratorTable;
 
-// Parse a string as an accelerator.
+// Parse a string as an accelerator, the results are cached.
 bool StringToAccelerator(const std::string& description,
                          ui::Accelerator* accelerator);
 
@@ -103,6 +103,26 @@ display::Display GetDisplayNearestPoint(const gfx::Point& point) {
   return display::Screen::GetScreen()->GetDisplayNearestPoint(point);
 }
 
+// Returns whether the new suggestions are the old ones with some removed, and
+// if so fills |kept_rows| with the old index of each new suggestion.
+bool FindKeptRows(const std::vector<base::string16>& old_values,
+                  const std::vector<base::string16>& old_labels,
+                  const std::vector<base::string16>& values,
+                  const std::vector<base::string16>& labels,
+                  std::vector<size_t>* kept_rows) {
+  size_t old_index = 0;
+  for (size_t i = 0; i < values.size(); ++i) {
+    while (old_index < old_values.size() &&
+           (old_values[old_index] != values[i] ||
+            old_labels[old_index] != labels[i]))
+      ++old_index;
+    if (old_index == old_values.size())
+      return false;
+    kept_rows->push_back(old_index++);
+  }
+  return true;
+}
+
 }  // namespace
 
 AutofillPopup::AutofillPopup() {
@@ -159,15 +179,45 @@ void AutofillPopup::Hide() {
     view_->Hide();
     view_ = nullptr;
   }
+  values_.clear();
+  labels_.clear();
+  row_widths_.clear();
+}
+
+bool AutofillPopup::IsShowingFor(content::RenderFrameHost* frame_host,
+                                 views::View* parent,
+                                 const gfx::RectF& bounds) const {
+  return view_ && frame_host_ == frame_host && parent_ == parent &&
+         element_bounds_ == gfx::ToEnclosedRect(bounds);
 }
 
 void AutofillPopup::SetItems(const std::vector<base::string16>& values,
                              const std::vector<base::string16>& labels) {
   DCHECK(view_);
+  // Typing into the element usually only removes suggestions, then the rows
+  // that remain are kept instead of being measured and created again.
+  std::vector<size_t> kept_rows;
+  bool narrowed = FindKeptRows(values_, labels_, values, labels, &kept_rows);
+
   values_ = values;
   labels_ = labels;
+  if (narrowed) {
+    std::vector<int> row_widths;
+    row_widths.reserve(kept_rows.size());
+    for (size_t row : kept_rows)
+      row_widths.push_back(row_widths_[row]);
+    row_widths_ = std::move(row_widths);
+  } else {
+    row_widths_.clear();
+    for (size_t i = 0; i < values_.size(); ++i)
+      row_widths_.push_back(GetRowWidth(i));
+  }
+
   UpdatePopupBounds();
-  view_->OnSuggestionsChanged();
+  if (narrowed)
+    view_->OnSuggestionsNarrowed(kept_rows);
+  else
+    view_->OnSuggestionsChanged();
   if (view_)  // could be hidden after the change
     view_->DoUpdateBoundsAndRedrawPopup();
 }
@@ -234,20 +284,22 @@ int AutofillPopup::GetDesiredPopupHeight() {
 int AutofillPopup::GetDesiredPopupWidth() {
   int popup_width = element_bounds_.width();
 
-  for (size_t i = 0; i < values_.size(); ++i) {
-    int row_size =
-        kEndPadding + 2 * kPopupBorderThickness +
-        gfx::GetStringWidth(GetValueAt(i), GetValueFontListForRow(i)) +
-        gfx::GetStringWidth(GetLabelAt(i), GetLabelFontListForRow(i));
-    if (GetLabelAt(i).length() > 0)
-      row_size += kNamePadding + kEndPadding;
-
-    popup_width = std::max(popup_width, row_size);
-  }
+  for (int row_width : row_widths_)
+    popup_width = std::max(popup_width, row_width);
 
   return popup_width;
 }
 
+int AutofillPopup::GetRowWidth(int i) {
+  int row_size =
+      kEndPadding + 2 * kPopupBorderThickness +
+      gfx::GetStringWidth(GetValueAt(i), GetValueFontListForRow(i)) +
+      gfx::GetStringWidth(GetLabelAt(i), GetLabelFontListForRow(i));
+  if (GetLabelAt(i).length() > 0)
+    row_size += kNamePadding + kEndPadding;
+  return row_size;
+}
+
 gfx::Rect AutofillPopup::GetRowBounds(int index) {
   int top = kPopupBorderThickness + index * kRowHeight;
 
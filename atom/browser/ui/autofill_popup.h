@@ -30,6 +30,11 @@ class AutofillPopup : public views::ViewObserver {
                   const gfx::RectF& bounds);
   void Hide();
 
+  // Whether the popup is shown for the element at |bounds| in |frame_host|.
+  bool IsShowingFor(content::RenderFrameHost* frame_host,
+                    views::View* parent,
+                    const gfx::RectF& bounds) const;
+
   void SetItems(const std::vector<base::string16>& values,
                 const std::vector<base::string16>& labels);
   void UpdatePopupBounds();
@@ -47,6 +52,7 @@ class AutofillPopup : public views::ViewObserver {
 
   int GetDesiredPopupHeight();
   int GetDesiredPopupWidth();
+  int GetRowWidth(int i);
   gfx::Rect GetRowBounds(int i);
   const gfx::FontList& GetValueFontListForRow(int index) const;
   const gfx::FontList& GetLabelFontListForRow(int index) const;
@@ -69,6 +75,9 @@ class AutofillPopup : public views::ViewObserver {
   std::vector<base::string16> values_;
   std::vector<base::string16> labels_;
 
+  // The width each suggestion needs, measuring text is slow.
+  std::vector<int> row_widths_;
+
   // Font lists for the suggestions
   gfx::FontList smaller_font_list_;
   gfx::FontList bold_font_list_;
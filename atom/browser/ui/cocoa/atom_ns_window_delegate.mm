@@ -44,9 +44,11 @@
   if (window.occlusionState & NSWindowOcclusionStateVisible) {
     // The app is visible
     shell_->NotifyWindowShow();
+    shell_->SetOccluded(false);
   } else {
     // The app is not visible
     shell_->NotifyWindowHide();
+    shell_->SetOccluded(true);
   }
 }
 
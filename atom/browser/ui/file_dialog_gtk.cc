@@ -11,6 +11,7 @@
 #include "base/callback.h"
 #include "base/files/file_util.h"
 #include "base/strings/string_util.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/ui/libgtkui/gtk_signal.h"
 #include "chrome/browser/ui/libgtkui/gtk_util.h"
 #include "ui/views/widget/desktop_aura/x11_desktop_handler.h"
@@ -138,6 +139,7 @@ class FileChooserDialog {
   std::vector<base::FilePath> GetFileNames() const {
     std::vector<base::FilePath> paths;
     auto* filenames = gtk_file_chooser_get_filenames(GTK_FILE_CHOOSER(dialog_));
+    paths.reserve(g_slist_length(filenames));
     for (auto* iter = filenames; iter != NULL; iter = iter->next) {
       auto* filename = static_cast<char*>(iter->data);
       paths.emplace_back(filename);
@@ -169,16 +171,21 @@ class FileChooserDialog {
 void FileChooserDialog::OnFileDialogResponse(GtkWidget* widget, int response) {
   gtk_widget_hide(dialog_);
 
+  // The callbacks are run from the message loop instead of from inside the
+  // GTK signal handler.
+  auto task_runner = base::ThreadTaskRunnerHandle::Get();
+  bool accepted = response == GTK_RESPONSE_ACCEPT;
   if (!save_callback_.is_null()) {
-    if (response == GTK_RESPONSE_ACCEPT)
-      save_callback_.Run(true, GetFileName());
-    else
-      save_callback_.Run(false, base::FilePath());
+    task_runner->PostTask(
+        FROM_HERE,
+        base::BindOnce(save_callback_, accepted,
+                       accepted ? GetFileName() : base::FilePath()));
   } else if (!open_callback_.is_null()) {
-    if (response == GTK_RESPONSE_ACCEPT)
-      open_callback_.Run(true, GetFileNames());
-    else
-      open_callback_.Run(false, std::vector<base::FilePath>());
+    task_runner->PostTask(
+        FROM_HERE,
+        base::BindOnce(open_callback_, accepted,
+                       accepted ? GetFileNames()
+                                : std::vector<base::FilePath>()));
   }
   delete this;
 }
@@ -33,6 +33,10 @@ class InspectableWebContents {
                                         PrefService* pref_service,
                                         bool is_guest);
 
+  // Whether |web_contents| is a devtools WebContents that is kept after its
+  // devtools were closed, so it can be reused when they are opened again.
+  static bool IsParkedDevTools(content::WebContents* web_contents);
+
   virtual ~InspectableWebContents() {}
 
   virtual InspectableWebContentsView* GetView() const = 0;
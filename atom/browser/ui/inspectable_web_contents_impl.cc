@@ -39,6 +39,7 @@
 #include "net/url_request/url_fetcher_response_writer.h"
 #include "ui/display/display.h"
 #include "ui/display/screen.h"
+#include "url/url_constants.h"
 
 namespace atom {
 
@@ -48,6 +49,9 @@ const double kPresetZoomFactors[] = {0.25, 0.333, 0.5,  0.666, 0.75, 0.9,
                                      1.0,  1.1,   1.25, 1.5,   1.75, 2.0,
                                      2.5,  3.0,   4.0,  5.0};
 
+// Marks the managed devtools WebContents while it is parked.
+const char kParkedDevToolsKey[] = "ParkedDevTools";
+
 const char kChromeUIDevToolsURL[] =
     "chrome-devtools://devtools/bundled/devtools_app.html?"
     "remoteBase=%s&"
@@ -194,6 +198,12 @@ int ResponseWriter::Finish(int net_error,
 InspectableWebContentsView* CreateInspectableContentsView(
     InspectableWebContentsImpl* inspectable_web_contents_impl);
 
+// static
+bool InspectableWebContents::IsParkedDevTools(
+    content::WebContents* web_contents) {
+  return web_contents->GetUserData(kParkedDevToolsKey) != nullptr;
+}
+
 void InspectableWebContentsImpl::RegisterPrefs(PrefRegistrySimple* registry) {
   std::unique_ptr<base::DictionaryValue> bounds_dict(new base::DictionaryValue);
   RectToDictionary(gfx::Rect(0, 0, 800, 600), bounds_dict.get());
@@ -242,6 +252,8 @@ InspectableWebContentsImpl::InspectableWebContentsImpl(
 
 InspectableWebContentsImpl::~InspectableWebContentsImpl() {
   // Unsubscribe from devtools and Clean up resources.
+  if (parked_devtools_web_contents_)
+    parked_devtools_web_contents_->SetDelegate(nullptr);
   if (GetDevToolsWebContents()) {
     if (managed_devtools_web_contents_)
       managed_devtools_web_contents_->SetDelegate(nullptr);
@@ -302,13 +314,15 @@ void InspectableWebContentsImpl::SetDockState(const std::string& state) {
 
 void InspectableWebContentsImpl::SetDevToolsWebContents(
     content::WebContents* devtools) {
-  if (!managed_devtools_web_contents_)
+  if (!managed_devtools_web_contents_) {
+    parked_devtools_web_contents_.reset();
     external_devtools_web_contents_ = devtools;
+  }
 }
 
 void InspectableWebContentsImpl::ShowDevTools() {
   if (embedder_message_dispatcher_) {
-    if (managed_devtools_web_contents_)
+    if (managed_devtools_web_contents_ && frontend_loaded_)
       view_->ShowDevTools();
     return;
   }
@@ -318,7 +332,10 @@ void InspectableWebContentsImpl::ShowDevTools() {
   embedder_message_dispatcher_.reset(
       DevToolsEmbedderMessageDispatcher::CreateForDevToolsFrontend(this));
 
-  if (!external_devtools_web_contents_) {  // no external devtools
+  if (parked_devtools_web_contents_) {
+    managed_devtools_web_contents_ = std::move(parked_devtools_web_contents_);
+    managed_devtools_web_contents_->RemoveUserData(kParkedDevToolsKey);
+  } else if (!external_devtools_web_contents_) {  // no external devtools
     managed_devtools_web_contents_ = content::WebContents::Create(
         content::WebContents::CreateParams(web_contents_->GetBrowserContext()));
     managed_devtools_web_contents_->SetDelegate(this);
@@ -337,7 +354,15 @@ void InspectableWebContentsImpl::CloseDevTools() {
     frontend_loaded_ = false;
     if (managed_devtools_web_contents_) {
       view_->CloseDevTools();
-      managed_devtools_web_contents_.reset();
+      // Only the frontend is unloaded, the WebContents is parked for the next
+      // ShowDevTools. This also detaches the agent and reports the close.
+      parked_devtools_web_contents_ = std::move(managed_devtools_web_contents_);
+      parked_devtools_web_contents_->SetUserData(
+          kParkedDevToolsKey, std::make_unique<base::SupportsUserData::Data>());
+      WebContentsDestroyed();
+      parked_devtools_web_contents_->GetController().LoadURL(
+          GURL(url::kAboutBlankURL), content::Referrer(),
+          ui::PAGE_TRANSITION_AUTO_TOPLEVEL, std::string());
     }
     embedder_message_dispatcher_.reset();
     if (!IsGuest())
@@ -741,6 +766,7 @@ void InspectableWebContentsImpl::WebContentsDestroyed() {
 
   for (const auto& pair : pending_requests_)
     delete pair.first;
+  pending_requests_.clear();
 
   if (view_ && view_->GetDelegate())
     view_->GetDelegate()->DevToolsClosed();
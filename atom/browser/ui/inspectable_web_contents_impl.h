@@ -225,6 +225,9 @@ class InspectableWebContentsImpl
   std::unique_ptr<content::WebContents> managed_devtools_web_contents_;
   // The external devtools assigned by SetDevToolsWebContents.
   content::WebContents* external_devtools_web_contents_ = nullptr;
+  // The managed devtools after CloseDevTools, kept with its renderer process
+  // so the next ShowDevTools only has to load the frontend.
+  std::unique_ptr<content::WebContents> parked_devtools_web_contents_;
 
   bool is_guest_;
   std::unique_ptr<InspectableWebContentsView> view_;
@@ -4,6 +4,7 @@
 
 #include "atom/browser/ui/views/autofill_popup_view.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "base/bind.h"
@@ -131,6 +132,39 @@ void AutofillPopupView::OnSuggestionsChanged() {
   DoUpdateBoundsAndRedrawPopup();
 }
 
+void AutofillPopupView::OnSuggestionsNarrowed(
+    const std::vector<size_t>& kept_rows) {
+  if (!popup_)
+    return;
+
+  // Delete only the child views of the removed rows.
+  size_t next_kept = kept_rows.size();
+  for (int i = child_count() - 1; i >= 0; --i) {
+    if (next_kept > 0 && kept_rows[next_kept - 1] == static_cast<size_t>(i)) {
+      --next_kept;
+      continue;
+    }
+    views::View* child = child_at(i);
+    RemoveChildView(child);
+    delete child;
+  }
+
+  if (selected_line_) {
+    auto it = std::find(kept_rows.begin(), kept_rows.end(),
+                        static_cast<size_t>(*selected_line_));
+    if (it != kept_rows.end())
+      selected_line_ = static_cast<int>(it - kept_rows.begin());
+    else
+      selected_line_.reset();
+  }
+
+  if (popup_->GetLineCount() == 0) {
+    popup_->Hide();
+    return;
+  }
+  DoUpdateBoundsAndRedrawPopup();
+}
+
 void AutofillPopupView::WriteDragDataForView(views::View*,
                                              const gfx::Point&,
                                              ui::OSExchangeData*) {}
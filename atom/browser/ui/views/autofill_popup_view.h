@@ -6,6 +6,7 @@
 #define ATOM_BROWSER_UI_VIEWS_AUTOFILL_POPUP_VIEW_H_
 
 #include <memory>
+#include <vector>
 
 #include "atom/browser/ui/autofill_popup.h"
 
@@ -66,6 +67,9 @@ class AutofillPopupView : public views::WidgetDelegateView,
   void Hide();
 
   void OnSuggestionsChanged();
+  // Called instead when some suggestions were removed, |kept_rows| holds the
+  // previous index of each remaining suggestion.
+  void OnSuggestionsNarrowed(const std::vector<size_t>& kept_rows);
 
   int GetSelectedLine() { return selected_line_.value_or(-1); }
 
@@ -45,6 +45,8 @@ typedef DbusmenuMenuitem* (*dbusmenu_menuitem_property_set_int_func)(
     DbusmenuMenuitem* item,
     const char* property,
     int value);
+typedef void (*dbusmenu_menuitem_property_remove_func)(DbusmenuMenuitem* item,
+                                                       const char* property);
 
 typedef struct _DbusmenuServer DbusmenuServer;
 typedef DbusmenuServer* (*dbusmenu_server_new_func)(const char* object);
@@ -69,6 +71,7 @@ dbusmenu_menuitem_property_set_variant_func menuitem_property_set_variant =
     NULL;
 dbusmenu_menuitem_property_set_bool_func menuitem_property_set_bool = NULL;
 dbusmenu_menuitem_property_set_int_func menuitem_property_set_int = NULL;
+dbusmenu_menuitem_property_remove_func menuitem_property_remove = NULL;
 
 // DbusmenuServer methods:
 dbusmenu_server_new_func server_new = NULL;
@@ -126,6 +129,9 @@ void EnsureMethodsLoaded() {
   menuitem_property_set_int =
       reinterpret_cast<dbusmenu_menuitem_property_set_int_func>(
           dlsym(dbusmenu_lib, "dbusmenu_menuitem_property_set_int"));
+  menuitem_property_remove =
+      reinterpret_cast<dbusmenu_menuitem_property_remove_func>(
+          dlsym(dbusmenu_lib, "dbusmenu_menuitem_property_remove"));
 
   // DbusmenuServer methods.
   server_new = reinterpret_cast<dbusmenu_server_new_func>(
@@ -168,6 +174,32 @@ std::string GetMenuModelStatus(AtomMenuModel* model) {
   return ret;
 }
 
+// The parts of the items of |model| whose change requires the menu to be
+// built again, a change of anything else is updated in place.
+std::string GetMenuModelLayout(AtomMenuModel* model) {
+  std::string ret;
+  for (int i = 0; i < model->GetItemCount(); ++i) {
+    AtomMenuModel::ItemType type = model->GetTypeAt(i);
+    ret += base::StringPrintf(
+        "%d-%p\n", type,
+        type == AtomMenuModel::TYPE_SUBMENU ? model->GetSubmenuModelAt(i)
+                                            : nullptr);
+  }
+  return ret;
+}
+
+// Returns true when the layout saved on |item| is the one of |model|, and
+// saves the new one otherwise.
+bool IsMenuLayoutUnchanged(AtomMenuModel* model, DbusmenuMenuitem* item) {
+  std::string layout = GetMenuModelLayout(model);
+  char* old = static_cast<char*>(g_object_get_data(G_OBJECT(item), "layout"));
+  if (old && layout == old)
+    return true;
+  g_object_set_data_full(G_OBJECT(item), "layout", g_strdup(layout.c_str()),
+                         g_free);
+  return false;
+}
+
 }  // namespace
 
 GlobalMenuBarX11::GlobalMenuBarX11(NativeWindowViews* window)
@@ -181,6 +213,8 @@ GlobalMenuBarX11::GlobalMenuBarX11(NativeWindowViews* window)
 }
 
 GlobalMenuBarX11::~GlobalMenuBarX11() {
+  if (root_item_)
+    g_object_unref(root_item_);
   if (IsServerStarted())
     g_object_unref(server_);
 
@@ -196,15 +230,25 @@ void GlobalMenuBarX11::SetMenu(AtomMenuModel* menu_model) {
   if (!IsServerStarted())
     return;
 
-  DbusmenuMenuitem* root_item = menuitem_new();
-  menuitem_property_set(root_item, kPropertyLabel, "Root");
-  menuitem_property_set_bool(root_item, kPropertyVisible, true);
+  // Setting the same menu again, e.g. after toggling its items, only updates
+  // the items that changed instead of sending the whole menu over DBus.
+  if (menu_model && menu_model == menu_model_ && root_item_) {
+    UpdateMenuFromModel(menu_model, root_item_);
+    return;
+  }
+
+  if (root_item_)
+    g_object_unref(root_item_);
+  root_item_ = menuitem_new();
+  menu_model_ = menu_model;
+  menuitem_property_set(root_item_, kPropertyLabel, "Root");
+  menuitem_property_set_bool(root_item_, kPropertyVisible, true);
   if (menu_model != nullptr) {
-    BuildMenuFromModel(menu_model, root_item);
+    IsMenuLayoutUnchanged(menu_model, root_item_);
+    BuildMenuFromModel(menu_model, root_item_);
   }
 
-  server_set_root(server_, root_item);
-  g_object_unref(root_item);
+  server_set_root(server_, root_item_);
 }
 
 bool GlobalMenuBarX11::IsServerStarted() const {
@@ -228,17 +272,11 @@ void GlobalMenuBarX11::BuildMenuFromModel(AtomMenuModel* model,
                                           DbusmenuMenuitem* parent) {
   for (int i = 0; i < model->GetItemCount(); ++i) {
     DbusmenuMenuitem* item = menuitem_new();
-    menuitem_property_set_bool(item, kPropertyVisible, model->IsVisibleAt(i));
 
     AtomMenuModel::ItemType type = model->GetTypeAt(i);
     if (type == AtomMenuModel::TYPE_SEPARATOR) {
       menuitem_property_set(item, kPropertyType, kTypeSeparator);
     } else {
-      std::string label = ui::ConvertAcceleratorsFromWindowsStyle(
-          base::UTF16ToUTF8(model->GetLabelAt(i)));
-      menuitem_property_set(item, kPropertyLabel, label.c_str());
-      menuitem_property_set_bool(item, kPropertyEnabled, model->IsEnabledAt(i));
-
       g_object_set_data(G_OBJECT(item), "model", model);
       SetMenuItemID(item, i);
 
@@ -247,10 +285,6 @@ void GlobalMenuBarX11::BuildMenuFromModel(AtomMenuModel* model,
         g_signal_connect(item, "about-to-show", G_CALLBACK(OnSubMenuShowThunk),
                          this);
       } else {
-        ui::Accelerator accelerator;
-        if (model->GetAcceleratorAtWithParams(i, true, &accelerator))
-          RegisterAccelerator(item, accelerator);
-
         g_signal_connect(item, "item-activated",
                          G_CALLBACK(OnItemActivatedThunk), this);
 
@@ -259,17 +293,65 @@ void GlobalMenuBarX11::BuildMenuFromModel(AtomMenuModel* model,
           menuitem_property_set(
               item, kPropertyToggleType,
               type == AtomMenuModel::TYPE_CHECK ? kToggleCheck : kToggleRadio);
-          menuitem_property_set_int(item, kPropertyToggleState,
-                                    model->IsItemCheckedAt(i));
         }
       }
     }
+    UpdateMenuItem(model, i, item);
 
     menuitem_child_append(parent, item);
     g_object_unref(item);
   }
 }
 
+void GlobalMenuBarX11::UpdateMenuFromModel(AtomMenuModel* model,
+                                           DbusmenuMenuitem* parent) {
+  if (!IsMenuLayoutUnchanged(model, parent)) {
+    GList* children = menuitem_take_children(parent);
+    g_list_foreach(children, reinterpret_cast<GFunc>(g_object_unref), NULL);
+    g_list_free(children);
+    BuildMenuFromModel(model, parent);
+    return;
+  }
+
+  // libdbusmenu only signals the properties whose value changed, so setting
+  // all of them again is cheap.
+  GList* children = menuitem_get_children(parent);
+  for (int i = 0; i < model->GetItemCount() && children;
+       ++i, children = children->next) {
+    UpdateMenuItem(model, i, static_cast<DbusmenuMenuitem*>(children->data));
+  }
+}
+
+void GlobalMenuBarX11::UpdateMenuItem(AtomMenuModel* model,
+                                      int index,
+                                      DbusmenuMenuitem* item) {
+  menuitem_property_set_bool(item, kPropertyVisible,
+                             model->IsVisibleAt(index));
+
+  AtomMenuModel::ItemType type = model->GetTypeAt(index);
+  if (type == AtomMenuModel::TYPE_SEPARATOR)
+    return;
+
+  std::string label = ui::ConvertAcceleratorsFromWindowsStyle(
+      base::UTF16ToUTF8(model->GetLabelAt(index)));
+  menuitem_property_set(item, kPropertyLabel, label.c_str());
+  menuitem_property_set_bool(item, kPropertyEnabled,
+                             model->IsEnabledAt(index));
+  if (type == AtomMenuModel::TYPE_SUBMENU)
+    return;
+
+  ui::Accelerator accelerator;
+  if (model->GetAcceleratorAtWithParams(index, true, &accelerator))
+    RegisterAccelerator(item, accelerator);
+  else
+    menuitem_property_remove(item, kPropertyShortcut);
+
+  if (type == AtomMenuModel::TYPE_CHECK || type == AtomMenuModel::TYPE_RADIO) {
+    menuitem_property_set_int(item, kPropertyToggleState,
+                              model->IsItemCheckedAt(index));
+  }
+}
+
 void GlobalMenuBarX11::RegisterAccelerator(DbusmenuMenuitem* item,
                                            const ui::Accelerator& accelerator) {
   // A translation of libdbusmenu-gtk's menuitem_property_set_shortcut()
@@ -288,6 +370,7 @@ void GlobalMenuBarX11::RegisterAccelerator(DbusmenuMenuitem* item,
       XKeysymToString(XKeysymForWindowsKeyCode(accelerator.key_code(), false));
   if (!name) {
     NOTIMPLEMENTED();
+    menuitem_property_remove(item, kPropertyShortcut);
     return;
   }
   g_variant_builder_add(&builder, "s", name);
@@ -315,7 +398,8 @@ void GlobalMenuBarX11::OnSubMenuShow(DbusmenuMenuitem* item) {
     return;
 
   // Do not update menu if the submenu has not been changed.
-  std::string status = GetMenuModelStatus(model);
+  AtomMenuModel* submenu = model->GetSubmenuModelAt(id);
+  std::string status = GetMenuModelStatus(submenu);
   char* old = static_cast<char*>(g_object_get_data(G_OBJECT(item), "status"));
   if (old && status == old)
     return;
@@ -324,13 +408,7 @@ void GlobalMenuBarX11::OnSubMenuShow(DbusmenuMenuitem* item) {
   g_object_set_data_full(G_OBJECT(item), "status", g_strdup(status.c_str()),
                          g_free);
 
-  // Clear children.
-  GList* children = menuitem_take_children(item);
-  g_list_foreach(children, reinterpret_cast<GFunc>(g_object_unref), NULL);
-  g_list_free(children);
-
-  // Build children.
-  BuildMenuFromModel(model->GetSubmenuModelAt(id), item);
+  UpdateMenuFromModel(submenu, item);
 }
 
 }  // namespace atom
@@ -57,6 +57,13 @@ class GlobalMenuBarX11 {
   // Create a menu from menu model.
   void BuildMenuFromModel(AtomMenuModel* model, DbusmenuMenuitem* parent);
 
+  // Updates the children of |parent| in place when the items of |model| only
+  // changed their state, otherwise builds them again.
+  void UpdateMenuFromModel(AtomMenuModel* model, DbusmenuMenuitem* parent);
+
+  // Sets the properties of |item| that can change without a rebuild.
+  void UpdateMenuItem(AtomMenuModel* model, int index, DbusmenuMenuitem* item);
+
   // Sets the accelerator for |item|.
   void RegisterAccelerator(DbusmenuMenuitem* item,
                            const ui::Accelerator& accelerator);
@@ -73,6 +80,11 @@ class GlobalMenuBarX11 {
 
   DbusmenuServer* server_ = nullptr;
 
+  // The root of the menu that is set on |server_|, reused while the same
+  // model is set again.
+  DbusmenuMenuitem* root_item_ = nullptr;
+  AtomMenuModel* menu_model_ = nullptr;
+
   DISALLOW_COPY_AND_ASSIGN(GlobalMenuBarX11);
 };
 
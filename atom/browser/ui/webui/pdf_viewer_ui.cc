@@ -13,6 +13,8 @@
 #include "atom/browser/ui/webui/pdf_viewer_handler.h"
 #include "atom/common/api/api_messages.h"
 #include "atom/common/atom_constants.h"
+#include "base/guid.h"
+#include "base/no_destructor.h"
 #include "base/sequenced_task_runner_helpers.h"
 #include "content/browser/loader/resource_dispatcher_host_impl.h"
 #include "content/browser/loader/resource_request_info_impl.h"
@@ -43,6 +45,23 @@ namespace atom {
 
 namespace {
 
+// How long an intercepted stream waits for its viewer to be created.
+constexpr base::TimeDelta kInterceptedStreamTimeout =
+    base::TimeDelta::FromSeconds(30);
+
+using InterceptedStreamMap =
+    std::map<std::string, std::unique_ptr<content::StreamInfo>>;
+
+InterceptedStreamMap& GetInterceptedStreams() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  static base::NoDestructor<InterceptedStreamMap> streams;
+  return *streams;
+}
+
+void ReleaseInterceptedStream(const std::string& stream_id) {
+  GetInterceptedStreams().erase(stream_id);
+}
+
 // Extracts the path value from the URL without the leading '/',
 // which follows the mapping of names in pdf_viewer_resources_map.
 std::string PathWithoutParams(const std::string& path) {
@@ -203,10 +222,12 @@ class PdfViewerUI::ResourceRequester
 
 PdfViewerUI::PdfViewerUI(content::BrowserContext* browser_context,
                          content::WebUI* web_ui,
-                         const std::string& src)
+                         const std::string& src,
+                         const std::string& stream_id)
     : content::WebUIController(web_ui),
       content::WebContentsObserver(web_ui->GetWebContents()),
-      src_(src) {
+      src_(src),
+      stream_id_(stream_id) {
   pdf_handler_ = new PdfViewerHandler(src);
   web_ui->AddMessageHandler(
       std::unique_ptr<content::WebUIMessageHandler>(pdf_handler_));
@@ -215,6 +236,30 @@ PdfViewerUI::PdfViewerUI(content::BrowserContext* browser_context,
 
 PdfViewerUI::~PdfViewerUI() {}
 
+// static
+std::string PdfViewerUI::AddInterceptedStream(
+    std::unique_ptr<content::StreamInfo> stream) {
+  std::string stream_id = base::GenerateGUID();
+  GetInterceptedStreams()[stream_id] = std::move(stream);
+  BrowserThread::PostDelayedTask(
+      BrowserThread::UI, FROM_HERE,
+      base::BindOnce(&ReleaseInterceptedStream, stream_id),
+      kInterceptedStreamTimeout);
+  return stream_id;
+}
+
+// static
+std::unique_ptr<content::StreamInfo> PdfViewerUI::TakeInterceptedStream(
+    const std::string& stream_id) {
+  auto& streams = GetInterceptedStreams();
+  auto it = streams.find(stream_id);
+  if (it == streams.end())
+    return nullptr;
+  auto stream = std::move(it->second);
+  streams.erase(it);
+  return stream;
+}
+
 bool PdfViewerUI::OnMessageReceived(
     const IPC::Message& message,
     content::RenderFrameHost* render_frame_host) {
@@ -235,6 +280,17 @@ void PdfViewerUI::OnPdfStreamCreated(
 }
 
 void PdfViewerUI::RenderFrameCreated(content::RenderFrameHost* rfh) {
+  // Read from the response that was intercepted by the navigation when it is
+  // still around, instead of requesting the resource again.
+  if (!stream_id_.empty()) {
+    auto stream = TakeInterceptedStream(stream_id_);
+    stream_id_.clear();
+    if (stream) {
+      OnPdfStreamCreated(std::move(stream));
+      return;
+    }
+  }
+
   int render_process_id = rfh->GetProcess()->GetID();
   int render_frame_id = rfh->GetRoutingID();
   int render_view_id = rfh->GetRenderViewHost()->GetRoutingID();
@@ -27,9 +27,18 @@ class PdfViewerUI : public content::WebUIController,
  public:
   PdfViewerUI(content::BrowserContext* browser_context,
               content::WebUI* web_ui,
-              const std::string& src);
+              const std::string& src,
+              const std::string& stream_id);
   ~PdfViewerUI() override;
 
+  // Keeps the stream of an intercepted PDF response until the viewer for it
+  // is created, returns the id to pass to the viewer. Streams that are not
+  // claimed in time are released, which cancels the underlying request.
+  static std::string AddInterceptedStream(
+      std::unique_ptr<content::StreamInfo> stream);
+  static std::unique_ptr<content::StreamInfo> TakeInterceptedStream(
+      const std::string& stream_id);
+
   // content::WebContentsObserver:
   bool OnMessageReceived(const IPC::Message& message,
                          content::RenderFrameHost* render_frame_host) override;
@@ -46,6 +55,9 @@ class PdfViewerUI : public content::WebUIController,
   // Source URL from where the PDF originates.
   std::string src_;
 
+  // Id of the intercepted stream to read the PDF from, cleared once claimed.
+  std::string stream_id_;
+
   PdfViewerHandler* pdf_handler_;
 
   scoped_refptr<ResourceRequester> resource_requester_;
@@ -147,10 +147,22 @@ namespace atom {
 JumpListItem::JumpListItem() = default;
 JumpListItem::JumpListItem(const JumpListItem&) = default;
 JumpListItem::~JumpListItem() = default;
+
+bool JumpListItem::operator==(const JumpListItem& other) const {
+  return type == other.type && path == other.path &&
+         arguments == other.arguments && title == other.title &&
+         description == other.description && icon_path == other.icon_path &&
+         icon_index == other.icon_index;
+}
+
 JumpListCategory::JumpListCategory() = default;
 JumpListCategory::JumpListCategory(const JumpListCategory&) = default;
 JumpListCategory::~JumpListCategory() = default;
 
+bool JumpListCategory::operator==(const JumpListCategory& other) const {
+  return type == other.type && name == other.name && items == other.items;
+}
+
 JumpList::JumpList(const base::string16& app_id) : app_id_(app_id) {
   destinations_.CoCreateInstance(CLSID_DestinationList);
 }
@@ -55,6 +55,8 @@ struct JumpListItem {
   JumpListItem();
   JumpListItem(const JumpListItem&);
   ~JumpListItem();
+
+  bool operator==(const JumpListItem& other) const;
 };
 
 struct JumpListCategory {
@@ -78,6 +80,8 @@ struct JumpListCategory {
   JumpListCategory();
   JumpListCategory(const JumpListCategory&);
   ~JumpListCategory();
+
+  bool operator==(const JumpListCategory& other) const;
 };
 
 // Creates or removes a custom Jump List for an app.
@@ -8,12 +8,14 @@
 #include <string>
 
 #include "atom/browser/native_window.h"
+#include "base/bind.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/win/scoped_gdi_object.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/display/win/screen_win.h"
 #include "ui/gfx/icon_util.h"
+#include "ui/gfx/skia_util.h"
 
 namespace atom {
 
@@ -27,6 +29,10 @@ const size_t kMaxButtonsCount = 7;
 // The base id of Thumbar button.
 const int kButtonIdBase = 40001;
 
+// The minimum time between two updates of the progress value.
+constexpr base::TimeDelta kProgressInterval =
+    base::TimeDelta::FromMilliseconds(100);
+
 bool GetThumbarButtonFlags(const std::vector<std::string>& flags,
                            THUMBBUTTONFLAGS* out) {
   THUMBBUTTONFLAGS result = THBF_ENABLED;  // THBF_ENABLED == 0
@@ -126,6 +132,13 @@ bool TaskbarHost::SetThumbarButtons(HWND window,
 }
 
 void TaskbarHost::RestoreThumbarButtons(HWND window) {
+  // The new tab doesn't have the progress and overlay of the old one either.
+  progress_timer_.Stop();
+  progress_value_ = -1;
+  progress_state_ = NativeWindow::PROGRESS_NONE;
+  overlay_bitmap_.reset();
+  overlay_text_.clear();
+
   if (thumbar_buttons_added_) {
     thumbar_buttons_added_ = false;
     SetThumbarButtons(window, last_buttons_);
@@ -135,46 +148,58 @@ void TaskbarHost::RestoreThumbarButtons(HWND window) {
 bool TaskbarHost::SetProgressBar(HWND window,
                                  double value,
                                  const NativeWindow::ProgressState state) {
-  if (!InitializeTaskbar())
-    return false;
+  NativeWindow::ProgressState new_state = state;
+  int new_value = -1;
+  if (value > 1.0 || state == NativeWindow::PROGRESS_INDETERMINATE)
+    new_state = NativeWindow::PROGRESS_INDETERMINATE;
+  else if (value < 0 || state == NativeWindow::PROGRESS_NONE)
+    new_state = NativeWindow::PROGRESS_NONE;
+  else
+    new_value = static_cast<int>(value * 100);
 
-  bool success;
-  if (value > 1.0 || state == NativeWindow::PROGRESS_INDETERMINATE) {
-    success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_INDETERMINATE));
-  } else if (value < 0 || state == NativeWindow::PROGRESS_NONE) {
-    success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_NOPROGRESS));
-  } else {
-    // Unless SetProgressState set a blocking state (TBPF_ERROR, TBPF_PAUSED)
-    // for the window, a call to SetProgressValue assumes the TBPF_NORMAL
-    // state even if it is not explicitly set.
-    // SetProgressValue overrides and clears the TBPF_INDETERMINATE state.
-    if (state == NativeWindow::PROGRESS_ERROR) {
-      success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_ERROR));
-    } else if (state == NativeWindow::PROGRESS_PAUSED) {
-      success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_PAUSED));
-    } else {
-      success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_NORMAL));
+  if (new_state == progress_state_) {
+    if (new_value == progress_value_) {
+      progress_timer_.Stop();
+      return true;
     }
-
-    if (success) {
-      int val = static_cast<int>(value * 100);
-      success = SUCCEEDED(taskbar_->SetProgressValue(window, val, 100));
+    // Apps often report the progress of every chunk of a download, the
+    // taskbar doesn't need to be updated that often.
+    base::TimeDelta elapsed = base::TimeTicks::Now() - last_progress_time_;
+    if (elapsed < kProgressInterval) {
+      pending_progress_window_ = window;
+      pending_progress_value_ = new_value;
+      if (!progress_timer_.IsRunning()) {
+        progress_timer_.Start(
+            FROM_HERE, kProgressInterval - elapsed,
+            base::Bind(&TaskbarHost::ApplyPendingProgressBar,
+                       base::Unretained(this)));
+      }
+      return true;
     }
   }
 
-  return success;
+  progress_timer_.Stop();
+  return ApplyProgressBar(window, new_value, new_state);
 }
 
 bool TaskbarHost::SetOverlayIcon(HWND window,
                                  const gfx::Image& overlay,
                                  const std::string& text) {
+  SkBitmap bitmap = overlay.AsBitmap();
+  if (text == overlay_text_ && gfx::BitmapsAreEqual(bitmap, overlay_bitmap_))
+    return true;
+
   if (!InitializeTaskbar())
     return false;
 
-  base::win::ScopedHICON icon(
-      IconUtil::CreateHICONFromSkBitmap(overlay.AsBitmap()));
-  return SUCCEEDED(taskbar_->SetOverlayIcon(window, icon.get(),
-                                            base::UTF8ToUTF16(text).c_str()));
+  base::win::ScopedHICON icon(IconUtil::CreateHICONFromSkBitmap(bitmap));
+  if (FAILED(taskbar_->SetOverlayIcon(window, icon.get(),
+                                      base::UTF8ToUTF16(text).c_str())))
+    return false;
+
+  overlay_bitmap_ = bitmap;
+  overlay_text_ = text;
+  return true;
 }
 
 bool TaskbarHost::SetThumbnailClip(HWND window, const gfx::Rect& region) {
@@ -208,6 +233,47 @@ bool TaskbarHost::HandleThumbarButtonEvent(int button_id) {
   return false;
 }
 
+bool TaskbarHost::ApplyProgressBar(HWND window,
+                                   int value,
+                                   const NativeWindow::ProgressState state) {
+  if (!InitializeTaskbar())
+    return false;
+
+  bool success;
+  if (state == NativeWindow::PROGRESS_INDETERMINATE) {
+    success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_INDETERMINATE));
+  } else if (state == NativeWindow::PROGRESS_NONE) {
+    success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_NOPROGRESS));
+  } else {
+    // Unless SetProgressState set a blocking state (TBPF_ERROR, TBPF_PAUSED)
+    // for the window, a call to SetProgressValue assumes the TBPF_NORMAL
+    // state even if it is not explicitly set.
+    // SetProgressValue overrides and clears the TBPF_INDETERMINATE state.
+    if (state == NativeWindow::PROGRESS_ERROR) {
+      success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_ERROR));
+    } else if (state == NativeWindow::PROGRESS_PAUSED) {
+      success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_PAUSED));
+    } else {
+      success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_NORMAL));
+    }
+
+    if (success)
+      success = SUCCEEDED(taskbar_->SetProgressValue(window, value, 100));
+  }
+
+  if (success) {
+    progress_value_ = value;
+    progress_state_ = state;
+    last_progress_time_ = base::TimeTicks::Now();
+  }
+  return success;
+}
+
+void TaskbarHost::ApplyPendingProgressBar() {
+  ApplyProgressBar(pending_progress_window_, pending_progress_value_,
+                   progress_state_);
+}
+
 bool TaskbarHost::InitializeTaskbar() {
   if (taskbar_)
     return true;
@@ -14,6 +14,9 @@
 
 #include "atom/browser/native_window.h"
 #include "base/callback.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/gfx/geometry/rect.h"
 #include "ui/gfx/image/image.h"
 
@@ -41,12 +44,13 @@ class TaskbarHost {
 
   void RestoreThumbarButtons(HWND window);
 
-  // Set the progress state in taskbar.
+  // Set the progress state in taskbar. Changes of only the value are applied
+  // at most ten times a second, the last one is applied with a delay.
   bool SetProgressBar(HWND window,
                       double value,
                       const NativeWindow::ProgressState state);
 
-  // Set the overlay icon in taskbar.
+  // Set the overlay icon in taskbar, does nothing if it is already shown.
   bool SetOverlayIcon(HWND window,
                       const gfx::Image& overlay,
                       const std::string& text);
@@ -64,6 +68,11 @@ class TaskbarHost {
   // Initialize the taskbar object.
   bool InitializeTaskbar();
 
+  bool ApplyProgressBar(HWND window,
+                        int value,
+                        const NativeWindow::ProgressState state);
+  void ApplyPendingProgressBar();
+
   using CallbackMap = std::map<int, base::Closure>;
   CallbackMap callback_map_;
 
@@ -75,6 +84,20 @@ class TaskbarHost {
   // Whether we have already added the buttons to thumbar.
   bool thumbar_buttons_added_ = false;
 
+  // The progress shown in taskbar, in percent or -1 without a value.
+  int progress_value_ = -1;
+  NativeWindow::ProgressState progress_state_ = NativeWindow::PROGRESS_NONE;
+  base::TimeTicks last_progress_time_;
+
+  // The progress to show once |progress_timer_| fires.
+  HWND pending_progress_window_ = nullptr;
+  int pending_progress_value_ = -1;
+  base::OneShotTimer progress_timer_;
+
+  // The overlay shown in taskbar.
+  SkBitmap overlay_bitmap_;
+  std::string overlay_text_;
+
   DISALLOW_COPY_AND_ASSIGN(TaskbarHost);
 };
 
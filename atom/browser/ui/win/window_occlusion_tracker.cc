@@ -0,0 +1,159 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/ui/win/window_occlusion_tracker.h"
+
+#include <dwmapi.h>
+
+#include "atom/browser/native_window.h"
+#include "base/bind.h"
+#include "base/win/scoped_gdi_object.h"
+
+namespace atom {
+
+namespace {
+
+// The events of a drag are merged into one update.
+const int kUpdateDelayMs = 100;
+
+// The ranges of the events that can change the occlusion of a window. The
+// location changes of the whole system, which come with every move of the
+// cursor or of a caret, would wake the UI thread all the time, so they are only
+// received for the windows of this process, and the windows of other processes
+// are updated when they are done being dragged or resized.
+const struct {
+  DWORD min;
+  DWORD max;
+  bool this_process_only;
+} kEventRanges[] = {
+    {EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, false},
+    {EVENT_SYSTEM_MOVESIZEEND, EVENT_SYSTEM_MOVESIZEEND, false},
+    {EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND, false},
+    {EVENT_OBJECT_SHOW, EVENT_OBJECT_REORDER, false},
+    {EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE, true},
+    {EVENT_OBJECT_CLOAKED, EVENT_OBJECT_UNCLOAKED, false},
+};
+
+// Windows that may be translucent, on other virtual desktops, or that let the
+// input through do not cover the windows below them.
+bool IsCoveringWindow(HWND hwnd) {
+  if (!IsWindowVisible(hwnd) || IsIconic(hwnd))
+    return false;
+
+  LONG ex_style = GetWindowLong(hwnd, GWL_EXSTYLE);
+  if (ex_style & (WS_EX_LAYERED | WS_EX_TRANSPARENT | WS_EX_NOACTIVATE))
+    return false;
+
+  BOOL cloaked = FALSE;
+  if (SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_CLOAKED, &cloaked,
+                                      sizeof(cloaked))) &&
+      cloaked)
+    return false;
+  return true;
+}
+
+bool IsWindowOccluded(HWND hwnd) {
+  if (IsIconic(hwnd))
+    return true;
+  if (!IsWindowVisible(hwnd))
+    return false;
+
+  RECT rect;
+  if (!GetWindowRect(hwnd, &rect))
+    return false;
+  base::win::ScopedRegion visible(CreateRectRgnIndirect(&rect));
+
+  // GW_HWNDPREV walks up the z-order, from the window to the topmost one.
+  for (HWND above = GetWindow(hwnd, GW_HWNDPREV); above;
+       above = GetWindow(above, GW_HWNDPREV)) {
+    RECT above_rect;
+    if (!IsCoveringWindow(above) || !GetWindowRect(above, &above_rect))
+      continue;
+    base::win::ScopedRegion covered(CreateRectRgnIndirect(&above_rect));
+    if (CombineRgn(visible.get(), visible.get(), covered.get(), RGN_DIFF) ==
+        NULLREGION)
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+// static
+WindowOcclusionTracker* WindowOcclusionTracker::GetInstance() {
+  return base::Singleton<WindowOcclusionTracker>::get();
+}
+
+WindowOcclusionTracker::WindowOcclusionTracker() = default;
+
+WindowOcclusionTracker::~WindowOcclusionTracker() {
+  for (HWINEVENTHOOK hook : hooks_)
+    UnhookWinEvent(hook);
+}
+
+void WindowOcclusionTracker::Track(NativeWindow* window, HWND hwnd) {
+  windows_[window] = hwnd;
+  // The events are received by the message loop of this thread, including
+  // the ones of the windows of this thread, which can cover each other.
+  if (hooks_.empty()) {
+    for (const auto& range : kEventRanges) {
+      DWORD process = range.this_process_only ? GetCurrentProcessId() : 0;
+      HWINEVENTHOOK hook =
+          SetWinEventHook(range.min, range.max, nullptr,
+                          &WindowOcclusionTracker::OnWinEvent, process, 0,
+                          WINEVENT_OUTOFCONTEXT);
+      if (hook)
+        hooks_.push_back(hook);
+    }
+  }
+  ScheduleUpdate();
+}
+
+void WindowOcclusionTracker::Untrack(NativeWindow* window) {
+  windows_.erase(window);
+  if (!windows_.empty())
+    return;
+  for (HWINEVENTHOOK hook : hooks_)
+    UnhookWinEvent(hook);
+  hooks_.clear();
+  update_timer_.Stop();
+}
+
+// static
+void CALLBACK WindowOcclusionTracker::OnWinEvent(HWINEVENTHOOK hook,
+                                                 DWORD event,
+                                                 HWND hwnd,
+                                                 LONG id_object,
+                                                 LONG id_child,
+                                                 DWORD event_thread,
+                                                 DWORD event_time) {
+  // Only the top-level windows matter, not their carets or children. The checks
+  // that do not call into the system come first, and nothing is checked while
+  // an update is already scheduled.
+  if (id_object != OBJID_WINDOW || !hwnd)
+    return;
+  WindowOcclusionTracker* self = GetInstance();
+  if (self->update_timer_.IsRunning() || GetAncestor(hwnd, GA_ROOT) != hwnd)
+    return;
+  self->ScheduleUpdate();
+}
+
+void WindowOcclusionTracker::ScheduleUpdate() {
+  if (update_timer_.IsRunning())
+    return;
+  update_timer_.Start(
+      FROM_HERE, base::TimeDelta::FromMilliseconds(kUpdateDelayMs),
+      base::Bind(&WindowOcclusionTracker::Update, base::Unretained(this)));
+}
+
+void WindowOcclusionTracker::Update() {
+  // The windows may be closed while they are updated.
+  std::map<NativeWindow*, HWND> windows = windows_;
+  for (const auto& it : windows) {
+    if (windows_.count(it.first))
+      it.first->SetOccluded(IsWindowOccluded(it.second));
+  }
+}
+
+}  // namespace atom
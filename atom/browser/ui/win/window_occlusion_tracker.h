@@ -0,0 +1,57 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_UI_WIN_WINDOW_OCCLUSION_TRACKER_H_
+#define ATOM_BROWSER_UI_WIN_WINDOW_OCCLUSION_TRACKER_H_
+
+#include <windows.h>
+
+#include <map>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/singleton.h"
+#include "base/timer/timer.h"
+
+namespace atom {
+
+class NativeWindow;
+
+// Finds out whether the tracked windows are fully covered by the other
+// windows of the desktop, whenever a window is moved, shown, hidden or
+// brought to the front.
+class WindowOcclusionTracker {
+ public:
+  static WindowOcclusionTracker* GetInstance();
+
+  void Track(NativeWindow* window, HWND hwnd);
+  void Untrack(NativeWindow* window);
+
+ private:
+  friend struct base::DefaultSingletonTraits<WindowOcclusionTracker>;
+
+  WindowOcclusionTracker();
+  ~WindowOcclusionTracker();
+
+  static void CALLBACK OnWinEvent(HWINEVENTHOOK hook,
+                                  DWORD event,
+                                  HWND hwnd,
+                                  LONG id_object,
+                                  LONG id_child,
+                                  DWORD event_thread,
+                                  DWORD event_time);
+
+  void ScheduleUpdate();
+  void Update();
+
+  std::map<NativeWindow*, HWND> windows_;
+  std::vector<HWINEVENTHOOK> hooks_;
+  base::OneShotTimer update_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(WindowOcclusionTracker);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_UI_WIN_WINDOW_OCCLUSION_TRACKER_H_
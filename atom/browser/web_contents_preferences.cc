@@ -10,11 +10,13 @@
 #include <vector>
 
 #include "atom/browser/native_window.h"
+#include "atom/browser/session_preferences.h"
 #include "atom/browser/web_view_manager.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/options_switches.h"
 #include "base/command_line.h"
 #include "base/memory/ptr_util.h"
+#include "base/optional.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "cc/base/switches.h"
@@ -79,6 +81,26 @@ bool GetAsInteger(const base::Value* val,
 
 namespace atom {
 
+struct WebContentsPreferences::Parsed {
+  Parsed() : switches(base::CommandLine::NO_PROGRAM) {}
+
+  bool Has(Flag flag) const { return flags & static_cast<uint32_t>(flag); }
+
+  uint32_t flags = 0;
+
+  // The switches that only depend on the preferences.
+  base::CommandLine switches;
+  int guest_instance_id = 0;
+
+  std::vector<std::pair<content::ScriptFontFamilyMap content::WebPreferences::*,
+                        base::string16>>
+      font_families;
+  base::Optional<int> default_font_size;
+  base::Optional<int> default_fixed_font_size;
+  base::Optional<int> minimum_font_size;
+  base::Optional<std::string> default_encoding;
+};
+
 // static
 std::vector<WebContentsPreferences*> WebContentsPreferences::instances_;
 
@@ -156,14 +178,20 @@ bool WebContentsPreferences::IsEnabled(const base::StringPiece& name,
   return default_value;
 }
 
+bool WebContentsPreferences::IsEnabled(Flag flag) const {
+  return GetParsed().Has(flag);
+}
+
 void WebContentsPreferences::Merge(const base::DictionaryValue& extend) {
   if (preference_.is_dict())
     static_cast<base::DictionaryValue*>(&preference_)->MergeDictionary(&extend);
+  OnPreferenceChanged();
 }
 
 void WebContentsPreferences::Clear() {
   if (preference_.is_dict())
     static_cast<base::DictionaryValue*>(&preference_)->Clear();
+  OnPreferenceChanged();
 }
 
 bool WebContentsPreferences::GetPreference(const base::StringPiece& name,
@@ -171,8 +199,19 @@ bool WebContentsPreferences::GetPreference(const base::StringPiece& name,
   return GetAsString(&preference_, name, value);
 }
 
+void WebContentsPreferences::SetPreference(const base::StringPiece& name,
+                                           base::Value value) {
+  preference_.SetKey(name, std::move(value));
+  OnPreferenceChanged();
+}
+
 bool WebContentsPreferences::IsRemoteModuleEnabled() const {
-  return IsEnabled(options::kEnableRemoteModule, true);
+  return IsEnabled(Flag::kRemoteModule);
+}
+
+void WebContentsPreferences::OnPreferenceChanged() {
+  parsed_.reset();
+  last_preference_needs_update_ = true;
 }
 
 bool WebContentsPreferences::GetPreloadPath(
@@ -218,42 +257,69 @@ WebContentsPreferences* WebContentsPreferences::From(
   return FromWebContents(web_contents);
 }
 
-void WebContentsPreferences::AppendCommandLineSwitches(
-    base::CommandLine* command_line) {
+std::unique_ptr<WebContentsPreferences::Parsed> WebContentsPreferences::Parse()
+    const {
+  auto parsed = std::make_unique<Parsed>();
+  auto set_flag = [&parsed](Flag flag, bool enabled) {
+    if (enabled)
+      parsed->flags |= static_cast<uint32_t>(flag);
+  };
+  bool node_integration = IsEnabled(options::kNodeIntegration, true);
+  bool web_security = IsEnabled(options::kWebSecurity, true);
+  set_flag(Flag::kPlugins, IsEnabled(options::kPlugins));
+  set_flag(Flag::kExperimentalFeatures,
+           IsEnabled(options::kExperimentalFeatures));
+  set_flag(Flag::kNodeIntegration, node_integration);
+  set_flag(Flag::kNodeIntegrationInWorker,
+           IsEnabled(options::kNodeIntegrationInWorker));
+  // TODO(kevinsawicki): Default to false in 2.0
+  set_flag(Flag::kWebviewTag,
+           IsEnabled(options::kWebviewTag, node_integration));
+  set_flag(Flag::kSandbox, IsEnabled(options::kSandbox));
+  set_flag(Flag::kNativeWindowOpen, IsEnabled(options::kNativeWindowOpen));
+  set_flag(Flag::kContextIsolation, IsEnabled(options::kContextIsolation));
+  set_flag(Flag::kRemoteModule, IsEnabled(options::kEnableRemoteModule, true));
+  set_flag(Flag::kOffscreen, IsEnabled(options::kOffscreen));
+#if defined(OS_MACOSX)
+  set_flag(Flag::kScrollBounce, IsEnabled(options::kScrollBounce));
+#endif
+  set_flag(Flag::kDisablePopups, IsEnabled("disablePopups"));
+  set_flag(Flag::kJavascript, IsEnabled("javascript", true));
+  set_flag(Flag::kImages, IsEnabled("images", true));
+  set_flag(Flag::kTextAreasAreResizable,
+           IsEnabled("textAreasAreResizable", true));
+  set_flag(Flag::kNavigateOnDragDrop, IsEnabled("navigateOnDragDrop"));
+  set_flag(Flag::kWebGL, IsEnabled("webgl", true));
+  set_flag(Flag::kWebSecurity, web_security);
+  set_flag(Flag::kAllowRunningInsecureContent,
+           IsEnabled(options::kAllowRunningInsecureContent, !web_security));
+
+  base::CommandLine* command_line = &parsed->switches;
+
   // Check if plugins are enabled.
-  if (IsEnabled(options::kPlugins))
+  if (parsed->Has(Flag::kPlugins))
     command_line->AppendSwitch(switches::kEnablePlugins);
 
   // Experimental flags.
-  if (IsEnabled(options::kExperimentalFeatures))
+  if (parsed->Has(Flag::kExperimentalFeatures))
     command_line->AppendSwitch(
         ::switches::kEnableExperimentalWebPlatformFeatures);
 
   // Check if we have node integration specified.
-  bool enable_node_integration = IsEnabled(options::kNodeIntegration, true);
   command_line->AppendSwitchASCII(switches::kNodeIntegration,
-                                  enable_node_integration ? "true" : "false");
+                                  node_integration ? "true" : "false");
 
   // Whether to enable node integration in Worker.
-  if (IsEnabled(options::kNodeIntegrationInWorker))
+  if (parsed->Has(Flag::kNodeIntegrationInWorker))
     command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
 
   // Check if webview tag creation is enabled, default to nodeIntegration value.
-  // TODO(kevinsawicki): Default to false in 2.0
-  bool webview_tag = IsEnabled(options::kWebviewTag, enable_node_integration);
-  command_line->AppendSwitchASCII(switches::kWebviewTag,
-                                  webview_tag ? "true" : "false");
-
-  // If the `sandbox` option was passed to the BrowserWindow's webPreferences,
-  // pass `--enable-sandbox` to the renderer so it won't have any node.js
-  // integration.
-  if (IsEnabled(options::kSandbox))
-    command_line->AppendSwitch(switches::kEnableSandbox);
-  else if (!command_line->HasSwitch(switches::kEnableSandbox))
-    command_line->AppendSwitch(service_manager::switches::kNoSandbox);
+  command_line->AppendSwitchASCII(
+      switches::kWebviewTag,
+      parsed->Has(Flag::kWebviewTag) ? "true" : "false");
 
   // Check if nativeWindowOpen is enabled.
-  if (IsEnabled(options::kNativeWindowOpen))
+  if (parsed->Has(Flag::kNativeWindowOpen))
     command_line->AppendSwitch(switches::kNativeWindowOpen);
 
   // The preload script.
@@ -272,28 +338,29 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   }
 
   // Whether to enable the remote module
-  if (!IsRemoteModuleEnabled())
+  if (!parsed->Has(Flag::kRemoteModule))
     command_line->AppendSwitch(switches::kDisableRemoteModule);
 
   // Run Electron APIs and preload script in isolated world
-  if (IsEnabled(options::kContextIsolation))
+  if (parsed->Has(Flag::kContextIsolation))
     command_line->AppendSwitch(switches::kContextIsolation);
 
   // --background-color.
   std::string s;
   if (GetAsString(&preference_, options::kBackgroundColor, &s)) {
     command_line->AppendSwitchASCII(switches::kBackgroundColor, s);
-  } else if (!IsEnabled(options::kOffscreen)) {
+  } else if (!parsed->Has(Flag::kOffscreen)) {
     // For non-OSR WebContents, we expect to have white background, see
     // https://github.com/electron/electron/issues/13764 for more.
     command_line->AppendSwitchASCII(switches::kBackgroundColor, "#fff");
   }
 
   // --guest-instance-id, which is used to identify guest WebContents.
-  int guest_instance_id = 0;
-  if (GetAsInteger(&preference_, options::kGuestInstanceID, &guest_instance_id))
-    command_line->AppendSwitchASCII(switches::kGuestInstanceID,
-                                    base::IntToString(guest_instance_id));
+  if (GetAsInteger(&preference_, options::kGuestInstanceID,
+                   &parsed->guest_instance_id))
+    command_line->AppendSwitchASCII(
+        switches::kGuestInstanceID,
+        base::IntToString(parsed->guest_instance_id));
 
   // Pass the opener's window id.
   int opener_id;
@@ -301,9 +368,14 @@ void WebContentsPreferences::AppendCommandLineSwitches(
     command_line->AppendSwitchASCII(switches::kOpenerID,
                                     base::IntToString(opener_id));
 
+  // --gpu-preference, the default powerPreference of WebGL contexts.
+  if (GetAsString(&preference_, options::kGpuPreference, &s) &&
+      (s == "low-power" || s == "high-performance"))
+    command_line->AppendSwitchASCII(switches::kGpuPreference, s);
+
 #if defined(OS_MACOSX)
   // Enable scroll bounce.
-  if (IsEnabled(options::kScrollBounce))
+  if (parsed->Has(Flag::kScrollBounce))
     command_line->AppendSwitch(switches::kScrollBounce);
 #endif
 
@@ -328,12 +400,89 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   if (GetAsString(&preference_, options::kDisableBlinkFeatures, &s))
     command_line->AppendSwitchASCII(::switches::kDisableBlinkFeatures, s);
 
-  if (guest_instance_id) {
+  auto* fonts_dict = preference_.FindKeyOfType("defaultFontFamily",
+                                               base::Value::Type::DICTIONARY);
+  if (fonts_dict) {
+    const struct {
+      const char* name;
+      content::ScriptFontFamilyMap content::WebPreferences::*map;
+    } kFontFamilies[] = {
+        {"standard", &content::WebPreferences::standard_font_family_map},
+        {"serif", &content::WebPreferences::serif_font_family_map},
+        {"sansSerif", &content::WebPreferences::sans_serif_font_family_map},
+        {"monospace", &content::WebPreferences::fixed_font_family_map},
+        {"cursive", &content::WebPreferences::cursive_font_family_map},
+        {"fantasy", &content::WebPreferences::fantasy_font_family_map},
+    };
+    for (const auto& family : kFontFamilies) {
+      base::string16 font;
+      if (GetAsString(fonts_dict, family.name, &font))
+        parsed->font_families.emplace_back(family.map, font);
+    }
+  }
+
+  int size;
+  if (GetAsInteger(&preference_, "defaultFontSize", &size))
+    parsed->default_font_size = size;
+  if (GetAsInteger(&preference_, "defaultMonospaceFontSize", &size))
+    parsed->default_fixed_font_size = size;
+  if (GetAsInteger(&preference_, "minimumFontSize", &size))
+    parsed->minimum_font_size = size;
+  std::string encoding;
+  if (GetAsString(&preference_, "defaultEncoding", &encoding))
+    parsed->default_encoding = encoding;
+
+  return parsed;
+}
+
+const WebContentsPreferences::Parsed& WebContentsPreferences::GetParsed()
+    const {
+  if (!parsed_)
+    parsed_ = Parse();
+  return *parsed_;
+}
+
+// static
+bool WebContentsPreferences::GetProcessSwitches(
+    content::WebContents* web_contents,
+    base::CommandLine* switches) {
+  auto* web_preferences = From(web_contents);
+  if (!web_preferences)
+    return false;
+
+  static const char* const kSandboxSwitch[] = {switches::kEnableSandbox};
+  switches->CopySwitchesFrom(*base::CommandLine::ForCurrentProcess(),
+                             kSandboxSwitch, arraysize(kSandboxSwitch));
+  web_preferences->AppendCommandLineSwitches(switches);
+  SessionPreferences::AppendExtraCommandLineSwitches(
+      web_contents->GetBrowserContext(), switches);
+
+  return !switches->HasSwitch(switches::kGuestInstanceID) &&
+         !switches->HasSwitch(switches::kOpenerID);
+}
+
+void WebContentsPreferences::AppendCommandLineSwitches(
+    base::CommandLine* command_line) {
+  const Parsed& parsed = GetParsed();
+  for (const auto& pair : parsed.switches.GetSwitches())
+    command_line->AppendSwitchNative(pair.first, pair.second);
+  for (const auto& arg : parsed.switches.GetArgs())
+    command_line->AppendArgNative(arg);
+
+  // If the `sandbox` option was passed to the BrowserWindow's webPreferences,
+  // pass `--enable-sandbox` to the renderer so it won't have any node.js
+  // integration.
+  if (parsed.Has(Flag::kSandbox))
+    command_line->AppendSwitch(switches::kEnableSandbox);
+  else if (!command_line->HasSwitch(switches::kEnableSandbox))
+    command_line->AppendSwitch(service_manager::switches::kNoSandbox);
+
+  if (parsed.guest_instance_id) {
     // Webview `document.visibilityState` tracks window visibility so we need
     // to let it know if the window happens to be hidden right now.
     auto* manager = WebViewManager::GetWebViewManager(web_contents_);
     if (manager) {
-      auto* embedder = manager->GetEmbedder(guest_instance_id);
+      auto* embedder = manager->GetEmbedder(parsed.guest_instance_id);
       if (embedder) {
         auto* relay = NativeWindowRelay::FromWebContents(embedder);
         if (relay) {
@@ -352,59 +501,40 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   // We are appending args to a webContents so let's save the current state
   // of our preferences object so that during the lifetime of the WebContents
   // we can fetch the options used to initally configure the WebContents
-  last_preference_ = preference_.Clone();
+  if (last_preference_needs_update_) {
+    last_preference_ = preference_.Clone();
+    last_preference_needs_update_ = false;
+  }
 }
 
 void WebContentsPreferences::OverrideWebkitPrefs(
     content::WebPreferences* prefs) {
-  prefs->javascript_enabled = IsEnabled("javascript", true /* default_value */);
-  prefs->images_enabled = IsEnabled("images", true /* default_value */);
-  prefs->text_areas_are_resizable =
-      IsEnabled("textAreasAreResizable", true /* default_value */);
-  prefs->navigate_on_drag_drop =
-      IsEnabled("navigateOnDragDrop", false /* default_value */);
+  const Parsed& parsed = GetParsed();
+  prefs->javascript_enabled = parsed.Has(Flag::kJavascript);
+  prefs->images_enabled = parsed.Has(Flag::kImages);
+  prefs->text_areas_are_resizable = parsed.Has(Flag::kTextAreasAreResizable);
+  prefs->navigate_on_drag_drop = parsed.Has(Flag::kNavigateOnDragDrop);
 
   // Check if webgl should be enabled.
-  bool is_webgl_enabled = IsEnabled("webgl", true /* default_value */);
-  prefs->webgl1_enabled = is_webgl_enabled;
-  prefs->webgl2_enabled = is_webgl_enabled;
+  prefs->webgl1_enabled = parsed.Has(Flag::kWebGL);
+  prefs->webgl2_enabled = parsed.Has(Flag::kWebGL);
 
   // Check if web security should be enabled.
-  bool is_web_security_enabled =
-      IsEnabled(options::kWebSecurity, true /* default_value */);
-  prefs->web_security_enabled = is_web_security_enabled;
+  prefs->web_security_enabled = parsed.Has(Flag::kWebSecurity);
   prefs->allow_running_insecure_content =
-      IsEnabled(options::kAllowRunningInsecureContent,
-                !is_web_security_enabled /* default_value */);
-
-  auto* fonts_dict = preference_.FindKeyOfType("defaultFontFamily",
-                                               base::Value::Type::DICTIONARY);
-  if (fonts_dict) {
-    base::string16 font;
-    if (GetAsString(fonts_dict, "standard", &font))
-      prefs->standard_font_family_map[content::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "serif", &font))
-      prefs->serif_font_family_map[content::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "sansSerif", &font))
-      prefs->sans_serif_font_family_map[content::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "monospace", &font))
-      prefs->fixed_font_family_map[content::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "cursive", &font))
-      prefs->cursive_font_family_map[content::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "fantasy", &font))
-      prefs->fantasy_font_family_map[content::kCommonScript] = font;
-  }
-
-  int size;
-  if (GetAsInteger(&preference_, "defaultFontSize", &size))
-    prefs->default_font_size = size;
-  if (GetAsInteger(&preference_, "defaultMonospaceFontSize", &size))
-    prefs->default_fixed_font_size = size;
-  if (GetAsInteger(&preference_, "minimumFontSize", &size))
-    prefs->minimum_font_size = size;
-  std::string encoding;
-  if (GetAsString(&preference_, "defaultEncoding", &encoding))
-    prefs->default_encoding = encoding;
+      parsed.Has(Flag::kAllowRunningInsecureContent);
+
+  for (const auto& family : parsed.font_families)
+    (prefs->*family.first)[content::kCommonScript] = family.second;
+
+  if (parsed.default_font_size)
+    prefs->default_font_size = *parsed.default_font_size;
+  if (parsed.default_fixed_font_size)
+    prefs->default_fixed_font_size = *parsed.default_fixed_font_size;
+  if (parsed.minimum_font_size)
+    prefs->minimum_font_size = *parsed.minimum_font_size;
+  if (parsed.default_encoding)
+    prefs->default_encoding = *parsed.default_encoding;
 }
 
 }  // namespace atom
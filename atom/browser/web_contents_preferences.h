@@ -5,6 +5,7 @@
 #ifndef ATOM_BROWSER_WEB_CONTENTS_PREFERENCES_H_
 #define ATOM_BROWSER_WEB_CONTENTS_PREFERENCES_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -32,13 +33,45 @@ class WebContentsPreferences
   // Get self from WebContents.
   static WebContentsPreferences* From(content::WebContents* web_contents);
 
+  // Gets the switches that AtomBrowserClient gives to the render process of
+  // |web_contents|, processes launched with the same switches can be shared.
+  // Returns false for guests and child windows, which are tied to the process
+  // of their embedder or opener.
+  static bool GetProcessSwitches(content::WebContents* web_contents,
+                                 base::CommandLine* switches);
+
   WebContentsPreferences(content::WebContents* web_contents,
                          const mate::Dictionary& web_preferences);
   ~WebContentsPreferences() override;
 
+  // The Boolean preferences that are read by navigations and process
+  // launches, they are parsed once instead of looked up every time.
+  enum class Flag : uint32_t {
+    kPlugins = 1 << 0,
+    kExperimentalFeatures = 1 << 1,
+    kNodeIntegration = 1 << 2,
+    kNodeIntegrationInWorker = 1 << 3,
+    kWebviewTag = 1 << 4,
+    kSandbox = 1 << 5,
+    kNativeWindowOpen = 1 << 6,
+    kContextIsolation = 1 << 7,
+    kRemoteModule = 1 << 8,
+    kOffscreen = 1 << 9,
+    kScrollBounce = 1 << 10,
+    kDisablePopups = 1 << 11,
+    kJavascript = 1 << 12,
+    kImages = 1 << 13,
+    kTextAreasAreResizable = 1 << 14,
+    kNavigateOnDragDrop = 1 << 15,
+    kWebGL = 1 << 16,
+    kWebSecurity = 1 << 17,
+    kAllowRunningInsecureContent = 1 << 18,
+  };
+
   // A simple way to know whether a Boolean property is enabled.
   bool IsEnabled(const base::StringPiece& name,
                  bool default_value = false) const;
+  bool IsEnabled(Flag flag) const;
 
   // $.extend(|web_preferences|, |new_web_preferences|).
   void Merge(const base::DictionaryValue& new_web_preferences);
@@ -55,6 +88,9 @@ class WebContentsPreferences
   // Return true if the particular preference value exists.
   bool GetPreference(const base::StringPiece& name, std::string* value) const;
 
+  // Set the value of a preference.
+  void SetPreference(const base::StringPiece& name, base::Value value);
+
   // Whether to enable the remote module
   bool IsRemoteModuleEnabled() const;
 
@@ -62,8 +98,8 @@ class WebContentsPreferences
   bool GetPreloadPath(base::FilePath::StringType* path) const;
 
   // Returns the web preferences.
-  base::Value* preference() { return &preference_; }
-  base::Value* last_preference() { return &last_preference_; }
+  const base::Value* preference() const { return &preference_; }
+  const base::Value* last_preference() const { return &last_preference_; }
 
  private:
   friend class content::WebContentsUserData<WebContentsPreferences>;
@@ -72,15 +108,28 @@ class WebContentsPreferences
   // Get WebContents according to process ID.
   static content::WebContents* GetWebContentsFromProcessID(int process_id);
 
+  struct Parsed;
+
   // Set preference value to given bool if user did not provide value
   bool SetDefaultBoolIfUndefined(const base::StringPiece& key, bool val);
 
+  // Returns the |preference_| parsed, which is only done again after they
+  // have been changed.
+  const Parsed& GetParsed() const;
+  std::unique_ptr<Parsed> Parse() const;
+
+  // Called after |preference_| has been changed.
+  void OnPreferenceChanged();
+
   static std::vector<WebContentsPreferences*> instances_;
 
   content::WebContents* web_contents_;
 
   base::Value preference_ = base::Value(base::Value::Type::DICTIONARY);
   base::Value last_preference_ = base::Value(base::Value::Type::DICTIONARY);
+  bool last_preference_needs_update_ = false;
+
+  mutable std::unique_ptr<Parsed> parsed_;
 
   DISALLOW_COPY_AND_ASSIGN(WebContentsPreferences);
 };
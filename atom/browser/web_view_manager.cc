@@ -19,26 +19,42 @@ void WebViewManager::AddGuest(int guest_instance_id,
                               int element_instance_id,
                               content::WebContents* embedder,
                               content::WebContents* web_contents) {
+  // A guest that is attached again forgets its old element.
+  RemoveGuest(guest_instance_id);
+
   web_contents_embedder_map_[guest_instance_id] = {web_contents, embedder};
+  embedder_guests_map_[embedder].insert(guest_instance_id);
 
   // Map the element in embedder to guest.
   int owner_process_id = embedder->GetMainFrame()->GetProcess()->GetID();
   ElementInstanceKey key(owner_process_id, element_instance_id);
   element_instance_id_to_guest_map_[key] = guest_instance_id;
+  guest_to_element_instance_id_map_.emplace(guest_instance_id, key);
 }
 
 void WebViewManager::RemoveGuest(int guest_instance_id) {
-  if (!base::ContainsKey(web_contents_embedder_map_, guest_instance_id))
+  auto it = web_contents_embedder_map_.find(guest_instance_id);
+  if (it == web_contents_embedder_map_.end())
     return;
 
-  web_contents_embedder_map_.erase(guest_instance_id);
+  auto guests = embedder_guests_map_.find(it->second.embedder);
+  if (guests != embedder_guests_map_.end()) {
+    guests->second.erase(guest_instance_id);
+    if (guests->second.empty())
+      embedder_guests_map_.erase(guests);
+  }
+  web_contents_embedder_map_.erase(it);
 
   // Remove the record of element in embedder too.
-  for (const auto& element : element_instance_id_to_guest_map_)
-    if (element.second == guest_instance_id) {
-      element_instance_id_to_guest_map_.erase(element.first);
-      break;
-    }
+  auto element = guest_to_element_instance_id_map_.find(guest_instance_id);
+  if (element != guest_to_element_instance_id_map_.end()) {
+    auto guest = element_instance_id_to_guest_map_.find(element->second);
+    // The element may have been mapped to a newer guest since.
+    if (guest != element_instance_id_to_guest_map_.end() &&
+        guest->second == guest_instance_id)
+      element_instance_id_to_guest_map_.erase(guest);
+    guest_to_element_instance_id_map_.erase(element);
+  }
 }
 
 content::WebContents* WebViewManager::GetEmbedder(int guest_instance_id) {
@@ -64,10 +80,17 @@ content::WebContents* WebViewManager::GetGuestByInstanceID(
 
 bool WebViewManager::ForEachGuest(content::WebContents* embedder_web_contents,
                                   const GuestCallback& callback) {
-  for (auto& item : web_contents_embedder_map_)
-    if (item.second.embedder == embedder_web_contents &&
-        callback.Run(item.second.web_contents))
+  auto guests = embedder_guests_map_.find(embedder_web_contents);
+  if (guests == embedder_guests_map_.end())
+    return false;
+  // The callback may remove guests, so visit a copy of their ids.
+  std::set<int> guest_instance_ids = guests->second;
+  for (int guest_instance_id : guest_instance_ids) {
+    auto it = web_contents_embedder_map_.find(guest_instance_id);
+    if (it != web_contents_embedder_map_.end() &&
+        callback.Run(it->second.web_contents))
       return true;
+  }
   return false;
 }
 
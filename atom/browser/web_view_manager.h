@@ -6,6 +6,7 @@
 #define ATOM_BROWSER_WEB_VIEW_MANAGER_H_
 
 #include <map>
+#include <set>
 
 #include "content/public/browser/browser_plugin_guest_manager.h"
 
@@ -61,6 +62,11 @@ class WebViewManager : public content::BrowserPluginGuestManager {
   };
   // (embedder_process_id, element_instance_id) => guest_instance_id
   std::map<ElementInstanceKey, int> element_instance_id_to_guest_map_;
+  // guest_instance_id => (embedder_process_id, element_instance_id)
+  std::map<int, ElementInstanceKey> guest_to_element_instance_id_map_;
+  // embedder => guest_instance_ids, so the guests of an embedder are visited
+  // without going through the guests of all embedders.
+  std::map<content::WebContents*, std::set<int>> embedder_guests_map_;
 
   DISALLOW_COPY_AND_ASSIGN(WebViewManager);
 };
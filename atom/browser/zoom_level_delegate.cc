@@ -4,8 +4,10 @@
 
 #include "atom/browser/zoom_level_delegate.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "base/bind.h"
@@ -30,6 +32,40 @@ const char kPartitionDefaultZoomLevel[] = "partition.default_zoom_level";
 // be displayed at the default zoom level.
 const char kPartitionPerHostZoomLevels[] = "partition.per_host_zoom_levels";
 
+// Keys of the per-host entries, older versions stored the bare zoom level.
+const char kZoomLevelKey[] = "zoom_level";
+const char kLastModifiedKey[] = "last_modified";
+
+// Changes are gathered for this long before they are written.
+constexpr base::TimeDelta kWriteDelay = base::TimeDelta::FromSeconds(5);
+
+// The number of hosts whose zoom levels are kept in the prefs.
+const size_t kMaxHostZoomLevels = 5000;
+
+bool ParseHostZoomLevel(const base::Value& value,
+                        double* level,
+                        base::Time* last_modified) {
+  if (value.is_double() || value.is_int()) {
+    *level = value.GetDouble();
+    *last_modified = base::Time();
+    return true;
+  }
+  if (!value.is_dict())
+    return false;
+  const base::Value* zoom_level = value.FindKey(kZoomLevelKey);
+  if (!zoom_level || !(zoom_level->is_double() || zoom_level->is_int()))
+    return false;
+  *level = zoom_level->GetDouble();
+  int64_t internal_value = 0;
+  const base::Value* modified =
+      value.FindKeyOfType(kLastModifiedKey, base::Value::Type::STRING);
+  if (modified && base::StringToInt64(modified->GetString(), &internal_value))
+    *last_modified = base::Time::FromInternalValue(internal_value);
+  else
+    *last_modified = base::Time();
+  return true;
+}
+
 std::string GetHash(const base::FilePath& partition_path) {
   size_t int_key = std::hash<base::FilePath>()(partition_path);
   return base::NumberToString(int_key);
@@ -50,7 +86,11 @@ ZoomLevelDelegate::ZoomLevelDelegate(PrefService* pref_service,
   partition_key_ = GetHash(partition_path);
 }
 
-ZoomLevelDelegate::~ZoomLevelDelegate() {}
+ZoomLevelDelegate::~ZoomLevelDelegate() {
+  // The prefs outlive the storage partitions that own us.
+  if (!dirty_hosts_.empty())
+    WritePendingChanges();
+}
 
 void ZoomLevelDelegate::SetDefaultZoomLevelPref(double level) {
   if (content::ZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel()))
@@ -78,37 +118,34 @@ void ZoomLevelDelegate::OnZoomLevelChanged(
     return;
 
   double level = change.zoom_level;
-  DictionaryPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
-  base::DictionaryValue* host_zoom_dictionaries = update.Get();
-  DCHECK(host_zoom_dictionaries);
-
   bool modification_is_removal =
       content::ZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel());
 
-  base::DictionaryValue* host_zoom_dictionary = nullptr;
-  if (!host_zoom_dictionaries->GetDictionary(partition_key_,
-                                             &host_zoom_dictionary)) {
-    host_zoom_dictionary = host_zoom_dictionaries->SetDictionary(
-        partition_key_, std::make_unique<base::DictionaryValue>());
+  if (modification_is_removal) {
+    if (host_zoom_levels_.erase(change.host))
+      SetHostDirty(change.host);
+    return;
   }
 
-  if (modification_is_removal)
-    host_zoom_dictionary->RemoveWithoutPathExpansion(change.host, nullptr);
-  else
-    host_zoom_dictionary->SetKey(change.host, base::Value(level));
+  // Navigations set the level of every host they visit, most of the time to
+  // the level it already has.
+  auto it = host_zoom_levels_.find(change.host);
+  if (it != host_zoom_levels_.end() &&
+      content::ZoomValuesEqual(level, it->second.level))
+    return;
+  host_zoom_levels_[change.host] = {level, base::Time::Now()};
+  SetHostDirty(change.host);
 }
 
 void ZoomLevelDelegate::ExtractPerHostZoomLevels(
     const base::DictionaryValue* host_zoom_dictionary) {
-  std::vector<std::string> keys_to_remove;
-  std::unique_ptr<base::DictionaryValue> host_zoom_dictionary_copy =
-      host_zoom_dictionary->DeepCopyWithoutEmptyChildren();
-  for (base::DictionaryValue::Iterator i(*host_zoom_dictionary_copy);
-       !i.IsAtEnd(); i.Advance()) {
-    const std::string& host(i.key());
+  for (const auto& item : host_zoom_dictionary->DictItems()) {
+    const std::string& host = item.first;
     double zoom_level = 0;
+    base::Time last_modified;
 
-    bool has_valid_zoom_level = i.value().GetAsDouble(&zoom_level);
+    bool has_valid_zoom_level =
+        ParseHostZoomLevel(item.second, &zoom_level, &last_modified);
 
     // Filter out A) the empty host, B) zoom levels equal to the default; and
     // remember them, so that we can later erase them from Prefs.
@@ -119,24 +156,74 @@ void ZoomLevelDelegate::ExtractPerHostZoomLevels(
     if (host.empty() || !has_valid_zoom_level ||
         content::ZoomValuesEqual(zoom_level,
                                  host_zoom_map_->GetDefaultZoomLevel())) {
-      keys_to_remove.push_back(host);
+      dirty_hosts_.insert(host);
       continue;
     }
 
+    host_zoom_levels_[host] = {zoom_level, last_modified};
     host_zoom_map_->SetZoomLevelForHost(host, zoom_level);
   }
 
   // Sanitize prefs to remove entries that match the default zoom level and/or
-  // have an empty host.
-  {
-    DictionaryPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
-    base::DictionaryValue* host_zoom_dictionaries = update.Get();
-    base::DictionaryValue* sanitized_host_zoom_dictionary = nullptr;
-    host_zoom_dictionaries->GetDictionary(partition_key_,
-                                          &sanitized_host_zoom_dictionary);
-    for (const std::string& s : keys_to_remove)
-      sanitized_host_zoom_dictionary->RemoveWithoutPathExpansion(s, nullptr);
+  // have an empty host, and the hosts beyond the limit.
+  Compact();
+  if (!dirty_hosts_.empty())
+    WritePendingChanges();
+}
+
+void ZoomLevelDelegate::SetHostDirty(const std::string& host) {
+  dirty_hosts_.insert(host);
+  if (!write_timer_.IsRunning())
+    write_timer_.Start(FROM_HERE, kWriteDelay,
+                       base::Bind(&ZoomLevelDelegate::WritePendingChanges,
+                                  base::Unretained(this)));
+}
+
+void ZoomLevelDelegate::Compact() {
+  if (host_zoom_levels_.size() <= kMaxHostZoomLevels)
+    return;
+
+  std::vector<std::pair<base::Time, std::string>> hosts;
+  hosts.reserve(host_zoom_levels_.size());
+  for (const auto& it : host_zoom_levels_)
+    hosts.emplace_back(it.second.last_modified, it.first);
+  size_t excess = hosts.size() - kMaxHostZoomLevels;
+  std::nth_element(hosts.begin(), hosts.begin() + excess, hosts.end());
+  for (size_t i = 0; i < excess; ++i) {
+    host_zoom_levels_.erase(hosts[i].second);
+    dirty_hosts_.insert(hosts[i].second);
+  }
+}
+
+void ZoomLevelDelegate::WritePendingChanges() {
+  write_timer_.Stop();
+  Compact();
+
+  DictionaryPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
+  base::DictionaryValue* host_zoom_dictionaries = update.Get();
+  DCHECK(host_zoom_dictionaries);
+
+  base::DictionaryValue* host_zoom_dictionary = nullptr;
+  if (!host_zoom_dictionaries->GetDictionary(partition_key_,
+                                             &host_zoom_dictionary)) {
+    host_zoom_dictionary = host_zoom_dictionaries->SetDictionary(
+        partition_key_, std::make_unique<base::DictionaryValue>());
+  }
+
+  for (const std::string& host : dirty_hosts_) {
+    auto it = host_zoom_levels_.find(host);
+    if (it == host_zoom_levels_.end()) {
+      host_zoom_dictionary->RemoveWithoutPathExpansion(host, nullptr);
+      continue;
+    }
+    base::Value entry(base::Value::Type::DICTIONARY);
+    entry.SetKey(kZoomLevelKey, base::Value(it->second.level));
+    entry.SetKey(kLastModifiedKey,
+                 base::Value(base::Int64ToString(
+                     it->second.last_modified.ToInternalValue())));
+    host_zoom_dictionary->SetKey(host, std::move(entry));
   }
+  dirty_hosts_.clear();
 }
 
 void ZoomLevelDelegate::InitHostZoomMap(content::HostZoomMap* host_zoom_map) {
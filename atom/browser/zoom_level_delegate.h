@@ -5,11 +5,15 @@
 #ifndef ATOM_BROWSER_ZOOM_LEVEL_DELEGATE_H_
 #define ATOM_BROWSER_ZOOM_LEVEL_DELEGATE_H_
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/host_zoom_map.h"
 #include "content/public/browser/zoom_level_delegate.h"
@@ -28,6 +32,11 @@ namespace atom {
 // to the per-partition default zoom levels flow through this
 // class. Any changes to per-host levels are updated when HostZoomMap calls
 // OnZoomLevelChanged.
+//
+// The per-host levels are kept in memory and written to the prefs in batches,
+// so navigating through many hosts does not rewrite the prefs for each one.
+// The least recently modified hosts are dropped from the prefs once there
+// are too many of them.
 class ZoomLevelDelegate : public content::ZoomLevelDelegate {
  public:
   static void RegisterPrefs(PrefRegistrySimple* pref_registry);
@@ -43,9 +52,23 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   void InitHostZoomMap(content::HostZoomMap* host_zoom_map) override;
 
  private:
+  struct HostZoomLevel {
+    double level;
+    base::Time last_modified;
+  };
+
   void ExtractPerHostZoomLevels(
       const base::DictionaryValue* host_zoom_dictionary);
 
+  // Marks |host| as changed and schedules a write.
+  void SetHostDirty(const std::string& host);
+
+  // Drops the least recently modified hosts beyond the limit.
+  void Compact();
+
+  // Writes the changed hosts to the prefs in a single update.
+  void WritePendingChanges();
+
   // This is a callback function that receives notifications from HostZoomMap
   // when per-host zoom levels change. It is used to update the per-host
   // zoom levels (if any) managed by this class (for its associated partition).
@@ -56,6 +79,12 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   std::unique_ptr<content::HostZoomMap::Subscription> zoom_subscription_;
   std::string partition_key_;
 
+  // The per-host zoom levels as they are persisted, and the hosts whose
+  // levels have not been written yet.
+  std::map<std::string, HostZoomLevel> host_zoom_levels_;
+  std::set<std::string> dirty_hosts_;
+  base::OneShotTimer write_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(ZoomLevelDelegate);
 };
 
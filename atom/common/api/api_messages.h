@@ -5,11 +5,15 @@
 // Multiply-included file, no traditional include guard.
 
 #include "atom/common/draggable_region.h"
+#include "base/files/file_path.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/unsafe_shared_memory_region.h"
 #include "base/strings/string16.h"
 #include "base/values.h"
 #include "content/public/common/common_param_traits.h"
 #include "content/public/common/referrer.h"
 #include "ipc/ipc_message_macros.h"
+#include "ipc/ipc_mojo_param_traits.h"
 #include "ipc/ipc_platform_file.h"
 #include "ui/gfx/geometry/rect_f.h"
 #include "ui/gfx/ipc/gfx_param_traits.h"
@@ -48,6 +52,62 @@ IPC_MESSAGE_ROUTED5(AtomFrameMsg_Message,
                     base::ListValue /* arguments */,
                     int32_t /* sender_id */)
 
+// Same with AtomFrameHostMsg_Message and AtomFrameMsg_Message, but the
+// arguments are written by v8::ValueSerializer instead of being converted to
+// base::ListValue. Large transferred ArrayBuffers are carried in shared memory.
+IPC_MESSAGE_ROUTED3(AtomFrameHostMsg_Message_Serialized,
+                    std::string /* channel */,
+                    std::vector<uint8_t> /* arguments */,
+                    std::vector<base::UnsafeSharedMemoryRegion> /* buffers */)
+
+IPC_MESSAGE_ROUTED6(AtomFrameMsg_Message_Serialized,
+                    bool /* internal */,
+                    bool /* send_to_all */,
+                    std::string /* channel */,
+                    std::vector<uint8_t> /* arguments */,
+                    std::vector<base::UnsafeSharedMemoryRegion> /* buffers */,
+                    int32_t /* sender_id */)
+
+// Sent by the renderer to call a handler registered with ipcMain.handle, the
+// browser answers asynchronously with AtomFrameMsg_InvokeReply.
+IPC_MESSAGE_ROUTED3(AtomFrameHostMsg_Invoke,
+                    int /* request_id */,
+                    std::string /* channel */,
+                    base::ListValue /* arguments */)
+
+IPC_MESSAGE_ROUTED3(AtomFrameMsg_InvokeReply,
+                    int /* request_id */,
+                    bool /* success */,
+                    base::ListValue /* result */)
+
+// Asks the browser to connect the frame with the main frame of another
+// webContents through a message pipe, each end is sent to a frame with
+// AtomFrameMsg_Port. The |request_id| is 0 in the frame that did not open it,
+// and the handle is invalid when the webContents does not exist.
+IPC_MESSAGE_ROUTED3(AtomFrameHostMsg_OpenPort,
+                    int /* request_id */,
+                    int32_t /* web_contents_id */,
+                    std::string /* channel */)
+
+IPC_MESSAGE_ROUTED4(AtomFrameMsg_Port,
+                    int /* request_id */,
+                    std::string /* channel */,
+                    int32_t /* sender_id */,
+                    mojo::MessagePipeHandle /* port */)
+
+// Shares a ring buffer created by webContents.createSharedRing with the main
+// frame, the messages written to it are only announced by
+// AtomFrameMsg_SharedRingDoorbell when the renderer waits for them.
+IPC_MESSAGE_ROUTED3(AtomFrameMsg_SharedRing,
+                    std::string /* channel */,
+                    int32_t /* ring_id */,
+                    base::UnsafeSharedMemoryRegion /* region */)
+
+IPC_MESSAGE_ROUTED1(AtomFrameMsg_SharedRingDoorbell, int32_t /* ring_id */)
+
+// Tells the renderer that a ring was closed in the main process.
+IPC_MESSAGE_ROUTED1(AtomFrameMsg_SharedRingClose, int32_t /* ring_id */)
+
 IPC_MESSAGE_ROUTED0(AtomViewMsg_Offscreen)
 
 IPC_MESSAGE_ROUTED3(AtomAutofillFrameHostMsg_ShowPopup,
@@ -64,8 +124,43 @@ IPC_MESSAGE_ROUTED1(AtomAutofillFrameMsg_AcceptSuggestion,
 IPC_MESSAGE_ROUTED1(AtomFrameHostMsg_UpdateDraggableRegions,
                     std::vector<atom::DraggableRegion> /* regions */)
 
-// Update renderer process preferences.
-IPC_MESSAGE_CONTROL1(AtomMsg_UpdatePreferences, base::ListValue)
+// Update renderer process preferences, the full set of entries is only sent
+// to new processes, the others get the changes to it.
+IPC_MESSAGE_CONTROL3(AtomMsg_UpdatePreferences,
+                     uint64_t /* version */,
+                     std::vector<int> /* ids */,
+                     base::ListValue /* entries */)
+IPC_MESSAGE_CONTROL3(AtomMsg_SetPreference,
+                     uint64_t /* version */,
+                     int /* id */,
+                     base::DictionaryValue /* entry */)
+IPC_MESSAGE_CONTROL2(AtomMsg_RemovePreference,
+                     uint64_t /* version */,
+                     int /* id */)
+
+// Asks a renderer for the memory of its V8 heap and of Blink's memory cache,
+// which it sends back in kilobytes.
+IPC_MESSAGE_CONTROL1(AtomMsg_RequestMemoryStats, int /* request id */)
+IPC_MESSAGE_CONTROL2(AtomHostMsg_MemoryStats,
+                     int /* request id */,
+                     base::DictionaryValue /* stats */)
+
+// Asks for the index of an asar archive already parsed by the browser, the
+// region is invalid when the browser has not parsed this version of it.
+IPC_SYNC_MESSAGE_CONTROL3_2(AtomHostMsg_GetSharedAsarIndex,
+                            base::FilePath /* archive path */,
+                            int64_t /* size */,
+                            int64_t /* last modified */,
+                            uint32_t /* header size */,
+                            base::ReadOnlySharedMemoryRegion /* index */)
+
+// Adds a stylesheet of the session to every new document, the text is shared
+// by all the processes of the session.
+IPC_MESSAGE_CONTROL3(AtomMsg_AddUserStyleSheet,
+                     int /* id */,
+                     base::ReadOnlySharedMemoryRegion /* css */,
+                     bool /* main frame only */)
+IPC_MESSAGE_CONTROL1(AtomMsg_RemoveUserStyleSheet, int /* id */)
 
 // Sent by renderer to set the temporary zoom level.
 IPC_SYNC_MESSAGE_ROUTED1_1(AtomFrameHostMsg_SetTemporaryZoomLevel,
@@ -83,3 +178,17 @@ IPC_MESSAGE_ROUTED2(AtomFrameHostMsg_PDFSaveURLAs,
 IPC_MESSAGE_ROUTED2(AtomFrameMsg_TakeHeapSnapshot,
                     IPC::PlatformFileForTransit /* file_handle */,
                     std::string /* channel */)
+
+IPC_MESSAGE_ROUTED2(AtomFrameMsg_StartHeapSampling,
+                    int /* sample_interval */,
+                    int /* stack_depth */)
+
+IPC_MESSAGE_ROUTED2(AtomFrameMsg_StopHeapSampling,
+                    IPC::PlatformFileForTransit /* file_handle */,
+                    std::string /* channel */)
+
+// Asks the renderer to release as much memory as it can, the memory stats
+// before and after are sent back on |channel|.
+IPC_MESSAGE_ROUTED2(AtomFrameMsg_PurgeMemory,
+                    bool /* critical */,
+                    std::string /* channel */)
@@ -4,11 +4,24 @@
 
 #include <stddef.h>
 
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "atom/common/api/locker.h"
 #include "atom/common/asar/archive.h"
+#include "atom/common/asar/asar_util.h"
+#include "atom/common/asar/readahead.h"
+#include "atom/common/internal_modules.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/node_worker_isolate.h"
+#include "base/files/file_util.h"
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_restrictions.h"
 #include "native_mate/arguments.h"
 #include "native_mate/dictionary.h"
 #include "native_mate/object_template_builder.h"
@@ -19,12 +32,142 @@
 
 namespace {
 
+// Keeps the archive, and thus its mapping, alive while the buffer is in use.
+void ReleaseArchive(char* data, void* hint) {
+  delete static_cast<std::shared_ptr<asar::Archive>*>(hint);
+}
+
+v8::Local<v8::Value> StatsToV8(v8::Isolate* isolate,
+                               const asar::Archive::Stats& stats) {
+  mate::Dictionary dict(isolate, v8::Object::New(isolate));
+  dict.Set("size", stats.compressed ? stats.uncompressed_size : stats.size);
+  dict.Set("offset", stats.offset);
+  dict.Set("isFile", stats.is_file);
+  dict.Set("isDirectory", stats.is_directory);
+  dict.Set("isLink", stats.is_link);
+  return dict.GetHandle();
+}
+
+// Runs a lookup of the async fs functions on the thread pool of libuv, so the
+// event loop is not blocked by large directories or files of the archive. The
+// callback gets the same result as the sync method of the lookup.
+class AsyncLookup {
+ public:
+  enum class Type { STAT, READDIR, REALPATH, READ };
+
+  static void Start(v8::Isolate* isolate,
+                    std::shared_ptr<asar::Archive> archive,
+                    Type type,
+                    const base::FilePath& path,
+                    v8::Local<v8::Function> callback) {
+    auto* lookup =
+        new AsyncLookup(isolate, std::move(archive), type, path, callback);
+    uv_queue_work(node::Environment::GetCurrent(isolate)->event_loop(),
+                  &lookup->request_, &AsyncLookup::Run, &AsyncLookup::Done);
+  }
+
+ private:
+  AsyncLookup(v8::Isolate* isolate,
+              std::shared_ptr<asar::Archive> archive,
+              Type type,
+              const base::FilePath& path,
+              v8::Local<v8::Function> callback)
+      : isolate_(isolate),
+        context_(isolate, isolate->GetCurrentContext()),
+        callback_(isolate, callback),
+        archive_(std::move(archive)),
+        type_(type),
+        path_(path) {
+    request_.data = this;
+  }
+
+  // Called on a thread of the pool.
+  static void Run(uv_work_t* request) {
+    auto* self = static_cast<AsyncLookup*>(request->data);
+    if (!self->archive_)
+      return;
+    switch (self->type_) {
+      case Type::STAT:
+        self->found_ = self->archive_->Stat(self->path_, &self->stats_);
+        break;
+      case Type::READDIR:
+        self->found_ = self->archive_->Readdir(self->path_, &self->files_);
+        break;
+      case Type::REALPATH:
+        self->found_ = self->archive_->Realpath(self->path_, &self->realpath_);
+        break;
+      case Type::READ: {
+        asar::Archive::FileInfo info;
+        self->found_ = self->archive_->GetFileInfo(self->path_, &info) &&
+                       !info.unpacked;
+        self->valid_ =
+            self->found_ && self->archive_->ReadFile(info, &self->contents_);
+        break;
+      }
+    }
+  }
+
+  // Called on the thread of the event loop.
+  static void Done(uv_work_t* request, int status) {
+    std::unique_ptr<AsyncLookup> self(static_cast<AsyncLookup*>(request->data));
+    v8::Isolate* isolate = self->isolate_;
+    mate::Locker locker(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = self->context_.Get(isolate);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::Value> result = v8::False(isolate);
+    if (status == 0 && self->found_) {
+      switch (self->type_) {
+        case Type::STAT:
+          result = StatsToV8(isolate, self->stats_);
+          break;
+        case Type::READDIR:
+          result = mate::ConvertToV8(isolate, self->files_);
+          break;
+        case Type::REALPATH:
+          result = mate::ConvertToV8(isolate, self->realpath_);
+          break;
+        case Type::READ:
+          if (self->valid_)
+            result = node::Buffer::Copy(isolate, self->contents_.data(),
+                                        self->contents_.size())
+                         .ToLocalChecked();
+          else
+            result = v8::Undefined(isolate);
+          break;
+      }
+    }
+    node::MakeCallback(isolate, context->Global(),
+                       self->callback_.Get(isolate), 1, &result, {0, 0});
+  }
+
+  uv_work_t request_;
+  v8::Isolate* isolate_;
+  v8::Global<v8::Context> context_;
+  v8::Global<v8::Function> callback_;
+  std::shared_ptr<asar::Archive> archive_;
+  Type type_;
+  base::FilePath path_;
+
+  bool found_ = false;
+  asar::Archive::Stats stats_;
+  std::vector<base::FilePath> files_;
+  base::FilePath realpath_;
+  // Whether the content passed the integrity check.
+  bool valid_ = false;
+  std::string contents_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncLookup);
+};
+
 class Archive : public mate::Wrappable<Archive> {
  public:
   static v8::Local<v8::Value> Create(v8::Isolate* isolate,
                                      const base::FilePath& path) {
-    auto archive = std::make_unique<asar::Archive>(path);
-    if (!archive->Init())
+    std::shared_ptr<asar::Archive> archive =
+        asar::GetOrCreateAsarArchive(path);
+    if (!archive)
       return v8::False(isolate);
     return (new Archive(isolate, std::move(archive)))->GetWrapper();
   }
@@ -36,14 +179,23 @@ class Archive : public mate::Wrappable<Archive> {
         .SetProperty("path", &Archive::GetPath)
         .SetMethod("getFileInfo", &Archive::GetFileInfo)
         .SetMethod("stat", &Archive::Stat)
+        .SetMethod("statAsync", &Archive::StatAsync)
         .SetMethod("readdir", &Archive::Readdir)
+        .SetMethod("readdirAsync", &Archive::ReaddirAsync)
         .SetMethod("realpath", &Archive::Realpath)
+        .SetMethod("realpathAsync", &Archive::RealpathAsync)
         .SetMethod("copyFileOut", &Archive::CopyFileOut)
-        .SetMethod("getFd", &Archive::GetFD);
+        .SetMethod("readFileView", &Archive::ReadFileView)
+        .SetMethod("readFile", &Archive::ReadFile)
+        .SetMethod("readFileAsync", &Archive::ReadFileAsync)
+        .SetMethod("readFileSync", &Archive::ReadFileSync)
+        .SetMethod("resolveCandidates", &Archive::ResolveCandidates)
+        .SetMethod("getFd", &Archive::GetFD)
+        .SetMethod("getHeaderDigest", &Archive::GetHeaderDigest);
   }
 
  protected:
-  Archive(v8::Isolate* isolate, std::unique_ptr<asar::Archive> archive)
+  Archive(v8::Isolate* isolate, std::shared_ptr<asar::Archive> archive)
       : archive_(std::move(archive)) {
     Init(isolate);
   }
@@ -51,7 +203,8 @@ class Archive : public mate::Wrappable<Archive> {
   // Returns the path of the file.
   base::FilePath GetPath() { return archive_->path(); }
 
-  // Reads the offset and size of file.
+  // Reads the offset and size of file, unpacked files also get their real
+  // path so they can be read without calling copyFileOut.
   v8::Local<v8::Value> GetFileInfo(v8::Isolate* isolate,
                                    const base::FilePath& path) {
     asar::Archive::FileInfo info;
@@ -60,7 +213,13 @@ class Archive : public mate::Wrappable<Archive> {
     mate::Dictionary dict(isolate, v8::Object::New(isolate));
     dict.Set("size", info.size);
     dict.Set("unpacked", info.unpacked);
+    if (info.unpacked)
+      dict.Set("path", archive_->GetUnpackedPath(path));
     dict.Set("offset", info.offset);
+    if (info.compressed) {
+      dict.Set("compressed", true);
+      dict.Set("uncompressedSize", info.uncompressed_size);
+    }
     return dict.GetHandle();
   }
 
@@ -69,13 +228,14 @@ class Archive : public mate::Wrappable<Archive> {
     asar::Archive::Stats stats;
     if (!archive_ || !archive_->Stat(path, &stats))
       return v8::False(isolate);
-    mate::Dictionary dict(isolate, v8::Object::New(isolate));
-    dict.Set("size", stats.size);
-    dict.Set("offset", stats.offset);
-    dict.Set("isFile", stats.is_file);
-    dict.Set("isDirectory", stats.is_directory);
-    dict.Set("isLink", stats.is_link);
-    return dict.GetHandle();
+    return StatsToV8(isolate, stats);
+  }
+
+  // Same with Stat, but the lookup runs on the thread pool.
+  void StatAsync(v8::Isolate* isolate,
+                 const base::FilePath& path,
+                 v8::Local<v8::Function> callback) {
+    StartLookup(isolate, AsyncLookup::Type::STAT, path, callback);
   }
 
   // Returns all files under a directory.
@@ -87,6 +247,13 @@ class Archive : public mate::Wrappable<Archive> {
     return mate::ConvertToV8(isolate, files);
   }
 
+  // Same with Readdir, but the lookup runs on the thread pool.
+  void ReaddirAsync(v8::Isolate* isolate,
+                    const base::FilePath& path,
+                    v8::Local<v8::Function> callback) {
+    StartLookup(isolate, AsyncLookup::Type::READDIR, path, callback);
+  }
+
   // Returns the path of file with symbol link resolved.
   v8::Local<v8::Value> Realpath(v8::Isolate* isolate,
                                 const base::FilePath& path) {
@@ -96,6 +263,13 @@ class Archive : public mate::Wrappable<Archive> {
     return mate::ConvertToV8(isolate, realpath);
   }
 
+  // Same with Realpath, but the lookup runs on the thread pool.
+  void RealpathAsync(v8::Isolate* isolate,
+                     const base::FilePath& path,
+                     v8::Local<v8::Function> callback) {
+    StartLookup(isolate, AsyncLookup::Type::REALPATH, path, callback);
+  }
+
   // Copy the file out into a temporary file and returns the new path.
   v8::Local<v8::Value> CopyFileOut(v8::Isolate* isolate,
                                    const base::FilePath& path) {
@@ -105,6 +279,97 @@ class Archive : public mate::Wrappable<Archive> {
     return mate::ConvertToV8(isolate, new_path);
   }
 
+  // Returns a Buffer that points directly into the memory-mapped archive.
+  // The memory is read-only, so the Buffer must never be handed to user code.
+  // Returns false when the file can not be mapped and undefined when it is
+  // corrupted.
+  v8::Local<v8::Value> ReadFileView(v8::Isolate* isolate,
+                                    const base::FilePath& path) {
+    asar::Archive::FileInfo info;
+    base::StringPiece content;
+    if (!archive_ || !archive_->GetFileInfo(path, &info) || info.compressed ||
+        !archive_->GetFileContent(info, &content))
+      return v8::False(isolate);
+    if (!archive_->VerifyRange(info, 0, info.size))
+      return v8::Undefined(isolate);
+    return node::Buffer::New(isolate, const_cast<char*>(content.data()),
+                             content.size(), &ReleaseArchive,
+                             new std::shared_ptr<asar::Archive>(archive_))
+        .ToLocalChecked();
+  }
+
+  // Reads the whole file into a new Buffer, decompressing it if needed.
+  v8::Local<v8::Value> ReadFile(v8::Isolate* isolate,
+                                const base::FilePath& path) {
+    asar::Archive::FileInfo info;
+    std::string contents;
+    if (!archive_ || !archive_->GetFileInfo(path, &info) ||
+        !archive_->ReadFile(info, &contents))
+      return v8::False(isolate);
+    return node::Buffer::Copy(isolate, contents.data(), contents.size())
+        .ToLocalChecked();
+  }
+
+  // Same with ReadFile, but the file is read, verified and decompressed on the
+  // thread pool. The callback gets false when the file does not exist and
+  // undefined when it is corrupted.
+  void ReadFileAsync(v8::Isolate* isolate,
+                     const base::FilePath& path,
+                     v8::Local<v8::Function> callback) {
+    StartLookup(isolate, AsyncLookup::Type::READ, path, callback);
+  }
+
+  // Looks up and reads the file in one call, as a string when |as_utf8| and
+  // as a new Buffer otherwise. Returns false when the file does not exist,
+  // undefined when it is corrupted and null when the caller has to read it
+  // itself, e.g. because it is unpacked. Packed files are always verified.
+  v8::Local<v8::Value> ReadFileSync(v8::Isolate* isolate,
+                                    const base::FilePath& path,
+                                    bool as_utf8) {
+    asar::Archive::FileInfo info;
+    if (!archive_ || !archive_->GetFileInfo(path, &info))
+      return v8::False(isolate);
+    if (info.unpacked)
+      return v8::Null(isolate);
+
+    // Uncompressed files are used in place when the archive is mapped,
+    // otherwise ReadFile verifies and reads them from the file.
+    std::string contents;
+    base::StringPiece content;
+    if (info.compressed || !archive_->GetFileContent(info, &content)) {
+      if (!archive_->ReadFile(info, &contents))
+        return v8::Undefined(isolate);
+      content = contents;
+    } else if (!archive_->VerifyRange(info, 0, info.size)) {
+      return v8::Undefined(isolate);
+    }
+
+    if (!as_utf8)
+      return node::Buffer::Copy(isolate, content.data(), content.size())
+          .ToLocalChecked();
+    v8::Local<v8::String> result;
+    if (content.size() > static_cast<size_t>(v8::String::kMaxLength) ||
+        !v8::String::NewFromUtf8(isolate, content.data(),
+                                 v8::NewStringType::kNormal,
+                                 static_cast<int>(content.size()))
+             .ToLocal(&result))
+      return v8::Null(isolate);
+    return result;
+  }
+
+  // Returns the index of the first of |paths| that exists and is not a
+  // directory, or -1 when there is none.
+  int ResolveCandidates(const std::vector<base::FilePath>& paths) {
+    if (!archive_)
+      return -1;
+    for (size_t i = 0; i < paths.size(); ++i) {
+      asar::Archive::Stats stats;
+      if (archive_->Stat(paths[i], &stats) && !stats.is_directory)
+        return static_cast<int>(i);
+    }
+    return -1;
+  }
+
   // Return the file descriptor.
   int GetFD() const {
     if (!archive_)
@@ -112,12 +377,40 @@ class Archive : public mate::Wrappable<Archive> {
     return archive_->GetFD();
   }
 
+  // Returns a digest that changes with each version of the archive.
+  std::string GetHeaderDigest() {
+    if (!archive_)
+      return std::string();
+    return archive_->GetHeaderDigest();
+  }
+
  private:
-  std::unique_ptr<asar::Archive> archive_;
+  void StartLookup(v8::Isolate* isolate,
+                   AsyncLookup::Type type,
+                   const base::FilePath& path,
+                   v8::Local<v8::Function> callback) {
+    // The lookup fails when the archive could not be opened, it still goes
+    // through the pool so the callback is never called synchronously.
+    AsyncLookup::Start(isolate, archive_, type, path, callback);
+  }
+
+  std::shared_ptr<asar::Archive> archive_;
 
   DISALLOW_COPY_AND_ASSIGN(Archive);
 };
 
+v8::Local<v8::Value> GetArchiveCacheStats(v8::Isolate* isolate) {
+  std::vector<mate::Dictionary> result;
+  for (const auto& stats : asar::GetArchiveCacheStats()) {
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+    dict.Set("path", stats.path);
+    dict.Set("hits", static_cast<double>(stats.hits));
+    dict.Set("misses", static_cast<double>(stats.misses));
+    result.push_back(dict);
+  }
+  return mate::ConvertToV8(isolate, result);
+}
+
 void InitAsarSupport(v8::Isolate* isolate,
                      v8::Local<v8::Value> process,
                      v8::Local<v8::Value> require) {
@@ -137,13 +430,99 @@ void InitAsarSupport(v8::Isolate* isolate,
   }
 }
 
+// The embedded sources live as long as the process, V8 can use them in place.
+class InternalModuleSource
+    : public v8::String::ExternalOneByteStringResource {
+ public:
+  explicit InternalModuleSource(const atom::InternalModule* module)
+      : module_(module) {}
+
+  const char* data() const override {
+    return reinterpret_cast<const char*>(module_->source);
+  }
+  size_t length() const override { return module_->length; }
+
+ private:
+  const atom::InternalModule* module_;
+
+  DISALLOW_COPY_AND_ASSIGN(InternalModuleSource);
+};
+
+// Returns the source of lib/|path| compiled into the binary, or undefined.
+v8::Local<v8::Value> GetInternalModuleSource(v8::Isolate* isolate,
+                                             const std::string& path) {
+  const atom::InternalModule* module = atom::FindInternalModule(path);
+  if (!module)
+    return v8::Undefined(isolate);
+  v8::Local<v8::String> source;
+  if (module->is_ascii) {
+    if (!v8::String::NewExternalOneByte(isolate,
+                                        new InternalModuleSource(module))
+             .ToLocal(&source))
+      return v8::Undefined(isolate);
+  } else {
+    source = v8::String::NewFromUtf8(
+        isolate, reinterpret_cast<const char*>(module->source),
+        v8::String::kNormalString, module->length);
+  }
+  return source;
+}
+
+bool HasInternalModule(const std::string& path) {
+  return atom::FindInternalModule(path) != nullptr;
+}
+
+// The code cache of electron.asar is read once per process and then shared by
+// the environments of all threads, e.g. those of web workers.
+struct CodeCacheFiles {
+  base::Lock lock;
+  // Null when the file could not be read.
+  std::map<base::FilePath, std::unique_ptr<std::string>> files;
+};
+
+base::LazyInstance<CodeCacheFiles>::Leaky g_code_cache_files =
+    LAZY_INSTANCE_INITIALIZER;
+
+v8::Local<v8::Value> ReadCodeCache(v8::Isolate* isolate,
+                                   const base::FilePath& path) {
+  CodeCacheFiles& cache = g_code_cache_files.Get();
+  base::AutoLock auto_lock(cache.lock);
+  auto it = cache.files.find(path);
+  if (it == cache.files.end()) {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    auto data = std::make_unique<std::string>();
+    if (!base::ReadFileToString(path, data.get()))
+      data.reset();
+    it = cache.files.emplace(path, std::move(data)).first;
+  }
+  if (!it->second)
+    return v8::Undefined(isolate);
+  return node::Buffer::Copy(isolate, it->second->data(), it->second->size())
+      .ToLocalChecked();
+}
+
+// The worker threads of Node can not use InitAsarSupport, the natives of their
+// loader are not reachable, so they evaluate asar.js as a module instead.
+v8::Local<v8::Value> GetAsarSource(v8::Isolate* isolate) {
+  return node::asar_value.ToStringChecked(isolate);
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
                 void* priv) {
-  mate::Dictionary dict(context->GetIsolate(), exports);
+  v8::Isolate* isolate = context->GetIsolate();
+  atom::PrepareNodeWorkerIsolate(isolate);
+
+  mate::Dictionary dict(isolate, exports);
   dict.SetMethod("createArchive", &Archive::Create);
+  dict.SetMethod("getArchiveCacheStats", &GetArchiveCacheStats);
   dict.SetMethod("initAsarSupport", &InitAsarSupport);
+  dict.SetMethod("getAsarSource", &GetAsarSource);
+  dict.SetMethod("getInternalModuleSource", &GetInternalModuleSource);
+  dict.SetMethod("hasInternalModule", &HasInternalModule);
+  dict.SetMethod("readCodeCache", &ReadCodeCache);
+  dict.SetMethod("prefetchRecordedReads", &asar::PrefetchRecordedReads);
 }
 
 }  // namespace
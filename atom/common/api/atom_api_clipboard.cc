@@ -4,20 +4,115 @@
 
 #include "atom/common/api/atom_api_clipboard.h"
 
+#include <utility>
+
+#include "atom/common/api/atom_api_native_image.h"
+#include "atom/common/api/locker.h"
 #include "atom/common/native_mate_converters/image_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
+#include "atom/common/promise_util.h"
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task_scheduler/post_task.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixmap.h"
 #include "ui/base/clipboard/scoped_clipboard_writer.h"
 
+#if defined(USE_X11)
+#include "ui/gfx/codec/png_codec.h"
+#endif
+
 #include "atom/common/node_includes.h"
 
 namespace atom {
 
 namespace api {
 
+namespace {
+
+base::TaskTraits GetClipboardTaskTraits() {
+  return {base::TaskPriority::USER_BLOCKING,
+          base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+}
+
+void ReleaseString(char* data, void* hint) {
+  delete static_cast<std::string*>(hint);
+}
+
+void ResolveWithImage(scoped_refptr<util::Promise> promise,
+                      const SkBitmap& bitmap) {
+  v8::Isolate* isolate = promise->isolate();
+  mate::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise->GetHandle()->CreationContext());
+  promise->Resolve(
+      NativeImage::Create(isolate, gfx::Image::CreateFrom1xBitmap(bitmap)));
+}
+
+#if defined(USE_X11)
+// The X11 clipboard stores images as PNG. It would encode and decode them
+// synchronously in WriteBitmap() and ReadImage(), so the PNG is read and
+// written as raw data instead and converted on the thread pool.
+SkBitmap DecodeImage(const std::string& png) {
+  SkBitmap bitmap;
+  gfx::PNGCodec::Decode(reinterpret_cast<const unsigned char*>(png.data()),
+                        png.size(), &bitmap);
+  return bitmap;
+}
+
+std::string PrepareImage(const SkBitmap& bitmap) {
+  std::vector<unsigned char> png;
+  if (!gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &png))
+    return std::string();
+  return std::string(png.begin(), png.end());
+}
+
+void WritePreparedImage(ui::ClipboardType type,
+                        scoped_refptr<util::Promise> promise,
+                        std::string png) {
+  v8::Isolate* isolate = promise->isolate();
+  mate::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise->GetHandle()->CreationContext());
+  if (png.empty()) {
+    promise->RejectWithErrorMessage("Failed to encode the image");
+    return;
+  }
+  ui::ScopedClipboardWriter writer(type);
+  writer.WriteData(png.data(), png.size(),
+                   ui::Clipboard::GetBitmapFormatType());
+  promise->Resolve();
+}
+#else
+// The clipboard takes a copy of the pixels that it can own.
+SkBitmap PrepareImage(const SkBitmap& orig) {
+  SkBitmap bmp;
+  if (!bmp.tryAllocPixels(orig.info()) ||
+      !orig.readPixels(bmp.info(), bmp.getPixels(), bmp.rowBytes(), 0, 0))
+    return SkBitmap();
+  return bmp;
+}
+
+void WritePreparedImage(ui::ClipboardType type,
+                        scoped_refptr<util::Promise> promise,
+                        const SkBitmap& bitmap) {
+  v8::Isolate* isolate = promise->isolate();
+  mate::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise->GetHandle()->CreationContext());
+  if (bitmap.drawsNothing()) {
+    promise->RejectWithErrorMessage("Failed to copy the image");
+    return;
+  }
+  ui::ScopedClipboardWriter writer(type);
+  writer.WriteImage(bitmap);
+  promise->Resolve();
+}
+#endif
+
+}  // namespace
+
 ui::ClipboardType Clipboard::GetClipboardType(mate::Arguments* args) {
   std::string type;
   if (args->GetNext(&type) && type == "selection")
@@ -51,8 +146,10 @@ std::string Clipboard::Read(const std::string& format_string) {
 
 v8::Local<v8::Value> Clipboard::ReadBuffer(const std::string& format_string,
                                            mate::Arguments* args) {
-  std::string data = Read(format_string);
-  return node::Buffer::Copy(args->isolate(), data.data(), data.length())
+  // The Buffer takes over the string instead of copying large payloads.
+  auto* data = new std::string(Read(format_string));
+  return node::Buffer::New(args->isolate(), const_cast<char*>(data->data()),
+                           data->size(), &ReleaseString, data)
       .ToLocalChecked();
 }
 
@@ -178,6 +275,36 @@ void Clipboard::WriteImage(const gfx::Image& image, mate::Arguments* args) {
   }
 }
 
+v8::Local<v8::Promise> Clipboard::ReadImageAsync(mate::Arguments* args) {
+  scoped_refptr<util::Promise> promise = new util::Promise(args->isolate());
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  auto type = GetClipboardType(args);
+#if defined(USE_X11)
+  if (type == ui::CLIPBOARD_TYPE_COPY_PASTE) {
+    std::string png;
+    clipboard->ReadData(ui::Clipboard::GetBitmapFormatType(), &png);
+    base::PostTaskWithTraitsAndReplyWithResult(
+        FROM_HERE, GetClipboardTaskTraits(),
+        base::BindOnce(&DecodeImage, std::move(png)),
+        base::BindOnce(&ResolveWithImage, promise));
+    return promise->GetHandle();
+  }
+#endif
+  // The other platforms convert the image inside ReadImage().
+  ResolveWithImage(promise, clipboard->ReadImage(type));
+  return promise->GetHandle();
+}
+
+v8::Local<v8::Promise> Clipboard::WriteImageAsync(const gfx::Image& image,
+                                                  mate::Arguments* args) {
+  scoped_refptr<util::Promise> promise = new util::Promise(args->isolate());
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, GetClipboardTaskTraits(),
+      base::BindOnce(&PrepareImage, image.AsBitmap()),
+      base::BindOnce(&WritePreparedImage, GetClipboardType(args), promise));
+  return promise->GetHandle();
+}
+
 #if !defined(OS_MACOSX)
 void Clipboard::WriteFindText(const base::string16& text) {}
 base::string16 Clipboard::ReadFindText() {
@@ -214,6 +341,8 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("writeBookmark", &atom::api::Clipboard::WriteBookmark);
   dict.SetMethod("readImage", &atom::api::Clipboard::ReadImage);
   dict.SetMethod("writeImage", &atom::api::Clipboard::WriteImage);
+  dict.SetMethod("readImageAsync", &atom::api::Clipboard::ReadImageAsync);
+  dict.SetMethod("writeImageAsync", &atom::api::Clipboard::WriteImageAsync);
   dict.SetMethod("readFindText", &atom::api::Clipboard::ReadFindText);
   dict.SetMethod("writeFindText", &atom::api::Clipboard::WriteFindText);
   dict.SetMethod("readBuffer", &atom::api::Clipboard::ReadBuffer);
@@ -44,6 +44,12 @@ class Clipboard {
   static gfx::Image ReadImage(mate::Arguments* args);
   static void WriteImage(const gfx::Image& image, mate::Arguments* args);
 
+  // Variants that convert the image on the thread pool and return a promise.
+  // The clipboard itself is only accessed on the calling thread.
+  static v8::Local<v8::Promise> ReadImageAsync(mate::Arguments* args);
+  static v8::Local<v8::Promise> WriteImageAsync(const gfx::Image& image,
+                                                mate::Arguments* args);
+
   static base::string16 ReadFindText();
   static void WriteFindText(const base::string16& text);
 
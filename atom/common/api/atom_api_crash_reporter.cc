@@ -5,6 +5,7 @@
 #include <map>
 #include <string>
 
+#include "atom/common/crash_reporter/crash_annotations.h"
 #include "atom/common/crash_reporter/crash_reporter.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "base/bind.h"
@@ -12,6 +13,7 @@
 
 #include "atom/common/node_includes.h"
 
+using crash_reporter::CrashAnnotations;
 using crash_reporter::CrashReporter;
 
 namespace mate {
@@ -44,6 +46,14 @@ std::map<std::string, std::string> GetParameters() {
   return CrashReporter::GetInstance()->GetParameters();
 }
 
+int AllocateAnnotation(const std::string& key) {
+  return CrashAnnotations::Allocate(key);
+}
+
+void SetAnnotation(int slot, const std::string& value) {
+  CrashAnnotations::Set(slot, value);
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -60,6 +70,11 @@ void Initialize(v8::Local<v8::Object> exports,
                  base::Bind(&CrashReporter::SetUploadToServer, reporter));
   dict.SetMethod("getUploadToServer",
                  base::Bind(&CrashReporter::GetUploadToServer, reporter));
+  dict.SetMethod("setMinidumpSizeLimit",
+                 base::Bind(&CrashReporter::SetMinidumpSizeLimit, reporter));
+  dict.SetMethod("allocateAnnotation", &AllocateAnnotation);
+  dict.SetMethod("setAnnotation", &SetAnnotation);
+  dict.SetMethod("clearAnnotation", &CrashAnnotations::Clear);
 }
 
 }  // namespace
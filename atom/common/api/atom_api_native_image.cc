@@ -4,23 +4,33 @@
 
 #include "atom/common/api/atom_api_native_image.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "atom/common/api/native_image_cache.h"
 #include "atom/common/asar/asar_util.h"
+#include "atom/common/bitmap_buffer.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/gfx_converter.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "atom/common/node_worker_isolate.h"
+#include "atom/common/promise_util.h"
+#include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
+#include "base/task_scheduler/post_task.h"
 #include "base/threading/thread_restrictions.h"
 #include "native_mate/object_template_builder.h"
 #include "net/base/data_url.h"
+#include "third_party/skia/include/codec/SkCodec.h"
 #include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
 #include "ui/base/layout.h"
@@ -28,6 +38,7 @@
 #include "ui/gfx/codec/jpeg_codec.h"
 #include "ui/gfx/codec/png_codec.h"
 #include "ui/gfx/geometry/size.h"
+#include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/image/image_skia_operations.h"
 #include "ui/gfx/image/image_util.h"
@@ -81,78 +92,239 @@ float GetScaleFactorFromOptions(mate::Arguments* args) {
   return scale_factor;
 }
 
+// Decodes PNG or JPEG |data|, the bitmap is empty when it fails. This is
+// thread safe.
+SkBitmap DecodeImage(const unsigned char* data, size_t size) {
+  // Try PNG first.
+  SkBitmap bitmap;
+  if (gfx::PNGCodec::Decode(data, size, &bitmap))
+    return bitmap;
+
+  // Try JPEG.
+  std::unique_ptr<SkBitmap> decoded = gfx::JPEGCodec::Decode(data, size);
+  if (!decoded)
+    return SkBitmap();
+
+  // `JPEGCodec::Decode()` doesn't tell `SkBitmap` instance it creates
+  // that all of its pixels are opaque, that's why the bitmap gets
+  // an alpha type `kPremul_SkAlphaType` instead of `kOpaque_SkAlphaType`.
+  // Let's fix it here.
+  // TODO(alexeykuzmin): This workaround should be removed
+  // when the `JPEGCodec::Decode()` code is fixed.
+  // See https://github.com/electron/electron/issues/11294.
+  decoded->setAlphaType(SkAlphaType::kOpaque_SkAlphaType);
+  return *decoded;
+}
+
 bool AddImageSkiaRep(gfx::ImageSkia* image,
                      const unsigned char* data,
                      size_t size,
                      int width,
                      int height,
                      double scale_factor) {
-  auto decoded = std::make_unique<SkBitmap>();
-
-  // Try PNG first.
-  if (!gfx::PNGCodec::Decode(data, size, decoded.get())) {
-    // Try JPEG.
-    decoded = gfx::JPEGCodec::Decode(data, size);
-    if (decoded) {
-      // `JPEGCodec::Decode()` doesn't tell `SkBitmap` instance it creates
-      // that all of its pixels are opaque, that's why the bitmap gets
-      // an alpha type `kPremul_SkAlphaType` instead of `kOpaque_SkAlphaType`.
-      // Let's fix it here.
-      // TODO(alexeykuzmin): This workaround should be removed
-      // when the `JPEGCodec::Decode()` code is fixed.
-      // See https://github.com/electron/electron/issues/11294.
-      decoded->setAlphaType(SkAlphaType::kOpaque_SkAlphaType);
-    }
-  }
+  SkBitmap decoded = DecodeImage(data, size);
 
-  if (!decoded) {
+  if (decoded.isNull()) {
     // Try Bitmap
     if (width > 0 && height > 0) {
-      decoded.reset(new SkBitmap);
-      decoded->allocN32Pixels(width, height, false);
-      decoded->setPixels(
-          const_cast<void*>(reinterpret_cast<const void*>(data)));
+      decoded.allocN32Pixels(width, height, false);
+      decoded.setPixels(const_cast<void*>(reinterpret_cast<const void*>(data)));
     } else {
       return false;
     }
   }
 
-  image->AddRepresentation(gfx::ImageSkiaRep(*decoded, scale_factor));
+  image->AddRepresentation(gfx::ImageSkiaRep(decoded, scale_factor));
   return true;
 }
 
-bool AddImageSkiaRep(gfx::ImageSkia* image,
-                     const base::FilePath& path,
-                     double scale_factor) {
-  std::string file_contents;
+// Only the header of |data| is parsed, the pixels are decoded the first time
+// they are needed.
+bool AddEncodedRep(std::vector<NativeImage::EncodedRep>* reps,
+                   scoped_refptr<base::RefCountedString> data,
+                   float scale_factor) {
+  std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(
+      SkData::MakeWithoutCopy(data->front(), data->size()));
+  if (!codec)
+    return false;
+
+  SkEncodedImageFormat format = codec->getEncodedFormat();
+  if (format != SkEncodedImageFormat::kPNG &&
+      format != SkEncodedImageFormat::kJPEG)
+    return false;
+
+  SkISize dimensions = codec->dimensions();
+  if (dimensions.isEmpty())
+    return false;
+
+  reps->push_back({data, scale_factor,
+                   gfx::Size(dimensions.width(), dimensions.height()),
+                   format == SkEncodedImageFormat::kPNG});
+  return true;
+}
+
+bool AddEncodedRep(std::vector<NativeImage::EncodedRep>* reps,
+                   const base::FilePath& path,
+                   float scale_factor) {
+  auto data = base::MakeRefCounted<base::RefCountedString>();
   {
     base::ThreadRestrictions::ScopedAllowIO allow_io;
-    if (!asar::ReadFileToString(path, &file_contents))
+    if (!asar::ReadFileToString(path, &data->data()))
       return false;
   }
 
-  const unsigned char* data =
-      reinterpret_cast<const unsigned char*>(file_contents.data());
-  size_t size = file_contents.size();
-  return AddImageSkiaRep(image, data, size, 0, 0, scale_factor);
+  return AddEncodedRep(reps, data, scale_factor);
 }
 
-bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
-                                   const base::FilePath& path) {
-  bool succeed = false;
+// The candidate files are appended to |checked_files| with their
+// modification times when it is given, with a null time for the missing ones
+// so that a representation added later is noticed. The times are taken
+// before the files are read, so a file modified meanwhile is read again next
+// time.
+bool PopulateEncodedRepsFromPath(
+    std::vector<NativeImage::EncodedRep>* reps,
+    const base::FilePath& path,
+    std::vector<std::pair<base::FilePath, base::Time>>* checked_files =
+        nullptr) {
+  std::vector<std::pair<base::FilePath, float>> candidates;
   std::string filename(path.BaseName().RemoveExtension().AsUTF8Unsafe());
-  if (base::MatchPattern(filename, "*@*x"))
+  if (base::MatchPattern(filename, "*@*x")) {
     // Don't search for other representations if the DPI has been specified.
-    return AddImageSkiaRep(image, path, GetScaleFactorFromPath(path));
-  else
-    succeed |= AddImageSkiaRep(image, path, 1.0f);
+    candidates.emplace_back(path, GetScaleFactorFromPath(path));
+  } else {
+    candidates.emplace_back(path, 1.0f);
+    for (const ScaleFactorPair& pair : kScaleFactorPairs)
+      candidates.emplace_back(path.InsertBeforeExtensionASCII(pair.name),
+                              pair.scale);
+  }
 
-  for (const ScaleFactorPair& pair : kScaleFactorPairs)
-    succeed |= AddImageSkiaRep(
-        image, path.InsertBeforeExtensionASCII(pair.name), pair.scale);
+  bool succeed = false;
+  for (const auto& candidate : candidates) {
+    if (checked_files) {
+      checked_files->emplace_back(
+          candidate.first, NativeImageCache::GetLastModified(candidate.first));
+    }
+    if (AddEncodedRep(reps, candidate.first, candidate.second))
+      succeed = true;
+  }
   return succeed;
 }
 
+// The pixels of one representation of an image, which can be read on any
+// thread.
+struct PixelSource {
+  float scale = 1.0f;
+  SkBitmap bitmap;
+  scoped_refptr<base::RefCountedString> encoded;
+};
+
+PixelSource GetPixelSource(const gfx::Image& image,
+                           const std::vector<NativeImage::EncodedRep>& reps,
+                           float scale_factor) {
+  PixelSource source;
+  source.scale = scale_factor;
+  if (reps.empty()) {
+    source.bitmap =
+        image.AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
+    return source;
+  }
+
+  const NativeImage::EncodedRep* closest = &reps.front();
+  for (const auto& rep : reps) {
+    if (std::abs(rep.scale - scale_factor) <
+        std::abs(closest->scale - scale_factor))
+      closest = &rep;
+  }
+  source.scale = closest->scale;
+  source.encoded = closest->data;
+  return source;
+}
+
+std::vector<PixelSource> GetPixelSources(
+    const gfx::Image& image,
+    const std::vector<NativeImage::EncodedRep>& reps) {
+  std::vector<PixelSource> sources;
+  if (reps.empty()) {
+    for (const gfx::ImageSkiaRep& rep : image.AsImageSkia().image_reps())
+      sources.push_back(GetPixelSource(image, reps, rep.scale()));
+  } else {
+    for (const NativeImage::EncodedRep& rep : reps)
+      sources.push_back(GetPixelSource(image, reps, rep.scale));
+  }
+  return sources;
+}
+
+SkBitmap ReadPixels(const PixelSource& source) {
+  if (!source.encoded)
+    return source.bitmap;
+  return DecodeImage(source.encoded->front(), source.encoded->size());
+}
+
+std::vector<unsigned char> EncodePNG(const PixelSource& source) {
+  std::vector<unsigned char> encoded;
+  SkBitmap bitmap = ReadPixels(source);
+  if (!bitmap.drawsNothing())
+    gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
+  return encoded;
+}
+
+std::vector<unsigned char> EncodeJPEG(const PixelSource& source,
+                                      int quality) {
+  std::vector<unsigned char> encoded;
+  SkBitmap bitmap = ReadPixels(source);
+  if (!bitmap.drawsNothing())
+    gfx::JPEGCodec::Encode(bitmap, quality, &encoded);
+  return encoded;
+}
+
+// Resizes every representation like gfx::ImageSkiaOperations does.
+std::vector<gfx::ImageSkiaRep> ResizeReps(
+    const std::vector<PixelSource>& sources,
+    skia::ImageOperations::ResizeMethod method,
+    const gfx::Size& size) {
+  std::vector<gfx::ImageSkiaRep> reps;
+  for (const PixelSource& source : sources) {
+    SkBitmap bitmap = ReadPixels(source);
+    if (bitmap.drawsNothing())
+      continue;
+    gfx::Size pixel_size = gfx::ScaleToCeiledSize(size, source.scale);
+    reps.emplace_back(skia::ImageOperations::Resize(bitmap, method,
+                                                    pixel_size.width(),
+                                                    pixel_size.height()),
+                      source.scale);
+  }
+  return reps;
+}
+
+// Encoding and resizing run on the thread pool instead of the main thread.
+base::TaskTraits GetImageTaskTraits() {
+  return {base::TaskPriority::USER_VISIBLE,
+          base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+}
+
+void ResolveWithBuffer(scoped_refptr<util::Promise> promise,
+                       std::vector<unsigned char> data) {
+  v8::Isolate* isolate = promise->isolate();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise->GetHandle()->CreationContext());
+  const char* buffer = reinterpret_cast<const char*>(data.data());
+  promise->Resolve(
+      node::Buffer::Copy(isolate, buffer, data.size()).ToLocalChecked());
+}
+
+void ResolveWithImage(scoped_refptr<util::Promise> promise,
+                      std::vector<gfx::ImageSkiaRep> reps) {
+  v8::Isolate* isolate = promise->isolate();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise->GetHandle()->CreationContext());
+  gfx::ImageSkia image_skia;
+  for (const gfx::ImageSkiaRep& rep : reps)
+    image_skia.AddRepresentation(rep);
+  promise->Resolve(NativeImage::Create(isolate, gfx::Image(image_skia)));
+}
+
 base::FilePath NormalizePath(const base::FilePath& path) {
   if (!path.ReferencesParent()) {
     return path;
@@ -204,17 +376,18 @@ bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon) {
 }
 #endif
 
-void Noop(char*, void*) {}
-
 }  // namespace
 
 NativeImage::NativeImage(v8::Isolate* isolate, const gfx::Image& image)
     : image_(image) {
   Init(isolate);
-  if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
-    isolate->AdjustAmountOfExternalAllocatedMemory(
-        image_.ToImageSkia()->bitmap()->computeByteSize());
-  }
+  UpdateExternalMemory();
+}
+
+NativeImage::NativeImage(v8::Isolate* isolate,
+                         const std::vector<EncodedRep>& reps)
+    : encoded_reps_(reps) {
+  Init(isolate);
 }
 
 #if defined(OS_WIN)
@@ -225,18 +398,71 @@ NativeImage::NativeImage(v8::Isolate* isolate, const base::FilePath& hicon_path)
   ReadImageSkiaFromICO(&image_skia, GetHICON(256));
   image_ = gfx::Image(image_skia);
   Init(isolate);
-  if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
-    isolate->AdjustAmountOfExternalAllocatedMemory(
-        image_.ToImageSkia()->bitmap()->computeByteSize());
-  }
+  UpdateExternalMemory();
 }
 #endif
 
 NativeImage::~NativeImage() {
-  if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
-    isolate()->AdjustAmountOfExternalAllocatedMemory(-static_cast<int64_t>(
-        image_.ToImageSkia()->bitmap()->computeByteSize()));
+  isolate()->AdjustAmountOfExternalAllocatedMemory(-external_memory_);
+}
+
+const gfx::Image& NativeImage::image() {
+  DecodeIfNeeded();
+  return image_;
+}
+
+void NativeImage::DecodeIfNeeded() {
+  if (encoded_reps_.empty())
+    return;
+
+  gfx::ImageSkia image_skia;
+  for (const EncodedRep& rep : encoded_reps_) {
+    SkBitmap bitmap = DecodeImage(rep.data->front(), rep.data->size());
+    if (!bitmap.isNull())
+      image_skia.AddRepresentation(gfx::ImageSkiaRep(bitmap, rep.scale));
   }
+  image_ = gfx::Image(image_skia);
+  if (!cache_key_.empty())
+    NativeImageCache::GetInstance()->SetDecoded(cache_key_, encoded_reps_,
+                                                image_);
+  encoded_reps_.clear();
+  UpdateExternalMemory();
+}
+
+void NativeImage::DetachFromCache() {
+  if (cache_key_.empty())
+    return;
+  cache_key_.clear();
+  if (!encoded_reps_.empty())
+    return;
+
+#if defined(OS_MACOSX)
+  bool is_template = IsTemplateImage();
+#endif
+  gfx::ImageSkia image_skia;
+  for (const gfx::ImageSkiaRep& rep : image_.AsImageSkia().image_reps())
+    image_skia.AddRepresentation(rep);
+  image_ = gfx::Image(image_skia);
+#if defined(OS_MACOSX)
+  if (is_template)
+    SetTemplateImage(true);
+#endif
+}
+
+void NativeImage::UpdateExternalMemory() {
+  int64_t size = 0;
+  if (image_.HasRepresentation(gfx::Image::kImageRepSkia))
+    size = image_.ToImageSkia()->bitmap()->computeByteSize();
+  isolate()->AdjustAmountOfExternalAllocatedMemory(size - external_memory_);
+  external_memory_ = size;
+}
+
+const NativeImage::EncodedRep* NativeImage::GetEncoded1xPNG() const {
+  for (const EncodedRep& rep : encoded_reps_) {
+    if (rep.scale == 1.0f && rep.is_png)
+      return &rep;
+  }
+  return nullptr;
 }
 
 #if defined(OS_WIN)
@@ -252,9 +478,9 @@ HICON NativeImage::GetHICON(int size) {
   }
 
   // Then convert the image to ICO.
-  if (image_.IsEmpty())
+  if (image().IsEmpty())
     return NULL;
-  hicons_[size] = IconUtil::CreateHICONFromSkBitmap(image_.AsBitmap());
+  hicons_[size] = IconUtil::CreateHICONFromSkBitmap(image().AsBitmap());
   return hicons_[size].get();
 }
 #endif
@@ -263,8 +489,15 @@ v8::Local<v8::Value> NativeImage::ToPNG(mate::Arguments* args) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
   if (scale_factor == 1.0f) {
+    // Use the PNG file itself when the image has not been decoded.
+    if (const EncodedRep* png = GetEncoded1xPNG()) {
+      return node::Buffer::Copy(args->isolate(), png->data->data().data(),
+                                png->data->size())
+          .ToLocalChecked();
+    }
+
     // Use raw 1x PNG bytes when available
-    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    scoped_refptr<base::RefCountedMemory> png = image().As1xPNGBytes();
     if (png->size() > 0) {
       const char* data = reinterpret_cast<const char*>(png->front());
       size_t size = png->size();
@@ -273,7 +506,7 @@ v8::Local<v8::Value> NativeImage::ToPNG(mate::Arguments* args) {
   }
 
   const SkBitmap bitmap =
-      image_.AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
+      image().AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
   std::vector<unsigned char> encoded;
   gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
   const char* data = reinterpret_cast<char*>(encoded.data());
@@ -281,11 +514,32 @@ v8::Local<v8::Value> NativeImage::ToPNG(mate::Arguments* args) {
   return node::Buffer::Copy(args->isolate(), data, size).ToLocalChecked();
 }
 
+v8::Local<v8::Value> NativeImage::ToPNGAsync(mate::Arguments* args) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+  scoped_refptr<util::Promise> promise = new util::Promise(args->isolate());
+
+  const EncodedRep* png = scale_factor == 1.0f ? GetEncoded1xPNG() : nullptr;
+  if (png) {
+    promise->Resolve(node::Buffer::Copy(args->isolate(),
+                                        png->data->data().data(),
+                                        png->data->size())
+                         .ToLocalChecked());
+    return promise->GetHandle();
+  }
+
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, GetImageTaskTraits(),
+      base::BindOnce(&EncodePNG,
+                     GetPixelSource(image_, encoded_reps_, scale_factor)),
+      base::BindOnce(&ResolveWithBuffer, promise));
+  return promise->GetHandle();
+}
+
 v8::Local<v8::Value> NativeImage::ToBitmap(mate::Arguments* args) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
   const SkBitmap bitmap =
-      image_.AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
+      image().AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
   SkPixelRef* ref = bitmap.pixelRef();
   if (!ref)
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
@@ -297,7 +551,7 @@ v8::Local<v8::Value> NativeImage::ToBitmap(mate::Arguments* args) {
 
 v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
   std::vector<unsigned char> output;
-  gfx::JPEG1xEncodedDataFromImage(image_, quality, &output);
+  gfx::JPEG1xEncodedDataFromImage(image(), quality, &output);
   if (output.empty())
     return node::Buffer::New(isolate, 0).ToLocalChecked();
   return node::Buffer::Copy(isolate,
@@ -306,32 +560,53 @@ v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
       .ToLocalChecked();
 }
 
+v8::Local<v8::Value> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                              int quality) {
+  scoped_refptr<util::Promise> promise = new util::Promise(isolate);
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, GetImageTaskTraits(),
+      base::BindOnce(&EncodeJPEG, GetPixelSource(image_, encoded_reps_, 1.0f),
+                     quality),
+      base::BindOnce(&ResolveWithBuffer, promise));
+  return promise->GetHandle();
+}
+
 std::string NativeImage::ToDataURL(mate::Arguments* args) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
   if (scale_factor == 1.0f) {
+    if (const EncodedRep* png = GetEncoded1xPNG())
+      return webui::GetPngDataUrl(png->data->front(), png->data->size());
+
     // Use raw 1x PNG bytes when available
-    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    scoped_refptr<base::RefCountedMemory> png = image().As1xPNGBytes();
     if (png->size() > 0)
       return webui::GetPngDataUrl(png->front(), png->size());
   }
 
   return webui::GetBitmapDataUrl(
-      image_.AsImageSkia().GetRepresentation(scale_factor).sk_bitmap());
+      image().AsImageSkia().GetRepresentation(scale_factor).sk_bitmap());
 }
 
 v8::Local<v8::Value> NativeImage::GetBitmap(mate::Arguments* args) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
   const SkBitmap bitmap =
-      image_.AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
-  SkPixelRef* ref = bitmap.pixelRef();
-  if (!ref)
-    return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
-  return node::Buffer::New(args->isolate(),
-                           reinterpret_cast<char*>(ref->pixels()),
-                           bitmap.computeByteSize(), &Noop, nullptr)
-      .ToLocalChecked();
+      image().AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
+  base::OnceClosure detach;
+  v8::Local<v8::Object> buffer = CreateBitmapBuffer(
+      args->isolate(), bitmap, pixels_transient_ ? &detach : nullptr);
+  if (detach)
+    detach_bitmaps_.push_back(std::move(detach));
+  return buffer;
+}
+
+void NativeImage::ReleasePixels() {
+  for (auto& detach : detach_bitmaps_)
+    std::move(detach).Run();
+  detach_bitmaps_.clear();
+  image_ = gfx::Image();
+  UpdateExternalMemory();
 }
 
 v8::Local<v8::Value> NativeImage::GetNativeHandle(v8::Isolate* isolate,
@@ -340,7 +615,7 @@ v8::Local<v8::Value> NativeImage::GetNativeHandle(v8::Isolate* isolate,
   if (IsEmpty())
     return node::Buffer::New(isolate, 0).ToLocalChecked();
 
-  NSImage* ptr = image_.AsNSImage();
+  NSImage* ptr = image().AsNSImage();
   return node::Buffer::Copy(isolate, reinterpret_cast<char*>(ptr),
                             sizeof(void*))
       .ToLocalChecked();
@@ -351,11 +626,19 @@ v8::Local<v8::Value> NativeImage::GetNativeHandle(v8::Isolate* isolate,
 }
 
 bool NativeImage::IsEmpty() {
-  return image_.IsEmpty();
+  // Only images that have decodable headers are kept encoded.
+  return encoded_reps_.empty() && image_.IsEmpty();
 }
 
 gfx::Size NativeImage::GetSize() {
-  return image_.Size();
+  if (encoded_reps_.empty())
+    return image_.Size();
+
+  // Same as the size of the gfx::ImageSkia, which is given by its first
+  // representation.
+  const EncodedRep& rep = encoded_reps_.front();
+  return gfx::Size(static_cast<int>(rep.pixel_size.width() / rep.scale),
+                   static_cast<int>(rep.pixel_size.height() / rep.scale));
 }
 
 float NativeImage::GetAspectRatio() {
@@ -366,50 +649,75 @@ float NativeImage::GetAspectRatio() {
     return static_cast<float>(size.width()) / static_cast<float>(size.height());
 }
 
-mate::Handle<NativeImage> NativeImage::Resize(
-    v8::Isolate* isolate,
-    const base::DictionaryValue& options) {
-  gfx::Size size = GetSize();
-  int width = size.width();
-  int height = size.height();
+void NativeImage::GetResizeOptions(
+    const base::DictionaryValue& options,
+    gfx::Size* size,
+    skia::ImageOperations::ResizeMethod* method) {
+  *size = GetSize();
+  int width = size->width();
+  int height = size->height();
   bool width_set = options.GetInteger("width", &width);
   bool height_set = options.GetInteger("height", &height);
-  size.SetSize(width, height);
+  size->SetSize(width, height);
 
   if (width_set && !height_set) {
     // Scale height to preserve original aspect ratio
-    size.set_height(width);
-    size = gfx::ScaleToRoundedSize(size, 1.f, 1.f / GetAspectRatio());
+    size->set_height(width);
+    *size = gfx::ScaleToRoundedSize(*size, 1.f, 1.f / GetAspectRatio());
   } else if (height_set && !width_set) {
     // Scale width to preserve original aspect ratio
-    size.set_width(height);
-    size = gfx::ScaleToRoundedSize(size, GetAspectRatio(), 1.f);
+    size->set_width(height);
+    *size = gfx::ScaleToRoundedSize(*size, GetAspectRatio(), 1.f);
   }
 
-  skia::ImageOperations::ResizeMethod method =
-      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
+  *method = skia::ImageOperations::ResizeMethod::RESIZE_BEST;
   std::string quality;
   options.GetString("quality", &quality);
   if (quality == "good")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
+    *method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
   else if (quality == "better")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+    *method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+}
+
+mate::Handle<NativeImage> NativeImage::Resize(
+    v8::Isolate* isolate,
+    const base::DictionaryValue& options) {
+  gfx::Size size;
+  skia::ImageOperations::ResizeMethod method;
+  GetResizeOptions(options, &size, &method);
 
   gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
-      image_.AsImageSkia(), method, size);
+      image().AsImageSkia(), method, size);
   return mate::CreateHandle(isolate,
                             new NativeImage(isolate, gfx::Image(resized)));
 }
 
+v8::Local<v8::Value> NativeImage::ResizeAsync(
+    v8::Isolate* isolate,
+    const base::DictionaryValue& options) {
+  gfx::Size size;
+  skia::ImageOperations::ResizeMethod method;
+  GetResizeOptions(options, &size, &method);
+
+  scoped_refptr<util::Promise> promise = new util::Promise(isolate);
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, GetImageTaskTraits(),
+      base::BindOnce(&ResizeReps, GetPixelSources(image_, encoded_reps_),
+                     method, size),
+      base::BindOnce(&ResolveWithImage, promise));
+  return promise->GetHandle();
+}
+
 mate::Handle<NativeImage> NativeImage::Crop(v8::Isolate* isolate,
                                             const gfx::Rect& rect) {
   gfx::ImageSkia cropped =
-      gfx::ImageSkiaOperations::ExtractSubset(image_.AsImageSkia(), rect);
+      gfx::ImageSkiaOperations::ExtractSubset(image().AsImageSkia(), rect);
   return mate::CreateHandle(isolate,
                             new NativeImage(isolate, gfx::Image(cropped)));
 }
 
 void NativeImage::AddRepresentation(const mate::Dictionary& options) {
+  DetachFromCache();
   int width = 0;
   int height = 0;
   float scale_factor = 1.0f;
@@ -418,7 +726,7 @@ void NativeImage::AddRepresentation(const mate::Dictionary& options) {
   options.Get("scaleFactor", &scale_factor);
 
   bool skia_rep_added = false;
-  gfx::ImageSkia image_skia = image_.AsImageSkia();
+  gfx::ImageSkia image_skia = image().AsImageSkia();
 
   v8::Local<v8::Value> buffer;
   GURL url;
@@ -494,10 +802,32 @@ mate::Handle<NativeImage> NativeImage::CreateFromPath(
     return mate::CreateHandle(isolate, new NativeImage(isolate, image_path));
   }
 #endif
-  gfx::ImageSkia image_skia;
-  PopulateImageSkiaRepsFromPath(&image_skia, image_path);
-  gfx::Image image(image_skia);
-  mate::Handle<NativeImage> handle = Create(isolate, image);
+
+  // The cache is not shared with the worker threads of Node.
+  if (IsNodeWorkerIsolate(isolate)) {
+    std::vector<EncodedRep> encoded_reps;
+    PopulateEncodedRepsFromPath(&encoded_reps, image_path);
+    return mate::CreateHandle(isolate, new NativeImage(isolate, encoded_reps));
+  }
+
+  std::string key = image_path.AsUTF8Unsafe();
+  NativeImageCache* cache = NativeImageCache::GetInstance();
+  NativeImageCache::Entry entry;
+  if (const auto* cached = cache->Get(key)) {
+    entry = *cached;
+  } else {
+    // Failures are not cached, the file may be created later.
+    if (PopulateEncodedRepsFromPath(&entry.encoded_reps, image_path,
+                                    &entry.files))
+      cache->Put(key, entry);
+  }
+
+  // Once an image of the entry has been decoded the others share its pixels.
+  NativeImage* image = entry.image.IsEmpty()
+                           ? new NativeImage(isolate, entry.encoded_reps)
+                           : new NativeImage(isolate, entry.image);
+  image->cache_key_ = key;
+  mate::Handle<NativeImage> handle = mate::CreateHandle(isolate, image);
 #if defined(OS_MACOSX)
   if (IsTemplateFilename(image_path))
     handle->SetTemplateImage(true);
@@ -520,6 +850,14 @@ mate::Handle<NativeImage> NativeImage::CreateFromBuffer(
     options.Get("scaleFactor", &scale_factor);
   }
 
+  // Encoded images are only decoded once their pixels are needed.
+  std::vector<EncodedRep> reps;
+  auto data = base::MakeRefCounted<base::RefCountedString>();
+  data->data().assign(node::Buffer::Data(buffer), node::Buffer::Length(buffer));
+  if (AddEncodedRep(&reps, data, scale_factor))
+    return mate::CreateHandle(args->isolate(),
+                              new NativeImage(args->isolate(), reps));
+
   gfx::ImageSkia image_skia;
   AddImageSkiaRep(&image_skia,
                   reinterpret_cast<unsigned char*>(node::Buffer::Data(buffer)),
@@ -555,7 +893,9 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
   prototype->SetClassName(mate::StringToV8(isolate, "NativeImage"));
   mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("toPNG", &NativeImage::ToPNG)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
       .SetMethod("toJPEG", &NativeImage::ToJPEG)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
       .SetMethod("toBitmap", &NativeImage::ToBitmap)
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
       .SetMethod("getNativeHandle", &NativeImage::GetNativeHandle)
@@ -565,6 +905,7 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setTemplateImage", &NativeImage::SetTemplateImage)
       .SetMethod("isTemplateImage", &NativeImage::IsTemplateImage)
       .SetMethod("resize", &NativeImage::Resize)
+      .SetMethod("resizeAsync", &NativeImage::ResizeAsync)
       .SetMethod("crop", &NativeImage::Crop)
       .SetMethod("getAspectRatio", &NativeImage::GetAspectRatio)
       .SetMethod("addRepresentation", &NativeImage::AddRepresentation);
@@ -607,11 +948,38 @@ bool Converter<mate::Handle<atom::api::NativeImage>>::FromV8(
 
 namespace {
 
+v8::Local<v8::Value> GetCacheStats(v8::Isolate* isolate) {
+  atom::api::NativeImageCache::Stats stats =
+      atom::api::NativeImageCache::GetInstance()->GetStats();
+  uint64_t lookups = stats.hits + stats.misses;
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("hits", stats.hits);
+  dict.Set("misses", stats.misses);
+  dict.Set("hitRate", lookups ? static_cast<double>(stats.hits) / lookups : 0);
+  dict.Set("evictions", stats.evictions);
+  dict.Set("count", static_cast<uint64_t>(stats.count));
+  dict.Set("size", static_cast<uint64_t>(stats.size));
+  dict.Set("limit", static_cast<uint64_t>(stats.limit));
+  return dict.GetHandle();
+}
+
+void ClearCache() {
+  atom::api::NativeImageCache::GetInstance()->Clear();
+}
+
+void SetCacheLimit(double limit) {
+  atom::api::NativeImageCache::GetInstance()->SetLimit(
+      static_cast<size_t>(std::max(limit, 0.0)));
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
                 void* priv) {
-  mate::Dictionary dict(context->GetIsolate(), exports);
+  v8::Isolate* isolate = context->GetIsolate();
+  atom::PrepareNodeWorkerIsolate(isolate);
+
+  mate::Dictionary dict(isolate, exports);
   dict.SetMethod("createEmpty", &atom::api::NativeImage::CreateEmpty);
   dict.SetMethod("createFromPath", &atom::api::NativeImage::CreateFromPath);
   dict.SetMethod("createFromBuffer", &atom::api::NativeImage::CreateFromBuffer);
@@ -619,6 +987,11 @@ void Initialize(v8::Local<v8::Object> exports,
                  &atom::api::NativeImage::CreateFromDataURL);
   dict.SetMethod("createFromNamedImage",
                  &atom::api::NativeImage::CreateFromNamedImage);
+  if (atom::IsNodeWorkerIsolate(isolate))
+    return;
+  dict.SetMethod("getCacheStats", &GetCacheStats);
+  dict.SetMethod("clearCache", &ClearCache);
+  dict.SetMethod("setCacheLimit", &SetCacheLimit);
 }
 
 }  // namespace
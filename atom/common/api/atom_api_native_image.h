@@ -7,12 +7,17 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
+#include "base/callback.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/values.h"
 #include "native_mate/dictionary.h"
 #include "native_mate/handle.h"
 #include "native_mate/wrappable.h"
+#include "skia/ext/image_operations.h"
 #include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
 #include "ui/gfx/image/image.h"
 
 #if defined(OS_WIN)
@@ -26,10 +31,6 @@ namespace base {
 class FilePath;
 }
 
-namespace gfx {
-class Size;
-}
-
 namespace mate {
 class Arguments;
 }
@@ -40,6 +41,14 @@ namespace api {
 
 class NativeImage : public mate::Wrappable<NativeImage> {
  public:
+  // A PNG or JPEG representation that has not been decoded yet.
+  struct EncodedRep {
+    scoped_refptr<base::RefCountedString> data;
+    float scale;
+    gfx::Size pixel_size;
+    bool is_png;
+  };
+
   static mate::Handle<NativeImage> CreateEmpty(v8::Isolate* isolate);
   static mate::Handle<NativeImage> Create(v8::Isolate* isolate,
                                           const gfx::Image& image);
@@ -67,10 +76,18 @@ class NativeImage : public mate::Wrappable<NativeImage> {
   HICON GetHICON(int size);
 #endif
 
-  const gfx::Image& image() const { return image_; }
+  // Decodes the image first if it is still encoded.
+  const gfx::Image& image();
+
+  // For images whose pixels are only valid during an event, e.g. the frames
+  // of the paint event. ReleasePixels() empties the image and the Buffers
+  // returned by getBitmap(), so the pixels can be reused right away.
+  void MarkPixelsTransient() { pixels_transient_ = true; }
+  void ReleasePixels();
 
  protected:
   NativeImage(v8::Isolate* isolate, const gfx::Image& image);
+  NativeImage(v8::Isolate* isolate, const std::vector<EncodedRep>& reps);
 #if defined(OS_WIN)
   NativeImage(v8::Isolate* isolate, const base::FilePath& hicon_path);
 #endif
@@ -78,13 +95,17 @@ class NativeImage : public mate::Wrappable<NativeImage> {
 
  private:
   v8::Local<v8::Value> ToPNG(mate::Arguments* args);
+  v8::Local<v8::Value> ToPNGAsync(mate::Arguments* args);
   v8::Local<v8::Value> ToJPEG(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Value> ToJPEGAsync(v8::Isolate* isolate, int quality);
   v8::Local<v8::Value> ToBitmap(mate::Arguments* args);
   v8::Local<v8::Value> GetBitmap(mate::Arguments* args);
   v8::Local<v8::Value> GetNativeHandle(v8::Isolate* isolate,
                                        mate::Arguments* args);
   mate::Handle<NativeImage> Resize(v8::Isolate* isolate,
                                    const base::DictionaryValue& options);
+  v8::Local<v8::Value> ResizeAsync(v8::Isolate* isolate,
+                                   const base::DictionaryValue& options);
   mate::Handle<NativeImage> Crop(v8::Isolate* isolate, const gfx::Rect& rect);
   std::string ToDataURL(mate::Arguments* args);
   bool IsEmpty();
@@ -97,12 +118,31 @@ class NativeImage : public mate::Wrappable<NativeImage> {
   // Determine if the image is a template image.
   bool IsTemplateImage();
 
+  void GetResizeOptions(const base::DictionaryValue& options,
+                        gfx::Size* size,
+                        skia::ImageOperations::ResizeMethod* method);
+  // Returns the 1x PNG data when the image has not been decoded yet.
+  const EncodedRep* GetEncoded1xPNG() const;
+  void DecodeIfNeeded();
+  void UpdateExternalMemory();
+  // Gives the image its own storage before it is modified, so the images
+  // shared with the cache are left untouched.
+  void DetachFromCache();
+
 #if defined(OS_WIN)
   base::FilePath hicon_path_;
   std::map<int, base::win::ScopedHICON> hicons_;
 #endif
 
   gfx::Image image_;
+  // Decoded into |image_| the first time the pixels are needed.
+  std::vector<EncodedRep> encoded_reps_;
+  int64_t external_memory_ = 0;
+  // The key of the image in the NativeImageCache it is shared with.
+  std::string cache_key_;
+
+  bool pixels_transient_ = false;
+  std::vector<base::OnceClosure> detach_bitmaps_;
 
   DISALLOW_COPY_AND_ASSIGN(NativeImage);
 };
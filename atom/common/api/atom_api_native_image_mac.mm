@@ -6,6 +6,8 @@
 
 #import <Cocoa/Cocoa.h>
 
+#include "atom/common/api/native_image_cache.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/sys_string_conversions.h"
 #include "ui/gfx/color_utils.h"
 #include "ui/gfx/image/image.h"
@@ -35,6 +37,19 @@ mate::Handle<NativeImage> NativeImage::CreateFromNamedImage(
     const std::string& name) {
   @autoreleasepool {
     std::vector<double> hsl_shift;
+    bool has_hsl_shift = args->GetNext(&hsl_shift) && hsl_shift.size() == 3;
+    std::string key = "named:" + name;
+    if (has_hsl_shift)
+      key += base::StringPrintf("@%f,%f,%f", hsl_shift[0], hsl_shift[1],
+                                hsl_shift[2]);
+
+    NativeImageCache* cache = NativeImageCache::GetInstance();
+    if (const auto* entry = cache->Get(key)) {
+      mate::Handle<NativeImage> handle = Create(args->isolate(), entry->image);
+      handle->cache_key_ = key;
+      return handle;
+    }
+
     NSImage* image = [NSImage imageNamed:base::SysUTF8ToNSString(name)];
     if (!image.valid) {
       return CreateEmpty(args->isolate());
@@ -42,7 +57,7 @@ mate::Handle<NativeImage> NativeImage::CreateFromNamedImage(
 
     NSData* png_data = bufferFromNSImage(image);
 
-    if (args->GetNext(&hsl_shift) && hsl_shift.size() == 3) {
+    if (has_hsl_shift) {
       gfx::Image gfx_image = gfx::Image::CreateFrom1xPNGBytes(
           reinterpret_cast<const unsigned char*>((char*)[png_data bytes]),
           [png_data length]);
@@ -55,17 +70,25 @@ mate::Handle<NativeImage> NativeImage::CreateFromNamedImage(
               .CopyNSImage());
     }
 
-    return CreateFromPNG(args->isolate(), (char*)[png_data bytes],
-                         [png_data length]);
+    mate::Handle<NativeImage> handle = CreateFromPNG(
+        args->isolate(), (char*)[png_data bytes], [png_data length]);
+    NativeImageCache::Entry entry;
+    entry.image = handle->image_;
+    cache->Put(key, entry);
+    handle->cache_key_ = key;
+    return handle;
   }
 }
 
 void NativeImage::SetTemplateImage(bool setAsTemplate) {
-  [image_.AsNSImage() setTemplate:setAsTemplate];
+  if (IsTemplateImage() == setAsTemplate)
+    return;
+  DetachFromCache();
+  [image().AsNSImage() setTemplate:setAsTemplate];
 }
 
 bool NativeImage::IsTemplateImage() {
-  return [image_.AsNSImage() isTemplate];
+  return [image().AsNSImage() isTemplate];
 }
 
 }  // namespace api
@@ -0,0 +1,164 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/api/atom_api_object_table.h"
+
+#include <cmath>
+
+#include "base/logging.h"
+#include "native_mate/object_template_builder.h"
+
+namespace atom {
+
+namespace api {
+
+namespace {
+
+// An ID is a positive integer below 2^53, so JavaScript numbers hold it
+// exactly: the generation of the slot in the high bits and the index of the
+// slot in the low bits. A slot would have to be reused 2^31 times for its
+// generation to wrap.
+const int kIndexBits = 22;
+const uint64_t kIndexMask = (UINT64_C(1) << kIndexBits) - 1;
+const uint32_t kMaxGeneration = (UINT32_C(1) << 31) - 1;
+const double kMaxID = static_cast<double>(
+    (static_cast<uint64_t>(kMaxGeneration) << kIndexBits) | kIndexMask);
+
+double MakeID(uint32_t index, uint32_t generation) {
+  return static_cast<double>((static_cast<uint64_t>(generation) << kIndexBits) |
+                             index);
+}
+
+// Returns 0, which is never an ID, if |id| is not an integer in range.
+uint64_t ToID(double id) {
+  if (!(id > 0 && id <= kMaxID) || std::floor(id) != id)
+    return 0;
+  return static_cast<uint64_t>(id);
+}
+
+}  // namespace
+
+ObjectTable::ObjectTable(v8::Isolate* isolate) {
+  Init(isolate);
+}
+
+ObjectTable::~ObjectTable() {}
+
+// static
+mate::Handle<ObjectTable> ObjectTable::Create(v8::Isolate* isolate) {
+  return mate::CreateHandle(isolate, new ObjectTable(isolate));
+}
+
+// static
+void ObjectTable::BuildPrototype(v8::Isolate* isolate,
+                                 v8::Local<v8::FunctionTemplate> prototype) {
+  prototype->SetClassName(mate::StringToV8(isolate, "ObjectTable"));
+  mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
+      .SetMethod("add", &ObjectTable::Add)
+      .SetMethod("get", &ObjectTable::Get)
+      .SetMethod("createOwner", &ObjectTable::CreateOwner)
+      .SetMethod("reference", &ObjectTable::Reference)
+      .SetMethod("dereference", &ObjectTable::Dereference)
+      .SetMethod("releaseOwner", &ObjectTable::ReleaseOwner);
+}
+
+double ObjectTable::Add(v8::Local<v8::Value> object) {
+  uint32_t index;
+  if (!free_slots_.empty()) {
+    index = free_slots_.back();
+    free_slots_.pop_back();
+  } else {
+    CHECK_LT(slots_.size(), kIndexMask) << "Too many remote objects";
+    index = static_cast<uint32_t>(slots_.size());
+    slots_.emplace_back();
+  }
+
+  Slot& slot = slots_[index];
+  // Generations start from 1 so IDs are never 0.
+  slot.generation = slot.generation % kMaxGeneration + 1;
+  slot.object.Reset(isolate(), object);
+  slot.ref_count = 0;
+  return MakeID(index, slot.generation);
+}
+
+v8::Local<v8::Value> ObjectTable::Get(double id) {
+  Slot* slot = GetSlot(ToID(id));
+  if (!slot)
+    return v8::Undefined(isolate());
+  return v8::Local<v8::Value>::New(isolate(), slot->object);
+}
+
+int32_t ObjectTable::CreateOwner() {
+  int32_t owner = ++next_owner_;
+  owners_[owner];
+  return owner;
+}
+
+void ObjectTable::Reference(double id, int32_t owner) {
+  uint64_t key = ToID(id);
+  Slot* slot = GetSlot(key);
+  auto it = owners_.find(owner);
+  if (!slot || it == owners_.end())
+    return;
+  if (it->second.insert(key).second)
+    slot->ref_count++;
+}
+
+void ObjectTable::Dereference(const std::vector<double>& ids,
+                              int32_t owner) {
+  auto it = owners_.find(owner);
+  if (it == owners_.end())
+    return;
+  for (double id : ids) {
+    uint64_t key = ToID(id);
+    if (it->second.erase(key))
+      Release(key);
+  }
+}
+
+void ObjectTable::ReleaseOwner(int32_t owner) {
+  auto it = owners_.find(owner);
+  if (it == owners_.end())
+    return;
+  std::unordered_set<uint64_t> ids;
+  ids.swap(it->second);
+  owners_.erase(it);
+  for (uint64_t id : ids)
+    Release(id);
+}
+
+ObjectTable::Slot* ObjectTable::GetSlot(uint64_t id) {
+  if (id == 0)
+    return nullptr;
+  uint32_t index = static_cast<uint32_t>(id & kIndexMask);
+  uint32_t generation = static_cast<uint32_t>(id >> kIndexBits);
+  if (index >= slots_.size() || slots_[index].generation != generation ||
+      slots_[index].object.IsEmpty())
+    return nullptr;
+  return &slots_[index];
+}
+
+void ObjectTable::Release(uint64_t id) {
+  Slot* slot = GetSlot(id);
+  if (!slot || --slot->ref_count > 0)
+    return;
+
+  // The object no longer has an ID, it gets a new one when it is passed to
+  // a renderer again.
+  v8::HandleScope handle_scope(isolate());
+  v8::Local<v8::Value> object =
+      v8::Local<v8::Value>::New(isolate(), slot->object);
+  if (object->IsObject()) {
+    v8::Local<v8::Private> key = v8::Private::ForApi(
+        isolate(), mate::StringToV8(isolate(), "atomId"));
+    object.As<v8::Object>()->SetPrivate(isolate()->GetCurrentContext(), key,
+                                        v8::Undefined(isolate()));
+  }
+  slot->object.Reset();
+  free_slots_.push_back(static_cast<uint32_t>(id & kIndexMask));
+}
+
+}  // namespace api
+
+}  // namespace atom
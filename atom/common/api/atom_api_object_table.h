@@ -0,0 +1,79 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_API_ATOM_API_OBJECT_TABLE_H_
+#define ATOM_COMMON_API_ATOM_API_OBJECT_TABLE_H_
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "native_mate/handle.h"
+#include "native_mate/wrappable.h"
+
+namespace atom {
+
+namespace api {
+
+// Stores the objects referenced by renderer processes through the remote
+// module, counting the owners that reference each object.
+//
+// The objects are kept in a slab of slots. An ID packs the index of its slot
+// with the generation of the slot, which changes whenever the slot is reused,
+// so IDs of released objects never resolve to newer objects. IDs are safe
+// integers rather than int32 so the generation is wide enough to never wrap.
+class ObjectTable : public mate::Wrappable<ObjectTable> {
+ public:
+  static mate::Handle<ObjectTable> Create(v8::Isolate* isolate);
+
+  static void BuildPrototype(v8::Isolate* isolate,
+                             v8::Local<v8::FunctionTemplate> prototype);
+
+ protected:
+  explicit ObjectTable(v8::Isolate* isolate);
+  ~ObjectTable() override;
+
+ private:
+  struct Slot {
+    v8::Global<v8::Value> object;
+    uint32_t generation = 0;
+    uint32_t ref_count = 0;
+  };
+
+  // Stores |object| without any owner and returns its ID.
+  double Add(v8::Local<v8::Value> object);
+
+  // Returns undefined if |id| is not in the table.
+  v8::Local<v8::Value> Get(double id);
+
+  int32_t CreateOwner();
+
+  // Adds |id| to the objects referenced by |owner|.
+  void Reference(double id, int32_t owner);
+
+  // Removes |ids| from the objects referenced by |owner|, an object is
+  // released once no owner references it.
+  void Dereference(const std::vector<double>& ids, int32_t owner);
+
+  // Dereferences all the objects of |owner| in a single pass.
+  void ReleaseOwner(int32_t owner);
+
+  // Returns nullptr if |id| is not in the table.
+  Slot* GetSlot(uint64_t id);
+  void Release(uint64_t id);
+
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> free_slots_;
+
+  std::unordered_map<int32_t, std::unordered_set<uint64_t>> owners_;
+  int32_t next_owner_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ObjectTable);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_API_ATOM_API_OBJECT_TABLE_H_
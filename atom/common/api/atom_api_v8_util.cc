@@ -6,28 +6,17 @@
 #include <utility>
 
 #include "atom/common/api/atom_api_key_weak_map.h"
+#include "atom/common/api/atom_api_object_table.h"
 #include "atom/common/api/remote_callback_freer.h"
 #include "atom/common/api/remote_object_freer.h"
 #include "atom/common/native_mate_converters/content_converter.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/node_includes.h"
-#include "base/hash.h"
+#include "base/trace_event/trace_event.h"
 #include "native_mate/dictionary.h"
 #include "url/origin.h"
 #include "v8/include/v8-profiler.h"
 
-namespace std {
-
-// The hash function used by DoubleIDWeakMap.
-template <typename Type1, typename Type2>
-struct hash<std::pair<Type1, Type2>> {
-  std::size_t operator()(std::pair<Type1, Type2> value) const {
-    return base::HashInts(base::Hash(value.first), value.second);
-  }
-};
-
-}  // namespace std
-
 namespace mate {
 
 template <typename Type1, typename Type2>
@@ -103,6 +92,15 @@ bool IsSameOrigin(const GURL& l, const GURL& r) {
   return url::Origin::Create(l).IsSameOriginWith(url::Origin::Create(r));
 }
 
+// Lets the JavaScript code mark the loading of modules in startup traces.
+void TraceBegin(const std::string& name) {
+  TRACE_EVENT_COPY_BEGIN0("electron", name.c_str());
+}
+
+void TraceEnd(const std::string& name) {
+  TRACE_EVENT_COPY_END0("electron", name.c_str());
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -115,13 +113,17 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("takeHeapSnapshot", &TakeHeapSnapshot);
   dict.SetMethod("setRemoteCallbackFreer", &atom::RemoteCallbackFreer::BindTo);
   dict.SetMethod("setRemoteObjectFreer", &atom::RemoteObjectFreer::BindTo);
-  dict.SetMethod("createIDWeakMap", &atom::api::KeyWeakMap<int32_t>::Create);
+  // The IDs of the object table are safe integers beyond the int32_t range.
+  dict.SetMethod("createIDWeakMap", &atom::api::KeyWeakMap<int64_t>::Create);
   dict.SetMethod(
       "createDoubleIDWeakMap",
       &atom::api::KeyWeakMap<std::pair<std::string, int32_t>>::Create);
+  dict.SetMethod("createObjectTable", &atom::api::ObjectTable::Create);
   dict.SetMethod("requestGarbageCollectionForTesting",
                  &RequestGarbageCollectionForTesting);
   dict.SetMethod("isSameOrigin", &IsSameOrigin);
+  dict.SetMethod("traceBegin", &TraceBegin);
+  dict.SetMethod("traceEnd", &TraceEnd);
 }
 
 }  // namespace
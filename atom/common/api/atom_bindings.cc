@@ -7,13 +7,16 @@
 #include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "atom/common/api/locker.h"
 #include "atom/common/application_info.h"
 #include "atom/common/atom_version.h"
 #include "atom/common/heap_snapshot.h"
+#include "atom/common/ipc_channel_stats.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
+#include "atom/common/node_bindings.h"
 #include "atom/common/node_includes.h"
 #include "base/logging.h"
 #include "base/process/process_info.h"
@@ -41,8 +44,10 @@ void FatalErrorCallback(const char* location, const char* message) {
 
 }  // namespace
 
-AtomBindings::AtomBindings(uv_loop_t* loop) {
-  uv_async_init(loop, &call_next_tick_async_, OnCallNextTick);
+AtomBindings::AtomBindings(NodeBindings* node_bindings)
+    : node_bindings_(node_bindings) {
+  uv_async_init(node_bindings->uv_loop(), &call_next_tick_async_,
+                OnCallNextTick);
   call_next_tick_async_.data = this;
   metrics_ = base::ProcessMetrics::CreateCurrentProcessMetrics();
 }
@@ -64,12 +69,16 @@ void AtomBindings::BindTo(v8::Isolate* isolate, v8::Local<v8::Object> process) {
   dict.SetMethod("getCPUUsage", base::Bind(&AtomBindings::GetCPUUsage,
                                            base::Unretained(metrics_.get())));
   dict.SetMethod("getIOCounters", &GetIOCounters);
+  dict.SetMethod("getIPCStats", &GetIPCStats);
+  dict.SetMethod("resetIPCStats", &ResetIPCStats);
   dict.SetMethod("takeHeapSnapshot", &TakeHeapSnapshot);
 #if defined(OS_POSIX)
   dict.SetMethod("setFdLimit", &base::IncreaseFdLimitTo);
 #endif
   dict.SetMethod("activateUvLoop", base::Bind(&AtomBindings::ActivateUVLoop,
                                               base::Unretained(this)));
+  dict.SetMethod("getUvRunStats", base::Bind(&AtomBindings::GetUvRunStats,
+                                             base::Unretained(this)));
 
 #if defined(MAS_BUILD)
   dict.SetReadOnly("mas", true);
@@ -104,6 +113,19 @@ void AtomBindings::ActivateUVLoop(v8::Isolate* isolate) {
   uv_async_send(&call_next_tick_async_);
 }
 
+v8::Local<v8::Value> AtomBindings::GetUvRunStats(v8::Isolate* isolate) {
+  const NodeBindings::UvRunStats& stats = node_bindings_->uv_run_stats();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.SetHidden("simple", true);
+  dict.Set("wakeups", stats.wakeups);
+  dict.Set("passes", stats.passes);
+  dict.Set("budgetExhausted", stats.budget_exhausted);
+  dict.Set("totalLatency", stats.total_latency.InMillisecondsF());
+  dict.Set("maxLatency", stats.max_latency.InMillisecondsF());
+  dict.Set("totalRunTime", stats.total_run_time.InMillisecondsF());
+  return dict.GetHandle();
+}
+
 // static
 void AtomBindings::OnCallNextTick(uv_async_t* handle) {
   AtomBindings* self = static_cast<AtomBindings*>(handle->data);
@@ -247,6 +269,29 @@ v8::Local<v8::Value> AtomBindings::GetIOCounters(v8::Isolate* isolate) {
   return dict.GetHandle();
 }
 
+// static
+v8::Local<v8::Value> AtomBindings::GetIPCStats(v8::Isolate* isolate) {
+  std::vector<mate::Dictionary> result;
+  for (const auto& it : IPCChannelStats::GetInstance()->counters()) {
+    const IPCChannelStats::Counters& counters = it.second;
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+    dict.SetHidden("simple", true);
+    dict.Set("channel", it.first);
+    dict.Set("sentCount", counters.sent_count);
+    dict.Set("sentBytes", counters.sent_bytes);
+    dict.Set("receivedCount", counters.received_count);
+    dict.Set("receivedBytes", counters.received_bytes);
+    dict.Set("handlerTime", counters.handler_time.InMillisecondsF());
+    result.push_back(dict);
+  }
+  return mate::ConvertToV8(isolate, result);
+}
+
+// static
+void AtomBindings::ResetIPCStats() {
+  IPCChannelStats::GetInstance()->Reset();
+}
+
 // static
 bool AtomBindings::TakeHeapSnapshot(v8::Isolate* isolate,
                                     const base::FilePath& file_path) {
@@ -22,9 +22,11 @@ class Environment;
 
 namespace atom {
 
+class NodeBindings;
+
 class AtomBindings {
  public:
-  explicit AtomBindings(uv_loop_t* loop);
+  explicit AtomBindings(NodeBindings* node_bindings);
   virtual ~AtomBindings();
 
   // Add process.atomBinding function, which behaves like process.binding but
@@ -44,14 +46,19 @@ class AtomBindings {
   static v8::Local<v8::Value> GetCPUUsage(base::ProcessMetrics* metrics,
                                           v8::Isolate* isolate);
   static v8::Local<v8::Value> GetIOCounters(v8::Isolate* isolate);
+  static v8::Local<v8::Value> GetIPCStats(v8::Isolate* isolate);
+  static void ResetIPCStats();
   static bool TakeHeapSnapshot(v8::Isolate* isolate,
                                const base::FilePath& file_path);
 
  private:
   void ActivateUVLoop(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetUvRunStats(v8::Isolate* isolate);
 
   static void OnCallNextTick(uv_async_t* handle);
 
+  NodeBindings* node_bindings_;
+
   uv_async_t call_next_tick_async_;
   std::list<node::Environment*> pending_next_ticks_;
   std::unique_ptr<base::ProcessMetrics> metrics_;
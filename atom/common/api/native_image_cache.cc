@@ -0,0 +1,148 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/api/native_image_cache.h"
+
+#include "base/files/file_util.h"
+#include "base/lazy_instance.h"
+#include "base/threading/thread_restrictions.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/image/image_skia.h"
+
+namespace atom {
+
+namespace api {
+
+namespace {
+
+// Enough for the icons of the tray, the menus and the notifications.
+const size_t kDefaultLimit = 32 * 1024 * 1024;
+
+base::LazyInstance<NativeImageCache>::Leaky g_native_image_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+NativeImageCache::Entry::Entry() = default;
+
+NativeImageCache::Entry::Entry(const Entry& other) = default;
+
+NativeImageCache::Entry::~Entry() = default;
+
+// static
+NativeImageCache* NativeImageCache::GetInstance() {
+  return g_native_image_cache.Pointer();
+}
+
+NativeImageCache::NativeImageCache()
+    : entries_(base::MRUCache<std::string, Entry>::NO_AUTO_EVICT),
+      limit_(kDefaultLimit) {}
+
+NativeImageCache::~NativeImageCache() = default;
+
+// static
+base::Time NativeImageCache::GetLastModified(const base::FilePath& path) {
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::File::Info info;
+  if (!base::GetFileInfo(path, &info))
+    return base::Time();
+  return info.last_modified;
+}
+
+const NativeImageCache::Entry* NativeImageCache::Get(const std::string& key) {
+  auto it = entries_.Get(key);
+  if (it == entries_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+  for (const auto& file : it->second.files) {
+    if (GetLastModified(file.first) != file.second) {
+      ++misses_;
+      return nullptr;
+    }
+  }
+
+  ++hits_;
+  return &it->second;
+}
+
+void NativeImageCache::Put(const std::string& key, const Entry& entry) {
+  auto it = entries_.Peek(key);
+  if (it != entries_.end()) {
+    size_ -= it->second.size;
+    entries_.Erase(it);
+  }
+
+  it = entries_.Put(key, entry);
+  it->second.size = GetEntrySize(entry);
+  size_ += it->second.size;
+  Shrink();
+}
+
+void NativeImageCache::SetDecoded(
+    const std::string& key,
+    const std::vector<NativeImage::EncodedRep>& reps,
+    const gfx::Image& image) {
+  // The entry may have been replaced by a newer version of the file.
+  auto it = entries_.Peek(key);
+  if (it == entries_.end() || reps.empty() ||
+      it->second.encoded_reps.empty() ||
+      it->second.encoded_reps.front().data != reps.front().data)
+    return;
+
+  size_ -= it->second.size;
+  it->second.encoded_reps.clear();
+  it->second.image = image;
+  it->second.size = GetEntrySize(it->second);
+  size_ += it->second.size;
+  Shrink();
+}
+
+void NativeImageCache::Clear() {
+  entries_.Clear();
+  size_ = 0;
+}
+
+void NativeImageCache::SetLimit(size_t limit) {
+  limit_ = limit;
+  Shrink();
+}
+
+NativeImageCache::Stats NativeImageCache::GetStats() const {
+  Stats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+  stats.count = entries_.size();
+  stats.size = size_;
+  stats.limit = limit_;
+  return stats;
+}
+
+// static
+size_t NativeImageCache::GetEntrySize(const Entry& entry) {
+  size_t size = 0;
+  for (const auto& rep : entry.encoded_reps)
+    size += rep.data->size();
+  if (entry.image.HasRepresentation(gfx::Image::kImageRepSkia)) {
+    for (const auto& rep : entry.image.ToImageSkia()->image_reps())
+      size += rep.sk_bitmap().computeByteSize();
+  } else if (entry.image.HasRepresentation(gfx::Image::kImageRepPNG)) {
+    size += entry.image.As1xPNGBytes()->size();
+  }
+  return size;
+}
+
+void NativeImageCache::Shrink() {
+  while (size_ > limit_ && !entries_.empty()) {
+    auto oldest = entries_.rbegin();
+    size_ -= oldest->second.size;
+    entries_.Erase(oldest);
+    ++evictions_;
+  }
+}
+
+}  // namespace api
+
+}  // namespace atom
@@ -0,0 +1,94 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_API_NATIVE_IMAGE_CACHE_H_
+#define ATOM_COMMON_API_NATIVE_IMAGE_CACHE_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "atom/common/api/atom_api_native_image.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/time/time.h"
+#include "ui/gfx/image/image.h"
+
+namespace atom {
+
+namespace api {
+
+// Keeps the images created from files and named images of the process, so
+// the same icon is only read and decoded once. The least recently used
+// images are evicted once the cache is larger than its limit.
+class NativeImageCache {
+ public:
+  struct Entry {
+    Entry();
+    Entry(const Entry& other);
+    ~Entry();
+
+    // The representations that have not been decoded yet.
+    std::vector<NativeImage::EncodedRep> encoded_reps;
+    // Shared by the images of the entry once one of them has been decoded.
+    gfx::Image image;
+    // The files the representations were looked up in, with their
+    // modification times or a null time for the missing ones, used to notice
+    // that one of them has been modified, added or removed.
+    std::vector<std::pair<base::FilePath, base::Time>> files;
+    // The size charged to the cache for the entry, set by the cache.
+    size_t size = 0;
+  };
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t count = 0;
+    size_t size = 0;
+    size_t limit = 0;
+  };
+
+  static NativeImageCache* GetInstance();
+
+  // Returns the modification time of |path|, or a null time when it has none,
+  // like the files in asar archives, which do not change.
+  static base::Time GetLastModified(const base::FilePath& path);
+
+  NativeImageCache();
+  ~NativeImageCache();
+
+  // Returns nullptr and counts a miss when there is no entry for |key| or when
+  // one of its files has been modified since it was read.
+  const Entry* Get(const std::string& key);
+  void Put(const std::string& key, const Entry& entry);
+  // Replaces the encoded representations of |key| with |image|, which has
+  // been decoded from |reps|.
+  void SetDecoded(const std::string& key,
+                  const std::vector<NativeImage::EncodedRep>& reps,
+                  const gfx::Image& image);
+
+  void Clear();
+  void SetLimit(size_t limit);
+  Stats GetStats() const;
+
+ private:
+  static size_t GetEntrySize(const Entry& entry);
+  void Shrink();
+
+  base::MRUCache<std::string, Entry> entries_;
+  size_t size_ = 0;
+  size_t limit_;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(NativeImageCache);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_API_NATIVE_IMAGE_CACHE_H_
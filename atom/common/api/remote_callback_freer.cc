@@ -4,14 +4,71 @@
 
 #include "atom/common/api/remote_callback_freer.h"
 
+#include <map>
+#include <memory>
+#include <vector>
+
 #include "atom/common/api/api_messages.h"
+#include "base/bind.h"
+#include "base/lazy_instance.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/web_contents.h"
 
 namespace atom {
 
+namespace {
+
+// A batch is sent right away once it has this many callbacks.
+const size_t kMaxReleaseBatch = 1000;
+
+// The callbacks collected since the last flush, keyed by the frame tree node
+// of the main frame, so a WebContents destroyed meanwhile is not used.
+// frame_tree_node_id => context_id => callback IDs
+using PendingReleases = std::map<int, std::map<std::string, std::vector<int>>>;
+
+base::LazyInstance<PendingReleases>::Leaky g_pending_releases =
+    LAZY_INSTANCE_INITIALIZER;
+
+bool g_flush_scheduled = false;
+
+void SendReleases(int frame_tree_node_id,
+                  const std::string& context_id,
+                  const std::vector<int>& callback_ids) {
+  auto* web_contents =
+      content::WebContents::FromFrameTreeNodeId(frame_tree_node_id);
+  if (!web_contents || callback_ids.empty())
+    return;
+  auto* frame_host = web_contents->GetMainFrame();
+  if (!frame_host)
+    return;
+
+  auto* channel = "ELECTRON_RENDERER_RELEASE_CALLBACK";
+  base::ListValue args;
+  int32_t sender_id = 0;
+  args.AppendString(context_id);
+  auto ids = std::make_unique<base::ListValue>();
+  for (int callback_id : callback_ids)
+    ids->AppendInteger(callback_id);
+  args.Append(std::move(ids));
+  frame_host->Send(new AtomFrameMsg_Message(frame_host->GetRoutingID(), true,
+                                            false, channel, args, sender_id));
+}
+
+void FlushReleases() {
+  g_flush_scheduled = false;
+  PendingReleases pending;
+  pending.swap(g_pending_releases.Get());
+  for (const auto& frame : pending) {
+    for (const auto& context : frame.second)
+      SendReleases(frame.first, context.first, context.second);
+  }
+}
+
+}  // namespace
+
 // static
 void RemoteCallbackFreer::BindTo(v8::Isolate* isolate,
                                  v8::Local<v8::Object> target,
@@ -34,18 +91,29 @@ RemoteCallbackFreer::RemoteCallbackFreer(v8::Isolate* isolate,
 RemoteCallbackFreer::~RemoteCallbackFreer() {}
 
 void RemoteCallbackFreer::RunDestructor() {
-  auto* channel = "ELECTRON_RENDERER_RELEASE_CALLBACK";
-  base::ListValue args;
-  int32_t sender_id = 0;
-  args.AppendString(context_id_);
-  args.AppendInteger(object_id_);
-  auto* frame_host = web_contents()->GetMainFrame();
-  if (frame_host) {
-    frame_host->Send(new AtomFrameMsg_Message(frame_host->GetRoutingID(), true,
-                                              false, channel, args, sender_id));
+  auto* frame_host = web_contents() ? web_contents()->GetMainFrame() : nullptr;
+  Observe(nullptr);
+  if (!frame_host)
+    return;
+
+  // Like the dereferences of remote objects, the callbacks collected at once
+  // are released with one message.
+  int frame_tree_node_id = frame_host->GetFrameTreeNodeId();
+  std::vector<int>& callback_ids =
+      g_pending_releases.Get()[frame_tree_node_id][context_id_];
+  callback_ids.push_back(object_id_);
+  if (callback_ids.size() >= kMaxReleaseBatch) {
+    std::vector<int> batch;
+    batch.swap(callback_ids);
+    SendReleases(frame_tree_node_id, context_id_, batch);
+    return;
   }
 
-  Observe(nullptr);
+  if (!g_flush_scheduled) {
+    g_flush_scheduled = true;
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&FlushReleases));
+  }
 }
 
 void RemoteCallbackFreer::RenderViewDeleted(content::RenderViewHost*) {
@@ -4,8 +4,15 @@
 
 #include "atom/common/api/remote_object_freer.h"
 
+#include <map>
+#include <memory>
+#include <vector>
+
 #include "atom/common/api/api_messages.h"
+#include "base/bind.h"
+#include "base/lazy_instance.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
 #include "content/public/renderer/render_frame.h"
 #include "third_party/blink/public/web/web_local_frame.h"
@@ -24,20 +31,63 @@ content::RenderFrame* GetCurrentRenderFrame() {
   return content::RenderFrame::FromWebFrame(frame);
 }
 
+// A batch is sent right away once it has this many objects.
+const size_t kMaxDereferenceBatch = 1000;
+
+// The objects collected since the last flush.
+// routing_id => context_id => object IDs
+using PendingDereferences =
+    std::map<int, std::map<std::string, std::vector<double>>>;
+
+base::LazyInstance<PendingDereferences>::Leaky g_pending_dereferences =
+    LAZY_INSTANCE_INITIALIZER;
+
+bool g_flush_scheduled = false;
+
+void SendDereferences(int routing_id,
+                      const std::string& context_id,
+                      const std::vector<double>& object_ids) {
+  content::RenderFrame* render_frame =
+      content::RenderFrame::FromRoutingID(routing_id);
+  if (!render_frame || object_ids.empty())
+    return;
+
+  auto* channel = "ipc-internal-message";
+  base::ListValue args;
+  args.AppendString("ELECTRON_BROWSER_DEREFERENCE");
+  args.AppendString(context_id);
+  auto ids = std::make_unique<base::ListValue>();
+  for (double object_id : object_ids)
+    ids->AppendDouble(object_id);
+  args.Append(std::move(ids));
+  render_frame->Send(new AtomFrameHostMsg_Message(routing_id, channel, args));
+}
+
 }  // namespace
 
+// static
+void RemoteObjectFreer::FlushDereferences() {
+  g_flush_scheduled = false;
+  PendingDereferences pending;
+  pending.swap(g_pending_dereferences.Get());
+  for (const auto& frame : pending) {
+    for (const auto& context : frame.second)
+      SendDereferences(frame.first, context.first, context.second);
+  }
+}
+
 // static
 void RemoteObjectFreer::BindTo(v8::Isolate* isolate,
                                v8::Local<v8::Object> target,
                                const std::string& context_id,
-                               int object_id) {
+                               double object_id) {
   new RemoteObjectFreer(isolate, target, context_id, object_id);
 }
 
 RemoteObjectFreer::RemoteObjectFreer(v8::Isolate* isolate,
                                      v8::Local<v8::Object> target,
                                      const std::string& context_id,
-                                     int object_id)
+                                     double object_id)
     : ObjectLifeMonitor(isolate, target),
       context_id_(context_id),
       object_id_(object_id),
@@ -51,18 +101,26 @@ RemoteObjectFreer::RemoteObjectFreer(v8::Isolate* isolate,
 RemoteObjectFreer::~RemoteObjectFreer() {}
 
 void RemoteObjectFreer::RunDestructor() {
-  content::RenderFrame* render_frame =
-      content::RenderFrame::FromRoutingID(routing_id_);
-  if (!render_frame)
+  if (routing_id_ == MSG_ROUTING_NONE)
     return;
 
-  auto* channel = "ipc-internal-message";
-  base::ListValue args;
-  args.AppendString("ELECTRON_BROWSER_DEREFERENCE");
-  args.AppendString(context_id_);
-  args.AppendInteger(object_id_);
-  render_frame->Send(new AtomFrameHostMsg_Message(render_frame->GetRoutingID(),
-                                                  channel, args));
+  // A page that drops many remote objects at once would otherwise send a
+  // message for each of them.
+  std::vector<double>& object_ids =
+      g_pending_dereferences.Get()[routing_id_][context_id_];
+  object_ids.push_back(object_id_);
+  if (object_ids.size() >= kMaxDereferenceBatch) {
+    std::vector<double> batch;
+    batch.swap(object_ids);
+    SendDereferences(routing_id_, context_id_, batch);
+    return;
+  }
+
+  if (!g_flush_scheduled) {
+    g_flush_scheduled = true;
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&RemoteObjectFreer::FlushDereferences));
+  }
 }
 
 }  // namespace atom
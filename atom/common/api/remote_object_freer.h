@@ -16,20 +16,25 @@ class RemoteObjectFreer : public ObjectLifeMonitor {
   static void BindTo(v8::Isolate* isolate,
                      v8::Local<v8::Object> target,
                      const std::string& context_id,
-                     int object_id);
+                     double object_id);
+
+  // Sends the dereferences collected since the last flush. They must be sent
+  // before any synchronous message, as its reply may reference the objects
+  // again.
+  static void FlushDereferences();
 
  protected:
   RemoteObjectFreer(v8::Isolate* isolate,
                     v8::Local<v8::Object> target,
                     const std::string& context_id,
-                    int object_id);
+                    double object_id);
   ~RemoteObjectFreer() override;
 
   void RunDestructor() override;
 
  private:
   std::string context_id_;
-  int object_id_;
+  double object_id_;
   int routing_id_;
 
   DISALLOW_COPY_AND_ASSIGN(RemoteObjectFreer);
@@ -4,25 +4,65 @@
 
 #include "atom/common/asar/archive.h"
 
+#include <inttypes.h>
+
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "atom/common/asar/archive_index.h"
+#include "atom/common/asar/readahead.h"
 #include "atom/common/asar/scoped_temporary_file.h"
+#include "base/bind.h"
 #include "base/files/file.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/json/json_reader.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/pickle.h"
+#include "base/sha1.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
 #include "base/task_scheduler/post_task.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
+#include "crypto/sha2.h"
+#include "third_party/brotli/include/brotli/decode.h"
 
 #if defined(OS_WIN)
 #include <io.h>
 #endif
 
+#if defined(OS_LINUX)
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "base/posix/eintr_wrapper.h"
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#endif
+#ifndef F_SEAL_SHRINK
+#define F_SEAL_SHRINK 0x0002
+#endif
+#ifndef F_SEAL_WRITE
+#define F_SEAL_WRITE 0x0008
+#endif
+#endif
+
 namespace asar {
 
 namespace {
@@ -33,6 +73,48 @@ const char kSeparators[] = "\\/";
 const char kSeparators[] = "/";
 #endif
 
+base::LazyInstance<base::Lock>::Leaky g_extraction_cache_lock =
+    LAZY_INSTANCE_INITIALIZER;
+base::LazyInstance<base::FilePath>::Leaky g_extraction_cache_directory =
+    LAZY_INSTANCE_INITIALIZER;
+
+// The extracted files of an archive that has not been used for this long are
+// deleted.
+constexpr base::TimeDelta kExtractionCacheMaxAge =
+    base::TimeDelta::FromDays(30);
+
+// Deletes the other versions of the archive that owns |version_directory|,
+// and the files of the archives that have not been used for a while.
+void PruneExtractionCache(const base::FilePath& cache_directory,
+                          const base::FilePath& version_directory) {
+  base::FilePath archive_directory = version_directory.DirName();
+  base::Time now = base::Time::Now();
+  base::TouchFile(archive_directory, now, now);
+
+  base::FileEnumerator versions(archive_directory, false,
+                                base::FileEnumerator::FILES |
+                                    base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = versions.Next(); !path.empty();
+       path = versions.Next()) {
+    if (path != version_directory)
+      base::DeleteFile(path, true);
+  }
+
+  base::FileEnumerator archives(cache_directory, false,
+                                base::FileEnumerator::FILES |
+                                    base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = archives.Next(); !path.empty();
+       path = archives.Next()) {
+    if (path == archive_directory)
+      continue;
+    // Loose files are left over from an older layout of the cache.
+    base::FileEnumerator::FileInfo info = archives.GetInfo();
+    if (!info.IsDirectory() ||
+        now - info.GetLastModifiedTime() > kExtractionCacheMaxAge)
+      base::DeleteFile(path, true);
+  }
+}
+
 bool GetNodeFromPath(std::string path,
                      const base::DictionaryValue* root,
                      const base::DictionaryValue** out);
@@ -112,6 +194,44 @@ bool FillFileInfoWithNode(Archive::FileInfo* info,
 
   node->GetBoolean("executable", &info->executable);
 
+  bool compressed = false;
+  uint32_t stored_size;
+  if (!ParseCompression(*node, &compressed, &stored_size))
+    return false;
+  if (compressed) {
+    info->compressed = true;
+    info->uncompressed_size = info->size;
+    info->size = stored_size;
+  }
+
+  return true;
+}
+
+// Converts |path| to the form used by the binary index.
+std::string ToIndexPath(const base::FilePath& path) {
+  std::string result = path.AsUTF8Unsafe();
+#if defined(OS_WIN)
+  std::replace(result.begin(), result.end(), '\\', '/');
+#endif
+  return result;
+}
+
+bool FillFileInfoWithEntry(Archive::FileInfo* info,
+                           uint32_t header_size,
+                           const ArchiveIndex::Entry* entry) {
+  if (entry->flags &
+      (ArchiveIndex::kUnknownCompression | ArchiveIndex::kInvalidIntegrity))
+    return false;
+
+  info->size = entry->size;
+  info->unpacked = entry->flags & ArchiveIndex::kUnpacked;
+  if (info->unpacked)
+    return true;
+
+  info->offset = entry->offset + header_size;
+  info->executable = entry->flags & ArchiveIndex::kExecutable;
+  info->compressed = entry->flags & ArchiveIndex::kBrotli;
+  info->uncompressed_size = entry->uncompressed_size;
   return true;
 }
 
@@ -141,6 +261,7 @@ Archive::~Archive() {
 }
 
 bool Archive::Init() {
+  TRACE_EVENT1("electron", "Archive::Init", "path", path_.AsUTF8Unsafe());
   if (!file_.IsValid()) {
     if (file_.error_details() != base::File::FILE_ERROR_NOT_FOUND) {
       LOG(WARNING) << "Opening " << path_.value() << ": "
@@ -178,14 +299,29 @@ bool Archive::Init() {
     PLOG(ERROR) << "Failed to read header from " << path_.value();
     return false;
   }
+  RecordRead(path_, 0, 8 + size);
 
-  std::string header;
-  if (!base::PickleIterator(base::Pickle(buf.data(), buf.size()))
-           .ReadString(&header)) {
+  base::Pickle pickle(buf.data(), buf.size());
+  base::PickleIterator iter(pickle);
+  base::StringPiece header;
+  if (!iter.ReadStringPiece(&header)) {
     LOG(ERROR) << "Failed to parse header from " << path_.value();
     return false;
   }
 
+  // Newer archives carry a binary index after the JSON header, which makes
+  // parsing the JSON unnecessary.
+  const char* index_data;
+  int index_length;
+  if (iter.ReadData(&index_data, &index_length)) {
+    index_ = ArchiveIndex::Create(base::StringPiece(index_data, index_length));
+    if (index_) {
+      header_size_ = 8 + size;
+      return true;
+    }
+    LOG(WARNING) << "Ignoring invalid index in " << path_.value();
+  }
+
   std::string error;
   base::JSONReader reader;
   std::unique_ptr<base::Value> value(reader.ReadToValue(header));
@@ -199,7 +335,37 @@ bool Archive::Init() {
   return true;
 }
 
+bool Archive::InitFromIndex(std::unique_ptr<ArchiveIndex> index,
+                            uint32_t header_size) {
+  if (!file_.IsValid() || !index)
+    return false;
+
+  header_size_ = header_size;
+  index_ = std::move(index);
+  return true;
+}
+
+bool Archive::GetArchiveFileInfo(base::File::Info* info) {
+  return file_.IsValid() && file_.GetInfo(info);
+}
+
 bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) {
+  if (index_) {
+    const ArchiveIndex::Entry* entry = index_->Find(ToIndexPath(path));
+    if (!entry)
+      return false;
+    if (entry->flags & ArchiveIndex::kLink)
+      return GetFileInfo(
+          base::FilePath::FromUTF8Unsafe(index_->GetLink(*entry).as_string()),
+          info);
+    if (entry->flags & ArchiveIndex::kDirectory)
+      return false;
+    if (!FillFileInfoWithEntry(info, header_size_, entry))
+      return false;
+    index_->GetIntegrity(*entry, &info->block_size, &info->block_hashes);
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -211,10 +377,29 @@ bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) {
   if (node->GetString("link", &link))
     return GetFileInfo(base::FilePath::FromUTF8Unsafe(link), info);
 
-  return FillFileInfoWithNode(info, header_size_, node);
+  if (!FillFileInfoWithNode(info, header_size_, node))
+    return false;
+  return FillIntegrityWithNode(info, node);
 }
 
 bool Archive::Stat(const base::FilePath& path, Stats* stats) {
+  if (index_) {
+    const ArchiveIndex::Entry* entry = index_->Find(ToIndexPath(path));
+    if (!entry)
+      return false;
+    if (entry->flags & ArchiveIndex::kLink) {
+      stats->is_file = false;
+      stats->is_link = true;
+      return true;
+    }
+    if (entry->flags & ArchiveIndex::kDirectory) {
+      stats->is_file = false;
+      stats->is_directory = true;
+      return true;
+    }
+    return FillFileInfoWithEntry(stats, header_size_, entry);
+  }
+
   if (!header_)
     return false;
 
@@ -239,6 +424,16 @@ bool Archive::Stat(const base::FilePath& path, Stats* stats) {
 
 bool Archive::Readdir(const base::FilePath& path,
                       std::vector<base::FilePath>* list) {
+  if (index_) {
+    const ArchiveIndex::Entry* entry = index_->Find(ToIndexPath(path));
+    std::vector<std::string> names;
+    if (!entry || !index_->ListChildren(entry, &names))
+      return false;
+    for (const std::string& name : names)
+      list->push_back(base::FilePath::FromUTF8Unsafe(name));
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -259,6 +454,18 @@ bool Archive::Readdir(const base::FilePath& path,
 }
 
 bool Archive::Realpath(const base::FilePath& path, base::FilePath* realpath) {
+  if (index_) {
+    const ArchiveIndex::Entry* entry = index_->Find(ToIndexPath(path));
+    if (!entry)
+      return false;
+    if (entry->flags & ArchiveIndex::kLink)
+      *realpath =
+          base::FilePath::FromUTF8Unsafe(index_->GetLink(*entry).as_string());
+    else
+      *realpath = path;
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -276,7 +483,30 @@ bool Archive::Realpath(const base::FilePath& path, base::FilePath* realpath) {
   return true;
 }
 
+base::FilePath Archive::GetUnpackedPath(const base::FilePath& path) {
+  base::AutoLock auto_lock(lock_);
+  return GetUnpackedPathLocked(path);
+}
+
+base::FilePath Archive::GetUnpackedPathLocked(const base::FilePath& path) {
+  auto it = unpacked_files_.find(path.value());
+  if (it != unpacked_files_.end())
+    return it->second;
+  base::FilePath unpacked_path =
+      path_.AddExtension(FILE_PATH_LITERAL("unpacked")).Append(path);
+  unpacked_files_[path.value()] = unpacked_path;
+  return unpacked_path;
+}
+
 bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
+  TRACE_EVENT1("electron", "Archive::CopyFileOut", "path", path.AsUTF8Unsafe());
+  base::AutoLock auto_lock(lock_);
+  auto extracted = extracted_files_.find(path.value());
+  if (extracted != extracted_files_.end()) {
+    *out = extracted->second;
+    return true;
+  }
+
   auto it = external_files_.find(path.value());
   if (it != external_files_.end()) {
     *out = it->second->path();
@@ -288,14 +518,38 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
     return false;
 
   if (info.unpacked) {
-    *out = path_.AddExtension(FILE_PATH_LITERAL("unpacked")).Append(path);
+    *out = GetUnpackedPathLocked(path);
     return true;
   }
 
+  // The cached files are checked by size and time only, so nothing that
+  // fails the integrity check is extracted.
+  if (!VerifyRange(info, 0, info.size))
+    return false;
+
+  if (CopyFileToCache(path, info, out)) {
+    extracted_files_[path.value()] = *out;
+    return true;
+  }
+
+#if defined(OS_LINUX)
+  if (CopyFileToMemory(info, out)) {
+    extracted_files_[path.value()] = *out;
+    return true;
+  }
+#endif
+
   auto temp_file = std::make_unique<ScopedTemporaryFile>();
   base::FilePath::StringType ext = path.Extension();
-  if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size))
+  if (info.compressed) {
+    std::string buffer;
+    base::StringPiece content;
+    if (!ReadDecodedContent(info, &buffer, &content) ||
+        !temp_file->InitFromContent(ext, content))
+      return false;
+  } else if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size)) {
     return false;
+  }
 
 #if defined(OS_POSIX)
   if (info.executable) {
@@ -309,6 +563,322 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
   return true;
 }
 
+// static
+const base::FilePath::CharType Archive::kExtractionCacheDirectoryName[] =
+    FILE_PATH_LITERAL("Asar Cache");
+
+// static
+void Archive::SetExtractionCacheDirectory(const base::FilePath& path) {
+  base::AutoLock auto_lock(g_extraction_cache_lock.Get());
+  *g_extraction_cache_directory.Pointer() = path;
+}
+
+// static
+base::FilePath Archive::GetExtractionCacheDirectory() {
+  base::AutoLock auto_lock(g_extraction_cache_lock.Get());
+  return g_extraction_cache_directory.Get();
+}
+
+bool Archive::CopyFileToCache(const base::FilePath& path,
+                              const FileInfo& info,
+                              base::FilePath* out) {
+  base::FilePath cache_directory = GetExtractionCacheDirectory();
+  if (cache_directory.empty())
+    return false;
+
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::File::Info archive_info;
+  std::string header_digest = GetHeaderDigest();
+  if (!file_.GetInfo(&archive_info) || header_digest.empty())
+    return false;
+
+  // Each version of an archive has its own directory, so a new version never
+  // reuses stale files and the old versions can be deleted as a whole.
+  std::string archive_hash = base::SHA1HashString(path_.AsUTF8Unsafe());
+  base::FilePath version_directory =
+      cache_directory
+          .AppendASCII(base::HexEncode(archive_hash.data(),
+                                       archive_hash.size()))
+          .AppendASCII(header_digest);
+  std::string key = base::StringPrintf("%s\n%" PRIu64 "\n%u",
+                                       path.AsUTF8Unsafe().c_str(),
+                                       info.offset, info.size);
+  std::string hash = base::SHA1HashString(key);
+  base::FilePath cached_path =
+      version_directory.AppendASCII(base::HexEncode(hash.data(), hash.size()))
+          .AddExtension(path.Extension());
+
+  if (!cache_pruned_) {
+    cache_pruned_ = true;
+    base::PostTaskWithTraits(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::BACKGROUND,
+         base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+        base::BindOnce(&PruneExtractionCache, cache_directory,
+                       version_directory));
+  }
+
+  // The extracted files get the modification time of the archive, in whole
+  // seconds since file systems store it with different precisions. A cached
+  // file that was changed has another size or modification time.
+  base::Time stamp =
+      base::Time::FromTimeT(archive_info.last_modified.ToTimeT());
+  if (IsCachedFileValid(info, cached_path, stamp)) {
+    *out = cached_path;
+    return true;
+  }
+
+  std::string buffer;
+  base::StringPiece content;
+  if (!base::CreateDirectory(version_directory) ||
+      !ReadDecodedContent(info, &buffer, &content))
+    return false;
+
+  // Write into a temporary file first, so other instances of the app never
+  // see a partially written file.
+  base::FilePath temp_path;
+  if (!base::CreateTemporaryFileInDir(version_directory, &temp_path))
+    return false;
+  if (base::WriteFile(temp_path, content.data(), content.size()) !=
+          static_cast<int>(content.size()) ||
+      !base::TouchFile(temp_path, stamp, stamp)) {
+    base::DeleteFile(temp_path, false);
+    return false;
+  }
+#if defined(OS_POSIX)
+  if (info.executable)
+    base::SetPosixFilePermissions(temp_path, 0755);
+#endif
+  if (!base::ReplaceFile(temp_path, cached_path, nullptr)) {
+    base::DeleteFile(temp_path, false);
+    // Another instance might have finished the same extraction.
+    if (!IsCachedFileValid(info, cached_path, stamp))
+      return false;
+  }
+
+  *out = cached_path;
+  return true;
+}
+
+bool Archive::IsCachedFileValid(const FileInfo& info,
+                                const base::FilePath& cached_path,
+                                base::Time stamp) {
+  int64_t expected_size = info.compressed ? info.uncompressed_size : info.size;
+  base::File::Info cached_info;
+  return base::GetFileInfo(cached_path, &cached_info) &&
+         !cached_info.is_directory && cached_info.size == expected_size &&
+         cached_info.last_modified.ToTimeT() == stamp.ToTimeT();
+}
+
+#if defined(OS_LINUX)
+bool Archive::CopyFileToMemory(const FileInfo& info, base::FilePath* out) {
+  base::ScopedFD fd(static_cast<int>(syscall(
+      __NR_memfd_create, "asar", MFD_CLOEXEC | MFD_ALLOW_SEALING)));
+  if (!fd.is_valid())
+    return false;
+
+  // The file is shared with everything that opens the path, sealing it keeps
+  // its content the one of the archive.
+  std::string buffer;
+  base::StringPiece content;
+  if (!ReadDecodedContent(info, &buffer, &content) ||
+      !base::WriteFileDescriptor(fd.get(), content.data(), content.size()) ||
+      HANDLE_EINTR(fcntl(fd.get(), F_ADD_SEALS,
+                         F_SEAL_WRITE | F_SEAL_SHRINK)) != 0)
+    return false;
+
+  *out = base::FilePath("/proc/self/fd").Append(base::IntToString(fd.get()));
+  memory_files_.push_back(std::move(fd));
+  return true;
+}
+#endif
+
+bool Archive::ReadFileContent(const FileInfo& info,
+                              std::string* buffer,
+                              base::StringPiece* content) {
+  if (GetFileContent(info, content))
+    return true;
+
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  buffer->resize(info.size);
+  if (file_.Read(info.offset, &(*buffer)[0], info.size) !=
+      static_cast<int>(info.size))
+    return false;
+  *content = *buffer;
+  return true;
+}
+
+bool Archive::ReadDecodedContent(const FileInfo& info,
+                                 std::string* buffer,
+                                 base::StringPiece* content) {
+  if (!info.compressed)
+    return ReadFileContent(info, buffer, content);
+
+  std::string compressed;
+  base::StringPiece compressed_content;
+  if (!ReadFileContent(info, &compressed, &compressed_content))
+    return false;
+
+  buffer->resize(info.uncompressed_size);
+  size_t decoded_size = buffer->size();
+  if (BrotliDecoderDecompress(
+          compressed_content.size(),
+          reinterpret_cast<const uint8_t*>(compressed_content.data()),
+          &decoded_size, reinterpret_cast<uint8_t*>(&(*buffer)[0])) !=
+          BROTLI_DECODER_RESULT_SUCCESS ||
+      decoded_size != info.uncompressed_size) {
+    LOG(ERROR) << "Failed to decompress file at " << info.offset << " in "
+               << path_.value();
+    return false;
+  }
+
+  *content = *buffer;
+  return true;
+}
+
+bool Archive::ReadFile(const FileInfo& info, std::string* contents) {
+  TRACE_EVENT1("electron", "Archive::ReadFile", "size", info.size);
+  if (!VerifyRange(info, 0, info.size))
+    return false;
+
+  std::string buffer;
+  base::StringPiece content;
+  if (!ReadDecodedContent(info, &buffer, &content))
+    return false;
+
+  if (content.data() == buffer.data())
+    contents->swap(buffer);
+  else
+    content.CopyToString(contents);
+  return true;
+}
+
+std::string Archive::GetHeaderDigest() {
+  if (!header_digest_.empty())
+    return header_digest_;
+
+  std::string header;
+  base::StringPiece content;
+  FileInfo info;
+  info.size = header_size_;
+  if (!ReadFileContent(info, &header, &content))
+    return std::string();
+
+  std::string hash = base::SHA1HashString(content.as_string());
+  header_digest_ = base::HexEncode(hash.data(), hash.size());
+  return header_digest_;
+}
+
+bool Archive::GetFileContent(const FileInfo& info,
+                             base::StringPiece* content) {
+  if (info.unpacked)
+    return false;
+
+  // Callers fall back to reading the file when the archive can not be
+  // mapped, so the range is recorded either way.
+  RecordRead(path_, info.offset, info.size);
+  if (!MapFile())
+    return false;
+
+  if (info.offset + info.size > mapped_file_->length()) {
+    LOG(ERROR) << "File is out of bounds in " << path_.value();
+    return false;
+  }
+
+  *content = base::StringPiece(
+      reinterpret_cast<const char*>(mapped_file_->data()) + info.offset,
+      info.size);
+  return true;
+}
+
+bool Archive::MapFile() {
+  base::AutoLock auto_lock(map_lock_);
+  if (mapped_file_)
+    return true;
+  if (map_failed_ || !file_.IsValid())
+    return false;
+
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(file_.Duplicate())) {
+    LOG(WARNING) << "Failed to map " << path_.value();
+    map_failed_ = true;
+    return false;
+  }
+
+  mapped_file_ = std::move(mapped_file);
+  return true;
+}
+
+bool Archive::FillIntegrityWithNode(FileInfo* info,
+                                    const base::DictionaryValue* node) {
+  if (info->unpacked || !node->FindKey("integrity"))
+    return true;
+
+  base::AutoLock auto_lock(integrity_lock_);
+  auto it = block_hashes_.find(info->offset);
+  if (it == block_hashes_.end()) {
+    uint32_t block_size;
+    std::string block_hashes;
+    if (!ParseIntegrity(*node, &block_size, &block_hashes))
+      return false;
+    // Keep the block size in front of the digests so it is cached as well.
+    std::string record(reinterpret_cast<const char*>(&block_size),
+                       sizeof(block_size));
+    record += block_hashes;
+    it = block_hashes_.emplace(info->offset, std::move(record)).first;
+  }
+
+  memcpy(&info->block_size, it->second.data(), sizeof(uint32_t));
+  info->block_hashes = base::StringPiece(it->second).substr(sizeof(uint32_t));
+  return true;
+}
+
+bool Archive::VerifyRange(const FileInfo& info,
+                          uint64_t offset,
+                          uint64_t length) {
+  if (info.unpacked || info.block_size == 0 || length == 0)
+    return true;
+
+  uint64_t end = std::min<uint64_t>(offset + length, info.size);
+  if (offset >= end)
+    return true;
+
+  size_t block_count = (info.size + info.block_size - 1) / info.block_size;
+  if (info.block_hashes.size() != block_count * crypto::kSHA256Length) {
+    LOG(ERROR) << "Wrong number of block hashes in " << path_.value();
+    return false;
+  }
+
+  base::AutoLock auto_lock(integrity_lock_);
+  std::vector<bool>& verified = verified_blocks_[info.offset];
+  verified.resize(block_count);
+  for (size_t block = offset / info.block_size;
+       block <= (end - 1) / info.block_size; ++block) {
+    if (verified[block])
+      continue;
+
+    FileInfo block_info;
+    block_info.offset = info.offset + uint64_t(block) * info.block_size;
+    block_info.size = static_cast<uint32_t>(std::min<uint64_t>(
+        info.block_size, info.size - uint64_t(block) * info.block_size));
+    std::string buffer;
+    base::StringPiece content;
+    if (!ReadFileContent(block_info, &buffer, &content))
+      return false;
+
+    std::string hash = crypto::SHA256HashString(content);
+    if (info.block_hashes.substr(block * crypto::kSHA256Length,
+                                 crypto::kSHA256Length) != hash) {
+      LOG(ERROR) << "Integrity check failed for block " << block << " at "
+                 << info.offset << " in " << path_.value();
+      return false;
+    }
+    verified[block] = true;
+  }
+  return true;
+}
+
 int Archive::GetFD() const {
   return fd_;
 }
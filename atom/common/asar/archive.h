@@ -6,22 +6,29 @@
 #define ATOM_COMMON_ASAR_ARCHIVE_H_
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "base/files/file.h"
 #include "base/files/file_path.h"
+#include "base/files/scoped_file.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
 
 namespace base {
 class DictionaryValue;
+class MemoryMappedFile;
 }
 
 namespace asar {
 
+class ArchiveIndex;
 class ScopedTemporaryFile;
 
 // This class represents an asar package, and provides methods to read
-// information from it.
+// information from it. Once initialized it can be used from any thread.
 class Archive {
  public:
   struct FileInfo {
@@ -30,6 +37,15 @@ class Archive {
     bool executable;
     uint32_t size;
     uint64_t offset;
+    // The file is hashed in blocks of |block_size| bytes, |block_hashes| has
+    // the SHA-256 digest of each block. Both are empty when the archive does
+    // not carry integrity information.
+    uint32_t block_size = 0;
+    base::StringPiece block_hashes;
+    // For compressed files |size| is the number of bytes stored in the
+    // archive, and |uncompressed_size| the size of the real content.
+    bool compressed = false;
+    uint32_t uncompressed_size = 0;
   };
 
   struct Stats : public FileInfo {
@@ -42,9 +58,17 @@ class Archive {
   explicit Archive(const base::FilePath& path);
   virtual ~Archive();
 
-  // Read and parse the header.
+  // Read and parse the header, the binary index is used instead of the JSON
+  // header when the archive has one.
   bool Init();
 
+  // Use an index that was built by another process instead of calling Init().
+  bool InitFromIndex(std::unique_ptr<ArchiveIndex> index, uint32_t header_size);
+
+  // Gets the size and the modification time of the opened archive file, which
+  // identify its version.
+  bool GetArchiveFileInfo(base::File::Info* info);
+
   // Get the info of a file.
   bool GetFileInfo(const base::FilePath& path, FileInfo* info);
 
@@ -59,26 +83,128 @@ class Archive {
 
   // Copy the file into a temporary file, and return the new path.
   // For unpacked file, this method will return its real path.
+  // When an extraction cache directory is set, the file is only extracted
+  // once for each version of the archive and reused in later launches.
   bool CopyFileOut(const base::FilePath& path, base::FilePath* out);
 
+  // Returns the real path of an unpacked file, the path is computed once for
+  // each file and then cached.
+  base::FilePath GetUnpackedPath(const base::FilePath& path);
+
+  // The name of the extraction cache directory inside the user data
+  // directory.
+  static const base::FilePath::CharType kExtractionCacheDirectoryName[];
+
+  // Sets the directory where CopyFileOut keeps extracted files across
+  // launches, an empty path disables the cache.
+  static void SetExtractionCacheDirectory(const base::FilePath& path);
+  static base::FilePath GetExtractionCacheDirectory();
+
+  // Returns a view of the packed file's content inside the memory-mapped
+  // archive, the view is only valid while the Archive is alive.
+  // Returns false for unpacked files or when the archive can not be mapped.
+  // The content is not verified, callers must check it with VerifyRange.
+  bool GetFileContent(const FileInfo& info, base::StringPiece* content);
+
+  // Reads the whole content of a packed file, decompressing it if needed.
+  bool ReadFile(const FileInfo& info, std::string* contents);
+
+  // Checks the hashes of the blocks of a packed file that overlap the range,
+  // each block is only hashed once during the lifetime of the archive.
+  bool VerifyRange(const FileInfo& info, uint64_t offset, uint64_t length);
+
+  // Returns a digest of the header, which identifies the archive's version.
+  std::string GetHeaderDigest();
+
   // Returns the file's fd.
   int GetFD() const;
 
   base::FilePath path() const { return path_; }
+  // Returns nullptr when the archive is read through its binary index.
   base::DictionaryValue* header() const { return header_.get(); }
+  ArchiveIndex* index() const { return index_.get(); }
+  uint32_t header_size() const { return header_size_; }
 
  private:
+  // Maps the whole archive into memory on first use.
+  bool MapFile();
+
+  // Fills the integrity information of a file node in the JSON header,
+  // returns false when the node has a record that can not be read.
+  bool FillIntegrityWithNode(FileInfo* info, const base::DictionaryValue* node);
+
+  // Same with GetUnpackedPath, |lock_| must be held.
+  base::FilePath GetUnpackedPathLocked(const base::FilePath& path);
+
+  // Copies the file into the persistent extraction cache.
+  bool CopyFileToCache(const base::FilePath& path,
+                       const FileInfo& info,
+                       base::FilePath* out);
+
+  // Whether the file at |cached_path| is still the one extracted from the
+  // packed file, i.e. it has its size and the modification time |stamp|.
+  bool IsCachedFileValid(const FileInfo& info,
+                         const base::FilePath& cached_path,
+                         base::Time stamp);
+
+#if defined(OS_LINUX)
+  // Copies the file into an anonymous in-memory file.
+  bool CopyFileToMemory(const FileInfo& info, base::FilePath* out);
+#endif
+
+  // Reads the content of a packed file, from the mapping when possible.
+  bool ReadFileContent(const FileInfo& info,
+                       std::string* buffer,
+                       base::StringPiece* content);
+
+  // Same with ReadFileContent, but compressed files are decompressed.
+  bool ReadDecodedContent(const FileInfo& info,
+                          std::string* buffer,
+                          base::StringPiece* content);
+
   base::FilePath path_;
   base::File file_;
   int fd_ = -1;
   uint32_t header_size_ = 0;
   std::unique_ptr<base::DictionaryValue> header_;
+  std::unique_ptr<ArchiveIndex> index_;
+
+  // Guards |mapped_file_| and |map_failed_|.
+  base::Lock map_lock_;
+
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+  bool map_failed_ = false;
+
+  // Guards |block_hashes_| and |verified_blocks_|, keyed by file offset.
+  base::Lock integrity_lock_;
+  std::unordered_map<uint64_t, std::string> block_hashes_;
+  std::unordered_map<uint64_t, std::vector<bool>> verified_blocks_;
+
+  // Guards the extracted files below.
+  base::Lock lock_;
+
+  std::string header_digest_;
+
+  // Whether the extraction cache was pruned for this archive.
+  bool cache_pruned_ = false;
 
   // Cached external temporary files.
   std::unordered_map<base::FilePath::StringType,
                      std::unique_ptr<ScopedTemporaryFile>>
       external_files_;
 
+  // Files extracted into the cache directory or into memory, they are not
+  // removed when the archive is destroyed.
+  std::unordered_map<base::FilePath::StringType, base::FilePath>
+      extracted_files_;
+
+  // Real paths of the unpacked files.
+  std::unordered_map<base::FilePath::StringType, base::FilePath>
+      unpacked_files_;
+#if defined(OS_LINUX)
+  std::vector<base::ScopedFD> memory_files_;
+#endif
+
   DISALLOW_COPY_AND_ASSIGN(Archive);
 };
 
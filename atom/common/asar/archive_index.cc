@@ -0,0 +1,360 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/asar/archive_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "crypto/sha2.h"
+
+namespace asar {
+
+namespace {
+
+const uint32_t kIndexMagic = 0x58444941;  // "AIDX"
+const uint32_t kIndexVersion = 4;
+
+// Guards against link cycles.
+const int kMaxLinkDepth = 32;
+
+struct IndexHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entry_count;
+  uint32_t strings_size;
+};
+
+static_assert(sizeof(IndexHeader) == 16, "IndexHeader must be packed");
+static_assert(sizeof(ArchiveIndex::Entry) == 48, "Entry must be packed");
+
+}  // namespace
+
+bool ParseIntegrity(const base::DictionaryValue& node,
+                    uint32_t* block_size,
+                    std::string* block_hashes) {
+  const base::DictionaryValue* integrity = nullptr;
+  if (!node.GetDictionaryWithoutPathExpansion("integrity", &integrity))
+    return false;
+
+  std::string algorithm;
+  int size = 0;
+  const base::ListValue* blocks = nullptr;
+  if (!integrity->GetString("algorithm", &algorithm) ||
+      algorithm != "SHA256" || !integrity->GetInteger("blockSize", &size) ||
+      size <= 0 || !integrity->GetList("blocks", &blocks)) {
+    LOG(WARNING) << "Unsupported integrity record in asar header";
+    return false;
+  }
+
+  std::string hashes;
+  for (const base::Value& block : blocks->GetList()) {
+    // HexStringToBytes appends to its output, so each block is decoded on its
+    // own and must be a whole SHA-256 digest.
+    std::vector<uint8_t> digest;
+    if (!block.is_string() ||
+        !base::HexStringToBytes(block.GetString(), &digest) ||
+        digest.size() != crypto::kSHA256Length) {
+      LOG(WARNING) << "Invalid integrity block hash in asar header";
+      return false;
+    }
+    hashes.append(digest.begin(), digest.end());
+  }
+
+  *block_size = static_cast<uint32_t>(size);
+  block_hashes->swap(hashes);
+  return true;
+}
+
+bool ParseCompression(const base::DictionaryValue& node,
+                      bool* compressed,
+                      uint32_t* stored_size) {
+  const base::DictionaryValue* compression = nullptr;
+  *compressed =
+      node.GetDictionaryWithoutPathExpansion("compression", &compression);
+  if (!*compressed)
+    return true;
+
+  std::string algorithm;
+  int size = 0;
+  if (!compression->GetString("algorithm", &algorithm) ||
+      algorithm != "brotli" || !compression->GetInteger("size", &size) ||
+      size < 0) {
+    LOG(WARNING) << "Unsupported compression record in asar header";
+    return false;
+  }
+
+  *stored_size = static_cast<uint32_t>(size);
+  return true;
+}
+
+// static
+std::unique_ptr<ArchiveIndex> ArchiveIndex::Create(base::StringPiece data) {
+  std::unique_ptr<ArchiveIndex> index(new ArchiveIndex);
+  data.CopyToString(&index->owned_data_);
+  index->data_ = index->owned_data_;
+  if (!index->Init())
+    return nullptr;
+  return index;
+}
+
+// static
+std::unique_ptr<ArchiveIndex> ArchiveIndex::CreateFromSharedMemory(
+    base::ReadOnlySharedMemoryMapping mapping) {
+  if (!mapping.IsValid())
+    return nullptr;
+  std::unique_ptr<ArchiveIndex> index(new ArchiveIndex);
+  index->mapping_ = std::move(mapping);
+  index->data_ =
+      base::StringPiece(static_cast<const char*>(index->mapping_.memory()),
+                        index->mapping_.size());
+  if (!index->Init())
+    return nullptr;
+  return index;
+}
+
+// static
+std::string ArchiveIndex::Serialize(const base::DictionaryValue& header) {
+  struct PendingEntry {
+    std::string path;
+    std::string link;
+    std::string integrity;
+    Entry entry = {};
+  };
+  std::vector<PendingEntry> pending;
+
+  // Flatten the tree, directories are pushed before their children.
+  std::vector<std::pair<std::string, const base::DictionaryValue*>> stack;
+  stack.emplace_back(std::string(), &header);
+  while (!stack.empty()) {
+    std::string path = std::move(stack.back().first);
+    const base::DictionaryValue* node = stack.back().second;
+    stack.pop_back();
+
+    PendingEntry item;
+    item.path = path;
+    const base::DictionaryValue* files = nullptr;
+    if (node->GetStringWithoutPathExpansion("link", &item.link)) {
+      item.entry.flags |= kLink;
+    } else if (node->GetDictionaryWithoutPathExpansion("files", &files)) {
+      item.entry.flags |= kDirectory;
+      for (base::DictionaryValue::Iterator it(*files); !it.IsAtEnd();
+           it.Advance()) {
+        const base::DictionaryValue* child = nullptr;
+        if (!it.value().GetAsDictionary(&child))
+          continue;
+        stack.emplace_back(path.empty() ? it.key() : path + "/" + it.key(),
+                           child);
+      }
+    } else {
+      int size = 0;
+      node->GetInteger("size", &size);
+      item.entry.size = static_cast<uint32_t>(size);
+      bool flag = false;
+      if (node->GetBoolean("unpacked", &flag) && flag)
+        item.entry.flags |= kUnpacked;
+      if (node->GetBoolean("executable", &flag) && flag)
+        item.entry.flags |= kExecutable;
+      bool compressed = false;
+      uint32_t stored_size;
+      if (!ParseCompression(*node, &compressed, &stored_size)) {
+        item.entry.flags |= kUnknownCompression;
+      } else if (compressed) {
+        item.entry.flags |= kBrotli;
+        item.entry.uncompressed_size = item.entry.size;
+        item.entry.size = stored_size;
+      }
+      std::string offset;
+      if (node->GetString("offset", &offset))
+        base::StringToUint64(offset, &item.entry.offset);
+      uint32_t block_size;
+      std::string block_hashes;
+      if (ParseIntegrity(*node, &block_size, &block_hashes)) {
+        item.integrity.assign(reinterpret_cast<const char*>(&block_size),
+                              sizeof(block_size));
+        item.integrity += block_hashes;
+      } else if (node->FindKey("integrity")) {
+        item.entry.flags |= kInvalidIntegrity;
+      }
+    }
+    pending.push_back(std::move(item));
+  }
+
+  std::sort(pending.begin(), pending.end(),
+            [](const PendingEntry& a, const PendingEntry& b) {
+              return a.path < b.path;
+            });
+
+  std::string strings;
+  for (PendingEntry& item : pending) {
+    item.entry.path_offset = static_cast<uint32_t>(strings.size());
+    item.entry.path_length = static_cast<uint32_t>(item.path.size());
+    strings += item.path;
+    item.entry.link_offset = static_cast<uint32_t>(strings.size());
+    item.entry.link_length = static_cast<uint32_t>(item.link.size());
+    strings += item.link;
+    item.entry.integrity_offset = static_cast<uint32_t>(strings.size());
+    item.entry.integrity_length = static_cast<uint32_t>(item.integrity.size());
+    strings += item.integrity;
+  }
+
+  IndexHeader index_header;
+  index_header.magic = kIndexMagic;
+  index_header.version = kIndexVersion;
+  index_header.entry_count = static_cast<uint32_t>(pending.size());
+  index_header.strings_size = static_cast<uint32_t>(strings.size());
+
+  std::string result;
+  result.reserve(sizeof(IndexHeader) + pending.size() * sizeof(Entry) +
+                 strings.size());
+  result.append(reinterpret_cast<const char*>(&index_header),
+                sizeof(index_header));
+  for (const PendingEntry& item : pending)
+    result.append(reinterpret_cast<const char*>(&item.entry), sizeof(Entry));
+  result += strings;
+  return result;
+}
+
+ArchiveIndex::ArchiveIndex() {}
+
+ArchiveIndex::~ArchiveIndex() {}
+
+bool ArchiveIndex::Init() {
+  if (data_.size() < sizeof(IndexHeader))
+    return false;
+
+  // |data_| is either heap allocated or page aligned, so the header and
+  // entries are aligned.
+  const auto* header = reinterpret_cast<const IndexHeader*>(data_.data());
+  if (header->magic != kIndexMagic || header->version != kIndexVersion)
+    return false;
+
+  uint64_t expected_size = sizeof(IndexHeader) +
+                           uint64_t(header->entry_count) * sizeof(Entry) +
+                           header->strings_size;
+  if (expected_size != data_.size())
+    return false;
+
+  entries_ =
+      reinterpret_cast<const Entry*>(data_.data() + sizeof(IndexHeader));
+  entry_count_ = header->entry_count;
+  strings_ = reinterpret_cast<const char*>(entries_ + entry_count_);
+  strings_size_ = header->strings_size;
+
+  for (size_t i = 0; i < entry_count_; ++i) {
+    const Entry& entry = entries_[i];
+    if (uint64_t(entry.path_offset) + entry.path_length > strings_size_ ||
+        uint64_t(entry.link_offset) + entry.link_length > strings_size_ ||
+        uint64_t(entry.integrity_offset) + entry.integrity_length >
+            strings_size_)
+      return false;
+    if (i > 0 && !(GetPath(entries_[i - 1]) < GetPath(entry))) {
+      LOG(ERROR) << "Entries of asar index are not sorted";
+      return false;
+    }
+  }
+
+  // The root directory must exist.
+  return entry_count_ > 0 && GetPath(entries_[0]).empty();
+}
+
+const ArchiveIndex::Entry* ArchiveIndex::Find(base::StringPiece path) const {
+  const Entry* entry = Lookup(path);
+  if (entry)
+    return entry;
+
+  // Replace the deepest parent directory that is a link with its target and
+  // try again, only allocate when there is a link to resolve.
+  std::string resolved;
+  for (int depth = 0; depth < kMaxLinkDepth; ++depth) {
+    base::StringPiece current = resolved.empty() ? path : resolved;
+    bool replaced = false;
+    for (size_t pos = current.rfind('/');
+         pos != base::StringPiece::npos && pos > 0;
+         pos = current.rfind('/', pos - 1)) {
+      const Entry* parent = Lookup(current.substr(0, pos));
+      if (!parent)
+        continue;
+      if (!(parent->flags & kLink))
+        return nullptr;
+      std::string target = GetLink(*parent).as_string();
+      current.substr(pos).AppendToString(&target);
+      resolved.swap(target);
+      replaced = true;
+      break;
+    }
+    if (!replaced)
+      return nullptr;
+
+    entry = Lookup(resolved);
+    if (entry)
+      return entry;
+  }
+
+  return nullptr;
+}
+
+bool ArchiveIndex::ListChildren(const Entry* entry,
+                                std::vector<std::string>* names) const {
+  if (entry->flags & kLink)
+    entry = Find(GetLink(*entry));
+  if (!entry || !(entry->flags & kDirectory))
+    return false;
+
+  std::string prefix = GetPath(*entry).as_string();
+  if (!prefix.empty())
+    prefix.push_back('/');
+
+  const Entry* end = entries_ + entry_count_;
+  const Entry* it = std::lower_bound(
+      entries_, end, base::StringPiece(prefix),
+      [this](const Entry& e, base::StringPiece p) { return GetPath(e) < p; });
+  for (; it != end; ++it) {
+    base::StringPiece child = GetPath(*it);
+    if (!child.starts_with(prefix))
+      break;
+    child.remove_prefix(prefix.size());
+    // Skip the root itself and grandchildren.
+    if (child.empty() || child.find('/') != base::StringPiece::npos)
+      continue;
+    names->push_back(child.as_string());
+  }
+  return true;
+}
+
+base::StringPiece ArchiveIndex::GetPath(const Entry& entry) const {
+  return base::StringPiece(strings_ + entry.path_offset, entry.path_length);
+}
+
+base::StringPiece ArchiveIndex::GetLink(const Entry& entry) const {
+  return base::StringPiece(strings_ + entry.link_offset, entry.link_length);
+}
+
+bool ArchiveIndex::GetIntegrity(const Entry& entry,
+                                uint32_t* block_size,
+                                base::StringPiece* block_hashes) const {
+  if (entry.integrity_length < sizeof(uint32_t))
+    return false;
+  memcpy(block_size, strings_ + entry.integrity_offset, sizeof(uint32_t));
+  *block_hashes =
+      base::StringPiece(strings_ + entry.integrity_offset + sizeof(uint32_t),
+                        entry.integrity_length - sizeof(uint32_t));
+  return *block_size > 0;
+}
+
+const ArchiveIndex::Entry* ArchiveIndex::Lookup(base::StringPiece path) const {
+  const Entry* end = entries_ + entry_count_;
+  const Entry* it = std::lower_bound(
+      entries_, end, path,
+      [this](const Entry& e, base::StringPiece p) { return GetPath(e) < p; });
+  if (it == end || GetPath(*it) != path)
+    return nullptr;
+  return it;
+}
+
+}  // namespace asar
@@ -0,0 +1,133 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_ASAR_ARCHIVE_INDEX_H_
+#define ATOM_COMMON_ASAR_ARCHIVE_INDEX_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+class DictionaryValue;
+}
+
+namespace asar {
+
+// A flat table of all the entries in an archive, which can be searched
+// without parsing the JSON header.
+//
+// The index is stored in the header pickle right after the JSON string, so
+// older versions of Electron simply ignore it. All integers are little-endian:
+//
+//   uint32 magic ("AIDX") | uint32 version | uint32 entry count |
+//   uint32 string table size | Entry[entry count] | string table
+//
+// Entries are sorted by the bytewise order of their UTF-8 paths, which are
+// relative to the archive root and separated by '/'. The root directory is
+// the entry with an empty path. The integrity record of a file, when present,
+// is a uint32 block size followed by the SHA-256 digest of each block.
+class ArchiveIndex {
+ public:
+  enum Flags : uint32_t {
+    kDirectory = 1 << 0,
+    kLink = 1 << 1,
+    kUnpacked = 1 << 2,
+    kExecutable = 1 << 3,
+    // The content is compressed with brotli.
+    kBrotli = 1 << 4,
+    // The content is compressed with an algorithm that can not be read.
+    kUnknownCompression = 1 << 5,
+    // The integrity record can not be read, so the content is never trusted.
+    kInvalidIntegrity = 1 << 6,
+  };
+
+  struct Entry {
+    uint32_t path_offset;
+    uint32_t path_length;
+    uint32_t flags;
+    uint32_t size;
+    // Offset of the content, relative to the end of the header.
+    uint64_t offset;
+    uint32_t link_offset;
+    uint32_t link_length;
+    uint32_t integrity_offset;
+    uint32_t integrity_length;
+    // Size of the content after decompression.
+    uint32_t uncompressed_size;
+    uint32_t reserved;
+  };
+
+  // Returns nullptr if |data| is not a valid index.
+  static std::unique_ptr<ArchiveIndex> Create(base::StringPiece data);
+
+  // Same with Create but reads the index in place from shared memory.
+  static std::unique_ptr<ArchiveIndex> CreateFromSharedMemory(
+      base::ReadOnlySharedMemoryMapping mapping);
+
+  // Builds the index out of a parsed JSON header.
+  static std::string Serialize(const base::DictionaryValue& header);
+
+  ~ArchiveIndex();
+
+  // Returns the entry of |path|, with links in parent directories resolved.
+  const Entry* Find(base::StringPiece path) const;
+
+  // Lists the names of the direct children of directory |entry|.
+  bool ListChildren(const Entry* entry, std::vector<std::string>* names) const;
+
+  base::StringPiece GetPath(const Entry& entry) const;
+  base::StringPiece GetLink(const Entry& entry) const;
+
+  // Returns false if the entry has no integrity record.
+  bool GetIntegrity(const Entry& entry,
+                    uint32_t* block_size,
+                    base::StringPiece* block_hashes) const;
+
+  // The raw index, can be used to recreate the index in another process.
+  base::StringPiece data() const { return data_; }
+
+ private:
+  ArchiveIndex();
+
+  // Checks the layout of |data_| and sets up the tables.
+  bool Init();
+
+  // Binary searches |path| without resolving links.
+  const Entry* Lookup(base::StringPiece path) const;
+
+  // |data_| points into either |owned_data_| or |mapping_|.
+  base::StringPiece data_;
+  std::string owned_data_;
+  base::ReadOnlySharedMemoryMapping mapping_;
+
+  const Entry* entries_ = nullptr;
+  size_t entry_count_ = 0;
+  const char* strings_ = nullptr;
+  size_t strings_size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ArchiveIndex);
+};
+
+// Reads the "integrity" record of a file node in the JSON header, the block
+// hashes are returned as raw SHA-256 digests.
+bool ParseIntegrity(const base::DictionaryValue& node,
+                    uint32_t* block_size,
+                    std::string* block_hashes);
+
+// Reads the "compression" record of a file node in the JSON header, whose
+// "size" is the size of the content before compression. |compressed| is set
+// to whether the node has the record, false is returned if the record can not
+// be read, in which case the content can not be read either.
+bool ParseCompression(const base::DictionaryValue& node,
+                      bool* compressed,
+                      uint32_t* stored_size);
+
+}  // namespace asar
+
+#endif  // ATOM_COMMON_ASAR_ARCHIVE_INDEX_H_
@@ -0,0 +1,222 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+// Measures the asar archive code on synthetic archives and prints the results
+// as JSON, see docs/development/testing.md. The options are:
+//
+//   --max-files=<count>  skip the archives with more files than count
+//   --output=<file>      write the JSON results to the file instead of stdout
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "atom/common/asar/archive.h"
+#include "atom/common/asar/asar_util.h"
+#include "base/at_exit.h"
+#include "base/command_line.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/task_scheduler/task_scheduler.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace {
+
+const int kArchiveSizes[] = {1000, 10000, 100000};
+const int kFilesPerDirectory = 100;
+const int kLargeFileSize = 16 * 1024 * 1024;
+// The lookups are made in batches, so the loop of Measure() is not what is
+// timed.
+const int kLookupsPerIteration = 1000;
+
+base::FilePath GetFilePath(int index) {
+  return base::FilePath()
+      .AppendASCII(base::StringPrintf("dir%d", index / kFilesPerDirectory))
+      .AppendASCII(base::StringPrintf("file%d.js", index));
+}
+
+// Writes an archive with |file_count| small files and |large.bin|, and
+// returns the size of its header.
+uint32_t CreateArchive(const base::FilePath& path, int file_count) {
+  base::DictionaryValue root;
+  std::string content;
+  for (int i = 0; i < file_count; ++i) {
+    std::string data = base::StringPrintf("module.exports = %d\n", i);
+    auto file = std::make_unique<base::DictionaryValue>();
+    file->SetInteger("size", static_cast<int>(data.size()));
+    file->SetString("offset", base::NumberToString(content.size()));
+    content += data;
+
+    std::string dir =
+        base::StringPrintf("files.dir%d.files", i / kFilesPerDirectory);
+    std::string name = base::StringPrintf("file%d.js", i);
+    base::DictionaryValue* files;
+    if (!root.GetDictionary(dir, &files)) {
+      files =
+          root.SetDictionary(dir, std::make_unique<base::DictionaryValue>());
+    }
+    files->SetWithoutPathExpansion(name, std::move(file));
+  }
+  auto large = std::make_unique<base::DictionaryValue>();
+  large->SetInteger("size", kLargeFileSize);
+  large->SetString("offset", base::NumberToString(content.size()));
+  content.append(kLargeFileSize, 'x');
+  base::DictionaryValue* files;
+  CHECK(root.GetDictionary("files", &files));
+  files->SetWithoutPathExpansion("large.bin", std::move(large));
+
+  // The header is a Pickle holding the JSON string, preceded by a Pickle
+  // holding the size of the first one.
+  std::string json;
+  CHECK(base::JSONWriter::Write(root, &json));
+  base::Pickle header_pickle;
+  header_pickle.WriteString(json);
+  base::Pickle size_pickle;
+  size_pickle.WriteUInt32(static_cast<uint32_t>(header_pickle.size()));
+
+  base::File file(path,
+                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  CHECK(file.IsValid());
+  CHECK(file.WriteAtCurrentPos(static_cast<const char*>(size_pickle.data()),
+                               size_pickle.size()) >= 0);
+  CHECK(file.WriteAtCurrentPos(static_cast<const char*>(header_pickle.data()),
+                               header_pickle.size()) >= 0);
+  CHECK(file.WriteAtCurrentPos(content.data(), content.size()) ==
+        static_cast<int>(content.size()));
+  return static_cast<uint32_t>(size_pickle.size() + header_pickle.size());
+}
+
+// Calls |fn| until a second has elapsed, the first calls are not measured.
+template <typename Fn>
+std::unique_ptr<base::DictionaryValue> Measure(const std::string& name,
+                                               int file_count,
+                                               double ops_per_call,
+                                               const Fn& fn) {
+  for (int i = 0; i < 3; ++i)
+    fn();
+
+  int iterations = 0;
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::TimeDelta elapsed;
+  while (elapsed < base::TimeDelta::FromSeconds(1)) {
+    fn();
+    ++iterations;
+    elapsed = base::TimeTicks::Now() - start;
+  }
+
+  auto result = std::make_unique<base::DictionaryValue>();
+  result->SetString("suite", "asar-native");
+  result->SetString("name", base::StringPrintf("%s (%d files)", name.c_str(),
+                                               file_count));
+  result->SetInteger("files", file_count);
+  result->SetInteger("iterations", iterations);
+  result->SetDouble("totalMs", elapsed.InMillisecondsF());
+  result->SetDouble("opsPerSecond",
+                    iterations * ops_per_call / elapsed.InSecondsF());
+  return result;
+}
+
+void MeasureArchive(const base::FilePath& path,
+                    int file_count,
+                    base::ListValue* results) {
+  uint32_t header_size = CreateArchive(path, file_count);
+
+  auto init = Measure("Archive::Init", file_count, 1, [&path]() {
+    asar::Archive archive(path);
+    CHECK(archive.Init());
+  });
+  init->SetInteger("headerSize", header_size);
+  results->Append(std::move(init));
+
+  asar::Archive archive(path);
+  CHECK(archive.Init());
+  std::vector<base::FilePath> files;
+  for (int i = 0; i < kLookupsPerIteration; ++i)
+    files.push_back(GetFilePath(static_cast<int64_t>(i) * 7919 % file_count));
+
+  results->Append(Measure("Archive::GetFileInfo", file_count,
+                          kLookupsPerIteration, [&archive, &files]() {
+                            asar::Archive::FileInfo info;
+                            for (const auto& file : files)
+                              CHECK(archive.GetFileInfo(file, &info));
+                          }));
+  results->Append(Measure("Archive::Stat", file_count, kLookupsPerIteration,
+                          [&archive, &files]() {
+                            asar::Archive::Stats stats;
+                            for (const auto& file : files)
+                              CHECK(archive.Stat(file, &stats));
+                          }));
+  results->Append(Measure(
+      "Archive::Readdir", file_count, 1, [&archive, &files]() {
+        std::vector<base::FilePath> entries;
+        CHECK(archive.Readdir(base::FilePath(), &entries));
+        entries.clear();
+        CHECK(archive.Readdir(files[0].DirName(), &entries));
+      }));
+
+  // Goes through the archive cache, like the file:// and asar:// requests.
+  auto read = Measure("asar::ReadFileToString", file_count, 1, [&path]() {
+    std::string contents;
+    CHECK(asar::ReadFileToString(
+        path.Append(FILE_PATH_LITERAL("large.bin")), &contents));
+  });
+  double ops_per_second;
+  CHECK(read->GetDouble("opsPerSecond", &ops_per_second));
+  read->SetDouble("bytesPerSecond", ops_per_second * kLargeFileSize);
+  results->Append(std::move(read));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  base::AtExitManager at_exit;
+  base::CommandLine::Init(argc, argv);
+  base::TaskScheduler::CreateAndStartWithDefaultParams("AsarBenchmark");
+
+  const auto* command_line = base::CommandLine::ForCurrentProcess();
+  int max_files = kArchiveSizes[arraysize(kArchiveSizes) - 1];
+  if (command_line->HasSwitch("max-files"))
+    base::StringToInt(command_line->GetSwitchValueASCII("max-files"),
+                      &max_files);
+
+  base::ScopedTempDir temp_dir;
+  CHECK(temp_dir.CreateUniqueTempDir());
+  auto results = std::make_unique<base::ListValue>();
+  for (int file_count : kArchiveSizes) {
+    if (file_count > max_files)
+      continue;
+    base::FilePath path = temp_dir.GetPath().AppendASCII(
+        base::StringPrintf("archive-%d.asar", file_count));
+    MeasureArchive(path, file_count, results.get());
+  }
+  asar::ClearArchives();
+
+  base::DictionaryValue output;
+  output.Set("results", std::move(results));
+  std::string json;
+  base::JSONWriter::WriteWithOptions(
+      output, base::JSONWriter::OPTIONS_PRETTY_PRINT, &json);
+
+  base::FilePath output_path = command_line->GetSwitchValuePath("output");
+  if (output_path.empty()) {
+    fputs(json.c_str(), stdout);
+  } else if (base::WriteFile(output_path, json.data(), json.size()) < 0) {
+    LOG(ERROR) << "Unable to write " << output_path.value();
+    return 1;
+  }
+
+  base::TaskScheduler::GetInstance()->Shutdown();
+  return 0;
+}
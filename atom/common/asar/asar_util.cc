@@ -6,43 +6,133 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "atom/common/asar/archive.h"
+#include "atom/common/asar/archive_index.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/lazy_instance.h"
-#include "base/stl_util.h"
-#include "base/threading/thread_local.h"
+#include "base/synchronization/lock.h"
 
 namespace asar {
 
 namespace {
 
-// The global instance of ArchiveMap, will be destroyed on exit.
-typedef std::map<base::FilePath, std::shared_ptr<Archive>> ArchiveMap;
-base::LazyInstance<base::ThreadLocalPointer<ArchiveMap>>::Leaky
-    g_archive_map_tls = LAZY_INSTANCE_INITIALIZER;
+struct CachedArchive {
+  std::shared_ptr<Archive> archive;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+};
+
+SharedIndexProvider g_shared_index_provider = nullptr;
+
+bool InitFromSharedIndex(Archive* archive) {
+  base::File::Info info;
+  uint32_t header_size = 0;
+  if (!g_shared_index_provider || !archive->GetArchiveFileInfo(&info))
+    return false;
+  std::unique_ptr<ArchiveIndex> index =
+      g_shared_index_provider(archive->path(), info.size,
+                              info.last_modified.ToInternalValue(),
+                              &header_size);
+  return index && archive->InitFromIndex(std::move(index), header_size);
+}
+
+// The process-wide cache of parsed archives, shared by all threads. Archives
+// are immutable once initialized so they can be used from any thread.
+class ArchiveCache {
+ public:
+  ArchiveCache() {}
+
+  std::shared_ptr<Archive> GetOrCreate(const base::FilePath& path) {
+    {
+      base::AutoLock auto_lock(lock_);
+      auto it = archives_.find(path);
+      if (it != archives_.end() && it->second.archive) {
+        ++it->second.hits;
+        return it->second.archive;
+      }
+    }
+
+    // Parse the header without holding the lock, so other threads are not
+    // blocked by the disk read. Paths that are not valid archives are not
+    // cached, so they do not pile up.
+    auto archive = std::make_shared<Archive>(path);
+    if (!InitFromSharedIndex(archive.get()) && !archive->Init())
+      return nullptr;
+
+    base::AutoLock auto_lock(lock_);
+    CachedArchive& cached = archives_[path];
+    ++cached.misses;
+    // Another thread might have won the race.
+    if (!cached.archive)
+      cached.archive = std::move(archive);
+    return cached.archive;
+  }
+
+  std::vector<std::shared_ptr<Archive>> GetArchives() {
+    base::AutoLock auto_lock(lock_);
+    std::vector<std::shared_ptr<Archive>> result;
+    for (const auto& it : archives_) {
+      if (it.second.archive)
+        result.push_back(it.second.archive);
+    }
+    return result;
+  }
+
+  void Clear() {
+    base::AutoLock auto_lock(lock_);
+    archives_.clear();
+  }
+
+  std::vector<ArchiveCacheStats> GetStats() {
+    base::AutoLock auto_lock(lock_);
+    std::vector<ArchiveCacheStats> result;
+    for (const auto& it : archives_) {
+      ArchiveCacheStats stats;
+      stats.path = it.first;
+      stats.hits = it.second.hits;
+      stats.misses = it.second.misses;
+      result.push_back(stats);
+    }
+    return result;
+  }
+
+ private:
+  base::Lock lock_;
+  std::map<base::FilePath, CachedArchive> archives_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArchiveCache);
+};
+
+// The global instance of ArchiveCache, will be destroyed on exit.
+base::LazyInstance<ArchiveCache>::Leaky g_archive_cache =
+    LAZY_INSTANCE_INITIALIZER;
 
 const base::FilePath::CharType kAsarExtension[] = FILE_PATH_LITERAL(".asar");
 
 }  // namespace
 
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
-  if (!g_archive_map_tls.Pointer()->Get())
-    g_archive_map_tls.Pointer()->Set(new ArchiveMap);
-  ArchiveMap& archive_map = *g_archive_map_tls.Pointer()->Get();
-  if (!ContainsKey(archive_map, path)) {
-    std::shared_ptr<Archive> archive(new Archive(path));
-    if (!archive->Init())
-      return nullptr;
-    archive_map[path] = archive;
-  }
-  return archive_map[path];
+  return g_archive_cache.Get().GetOrCreate(path);
 }
 
 void ClearArchives() {
-  if (g_archive_map_tls.Pointer()->Get())
-    delete g_archive_map_tls.Pointer()->Get();
+  g_archive_cache.Get().Clear();
+}
+
+std::vector<ArchiveCacheStats> GetArchiveCacheStats() {
+  return g_archive_cache.Get().GetStats();
+}
+
+std::vector<std::shared_ptr<Archive>> GetCachedArchives() {
+  return g_archive_cache.Get().GetArchives();
+}
+
+void SetSharedIndexProvider(SharedIndexProvider provider) {
+  g_shared_index_provider = provider;
 }
 
 bool GetAsarArchivePath(const base::FilePath& full_path,
@@ -87,14 +177,7 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
     return base::ReadFileToString(real_path, contents);
   }
 
-  base::File src(asar_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
-  if (!src.IsValid())
-    return false;
-
-  contents->resize(info.size);
-  return static_cast<int>(info.size) ==
-         src.Read(info.offset, const_cast<char*>(contents->data()),
-                  contents->size());
+  return archive->ReadFile(info, contents);
 }
 
 }  // namespace asar
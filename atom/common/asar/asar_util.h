@@ -5,23 +5,53 @@
 #ifndef ATOM_COMMON_ASAR_ASAR_UTIL_H_
 #define ATOM_COMMON_ASAR_ASAR_UTIL_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
+#include <vector>
 
-namespace base {
-class FilePath;
-}
+#include "base/files/file_path.h"
 
 namespace asar {
 
 class Archive;
+class ArchiveIndex;
+
+struct ArchiveCacheStats {
+  base::FilePath path;
+  // Number of times the parsed archive was reused.
+  uint64_t hits = 0;
+  // Number of times the archive had to be opened and parsed.
+  uint64_t misses = 0;
+};
 
-// Gets or creates a new Archive from the path.
+// Gets or creates a new Archive from the path, the archive is shared by all
+// threads of the process.
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path);
 
 // Destroy cached Archive objects.
 void ClearArchives();
 
+// Returns the hit and miss counters of each cached archive.
+std::vector<ArchiveCacheStats> GetArchiveCacheStats();
+
+// Returns all the archives that have been successfully parsed.
+std::vector<std::shared_ptr<Archive>> GetCachedArchives();
+
+// Returns the index that another process built for the version of the
+// archive at |path| identified by |size| and |last_modified|, or nullptr.
+using SharedIndexProvider =
+    std::unique_ptr<ArchiveIndex> (*)(const base::FilePath& path,
+                                      int64_t size,
+                                      int64_t last_modified,
+                                      uint32_t* header_size);
+
+// Makes the archives that are not cached yet use the index of |provider|
+// instead of parsing their header, when it has one. Must be called before
+// any archive is opened.
+void SetSharedIndexProvider(SharedIndexProvider provider);
+
 // Separates the path to Archive out.
 bool GetAsarArchivePath(const base::FilePath& full_path,
                         base::FilePath* asar_path,
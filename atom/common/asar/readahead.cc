@@ -0,0 +1,277 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/asar/readahead.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/bind.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/pickle.h"
+#include "base/synchronization/lock.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/threading/platform_thread.h"
+
+#if defined(OS_WIN)
+#include <windows.h>
+
+#include "base/files/memory_mapped_file.h"
+#elif defined(OS_POSIX)
+#include <fcntl.h>
+#endif
+
+namespace asar {
+
+namespace {
+
+const int kManifestVersion = 1;
+
+// Ranges that are closer than this are read ahead as a single range, which
+// turns the small reads of neighbouring files into sequential I/O.
+const uint64_t kMergeGap = 64 * 1024;
+
+// Bounds the memory used by a recording.
+const size_t kMaxRecordedReads = 10000;
+
+struct Range {
+  uint64_t offset;
+  uint64_t size;
+};
+
+struct ReadRecording {
+  base::Lock lock;
+  base::TimeTicks deadline;
+  size_t count = 0;
+  std::map<base::FilePath, std::vector<Range>> reads;
+};
+
+base::LazyInstance<ReadRecording>::Leaky g_recording =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Checked without the lock so reads are cheap when nothing is recorded.
+base::subtle::Atomic32 g_recording_active = 0;
+
+void MergeRanges(std::vector<Range>* ranges) {
+  std::sort(ranges->begin(), ranges->end(),
+            [](const Range& a, const Range& b) { return a.offset < b.offset; });
+
+  std::vector<Range> merged;
+  for (const Range& range : *ranges) {
+    if (!merged.empty() &&
+        range.offset <= merged.back().offset + merged.back().size + kMergeGap) {
+      uint64_t end = std::max(merged.back().offset + merged.back().size,
+                              range.offset + range.size);
+      merged.back().size = end - merged.back().offset;
+    } else {
+      merged.push_back(range);
+    }
+  }
+  ranges->swap(merged);
+}
+
+void ReadAhead(base::File file, const std::vector<Range>& ranges) {
+#if defined(OS_LINUX)
+  for (const Range& range : ranges)
+    posix_fadvise(file.GetPlatformFile(), range.offset, range.size,
+                  POSIX_FADV_WILLNEED);
+#elif defined(OS_MACOSX)
+  for (const Range& range : ranges) {
+    struct radvisory advice;
+    advice.ra_offset = range.offset;
+    advice.ra_count = static_cast<int>(
+        std::min<uint64_t>(range.size, std::numeric_limits<int>::max()));
+    fcntl(file.GetPlatformFile(), F_RDADVISE, &advice);
+  }
+#elif defined(OS_WIN)
+  // PrefetchVirtualMemory is only available since Windows 8.
+  static auto* prefetch_virtual_memory =
+      reinterpret_cast<decltype(&::PrefetchVirtualMemory)>(::GetProcAddress(
+          ::GetModuleHandle(L"kernel32.dll"), "PrefetchVirtualMemory"));
+  if (!prefetch_virtual_memory)
+    return;
+
+  base::MemoryMappedFile mapped_file;
+  if (!mapped_file.Initialize(std::move(file)))
+    return;
+
+  std::vector<WIN32_MEMORY_RANGE_ENTRY> entries;
+  for (const Range& range : ranges) {
+    WIN32_MEMORY_RANGE_ENTRY entry;
+    entry.VirtualAddress =
+        const_cast<uint8_t*>(mapped_file.data() + range.offset);
+    entry.NumberOfBytes = static_cast<SIZE_T>(range.size);
+    entries.push_back(entry);
+  }
+  prefetch_virtual_memory(::GetCurrentProcess(), entries.size(),
+                          entries.data(), 0);
+#endif
+}
+
+void PrefetchManifest(const base::FilePath& manifest_path) {
+  std::string data;
+  if (!base::ReadFileToString(manifest_path, &data))
+    return;
+
+  base::Pickle pickle(data.data(), static_cast<int>(data.size()));
+  base::PickleIterator iter(pickle);
+  int version;
+  uint32_t archive_count;
+  if (!iter.ReadInt(&version) || version != kManifestVersion ||
+      !iter.ReadUInt32(&archive_count))
+    return;
+
+  for (uint32_t i = 0; i < archive_count; ++i) {
+    std::string path;
+    int64_t size, last_modified;
+    uint32_t range_count;
+    if (!iter.ReadString(&path) || !iter.ReadInt64(&size) ||
+        !iter.ReadInt64(&last_modified) || !iter.ReadUInt32(&range_count))
+      return;
+
+    std::vector<Range> ranges;
+    for (uint32_t j = 0; j < range_count; ++j) {
+      Range range;
+      if (!iter.ReadUInt64(&range.offset) || !iter.ReadUInt64(&range.size))
+        return;
+      // Ignore ranges that do not fit in the archive.
+      if (range.offset <= static_cast<uint64_t>(size) &&
+          range.size <= static_cast<uint64_t>(size) - range.offset)
+        ranges.push_back(range);
+    }
+
+    // The recorded ranges are useless once the archive has been replaced.
+    base::File file(base::FilePath::FromUTF8Unsafe(path),
+                    base::File::FLAG_OPEN | base::File::FLAG_READ);
+    base::File::Info info;
+    if (!file.IsValid() || !file.GetInfo(&info) || info.size != size ||
+        info.last_modified.ToInternalValue() != last_modified)
+      continue;
+
+    ReadAhead(std::move(file), ranges);
+  }
+}
+
+void WriteManifest(const base::FilePath& manifest_path) {
+  std::map<base::FilePath, std::vector<Range>> reads;
+  {
+    ReadRecording& recording = g_recording.Get();
+    base::AutoLock auto_lock(recording.lock);
+    base::subtle::NoBarrier_Store(&g_recording_active, 0);
+    reads.swap(recording.reads);
+  }
+
+  // Keep the manifest of the last launch when nothing was read.
+  if (reads.empty())
+    return;
+
+  base::Pickle pickle;
+  pickle.WriteInt(kManifestVersion);
+  std::vector<std::pair<base::FilePath, base::File::Info>> archives;
+  for (const auto& it : reads) {
+    base::File::Info info;
+    if (base::GetFileInfo(it.first, &info))
+      archives.emplace_back(it.first, info);
+  }
+  pickle.WriteUInt32(static_cast<uint32_t>(archives.size()));
+  for (const auto& archive : archives) {
+    std::vector<Range>& ranges = reads[archive.first];
+    MergeRanges(&ranges);
+    pickle.WriteString(archive.first.AsUTF8Unsafe());
+    pickle.WriteInt64(archive.second.size);
+    pickle.WriteInt64(archive.second.last_modified.ToInternalValue());
+    pickle.WriteUInt32(static_cast<uint32_t>(ranges.size()));
+    for (const Range& range : ranges) {
+      pickle.WriteUInt64(range.offset);
+      pickle.WriteUInt64(range.size);
+    }
+  }
+
+  if (!base::CreateDirectory(manifest_path.DirName()) ||
+      !base::ImportantFileWriter::WriteFileAtomically(
+          manifest_path,
+          base::StringPiece(static_cast<const char*>(pickle.data()),
+                            pickle.size())))
+    LOG(WARNING) << "Failed to write " << manifest_path.value();
+}
+
+// Reads ahead on a thread of its own, since it starts before the main script
+// is loaded and the task scheduler only runs tasks after that.
+class PrefetchThread : public base::PlatformThread::Delegate {
+ public:
+  explicit PrefetchThread(const base::FilePath& manifest_path)
+      : manifest_path_(manifest_path) {}
+
+  void ThreadMain() override {
+    base::PlatformThread::SetName("AsarReadahead");
+    PrefetchManifest(manifest_path_);
+
+    // The manifest has been read, it is replaced by the recording of this
+    // launch once the recording ends.
+    base::TimeDelta remaining;
+    {
+      ReadRecording& recording = g_recording.Get();
+      base::AutoLock auto_lock(recording.lock);
+      if (!recording.deadline.is_null())
+        remaining = recording.deadline - base::TimeTicks::Now();
+    }
+    base::PostDelayedTaskWithTraits(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::BACKGROUND,
+         base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+        base::BindOnce(&WriteManifest, manifest_path_),
+        std::max(remaining, base::TimeDelta()));
+    delete this;
+  }
+
+ private:
+  base::FilePath manifest_path_;
+
+  DISALLOW_COPY_AND_ASSIGN(PrefetchThread);
+};
+
+}  // namespace
+
+void StartReadRecording(base::TimeDelta duration) {
+  ReadRecording& recording = g_recording.Get();
+  base::AutoLock auto_lock(recording.lock);
+  recording.deadline = base::TimeTicks::Now() + duration;
+  base::subtle::NoBarrier_Store(&g_recording_active, 1);
+}
+
+void RecordRead(const base::FilePath& path, uint64_t offset, uint64_t size) {
+  if (!base::subtle::NoBarrier_Load(&g_recording_active))
+    return;
+
+  ReadRecording& recording = g_recording.Get();
+  base::AutoLock auto_lock(recording.lock);
+  if (base::TimeTicks::Now() > recording.deadline) {
+    base::subtle::NoBarrier_Store(&g_recording_active, 0);
+    return;
+  }
+  if (recording.count >= kMaxRecordedReads)
+    return;
+  recording.reads[path].push_back({offset, size});
+  ++recording.count;
+}
+
+void PrefetchRecordedReads(const base::FilePath& manifest_path) {
+  auto* thread = new PrefetchThread(manifest_path);
+  if (!base::PlatformThread::CreateNonJoinableWithPriority(
+          0, thread, base::ThreadPriority::BACKGROUND))
+    delete thread;
+}
+
+}  // namespace asar
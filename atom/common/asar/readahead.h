@@ -0,0 +1,33 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_ASAR_READAHEAD_H_
+#define ATOM_COMMON_ASAR_READAHEAD_H_
+
+#include <stdint.h>
+
+#include "base/time/time.h"
+
+namespace base {
+class FilePath;
+}
+
+namespace asar {
+
+// Starts recording the ranges that are read from archives, reads after
+// |duration| has elapsed are ignored.
+void StartReadRecording(base::TimeDelta duration);
+
+// Called by Archive whenever a range of the archive is read, does nothing
+// when no recording is in progress.
+void RecordRead(const base::FilePath& path, uint64_t offset, uint64_t size);
+
+// Reads ahead the ranges recorded by the last launch in |manifest_path| on a
+// background thread, then replaces the manifest with the reads of this launch
+// once the recording ends. Can be called before the task scheduler runs.
+void PrefetchRecordedReads(const base::FilePath& manifest_path);
+
+}  // namespace asar
+
+#endif  // ATOM_COMMON_ASAR_READAHEAD_H_
@@ -6,6 +6,7 @@
 #define ATOM_COMMON_ASAR_SCOPED_TEMPORARY_FILE_H_
 
 #include "base/files/file_path.h"
+#include "base/strings/string_piece.h"
 
 namespace base {
 class File;
@@ -31,6 +32,10 @@ class ScopedTemporaryFile {
                     uint64_t offset,
                     uint64_t size);
 
+  // Init an temporary file and fill it with |content|.
+  bool InitFromContent(const base::FilePath::StringType& ext,
+                       base::StringPiece content);
+
   base::FilePath path() const { return path_; }
 
  private:
@@ -28,6 +28,7 @@ const char kSecureProtocolDescription[] =
 const char kPdfPluginMimeType[] = "application/x-google-chrome-pdf";
 const char kPdfPluginPath[] = "chrome://pdf-viewer/";
 const char kPdfPluginSrc[] = "src";
+const char kPdfPluginStream[] = "stream";
 
 const char kPdfViewerUIOrigin[] = "chrome://pdf-viewer/";
 const char kPdfViewerUIHost[] = "pdf-viewer";
@@ -27,6 +27,7 @@ extern const char kSecureProtocolDescription[];
 extern const char kPdfPluginMimeType[];
 extern const char kPdfPluginPath[];
 extern const char kPdfPluginSrc[];
+extern const char kPdfPluginStream[];
 
 // Constants for PDF viewer webui.
 extern const char kPdfViewerUIOrigin[];
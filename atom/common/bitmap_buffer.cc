@@ -0,0 +1,59 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/bitmap_buffer.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkPixelRef.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+namespace {
+
+// Owned by the Buffer, the pixels can be let go before it is collected.
+struct BitmapPixels {
+  sk_sp<SkPixelRef> pixel_ref;
+};
+
+void ReleasePixels(char* data, void* hint) {
+  delete static_cast<BitmapPixels*>(hint);
+}
+
+void DetachBuffer(v8::Isolate* isolate,
+                  v8::Global<v8::Object> buffer,
+                  BitmapPixels* pixels) {
+  v8::HandleScope handle_scope(isolate);
+  buffer.Get(isolate).As<v8::ArrayBufferView>()->Buffer()->Neuter();
+  // |buffer| kept the Buffer, and so |pixels|, from being collected.
+  pixels->pixel_ref.reset();
+}
+
+}  // namespace
+
+v8::Local<v8::Object> CreateBitmapBuffer(v8::Isolate* isolate,
+                                         const SkBitmap& bitmap,
+                                         base::OnceClosure* detach) {
+  SkPixelRef* pixel_ref = bitmap.pixelRef();
+  if (!pixel_ref || !bitmap.getPixels())
+    return node::Buffer::New(isolate, 0).ToLocalChecked();
+
+  auto* pixels = new BitmapPixels{sk_ref_sp(pixel_ref)};
+  v8::Local<v8::Object> buffer =
+      node::Buffer::New(isolate, static_cast<char*>(bitmap.getPixels()),
+                        bitmap.computeByteSize(), &ReleasePixels, pixels)
+          .ToLocalChecked();
+  if (detach) {
+    *detach = base::BindOnce(&DetachBuffer, isolate,
+                             v8::Global<v8::Object>(isolate, buffer), pixels);
+  }
+  return buffer;
+}
+
+}  // namespace atom
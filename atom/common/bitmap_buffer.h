@@ -0,0 +1,28 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_BITMAP_BUFFER_H_
+#define ATOM_COMMON_BITMAP_BUFFER_H_
+
+#include "base/callback_forward.h"
+#include "v8/include/v8.h"
+
+class SkBitmap;
+
+namespace atom {
+
+// Returns a Buffer that references the pixels of |bitmap| instead of copying
+// them, the pixels are kept alive until the Buffer is garbage collected.
+//
+// The Buffer sees the later changes of the pixels, so it should only be used
+// for bitmaps that are not drawn into anymore. When |detach| is given it is
+// set to a closure that empties the Buffer and lets the pixels go at once,
+// for pixels that are only valid for a while.
+v8::Local<v8::Object> CreateBitmapBuffer(v8::Isolate* isolate,
+                                         const SkBitmap& bitmap,
+                                         base::OnceClosure* detach = nullptr);
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_BITMAP_BUFFER_H_
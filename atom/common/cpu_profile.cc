@@ -0,0 +1,134 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/cpu_profile.h"
+
+#include <map>
+#include <utility>
+
+#include "base/json/json_writer.h"
+#include "base/lazy_instance.h"
+#include "base/values.h"
+#include "v8/include/v8-profiler.h"
+
+#include "atom/common/node_includes.h"
+
+namespace {
+
+const char kProfileTitle[] = "electron-cpu-profile";
+
+// The profilers that are running, they are disposed when they are stopped or
+// when the Node environment of their isolate is torn down.
+base::LazyInstance<std::map<v8::Isolate*, v8::CpuProfiler*>>::Leaky
+    g_profilers = LAZY_INSTANCE_INITIALIZER;
+
+void DisposeProfiler(void* arg) {
+  auto* isolate = static_cast<v8::Isolate*>(arg);
+  auto it = g_profilers.Get().find(isolate);
+  if (it == g_profilers.Get().end())
+    return;
+  it->second->Dispose();
+  g_profilers.Get().erase(it);
+}
+
+// Appends |node| and its descendants to |nodes| as the ProfileNode objects of
+// the DevTools protocol.
+void AppendProfileNode(const v8::CpuProfileNode* node,
+                       base::Value::ListStorage* nodes) {
+  base::Value call_frame(base::Value::Type::DICTIONARY);
+  call_frame.SetKey("functionName", base::Value(node->GetFunctionNameStr()));
+  call_frame.SetKey("scriptId",
+                    base::Value(std::to_string(node->GetScriptId())));
+  call_frame.SetKey("url", base::Value(node->GetScriptResourceNameStr()));
+  call_frame.SetKey("lineNumber", base::Value(node->GetLineNumber() - 1));
+  call_frame.SetKey("columnNumber", base::Value(node->GetColumnNumber() - 1));
+
+  base::Value::ListStorage children;
+  for (int i = 0; i < node->GetChildrenCount(); ++i)
+    children.emplace_back(static_cast<int>(node->GetChild(i)->GetNodeId()));
+
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetKey("id", base::Value(static_cast<int>(node->GetNodeId())));
+  value.SetKey("callFrame", std::move(call_frame));
+  value.SetKey("hitCount", base::Value(static_cast<int>(node->GetHitCount())));
+  value.SetKey("children", base::Value(std::move(children)));
+  nodes->push_back(std::move(value));
+
+  for (int i = 0; i < node->GetChildrenCount(); ++i)
+    AppendProfileNode(node->GetChild(i), nodes);
+}
+
+base::Value ProfileToValue(const v8::CpuProfile* profile) {
+  base::Value::ListStorage nodes;
+  AppendProfileNode(profile->GetTopDownRoot(), &nodes);
+
+  base::Value::ListStorage samples;
+  base::Value::ListStorage time_deltas;
+  int64_t last_timestamp = profile->GetStartTime();
+  for (int i = 0; i < profile->GetSamplesCount(); ++i) {
+    samples.emplace_back(static_cast<int>(profile->GetSample(i)->GetNodeId()));
+    int64_t timestamp = profile->GetSampleTimestamp(i);
+    time_deltas.emplace_back(static_cast<double>(timestamp - last_timestamp));
+    last_timestamp = timestamp;
+  }
+
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetKey("nodes", base::Value(std::move(nodes)));
+  value.SetKey("startTime",
+               base::Value(static_cast<double>(profile->GetStartTime())));
+  value.SetKey("endTime",
+               base::Value(static_cast<double>(profile->GetEndTime())));
+  value.SetKey("samples", base::Value(std::move(samples)));
+  value.SetKey("timeDeltas", base::Value(std::move(time_deltas)));
+  return value;
+}
+
+}  // namespace
+
+namespace atom {
+
+bool StartCpuProfiling(v8::Isolate* isolate, int sampling_interval_us) {
+  DCHECK(isolate);
+  DCHECK_GT(sampling_interval_us, 0);
+  if (g_profilers.Get().count(isolate))
+    return false;
+
+  v8::CpuProfiler* profiler = v8::CpuProfiler::New(isolate);
+  // The interval can only be changed while no profile is being recorded.
+  profiler->SetSamplingInterval(sampling_interval_us);
+  g_profilers.Get()[isolate] = profiler;
+  node::AddEnvironmentCleanupHook(isolate, &DisposeProfiler, isolate);
+
+  v8::HandleScope handle_scope(isolate);
+  profiler->StartProfiling(
+      v8::String::NewFromUtf8(isolate, kProfileTitle,
+                              v8::NewStringType::kNormal)
+          .ToLocalChecked(),
+      true);
+  return true;
+}
+
+bool StopCpuProfiling(v8::Isolate* isolate, std::string* json) {
+  DCHECK(isolate);
+  DCHECK(json);
+  auto it = g_profilers.Get().find(isolate);
+  if (it == g_profilers.Get().end())
+    return false;
+
+  v8::HandleScope handle_scope(isolate);
+  v8::CpuProfile* profile = it->second->StopProfiling(
+      v8::String::NewFromUtf8(isolate, kProfileTitle,
+                              v8::NewStringType::kNormal)
+          .ToLocalChecked());
+  bool success = profile && base::JSONWriter::Write(ProfileToValue(profile),
+                                                    json);
+  if (profile)
+    profile->Delete();
+
+  node::RemoveEnvironmentCleanupHook(isolate, &DisposeProfiler, isolate);
+  DisposeProfiler(isolate);
+  return success;
+}
+
+}  // namespace atom
@@ -0,0 +1,25 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_CPU_PROFILE_H_
+#define ATOM_COMMON_CPU_PROFILE_H_
+
+#include <string>
+
+#include "v8/include/v8.h"
+
+namespace atom {
+
+// Starts sampling the stacks of the JavaScript that runs on |isolate| every
+// |sampling_interval_us| microseconds. Returns false if the profiler is
+// already running.
+bool StartCpuProfiling(v8::Isolate* isolate, int sampling_interval_us);
+
+// Stops the profiler and writes the profile to |json| in the .cpuprofile
+// format of DevTools. Returns false if the profiler was not running.
+bool StopCpuProfiling(v8::Isolate* isolate, std::string* json);
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_CPU_PROFILE_H_
@@ -0,0 +1,124 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/crash_reporter/crash_annotations.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+
+#if defined(OS_MACOSX) && !defined(MAS_BUILD)
+#include "crashpad/client/annotation.h"
+#endif
+
+namespace crash_reporter {
+
+namespace {
+
+struct Slot {
+  char key[CrashAnnotations::kMaxKeySize];
+  char values[2][CrashAnnotations::kMaxValueSize];
+  // The buffer of the current value, -1 when there is none.
+  std::atomic<int> active;
+  // Serializes the writers of the slot, they never wait for long.
+  std::atomic_flag writing;
+#if defined(OS_MACOSX) && !defined(MAS_BUILD)
+  // Crashpad reads the annotations from the memory of the crashed process.
+  crashpad::StringAnnotation<CrashAnnotations::kMaxValueSize>* annotation;
+#endif
+};
+
+Slot g_slots[CrashAnnotations::kMaxAnnotations];
+std::atomic<int> g_slot_count(0);
+
+base::Lock& GetAllocationLock() {
+  static base::NoDestructor<base::Lock> lock;
+  return *lock;
+}
+
+bool IsValidSlot(int slot) {
+  return slot >= 0 && slot < g_slot_count.load(std::memory_order_acquire);
+}
+
+}  // namespace
+
+// static
+int CrashAnnotations::Allocate(const base::StringPiece& key) {
+  base::AutoLock auto_lock(GetAllocationLock());
+  std::string truncated = key.substr(0, kMaxKeySize - 1).as_string();
+  int count = g_slot_count.load(std::memory_order_relaxed);
+  for (int i = 0; i < count; ++i) {
+    if (truncated == g_slots[i].key)
+      return i;
+  }
+  if (count == kMaxAnnotations)
+    return -1;
+
+  Slot& slot = g_slots[count];
+  memcpy(slot.key, truncated.c_str(), truncated.size() + 1);
+  slot.active.store(-1, std::memory_order_relaxed);
+  slot.writing.clear();
+#if defined(OS_MACOSX) && !defined(MAS_BUILD)
+  slot.annotation = new crashpad::StringAnnotation<kMaxValueSize>(slot.key);
+#endif
+  // Publishes the slot to the readers.
+  g_slot_count.store(count + 1, std::memory_order_release);
+  return count;
+}
+
+// static
+void CrashAnnotations::Set(int slot, const base::StringPiece& value) {
+  if (!IsValidSlot(slot))
+    return;
+
+  Slot& s = g_slots[slot];
+  while (s.writing.test_and_set(std::memory_order_acquire)) {
+  }
+  int next = s.active.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+  size_t size = std::min(value.size(), kMaxValueSize - 1);
+  memcpy(s.values[next], value.data(), size);
+  s.values[next][size] = '\0';
+  s.active.store(next, std::memory_order_release);
+#if defined(OS_MACOSX) && !defined(MAS_BUILD)
+  s.annotation->Set(s.values[next]);
+#endif
+  s.writing.clear(std::memory_order_release);
+}
+
+// static
+void CrashAnnotations::Clear(int slot) {
+  if (!IsValidSlot(slot))
+    return;
+
+  Slot& s = g_slots[slot];
+  while (s.writing.test_and_set(std::memory_order_acquire)) {
+  }
+  s.active.store(-1, std::memory_order_release);
+#if defined(OS_MACOSX) && !defined(MAS_BUILD)
+  s.annotation->Clear();
+#endif
+  s.writing.clear(std::memory_order_release);
+}
+
+// static
+bool CrashAnnotations::Get(int slot, const char** key, const char** value) {
+  if (!IsValidSlot(slot))
+    return false;
+
+  const Slot& s = g_slots[slot];
+  int active = s.active.load(std::memory_order_acquire);
+  if (active < 0)
+    return false;
+  *key = s.key;
+  *value = s.values[active];
+  return true;
+}
+
+}  // namespace crash_reporter
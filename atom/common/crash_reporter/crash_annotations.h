@@ -0,0 +1,45 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_CRASH_REPORTER_CRASH_ANNOTATIONS_H_
+#define ATOM_COMMON_CRASH_REPORTER_CRASH_ANNOTATIONS_H_
+
+#include <stddef.h>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace crash_reporter {
+
+// Preallocated slots for crash annotations whose values change often, like
+// the current route of an app. A value is written into the spare one of two
+// buffers, which is then published with an atomic store, so setting it makes
+// no allocations and the crash handler always reads a whole value when it
+// writes the dump. Concurrent Set and Clear calls on the same slot spin on a
+// flag until the other one is done, the crash handler never waits.
+class CrashAnnotations {
+ public:
+  static const int kMaxAnnotations = 16;
+  // The sizes include the terminating NUL, longer values are truncated.
+  static const size_t kMaxKeySize = 64;
+  static const size_t kMaxValueSize = 256;
+
+  // Returns the slot of |key|, which is allocated on the first call, or -1
+  // when all the slots are used.
+  static int Allocate(const base::StringPiece& key);
+
+  static void Set(int slot, const base::StringPiece& value);
+  static void Clear(int slot);
+
+  // Returns false when |slot| has no value. Async-signal-safe, so it can be
+  // called by a crash handler.
+  static bool Get(int slot, const char** key, const char** value);
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(CrashAnnotations);
+};
+
+}  // namespace crash_reporter
+
+#endif  // ATOM_COMMON_CRASH_REPORTER_CRASH_ANNOTATIONS_H_
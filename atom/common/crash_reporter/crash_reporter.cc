@@ -93,6 +93,8 @@ std::map<std::string, std::string> CrashReporter::GetParameters() const {
   return upload_parameters_;
 }
 
+void CrashReporter::SetMinidumpSizeLimit(int64_t size) {}
+
 #if defined(OS_MACOSX) && defined(MAS_BUILD)
 // static
 CrashReporter* CrashReporter::GetInstance() {
@@ -120,6 +122,10 @@ void CrashReporter::StartInstance(const mate::Dictionary& options) {
   extra_parameters["_productName"] = product_name;
   extra_parameters["_companyName"] = company_name;
 
+  int64_t minidump_size_limit;
+  if (options.Get("minidumpSizeLimit", &minidump_size_limit))
+    reporter->SetMinidumpSizeLimit(minidump_size_limit);
+
   reporter->Start(product_name, company_name, submit_url, crashes_dir, true,
                   false, extra_parameters);
 }
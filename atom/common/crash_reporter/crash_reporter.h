@@ -41,6 +41,8 @@ class CrashReporter {
                                  const std::string& value);
   virtual void RemoveExtraParameter(const std::string& key);
   virtual std::map<std::string, std::string> GetParameters() const;
+  // Must be called before Start. A negative |size| means no limit.
+  virtual void SetMinidumpSizeLimit(int64_t size);
 
  protected:
   CrashReporter();
@@ -10,6 +10,7 @@
 
 #include <string>
 
+#include "atom/common/crash_reporter/crash_annotations.h"
 #include "base/debug/crash_logging.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
@@ -35,7 +36,8 @@ static const off_t kMaxMinidumpFileSize = 1258291;
 
 }  // namespace
 
-CrashReporterLinux::CrashReporterLinux() : pid_(getpid()) {
+CrashReporterLinux::CrashReporterLinux()
+    : pid_(getpid()), minidump_size_limit_(kMaxMinidumpFileSize) {
   // Set the base process start time value.
   struct timeval tv;
   if (!gettimeofday(&tv, NULL)) {
@@ -84,6 +86,13 @@ bool CrashReporterLinux::GetUploadToServer() {
   return upload_to_server_;
 }
 
+void CrashReporterLinux::SetMinidumpSizeLimit(int64_t size) {
+  // Breakpad keeps the stacks of the crashing thread and of as many other
+  // threads as fit in the limit, so a small limit writes little more than
+  // the stack of the crash.
+  minidump_size_limit_ = size < 0 ? -1 : static_cast<off_t>(size);
+}
+
 void CrashReporterLinux::EnableCrashDumping(const base::FilePath& crashes_dir) {
   {
     base::ThreadRestrictions::ScopedAllowIO allow_io;
@@ -93,7 +102,7 @@ void CrashReporterLinux::EnableCrashDumping(const base::FilePath& crashes_dir) {
   strncpy(g_crash_log_path, log_file.c_str(), sizeof(g_crash_log_path));
 
   MinidumpDescriptor minidump_descriptor(crashes_dir.value());
-  minidump_descriptor.set_size_limit(kMaxMinidumpFileSize);
+  minidump_descriptor.set_size_limit(minidump_size_limit_);
 
   breakpad_.reset(new ExceptionHandler(minidump_descriptor, NULL, CrashDone,
                                        this,
@@ -127,6 +136,14 @@ bool CrashReporterLinux::CrashDone(const MinidumpDescriptor& minidump,
   info.pid = self->pid_;
   info.upload_url = self->upload_url_.c_str();
   info.crash_keys = self->crash_keys_.get();
+
+  // The annotations are only copied now, so setting them stays cheap.
+  for (int i = 0; i < CrashAnnotations::kMaxAnnotations; ++i) {
+    const char* key;
+    const char* value;
+    if (info.crash_keys && CrashAnnotations::Get(i, &key, &value))
+      info.crash_keys->SetKeyValue(key, value);
+  }
   HandleCrashDump(info);
   return true;
 }
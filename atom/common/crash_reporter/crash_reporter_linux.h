@@ -38,6 +38,7 @@ class CrashReporterLinux : public CrashReporter {
   void SetUploadToServer(bool upload_to_server) override;
   void SetUploadParameters() override;
   bool GetUploadToServer() override;
+  void SetMinidumpSizeLimit(int64_t size) override;
 
  private:
   friend struct base::DefaultSingletonTraits<CrashReporterLinux>;
@@ -58,6 +59,7 @@ class CrashReporterLinux : public CrashReporter {
   pid_t pid_ = 0;
   std::string upload_url_;
   bool upload_to_server_ = true;
+  off_t minidump_size_limit_;
 
   DISALLOW_COPY_AND_ASSIGN(CrashReporterLinux);
 };
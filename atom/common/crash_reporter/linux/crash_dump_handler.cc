@@ -101,7 +101,9 @@ const char g_content_type_msg[] = "Content-Type: application/octet-stream";
 // MimeWriter manages an iovec for writing MIMEs to a file.
 class MimeWriter {
  public:
-  static const int kIovCapacity = 30;
+  // Crash keys fill the iovec until it is full, so they take a few writes
+  // instead of one each. This still fits on the signal stack.
+  static const int kIovCapacity = 128;
   static const size_t kMaxCrashChunkSize = 64;
 
   MimeWriter(int fd, const char* const mime_boundary);
@@ -609,6 +611,7 @@ void HandleCrashDump(const BreakpadInfo& info) {
                          pid_value_len);
       writer.AddBoundary();
     }
+    // The iovec points to |pid_value_buf|.
     writer.Flush();
   }
 
@@ -635,7 +638,6 @@ void HandleCrashDump(const BreakpadInfo& info) {
     static const char distro_msg[] = "lsb-release";
     writer.AddPairString(distro_msg, info.distro);
     writer.AddBoundary();
-    writer.Flush();
   }
 
   if (info.oom_size) {
@@ -649,13 +651,14 @@ void HandleCrashDump(const BreakpadInfo& info) {
     writer.Flush();
   }
 
+  // Like the distro, the crash keys outlive the writer, so they are written
+  // once the iovec is full.
   if (info.crash_keys) {
     CrashKeyStorage::Iterator crash_key_iterator(*info.crash_keys);
     const CrashKeyStorage::Entry* entry;
     while ((entry = crash_key_iterator.Next())) {
       writer.AddPairString(entry->key, entry->value);
       writer.AddBoundary();
-      writer.Flush();
     }
   }
 
@@ -670,6 +673,13 @@ void HandleCrashDump(const BreakpadInfo& info) {
 
   const pid_t child = sys_fork();
   if (!child) {
+    // The crashing process only waits for this intermediate process, which
+    // leaves the upload to a daemonized helper, so a slow upload does not
+    // delay the crash and get the process killed by a watchdog. When the
+    // fork fails the upload is done from here.
+    if (sys_fork() > 0)
+      sys__exit(0);
+
     // Spawned helper process.
     //
     // This code is called both when a browser is crashing (in which case,
@@ -7,8 +7,10 @@
 #include <windows.h>
 
 #include <sddl.h>
+#include <algorithm>
 #include <fstream>  // NOLINT
 #include <map>
+#include <utility>
 
 #include "base/command_line.h"
 #include "base/files/file_util.h"
@@ -33,6 +35,10 @@ const wchar_t kTestPipeName[] = L"\\\\.\\pipe\\ChromeCrashServices";
 const wchar_t kGoogleReportURL[] = L"https://clients2.google.com/cr/report";
 const wchar_t kCheckPointFile[] = L"crash_checkpoint.txt";
 
+// The number of dumps processed at the same time, when several processes
+// crash together the others wait in the queue.
+const int kMaxDumpWorkers = 4;
+
 typedef std::map<std::wstring, std::wstring> CrashMap;
 
 bool CustomInfoToMap(const google_breakpad::ClientInfo* client_info,
@@ -180,6 +186,17 @@ struct DumpJobInfo {
 
 }  // namespace
 
+// A dump written by breakpad, waiting to be moved and annotated.
+struct CrashService::PendingDump {
+  // Keeps the service alive until the dump is processed.
+  ProcessingLock processing_lock;
+  DWORD pid = 0;
+  bool is_browser = false;
+  CrashMap map;
+  base::FilePath dump_path;
+  base::TimeTicks queued_time;
+};
+
 // Command line switches:
 const char CrashService::kMaxReports[] = "max-reports";
 const char CrashService::kNoWindow[] = "no-window";
@@ -196,6 +213,11 @@ CrashService::~CrashService() {
   delete sender_;
 }
 
+base::TimeDelta CrashService::max_dump_queue_time() const {
+  base::AutoLock lock(dumps_);
+  return max_dump_queue_time_;
+}
+
 bool CrashService::Initialize(const base::string16& application_name,
                               const base::FilePath& operating_dir,
                               const base::FilePath& dumps_path) {
@@ -363,13 +385,68 @@ void CrashService::OnClientDumpRequest(
     return;
   }
 
-  CrashMap map;
-  CustomInfoToMap(client_info, self->reporter_tag_, &map);
+  // The client waits until this returns, so only queue the dump here and let
+  // a worker process it.
+  auto dump = std::make_unique<PendingDump>();
+  dump->pid = client_info->pid();
+  CustomInfoToMap(client_info, self->reporter_tag_, &dump->map);
+  CrashMap::const_iterator it = dump->map.find(L"process_type");
+  dump->is_browser = it != dump->map.end() && it->second == L"browser";
+  dump->dump_path = base::FilePath(*file_path);
+  dump->queued_time = base::TimeTicks::Now();
+
+  base::AutoLock dumps_lock(self->dumps_);
+  self->pending_dumps_.push_back(std::move(dump));
+  if (self->dump_workers_ >= kMaxDumpWorkers)
+    return;
+  if (::QueueUserWorkItem(&CrashService::ProcessDumps, self,
+                          WT_EXECUTEDEFAULT)) {
+    ++self->dump_workers_;
+  } else if (self->dump_workers_ == 0) {
+    LOG(ERROR) << "could not queue dump processing";
+    self->pending_dumps_.clear();
+  }
+}
+
+DWORD CrashService::ProcessDumps(void* context) {
+  CrashService* self = static_cast<CrashService*>(context);
+  while (true) {
+    std::unique_ptr<PendingDump> dump;
+    {
+      base::AutoLock lock(self->dumps_);
+      auto& dumps = self->pending_dumps_;
+      if (dumps.empty()) {
+        --self->dump_workers_;
+        return 0;
+      }
+      // The browser process crashing takes the whole app down, its dump is
+      // the most useful one.
+      auto next = std::min_element(
+          dumps.begin(), dumps.end(),
+          [](const std::unique_ptr<PendingDump>& a,
+             const std::unique_ptr<PendingDump>& b) {
+            if (a->is_browser != b->is_browser)
+              return a->is_browser;
+            return a->queued_time < b->queued_time;
+          });
+      dump = std::move(*next);
+      dumps.erase(next);
+
+      base::TimeDelta queue_time = base::TimeTicks::Now() - dump->queued_time;
+      ++self->dumps_processed_;
+      self->total_dump_queue_time_ += queue_time;
+      self->max_dump_queue_time_ =
+          std::max(self->max_dump_queue_time_, queue_time);
+    }
+    self->ProcessDump(*dump);
+  }
+}
 
+void CrashService::ProcessDump(const PendingDump& dump) {
   // Move dump file to the directory under client breakpad dump location.
-  base::FilePath dump_location = base::FilePath(*file_path);
-  CrashMap::const_iterator it = map.find(L"breakpad-dump-location");
-  if (it != map.end()) {
+  base::FilePath dump_location = dump.dump_path;
+  CrashMap::const_iterator it = dump.map.find(L"breakpad-dump-location");
+  if (it != dump.map.end()) {
     base::FilePath alternate_dump_location = base::FilePath(it->second);
     base::CreateDirectoryW(alternate_dump_location);
     alternate_dump_location =
@@ -378,20 +455,19 @@ void CrashService::OnClientDumpRequest(
     dump_location = alternate_dump_location;
   }
 
-  DWORD pid = client_info->pid();
-  VLOG(1) << "dump for pid = " << pid << " is " << dump_location.value();
+  VLOG(1) << "dump for pid = " << dump.pid << " is " << dump_location.value();
 
-  if (!WriteCustomInfoToFile(dump_location.value(), map)) {
+  if (!WriteCustomInfoToFile(dump_location.value(), dump.map)) {
     LOG(ERROR) << "could not write custom info file";
   }
 
-  if (!self->sender_ || map.find(L"skip_upload") != map.end())
+  if (!sender_ || dump.map.find(L"skip_upload") != dump.map.end())
     return;
 
   // Send the crash dump using a worker thread. This operation has retry
   // logic in case there is no internet connection at the time.
   DumpJobInfo* dump_job =
-      new DumpJobInfo(pid, self, map, dump_location.value());
+      new DumpJobInfo(dump.pid, this, dump.map, dump_location.value());
   if (!::QueueUserWorkItem(&CrashService::AsyncSendDump, dump_job,
                            WT_EXECUTELONGFUNCTION)) {
     LOG(ERROR) << "could not queue job";
@@ -479,6 +555,16 @@ int CrashService::ProcessingLoop() {
           << "\nclients terminated :" << clients_terminated_
           << "\ndumps serviced :" << requests_handled_
           << "\ndumps reported :" << requests_sent_;
+  {
+    base::AutoLock lock(dumps_);
+    if (dumps_processed_ > 0) {
+      VLOG(1) << "dumps processed :" << dumps_processed_
+              << "\naverage dump queue time :"
+              << (total_dump_queue_time_ / dumps_processed_).InMilliseconds()
+              << "ms\nmaximum dump queue time :"
+              << max_dump_queue_time_.InMilliseconds() << "ms";
+    }
+  }
 
   return static_cast<int>(msg.wParam);
 }
@@ -5,11 +5,14 @@
 #ifndef ATOM_COMMON_CRASH_REPORTER_WIN_CRASH_SERVICE_H_
 #define ATOM_COMMON_CRASH_REPORTER_WIN_CRASH_SERVICE_H_
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 
 #if defined(OS_WIN)
 #include <windows.h>
@@ -79,6 +82,8 @@ class CrashService {
   int clients_connected() const { return clients_connected_; }
   // Returns number of crash clients terminated.
   int clients_terminated() const { return clients_terminated_; }
+  // Returns the longest time a dump waited to be processed.
+  base::TimeDelta max_dump_queue_time() const;
 
   // Starts the processing loop. This function does not return unless the
   // user is logging off or the user closes the crash service window. The
@@ -97,6 +102,14 @@ class CrashService {
   static void OnClientExited(void* context,
                              const google_breakpad::ClientInfo* client_info);
 
+  struct PendingDump;
+
+  // Moves the dumps waiting in |pending_dumps_| to their final location and
+  // writes their custom info, the dumps of the browser process first. Up to
+  // kMaxDumpWorkers of these run at the same time.
+  static DWORD __stdcall ProcessDumps(void* context);
+  void ProcessDump(const PendingDump& dump);
+
   // This routine sends the crash dump to the server. It takes the sending_
   // lock when it is performing the send.
   static DWORD __stdcall AsyncSendDump(void* context);
@@ -122,6 +135,14 @@ class CrashService {
   volatile LONG clients_terminated_ = 0;
   base::Lock sending_;
 
+  // Dumps written by breakpad but not processed yet, guarded by |dumps_|.
+  std::vector<std::unique_ptr<PendingDump>> pending_dumps_;
+  int dump_workers_ = 0;
+  int dumps_processed_ = 0;
+  base::TimeDelta total_dump_queue_time_;
+  base::TimeDelta max_dump_queue_time_;
+  mutable base::Lock dumps_;
+
   DISALLOW_COPY_AND_ASSIGN(CrashService);
 };
 
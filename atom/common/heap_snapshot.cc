@@ -4,10 +4,33 @@
 
 #include "atom/common/heap_snapshot.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/json/json_writer.h"
+#include "base/memory/ref_counted.h"
+#include "base/sequenced_task_runner.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/task_runner_util.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+#include "base/values.h"
 #include "v8/include/v8-profiler.h"
 
 namespace {
 
+// Snapshots of large heaps are hundreds of megabytes, so they are written in
+// large chunks, and at most this many chunks wait for the disk.
+const int kChunkSize = 1024 * 1024;
+const int kMaxPendingChunks = 8;
+
+// Reporting more often than this would flood the receiver of the progress.
+const int kProgressIntervalMs = 100;
+
 class HeapSnapshotOutputStream : public v8::OutputStream {
  public:
   explicit HeapSnapshotOutputStream(base::File* file) : file_(file) {
@@ -30,6 +53,167 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   bool is_complete_ = false;
 };
 
+// Writes chunks to a file in order on a blocking task runner.
+class FileWriter : public base::RefCountedThreadSafe<FileWriter> {
+ public:
+  explicit FileWriter(base::File file)
+      : file_(std::move(file)),
+        task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+            {base::MayBlock(), base::TaskPriority::USER_VISIBLE})),
+        chunk_written_(&lock_) {}
+
+  // Returns false when an earlier chunk could not be written. Blocks while
+  // too many chunks are pending, which bounds the memory of the writer.
+  bool Write(std::string chunk) {
+    {
+      base::AutoLock auto_lock(lock_);
+      while (pending_chunks_ >= kMaxPendingChunks && !failed_)
+        chunk_written_.Wait();
+      if (failed_)
+        return false;
+      ++pending_chunks_;
+    }
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&FileWriter::WriteOnWriterSequence,
+                                          this, std::move(chunk)));
+    return true;
+  }
+
+  // Calls |done| on the current thread once all chunks have been written.
+  void Close(bool success, atom::HeapSnapshotDoneCallback done) {
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&FileWriter::CloseOnWriterSequence, this, success),
+        std::move(done));
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<FileWriter>;
+  ~FileWriter() {}
+
+  void WriteOnWriterSequence(const std::string& chunk) {
+    int size = static_cast<int>(chunk.size());
+    bool success = file_.WriteAtCurrentPos(chunk.data(), size) == size;
+
+    base::AutoLock auto_lock(lock_);
+    --pending_chunks_;
+    if (!success)
+      failed_ = true;
+    chunk_written_.Signal();
+  }
+
+  bool CloseOnWriterSequence(bool success) {
+    file_.Close();
+    base::AutoLock auto_lock(lock_);
+    return success && !failed_;
+  }
+
+  base::File file_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  base::Lock lock_;
+  base::ConditionVariable chunk_written_;
+  int pending_chunks_ = 0;
+  bool failed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(FileWriter);
+};
+
+class ProgressReporter : public v8::ActivityControl {
+ public:
+  explicit ProgressReporter(const atom::HeapSnapshotProgressCallback& callback)
+      : callback_(callback) {}
+
+  void Report(atom::HeapSnapshotPhase phase, int64_t done, int64_t total) {
+    if (callback_.is_null())
+      return;
+    base::TimeTicks now = base::TimeTicks::Now();
+    if (now - last_report_ <
+        base::TimeDelta::FromMilliseconds(kProgressIntervalMs))
+      return;
+    last_report_ = now;
+    callback_.Run(phase, done, total);
+  }
+
+  // v8::ActivityControl:
+  ControlOption ReportProgressValue(int done, int total) override {
+    Report(atom::HeapSnapshotPhase::kSnapshot, done, total);
+    return kContinue;
+  }
+
+ private:
+  atom::HeapSnapshotProgressCallback callback_;
+  base::TimeTicks last_report_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProgressReporter);
+};
+
+class AsyncOutputStream : public v8::OutputStream {
+ public:
+  AsyncOutputStream(FileWriter* writer, ProgressReporter* progress)
+      : writer_(writer), progress_(progress) {}
+
+  bool IsComplete() const { return is_complete_; }
+
+  // v8::OutputStream
+  int GetChunkSize() override { return kChunkSize; }
+  void EndOfStream() override { is_complete_ = true; }
+
+  v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
+    if (!writer_->Write(std::string(data, size)))
+      return kAbort;
+    bytes_written_ += size;
+    progress_->Report(atom::HeapSnapshotPhase::kWrite, bytes_written_, 0);
+    return kContinue;
+  }
+
+ private:
+  FileWriter* writer_;
+  ProgressReporter* progress_;
+  int64_t bytes_written_ = 0;
+  bool is_complete_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncOutputStream);
+};
+
+void ReportFailure(atom::HeapSnapshotDoneCallback done) {
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(std::move(done), false));
+}
+
+std::string ToUTF8(v8::Isolate* isolate, v8::Local<v8::String> string) {
+  v8::String::Utf8Value value(isolate, string);
+  return *value ? std::string(*value, value.length()) : std::string();
+}
+
+// Converts the nodes of an allocation profile to the ProfileNode objects of
+// the DevTools protocol.
+base::Value AllocationNodeToValue(v8::Isolate* isolate,
+                                  const v8::AllocationProfile::Node* node,
+                                  int* next_id) {
+  base::Value call_frame(base::Value::Type::DICTIONARY);
+  call_frame.SetKey("functionName", base::Value(ToUTF8(isolate, node->name)));
+  call_frame.SetKey("scriptId", base::Value(std::to_string(node->script_id)));
+  call_frame.SetKey("url", base::Value(ToUTF8(isolate, node->script_name)));
+  call_frame.SetKey("lineNumber", base::Value(node->line_number - 1));
+  call_frame.SetKey("columnNumber", base::Value(node->column_number - 1));
+
+  double self_size = 0;
+  for (const auto& allocation : node->allocations)
+    self_size += static_cast<double>(allocation.size) * allocation.count;
+
+  base::Value::ListStorage children;
+  for (const auto* child : node->children)
+    children.push_back(AllocationNodeToValue(isolate, child, next_id));
+
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetKey("callFrame", std::move(call_frame));
+  value.SetKey("selfSize", base::Value(self_size));
+  value.SetKey("id", base::Value((*next_id)++));
+  value.SetKey("children", base::Value(std::move(children)));
+  return value;
+}
+
 }  // namespace
 
 namespace atom {
@@ -53,4 +237,67 @@ bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
   return stream.IsComplete();
 }
 
+void TakeHeapSnapshotAsync(v8::Isolate* isolate,
+                           base::File file,
+                           const HeapSnapshotProgressCallback& progress,
+                           HeapSnapshotDoneCallback done) {
+  DCHECK(isolate);
+
+  if (!file.IsValid()) {
+    ReportFailure(std::move(done));
+    return;
+  }
+
+  ProgressReporter reporter(progress);
+  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot(&reporter);
+  if (!snapshot) {
+    ReportFailure(std::move(done));
+    return;
+  }
+
+  auto writer = base::MakeRefCounted<FileWriter>(std::move(file));
+  AsyncOutputStream stream(writer.get(), &reporter);
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+
+  const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+
+  writer->Close(stream.IsComplete(), std::move(done));
+}
+
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               uint64_t sample_interval,
+                               int stack_depth) {
+  DCHECK(isolate);
+  return isolate->GetHeapProfiler()->StartSamplingHeapProfiler(sample_interval,
+                                                               stack_depth);
+}
+
+void StopSamplingHeapProfiler(v8::Isolate* isolate,
+                              base::File file,
+                              HeapSnapshotDoneCallback done) {
+  DCHECK(isolate);
+  v8::HandleScope handle_scope(isolate);
+
+  auto* profiler = isolate->GetHeapProfiler();
+  std::unique_ptr<v8::AllocationProfile> profile(
+      profiler->GetAllocationProfile());
+  profiler->StopSamplingHeapProfiler();
+  if (!profile || !file.IsValid()) {
+    ReportFailure(std::move(done));
+    return;
+  }
+
+  int next_id = 1;
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetKey("head", AllocationNodeToValue(isolate, profile->GetRootNode(),
+                                             &next_id));
+  std::string json;
+  bool success = base::JSONWriter::Write(value, &json);
+
+  auto writer = base::MakeRefCounted<FileWriter>(std::move(file));
+  if (success)
+    success = writer->Write(std::move(json));
+  writer->Close(success, std::move(done));
+}
+
 }  // namespace atom
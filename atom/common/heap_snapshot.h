@@ -5,13 +5,46 @@
 #ifndef ATOM_COMMON_HEAP_SNAPSHOT_H_
 #define ATOM_COMMON_HEAP_SNAPSHOT_H_
 
+#include "base/callback.h"
 #include "base/files/file.h"
 #include "v8/include/v8.h"
 
 namespace atom {
 
+enum class HeapSnapshotPhase {
+  // |done| and |total| count the heap objects that have been visited.
+  kSnapshot,
+  // |done| counts the bytes that have been written, |total| is unknown.
+  kWrite,
+};
+
+using HeapSnapshotProgressCallback = base::RepeatingCallback<
+    void(HeapSnapshotPhase phase, int64_t done, int64_t total)>;
+using HeapSnapshotDoneCallback = base::OnceCallback<void(bool success)>;
+
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
 
+// Takes the snapshot and serializes it on the current thread, as V8 requires,
+// but leaves the writing of the file to a blocking task runner. Only a few
+// chunks are held in memory at any time, so large heaps are not buffered in
+// full. |done| is called on the current thread once the file is closed.
+void TakeHeapSnapshotAsync(v8::Isolate* isolate,
+                           base::File file,
+                           const HeapSnapshotProgressCallback& progress,
+                           HeapSnapshotDoneCallback done);
+
+// The sampling heap profiler records the stacks of an allocation every
+// |sample_interval| bytes on average, which is far cheaper than a snapshot.
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               uint64_t sample_interval,
+                               int stack_depth);
+
+// Stops the profiler and writes the profile to |file| in the .heapprofile
+// format of DevTools.
+void StopSamplingHeapProfiler(v8::Isolate* isolate,
+                              base::File file,
+                              HeapSnapshotDoneCallback done);
+
 }  // namespace atom
 
 #endif  // ATOM_COMMON_HEAP_SNAPSHOT_H_
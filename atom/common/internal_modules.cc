@@ -0,0 +1,27 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/internal_modules.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "internal_modules_data.h"  // NOLINT: This file is generated
+
+namespace atom {
+
+const InternalModule* FindInternalModule(base::StringPiece path) {
+  const InternalModule* begin = std::begin(kInternalModules);
+  const InternalModule* end = std::end(kInternalModules);
+  const InternalModule* it =
+      std::lower_bound(begin, end, path,
+                       [](const InternalModule& module, base::StringPiece key) {
+                         return base::StringPiece(module.path) < key;
+                       });
+  if (it == end || base::StringPiece(it->path) != path)
+    return nullptr;
+  return it;
+}
+
+}  // namespace atom
@@ -0,0 +1,32 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_INTERNAL_MODULES_H_
+#define ATOM_COMMON_INTERNAL_MODULES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/strings/string_piece.h"
+
+namespace atom {
+
+// A module of Electron's lib/ directory compiled into the binary by
+// tools/embed-internal-modules.py, so it can be loaded without reading
+// electron.asar.
+struct InternalModule {
+  // Relative to lib/ with "/" as separator, e.g. "browser/init.js".
+  const char* path;
+  const uint8_t* source;
+  size_t length;
+  // Whether the source can be handed to V8 as a one-byte string.
+  bool is_ascii;
+};
+
+// Returns the module at |path|, or nullptr when it was not embedded.
+const InternalModule* FindInternalModule(base::StringPiece path);
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_INTERNAL_MODULES_H_
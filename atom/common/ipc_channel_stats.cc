@@ -0,0 +1,74 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/ipc_channel_stats.h"
+
+#include "base/strings/string_util.h"
+#include "base/trace_event/trace_event.h"
+#include "base/values.h"
+
+namespace atom {
+
+namespace {
+
+const char kTraceCategory[] = TRACE_DISABLED_BY_DEFAULT("electron.ipc");
+
+}  // namespace
+
+IPCChannelStats::IPCChannelStats() {
+  DETACH_FROM_THREAD(thread_checker_);
+}
+
+IPCChannelStats::~IPCChannelStats() = default;
+
+// static
+IPCChannelStats* IPCChannelStats::GetInstance() {
+  static base::NoDestructor<IPCChannelStats> instance;
+  return instance.get();
+}
+
+// static
+std::string IPCChannelStats::GetChannelName(const std::string& channel,
+                                            const base::ListValue& args) {
+  // ipc-message, ipc-message-sync, ipc-internal-message and so on.
+  std::string name;
+  if (base::StartsWith(channel, "ipc-", base::CompareCase::SENSITIVE) &&
+      !args.GetList().empty() && args.GetList()[0].is_string())
+    name = args.GetList()[0].GetString();
+  return name.empty() ? channel : name;
+}
+
+void IPCChannelStats::Record(Direction direction,
+                             const std::string& channel,
+                             size_t bytes,
+                             base::TimeDelta handler_time) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  Counters& counters = counters_[channel];
+  if (direction == Direction::kSent) {
+    TRACE_EVENT_INSTANT2("electron", "IPCChannelStats::Send",
+                         TRACE_EVENT_SCOPE_THREAD, "channel", channel,
+                         "bytes", bytes);
+    counters.sent_count++;
+    counters.sent_bytes += bytes;
+  } else {
+    counters.received_count++;
+    counters.received_bytes += bytes;
+    counters.handler_time += handler_time;
+  }
+
+  bool tracing = false;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(kTraceCategory, &tracing);
+  if (tracing) {
+    TRACE_COPY_COUNTER2(kTraceCategory, ("IPC " + channel).c_str(), "count",
+                        counters.sent_count + counters.received_count, "bytes",
+                        counters.sent_bytes + counters.received_bytes);
+  }
+}
+
+void IPCChannelStats::Reset() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  counters_.clear();
+}
+
+}  // namespace atom
@@ -0,0 +1,71 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_IPC_CHANNEL_STATS_H_
+#define ATOM_COMMON_IPC_CHANNEL_STATS_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/threading/thread_checker.h"
+#include "base/time/time.h"
+
+namespace base {
+class ListValue;
+}
+
+namespace atom {
+
+// Counts the IPC messages of the current process per channel, the counters
+// are also exported to the "disabled-by-default-electron.ipc" trace category.
+// Only used on the thread that runs JavaScript.
+class IPCChannelStats {
+ public:
+  enum class Direction {
+    kSent,
+    kReceived,
+  };
+
+  struct Counters {
+    uint64_t sent_count = 0;
+    uint64_t sent_bytes = 0;
+    uint64_t received_count = 0;
+    uint64_t received_bytes = 0;
+    base::TimeDelta handler_time;
+  };
+
+  static IPCChannelStats* GetInstance();
+
+  // Returns the channel that |channel| was sent on by ipcRenderer, which puts
+  // the real channel in front of |args| of its own channels.
+  static std::string GetChannelName(const std::string& channel,
+                                    const base::ListValue& args);
+
+  void Record(Direction direction,
+              const std::string& channel,
+              size_t bytes,
+              base::TimeDelta handler_time = base::TimeDelta());
+  void Reset();
+
+  const std::map<std::string, Counters>& counters() const { return counters_; }
+
+ private:
+  friend class base::NoDestructor<IPCChannelStats>;
+
+  IPCChannelStats();
+  ~IPCChannelStats();
+
+  std::map<std::string, Counters> counters_;
+
+  THREAD_CHECKER(thread_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(IPCChannelStats);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_IPC_CHANNEL_STATS_H_
@@ -5,79 +5,150 @@
 #ifndef ATOM_COMMON_KEY_WEAK_MAP_H_
 #define ATOM_COMMON_KEY_WEAK_MAP_H_
 
-#include <unordered_map>
-#include <utility>
+#include <deque>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "v8/include/v8.h"
 
 namespace atom {
 
 // Like ES6's WeakMap, but the key is Integer and the value is Weak Pointer.
+//
+// The keys are kept sorted in one vector, which is cheap for the increasing
+// IDs most maps use. Removing a key from it moves the keys after it, so the
+// entries that are removed or garbage collected are only marked. A marked
+// entry is reused when its key is set again, and the marked entries are
+// dropped from the vector in one pass once they are a large part of it.
 template <typename K>
 class KeyWeakMap {
  public:
-  // Records the key and self, used by SetWeak.
-  struct KeyObject {
-    K key;
-    KeyWeakMap* self;
-  };
-
   KeyWeakMap() {}
   virtual ~KeyWeakMap() {
-    for (auto& p : map_)
-      p.second.second.ClearWeak();
+    for (auto& entry : entries_) {
+      if (!entry.removed)
+        entry.object.ClearWeak();
+    }
   }
 
   // Sets the object to WeakMap with the given |key|.
   void Set(v8::Isolate* isolate, const K& key, v8::Local<v8::Object> object) {
-    KeyObject key_object = {key, this};
-    auto& p = map_[key] =
-        std::make_pair(key_object, v8::Global<v8::Object>(isolate, object));
-    p.second.SetWeak(&(p.first), OnObjectGC, v8::WeakCallbackType::kParameter);
+    Entry* entry;
+    auto iter = index_.find(key);
+    if (iter != index_.end()) {
+      entry = iter->second;
+      if (entry->removed) {
+        entry->removed = false;
+        --removed_count_;
+      }
+    } else {
+      if (removed_count_ >= kMinRemovedToDrop &&
+          removed_count_ * 2 >= index_.size())
+        DropRemovedEntries();
+      entry = NewEntry();
+      index_.emplace(key, entry);
+    }
+    entry->object.Reset(isolate, object);
+    entry->object.SetWeak(entry, OnObjectGC, v8::WeakCallbackType::kParameter);
   }
 
   // Gets the object from WeakMap by its |key|.
   v8::MaybeLocal<v8::Object> Get(v8::Isolate* isolate, const K& key) {
-    auto iter = map_.find(key);
-    if (iter == map_.end())
+    auto iter = index_.find(key);
+    if (iter == index_.end() || iter->second->removed)
       return v8::MaybeLocal<v8::Object>();
     else
-      return v8::Local<v8::Object>::New(isolate, iter->second.second);
+      return v8::Local<v8::Object>::New(isolate, iter->second->object);
   }
 
   // Whethere there is an object with |key| in this WeakMap.
-  bool Has(const K& key) const { return map_.find(key) != map_.end(); }
+  bool Has(const K& key) const {
+    auto iter = index_.find(key);
+    return iter != index_.end() && !iter->second->removed;
+  }
+
+  // Calls |callback| with the key and the object of each entry, without
+  // copying them. |callback| must not change the map.
+  template <typename Callback>
+  void ForEach(v8::Isolate* isolate, const Callback& callback) const {
+    for (const auto& it : index_) {
+      if (!it.second->removed)
+        callback(it.first, v8::Local<v8::Object>::New(isolate,
+                                                      it.second->object));
+    }
+  }
 
   // Returns all objects.
   std::vector<v8::Local<v8::Object>> Values(v8::Isolate* isolate) const {
     std::vector<v8::Local<v8::Object>> keys;
-    keys.reserve(map_.size());
-    for (const auto& it : map_)
-      keys.emplace_back(v8::Local<v8::Object>::New(isolate, it.second.second));
+    keys.reserve(index_.size() - removed_count_);
+    ForEach(isolate, [&keys](const K& key, v8::Local<v8::Object> object) {
+      keys.push_back(object);
+    });
     return keys;
   }
 
   // Remove object with |key| in the WeakMap.
   void Remove(const K& key) {
-    auto iter = map_.find(key);
-    if (iter == map_.end())
+    auto iter = index_.find(key);
+    if (iter == index_.end() || iter->second->removed)
       return;
-
-    iter->second.second.ClearWeak();
-    map_.erase(iter);
+    iter->second->object.Reset();
+    MarkRemoved(iter->second);
   }
 
  private:
-  static void OnObjectGC(
-      const v8::WeakCallbackInfo<typename KeyWeakMap<K>::KeyObject>& data) {
-    KeyWeakMap<K>::KeyObject* key_object = data.GetParameter();
-    key_object->self->Remove(key_object->key);
+  // Fewer marked entries than this are never worth a pass over the vector.
+  static constexpr size_t kMinRemovedToDrop = 32;
+
+  // Entries never move, so the weak callbacks can refer to them.
+  struct Entry {
+    KeyWeakMap* self;
+    v8::Global<v8::Object> object;
+    bool removed = false;
+  };
+
+  static void OnObjectGC(const v8::WeakCallbackInfo<Entry>& data) {
+    Entry* entry = data.GetParameter();
+    entry->object.Reset();
+    entry->self->MarkRemoved(entry);
+  }
+
+  Entry* NewEntry() {
+    Entry* entry;
+    if (free_entries_.empty()) {
+      entries_.emplace_back();
+      entry = &entries_.back();
+    } else {
+      entry = free_entries_.back();
+      free_entries_.pop_back();
+    }
+    entry->self = this;
+    entry->removed = false;
+    return entry;
+  }
+
+  void MarkRemoved(Entry* entry) {
+    entry->removed = true;
+    ++removed_count_;
+  }
+
+  void DropRemovedEntries() {
+    base::EraseIf(index_, [this](const auto& it) {
+      if (!it.second->removed)
+        return false;
+      free_entries_.push_back(it.second);
+      return true;
+    });
+    removed_count_ = 0;
   }
 
-  // Map of stored objects.
-  std::unordered_map<K, std::pair<KeyObject, v8::Global<v8::Object>>> map_;
+  base::flat_map<K, Entry*> index_;
+  std::deque<Entry> entries_;
+  std::vector<Entry*> free_entries_;
+  // The entries in |index_| that are marked as removed.
+  size_t removed_count_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(KeyWeakMap);
 };
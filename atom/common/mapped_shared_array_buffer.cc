@@ -0,0 +1,75 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/mapped_shared_array_buffer.h"
+
+#include <utility>
+
+namespace atom {
+
+namespace {
+
+class MappedSharedArrayBuffer {
+ public:
+  MappedSharedArrayBuffer(v8::Isolate* isolate,
+                          base::WritableSharedMemoryMapping mapping)
+      : isolate_(isolate), mapping_(std::move(mapping)) {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(mapping_.size());
+  }
+
+  ~MappedSharedArrayBuffer() {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(
+        -static_cast<int64_t>(mapping_.size()));
+  }
+
+  v8::Local<v8::SharedArrayBuffer> CreateBuffer() {
+    v8::Local<v8::SharedArrayBuffer> buffer = v8::SharedArrayBuffer::New(
+        isolate_, mapping_.memory(), mapping_.size(),
+        v8::ArrayBufferCreationMode::kExternalized);
+    buffer_.Reset(isolate_, buffer);
+    buffer_.SetWeak(this, &MappedSharedArrayBuffer::OnGarbageCollected,
+                    v8::WeakCallbackType::kParameter);
+    return buffer;
+  }
+
+ private:
+  static void OnGarbageCollected(
+      const v8::WeakCallbackInfo<MappedSharedArrayBuffer>& data) {
+    delete data.GetParameter();
+  }
+
+  v8::Isolate* isolate_;
+  base::WritableSharedMemoryMapping mapping_;
+  v8::Global<v8::SharedArrayBuffer> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedSharedArrayBuffer);
+};
+
+}  // namespace
+
+v8::Local<v8::SharedArrayBuffer> CreateMappedSharedArrayBuffer(
+    v8::Isolate* isolate,
+    base::WritableSharedMemoryMapping mapping) {
+  auto* holder = new MappedSharedArrayBuffer(isolate, std::move(mapping));
+  return holder->CreateBuffer();
+}
+
+MappedSharedArrayBuffers::MappedSharedArrayBuffers() = default;
+
+MappedSharedArrayBuffers::~MappedSharedArrayBuffers() = default;
+
+v8::Local<v8::SharedArrayBuffer> MappedSharedArrayBuffers::Create(
+    v8::Isolate* isolate,
+    base::WritableSharedMemoryMapping mapping) {
+  mappings_.push_back(std::move(mapping));
+  const base::WritableSharedMemoryMapping& stored = mappings_.back();
+  return v8::SharedArrayBuffer::New(isolate, stored.memory(), stored.size(),
+                                    v8::ArrayBufferCreationMode::kExternalized);
+}
+
+void MappedSharedArrayBuffers::Clear() {
+  mappings_.clear();
+}
+
+}  // namespace atom
@@ -0,0 +1,51 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_MAPPED_SHARED_ARRAY_BUFFER_H_
+#define ATOM_COMMON_MAPPED_SHARED_ARRAY_BUFFER_H_
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+// Creates a SharedArrayBuffer over the memory of |mapping|, which stays mapped
+// until the SharedArrayBuffer is garbage collected. Node refuses to transfer
+// externalized SharedArrayBuffers to workers, so in the main process the heap
+// of |isolate| holds the only references to the memory.
+v8::Local<v8::SharedArrayBuffer> CreateMappedSharedArrayBuffer(
+    v8::Isolate* isolate,
+    base::WritableSharedMemoryMapping mapping);
+
+// Owns the shared memory behind the SharedArrayBuffers given to the script
+// context of a frame.
+//
+// The memory is not unmapped when a buffer is garbage collected but when the
+// owner calls Clear(), which it does once the context is released and no
+// script can reach the buffers anymore.
+class MappedSharedArrayBuffers {
+ public:
+  MappedSharedArrayBuffers();
+  ~MappedSharedArrayBuffers();
+
+  // Keeps |mapping| and returns a SharedArrayBuffer over its memory.
+  v8::Local<v8::SharedArrayBuffer> Create(
+      v8::Isolate* isolate,
+      base::WritableSharedMemoryMapping mapping);
+
+  // Unmaps the memory of all the buffers.
+  void Clear();
+
+ private:
+  std::vector<base::WritableSharedMemoryMapping> mappings_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedSharedArrayBuffers);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_MAPPED_SHARED_ARRAY_BUFFER_H_
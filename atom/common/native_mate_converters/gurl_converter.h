@@ -15,7 +15,12 @@ namespace mate {
 template <>
 struct Converter<GURL> {
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, const GURL& val) {
-    return ConvertToV8(isolate, val.spec());
+    // The spec of a valid URL is canonicalized to ASCII.
+    const std::string& spec = val.spec();
+    return v8::String::NewFromOneByte(
+               isolate, reinterpret_cast<const uint8_t*>(spec.data()),
+               v8::NewStringType::kNormal, static_cast<int>(spec.size()))
+        .ToLocalChecked();
   }
   static bool FromV8(v8::Isolate* isolate,
                      v8::Local<v8::Value> val,
@@ -5,6 +5,8 @@
 #ifndef ATOM_COMMON_NATIVE_MATE_CONVERTERS_STRING16_CONVERTER_H_
 #define ATOM_COMMON_NATIVE_MATE_CONVERTERS_STRING16_CONVERTER_H_
 
+#include <utility>
+
 #include "base/strings/string16.h"
 #include "native_mate/converter.h"
 
@@ -14,6 +16,10 @@ template <>
 struct Converter<base::string16> {
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
                                    const base::string16& val) {
+    v8::Local<v8::String> external;
+    if (val.size() >= kExternalStringMinLength &&
+        NewExternalString(isolate, base::string16(val)).ToLocal(&external))
+      return external;
     return v8::String::NewFromTwoByte(
         isolate, reinterpret_cast<const uint16_t*>(val.data()),
         v8::String::kNormalString, val.size());
@@ -24,6 +30,13 @@ struct Converter<base::string16> {
     if (!val->IsString())
       return false;
 
+    const auto* external = GetExternalTwoByteResource(val.As<v8::String>());
+    if (external) {
+      out->assign(reinterpret_cast<const base::char16*>(external->data()),
+                  external->length());
+      return true;
+    }
+
     v8::String::Value s(val);
     out->assign(reinterpret_cast<const base::char16*>(*s), s.length());
     return true;
@@ -35,6 +48,15 @@ inline v8::Local<v8::String> StringToV8(v8::Isolate* isolate,
   return ConvertToV8(isolate, input).As<v8::String>();
 }
 
+// Hands |input| to V8 without copying it when it is large.
+inline v8::Local<v8::String> StringToV8(v8::Isolate* isolate,
+                                        base::string16&& input) {
+  v8::Local<v8::String> external;
+  if (NewExternalString(isolate, std::move(input)).ToLocal(&external))
+    return external;
+  return StringToV8(isolate, static_cast<const base::string16&>(input));
+}
+
 }  // namespace mate
 
 #endif  // ATOM_COMMON_NATIVE_MATE_CONVERTERS_STRING16_CONVERTER_H_
@@ -4,9 +4,11 @@
 
 #include "atom/common/native_mate_converters/v8_value_converter.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -23,6 +25,42 @@ namespace {
 
 const int kMaxRecursionDepth = 100;
 
+// Converts |string| to UTF-8. One-byte strings, which are most of the strings
+// in practice, are copied directly instead of going through Utf8Value.
+std::string V8StringToUTF8(v8::Local<v8::String> string) {
+  if (!string->IsOneByte()) {
+    std::string result(string->Utf8Length(), '\0');
+    string->WriteUtf8(&result[0], static_cast<int>(result.size()), nullptr,
+                      v8::String::NO_NULL_TERMINATION);
+    return result;
+  }
+
+  int length = string->Length();
+  std::string result(length, '\0');
+  string->WriteOneByte(reinterpret_cast<uint8_t*>(&result[0]), 0, length,
+                       v8::String::NO_NULL_TERMINATION);
+
+  // Latin-1 characters above 0x7F take two bytes in UTF-8.
+  size_t non_ascii = std::count_if(result.begin(), result.end(), [](char c) {
+    return static_cast<uint8_t>(c) >= 0x80;
+  });
+  if (non_ascii == 0)
+    return result;
+
+  std::string utf8;
+  utf8.reserve(result.size() + non_ascii);
+  for (char c : result) {
+    uint8_t byte = static_cast<uint8_t>(c);
+    if (byte < 0x80) {
+      utf8.push_back(c);
+    } else {
+      utf8.push_back(static_cast<char>(0xC0 | (byte >> 6)));
+      utf8.push_back(static_cast<char>(0x80 | (byte & 0x3F)));
+    }
+  }
+  return utf8;
+}
+
 }  // namespace
 
 // The state of a call to FromV8Value.
@@ -70,6 +108,21 @@ class V8ValueConverter::FromV8ValueState {
 
   bool HasReachedMaxRecursionDepth() { return max_recursion_depth_ < 0; }
 
+  // Returns the UTF-8 form of the property name |key|. Objects of the same
+  // shape share the internalized strings of their keys, so in an array of
+  // similar objects each name is only converted once.
+  const std::string& GetPropertyName(v8::Local<v8::String> key) {
+    int hash = key->GetIdentityHash();
+    auto range = property_names_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.first == key)
+        return it->second.second;
+    }
+    auto it = property_names_.emplace(
+        hash, std::make_pair(key, V8StringToUTF8(key)));
+    return it->second.second;
+  }
+
  private:
   using HashToHandleMap = std::multimap<int, v8::Local<v8::Object>>;
   using Iterator = HashToHandleMap::const_iterator;
@@ -91,6 +144,9 @@ class V8ValueConverter::FromV8ValueState {
 
   HashToHandleMap unique_map_;
 
+  std::unordered_multimap<int, std::pair<v8::Local<v8::String>, std::string>>
+      property_names_;
+
   int max_recursion_depth_;
 };
 
@@ -316,10 +372,8 @@ base::Value* V8ValueConverter::FromV8ValueImpl(FromV8ValueState* state,
     return new base::Value(val_as_double);
   }
 
-  if (val->IsString()) {
-    v8::String::Utf8Value utf8(val->ToString(context).ToLocalChecked());
-    return new base::Value(std::string(*utf8, utf8.length()));
-  }
+  if (val->IsString())
+    return new base::Value(V8StringToUTF8(val.As<v8::String>()));
 
   if (val->IsUndefined())
     // JSON.stringify ignores undefined.
@@ -387,10 +441,12 @@ base::Value* V8ValueConverter::FromV8Array(v8::Local<v8::Array> val,
       val->CreationContext() != isolate->GetCurrentContext())
     scope.reset(new v8::Context::Scope(val->CreationContext()));
 
-  auto* result = new base::ListValue();
+  uint32_t length = val->Length();
+  base::Value::ListStorage result;
+  result.reserve(length);
 
   // Only fields with integer keys are carried over to the ListValue.
-  for (uint32_t i = 0; i < val->Length(); ++i) {
+  for (uint32_t i = 0; i < length; ++i) {
     v8::TryCatch try_catch(isolate);
     v8::Local<v8::Value> child_v8 = val->Get(i);
     if (try_catch.HasCaught()) {
@@ -398,18 +454,35 @@ base::Value* V8ValueConverter::FromV8Array(v8::Local<v8::Array> val,
       child_v8 = v8::Null(isolate);
     }
 
+    // Numbers make up most of the large arrays, they are stored directly
+    // instead of going through FromV8ValueImpl. Holes are read as undefined,
+    // so only the other values need to be checked.
+    if (child_v8->IsInt32()) {
+      result.emplace_back(child_v8.As<v8::Int32>()->Value());
+      continue;
+    }
+    if (child_v8->IsNumber()) {
+      double child_as_double = child_v8.As<v8::Number>()->Value();
+      if (std::isfinite(child_as_double))
+        result.emplace_back(child_as_double);
+      else
+        result.emplace_back();
+      continue;
+    }
+
     if (!val->HasRealIndexedProperty(i))
       continue;
 
-    base::Value* child = FromV8ValueImpl(state, child_v8, isolate);
+    std::unique_ptr<base::Value> child(
+        FromV8ValueImpl(state, child_v8, isolate));
     if (child)
-      result->Append(std::unique_ptr<base::Value>(child));
+      result.push_back(std::move(*child));
     else
       // JSON.stringify puts null in places where values don't serialize, for
       // example undefined and functions. Emulate that behavior.
-      result->Append(std::make_unique<base::Value>());
+      result.emplace_back();
   }
-  return result;
+  return new base::ListValue(std::move(result));
 }
 
 base::Value* V8ValueConverter::FromNodeBuffer(v8::Local<v8::Value> value,
@@ -434,10 +507,14 @@ base::Value* V8ValueConverter::FromV8Object(v8::Local<v8::Object> val,
       val->CreationContext() != isolate->GetCurrentContext())
     scope.reset(new v8::Context::Scope(val->CreationContext()));
 
-  auto result = std::make_unique<base::DictionaryValue>();
   v8::Local<v8::Array> property_names(val->GetOwnPropertyNames());
+  uint32_t length = property_names->Length();
+
+  // The entries are sorted once at the end, instead of on every insertion.
+  std::vector<base::Value::DictStorage::value_type> result;
+  result.reserve(length);
 
-  for (uint32_t i = 0; i < property_names->Length(); ++i) {
+  for (uint32_t i = 0; i < length; ++i) {
     v8::Local<v8::Value> key(property_names->Get(i));
 
     // Extend this test to cover more types as necessary and if sensible.
@@ -448,15 +525,17 @@ base::Value* V8ValueConverter::FromV8Object(v8::Local<v8::Object> val,
       continue;
     }
 
-    v8::String::Utf8Value name_utf8(
-        key->ToString(isolate->GetCurrentContext()).ToLocalChecked());
+    std::string name =
+        key->IsString()
+            ? state->GetPropertyName(key.As<v8::String>())
+            : V8StringToUTF8(
+                  key->ToString(isolate->GetCurrentContext()).ToLocalChecked());
 
     v8::TryCatch try_catch(isolate);
     v8::Local<v8::Value> child_v8 = val->Get(key);
 
     if (try_catch.HasCaught()) {
-      LOG(ERROR) << "Getter for property " << *name_utf8
-                 << " threw an exception.";
+      LOG(ERROR) << "Getter for property " << name << " threw an exception.";
       child_v8 = v8::Null(isolate);
     }
 
@@ -490,11 +569,11 @@ base::Value* V8ValueConverter::FromV8Object(v8::Local<v8::Object> val,
     if (strip_null_from_objects_ && child->is_none())
       continue;
 
-    result->SetWithoutPathExpansion(std::string(*name_utf8, name_utf8.length()),
-                                    std::move(child));
+    result.emplace_back(std::move(name), std::move(child));
   }
 
-  return result.release();
+  return new base::DictionaryValue(
+      base::Value::DictStorage(std::move(result), base::KEEP_LAST_OF_DUPES));
 }
 
 }  // namespace atom
@@ -10,10 +10,14 @@
 #include <utility>
 #include <vector>
 
+#include "atom/browser/microtasks_runner.h"
+#include "atom/browser/task_duration_monitor.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/api/locker.h"
 #include "atom/common/atom_command_line.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/environment.h"
@@ -41,6 +45,7 @@
   V(atom_browser_event)                      \
   V(atom_browser_global_shortcut)            \
   V(atom_browser_in_app_purchase)            \
+  V(atom_browser_json)                       \
   V(atom_browser_menu)                       \
   V(atom_browser_net)                        \
   V(atom_browser_power_monitor)              \
@@ -78,6 +83,8 @@
 
 #define ELECTRON_DESKTOP_CAPTURER_MODULE(V) V(atom_browser_desktop_capturer)
 
+#define ELECTRON_OSR_MODULE(V) V(atom_browser_offscreen_atlas)
+
 // This is used to load built-in modules. Instead of using
 // __attribute__((constructor)), we call the _register_<modname>
 // function for each built-in modules explicitly. This is only
@@ -91,6 +98,9 @@ ELECTRON_VIEW_MODULES(V)
 #if BUILDFLAG(ENABLE_DESKTOP_CAPTURER)
 ELECTRON_DESKTOP_CAPTURER_MODULE(V)
 #endif
+#if BUILDFLAG(ENABLE_OSR)
+ELECTRON_OSR_MODULE(V)
+#endif
 #undef V
 
 namespace {
@@ -124,6 +134,10 @@ namespace atom {
 
 namespace {
 
+// How long the main thread keeps running the uv loop while events are ready,
+// which is half of a frame at 60fps.
+constexpr base::TimeDelta kUvRunBudget = base::TimeDelta::FromMilliseconds(8);
+
 // Convert the given vector to an array of C-strings. The strings in the
 // returned vector are only guaranteed valid so long as the vector of strings
 // is not modified.
@@ -166,16 +180,18 @@ NodeBindings::NodeBindings(BrowserEnvironment browser_env)
 }
 
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
-  WakeupEmbedThread();
-
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+  if (embed_thread_started_) {
+    // Quit the embed thread.
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
+    WakeupEmbedThread();
+
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
+    uv_sem_destroy(&embed_sem_);
+  }
 
   // Clear uv.
-  uv_sem_destroy(&embed_sem_);
   uv_close(reinterpret_cast<uv_handle_t*>(&dummy_uv_handle_), nullptr);
 
   // Clean up worker loop
@@ -192,6 +208,9 @@ void NodeBindings::RegisterBuiltinModules() {
 #if BUILDFLAG(ENABLE_DESKTOP_CAPTURER)
   ELECTRON_DESKTOP_CAPTURER_MODULE(V)
 #endif
+#if BUILDFLAG(ENABLE_OSR)
+  ELECTRON_OSR_MODULE(V)
+#endif
 #undef V
 }
 
@@ -219,10 +238,14 @@ void NodeBindings::Initialize() {
 
   // pass non-null program name to argv so it doesn't crash
   // trying to index into a nullptr
-  int argc = 1;
+  std::vector<const char*> args = {"electron"};
+  // The worker threads of Node are only supported by the main process, the
+  // node environments of renderers have no platform to run them on.
+  if (browser_env_ == BROWSER)
+    args.push_back("--experimental-worker");
+  int argc = args.size();
   int exec_argc = 0;
-  const char* prog_name = "electron";
-  const char** argv = &prog_name;
+  const char** argv = args.data();
   const char** exec_argv = nullptr;
 
   std::unique_ptr<base::Environment> env(base::Environment::Create());
@@ -349,12 +372,14 @@ node::Environment* NodeBindings::CreateEnvironment(
   base::PathService::Get(content::CHILD_PROCESS_EXE, &helper_exec_path);
   process.Set("helperExecPath", helper_exec_path);
 
+  StartupTimeline::AddMark("nodeEnvironmentCreated");
   return env;
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
   node::LoadEnvironment(env);
   mate::EmitEvent(env->isolate(), env->process_object(), "loaded");
+  StartupTimeline::AddMark("nodeEnvironmentLoaded");
 }
 
 void NodeBindings::PrepareMessageLoop() {
@@ -362,9 +387,14 @@ void NodeBindings::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, &dummy_uv_handle_, nullptr);
 
+  // The message pump waits for the uv events by itself.
+  if (integrated_polling_)
+    return;
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
+  embed_thread_started_ = true;
 }
 
 void NodeBindings::RunMessageLoop() {
@@ -376,6 +406,7 @@ void NodeBindings::RunMessageLoop() {
 }
 
 void NodeBindings::UvRunOnce() {
+  TRACE_EVENT0("electron", "NodeBindings::UvRunOnce");
   node::Environment* env = uv_env();
 
   // When doing navigation without restarting renderer process, it may happen
@@ -391,30 +422,79 @@ void NodeBindings::UvRunOnce() {
   // Enter node context while dealing with uv events.
   v8::Context::Scope context_scope(env->context());
 
-  // Perform microtask checkpoint after running JavaScript.
-  v8::MicrotasksScope script_scope(env->isolate(),
-                                   v8::MicrotasksScope::kRunMicrotasks);
+  // Keep running the loop while new events are ready, so a burst of them is
+  // handled in one wakeup, but give the other tasks a chance after a while.
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::TimeTicks now = start;
+  int r;
+  while (true) {
+    {
+      // Perform microtask checkpoint after running JavaScript.
+      v8::MicrotasksScope script_scope(env->isolate(),
+                                       v8::MicrotasksScope::kRunMicrotasks);
 
-  if (browser_env_ != BROWSER)
-    TRACE_EVENT_BEGIN0("devtools.timeline", "FunctionCall");
+      if (browser_env_ != BROWSER)
+        TRACE_EVENT_BEGIN0("devtools.timeline", "FunctionCall");
 
-  // Deal with uv events.
-  int r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+      // Deal with uv events.
+      r = uv_run(uv_loop_, UV_RUN_NOWAIT);
 
-  if (browser_env_ != BROWSER)
-    TRACE_EVENT_END0("devtools.timeline", "FunctionCall");
+      if (browser_env_ != BROWSER)
+        TRACE_EVENT_END0("devtools.timeline", "FunctionCall");
+    }
+
+    ++uv_run_stats_.passes;
+    now = base::TimeTicks::Now();
+    if (r == 0 || !HasPendingEvents())
+      break;
+    if (now - start >= kUvRunBudget) {
+      ++uv_run_stats_.budget_exhausted;
+      break;
+    }
+  }
+
+  ++uv_run_stats_.wakeups;
+  uv_run_stats_.total_run_time += now - start;
+
+  // The tasks of the V8 platform run in the loop, and may settle promises
+  // without running a script, like an async WebAssembly compilation.
+  if (browser_env_ == BROWSER) {
+    MicrotasksRunner::NotifyMicrotasksQueued(env->isolate());
+    TaskDurationMonitor::RecordUvRun(now - start);
+  }
 
   if (r == 0)
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
   // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  if (embed_thread_started_)
+    uv_sem_post(&embed_sem_);
+}
+
+// static
+bool NodeBindings::IsIntegratedPollingEnabled(BrowserEnvironment browser_env) {
+  return browser_env == BROWSER &&
+         base::CommandLine::ForCurrentProcess()->HasSwitch(
+             switches::kIntegrateNodePolling);
+}
+
+bool NodeBindings::HasPendingEvents() {
+  return false;
+}
+
+void NodeBindings::UvRunOnceAfterWakeup(base::TimeTicks wakeup_time) {
+  base::TimeDelta latency = base::TimeTicks::Now() - wakeup_time;
+  uv_run_stats_.total_latency += latency;
+  uv_run_stats_.max_latency = std::max(uv_run_stats_.max_latency, latency);
+  UvRunOnce();
 }
 
 void NodeBindings::WakeupMainThread() {
   DCHECK(task_runner_);
-  task_runner_->PostTask(FROM_HERE, base::BindOnce(&NodeBindings::UvRunOnce,
-                                                   weak_factory_.GetWeakPtr()));
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&NodeBindings::UvRunOnceAfterWakeup,
+                                weak_factory_.GetWeakPtr(),
+                                base::TimeTicks::Now()));
 }
 
 void NodeBindings::WakeupEmbedThread() {
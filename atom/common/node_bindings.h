@@ -9,6 +9,7 @@
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "uv.h"  // NOLINT(build/include)
 #include "v8/include/v8.h"
 
@@ -31,6 +32,21 @@ class NodeBindings {
     WORKER,
   };
 
+  // Counters of how the uv loop is run by the main thread.
+  struct UvRunStats {
+    // Times the main thread ran the uv loop.
+    uint64_t wakeups = 0;
+    // Calls to uv_run, there can be several of them in one wakeup.
+    uint64_t passes = 0;
+    // Wakeups that stopped with events left because of the time budget.
+    uint64_t budget_exhausted = 0;
+    // From the embed thread seeing events to the main thread running them.
+    base::TimeDelta total_latency;
+    base::TimeDelta max_latency;
+    // Time spent in uv_run.
+    base::TimeDelta total_run_time;
+  };
+
   static NodeBindings* Create(BrowserEnvironment browser_env);
   static void RegisterBuiltinModules();
   static bool IsInitialized();
@@ -61,12 +77,21 @@ class NodeBindings {
 
   uv_loop_t* uv_loop() const { return uv_loop_; }
 
+  const UvRunStats& uv_run_stats() const { return uv_run_stats_; }
+
  protected:
   explicit NodeBindings(BrowserEnvironment browser_env);
 
+  // Whether the switch asks the main thread's message pump to watch uv's
+  // backend fd itself. Only the browser process supports it.
+  static bool IsIntegratedPollingEnabled(BrowserEnvironment browser_env);
+
   // Called to poll events in new thread.
   virtual void PollEvents() = 0;
 
+  // Whether uv's backend fd has events that are ready, without waiting.
+  virtual bool HasPendingEvents();
+
   // Run the libuv loop for once.
   void UvRunOnce();
 
@@ -85,10 +110,20 @@ class NodeBindings {
   // Current thread's libuv loop.
   uv_loop_t* uv_loop_;
 
+  // Set by derived classes that let the message pump of the main thread poll
+  // uv's backend fd, in which case no embed thread is started.
+  bool integrated_polling_ = false;
+
  private:
   // Thread to poll uv events.
   static void EmbedThreadRunner(void* arg);
 
+  // Run the libuv loop for the events seen by the embed thread at
+  // |wakeup_time|.
+  void UvRunOnceAfterWakeup(base::TimeTicks wakeup_time);
+
+  UvRunStats uv_run_stats_;
+
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
@@ -100,6 +135,7 @@ class NodeBindings {
 
   // Thread for polling events.
   uv_thread_t embed_thread_;
+  bool embed_thread_started_ = false;
 
   // Semaphore to wait for main loop in the embed thread.
   uv_sem_t embed_sem_;
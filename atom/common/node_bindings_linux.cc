@@ -6,8 +6,23 @@
 
 #include <sys/epoll.h>
 
+#if defined(USE_GLIB)
+#include <glib.h>
+#endif
+
 namespace atom {
 
+#if defined(USE_GLIB)
+struct NodeBindingsLinux::UvSource {
+  GSource source;
+  GPollFD poll_fd;
+  NodeBindingsLinux* bindings;
+  // When the nearest uv timer is due, in the time of g_source_get_time(), or
+  // -1 when there is no timer.
+  gint64 deadline;
+};
+#endif
+
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
     : NodeBindings(browser_env), epoll_(epoll_create(1)) {
   int backend_fd = uv_backend_fd(uv_loop_);
@@ -15,15 +30,31 @@ NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
   ev.events = EPOLLIN;
   ev.data.fd = backend_fd;
   epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
+
+#if defined(USE_GLIB)
+  integrated_polling_ = IsIntegratedPollingEnabled(browser_env);
+#endif
 }
 
-NodeBindingsLinux::~NodeBindingsLinux() {}
+NodeBindingsLinux::~NodeBindingsLinux() {
+#if defined(USE_GLIB)
+  if (uv_source_) {
+    g_source_destroy(uv_source_);
+    g_source_unref(uv_source_);
+  }
+#endif
+}
 
 void NodeBindingsLinux::RunMessageLoop() {
   // Get notified when libuv's watcher queue changes.
   uv_loop_->data = this;
   uv_loop_->on_watcher_queue_updated = OnWatcherQueueChanged;
 
+#if defined(USE_GLIB)
+  if (integrated_polling_)
+    AttachUvSource();
+#endif
+
   NodeBindings::RunMessageLoop();
 }
 
@@ -32,7 +63,9 @@ void NodeBindingsLinux::OnWatcherQueueChanged(uv_loop_t* loop) {
   NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(loop->data);
 
   // We need to break the io polling in the epoll thread when loop's watcher
-  // queue changes, otherwise new events cannot be notified.
+  // queue changes, otherwise new events cannot be notified. Without the
+  // thread this makes the backend fd readable, so the uv loop runs and adds
+  // the new watchers to its epoll.
   self->WakeupEmbedThread();
 }
 
@@ -47,6 +80,61 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+bool NodeBindingsLinux::HasPendingEvents() {
+  struct epoll_event ev;
+  return epoll_wait(epoll_, &ev, 1, 0) > 0;
+}
+
+#if defined(USE_GLIB)
+// static
+gboolean NodeBindingsLinux::UvSourcePrepare(GSource* source, gint* timeout) {
+  auto* self = reinterpret_cast<UvSource*>(source);
+  uv_loop_t* loop = self->bindings->uv_loop_;
+
+  // The timeout is relative to the loop's time, which is stale when the main
+  // thread has been busy with other tasks.
+  uv_update_time(loop);
+  *timeout = uv_backend_timeout(loop);
+  if (*timeout < 0)
+    self->deadline = -1;
+  else
+    self->deadline = g_source_get_time(source) + *timeout * gint64{1000};
+  return *timeout == 0;
+}
+
+// static
+gboolean NodeBindingsLinux::UvSourceCheck(GSource* source) {
+  auto* self = reinterpret_cast<UvSource*>(source);
+  if (self->poll_fd.revents & G_IO_IN)
+    return TRUE;
+  return self->deadline >= 0 && g_source_get_time(source) >= self->deadline;
+}
+
+// static
+gboolean NodeBindingsLinux::UvSourceDispatch(GSource* source,
+                                             GSourceFunc callback,
+                                             gpointer user_data) {
+  reinterpret_cast<UvSource*>(source)->bindings->UvRunOnce();
+  return G_SOURCE_CONTINUE;
+}
+
+void NodeBindingsLinux::AttachUvSource() {
+  static GSourceFuncs uv_source_funcs = {UvSourcePrepare, UvSourceCheck,
+                                         UvSourceDispatch, nullptr};
+
+  uv_source_ = g_source_new(&uv_source_funcs, sizeof(UvSource));
+  auto* source = reinterpret_cast<UvSource*>(uv_source_);
+  source->bindings = this;
+  source->deadline = -1;
+  source->poll_fd.fd = uv_backend_fd(uv_loop_);
+  source->poll_fd.events = G_IO_IN;
+  source->poll_fd.revents = 0;
+  g_source_add_poll(uv_source_, &source->poll_fd);
+  g_source_set_can_recurse(uv_source_, FALSE);
+  g_source_attach(uv_source_, g_main_context_default());
+}
+#endif
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
@@ -8,6 +8,10 @@
 #include "atom/common/node_bindings.h"
 #include "base/compiler_specific.h"
 
+#if defined(USE_GLIB)
+typedef struct _GSource GSource;
+#endif
+
 namespace atom {
 
 class NodeBindingsLinux : public NodeBindings {
@@ -22,6 +26,24 @@ class NodeBindingsLinux : public NodeBindings {
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
   void PollEvents() override;
+  bool HasPendingEvents() override;
+
+#if defined(USE_GLIB)
+  struct UvSource;
+
+  // The GSourceFuncs of |uv_source_|.
+  static int UvSourcePrepare(GSource* source, int* timeout);
+  static int UvSourceCheck(GSource* source);
+  static int UvSourceDispatch(GSource* source,
+                              int (*callback)(void*),
+                              void* user_data);
+
+  // Adds the source to the glib main context, which polls uv's backend fd
+  // in the same poll() as the other events of the main thread.
+  void AttachUvSource();
+
+  GSource* uv_source_ = nullptr;
+#endif
 
   // Epoll to poll for uv's backend fd.
   int epoll_;
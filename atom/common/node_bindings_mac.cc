@@ -15,15 +15,27 @@
 namespace atom {
 
 NodeBindingsMac::NodeBindingsMac(BrowserEnvironment browser_env)
-    : NodeBindings(browser_env) {}
+    : NodeBindings(browser_env) {
+  integrated_polling_ = IsIntegratedPollingEnabled(browser_env);
+}
 
-NodeBindingsMac::~NodeBindingsMac() {}
+NodeBindingsMac::~NodeBindingsMac() {
+  if (observer_)
+    CFRunLoopObserverInvalidate(observer_);
+  if (uv_timer_)
+    CFRunLoopTimerInvalidate(uv_timer_);
+  if (backend_fd_ref_)
+    CFFileDescriptorInvalidate(backend_fd_ref_);
+}
 
 void NodeBindingsMac::RunMessageLoop() {
   // Get notified when libuv's watcher queue changes.
   uv_loop_->data = this;
   uv_loop_->on_watcher_queue_updated = OnWatcherQueueChanged;
 
+  if (integrated_polling_)
+    AttachToRunLoop();
+
   NodeBindings::RunMessageLoop();
 }
 
@@ -57,6 +69,76 @@ void NodeBindingsMac::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+bool NodeBindingsMac::HasPendingEvents() {
+  fd_set readset;
+  int fd = uv_backend_fd(uv_loop_);
+  FD_ZERO(&readset);
+  FD_SET(fd, &readset);
+
+  struct timeval tv = {0, 0};
+  return select(fd + 1, &readset, nullptr, nullptr, &tv) > 0;
+}
+
+// static
+void NodeBindingsMac::OnBackendFdReadable(CFFileDescriptorRef fd_ref,
+                                          CFOptionFlags flags,
+                                          void* info) {
+  static_cast<NodeBindingsMac*>(info)->UvRunOnce();
+  // The callbacks are disabled each time they fire.
+  CFFileDescriptorEnableCallBacks(fd_ref, kCFFileDescriptorReadCallBack);
+}
+
+// static
+void NodeBindingsMac::OnUvTimer(CFRunLoopTimerRef timer, void* info) {
+  static_cast<NodeBindingsMac*>(info)->UvRunOnce();
+}
+
+// static
+void NodeBindingsMac::OnBeforeWaiting(CFRunLoopObserverRef observer,
+                                      CFRunLoopActivity activity,
+                                      void* info) {
+  // Timers may have been added by the tasks run in this iteration.
+  static_cast<NodeBindingsMac*>(info)->ScheduleUvTimer();
+}
+
+void NodeBindingsMac::AttachToRunLoop() {
+  CFRunLoopRef run_loop = CFRunLoopGetCurrent();
+
+  CFFileDescriptorContext fd_context = {0, this, nullptr, nullptr, nullptr};
+  backend_fd_ref_.reset(CFFileDescriptorCreate(
+      nullptr, uv_backend_fd(uv_loop_), false, OnBackendFdReadable,
+      &fd_context));
+  CFFileDescriptorEnableCallBacks(backend_fd_ref_,
+                                  kCFFileDescriptorReadCallBack);
+  base::ScopedCFTypeRef<CFRunLoopSourceRef> source(
+      CFFileDescriptorCreateRunLoopSource(nullptr, backend_fd_ref_, 0));
+  CFRunLoopAddSource(run_loop, source, kCFRunLoopCommonModes);
+
+  // Same as the delayed work timer of base::MessagePumpCFRunLoopBase, the
+  // timer never fires until ScheduleUvTimer() sets its fire date.
+  CFRunLoopTimerContext timer_context = {0, this, nullptr, nullptr, nullptr};
+  uv_timer_.reset(CFRunLoopTimerCreate(nullptr, kCFTimeIntervalMax,
+                                       kCFTimeIntervalMax, 0, 0, OnUvTimer,
+                                       &timer_context));
+  CFRunLoopAddTimer(run_loop, uv_timer_, kCFRunLoopCommonModes);
+
+  CFRunLoopObserverContext observer_context = {0, this, nullptr, nullptr,
+                                               nullptr};
+  observer_.reset(CFRunLoopObserverCreate(nullptr, kCFRunLoopBeforeWaiting,
+                                          true, 0, OnBeforeWaiting,
+                                          &observer_context));
+  CFRunLoopAddObserver(run_loop, observer_, kCFRunLoopCommonModes);
+}
+
+void NodeBindingsMac::ScheduleUvTimer() {
+  uv_update_time(uv_loop_);
+  int timeout = uv_backend_timeout(uv_loop_);
+  CFAbsoluteTime fire_date = kCFTimeIntervalMax;
+  if (timeout >= 0)
+    fire_date = CFAbsoluteTimeGetCurrent() + timeout / 1000.0;
+  CFRunLoopTimerSetNextFireDate(uv_timer_, fire_date);
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsMac(browser_env);
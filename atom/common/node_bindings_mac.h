@@ -5,8 +5,11 @@
 #ifndef ATOM_COMMON_NODE_BINDINGS_MAC_H_
 #define ATOM_COMMON_NODE_BINDINGS_MAC_H_
 
+#include <CoreFoundation/CoreFoundation.h>
+
 #include "atom/common/node_bindings.h"
 #include "base/compiler_specific.h"
+#include "base/mac/scoped_cftyperef.h"
 
 namespace atom {
 
@@ -22,6 +25,26 @@ class NodeBindingsMac : public NodeBindings {
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
   void PollEvents() override;
+  bool HasPendingEvents() override;
+
+  // Called by the run loop of the main thread when polling integrated.
+  static void OnBackendFdReadable(CFFileDescriptorRef fd_ref,
+                                  CFOptionFlags flags,
+                                  void* info);
+  static void OnUvTimer(CFRunLoopTimerRef timer, void* info);
+  static void OnBeforeWaiting(CFRunLoopObserverRef observer,
+                              CFRunLoopActivity activity,
+                              void* info);
+
+  // Watches uv's backend fd and timers in the run loop of the main thread.
+  void AttachToRunLoop();
+
+  // Moves |uv_timer_| to when the nearest uv timer is due.
+  void ScheduleUvTimer();
+
+  base::ScopedCFTypeRef<CFFileDescriptorRef> backend_fd_ref_;
+  base::ScopedCFTypeRef<CFRunLoopTimerRef> uv_timer_;
+  base::ScopedCFTypeRef<CFRunLoopObserverRef> observer_;
 
   DISALLOW_COPY_AND_ASSIGN(NodeBindingsMac);
 };
@@ -0,0 +1,69 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/node_worker_isolate.h"
+
+#include <set>
+
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
+#include "content/public/browser/browser_thread.h"
+#include "gin/array_buffer.h"
+#include "gin/per_isolate_data.h"
+#include "gin/public/isolate_holder.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+namespace {
+
+struct WorkerIsolates {
+  base::Lock lock;
+  std::set<v8::Isolate*> isolates;
+};
+
+base::LazyInstance<WorkerIsolates>::Leaky g_worker_isolates =
+    LAZY_INSTANCE_INITIALIZER;
+
+void FreeWorkerIsolateData(void* arg) {
+  auto* data = static_cast<gin::PerIsolateData*>(arg);
+  {
+    WorkerIsolates& workers = g_worker_isolates.Get();
+    base::AutoLock auto_lock(workers.lock);
+    workers.isolates.erase(data->isolate());
+  }
+  delete data;
+}
+
+}  // namespace
+
+void PrepareNodeWorkerIsolate(v8::Isolate* isolate) {
+  // The isolates of the main thread and of the renderer's workers are all
+  // created by gin.
+  if (gin::PerIsolateData::From(isolate))
+    return;
+
+  // The worker threads of Node only exist in the main process. The task
+  // runner is only used by gin's platform, which Electron does not use.
+  auto* data = new gin::PerIsolateData(
+      isolate, gin::ArrayBufferAllocator::SharedInstance(),
+      gin::IsolateHolder::kSingleThread,
+      content::BrowserThread::GetTaskRunnerForThread(
+          content::BrowserThread::UI));
+  {
+    WorkerIsolates& workers = g_worker_isolates.Get();
+    base::AutoLock auto_lock(workers.lock);
+    workers.isolates.insert(isolate);
+  }
+  node::AddEnvironmentCleanupHook(isolate, &FreeWorkerIsolateData, data);
+}
+
+bool IsNodeWorkerIsolate(v8::Isolate* isolate) {
+  WorkerIsolates& workers = g_worker_isolates.Get();
+  base::AutoLock auto_lock(workers.lock);
+  return workers.isolates.count(isolate) > 0;
+}
+
+}  // namespace atom
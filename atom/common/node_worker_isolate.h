@@ -0,0 +1,26 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_NODE_WORKER_ISOLATE_H_
+#define ATOM_COMMON_NODE_WORKER_ISOLATE_H_
+
+namespace v8 {
+class Isolate;
+}
+
+namespace atom {
+
+// The worker threads of Node create isolates of their own, which lack the gin
+// data that native_mate keeps the templates of wrappable objects in. The
+// native modules that support worker threads call this in their Initialize,
+// it creates the data for the isolate of a worker, and frees it with the
+// worker's environment.
+void PrepareNodeWorkerIsolate(v8::Isolate* isolate);
+
+// Whether |isolate| belongs to a worker thread of Node.
+bool IsNodeWorkerIsolate(v8::Isolate* isolate);
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_NODE_WORKER_ISOLATE_H_
@@ -65,6 +65,12 @@ const char kAutoHideMenuBar[] = "autoHideMenuBar";
 // Enable window to be resized larger than screen.
 const char kEnableLargerThanScreen[] = "enableLargerThanScreen";
 
+// Emit the resize and move events at most once per frame.
+const char kCoalesceBoundsEvents[] = "coalesceBoundsEvents";
+
+// Stop rendering the contents while the window is covered.
+const char kOcclusionTracking[] = "occlusionTracking";
+
 // Forces to use dark theme on Linux.
 const char kDarkTheme[] = "darkTheme";
 
@@ -128,6 +134,9 @@ const char kOpenerID[] = "openerId";
 // Enable the rubber banding effect.
 const char kScrollBounce[] = "scrollBounce";
 
+// The GPU WebGL contexts of the page run on by default.
+const char kGpuPreference[] = "gpuPreference";
+
 // Enable blink features.
 const char kEnableBlinkFeatures[] = "enableBlinkFeatures";
 
@@ -154,6 +163,10 @@ const char kAllowRunningInsecureContent[] = "allowRunningInsecureContent";
 
 const char kOffscreen[] = "offscreen";
 
+const char kSharedTexture[] = "sharedTexture";
+
+const char kPaintRegions[] = "paintRegions";
+
 }  // namespace options
 
 namespace switches {
@@ -191,6 +204,15 @@ const char kAppUserModelId[] = "app-user-model-id";
 // The application path
 const char kAppPath[] = "app-path";
 
+// Where files extracted from asar archives are cached.
+const char kAsarExtractionCache[] = "asar-extraction-cache";
+
+// Where the V8 code cache of the scripts in asar archives is kept.
+const char kAsarCodeCache[] = "asar-code-cache";
+
+// The renderer was launched ahead of time and waits for a page.
+const char kSpareRenderer[] = "spare-renderer";
+
 // The command line switch versions of the options.
 const char kBackgroundColor[] = "background-color";
 const char kPreloadScript[] = "preload";
@@ -201,6 +223,7 @@ const char kContextIsolation[] = "context-isolation";
 const char kGuestInstanceID[] = "guest-instance-id";
 const char kOpenerID[] = "opener-id";
 const char kScrollBounce[] = "scroll-bounce";
+const char kGpuPreference[] = "gpu-preference";
 const char kHiddenPage[] = "hidden-page";
 const char kNativeWindowOpen[] = "native-window-open";
 const char kWebviewTag[] = "webview-tag";
@@ -220,6 +243,24 @@ const char kDiskCacheSize[] = "disk-cache-size";
 // Ignore the limit of 6 connections per host.
 const char kIgnoreConnectionsLimit[] = "ignore-connections-limit";
 
+// Split downloads into this many ranged requests when the server allows it.
+const char kParallelDownloadConnections[] = "parallel-download-connections";
+
+// Let the message loop of the main process poll the uv events, instead of a
+// separate thread that wakes it up.
+const char kIntegrateNodePolling[] = "integrate-node-polling";
+
+// Subsystems of the main process that are initialized once the first window
+// has painted, separated by ",".
+const char kDeferInitialization[] = "defer-initialization";
+
+// Run the microtasks of the main process once the tasks that were queued have
+// run, instead of after each task.
+const char kBatchMicrotaskCheckpoints[] = "batch-microtask-checkpoints";
+
+// The number of threads V8 runs its background tasks on in the main process.
+const char kJsWorkerThreads[] = "js-worker-threads";
+
 // Whitelist containing servers for which Integrated Authentication is enabled.
 const char kAuthServerWhitelist[] = "auth-server-whitelist";
 
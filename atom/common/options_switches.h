@@ -41,6 +41,8 @@ extern const char kTitleBarStyle[];
 extern const char kTabbingIdentifier[];
 extern const char kAutoHideMenuBar[];
 extern const char kEnableLargerThanScreen[];
+extern const char kCoalesceBoundsEvents[];
+extern const char kOcclusionTracking[];
 extern const char kDarkTheme[];
 extern const char kTransparent[];
 extern const char kType[];
@@ -64,6 +66,7 @@ extern const char kGuestInstanceID[];
 extern const char kExperimentalFeatures[];
 extern const char kOpenerID[];
 extern const char kScrollBounce[];
+extern const char kGpuPreference[];
 extern const char kEnableBlinkFeatures[];
 extern const char kDisableBlinkFeatures[];
 extern const char kNodeIntegrationInWorker[];
@@ -75,6 +78,8 @@ extern const char kSandbox[];
 extern const char kWebSecurity[];
 extern const char kAllowRunningInsecureContent[];
 extern const char kOffscreen[];
+extern const char kSharedTexture[];
+extern const char kPaintRegions[];
 
 }  // namespace options
 
@@ -93,6 +98,9 @@ extern const char kRegisterServiceWorkerSchemes[];
 extern const char kSecureSchemes[];
 extern const char kAppUserModelId[];
 extern const char kAppPath[];
+extern const char kAsarExtractionCache[];
+extern const char kAsarCodeCache[];
+extern const char kSpareRenderer[];
 
 extern const char kBackgroundColor[];
 extern const char kPreloadScript[];
@@ -103,6 +111,7 @@ extern const char kContextIsolation[];
 extern const char kGuestInstanceID[];
 extern const char kOpenerID[];
 extern const char kScrollBounce[];
+extern const char kGpuPreference[];
 extern const char kHiddenPage[];
 extern const char kNativeWindowOpen[];
 extern const char kNodeIntegrationInWorker[];
@@ -113,6 +122,11 @@ extern const char kWidevineCdmVersion[];
 
 extern const char kDiskCacheSize[];
 extern const char kIgnoreConnectionsLimit[];
+extern const char kParallelDownloadConnections[];
+extern const char kIntegrateNodePolling[];
+extern const char kDeferInitialization[];
+extern const char kBatchMicrotaskCheckpoints[];
+extern const char kJsWorkerThreads[];
 extern const char kAuthServerWhitelist[];
 extern const char kAuthNegotiateDelegateWhitelist[];
 
@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "atom/browser/microtasks_runner.h"
 #include "content/public/browser/browser_thread.h"
 #include "native_mate/converter.h"
 
@@ -23,11 +24,13 @@ class Promise : public base::RefCounted<Promise> {
   virtual v8::Local<v8::Promise> GetHandle() const;
 
   v8::Maybe<bool> Resolve() {
+    MicrotasksRunner::NotifyMicrotasksQueued(isolate());
     return GetInner()->Resolve(isolate()->GetCurrentContext(),
                                v8::Undefined(isolate()));
   }
 
   v8::Maybe<bool> Reject() {
+    MicrotasksRunner::NotifyMicrotasksQueued(isolate());
     return GetInner()->Reject(isolate()->GetCurrentContext(),
                               v8::Undefined(isolate()));
   }
@@ -36,12 +39,14 @@ class Promise : public base::RefCounted<Promise> {
   // We use the MicrotasksRunner to trigger the running of pending microtasks
   template <typename T>
   v8::Maybe<bool> Resolve(const T& value) {
+    MicrotasksRunner::NotifyMicrotasksQueued(isolate());
     return GetInner()->Resolve(isolate()->GetCurrentContext(),
                                mate::ConvertToV8(isolate(), value));
   }
 
   template <typename T>
   v8::Maybe<bool> Reject(const T& value) {
+    MicrotasksRunner::NotifyMicrotasksQueued(isolate());
     return GetInner()->Reject(isolate()->GetCurrentContext(),
                               mate::ConvertToV8(isolate(), value));
   }
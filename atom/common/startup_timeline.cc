@@ -0,0 +1,69 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/startup_timeline.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "base/lazy_instance.h"
+#include "base/process/process_info.h"
+#include "base/trace_event/trace_event.h"
+#include "base/values.h"
+
+namespace atom {
+
+namespace {
+
+base::LazyInstance<StartupTimeline>::Leaky g_startup_timeline =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+StartupTimeline::StartupTimeline() = default;
+
+StartupTimeline::~StartupTimeline() = default;
+
+// static
+StartupTimeline* StartupTimeline::GetInstance() {
+  return g_startup_timeline.Pointer();
+}
+
+// static
+void StartupTimeline::AddMark(const char* name) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  StartupTimeline* self = GetInstance();
+  {
+    base::AutoLock auto_lock(self->lock_);
+    for (const Mark& mark : self->marks_) {
+      if (strcmp(mark.name, name) == 0)
+        return;
+    }
+    self->marks_.push_back({name, now});
+  }
+  TRACE_EVENT_INSTANT0("startup", name, TRACE_EVENT_SCOPE_PROCESS);
+}
+
+std::unique_ptr<base::ListValue> StartupTimeline::GetMarks() {
+  // The process creation time is only known as a wall clock time.
+  base::TimeTicks origin;
+  base::Time creation_time = base::CurrentProcessInfo::CreationTime();
+  if (!creation_time.is_null())
+    origin = base::TimeTicks::Now() - (base::Time::Now() - creation_time);
+
+  auto result = std::make_unique<base::ListValue>();
+  base::AutoLock auto_lock(lock_);
+  if (origin.is_null() && !marks_.empty())
+    origin = marks_.front().time;
+  for (const Mark& mark : marks_) {
+    auto dict = std::make_unique<base::DictionaryValue>();
+    dict->SetString("name", mark.name);
+    dict->SetDouble("time", (mark.time - origin).InMillisecondsF());
+    result->Append(std::move(dict));
+  }
+  return result;
+}
+
+}  // namespace atom
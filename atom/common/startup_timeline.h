@@ -0,0 +1,53 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_STARTUP_TIMELINE_H_
+#define ATOM_COMMON_STARTUP_TIMELINE_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+namespace base {
+class ListValue;
+}
+
+namespace atom {
+
+// The times at which the process reached the phases of its startup. Every
+// mark is also emitted as an instant trace event of the "startup" category.
+class StartupTimeline {
+ public:
+  struct Mark {
+    const char* name;
+    base::TimeTicks time;
+  };
+
+  StartupTimeline();
+  ~StartupTimeline();
+
+  static StartupTimeline* GetInstance();
+
+  // Only the first mark of each |name| is recorded, later ones are about
+  // contexts and environments that are created after startup. |name| must be
+  // a string literal.
+  static void AddMark(const char* name);
+
+  // Returns [{name, time}] with the times in milliseconds since the process
+  // was launched.
+  std::unique_ptr<base::ListValue> GetMarks();
+
+ private:
+  base::Lock lock_;
+  std::vector<Mark> marks_;
+
+  DISALLOW_COPY_AND_ASSIGN(StartupTimeline);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_STARTUP_TIMELINE_H_
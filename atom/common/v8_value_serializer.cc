@@ -0,0 +1,488 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/v8_value_serializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "native_mate/converter.h"
+
+namespace atom {
+
+namespace {
+
+// Transferred ArrayBuffers that are smaller than this are copied into the
+// message, the cost of setting up shared memory is higher.
+const size_t kSharedMemoryThreshold = 64 * 1024;
+
+// Keeps the shared memory of a transferred ArrayBuffer mapped until the
+// ArrayBuffer is garbage collected.
+class MappedArrayBuffer {
+ public:
+  static v8::Local<v8::ArrayBuffer> Create(
+      v8::Isolate* isolate,
+      base::WritableSharedMemoryMapping mapping) {
+    auto* self = new MappedArrayBuffer(isolate, std::move(mapping));
+    v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(
+        isolate, self->mapping_.memory(), self->mapping_.size(),
+        v8::ArrayBufferCreationMode::kExternalized);
+    self->buffer_.Reset(isolate, buffer);
+    self->buffer_.SetWeak(self, &MappedArrayBuffer::OnGarbageCollected,
+                          v8::WeakCallbackType::kParameter);
+    isolate->AdjustAmountOfExternalAllocatedMemory(self->mapping_.size());
+    return buffer;
+  }
+
+ private:
+  MappedArrayBuffer(v8::Isolate* isolate,
+                    base::WritableSharedMemoryMapping mapping)
+      : isolate_(isolate), mapping_(std::move(mapping)) {}
+
+  ~MappedArrayBuffer() {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(
+        -static_cast<int64_t>(mapping_.size()));
+  }
+
+  static void OnGarbageCollected(
+      const v8::WeakCallbackInfo<MappedArrayBuffer>& data) {
+    delete data.GetParameter();
+  }
+
+  v8::Isolate* isolate_;
+  base::WritableSharedMemoryMapping mapping_;
+  v8::Global<v8::ArrayBuffer> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedArrayBuffer);
+};
+
+// Detaches |buffer| from its isolate, like postMessage does for transferred
+// ArrayBuffers.
+void DetachArrayBuffer(v8::Local<v8::ArrayBuffer> buffer) {
+  if (!buffer->IsNeuterable())
+    return;
+  if (buffer->IsExternal()) {
+    buffer->Neuter();
+    return;
+  }
+  // Only externalized buffers can be neutered, the memory is ours after that.
+  v8::ArrayBuffer::Contents contents = buffer->Externalize();
+  buffer->Neuter();
+  contents.Deleter()(contents.Data(), contents.ByteLength(),
+                     contents.DeleterData());
+}
+
+// Typed arrays are written as host objects so that only the viewed part of
+// the ArrayBuffer is copied, node's Buffers are usually slices of a larger
+// pool.
+enum ArrayBufferViewTag : uint32_t {
+  kInt8Array = 0,
+  kUint8Array,
+  kUint8ClampedArray,
+  kInt16Array,
+  kUint16Array,
+  kInt32Array,
+  kUint32Array,
+  kFloat32Array,
+  kFloat64Array,
+  kDataView,
+};
+
+// Set on the tag of a view whose ArrayBuffer is transferred, the view then
+// refers to the transferred ArrayBuffer instead of carrying a copy.
+const uint32_t kTransferredViewFlag = 1 << 8;
+
+bool GetArrayBufferViewTag(v8::Local<v8::ArrayBufferView> view,
+                           uint32_t* tag) {
+  if (view->IsInt8Array())
+    *tag = kInt8Array;
+  else if (view->IsUint8Array())
+    *tag = kUint8Array;
+  else if (view->IsUint8ClampedArray())
+    *tag = kUint8ClampedArray;
+  else if (view->IsInt16Array())
+    *tag = kInt16Array;
+  else if (view->IsUint16Array())
+    *tag = kUint16Array;
+  else if (view->IsInt32Array())
+    *tag = kInt32Array;
+  else if (view->IsUint32Array())
+    *tag = kUint32Array;
+  else if (view->IsFloat32Array())
+    *tag = kFloat32Array;
+  else if (view->IsFloat64Array())
+    *tag = kFloat64Array;
+  else if (view->IsDataView())
+    *tag = kDataView;
+  else
+    return false;
+  return true;
+}
+
+// Creates the view |tag| of |length| bytes at |offset| of |buffer|.
+v8::MaybeLocal<v8::Object> CreateArrayBufferView(
+    uint32_t tag,
+    v8::Local<v8::ArrayBuffer> buffer,
+    size_t offset,
+    size_t length) {
+  if (offset > buffer->ByteLength() || length > buffer->ByteLength() - offset)
+    return v8::MaybeLocal<v8::Object>();
+  switch (tag) {
+    case kInt8Array:
+      return v8::Int8Array::New(buffer, offset, length);
+    case kUint8Array:
+      return v8::Uint8Array::New(buffer, offset, length);
+    case kUint8ClampedArray:
+      return v8::Uint8ClampedArray::New(buffer, offset, length);
+    case kInt16Array:
+      if (offset % 2 == 0 && length % 2 == 0)
+        return v8::Int16Array::New(buffer, offset, length / 2);
+      break;
+    case kUint16Array:
+      if (offset % 2 == 0 && length % 2 == 0)
+        return v8::Uint16Array::New(buffer, offset, length / 2);
+      break;
+    case kInt32Array:
+      if (offset % 4 == 0 && length % 4 == 0)
+        return v8::Int32Array::New(buffer, offset, length / 4);
+      break;
+    case kUint32Array:
+      if (offset % 4 == 0 && length % 4 == 0)
+        return v8::Uint32Array::New(buffer, offset, length / 4);
+      break;
+    case kFloat32Array:
+      if (offset % 4 == 0 && length % 4 == 0)
+        return v8::Float32Array::New(buffer, offset, length / 4);
+      break;
+    case kFloat64Array:
+      if (offset % 8 == 0 && length % 8 == 0)
+        return v8::Float64Array::New(buffer, offset, length / 8);
+      break;
+    case kDataView:
+      return v8::DataView::New(buffer, offset, length);
+  }
+  return v8::MaybeLocal<v8::Object>();
+}
+
+// Moves the memory of |buffer| into a new ArrayBuffer of the current context
+// and detaches |buffer|.
+v8::Local<v8::ArrayBuffer> MoveArrayBuffer(v8::Isolate* isolate,
+                                           v8::Local<v8::ArrayBuffer> buffer) {
+  size_t length = buffer->ByteLength();
+  if (buffer->IsExternal()) {
+    // The memory belongs to someone else, it has to be copied.
+    auto result = v8::ArrayBuffer::New(isolate, length);
+    memcpy(result->GetContents().Data(), buffer->GetContents().Data(), length);
+    buffer->Neuter();
+    return result;
+  }
+
+  // Both contexts share the allocator of the isolate, so v8 can take the
+  // memory back.
+  v8::ArrayBuffer::Contents contents = buffer->Externalize();
+  buffer->Neuter();
+  return v8::ArrayBuffer::New(isolate, contents.Data(), length,
+                              v8::ArrayBufferCreationMode::kInternalized);
+}
+
+// When |array_buffers| is null the value stays in the process, transferred
+// ArrayBuffers are then only referenced by the output and are moved by the
+// caller.
+class Serializer : public v8::ValueSerializer::Delegate {
+ public:
+  Serializer(v8::Isolate* isolate,
+             std::vector<uint8_t>* data,
+             std::vector<base::UnsafeSharedMemoryRegion>* array_buffers)
+      : isolate_(isolate),
+        data_(data),
+        array_buffers_(array_buffers),
+        serializer_(isolate, this) {
+    serializer_.SetTreatArrayBufferViewsAsHostObjects(true);
+  }
+
+  bool Serialize(v8::Local<v8::Value> value,
+                 const std::vector<v8::Local<v8::Value>>& transfer) {
+    std::vector<v8::Local<v8::ArrayBuffer>> transferred;
+    for (v8::Local<v8::Value> item : transfer) {
+      if (!item->IsArrayBuffer()) {
+        ThrowDataCloneError(
+            mate::StringToV8(isolate_, "Only ArrayBuffers can be transferred"));
+        return false;
+      }
+      auto buffer = item.As<v8::ArrayBuffer>();
+      if (!buffer->IsNeuterable()) {
+        ThrowDataCloneError(mate::StringToV8(
+            isolate_, "An ArrayBuffer could not be transferred"));
+        return false;
+      }
+      if (std::find(transferred.begin(), transferred.end(), buffer) !=
+          transferred.end()) {
+        ThrowDataCloneError(mate::StringToV8(
+            isolate_, "An ArrayBuffer can only be transferred once"));
+        return false;
+      }
+      if (!array_buffers_)
+        TransferArrayBuffer(buffer);
+      else if (buffer->ByteLength() >= kSharedMemoryThreshold &&
+               !MoveToSharedMemory(buffer))
+        return false;
+      transferred.push_back(buffer);
+    }
+
+    serializer_.WriteHeader();
+    bool wrote;
+    if (!serializer_.WriteValue(isolate_->GetCurrentContext(), value)
+             .To(&wrote) ||
+        !wrote)
+      return false;
+
+    // The buffer is |data_| itself, see ReallocateBufferMemory.
+    std::pair<uint8_t*, size_t> result = serializer_.Release();
+    DCHECK_EQ(result.first, data_->data());
+    data_->resize(result.second);
+
+    // The caller moves the ArrayBuffers that stay in the process.
+    if (array_buffers_) {
+      for (v8::Local<v8::ArrayBuffer> buffer : transferred)
+        DetachArrayBuffer(buffer);
+    }
+    return true;
+  }
+
+  // v8::ValueSerializer::Delegate:
+  void ThrowDataCloneError(v8::Local<v8::String> message) override {
+    isolate_->ThrowException(v8::Exception::Error(message));
+  }
+
+  v8::Maybe<bool> WriteHostObject(v8::Isolate* isolate,
+                                  v8::Local<v8::Object> object) override {
+    uint32_t tag;
+    if (!object->IsArrayBufferView() ||
+        !GetArrayBufferViewTag(object.As<v8::ArrayBufferView>(), &tag))
+      return v8::ValueSerializer::Delegate::WriteHostObject(isolate, object);
+
+    auto view = object.As<v8::ArrayBufferView>();
+    size_t length = view->ByteLength();
+    if (length > std::numeric_limits<uint32_t>::max()) {
+      ThrowDataCloneError(
+          mate::StringToV8(isolate, "Typed array is too large"));
+      return v8::Nothing<bool>();
+    }
+
+    for (size_t i = 0; i < transferred_.size(); ++i) {
+      if (transferred_[i] != view->Buffer())
+        continue;
+      // The receiver gets the ArrayBuffer, so the view is not copied.
+      if (view->ByteOffset() > std::numeric_limits<uint32_t>::max())
+        break;
+      serializer_.WriteUint32(tag | kTransferredViewFlag);
+      serializer_.WriteUint32(static_cast<uint32_t>(i));
+      serializer_.WriteUint32(static_cast<uint32_t>(view->ByteOffset()));
+      serializer_.WriteUint32(static_cast<uint32_t>(length));
+      return v8::Just(true);
+    }
+
+    serializer_.WriteUint32(tag);
+    serializer_.WriteUint32(static_cast<uint32_t>(length));
+    const uint8_t* contents =
+        static_cast<const uint8_t*>(view->Buffer()->GetContents().Data());
+    serializer_.WriteRawBytes(contents + view->ByteOffset(), length);
+    return v8::Just(true);
+  }
+
+  // The serializer writes directly into |data_|, so the output does not need
+  // to be copied before being put into an IPC message.
+  void* ReallocateBufferMemory(void* old_buffer,
+                               size_t size,
+                               size_t* actual_size) override {
+    DCHECK(!old_buffer || old_buffer == data_->data());
+    data_->resize(size);
+    *actual_size = data_->size();
+    return data_->data();
+  }
+
+  void FreeBufferMemory(void* buffer) override {}
+
+  // The ArrayBuffers the output refers to, by index.
+  const std::vector<v8::Local<v8::ArrayBuffer>>& transferred() const {
+    return transferred_;
+  }
+
+ private:
+  void TransferArrayBuffer(v8::Local<v8::ArrayBuffer> buffer) {
+    serializer_.TransferArrayBuffer(static_cast<uint32_t>(transferred_.size()),
+                                    buffer);
+    transferred_.push_back(buffer);
+  }
+
+  // Copies the content of |buffer| into shared memory, the serializer then
+  // only writes the index of the region.
+  bool MoveToSharedMemory(v8::Local<v8::ArrayBuffer> buffer) {
+    size_t length = buffer->ByteLength();
+    auto region = base::UnsafeSharedMemoryRegion::Create(length);
+    base::WritableSharedMemoryMapping mapping = region.Map();
+    if (!mapping.IsValid()) {
+      ThrowDataCloneError(mate::StringToV8(
+          isolate_, "Unable to allocate shared memory for ArrayBuffer"));
+      return false;
+    }
+    memcpy(mapping.memory(), buffer->GetContents().Data(), length);
+
+    DCHECK_EQ(transferred_.size(), array_buffers_->size());
+    TransferArrayBuffer(buffer);
+    array_buffers_->push_back(std::move(region));
+    return true;
+  }
+
+  v8::Isolate* isolate_;
+  std::vector<uint8_t>* data_;
+  std::vector<base::UnsafeSharedMemoryRegion>* array_buffers_;
+  std::vector<v8::Local<v8::ArrayBuffer>> transferred_;
+  v8::ValueSerializer serializer_;
+
+  DISALLOW_COPY_AND_ASSIGN(Serializer);
+};
+
+class Deserializer : public v8::ValueDeserializer::Delegate {
+ public:
+  Deserializer(v8::Isolate* isolate, const std::vector<uint8_t>& data)
+      : isolate_(isolate),
+        deserializer_(isolate, data.data(), data.size(), this) {}
+
+  bool Deserialize(
+      const std::vector<base::UnsafeSharedMemoryRegion>& array_buffers,
+      v8::Local<v8::Value>* value) {
+    v8::Local<v8::Context> context = isolate_->GetCurrentContext();
+    bool read;
+    if (!deserializer_.ReadHeader(context).To(&read) || !read)
+      return false;
+
+    // The transferred ArrayBuffers are backed by the shared memory directly.
+    for (size_t i = 0; i < array_buffers.size(); ++i) {
+      base::WritableSharedMemoryMapping mapping = array_buffers[i].Map();
+      if (!mapping.IsValid())
+        return false;
+      TransferArrayBuffer(
+          MappedArrayBuffer::Create(isolate_, std::move(mapping)));
+    }
+
+    return deserializer_.ReadValue(context).ToLocal(value);
+  }
+
+  // Reads a value written in this process, |transferred| are the moved
+  // ArrayBuffers in the order of Serializer::transferred().
+  bool Deserialize(const std::vector<v8::Local<v8::ArrayBuffer>>& transferred,
+                   v8::Local<v8::Value>* value) {
+    v8::Local<v8::Context> context = isolate_->GetCurrentContext();
+    bool read;
+    if (!deserializer_.ReadHeader(context).To(&read) || !read)
+      return false;
+    for (v8::Local<v8::ArrayBuffer> buffer : transferred)
+      TransferArrayBuffer(buffer);
+    return deserializer_.ReadValue(context).ToLocal(value);
+  }
+
+  // v8::ValueDeserializer::Delegate:
+  v8::MaybeLocal<v8::Object> ReadHostObject(v8::Isolate* isolate) override {
+    uint32_t tag, index, offset, length;
+    const void* contents;
+    v8::Local<v8::Object> view;
+    if (deserializer_.ReadUint32(&tag) && (tag & kTransferredViewFlag)) {
+      if (deserializer_.ReadUint32(&index) &&
+          deserializer_.ReadUint32(&offset) &&
+          deserializer_.ReadUint32(&length) && index < transferred_.size() &&
+          CreateArrayBufferView(tag & ~kTransferredViewFlag,
+                                transferred_[index], offset, length)
+              .ToLocal(&view))
+        return view;
+    } else if (deserializer_.ReadUint32(&length) &&
+               deserializer_.ReadRawBytes(length, &contents)) {
+      v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, length);
+      memcpy(buffer->GetContents().Data(), contents, length);
+      if (CreateArrayBufferView(tag, buffer, 0, length).ToLocal(&view))
+        return view;
+    }
+
+    isolate->ThrowException(v8::Exception::Error(
+        mate::StringToV8(isolate, "Unable to deserialize typed array")));
+    return v8::MaybeLocal<v8::Object>();
+  }
+
+ private:
+  void TransferArrayBuffer(v8::Local<v8::ArrayBuffer> buffer) {
+    deserializer_.TransferArrayBuffer(
+        static_cast<uint32_t>(transferred_.size()), buffer);
+    transferred_.push_back(buffer);
+  }
+
+  v8::Isolate* isolate_;
+  std::vector<v8::Local<v8::ArrayBuffer>> transferred_;
+  v8::ValueDeserializer deserializer_;
+
+  DISALLOW_COPY_AND_ASSIGN(Deserializer);
+};
+
+}  // namespace
+
+bool SerializeV8Value(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::Value>>& transfer,
+    std::vector<uint8_t>* data,
+    std::vector<base::UnsafeSharedMemoryRegion>* array_buffers) {
+  Serializer serializer(isolate, data, array_buffers);
+  return serializer.Serialize(value, transfer);
+}
+
+bool DeserializeV8Value(
+    v8::Isolate* isolate,
+    const std::vector<uint8_t>& data,
+    const std::vector<base::UnsafeSharedMemoryRegion>& array_buffers,
+    v8::Local<v8::Value>* value) {
+  v8::TryCatch try_catch(isolate);
+  Deserializer deserializer(isolate, data);
+  if (!deserializer.Deserialize(array_buffers, value)) {
+    LOG(ERROR) << "Failed to deserialize IPC message";
+    return false;
+  }
+  return true;
+}
+
+bool CopyV8ValueToContext(v8::Isolate* isolate,
+                          v8::Local<v8::Value> value,
+                          const std::vector<v8::Local<v8::Value>>& transfer,
+                          v8::Local<v8::Context> target,
+                          v8::Local<v8::Value>* result) {
+  std::vector<uint8_t> data;
+  Serializer serializer(isolate, &data, nullptr);
+  if (!serializer.Serialize(value, transfer))
+    return false;
+
+  v8::EscapableHandleScope handle_scope(isolate);
+  v8::Local<v8::Value> copy;
+  {
+    v8::Context::Scope context_scope(target);
+    v8::TryCatch try_catch(isolate);
+    std::vector<v8::Local<v8::ArrayBuffer>> transferred;
+    for (v8::Local<v8::ArrayBuffer> buffer : serializer.transferred())
+      transferred.push_back(MoveArrayBuffer(isolate, buffer));
+    Deserializer deserializer(isolate, data);
+    if (!deserializer.Deserialize(transferred, &copy))
+      copy.Clear();
+  }
+  if (copy.IsEmpty()) {
+    isolate->ThrowException(v8::Exception::Error(
+        mate::StringToV8(isolate, "Unable to copy the value")));
+    return false;
+  }
+  *result = handle_scope.Escape(copy);
+  return true;
+}
+
+}  // namespace atom
@@ -0,0 +1,50 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_V8_VALUE_SERIALIZER_H_
+#define ATOM_COMMON_V8_VALUE_SERIALIZER_H_
+
+#include <vector>
+
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+// Serializes |value| with the structured clone algorithm of v8, which keeps
+// ArrayBuffer, typed arrays, Map, Set and Date intact. Returns false with an
+// exception thrown in |isolate| when the value can not be cloned.
+//
+// The ArrayBuffers in |transfer| are detached from |isolate|, the large ones
+// are moved into |array_buffers| instead of being copied into |data| so the
+// receiver can use the shared memory directly.
+bool SerializeV8Value(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::Value>>& transfer,
+    std::vector<uint8_t>* data,
+    std::vector<base::UnsafeSharedMemoryRegion>* array_buffers);
+
+// Recreates a value written by SerializeV8Value in the current context,
+// returns false if |data| is malformed.
+bool DeserializeV8Value(
+    v8::Isolate* isolate,
+    const std::vector<uint8_t>& data,
+    const std::vector<base::UnsafeSharedMemoryRegion>& array_buffers,
+    v8::Local<v8::Value>* value);
+
+// Copies |value| into |target|, another context of |isolate|, like
+// postMessage between two windows would. The ArrayBuffers in |transfer| are
+// moved into |target| without copying their memory and are detached from the
+// current context. Returns false with an exception thrown in the current
+// context when the value can not be copied.
+bool CopyV8ValueToContext(v8::Isolate* isolate,
+                          v8::Local<v8::Value> value,
+                          const std::vector<v8::Local<v8::Value>>& transfer,
+                          v8::Local<v8::Context> target,
+                          v8::Local<v8::Value>* result);
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_V8_VALUE_SERIALIZER_H_
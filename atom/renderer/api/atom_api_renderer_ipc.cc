@@ -4,10 +4,13 @@
 
 #include "atom/renderer/api/atom_api_renderer_ipc.h"
 #include "atom/common/api/api_messages.h"
+#include "atom/common/api/remote_object_freer.h"
+#include "atom/common/ipc_channel_stats.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/node_bindings.h"
 #include "atom/common/node_includes.h"
+#include "atom/common/v8_value_serializer.h"
 #include "content/public/renderer/render_frame.h"
 #include "native_mate/dictionary.h"
 #include "third_party/blink/public/web/web_local_frame.h"
@@ -27,6 +30,19 @@ RenderFrame* GetCurrentRenderFrame() {
   return RenderFrame::FromWebFrame(frame);
 }
 
+namespace {
+
+// Sends |message| and counts it for |channel| in IPCChannelStats.
+bool SendAndRecord(RenderFrame* render_frame,
+                   const std::string& channel,
+                   IPC::Message* message) {
+  IPCChannelStats::GetInstance()->Record(IPCChannelStats::Direction::kSent,
+                                         channel, message->size());
+  return render_frame->Send(message);
+}
+
+}  // namespace
+
 void Send(mate::Arguments* args,
           const std::string& channel,
           const base::ListValue& arguments) {
@@ -34,13 +50,39 @@ void Send(mate::Arguments* args,
   if (render_frame == nullptr)
     return;
 
-  bool success = render_frame->Send(new AtomFrameHostMsg_Message(
-      render_frame->GetRoutingID(), channel, arguments));
+  bool success = SendAndRecord(
+      render_frame, IPCChannelStats::GetChannelName(channel, arguments),
+      new AtomFrameHostMsg_Message(render_frame->GetRoutingID(), channel,
+                                   arguments));
 
   if (!success)
     args->ThrowError("Unable to send AtomFrameHostMsg_Message");
 }
 
+void SendSerialized(mate::Arguments* args,
+                    const std::string& channel,
+                    v8::Local<v8::Value> arguments,
+                    const std::vector<v8::Local<v8::Value>>& transfer) {
+  RenderFrame* render_frame = GetCurrentRenderFrame();
+  if (render_frame == nullptr)
+    return;
+
+  // An exception has been thrown when the arguments can not be cloned.
+  std::vector<uint8_t> data;
+  std::vector<base::UnsafeSharedMemoryRegion> array_buffers;
+  if (!SerializeV8Value(args->isolate(), arguments, transfer, &data,
+                        &array_buffers))
+    return;
+
+  bool success = SendAndRecord(
+      render_frame, channel,
+      new AtomFrameHostMsg_Message_Serialized(render_frame->GetRoutingID(),
+                                              channel, data, array_buffers));
+
+  if (!success)
+    args->ThrowError("Unable to send AtomFrameHostMsg_Message_Serialized");
+}
+
 base::ListValue SendSync(mate::Arguments* args,
                          const std::string& channel,
                          const base::ListValue& arguments) {
@@ -50,9 +92,13 @@ base::ListValue SendSync(mate::Arguments* args,
   if (render_frame == nullptr)
     return result;
 
+  RemoteObjectFreer::FlushDereferences();
+
   IPC::SyncMessage* message = new AtomFrameHostMsg_Message_Sync(
       render_frame->GetRoutingID(), channel, arguments, &result);
-  bool success = render_frame->Send(message);
+  bool success = SendAndRecord(
+      render_frame, IPCChannelStats::GetChannelName(channel, arguments),
+      message);
 
   if (!success)
     args->ThrowError("Unable to send AtomFrameHostMsg_Message_Sync");
@@ -60,6 +106,28 @@ base::ListValue SendSync(mate::Arguments* args,
   return result;
 }
 
+// Returns the id of the request, ids are never reused by the process so a
+// reply meant for a previous document of the frame can not be taken for the
+// reply to a request of the current one.
+int Invoke(mate::Arguments* args,
+           const std::string& channel,
+           const base::ListValue& arguments) {
+  static int next_request_id = 0;
+  RenderFrame* render_frame = GetCurrentRenderFrame();
+  if (render_frame == nullptr)
+    return 0;
+
+  int request_id = ++next_request_id;
+  bool success = SendAndRecord(
+      render_frame, channel,
+      new AtomFrameHostMsg_Invoke(render_frame->GetRoutingID(), request_id,
+                                  channel, arguments));
+
+  if (!success)
+    args->ThrowError("Unable to send AtomFrameHostMsg_Invoke");
+  return request_id;
+}
+
 void SendTo(mate::Arguments* args,
             bool internal,
             bool send_to_all,
@@ -70,22 +138,42 @@ void SendTo(mate::Arguments* args,
   if (render_frame == nullptr)
     return;
 
-  bool success = render_frame->Send(new AtomFrameHostMsg_Message_To(
-      render_frame->GetRoutingID(), internal, send_to_all, web_contents_id,
-      channel, arguments));
+  bool success = SendAndRecord(
+      render_frame, channel,
+      new AtomFrameHostMsg_Message_To(render_frame->GetRoutingID(), internal,
+                                      send_to_all, web_contents_id, channel,
+                                      arguments));
 
   if (!success)
     args->ThrowError("Unable to send AtomFrameHostMsg_Message_To");
 }
 
+void OpenPort(mate::Arguments* args,
+              int request_id,
+              int32_t web_contents_id,
+              const std::string& channel) {
+  RenderFrame* render_frame = GetCurrentRenderFrame();
+  if (render_frame == nullptr)
+    return;
+
+  bool success = render_frame->Send(new AtomFrameHostMsg_OpenPort(
+      render_frame->GetRoutingID(), request_id, web_contents_id, channel));
+
+  if (!success)
+    args->ThrowError("Unable to send AtomFrameHostMsg_OpenPort");
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
                 void* priv) {
   mate::Dictionary dict(context->GetIsolate(), exports);
   dict.SetMethod("send", &Send);
+  dict.SetMethod("sendSerialized", &SendSerialized);
   dict.SetMethod("sendSync", &SendSync);
   dict.SetMethod("sendTo", &SendTo);
+  dict.SetMethod("invoke", &Invoke);
+  dict.SetMethod("openPort", &OpenPort);
 }
 
 }  // namespace api
@@ -4,12 +4,15 @@
 
 #include "atom/renderer/api/atom_api_spell_check_client.h"
 
+#include <algorithm>
 #include <map>
+#include <set>
 #include <vector>
 
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "base/logging.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
 #include "components/spellcheck/renderer/spellcheck_worditerator.h"
 #include "native_mate/converter.h"
 #include "native_mate/dictionary.h"
@@ -24,6 +27,16 @@ namespace api {
 
 namespace {
 
+// Words that the provider already checked are answered from the cache.
+const int kWordCacheSize = 10000;
+
+// The words are sent to the provider in batches, and the text is split into
+// words for at most this long before yielding to other tasks, so typing in
+// large documents is not blocked.
+const size_t kBatchSize = 256;
+const int kTimeSliceMs = 8;
+const int kWordsPerDeadlineCheck = 64;
+
 bool HasWordCharacters(const base::string16& text, int index) {
   const base::char16* data = text.data();
   int length = text.length();
@@ -45,20 +58,45 @@ class SpellCheckClient::SpellcheckRequest {
   using WordMap =
       std::map<base::string16, std::vector<blink::WebTextCheckingResult>>;
 
-  SpellcheckRequest(const base::string16& text,
+  SpellcheckRequest(int id,
+                    const base::string16& text,
                     blink::WebTextCheckingCompletion* completion)
-      : text_(text), completion_(completion) {
+      : id_(id), text_(text), completion_(completion) {
     DCHECK(completion);
   }
   ~SpellcheckRequest() {}
 
+  int id() const { return id_; }
   const base::string16& text() const { return text_; }
   blink::WebTextCheckingCompletion* completion() { return completion_; }
   WordMap& wordmap() { return word_map_; }
 
+  // Whether the word iterator has been given the text of this request.
+  bool started = false;
+  // The words that are not in the cache, and the batch that is being checked
+  // by the provider.
+  std::vector<base::string16> unchecked_words;
+  size_t batch_start = 0;
+  size_t batch_end = 0;
+
+  // Moves the occurrences of a misspelled word to the results.
+  void AddMisspelledWord(const base::string16& word) {
+    auto iter = word_map_.find(word);
+    if (iter == word_map_.end())
+      return;
+    auto& occurrences = iter->second;
+    results_.insert(results_.end(), occurrences.begin(), occurrences.end());
+    occurrences.clear();
+  }
+  const std::vector<blink::WebTextCheckingResult>& results() const {
+    return results_;
+  }
+
  private:
+  int id_;
   base::string16 text_;  // Text to be checked in this task.
   WordMap word_map_;     // WordMap to hold distinct words in text
+  std::vector<blink::WebTextCheckingResult> results_;
   // The interface to send the misspelled ranges to WebKit.
   blink::WebTextCheckingCompletion* completion_;
 
@@ -71,7 +109,8 @@ SpellCheckClient::SpellCheckClient(const std::string& language,
     : pending_request_param_(nullptr),
       isolate_(isolate),
       context_(isolate, isolate->GetCurrentContext()),
-      provider_(isolate, provider) {
+      provider_(isolate, provider),
+      word_cache_(kWordCacheSize) {
   DCHECK(!context_.IsEmpty());
 
   character_attributes_.SetDefaultLanguage(language);
@@ -100,11 +139,13 @@ void SpellCheckClient::RequestCheckingOfText(
     pending_request_param_->completion()->DidCancelCheckingText();
   }
 
-  pending_request_param_.reset(new SpellcheckRequest(text, completionCallback));
+  int request_id = ++next_request_id_;
+  pending_request_param_.reset(
+      new SpellcheckRequest(request_id, text, completionCallback));
 
   base::ThreadTaskRunnerHandle::Get()->PostTask(
-      FROM_HERE,
-      base::BindOnce(&SpellCheckClient::SpellCheckText, AsWeakPtr()));
+      FROM_HERE, base::BindOnce(&SpellCheckClient::SpellCheckText, AsWeakPtr(),
+                                request_id));
 }
 
 bool SpellCheckClient::IsSpellCheckingEnabled() const {
@@ -120,7 +161,11 @@ bool SpellCheckClient::IsShowingSpellingUI() {
 void SpellCheckClient::UpdateSpellingUIWithMisspelledWord(
     const blink::WebString& word) {}
 
-void SpellCheckClient::SpellCheckText() {
+void SpellCheckClient::SpellCheckText(int request_id) {
+  // A newer request replaced this one.
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
+
   const auto& text = pending_request_param_->text();
   if (text.empty() || spell_check_.IsEmpty()) {
     pending_request_param_->completion()->DidCancelCheckingText();
@@ -142,14 +187,27 @@ void SpellCheckClient::SpellCheckText() {
     return;
   }
 
-  text_iterator_.SetText(text.c_str(), text.size());
+  if (!pending_request_param_->started) {
+    text_iterator_.SetText(text.c_str(), text.size());
+    pending_request_param_->started = true;
+  }
 
   SpellCheckScope scope(*this);
   base::string16 word;
-  std::vector<base::string16> words;
   auto& word_map = pending_request_param_->wordmap();
   blink::WebTextCheckingResult result;
-  for (;;) {  // Run until end of text
+  const base::TimeTicks deadline =
+      base::TimeTicks::Now() + base::TimeDelta::FromMilliseconds(kTimeSliceMs);
+  for (int count = 1;; ++count) {  // Run until end of text
+    // Continue in a later task when the text takes too long.
+    if (count % kWordsPerDeadlineCheck == 0 &&
+        base::TimeTicks::Now() > deadline) {
+      base::ThreadTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::BindOnce(&SpellCheckClient::SpellCheckText,
+                                    AsWeakPtr(), request_id));
+      return;
+    }
+
     const auto status =
         text_iterator_.GetNextWord(&word, &result.location, &result.length);
     if (status == SpellcheckWordIterator::IS_END_OF_TEXT)
@@ -161,62 +219,99 @@ void SpellCheckClient::SpellCheckText() {
     // (e.g. "hello:hello"), we should treat it as a valid word.
     std::vector<base::string16> contraction_words;
     if (!IsContraction(scope, word, &contraction_words)) {
-      words.push_back(word);
       word_map[word].push_back(result);
     } else {
       // For a contraction, we want check the spellings of each individual
       // part, but mark the entire word incorrect if any part is misspelled
       // Hence, we use the same word_start and word_length values for every
       // part of the contraction.
-      for (const auto& w : contraction_words) {
-        words.push_back(w);
+      for (const auto& w : contraction_words)
         word_map[w].push_back(result);
-      }
     }
   }
 
-  // Send out all the words data to the spellchecker to check
-  SpellCheckWords(scope, words);
-}
+  // Only the distinct words that are not in the cache are sent out.
+  auto& unchecked_words = pending_request_param_->unchecked_words;
+  std::vector<base::string16> misspelled_words;
+  for (const auto& pair : word_map) {
+    auto cached = word_cache_.Get(pair.first);
+    if (cached == word_cache_.end())
+      unchecked_words.push_back(pair.first);
+    else if (cached->second)
+      misspelled_words.push_back(pair.first);
+  }
+  for (const auto& misspelled_word : misspelled_words)
+    pending_request_param_->AddMisspelledWord(misspelled_word);
 
-void SpellCheckClient::OnSpellCheckDone(
-    const std::vector<base::string16>& misspelled_words) {
-  std::vector<blink::WebTextCheckingResult> results;
-  auto* const completion_handler = pending_request_param_->completion();
+  SpellCheckNextBatch(request_id);
+}
 
-  auto& word_map = pending_request_param_->wordmap();
+void SpellCheckClient::SpellCheckNextBatch(int request_id) {
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
 
-  // Take each word from the list of misspelled words received, find their
-  // corresponding WebTextCheckingResult that's stored in the map and pass
-  // all the results to blink through the completion callback.
-  for (const auto& word : misspelled_words) {
-    auto iter = word_map.find(word);
-    if (iter != word_map.end()) {
-      // Word found in map, now gather all the occurrences of the word
-      // from the map value
-      auto& words = iter->second;
-      results.insert(results.end(), words.begin(), words.end());
-      words.clear();
-    }
+  auto* request = pending_request_param_.get();
+  const auto& words = request->unchecked_words;
+  if (request->batch_end >= words.size()) {
+    FinishRequest();
+    return;
   }
-  completion_handler->DidFinishCheckingText(results);
-  pending_request_param_ = nullptr;
-}
 
-void SpellCheckClient::SpellCheckWords(
-    const SpellCheckScope& scope,
-    const std::vector<base::string16>& words) {
-  DCHECK(!scope.spell_check_.IsEmpty());
+  request->batch_start = request->batch_end;
+  request->batch_end =
+      std::min(words.size(), request->batch_start + kBatchSize);
+  std::vector<base::string16> batch(words.begin() + request->batch_start,
+                                    words.begin() + request->batch_end);
 
+  SpellCheckScope scope(*this);
   v8::Local<v8::FunctionTemplate> templ = mate::CreateFunctionTemplate(
-      isolate_, base::Bind(&SpellCheckClient::OnSpellCheckDone, AsWeakPtr()));
+      isolate_, base::Bind(&SpellCheckClient::OnSpellCheckDone, AsWeakPtr(),
+                           request_id, request->batch_start));
 
-  v8::Local<v8::Value> args[] = {mate::ConvertToV8(isolate_, words),
+  v8::Local<v8::Value> args[] = {mate::ConvertToV8(isolate_, batch),
                                  templ->GetFunction()};
   // Call javascript with the words and the callback function
   scope.spell_check_->Call(scope.provider_, 2, args);
 }
 
+void SpellCheckClient::OnSpellCheckDone(
+    int request_id,
+    size_t batch_start,
+    const std::vector<base::string16>& misspelled_words) {
+  // Ignore the answers for replaced requests, or repeated calls of the
+  // callback.
+  auto* request = pending_request_param_.get();
+  if (!request || request->id() != request_id ||
+      request->batch_start != batch_start)
+    return;
+
+  std::set<base::string16> misspelled(misspelled_words.begin(),
+                                      misspelled_words.end());
+  for (size_t i = request->batch_start; i < request->batch_end; ++i) {
+    const auto& word = request->unchecked_words[i];
+    bool is_misspelled = misspelled.count(word) > 0;
+    word_cache_.Put(word, is_misspelled);
+    if (is_misspelled)
+      request->AddMisspelledWord(word);
+  }
+  // Mark the batch as answered.
+  request->batch_start = request->batch_end;
+
+  // The next batch is sent from a new task, so a provider that answers
+  // synchronously does not block the renderer for the whole text.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&SpellCheckClient::SpellCheckNextBatch,
+                                AsWeakPtr(), request_id));
+}
+
+void SpellCheckClient::FinishRequest() {
+  // Take each misspelled word's WebTextCheckingResult, which were gathered
+  // from the map, and pass all the results to blink through the completion
+  // callback.
+  auto request = std::move(pending_request_param_);
+  request->completion()->DidFinishCheckingText(request->results());
+}
+
 // Returns whether or not the given string is a contraction.
 // This function is a fall-back when the SpellcheckWordIterator class
 // returns a concatenated word which is not in the selected dictionary
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/callback.h"
+#include "base/containers/mru_cache.h"
 #include "base/memory/weak_ptr.h"
 #include "components/spellcheck/renderer/spellcheck_worditerator.h"
 #include "native_mate/scoped_persistent.h"
@@ -61,14 +62,14 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
 
   // Run through the word iterator and send out requests
   // to the JS API for checking spellings of words in the current
-  // request.
-  void SpellCheckText();
+  // request. Long texts are split over several tasks.
+  void SpellCheckText(int request_id);
 
-  // Call JavaScript to check spelling a word.
+  // Call JavaScript to check the spelling of the next batch of the words
+  // that are not in the cache.
   // The javascript function will callback OnSpellCheckDone
   // with the results of all the misspelled words.
-  void SpellCheckWords(const SpellCheckScope& scope,
-                       const std::vector<base::string16>& words);
+  void SpellCheckNextBatch(int request_id);
 
   // Returns whether or not the given word is a contraction of valid words
   // (e.g. "word:word").
@@ -79,7 +80,12 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
                      std::vector<base::string16>* contraction_words);
 
   // Callback for the JS API which returns the list of misspelled words.
-  void OnSpellCheckDone(const std::vector<base::string16>& misspelled_words);
+  void OnSpellCheckDone(int request_id,
+                        size_t batch_start,
+                        const std::vector<base::string16>& misspelled_words);
+
+  // Reports the results of the pending request to blink.
+  void FinishRequest();
 
   // Represents character attributes used for filtering out characters which
   // are not supported by this SpellCheck object.
@@ -97,6 +103,11 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   // (When WebKit sends two or more requests, we cancel the previous
   // requests so we do not have to use vectors.)
   std::unique_ptr<SpellcheckRequest> pending_request_param_;
+  int next_request_id_ = 0;
+
+  // Whether the provider reported the words as misspelled. The answers of a
+  // provider are assumed to not change, a new provider gets a new client.
+  base::MRUCache<base::string16, bool> word_cache_;
 
   v8::Isolate* isolate_;
   v8::Persistent<v8::Context> context_;
@@ -4,14 +4,19 @@
 
 #include "atom/renderer/api/atom_api_web_frame.h"
 
+#include <utility>
+
 #include "atom/common/api/api_messages.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/native_mate_converters/blink_converter.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/gfx_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
+#include "atom/common/v8_value_serializer.h"
 #include "atom/renderer/api/atom_api_spell_check_client.h"
+#include "base/containers/mru_cache.h"
 #include "base/memory/memory_pressure_listener.h"
+#include "base/no_destructor.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "content/public/renderer/render_frame_visitor.h"
@@ -109,6 +114,57 @@ class ScriptExecutionCallback : public blink::WebScriptExecutionCallback {
   DISALLOW_COPY_AND_ASSIGN(ScriptExecutionCallback);
 };
 
+// Scripts of executeJavaScriptInFrames are compiled once and then bound to
+// the context of each frame, the compiled scripts are kept for later calls.
+const size_t kMaxCachedScripts = 16;
+
+using ScriptCache =
+    base::MRUCache<base::string16, v8::Global<v8::UnboundScript>>;
+
+ScriptCache* GetScriptCache() {
+  static base::NoDestructor<ScriptCache> cache(kMaxCachedScripts);
+  return cache.get();
+}
+
+v8::MaybeLocal<v8::UnboundScript> GetUnboundScript(v8::Isolate* isolate,
+                                                   const base::string16& code) {
+  ScriptCache* cache = GetScriptCache();
+  auto it = cache->Get(code);
+  if (it != cache->end())
+    return it->second.Get(isolate);
+
+  v8::ScriptCompiler::Source source(
+      mate::ConvertToV8(isolate, code).As<v8::String>());
+  v8::Local<v8::UnboundScript> script;
+  if (!v8::ScriptCompiler::CompileUnboundScript(isolate, &source)
+           .ToLocal(&script))
+    return v8::MaybeLocal<v8::UnboundScript>();
+  cache->Put(code, v8::Global<v8::UnboundScript>(isolate, script));
+  return script;
+}
+
+// Adds the routing ids of |frame| and its local descendants to |frames|.
+void CollectLocalFrames(blink::WebLocalFrame* frame, std::vector<int>* frames) {
+  frames->push_back(content::RenderFrame::GetRoutingIdForWebFrame(frame));
+  for (blink::WebFrame* child = frame->FirstChild(); child;
+       child = child->NextSibling()) {
+    if (child->IsWebLocalFrame())
+      CollectLocalFrames(child->ToWebLocalFrame(), frames);
+  }
+}
+
+// Copies |value| from the context of a frame into |context| with the structured
+// clone algorithm, so the caller never holds objects of the other frames.
+bool CloneIntoContext(v8::Isolate* isolate,
+                      v8::Local<v8::Context> from_context,
+                      v8::Local<v8::Value> value,
+                      v8::Local<v8::Context> to_context,
+                      v8::Local<v8::Value>* out) {
+  v8::Context::Scope context_scope(from_context);
+  v8::TryCatch try_catch(isolate);
+  return CopyV8ValueToContext(isolate, value, {}, to_context, out);
+}
+
 class FrameSpellChecker : public content::RenderFrameVisitor {
  public:
   explicit FrameSpellChecker(SpellCheckClient* spell_check_client,
@@ -343,6 +399,105 @@ void WebFrame::ExecuteJavaScriptInIsolatedWorld(
       scriptExecutionType, callback.release());
 }
 
+v8::Local<v8::Value> WebFrame::ExecuteJavaScriptInFrames(
+    const base::string16& code,
+    mate::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  int world_id = 0;
+  mate::Dictionary options;
+  if (!args->PeekNext().IsEmpty() && !args->PeekNext()->IsFunction() &&
+      args->GetNext(&options))
+    options.Get("worldId", &world_id);
+  base::Callback<void(v8::Local<v8::Value>)> completion_callback;
+  args->GetNext(&completion_callback);
+
+  v8::Local<v8::UnboundScript> script;
+  {
+    v8::TryCatch try_catch(isolate);
+    if (!GetUnboundScript(isolate, code).ToLocal(&script)) {
+      try_catch.ReThrow();
+      return v8::Undefined(isolate);
+    }
+  }
+
+  // The scripts can remove frames, so they are looked up by routing id
+  // before each run.
+  std::vector<int> frames;
+  CollectLocalFrames(web_frame_, &frames);
+
+  v8::Local<v8::Context> caller_context = isolate->GetCurrentContext();
+  std::vector<v8::Local<v8::Value>> results;
+  for (int routing_id : frames) {
+    mate::Dictionary entry = mate::Dictionary::CreateEmpty(isolate);
+    entry.Set("routingId", routing_id);
+    results.push_back(entry.GetHandle());
+
+    content::RenderFrame* render_frame =
+        content::RenderFrame::FromRoutingID(routing_id);
+    if (!render_frame) {
+      entry.Set("error", "The frame was removed");
+      continue;
+    }
+
+    blink::WebLocalFrame* frame = render_frame->GetWebFrame();
+    v8::Local<v8::Context> context =
+        world_id == 0 ? frame->MainWorldScriptContext()
+                      : frame->WorldScriptContext(isolate, world_id);
+    if (context.IsEmpty()) {
+      entry.Set("error", "The frame has no script context");
+      continue;
+    }
+
+    v8::Local<v8::Value> value;
+    std::string error;
+    {
+      v8::Context::Scope context_scope(context);
+      v8::TryCatch try_catch(isolate);
+      if (!script->BindToCurrentContext()->Run(context).ToLocal(&value)) {
+        error = try_catch.Message().IsEmpty()
+                    ? "The script was terminated"
+                    : mate::V8ToString(try_catch.Message()->Get());
+      }
+    }
+
+    v8::Local<v8::Value> result;
+    if (error.empty() &&
+        !CloneIntoContext(isolate, context, value, caller_context, &result))
+      error = "The result could not be cloned";
+    if (error.empty())
+      entry.Set("result", result);
+    else
+      entry.Set("error", error);
+  }
+
+  v8::Local<v8::Value> array = mate::ConvertToV8(isolate, results);
+  if (!completion_callback.is_null())
+    completion_callback.Run(array);
+  return array;
+}
+
+void WebFrame::CopyToMainWorld(const std::string& name,
+                               v8::Local<v8::Value> value,
+                               mate::Arguments* args) {
+  std::vector<v8::Local<v8::Value>> transfer;
+  if (args->Length() > 2 && !args->GetNext(&transfer)) {
+    args->ThrowError("transfer must be an array of ArrayBuffers");
+    return;
+  }
+
+  v8::Isolate* isolate = args->isolate();
+  v8::Local<v8::Context> context = web_frame_->MainWorldScriptContext();
+  v8::Local<v8::Value> copy;
+  if (context.IsEmpty() ||
+      !CopyV8ValueToContext(isolate, value, transfer, context, &copy))
+    return;
+
+  // Defined as a data property, so no setter of the page runs.
+  v8::Context::Scope context_scope(context);
+  ignore_result(context->Global()->CreateDataProperty(
+      context, mate::StringToV8(isolate, name), copy));
+}
+
 void WebFrame::SetIsolatedWorldSecurityOrigin(int world_id,
                                               const std::string& origin_url) {
   web_frame_->SetIsolatedWorldSecurityOrigin(
@@ -501,6 +656,9 @@ void WebFrame::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("executeJavaScript", &WebFrame::ExecuteJavaScript)
       .SetMethod("executeJavaScriptInIsolatedWorld",
                  &WebFrame::ExecuteJavaScriptInIsolatedWorld)
+      .SetMethod("executeJavaScriptInFrames",
+                 &WebFrame::ExecuteJavaScriptInFrames)
+      .SetMethod("copyToMainWorld", &WebFrame::CopyToMainWorld)
       .SetMethod("setIsolatedWorldSecurityOrigin",
                  &WebFrame::SetIsolatedWorldSecurityOrigin)
       .SetMethod("setIsolatedWorldContentSecurityPolicy",
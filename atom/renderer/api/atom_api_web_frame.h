@@ -74,6 +74,15 @@ class WebFrame : public mate::Wrappable<WebFrame> {
       int world_id,
       const std::vector<mate::Dictionary>& scripts,
       mate::Arguments* args);
+  // Runs |code| in this frame and its local subframes, the script is only
+  // compiled once.
+  v8::Local<v8::Value> ExecuteJavaScriptInFrames(const base::string16& code,
+                                                 mate::Arguments* args);
+
+  // Copies |value| into the main world of the frame as the global |name|.
+  void CopyToMainWorld(const std::string& name,
+                       v8::Local<v8::Value> value,
+                       mate::Arguments* args);
 
   // Isolated world related methods
   void SetIsolatedWorldSecurityOrigin(int world_id,
@@ -0,0 +1,50 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/renderer/asar_index_client.h"
+
+#include <memory>
+
+#include "atom/common/api/api_messages.h"
+#include "atom/common/asar/archive_index.h"
+#include "atom/common/asar/asar_util.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "content/public/renderer/render_thread.h"
+#include "ipc/ipc_sync_message_filter.h"
+
+namespace atom {
+
+namespace {
+
+// Archives are opened by the render thread and by the threads of workers, the
+// filter can send from any of them.
+IPC::SyncMessageFilter* g_sync_message_filter = nullptr;
+
+std::unique_ptr<asar::ArchiveIndex> GetSharedIndex(const base::FilePath& path,
+                                                   int64_t size,
+                                                   int64_t last_modified,
+                                                   uint32_t* header_size) {
+  base::ReadOnlySharedMemoryRegion region;
+  if (!g_sync_message_filter->Send(new AtomHostMsg_GetSharedAsarIndex(
+          path, size, last_modified, header_size, &region)) ||
+      !region.IsValid())
+    return nullptr;
+
+  auto index = asar::ArchiveIndex::CreateFromSharedMemory(region.Map());
+  if (!index)
+    LOG(WARNING) << "Ignoring invalid shared index of " << path.value();
+  return index;
+}
+
+}  // namespace
+
+void InstallAsarIndexClient() {
+  // Leaked, the archives can be opened until the process exits.
+  g_sync_message_filter =
+      content::RenderThread::Get()->GetSyncMessageFilter().get();
+  g_sync_message_filter->AddRef();
+  asar::SetSharedIndexProvider(&GetSharedIndex);
+}
+
+}  // namespace atom
@@ -0,0 +1,17 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_RENDERER_ASAR_INDEX_CLIENT_H_
+#define ATOM_RENDERER_ASAR_INDEX_CLIENT_H_
+
+namespace atom {
+
+// Makes the archives opened by this process ask the browser process for the
+// index it has parsed before they parse their header themselves. Must be
+// called on the render thread.
+void InstallAsarIndexClient();
+
+}  // namespace atom
+
+#endif  // ATOM_RENDERER_ASAR_INDEX_CLIENT_H_
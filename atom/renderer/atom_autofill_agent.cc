@@ -4,9 +4,11 @@
 
 #include "atom/renderer/atom_autofill_agent.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "atom/common/api/api_messages.h"
+#include "base/strings/string_util.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_view.h"
 #include "third_party/blink/public/platform/web_keyboard_event.h"
@@ -24,16 +26,11 @@ namespace {
 const size_t kMaxDataLength = 1024;
 const size_t kMaxListSize = 512;
 
-void GetDataListSuggestions(const blink::WebInputElement& element,
-                            std::vector<base::string16>* values,
-                            std::vector<base::string16>* labels) {
-  for (const auto& option : element.FilteredDataListOptions()) {
-    values->push_back(option.Value().Utf16());
-    if (option.Value() != option.Label())
-      labels->push_back(option.Label().Utf16());
-    else
-      labels->push_back(base::string16());
-  }
+// The popup shows at most this many suggestions.
+const size_t kMaxSuggestions = 100;
+
+bool StartsWith(const base::string16& text, const base::string16& prefix) {
+  return base::StartsWith(text, prefix, base::CompareCase::INSENSITIVE_ASCII);
 }
 
 void TrimStringVectorForIPC(std::vector<base::string16>* strings) {
@@ -67,6 +64,7 @@ void AutofillAgent::DidChangeScrollOffset() {
 void AutofillAgent::FocusedNodeChanged(const blink::WebNode&) {
   focused_node_was_last_clicked_ = false;
   was_focused_before_now_ = false;
+  ClearMatchingSuggestions();
   HidePopup();
 }
 
@@ -113,6 +111,8 @@ void AutofillAgent::OpenTextDataListChooser(
 
 void AutofillAgent::DataListOptionsChanged(
     const blink::WebInputElement& element) {
+  if (element == matches_element_)
+    ClearMatchingSuggestions();
   if (!element.Focused())
     return;
 
@@ -147,8 +147,15 @@ void AutofillAgent::ShowSuggestions(const blink::WebFormControlElement& element,
   std::vector<base::string16> data_list_values;
   std::vector<base::string16> data_list_labels;
   if (input_element) {
-    GetDataListSuggestions(*input_element, &data_list_values,
-                           &data_list_labels);
+    const std::vector<Suggestion>& suggestions =
+        GetMatchingSuggestions(*input_element, value.Utf16());
+    size_t count = std::min(suggestions.size(), kMaxSuggestions);
+    data_list_values.reserve(count);
+    data_list_labels.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      data_list_values.push_back(suggestions[i].value);
+      data_list_labels.push_back(suggestions[i].label);
+    }
     TrimStringVectorForIPC(&data_list_values);
     TrimStringVectorForIPC(&data_list_labels);
   }
@@ -156,6 +163,44 @@ void AutofillAgent::ShowSuggestions(const blink::WebFormControlElement& element,
   ShowPopup(element, data_list_values, data_list_labels);
 }
 
+const std::vector<AutofillAgent::Suggestion>&
+AutofillAgent::GetMatchingSuggestions(const blink::WebInputElement& element,
+                                      const base::string16& query) {
+  auto matches_query = [&query](const Suggestion& suggestion) {
+    return StartsWith(suggestion.value, query) ||
+           StartsWith(suggestion.label, query);
+  };
+
+  // Every option that starts with |query| also starts with a prefix of it.
+  if (element == matches_element_ && StartsWith(query, matches_query_)) {
+    matches_.erase(
+        std::remove_if(matches_.begin(), matches_.end(),
+                       [&](const Suggestion& s) { return !matches_query(s); }),
+        matches_.end());
+    matches_query_ = query;
+    return matches_;
+  }
+
+  matches_.clear();
+  matches_element_ = element;
+  matches_query_ = query;
+  for (const auto& option : element.FilteredDataListOptions()) {
+    Suggestion suggestion;
+    suggestion.value = option.Value().Utf16();
+    if (option.Value() != option.Label())
+      suggestion.label = option.Label().Utf16();
+    if (matches_query(suggestion))
+      matches_.push_back(std::move(suggestion));
+  }
+  return matches_;
+}
+
+void AutofillAgent::ClearMatchingSuggestions() {
+  matches_element_.Reset();
+  matches_query_.clear();
+  matches_.clear();
+}
+
 void AutofillAgent::DidReceiveLeftMouseDownOrGestureTapInNode(
     const blink::WebNode& node) {
   focused_node_was_last_clicked_ = !node.IsNull() && node.Focused();
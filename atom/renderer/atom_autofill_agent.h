@@ -39,6 +39,11 @@ class AutofillAgent : public content::RenderFrameObserver,
     bool requires_caret_at_end;
   };
 
+  struct Suggestion {
+    base::string16 value;
+    base::string16 label;
+  };
+
   bool OnMessageReceived(const IPC::Message& message) override;
 
   // blink::WebAutofillClient:
@@ -61,6 +66,13 @@ class AutofillAgent : public content::RenderFrameObserver,
 
   void DoFocusChangeComplete();
 
+  // Returns the datalist options of |element| that start with |query|,
+  // narrowing the previous matches when |query| extends the previous query.
+  const std::vector<Suggestion>& GetMatchingSuggestions(
+      const blink::WebInputElement& element,
+      const base::string16& query);
+  void ClearMatchingSuggestions();
+
   // True when the last click was on the focused node.
   bool focused_node_was_last_clicked_ = false;
 
@@ -69,6 +81,11 @@ class AutofillAgent : public content::RenderFrameObserver,
   // already focused, or if it caused the focus to change.
   bool was_focused_before_now_ = false;
 
+  // The options of |matches_element_| that start with |matches_query_|.
+  blink::WebInputElement matches_element_;
+  base::string16 matches_query_;
+  std::vector<Suggestion> matches_;
+
   base::WeakPtrFactory<AutofillAgent> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(AutofillAgent);
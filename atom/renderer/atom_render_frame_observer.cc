@@ -5,28 +5,39 @@
 #include "atom/renderer/atom_render_frame_observer.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "atom/common/api/api_messages.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/heap_snapshot.h"
+#include "atom/common/ipc_channel_stats.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/node_includes.h"
+#include "atom/common/v8_value_serializer.h"
+#include "atom/renderer/memory_stats_reporter.h"
+#include "base/bind.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/strings/string_number_conversions.h"
-#include "base/threading/thread_restrictions.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
+#include "content/public/renderer/render_thread.h"
 #include "content/public/renderer/render_view.h"
 #include "ipc/ipc_message_macros.h"
 #include "native_mate/dictionary.h"
 #include "net/base/net_module.h"
 #include "net/grit/net_resources.h"
+#include "third_party/blink/public/common/message_port/message_port_channel.h"
+#include "third_party/blink/public/platform/web_cache.h"
+#include "third_party/blink/public/platform/web_security_origin.h"
 #include "third_party/blink/public/web/blink.h"
+#include "third_party/blink/public/web/web_dom_message_event.h"
 #include "third_party/blink/public/web/web_document.h"
 #include "third_party/blink/public/web/web_draggable_region.h"
 #include "third_party/blink/public/web/web_element.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_script_source.h"
+#include "third_party/blink/public/web/web_serialized_script_value.h"
 #include "ui/base/resource/resource_bundle.h"
 
 namespace atom {
@@ -69,6 +80,33 @@ base::StringPiece NetResourceProvider(int key) {
   return base::StringPiece();
 }
 
+// The snapshot is written after the frame may have gone away, so the results
+// are sent with the routing ID of the frame.
+void SendHeapSnapshotResult(int routing_id,
+                            const std::string& channel,
+                            bool success) {
+  base::ListValue args;
+  args.AppendString(channel);
+  args.AppendBoolean(success);
+  content::RenderThread::Get()->Send(
+      new AtomFrameHostMsg_Message(routing_id, "ipc-message", args));
+}
+
+void SendHeapSnapshotProgress(int routing_id,
+                              const std::string& channel,
+                              HeapSnapshotPhase phase,
+                              int64_t done,
+                              int64_t total) {
+  base::ListValue args;
+  args.AppendString(channel + "_PROGRESS");
+  args.AppendString(phase == HeapSnapshotPhase::kSnapshot ? "snapshot"
+                                                          : "write");
+  args.AppendDouble(done);
+  args.AppendDouble(total);
+  content::RenderThread::Get()->Send(
+      new AtomFrameHostMsg_Message(routing_id, "ipc-message", args));
+}
+
 }  // namespace
 
 AtomRenderFrameObserver::AtomRenderFrameObserver(
@@ -114,14 +152,28 @@ void AtomRenderFrameObserver::DraggableRegionsChanged() {
     region.draggable = webregion.draggable;
     regions.push_back(region);
   }
+  // Blink reports the regions after every layout, even when they are the
+  // same.
+  if (regions == draggable_regions_)
+    return;
+  draggable_regions_ = regions;
   Send(new AtomFrameHostMsg_UpdateDraggableRegions(routing_id(), regions));
 }
 
 void AtomRenderFrameObserver::WillReleaseScriptContext(
     v8::Local<v8::Context> context,
     int world_id) {
-  if (ShouldNotifyClient(world_id))
+  if (ShouldNotifyClient(world_id)) {
     renderer_client_->WillReleaseScriptContext(context, render_frame_);
+    // No script can reach the buffers of the rings after this.
+    shared_rings_.Clear();
+  }
+}
+
+void AtomRenderFrameObserver::DidCreateNewDocument() {
+  // The contexts of the previous document are gone even when they were never
+  // released, e.g. when the frame was reused for an empty document.
+  shared_rings_.Clear();
 }
 
 void AtomRenderFrameObserver::OnDestruct() {
@@ -163,9 +215,20 @@ bool AtomRenderFrameObserver::ShouldNotifyClient(int world_id) {
 
 bool AtomRenderFrameObserver::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
+  received_message_size_ = message.size();
   IPC_BEGIN_MESSAGE_MAP(AtomRenderFrameObserver, message)
     IPC_MESSAGE_HANDLER(AtomFrameMsg_Message, OnBrowserMessage)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_Message_Serialized,
+                        OnBrowserMessageSerialized)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_InvokeReply, OnInvokeReply)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_Port, OnPort)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_SharedRing, OnSharedRing)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_SharedRingDoorbell, OnSharedRingDoorbell)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_SharedRingClose, OnSharedRingClose)
     IPC_MESSAGE_HANDLER(AtomFrameMsg_TakeHeapSnapshot, OnTakeHeapSnapshot)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_StartHeapSampling, OnStartHeapSampling)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_StopHeapSampling, OnStopHeapSampling)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_PurgeMemory, OnPurgeMemory)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
 
@@ -177,43 +240,208 @@ void AtomRenderFrameObserver::OnBrowserMessage(bool internal,
                                                const std::string& channel,
                                                const base::ListValue& args,
                                                int32_t sender_id) {
+  TRACE_EVENT1("electron", "AtomRenderFrameObserver::OnBrowserMessage",
+               "channel", channel);
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (blink::WebLocalFrame* frame : GetMessageTargets(send_to_all))
+    EmitIPCEvent(frame, internal, channel, args, sender_id);
+  IPCChannelStats::GetInstance()->Record(
+      IPCChannelStats::Direction::kReceived, channel, received_message_size_,
+      base::TimeTicks::Now() - start);
+}
+
+void AtomRenderFrameObserver::OnBrowserMessageSerialized(
+    bool internal,
+    bool send_to_all,
+    const std::string& channel,
+    const std::vector<uint8_t>& args,
+    const std::vector<base::UnsafeSharedMemoryRegion>& array_buffers,
+    int32_t sender_id) {
+  // The arguments are deserialized separately in each frame's context, the
+  // frames share the memory of transferred ArrayBuffers.
+  TRACE_EVENT1("electron",
+               "AtomRenderFrameObserver::OnBrowserMessageSerialized",
+               "channel", channel);
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (blink::WebLocalFrame* frame : GetMessageTargets(send_to_all))
+    EmitSerializedIPCEvent(frame, internal, channel, args, array_buffers,
+                           sender_id);
+  IPCChannelStats::GetInstance()->Record(
+      IPCChannelStats::Direction::kReceived, channel, received_message_size_,
+      base::TimeTicks::Now() - start);
+}
+
+std::vector<blink::WebLocalFrame*> AtomRenderFrameObserver::GetMessageTargets(
+    bool send_to_all) {
+  std::vector<blink::WebLocalFrame*> frames;
+
   // Don't handle browser messages before document element is created.
   // When we receive a message from the browser, we try to transfer it
   // to a web page, and when we do that Blink creates an empty
   // document element if it hasn't been created yet, and it makes our init
   // script to run while `window.location` is still "about:blank".
   if (!document_created_)
-    return;
+    return frames;
 
   blink::WebLocalFrame* frame = render_frame_->GetWebFrame();
   if (!frame || !render_frame_->IsMainFrame())
-    return;
+    return frames;
 
-  EmitIPCEvent(frame, internal, channel, args, sender_id);
+  frames.push_back(frame);
 
   // Also send the message to all sub-frames.
   if (send_to_all) {
     for (blink::WebFrame* child = frame->FirstChild(); child;
          child = child->NextSibling())
-      if (child->IsWebLocalFrame()) {
-        EmitIPCEvent(child->ToWebLocalFrame(), internal, channel, args,
-                     sender_id);
-      }
+      if (child->IsWebLocalFrame())
+        frames.push_back(child->ToWebLocalFrame());
   }
+  return frames;
+}
+
+void AtomRenderFrameObserver::OnInvokeReply(int request_id,
+                                            bool success,
+                                            const base::ListValue& result) {
+  // The reply goes to the frame that made the request, which is not
+  // necessarily the main frame.
+  base::ListValue args;
+  args.AppendInteger(request_id);
+  args.AppendBoolean(success);
+  for (const base::Value& value : result.GetList())
+    args.GetList().push_back(value.Clone());
+  EmitIPCEvent(render_frame_->GetWebFrame(), true,
+               "ELECTRON_RENDERER_INVOKE_REPLY", args, 0);
+}
+
+void AtomRenderFrameObserver::OnPort(int request_id,
+                                     const std::string& channel,
+                                     int32_t sender_id,
+                                     mojo::MessagePipeHandle port) {
+  mojo::ScopedMessagePipeHandle handle(port);
+  blink::WebLocalFrame* frame = render_frame_->GetWebFrame();
+  if (!frame)
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = frame->MainWorldScriptContext();
+  v8::Context::Scope context_scope(context);
+
+  mate::Dictionary data = mate::Dictionary::CreateEmpty(isolate);
+  data.Set("type", "ELECTRON_IPC_PORT");
+  data.Set("requestId", request_id);
+  data.Set("channel", channel);
+  data.Set("senderId", sender_id);
+
+  // Blink only creates MessagePort objects when dispatching message events,
+  // so the port is delivered to the window and picked up by ipcRenderer.
+  blink::WebVector<blink::MessagePortChannel> ports;
+  if (handle.is_valid())
+    ports = blink::WebVector<blink::MessagePortChannel>(
+        std::vector<blink::MessagePortChannel>{
+            blink::MessagePortChannel(std::move(handle))});
+  blink::WebDOMMessageEvent event(
+      blink::WebSerializedScriptValue::Serialize(isolate, data.GetHandle()),
+      blink::WebString(), nullptr, frame->GetDocument(), std::move(ports));
+  frame->DispatchMessageEventWithOriginCheck(blink::WebSecurityOrigin(), event,
+                                             false);
+}
+
+void AtomRenderFrameObserver::OnSharedRing(
+    const std::string& channel,
+    int32_t ring_id,
+    const base::UnsafeSharedMemoryRegion& region) {
+  blink::WebLocalFrame* frame = render_frame_->GetWebFrame();
+  if (!frame)
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
+  v8::Context::Scope context_scope(context);
+
+  // Only emit IPC event for context with node integration.
+  if (!node::Environment::GetCurrent(context))
+    return;
+
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return;
+
+  std::vector<v8::Local<v8::Value>> args = {
+      mate::ConvertToV8(isolate, channel), mate::ConvertToV8(isolate, ring_id),
+      shared_rings_.Create(isolate, std::move(mapping))};
+  EmitIPCEventInContext(context, true, "ELECTRON_SHARED_RING", std::move(args),
+                        0);
+}
+
+void AtomRenderFrameObserver::OnSharedRingDoorbell(int32_t ring_id) {
+  base::ListValue args;
+  args.AppendInteger(ring_id);
+  EmitIPCEvent(render_frame_->GetWebFrame(), true,
+               "ELECTRON_SHARED_RING_DOORBELL", args, 0);
+}
+
+void AtomRenderFrameObserver::OnSharedRingClose(int32_t ring_id) {
+  base::ListValue args;
+  args.AppendInteger(ring_id);
+  EmitIPCEvent(render_frame_->GetWebFrame(), true, "ELECTRON_SHARED_RING_CLOSE",
+               args, 0);
 }
 
 void AtomRenderFrameObserver::OnTakeHeapSnapshot(
     IPC::PlatformFileForTransit file_handle,
     const std::string& channel) {
-  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  int routing_id = render_frame_->GetRoutingID();
+  TakeHeapSnapshotAsync(
+      blink::MainThreadIsolate(),
+      IPC::PlatformFileForTransitToFile(file_handle),
+      base::BindRepeating(&SendHeapSnapshotProgress, routing_id, channel),
+      base::BindOnce(&SendHeapSnapshotResult, routing_id, channel));
+}
+
+void AtomRenderFrameObserver::OnStartHeapSampling(int sample_interval,
+                                                  int stack_depth) {
+  StartSamplingHeapProfiler(blink::MainThreadIsolate(), sample_interval,
+                            stack_depth);
+}
 
-  auto file = IPC::PlatformFileForTransitToFile(file_handle);
-  bool success = TakeHeapSnapshot(blink::MainThreadIsolate(), &file);
+void AtomRenderFrameObserver::OnStopHeapSampling(
+    IPC::PlatformFileForTransit file_handle,
+    const std::string& channel) {
+  StopSamplingHeapProfiler(
+      blink::MainThreadIsolate(),
+      IPC::PlatformFileForTransitToFile(file_handle),
+      base::BindOnce(&SendHeapSnapshotResult, render_frame_->GetRoutingID(),
+                     channel));
+}
+
+void AtomRenderFrameObserver::OnPurgeMemory(bool critical,
+                                            const std::string& channel) {
+  TRACE_EVENT1("electron", "AtomRenderFrameObserver::OnPurgeMemory",
+               "critical", critical);
+  base::DictionaryValue before = MemoryStatsReporter::GetStats();
+
+  // Blink's listeners drop its caches, including the decoded images, and
+  // the compositor releases its resources.
+  base::MemoryPressureListener::NotifyMemoryPressure(
+      critical ? base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL
+               : base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+
+  // Node shares the isolate with the page, so this collects its heap too.
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  if (critical) {
+    blink::WebCache::Clear();
+    isolate->LowMemoryNotification();
+  } else {
+    isolate->MemoryPressureNotification(v8::MemoryPressureLevel::kModerate);
+  }
 
   base::ListValue args;
   args.AppendString(channel);
-  args.AppendBoolean(success);
-
+  args.GetList().push_back(std::move(before));
+  args.GetList().push_back(MemoryStatsReporter::GetStats());
   render_frame_->Send(new AtomFrameHostMsg_Message(
       render_frame_->GetRoutingID(), "ipc-message", args));
 }
@@ -233,20 +461,59 @@ void AtomRenderFrameObserver::EmitIPCEvent(blink::WebLocalFrame* frame,
   v8::Context::Scope context_scope(context);
 
   // Only emit IPC event for context with node integration.
-  node::Environment* env = node::Environment::GetCurrent(context);
-  if (!env)
+  if (!node::Environment::GetCurrent(context))
+    return;
+
+  EmitIPCEventInContext(context, internal, channel,
+                        ListValueToVector(isolate, args), sender_id);
+}
+
+void AtomRenderFrameObserver::EmitSerializedIPCEvent(
+    blink::WebLocalFrame* frame,
+    bool internal,
+    const std::string& channel,
+    const std::vector<uint8_t>& args,
+    const std::vector<base::UnsafeSharedMemoryRegion>& array_buffers,
+    int32_t sender_id) {
+  if (!frame)
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
+  v8::Context::Scope context_scope(context);
+
+  // Only emit IPC event for context with node integration.
+  if (!node::Environment::GetCurrent(context))
     return;
 
+  v8::Local<v8::Value> value;
+  std::vector<v8::Local<v8::Value>> args_vector;
+  if (!DeserializeV8Value(isolate, args, array_buffers, &value) ||
+      !mate::ConvertFromV8(isolate, value, &args_vector))
+    return;
+
+  EmitIPCEventInContext(context, internal, channel, std::move(args_vector),
+                        sender_id);
+}
+
+void AtomRenderFrameObserver::EmitIPCEventInContext(
+    v8::Local<v8::Context> context,
+    bool internal,
+    const std::string& channel,
+    std::vector<v8::Local<v8::Value>> args,
+    int32_t sender_id) {
+  v8::Isolate* isolate = context->GetIsolate();
   v8::Local<v8::Object> ipc;
   if (GetIPCObject(isolate, context, internal, &ipc)) {
     TRACE_EVENT0("devtools.timeline", "FunctionCall");
-    auto args_vector = ListValueToVector(isolate, args);
     // Insert the Event object, event.sender is ipc.
     mate::Dictionary event = mate::Dictionary::CreateEmpty(isolate);
     event.Set("sender", ipc);
     event.Set("senderId", sender_id);
-    args_vector.insert(args_vector.begin(), event.GetHandle());
-    mate::EmitEvent(isolate, ipc, channel, args_vector);
+    args.insert(args.begin(), event.GetHandle());
+    mate::EmitEvent(isolate, ipc, channel, args);
   }
 }
 
@@ -6,11 +6,16 @@
 #define ATOM_RENDERER_ATOM_RENDER_FRAME_OBSERVER_H_
 
 #include <string>
+#include <vector>
 
+#include "atom/common/draggable_region.h"
+#include "atom/common/mapped_shared_array_buffer.h"
 #include "atom/renderer/renderer_client_base.h"
+#include "base/memory/unsafe_shared_memory_region.h"
 #include "base/strings/string16.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "ipc/ipc_platform_file.h"
+#include "mojo/public/cpp/system/message_pipe.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 
 namespace base {
@@ -39,6 +44,7 @@ class AtomRenderFrameObserver : public content::RenderFrameObserver {
   void DraggableRegionsChanged() override;
   void WillReleaseScriptContext(v8::Local<v8::Context> context,
                                 int world_id) override;
+  void DidCreateNewDocument() override;
   void OnDestruct() override;
   bool OnMessageReceived(const IPC::Message& message) override;
   void DidCreateDocumentElement() override;
@@ -49,6 +55,14 @@ class AtomRenderFrameObserver : public content::RenderFrameObserver {
                             const std::string& channel,
                             const base::ListValue& args,
                             int32_t sender_id);
+  // Same with EmitIPCEvent, but |args| was written by v8::ValueSerializer.
+  virtual void EmitSerializedIPCEvent(
+      blink::WebLocalFrame* frame,
+      bool internal,
+      const std::string& channel,
+      const std::vector<uint8_t>& args,
+      const std::vector<base::UnsafeSharedMemoryRegion>& array_buffers,
+      int32_t sender_id);
 
  private:
   bool ShouldNotifyClient(int world_id);
@@ -60,12 +74,49 @@ class AtomRenderFrameObserver : public content::RenderFrameObserver {
                         const std::string& channel,
                         const base::ListValue& args,
                         int32_t sender_id);
+  void OnBrowserMessageSerialized(
+      bool internal,
+      bool send_to_all,
+      const std::string& channel,
+      const std::vector<uint8_t>& args,
+      const std::vector<base::UnsafeSharedMemoryRegion>& array_buffers,
+      int32_t sender_id);
+  // Returns the frames that a message from the browser is emitted in.
+  std::vector<blink::WebLocalFrame*> GetMessageTargets(bool send_to_all);
+  void EmitIPCEventInContext(v8::Local<v8::Context> context,
+                             bool internal,
+                             const std::string& channel,
+                             std::vector<v8::Local<v8::Value>> args,
+                             int32_t sender_id);
+  void OnInvokeReply(int request_id,
+                     bool success,
+                     const base::ListValue& result);
+  void OnPort(int request_id,
+              const std::string& channel,
+              int32_t sender_id,
+              mojo::MessagePipeHandle port);
+  void OnSharedRing(const std::string& channel,
+                    int32_t ring_id,
+                    const base::UnsafeSharedMemoryRegion& region);
+  void OnSharedRingDoorbell(int32_t ring_id);
+  void OnSharedRingClose(int32_t ring_id);
   void OnTakeHeapSnapshot(IPC::PlatformFileForTransit file_handle,
                           const std::string& channel);
+  void OnStartHeapSampling(int sample_interval, int stack_depth);
+  void OnStopHeapSampling(IPC::PlatformFileForTransit file_handle,
+                          const std::string& channel);
+  void OnPurgeMemory(bool critical, const std::string& channel);
 
   content::RenderFrame* render_frame_;
   RendererClientBase* renderer_client_;
   bool document_created_ = false;
+  // The size of the IPC message being dispatched, for IPCChannelStats.
+  size_t received_message_size_ = 0;
+  // The regions that were last sent to the browser.
+  std::vector<DraggableRegion> draggable_regions_;
+  // The memory of the shared rings, unmapped when the context they were given
+  // to is released.
+  MappedSharedArrayBuffers shared_rings_;
 
   DISALLOW_COPY_AND_ASSIGN(AtomRenderFrameObserver);
 };
@@ -12,6 +12,7 @@
 #include "atom/common/asar/asar_util.h"
 #include "atom/common/node_bindings.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
 #include "atom/renderer/api/atom_api_renderer_ipc.h"
 #include "atom/renderer/atom_render_frame_observer.h"
 #include "atom/renderer/web_worker_observer.h"
@@ -38,7 +39,7 @@ bool IsDevToolsExtension(content::RenderFrame* render_frame) {
 
 AtomRendererClient::AtomRendererClient()
     : node_bindings_(NodeBindings::Create(NodeBindings::RENDERER)),
-      atom_bindings_(new AtomBindings(uv_default_loop())) {}
+      atom_bindings_(new AtomBindings(node_bindings_.get())) {}
 
 AtomRendererClient::~AtomRendererClient() {
   asar::ClearArchives();
@@ -46,6 +47,17 @@ AtomRendererClient::~AtomRendererClient() {
 
 void AtomRendererClient::RenderThreadStarted() {
   RendererClientBase::RenderThreadStarted();
+
+  // A spare process has time to prepare node before it gets a page, but only
+  // pages with node integration need it to be ready that early.
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  if (command_line->HasSwitch(switches::kSpareRenderer) &&
+      command_line->GetSwitchValueASCII(switches::kNodeIntegration) ==
+          "true") {
+    node_integration_initialized_ = true;
+    node_bindings_->Initialize();
+    node_bindings_->PrepareMessageLoop();
+  }
 }
 
 void AtomRendererClient::RenderFrameCreated(
@@ -80,6 +92,7 @@ void AtomRendererClient::DidCreateScriptContext(
     v8::Handle<v8::Context> context,
     content::RenderFrame* render_frame) {
   RendererClientBase::DidCreateScriptContext(context, render_frame);
+  StartupTimeline::AddMark("didCreateScriptContext");
 
   // Only allow node integration for the main frame of the top window, unless it
   // is a devtools extension page. Allowing child frames or child windows to
@@ -220,6 +233,9 @@ void AtomRendererClient::SetupMainWorldOverrides(
   dict.Set("hiddenPage", command_line->HasSwitch(switches::kHiddenPage));
   dict.Set(options::kNativeWindowOpen,
            command_line->HasSwitch(switches::kNativeWindowOpen));
+  if (command_line->HasSwitch(switches::kGpuPreference))
+    dict.Set(options::kGpuPreference,
+             command_line->GetSwitchValueASCII(switches::kGpuPreference));
 
   v8::Local<v8::Value> args[] = {binding};
   ignore_result(func->Call(context, v8::Null(isolate), 1, args));
@@ -4,6 +4,10 @@
 
 #include "atom/renderer/atom_sandboxed_renderer_client.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "atom/common/api/api_messages.h"
 #include "atom/common/api/atom_bindings.h"
 #include "atom/common/application_info.h"
@@ -11,8 +15,10 @@
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/node_bindings.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/v8_value_serializer.h"
 #include "atom/renderer/api/atom_api_renderer_ipc.h"
 #include "atom/renderer/atom_render_frame_observer.h"
+#include "atom/renderer/code_cache_util.h"
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/files/file_path.h"
@@ -32,6 +38,7 @@ namespace {
 
 const char kIpcKey[] = "ipcNative";
 const char kModuleCacheKey[] = "native-module-cache";
+const char kBundleCodeCacheKey[] = "preload-bundle";
 
 bool IsDevTools(content::RenderFrame* render_frame) {
   return render_frame->GetWebFrame()->GetDocument().Url().ProtocolIs(
@@ -80,11 +87,25 @@ v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
   return exports;
 }
 
+// |cache_key| identifies the version of the preload script, an empty key
+// compiles it without a code cache.
 v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
-                                         v8::Local<v8::String> preloadSrc) {
-  auto script = v8::Script::Compile(preloadSrc);
-  auto func = script->Run();
-  return func;
+                                         v8::Local<v8::String> preloadSrc,
+                                         mate::Arguments* args) {
+  auto context = isolate->GetCurrentContext();
+  std::string cache_key;
+  args->GetNext(&cache_key);
+
+  v8::Local<v8::Script> script;
+  if (cache_key.empty()) {
+    v8::ScriptCompiler::Source source(preloadSrc);
+    if (!v8::ScriptCompiler::Compile(context, &source).ToLocal(&script))
+      return v8::Undefined(isolate);
+  } else if (!CompileWithCodeCache(context, preloadSrc, cache_key, nullptr)
+                  .ToLocal(&script)) {
+    return v8::Undefined(isolate);
+  }
+  return script->Run(context).FromMaybe(v8::Local<v8::Value>());
 }
 
 class AtomSandboxedRenderFrameObserver : public AtomRenderFrameObserver {
@@ -115,6 +136,30 @@ class AtomSandboxedRenderFrameObserver : public AtomRenderFrameObserver {
         std::vector<v8::Local<v8::Value>>(argv, argv + node::arraysize(argv)));
   }
 
+  void EmitSerializedIPCEvent(
+      blink::WebLocalFrame* frame,
+      bool internal,
+      const std::string& channel,
+      const std::vector<uint8_t>& args,
+      const std::vector<base::UnsafeSharedMemoryRegion>& array_buffers,
+      int32_t sender_id) override {
+    if (!frame)
+      return;
+
+    auto* isolate = blink::MainThreadIsolate();
+    v8::HandleScope handle_scope(isolate);
+    auto context = frame->MainWorldScriptContext();
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::Value> value;
+    if (!DeserializeV8Value(isolate, args, array_buffers, &value))
+      return;
+    v8::Local<v8::Value> argv[] = {mate::ConvertToV8(isolate, channel), value,
+                                   mate::ConvertToV8(isolate, sender_id)};
+    renderer_client_->InvokeIpcCallback(
+        context, internal ? "onInternalMessage" : "onMessage",
+        std::vector<v8::Local<v8::Value>>(argv, argv + node::arraysize(argv)));
+  }
+
  private:
   AtomSandboxedRendererClient* renderer_client_;
   DISALLOW_COPY_AND_ASSIGN(AtomSandboxedRenderFrameObserver);
@@ -200,10 +245,16 @@ void AtomSandboxedRendererClient::DidCreateScriptContext(
   std::string left = "(function(binding, require) {\n";
   std::string right = "\n})";
   // Compile the wrapper and run it to get the function object
-  auto script = v8::Script::Compile(v8::String::Concat(
-      mate::ConvertToV8(isolate, left)->ToString(),
-      v8::String::Concat(node::preload_bundle_value.ToStringChecked(isolate),
-                         mate::ConvertToV8(isolate, right)->ToString())));
+  auto script =
+      CompileWithCodeCache(
+          context,
+          v8::String::Concat(
+              mate::ConvertToV8(isolate, left)->ToString(),
+              v8::String::Concat(
+                  node::preload_bundle_value.ToStringChecked(isolate),
+                  mate::ConvertToV8(isolate, right)->ToString())),
+          kBundleCodeCacheKey, nullptr)
+          .ToLocalChecked();
   auto func =
       v8::Handle<v8::Function>::Cast(script->Run(context).ToLocalChecked());
   // Create and initialize the binding object
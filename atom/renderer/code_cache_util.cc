@@ -0,0 +1,80 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/renderer/code_cache_util.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/no_destructor.h"
+
+namespace atom {
+
+namespace {
+
+// Enough for the sandbox bundle, the preload scripts and the content scripts
+// of a handful of extensions.
+const size_t kMaxCodeCaches = 32;
+
+using CodeCache = base::MRUCache<std::string, std::vector<uint8_t>>;
+
+CodeCache* GetCodeCache() {
+  static base::NoDestructor<CodeCache> cache(kMaxCodeCaches);
+  return cache.get();
+}
+
+// v8::ScriptCompiler::Source can be neither copied nor moved.
+std::unique_ptr<v8::ScriptCompiler::Source> MakeSource(
+    v8::Local<v8::String> source,
+    v8::ScriptOrigin* origin,
+    v8::ScriptCompiler::CachedData* cached_data) {
+  if (origin)
+    return std::make_unique<v8::ScriptCompiler::Source>(source, *origin,
+                                                        cached_data);
+  return std::make_unique<v8::ScriptCompiler::Source>(source, cached_data);
+}
+
+}  // namespace
+
+v8::MaybeLocal<v8::Script> CompileWithCodeCache(v8::Local<v8::Context> context,
+                                                v8::Local<v8::String> source,
+                                                const std::string& cache_key,
+                                                v8::ScriptOrigin* origin) {
+  CodeCache* cache = GetCodeCache();
+  v8::Local<v8::Script> script;
+
+  auto it = cache->Get(cache_key);
+  if (it != cache->end()) {
+    const std::vector<uint8_t>& data = it->second;
+    std::unique_ptr<v8::ScriptCompiler::Source> cached_source = MakeSource(
+        source, origin,
+        new v8::ScriptCompiler::CachedData(data.data(),
+                                           static_cast<int>(data.size())));
+    // A rejected cache still compiles the script, whose cache then replaces
+    // the rejected one.
+    if (v8::ScriptCompiler::Compile(context, cached_source.get(),
+                                    v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocal(&script) &&
+        !cached_source->GetCachedData()->rejected)
+      return script;
+  }
+
+  if (script.IsEmpty()) {
+    std::unique_ptr<v8::ScriptCompiler::Source> plain_source =
+        MakeSource(source, origin, nullptr);
+    if (!v8::ScriptCompiler::Compile(context, plain_source.get())
+             .ToLocal(&script))
+      return v8::MaybeLocal<v8::Script>();
+  }
+
+  std::unique_ptr<v8::ScriptCompiler::CachedData> data(
+      v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+  if (data)
+    cache->Put(cache_key,
+               std::vector<uint8_t>(data->data, data->data + data->length));
+  return script;
+}
+
+}  // namespace atom
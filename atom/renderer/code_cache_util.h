@@ -0,0 +1,24 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_RENDERER_CODE_CACHE_UTIL_H_
+#define ATOM_RENDERER_CODE_CACHE_UTIL_H_
+
+#include <string>
+
+#include "v8/include/v8.h"
+
+namespace atom {
+
+// Compiles |source| in |context|, reusing the code cache stored under
+// |cache_key|. The caches are kept for the lifetime of the renderer process,
+// so |cache_key| must change whenever the source does. |origin| may be null.
+v8::MaybeLocal<v8::Script> CompileWithCodeCache(v8::Local<v8::Context> context,
+                                                v8::Local<v8::String> source,
+                                                const std::string& cache_key,
+                                                v8::ScriptOrigin* origin);
+
+}  // namespace atom
+
+#endif  // ATOM_RENDERER_CODE_CACHE_UTIL_H_
@@ -0,0 +1,73 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/renderer/memory_stats_reporter.h"
+
+#include <utility>
+
+#include "atom/common/api/api_messages.h"
+#include "content/public/renderer/render_thread.h"
+#include "third_party/blink/public/platform/web_cache.h"
+#include "third_party/blink/public/web/blink.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+MemoryStatsReporter::MemoryStatsReporter() {
+  content::RenderThread::Get()->AddObserver(this);
+}
+
+MemoryStatsReporter::~MemoryStatsReporter() {}
+
+bool MemoryStatsReporter::OnControlMessageReceived(
+    const IPC::Message& message) {
+  bool handled = true;
+  IPC_BEGIN_MESSAGE_MAP(MemoryStatsReporter, message)
+    IPC_MESSAGE_HANDLER(AtomMsg_RequestMemoryStats, OnRequestMemoryStats)
+    IPC_MESSAGE_UNHANDLED(handled = false)
+  IPC_END_MESSAGE_MAP()
+  return handled;
+}
+
+// static
+base::DictionaryValue MemoryStatsReporter::GetStats() {
+  base::DictionaryValue stats;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  if (isolate) {
+    v8::HeapStatistics heap;
+    isolate->GetHeapStatistics(&heap);
+    base::DictionaryValue js_heap;
+    js_heap.SetInteger("used", static_cast<int>(heap.used_heap_size() >> 10));
+    js_heap.SetInteger("total",
+                       static_cast<int>(heap.total_heap_size() >> 10));
+    stats.SetKey("jsHeap", std::move(js_heap));
+  }
+
+  blink::WebCache::ResourceTypeStats cache;
+  blink::WebCache::GetResourceTypeStats(&cache);
+  size_t size = 0;
+  // Blink's decoded size, e.g. the bitmaps of the images and the parsed style
+  // sheets, counted whether the resources are used by a document or not.
+  size_t decoded_size = 0;
+  for (const auto* stat : {&cache.images, &cache.css_style_sheets,
+                           &cache.scripts, &cache.xsl_style_sheets,
+                           &cache.fonts, &cache.other}) {
+    size += stat->size;
+    decoded_size += stat->decoded_size;
+  }
+  base::DictionaryValue memory_cache;
+  memory_cache.SetInteger("size", static_cast<int>(size >> 10));
+  memory_cache.SetInteger("decodedSize",
+                          static_cast<int>(decoded_size >> 10));
+  stats.SetKey("memoryCache", std::move(memory_cache));
+  return stats;
+}
+
+void MemoryStatsReporter::OnRequestMemoryStats(int request_id) {
+  content::RenderThread::Get()->Send(
+      new AtomHostMsg_MemoryStats(request_id, GetStats()));
+}
+
+}  // namespace atom
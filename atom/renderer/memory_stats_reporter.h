@@ -0,0 +1,34 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_RENDERER_MEMORY_STATS_REPORTER_H_
+#define ATOM_RENDERER_MEMORY_STATS_REPORTER_H_
+
+#include "base/values.h"
+#include "content/public/renderer/render_thread_observer.h"
+
+namespace atom {
+
+// Reports the memory of the main thread's V8 heap and of Blink's memory cache
+// when the browser asks for it, see app.getAppMemoryMetrics().
+class MemoryStatsReporter : public content::RenderThreadObserver {
+ public:
+  MemoryStatsReporter();
+  ~MemoryStatsReporter() override;
+
+  // The sizes in kilobytes, as reported to the browser.
+  static base::DictionaryValue GetStats();
+
+ private:
+  // content::RenderThreadObserver:
+  bool OnControlMessageReceived(const IPC::Message& message) override;
+
+  void OnRequestMemoryStats(int request_id);
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryStatsReporter);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_RENDERER_MEMORY_STATS_REPORTER_H_
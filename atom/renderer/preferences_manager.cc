@@ -15,20 +15,63 @@ PreferencesManager::PreferencesManager() {
 
 PreferencesManager::~PreferencesManager() {}
 
+const base::ListValue* PreferencesManager::preferences() const {
+  if (!received_)
+    return nullptr;
+
+  if (!preferences_) {
+    preferences_ = std::make_unique<base::ListValue>();
+    for (const auto& iter : entries_)
+      preferences_->Append(base::Value::ToUniquePtrValue(iter.second->Clone()));
+  }
+  return preferences_.get();
+}
+
 bool PreferencesManager::OnControlMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(PreferencesManager, message)
     IPC_MESSAGE_HANDLER(AtomMsg_UpdatePreferences, OnUpdatePreferences)
+    IPC_MESSAGE_HANDLER(AtomMsg_SetPreference, OnSetPreference)
+    IPC_MESSAGE_HANDLER(AtomMsg_RemovePreference, OnRemovePreference)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
   return handled;
 }
 
-void PreferencesManager::OnUpdatePreferences(
-    const base::ListValue& preferences) {
-  auto copy =
-      base::ListValue::From(base::Value::ToUniquePtrValue(preferences.Clone()));
-  preferences_.swap(copy);
+void PreferencesManager::OnUpdatePreferences(uint64_t version,
+                                             const std::vector<int>& ids,
+                                             const base::ListValue& entries) {
+  const base::Value::ListStorage& list = entries.GetList();
+  if (ids.size() != list.size())
+    return;
+
+  entries_.clear();
+  for (size_t i = 0; i < ids.size(); ++i)
+    entries_[ids[i]] = base::Value::ToUniquePtrValue(list[i].Clone());
+  received_ = true;
+  version_ = version;
+  preferences_.reset();
+}
+
+void PreferencesManager::OnSetPreference(uint64_t version,
+                                         int id,
+                                         const base::DictionaryValue& entry) {
+  // The change is already part of the entries that were sent.
+  if (!received_ || version <= version_)
+    return;
+
+  entries_[id] = base::Value::ToUniquePtrValue(entry.Clone());
+  version_ = version;
+  preferences_.reset();
+}
+
+void PreferencesManager::OnRemovePreference(uint64_t version, int id) {
+  if (!received_ || version <= version_)
+    return;
+
+  entries_.erase(id);
+  version_ = version;
+  preferences_.reset();
 }
 
 }  // namespace atom
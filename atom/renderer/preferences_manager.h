@@ -5,7 +5,9 @@
 #ifndef ATOM_RENDERER_PREFERENCES_MANAGER_H_
 #define ATOM_RENDERER_PREFERENCES_MANAGER_H_
 
+#include <map>
 #include <memory>
+#include <vector>
 
 #include "base/values.h"
 #include "content/public/renderer/render_thread_observer.h"
@@ -17,15 +19,27 @@ class PreferencesManager : public content::RenderThreadObserver {
   PreferencesManager();
   ~PreferencesManager() override;
 
-  const base::ListValue* preferences() const { return preferences_.get(); }
+  // Returns null until the browser has sent the preferences.
+  const base::ListValue* preferences() const;
 
  private:
   // content::RenderThreadObserver:
   bool OnControlMessageReceived(const IPC::Message& message) override;
 
-  void OnUpdatePreferences(const base::ListValue& preferences);
+  void OnUpdatePreferences(uint64_t version,
+                           const std::vector<int>& ids,
+                           const base::ListValue& entries);
+  void OnSetPreference(uint64_t version,
+                       int id,
+                       const base::DictionaryValue& entry);
+  void OnRemovePreference(uint64_t version, int id);
 
-  std::unique_ptr<base::ListValue> preferences_;
+  bool received_ = false;
+  uint64_t version_ = 0;
+  std::map<int, std::unique_ptr<base::Value>> entries_;
+
+  // The |entries_| as a list, built when they are read after a change.
+  mutable std::unique_ptr<base::ListValue> preferences_;
 
   DISALLOW_COPY_AND_ASSIGN(PreferencesManager);
 };
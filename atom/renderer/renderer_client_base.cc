@@ -4,19 +4,28 @@
 
 #include "atom/renderer/renderer_client_base.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "atom/common/asar/archive.h"
 #include "atom/common/color_util.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/options_switches.h"
+#include "atom/renderer/asar_index_client.h"
 #include "atom/renderer/atom_autofill_agent.h"
 #include "atom/renderer/atom_render_frame_observer.h"
 #include "atom/renderer/atom_render_view_observer.h"
+#include "atom/renderer/code_cache_util.h"
 #include "atom/renderer/content_settings_observer.h"
+#include "atom/renderer/memory_stats_reporter.h"
 #include "atom/renderer/preferences_manager.h"
+#include "atom/renderer/user_style_sheets.h"
+#include "atom/renderer/web_worker_observer.h"
 #include "base/command_line.h"
+#include "base/hash.h"
+#include "base/strings/pattern.h"
 #include "base/strings/string_split.h"
 #include "base/strings/stringprintf.h"
 #include "content/public/common/content_constants.h"
@@ -24,11 +33,14 @@
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_view.h"
 #include "electron/buildflags/buildflags.h"
+#include "native_mate/arguments.h"
 #include "native_mate/dictionary.h"
 #include "printing/buildflags/buildflags.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_custom_element.h"  // NOLINT(build/include_alpha)
+#include "third_party/blink/public/web/web_document.h"
 #include "third_party/blink/public/web/web_frame_widget.h"
+#include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_plugin_params.h"
 #include "third_party/blink/public/web/web_script_source.h"
 #include "third_party/blink/public/web/web_security_policy.h"
@@ -72,6 +84,97 @@ v8::Local<v8::Value> GetRenderProcessPreferences(
     return v8::Null(isolate);
 }
 
+// https://developer.chrome.com/extensions/match_patterns
+bool MatchesPattern(const std::string& url, const base::Value& pattern) {
+  if (!pattern.is_string())
+    return false;
+  const std::string& pattern_string = pattern.GetString();
+  return pattern_string == "<all_urls>" ||
+         base::MatchPattern(url, pattern_string);
+}
+
+// Returns the content scripts of the extensions whose patterns match the
+// document of the current frame, as [{extensionId, script}].
+v8::Local<v8::Value> GetContentScripts(
+    const PreferencesManager* preferences_manager,
+    v8::Isolate* isolate) {
+  base::ListValue content_scripts;
+  const base::ListValue* preferences = preferences_manager->preferences();
+  blink::WebLocalFrame* frame = blink::WebLocalFrame::FrameForCurrentContext();
+  if (!preferences || !frame)
+    return mate::ConvertToV8(isolate, content_scripts);
+
+  // Patterns are matched against the URL without its query and fragment.
+  GURL document_url = frame->GetDocument().Url();
+  std::string url = document_url.scheme() + "://" + document_url.host();
+  if (document_url.has_port())
+    url += ":" + document_url.port();
+  url += document_url.path();
+
+  for (const auto& preference : preferences->GetList()) {
+    const base::Value* extension_id =
+        preference.FindKeyOfType("extensionId", base::Value::Type::STRING);
+    const base::Value* scripts =
+        preference.FindKeyOfType("contentScripts", base::Value::Type::LIST);
+    if (!extension_id || !scripts)
+      continue;
+    for (const auto& script : scripts->GetList()) {
+      const base::Value* matches =
+          script.FindKeyOfType("matches", base::Value::Type::LIST);
+      if (!matches ||
+          std::none_of(matches->GetList().begin(), matches->GetList().end(),
+                       [&url](const base::Value& pattern) {
+                         return MatchesPattern(url, pattern);
+                       }))
+        continue;
+      base::Value entry(base::Value::Type::DICTIONARY);
+      entry.SetKey("extensionId", extension_id->Clone());
+      entry.SetKey("script", script.Clone());
+      content_scripts.GetList().push_back(std::move(entry));
+    }
+  }
+  return mate::ConvertToV8(isolate, content_scripts);
+}
+
+// Compiles the content script |code| into a function that receives the
+// chrome API object. Content scripts are compiled again for every frame they
+// are injected into, so their code caches are kept for the process.
+v8::Local<v8::Value> CompileContentScript(const std::string& url,
+                                          const std::string& code,
+                                          mate::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  std::string cache_key =
+      base::StringPrintf("content-script:%s:%08x", url.c_str(),
+                         static_cast<uint32_t>(base::Hash(code)));
+  // The wrapper takes the first line, so the code starts at line 0.
+  v8::ScriptOrigin origin(mate::StringToV8(isolate, url),
+                          v8::Integer::New(isolate, -1));
+
+  // A compile or run error is left pending and thrown to the caller.
+  v8::Local<v8::Script> script;
+  v8::Local<v8::Value> function;
+  if (!CompileWithCodeCache(
+           context,
+           mate::StringToV8(isolate, "((chrome) => {\n" + code + "\n})"),
+           cache_key, &origin)
+           .ToLocal(&script) ||
+      !script->Run(context).ToLocal(&function))
+    return v8::Undefined(isolate);
+  return function;
+}
+
+v8::Local<v8::Value> GetWorkerStats(v8::Isolate* isolate) {
+  WebWorkerObserver::Stats stats = WebWorkerObserver::GetStats();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.SetHidden("simple", true);
+  dict.Set("created", stats.created);
+  dict.Set("active", stats.active);
+  dict.Set("totalCreationTime", stats.total_creation_time.InMillisecondsF());
+  dict.Set("maxCreationTime", stats.max_creation_time.InMillisecondsF());
+  return dict.GetHandle();
+}
+
 std::vector<std::string> ParseSchemesCLISwitch(base::CommandLine* command_line,
                                                const char* switch_name) {
   std::string custom_schemes = command_line->GetSwitchValueASCII(switch_name);
@@ -133,6 +236,10 @@ void RendererClientBase::AddRenderBindings(
   dict.SetMethod(
       "getRenderProcessPreferences",
       base::Bind(GetRenderProcessPreferences, preferences_manager_.get()));
+  dict.SetMethod("getContentScripts",
+                 base::Bind(GetContentScripts, preferences_manager_.get()));
+  dict.SetMethod("compileContentScript", &CompileContentScript);
+  dict.SetMethod("getWorkerStats", &GetWorkerStats);
 }
 
 void RendererClientBase::RenderThreadStarted() {
@@ -171,6 +278,13 @@ void RendererClientBase::RenderThreadStarted() {
 
   preferences_manager_.reset(new PreferencesManager);
 
+  if (command_line->HasSwitch(switches::kAsarExtractionCache))
+    asar::Archive::SetExtractionCacheDirectory(
+        command_line->GetSwitchValuePath(switches::kAsarExtractionCache));
+  InstallAsarIndexClient();
+  memory_stats_reporter_.reset(new MemoryStatsReporter);
+  user_style_sheets_.reset(new UserStyleSheets);
+
 #if defined(OS_WIN)
   // Set ApplicationUserModelID in renderer process.
   base::string16 app_id =
@@ -190,6 +304,7 @@ void RendererClientBase::RenderFrameCreated(
   new PepperHelper(render_frame);
 #endif
   new ContentSettingsObserver(render_frame);
+  user_style_sheets_->ObserveFrame(render_frame);
 #if BUILDFLAG(ENABLE_PRINTING)
   new printing::PrintRenderFrameHelper(
       render_frame, std::make_unique<atom::PrintRenderFrameHelperDelegate>());
@@ -20,7 +20,9 @@
 
 namespace atom {
 
+class MemoryStatsReporter;
 class PreferencesManager;
+class UserStyleSheets;
 
 class RendererClientBase : public content::ContentRendererClient {
  public:
@@ -60,6 +62,8 @@ class RendererClientBase : public content::ContentRendererClient {
 
  private:
   std::unique_ptr<PreferencesManager> preferences_manager_;
+  std::unique_ptr<MemoryStatsReporter> memory_stats_reporter_;
+  std::unique_ptr<UserStyleSheets> user_style_sheets_;
 #if defined(WIDEVINE_CDM_AVAILABLE)
   ChromeKeySystemsProvider key_systems_provider_;
 #endif
@@ -0,0 +1,82 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/renderer/user_style_sheets.h"
+
+#include "atom/common/api/api_messages.h"
+#include "content/public/renderer/render_frame.h"
+#include "content/public/renderer/render_frame_observer.h"
+#include "content/public/renderer/render_thread.h"
+#include "third_party/blink/public/web/web_document.h"
+#include "third_party/blink/public/web/web_local_frame.h"
+
+namespace atom {
+
+class UserStyleSheets::FrameObserver : public content::RenderFrameObserver {
+ public:
+  FrameObserver(content::RenderFrame* render_frame,
+                UserStyleSheets* style_sheets)
+      : content::RenderFrameObserver(render_frame),
+        style_sheets_(style_sheets) {}
+
+  // content::RenderFrameObserver:
+  void DidCreateDocumentElement() override {
+    style_sheets_->InsertInto(render_frame());
+  }
+  void OnDestruct() override { delete this; }
+
+ private:
+  UserStyleSheets* style_sheets_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameObserver);
+};
+
+UserStyleSheets::UserStyleSheets() {
+  content::RenderThread::Get()->AddObserver(this);
+}
+
+UserStyleSheets::~UserStyleSheets() {}
+
+void UserStyleSheets::ObserveFrame(content::RenderFrame* render_frame) {
+  new FrameObserver(render_frame, this);
+}
+
+bool UserStyleSheets::OnControlMessageReceived(const IPC::Message& message) {
+  bool handled = true;
+  IPC_BEGIN_MESSAGE_MAP(UserStyleSheets, message)
+    IPC_MESSAGE_HANDLER(AtomMsg_AddUserStyleSheet, OnAddUserStyleSheet)
+    IPC_MESSAGE_HANDLER(AtomMsg_RemoveUserStyleSheet, OnRemoveUserStyleSheet)
+    IPC_MESSAGE_UNHANDLED(handled = false)
+  IPC_END_MESSAGE_MAP()
+  return handled;
+}
+
+void UserStyleSheets::OnAddUserStyleSheet(
+    int id,
+    const base::ReadOnlySharedMemoryRegion& region,
+    bool main_frame_only) {
+  base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid()) {
+    LOG(WARNING) << "Ignoring invalid user stylesheet " << id;
+    return;
+  }
+  StyleSheet& style_sheet = style_sheets_[id];
+  style_sheet.css = blink::WebString::FromUTF8(
+      static_cast<const char*>(mapping.memory()), mapping.size());
+  style_sheet.main_frame_only = main_frame_only;
+}
+
+void UserStyleSheets::OnRemoveUserStyleSheet(int id) {
+  style_sheets_.erase(id);
+}
+
+void UserStyleSheets::InsertInto(content::RenderFrame* render_frame) {
+  blink::WebDocument document = render_frame->GetWebFrame()->GetDocument();
+  for (const auto& iter : style_sheets_) {
+    if (!iter.second.main_frame_only || render_frame->IsMainFrame())
+      document.InsertStyleSheet(iter.second.css);
+  }
+}
+
+}  // namespace atom
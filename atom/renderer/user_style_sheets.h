@@ -0,0 +1,56 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_RENDERER_USER_STYLE_SHEETS_H_
+#define ATOM_RENDERER_USER_STYLE_SHEETS_H_
+
+#include <map>
+
+#include "base/memory/read_only_shared_memory_region.h"
+#include "content/public/renderer/render_thread_observer.h"
+#include "third_party/blink/public/platform/web_string.h"
+
+namespace content {
+class RenderFrame;
+}
+
+namespace atom {
+
+// Keeps the stylesheets added with ses.addUserStyleSheet and inserts them
+// into each new document of the process.
+class UserStyleSheets : public content::RenderThreadObserver {
+ public:
+  UserStyleSheets();
+  ~UserStyleSheets() override;
+
+  // Starts inserting the stylesheets into the documents of |render_frame|.
+  void ObserveFrame(content::RenderFrame* render_frame);
+
+ private:
+  class FrameObserver;
+
+  struct StyleSheet {
+    // The text is converted once, every document shares the same string.
+    blink::WebString css;
+    bool main_frame_only = false;
+  };
+
+  // content::RenderThreadObserver:
+  bool OnControlMessageReceived(const IPC::Message& message) override;
+
+  void OnAddUserStyleSheet(int id,
+                           const base::ReadOnlySharedMemoryRegion& region,
+                           bool main_frame_only);
+  void OnRemoveUserStyleSheet(int id);
+
+  void InsertInto(content::RenderFrame* render_frame);
+
+  std::map<int, StyleSheet> style_sheets_;
+
+  DISALLOW_COPY_AND_ASSIGN(UserStyleSheets);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_RENDERER_USER_STYLE_SHEETS_H_
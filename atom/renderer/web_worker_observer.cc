@@ -4,12 +4,15 @@
 
 #include "atom/renderer/web_worker_observer.h"
 
+#include <algorithm>
+
 #include "atom/common/api/atom_bindings.h"
 #include "atom/common/api/event_emitter_caller.h"
-#include "atom/common/asar/asar_util.h"
 #include "atom/common/node_bindings.h"
 #include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/thread_local.h"
+#include "base/trace_event/trace_event.h"
 
 #include "atom/common/node_includes.h"
 
@@ -21,6 +24,13 @@ static base::LazyInstance<
     base::ThreadLocalPointer<WebWorkerObserver>>::DestructorAtExit lazy_tls =
     LAZY_INSTANCE_INITIALIZER;
 
+struct GlobalStats {
+  base::Lock lock;
+  WebWorkerObserver::Stats stats;
+};
+
+base::LazyInstance<GlobalStats>::Leaky g_stats = LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 // static
@@ -29,19 +39,33 @@ WebWorkerObserver* WebWorkerObserver::GetCurrent() {
   return self ? self : new WebWorkerObserver;
 }
 
+// static
+WebWorkerObserver::Stats WebWorkerObserver::GetStats() {
+  GlobalStats& global = g_stats.Get();
+  base::AutoLock auto_lock(global.lock);
+  return global.stats;
+}
+
 WebWorkerObserver::WebWorkerObserver()
     : node_bindings_(NodeBindings::Create(NodeBindings::WORKER)),
-      atom_bindings_(new AtomBindings(node_bindings_->uv_loop())) {
+      atom_bindings_(new AtomBindings(node_bindings_.get())) {
   lazy_tls.Pointer()->Set(this);
 }
 
 WebWorkerObserver::~WebWorkerObserver() {
   lazy_tls.Pointer()->Set(nullptr);
   node::FreeEnvironment(node_bindings_->uv_env());
-  asar::ClearArchives();
+
+  if (environment_created_) {
+    GlobalStats& global = g_stats.Get();
+    base::AutoLock auto_lock(global.lock);
+    --global.stats.active;
+  }
 }
 
 void WebWorkerObserver::ContextCreated(v8::Local<v8::Context> context) {
+  TRACE_EVENT0("electron", "WebWorkerObserver::ContextCreated");
+  base::TimeTicks start = base::TimeTicks::Now();
   v8::Context::Scope context_scope(context);
 
   // Start the embed thread.
@@ -61,6 +85,16 @@ void WebWorkerObserver::ContextCreated(v8::Local<v8::Context> context) {
 
   // Give the node loop a run to make sure everything is ready.
   node_bindings_->RunMessageLoop();
+
+  base::TimeDelta creation_time = base::TimeTicks::Now() - start;
+  environment_created_ = true;
+  GlobalStats& global = g_stats.Get();
+  base::AutoLock auto_lock(global.lock);
+  ++global.stats.created;
+  ++global.stats.active;
+  global.stats.total_creation_time += creation_time;
+  global.stats.max_creation_time =
+      std::max(global.stats.max_creation_time, creation_time);
 }
 
 void WebWorkerObserver::ContextWillDestroy(v8::Local<v8::Context> context) {
@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "v8/include/v8.h"
 
 namespace atom {
@@ -18,9 +19,21 @@ class NodeBindings;
 // Watches for WebWorker and insert node integration to it.
 class WebWorkerObserver {
  public:
+  // The Node environments of the workers of this process.
+  struct Stats {
+    int created = 0;
+    int active = 0;
+    // The time spent creating and bootstrapping the environments.
+    base::TimeDelta total_creation_time;
+    base::TimeDelta max_creation_time;
+  };
+
   // Returns the WebWorkerObserver for current worker thread.
   static WebWorkerObserver* GetCurrent();
 
+  // Can be called from any thread.
+  static Stats GetStats();
+
   void ContextCreated(v8::Local<v8::Context> context);
   void ContextWillDestroy(v8::Local<v8::Context> context);
 
@@ -30,6 +43,7 @@ class WebWorkerObserver {
 
   std::unique_ptr<NodeBindings> node_bindings_;
   std::unique_ptr<AtomBindings> atom_bindings_;
+  bool environment_created_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(WebWorkerObserver);
 };
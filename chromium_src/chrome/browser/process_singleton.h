@@ -9,6 +9,7 @@
 #include <windows.h>
 #endif  // defined(OS_WIN)
 
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -23,6 +24,7 @@
 
 #if defined(OS_POSIX) && !defined(OS_ANDROID)
 #include "base/files/scoped_temp_dir.h"
+#include "base/process/launch.h"
 #endif
 
 #if defined(OS_WIN)
@@ -90,6 +92,18 @@ class ProcessSingleton {
 
 #if defined(OS_POSIX) && !defined(OS_ANDROID)
   static void DisablePromptForTesting();
+
+  // Hands the lock and the socket over to a process launched with |options|,
+  // so it starts as the singleton instance while this one shuts down. Once
+  // the process is launched HandOver() points the lock at it, this instance
+  // then stops listening and leaves the files to the new process.
+  void PrepareHandOver(base::LaunchOptions* options);
+  void HandOver(base::ProcessId pid);
+
+  // Returns the singleton handed over by the instance that launched this one,
+  // or null when nothing was handed over.
+  static std::unique_ptr<ProcessSingleton> TakeOver(
+      const NotificationCallback& notification_callback);
 #endif
 #if defined(OS_WIN)
   // Called to query whether to kill a hung browser process that has visible
@@ -152,6 +166,10 @@ class ProcessSingleton {
   // Default function to kill a process, overridable by tests.
   void KillProcess(int pid);
 
+  // Creates the temporary directory of the socket and links the socket and
+  // the cookies into the profile. Returns the path to bind the socket to.
+  bool SetupSocketDir(base::FilePath* socket_target_path);
+
   // Allow overriding for tests.
   base::ProcessId current_pid_;
 
@@ -159,6 +177,9 @@ class ProcessSingleton {
   // Allows overriding for tests.
   base::Callback<void(int)> kill_callback_;
 
+  // The user data directory the singleton is named after.
+  base::FilePath user_data_dir_;
+
   // Path in file system to the socket.
   base::FilePath socket_path_;
 
@@ -175,8 +196,10 @@ class ProcessSingleton {
   // because it posts messages between threads.
   class LinuxWatcher;
   scoped_refptr<LinuxWatcher> watcher_;
-  int sock_;
+  int sock_ = -1;
   bool listen_on_ready_ = false;
+  // Whether the lock and the socket belong to a relaunched instance.
+  bool handed_over_ = false;
 #endif
 
   SEQUENCE_CHECKER(sequence_checker_);
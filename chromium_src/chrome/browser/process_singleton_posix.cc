@@ -36,6 +36,23 @@
 // process will be considered as hung for some reason. The second process then
 // retrieves the process id from the symbol link and kills it by sending
 // SIGKILL. Then the second process starts as normal.
+//
+// On Linux the temporary directory of the socket is created in the runtime
+// directory of the user ($XDG_RUNTIME_DIR) when there is one, as it is local,
+// private to the user and supports unix domain sockets. The lock, the socket
+// symlink and the cookie always stay in the profile, so instances with
+// different runtime directories still find each other. The lock can not move
+// to a local directory either: on a profile shared over NFS it is the only
+// thing that stops instances on two hosts from using the profile at once.
+//
+// The first process only sends the ACK once the message has been handled on
+// the UI thread, so the second process does not exit before a message that a
+// shutting down instance dropped could be reported to it.
+//
+// An instance that relaunches itself without waiting to exit hands the socket
+// and the lock over to the new instance: the listening socket is inherited as
+// kHandOverSocketFD and the lock is pointed at the new process, so the new
+// instance does not notify the old one while it shuts down.
 
 #include "chrome/browser/process_singleton.h"
 
@@ -52,6 +69,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 
 #include <stddef.h>
 
@@ -61,9 +79,11 @@
 #include "base/base_paths.h"
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/environment.h"
 #include "base/files/file_descriptor_watcher_posix.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
@@ -124,6 +144,16 @@ const base::FilePath::CharType kSingletonLockFilename[] =
 const base::FilePath::CharType kSingletonSocketFilename[] =
     FILE_PATH_LITERAL("SS");
 
+#if defined(OS_LINUX)
+const char kRuntimeDirEnvVar[] = "XDG_RUNTIME_DIR";
+#endif
+
+// Set for a relaunched instance to the pid of the instance that handed the
+// singleton over and the user data directory, separated by a colon.
+const char kHandOverEnvVar[] = "ELECTRON_PROCESS_SINGLETON_HAND_OVER";
+// The file descriptor the handed over socket shows up on.
+const int kHandOverSocketFD = STDERR_FILENO + 1;
+
 // Set the close-on-exec bit on a file descriptor.
 // Returns 0 on success, -1 on failure.
 int SetCloseOnExec(int fd) {
@@ -283,6 +313,28 @@ bool SymlinkPath(const base::FilePath& target, const base::FilePath& path) {
   return true;
 }
 
+// Returns what the lock symlink of process |pid| points to.
+base::FilePath GetLockTarget(base::ProcessId pid) {
+  return base::FilePath(base::StringPrintf(
+      "%s%c%u", net::GetHostName().c_str(), kLockDelimiter, pid));
+}
+
+// Points the lock symlink at |target|. A new symlink is renamed over the old
+// one, so the lock never goes missing while it changes hands.
+bool ReplaceLockPath(const base::FilePath& target, const base::FilePath& path) {
+  base::FilePath temp_path =
+      path.AddExtension(base::IntToString(base::GetCurrentProcId()));
+  UnlinkPath(temp_path);
+  if (!SymlinkPath(target, temp_path))
+    return false;
+  if (rename(temp_path.value().c_str(), path.value().c_str()) != 0) {
+    PLOG(ERROR) << "Failed to replace " << path.value();
+    UnlinkPath(temp_path);
+    return false;
+  }
+  return true;
+}
+
 // Extract the hostname and pid from the lock symlink.
 // Returns true if the lock existed.
 bool ParseLockPath(const base::FilePath& path,
@@ -318,6 +370,27 @@ bool DisplayProfileInUseError(const base::FilePath& lock_path,
   return true;
 }
 
+// Returns the runtime directory of the user, or an empty path when there is
+// no usable one.
+base::FilePath GetRuntimeDir() {
+#if defined(OS_LINUX)
+  std::unique_ptr<base::Environment> env(base::Environment::Create());
+  std::string runtime_dir;
+  if (!env->GetVar(kRuntimeDirEnvVar, &runtime_dir) || runtime_dir.empty())
+    return base::FilePath();
+
+  // The spec requires the directory to be owned by the user with mode 700,
+  // otherwise the socket could be reached by others.
+  struct stat info;
+  if (stat(runtime_dir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode) ||
+      info.st_uid != geteuid() || (info.st_mode & 077) != 0)
+    return base::FilePath();
+  return base::FilePath(runtime_dir);
+#else
+  return base::FilePath();
+#endif
+}
+
 bool IsChromeProcess(pid_t pid) {
   base::FilePath other_chrome_path(base::GetProcessExecutablePath(pid));
 
@@ -716,7 +789,8 @@ ProcessSingleton::ProcessSingleton(
     const base::FilePath& user_data_dir,
     const NotificationCallback& notification_callback)
     : notification_callback_(notification_callback),
-      current_pid_(base::GetCurrentProcId()) {
+      current_pid_(base::GetCurrentProcId()),
+      user_data_dir_(user_data_dir) {
   // The user_data_dir may have not been created yet.
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   base::CreateDirectoryAndGetError(user_data_dir, nullptr);
@@ -962,8 +1036,7 @@ bool ProcessSingleton::Create() {
 
   // The symlink lock is pointed to the hostname and process id, so other
   // processes can find it out.
-  base::FilePath symlink_content(base::StringPrintf(
-      "%s%c%u", net::GetHostName().c_str(), kLockDelimiter, current_pid_));
+  base::FilePath symlink_content = GetLockTarget(current_pid_);
 
   // Create symbol link before binding the socket, to ensure only one instance
   // can have the socket open.
@@ -985,6 +1058,33 @@ bool ProcessSingleton::Create() {
 #endif
   }
 
+  base::FilePath socket_target_path;
+  if (!SetupSocketDir(&socket_target_path))
+    return false;
+
+  SetupSocket(socket_target_path.value(), &sock, &addr);
+
+  if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+    PLOG(ERROR) << "Failed to bind() " << socket_target_path.value();
+    CloseSocket(sock);
+    return false;
+  }
+
+  if (listen(sock, 5) < 0)
+    NOTREACHED() << "listen failed: " << base::safe_strerror(errno);
+
+  sock_ = sock;
+
+  if (BrowserThread::IsThreadInitialized(BrowserThread::IO)) {
+    StartListeningOnSocket();
+  } else {
+    listen_on_ready_ = true;
+  }
+
+  return true;
+}
+
+bool ProcessSingleton::SetupSocketDir(base::FilePath* socket_target_path) {
   if (IsAppSandboxed()) {
     // For sandboxed applications, the tmp dir could be too long to fit
     // addr->sun_path, so we need to make it as short as possible.
@@ -1000,8 +1100,13 @@ bool ProcessSingleton::Create() {
   } else {
     // Create the socket file somewhere in /tmp which is usually mounted as a
     // normal filesystem. Some network filesystems (notably AFS) are screwy and
-    // do not support Unix domain sockets.
-    if (!socket_dir_.CreateUniqueTempDir()) {
+    // do not support Unix domain sockets. The runtime directory of the user is
+    // preferred, it is local and only the user can reach it.
+    base::FilePath runtime_dir = GetRuntimeDir();
+    bool created = runtime_dir.empty()
+                       ? socket_dir_.CreateUniqueTempDir()
+                       : socket_dir_.CreateUniqueTempDirUnderPath(runtime_dir);
+    if (!created) {
       LOG(ERROR) << "Failed to create socket directory.";
       return false;
     }
@@ -1014,14 +1119,13 @@ bool ProcessSingleton::Create() {
       << "Temp directory mode is not 700: " << std::oct << dir_mode;
 
   // Setup the socket symlink and the two cookies.
-  base::FilePath socket_target_path =
-      socket_dir_.GetPath().Append(kSingletonSocketFilename);
+  *socket_target_path = socket_dir_.GetPath().Append(kSingletonSocketFilename);
   base::FilePath cookie(GenerateCookie());
   base::FilePath remote_cookie_path =
       socket_dir_.GetPath().Append(kSingletonCookieFilename);
   UnlinkPath(socket_path_);
   UnlinkPath(cookie_path_);
-  if (!SymlinkPath(socket_target_path, socket_path_) ||
+  if (!SymlinkPath(*socket_target_path, socket_path_) ||
       !SymlinkPath(cookie, cookie_path_) ||
       !SymlinkPath(cookie, remote_cookie_path)) {
     // We've already locked things, so we can't have lost the startup race,
@@ -1032,32 +1136,97 @@ bool ProcessSingleton::Create() {
     return false;
   }
 
-  SetupSocket(socket_target_path.value(), &sock, &addr);
+  return true;
+}
 
-  if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
-    PLOG(ERROR) << "Failed to bind() " << socket_target_path.value();
-    CloseSocket(sock);
-    return false;
+void ProcessSingleton::Cleanup() {
+  if (handed_over_)
+    return;
+  UnlinkPath(socket_path_);
+  UnlinkPath(cookie_path_);
+  UnlinkPath(lock_path_);
+}
+
+void ProcessSingleton::PrepareHandOver(base::LaunchOptions* options) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (sock_ < 0)
+    return;
+  options->fds_to_remap.push_back(std::make_pair(sock_, kHandOverSocketFD));
+  options->environment[kHandOverEnvVar] = base::StringPrintf(
+      "%u:%s", current_pid_, user_data_dir_.value().c_str());
+}
+
+void ProcessSingleton::HandOver(base::ProcessId pid) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (sock_ < 0)
+    return;
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  // The new instance points the lock at itself as well, whichever comes
+  // first, the lock never names a process that gave it away.
+  ReplaceLockPath(GetLockTarget(pid), lock_path_);
+  handed_over_ = true;
+  listen_on_ready_ = false;
+  watcher_ = nullptr;
+  // The socket directory is deleted by the new instance when it exits.
+  ignore_result(socket_dir_.Take());
+}
+
+// static
+std::unique_ptr<ProcessSingleton> ProcessSingleton::TakeOver(
+    const NotificationCallback& notification_callback) {
+  std::unique_ptr<base::Environment> env(base::Environment::Create());
+  std::string value;
+  if (!env->GetVar(kHandOverEnvVar, &value))
+    return nullptr;
+  // The processes launched by this one do not inherit the singleton.
+  env->UnSetVar(kHandOverEnvVar);
+
+  struct stat info;
+  if (fstat(kHandOverSocketFD, &info) != 0 || !S_ISSOCK(info.st_mode)) {
+    LOG(ERROR) << "The process singleton socket was not handed over.";
+    return nullptr;
+  }
+  base::ScopedFD sock(kHandOverSocketFD);
+  SetCloseOnExec(sock.get());
+
+  std::string::size_type pos = value.find(':');
+  int parent_pid;
+  if (pos == std::string::npos ||
+      !base::StringToInt(value.substr(0, pos), &parent_pid)) {
+    LOG(ERROR) << "Invalid " << kHandOverEnvVar << ": " << value;
+    return nullptr;
   }
 
-  if (listen(sock, 5) < 0)
-    NOTREACHED() << "listen failed: " << base::safe_strerror(errno);
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  std::unique_ptr<ProcessSingleton> singleton(new ProcessSingleton(
+      base::FilePath(value.substr(pos + 1)), notification_callback));
 
-  sock_ = sock;
+  // The lock still names the instance that handed it over, unless that
+  // instance has already pointed it at this one.
+  std::string hostname;
+  int pid;
+  if (!ParseLockPath(singleton->lock_path_, &hostname, &pid) ||
+      hostname != net::GetHostName() ||
+      (pid != parent_pid && pid != static_cast<int>(singleton->current_pid_))) {
+    LOG(ERROR) << "The process singleton was taken by another process.";
+    return nullptr;
+  }
+  if (!ReplaceLockPath(GetLockTarget(singleton->current_pid_),
+                       singleton->lock_path_)) {
+    return nullptr;
+  }
+
+  base::FilePath socket_target = ReadLink(singleton->socket_path_);
+  if (!socket_target.empty())
+    ignore_result(singleton->socket_dir_.Set(socket_target.DirName()));
 
+  singleton->sock_ = sock.release();
   if (BrowserThread::IsThreadInitialized(BrowserThread::IO)) {
-    StartListeningOnSocket();
+    singleton->StartListeningOnSocket();
   } else {
-    listen_on_ready_ = true;
+    singleton->listen_on_ready_ = true;
   }
-
-  return true;
-}
-
-void ProcessSingleton::Cleanup() {
-  UnlinkPath(socket_path_);
-  UnlinkPath(cookie_path_);
-  UnlinkPath(lock_path_);
+  return singleton;
 }
 
 bool ProcessSingleton::IsSameChromeInstance(pid_t pid) {
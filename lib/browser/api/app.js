@@ -8,7 +8,7 @@ const { app, App } = bindings
 module.exports = app
 
 const electron = require('electron')
-const { deprecate, Menu } = electron
+const { deprecate } = electron
 const { EventEmitter } = require('events')
 
 let dockMenu = null
@@ -19,10 +19,10 @@ EventEmitter.call(app)
 
 Object.assign(app, {
   setApplicationMenu (menu) {
-    return Menu.setApplicationMenu(menu)
+    return electron.Menu.setApplicationMenu(menu)
   },
   getApplicationMenu () {
-    return Menu.getApplicationMenu()
+    return electron.Menu.getApplicationMenu()
   },
   commandLine: {
     appendSwitch (...args) {
@@ -52,6 +52,53 @@ app.getAppMetrics = () => {
   return metrics
 }
 
+app.getFileIcons = (paths, options, callback) => {
+  if (typeof options === 'function') {
+    callback = options
+    options = {}
+  }
+  if (!Array.isArray(paths)) {
+    throw new TypeError('First argument must be an array of paths')
+  }
+  if (typeof callback !== 'function') {
+    throw new TypeError('Missing required callback function')
+  }
+
+  // The files are resolved natively with a bounded number of loads, and the
+  // ones that share an icon are only loaded once.
+  const icons = new Array(paths.length).fill(null)
+  let remaining = paths.length
+  if (remaining === 0) {
+    process.nextTick(callback, icons)
+    return
+  }
+  paths.forEach((filePath, index) => {
+    app.getFileIcon(filePath, options, (error, icon) => {
+      if (!error) icons[index] = icon
+      if (--remaining === 0) callback(icons)
+    })
+  })
+}
+
+const nativeRequestIdleCallback = app.requestIdleCallback
+app.requestIdleCallback = (callback, options = {}) => {
+  if (typeof callback !== 'function') {
+    throw new TypeError('Missing required callback function')
+  }
+  const { timeout = 0 } = options
+  if (typeof timeout !== 'number' || timeout < 0) {
+    throw new TypeError('timeout must be a non-negative number')
+  }
+
+  return nativeRequestIdleCallback.call(app, (timeRemaining, didTimeout) => {
+    const deadline = Date.now() + timeRemaining
+    callback({
+      didTimeout,
+      timeRemaining: () => Math.max(deadline - Date.now(), 0)
+    })
+  }, timeout)
+}
+
 app.isPackaged = (() => {
   const execFile = path.basename(process.execPath).toLowerCase()
   if (process.platform === 'win32') {
@@ -2,9 +2,12 @@
 
 const EventEmitter = require('events').EventEmitter
 const { autoUpdater, AutoUpdater } = process.atomBinding('auto_updater')
+const { applyDelta } = require('@electron/internal/browser/api/auto-updater/delta-update')
 
 // AutoUpdater is an EventEmitter.
 Object.setPrototypeOf(AutoUpdater.prototype, EventEmitter.prototype)
 EventEmitter.call(autoUpdater)
 
+AutoUpdater.prototype.applyDelta = applyDelta
+
 module.exports = autoUpdater
@@ -3,6 +3,7 @@
 const { app } = require('electron')
 const { EventEmitter } = require('events')
 const squirrelUpdate = require('@electron/internal/browser/api/auto-updater/squirrel-update-win')
+const { applyDelta } = require('@electron/internal/browser/api/auto-updater/delta-update')
 
 class AutoUpdater extends EventEmitter {
   quitAndInstall () {
@@ -64,6 +65,10 @@ class AutoUpdater extends EventEmitter {
     })
   }
 
+  applyDelta (options) {
+    return applyDelta(options)
+  }
+
   // Private: Emit both error object and message, this is to keep compatibility
   // with Old APIs.
   emitError (message) {
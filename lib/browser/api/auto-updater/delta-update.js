@@ -0,0 +1,21 @@
+'use strict'
+
+const path = require('path')
+
+// The paths in a delta are relative to the directory of the installed app,
+// which is the app bundle on macOS.
+const getInstallPath = function () {
+  if (process.platform === 'darwin') {
+    return path.resolve(process.execPath, '..', '..', '..')
+  }
+  return path.dirname(process.execPath)
+}
+
+exports.applyDelta = function (options = {}) {
+  const { deltaPath, outputPath, basePath = getInstallPath() } = options
+  if (typeof deltaPath !== 'string' || typeof outputPath !== 'string') {
+    return Promise.reject(new TypeError('deltaPath and outputPath must be strings'))
+  }
+  const { applyDelta } = process.atomBinding('auto_updater')
+  return applyDelta(basePath, deltaPath, outputPath)
+}
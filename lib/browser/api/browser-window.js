@@ -4,6 +4,7 @@ const electron = require('electron')
 const { WebContentsView, TopLevelWindow } = electron
 const { BrowserWindow } = process.atomBinding('window')
 const ipcMain = require('@electron/internal/browser/ipc-main-internal')
+const windowRecycler = require('@electron/internal/browser/window-recycler')
 
 Object.setPrototypeOf(BrowserWindow.prototype, TopLevelWindow.prototype)
 
@@ -141,7 +142,9 @@ BrowserWindow.fromId = (id) => {
 }
 
 BrowserWindow.getAllWindows = () => {
-  return TopLevelWindow.getAllWindows().filter(isBrowserWindow)
+  return TopLevelWindow.getAllWindows().filter((win) => {
+    return isBrowserWindow(win) && !windowRecycler.isPooled(win)
+  })
 }
 
 BrowserWindow.getFocusedWindow = () => {
@@ -151,26 +154,48 @@ BrowserWindow.getFocusedWindow = () => {
   return null
 }
 
+// The contents know their owner window, so the windows are not searched.
 BrowserWindow.fromWebContents = (webContents) => {
-  for (const window of BrowserWindow.getAllWindows()) {
-    if (window.webContents.equal(webContents)) return window
-  }
+  const window = webContents.getOwnerBrowserWindow()
+  if (isBrowserWindow(window) && window.webContents.equal(webContents)) return window
 }
 
 BrowserWindow.fromBrowserView = (browserView) => {
-  for (const window of BrowserWindow.getAllWindows()) {
-    if (window.getBrowserView() === browserView) return window
-  }
+  const window = browserView.webContents.getOwnerBrowserWindow()
+  if (isBrowserWindow(window) && window.getBrowserView() === browserView) return window
 
   return null
 }
 
+// The windows are moved by the system in one go, the views are laid out
+// together after the current task.
+BrowserWindow.setBoundsForWindows = (entries) => {
+  if (!Array.isArray(entries)) {
+    throw new TypeError('Expected an array of entries')
+  }
+  const windowEntries = entries.filter((entry) => !entry.view).map(({ window, bounds }) => ({
+    window,
+    bounds: window ? { ...window.getBounds(), ...bounds } : bounds
+  }))
+  TopLevelWindow.setBoundsForWindows(windowEntries)
+  for (const { view, bounds } of entries) {
+    if (view) view.setBounds(bounds)
+  }
+}
+
 BrowserWindow.fromDevToolsWebContents = (webContents) => {
-  for (const window of BrowserWindow.getAllWindows()) {
+  const isDevToolsOf = (window) => {
     const { devToolsWebContents } = window
-    if (devToolsWebContents != null && devToolsWebContents.equal(webContents)) {
-      return window
-    }
+    return devToolsWebContents != null && devToolsWebContents.equal(webContents)
+  }
+
+  // Docked devtools are owned by their window, detached and external ones
+  // have no owner and are searched for.
+  const owner = webContents.getOwnerBrowserWindow()
+  if (isBrowserWindow(owner) && isDevToolsOf(owner)) return owner
+
+  for (const window of BrowserWindow.getAllWindows()) {
+    if (isDevToolsOf(window)) return window
   }
 }
 
@@ -226,4 +251,21 @@ Object.assign(BrowserWindow.prototype, {
   }
 })
 
-module.exports = BrowserWindow
+// Windows created with the recyclable option are kept when closed, and handed
+// out again when a window with the same options is constructed.
+const RecyclableBrowserWindow = function BrowserWindow (options) {
+  if (!new.target) return NativeBrowserWindow(options)
+  if (new.target === RecyclableBrowserWindow) {
+    const recycled = windowRecycler.take(options)
+    if (recycled) return recycled
+  }
+  const window = Reflect.construct(NativeBrowserWindow, [options], new.target)
+  windowRecycler.setup(window, options)
+  return window
+}
+
+const NativeBrowserWindow = BrowserWindow
+RecyclableBrowserWindow.prototype = NativeBrowserWindow.prototype
+Object.setPrototypeOf(RecyclableBrowserWindow, NativeBrowserWindow)
+
+module.exports = RecyclableBrowserWindow
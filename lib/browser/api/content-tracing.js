@@ -1,3 +1,38 @@
 'use strict'
 
-module.exports = process.atomBinding('content_tracing')
+const binding = process.atomBinding('content_tracing')
+
+// The options of the current recording, so it can be resumed after a
+// snapshot.
+let recordingOptions = null
+
+const contentTracing = Object.assign({}, binding)
+
+contentTracing.startRecording = function (options, callback) {
+  recordingOptions = options
+  return binding.startRecording(options, callback)
+}
+
+contentTracing.stopRecording = function (resultFilePath, callback) {
+  recordingOptions = null
+  return binding.stopRecording(resultFilePath, callback)
+}
+
+contentTracing.snapshotRecording = function (resultFilePath, callback) {
+  if (recordingOptions === null) {
+    throw new Error('Recording has not been started')
+  }
+  const options = recordingOptions
+  binding.stopRecording(resultFilePath, (path) => {
+    // A new recording may have been started in the meantime.
+    if (recordingOptions === options) {
+      binding.startRecording(options, () => {
+        if (callback) callback(path)
+      })
+    } else if (callback) {
+      callback(path)
+    }
+  })
+}
+
+module.exports = contentTracing
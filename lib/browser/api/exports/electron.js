@@ -10,6 +10,6 @@ common.defineProperties(exports)
 for (const module of moduleList) {
   Object.defineProperty(exports, module.name, {
     enumerable: !module.private,
-    get: common.memoizedGetter(() => require(`@electron/internal/browser/api/${module.file}.js`))
+    get: common.lazyRequire(module.name, `@electron/internal/browser/api/${module.file}.js`)
   })
 }
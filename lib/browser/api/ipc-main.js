@@ -1,10 +1,34 @@
 'use strict'
 
 const { EventEmitter } = require('events')
+const { trackChannels } = require('@electron/internal/browser/ipc-channel-tracker')
 
 const emitter = new EventEmitter()
 
 // Do not throw exception when channel name is "error".
 emitter.on('error', () => {})
 
+trackChannels(emitter, false)
+
+// The handlers of ipcRenderer.invoke, keyed by channel.
+const invokeHandlers = new Map()
+
+emitter.handle = function (channel, handler) {
+  if (typeof handler !== 'function') {
+    throw new TypeError('Handler must be a function')
+  }
+  if (invokeHandlers.has(channel)) {
+    throw new Error(`Attempted to register a second handler for '${channel}'`)
+  }
+  invokeHandlers.set(channel, handler)
+}
+
+emitter.removeHandler = function (channel) {
+  invokeHandlers.delete(channel)
+}
+
+emitter._getHandler = function (channel) {
+  return invokeHandlers.get(channel)
+}
+
 module.exports = emitter
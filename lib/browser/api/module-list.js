@@ -14,6 +14,7 @@ module.exports = [
   { name: 'globalShortcut', file: 'global-shortcut' },
   { name: 'ipcMain', file: 'ipc-main' },
   { name: 'inAppPurchase', file: 'in-app-purchase' },
+  { name: 'json', file: 'json' },
   { name: 'Menu', file: 'menu' },
   { name: 'MenuItem', file: 'menu-item' },
   { name: 'net', file: 'net' },
@@ -22,6 +23,7 @@ module.exports = [
   { name: 'powerMonitor', file: 'power-monitor' },
   { name: 'powerSaveBlocker', file: 'power-save-blocker' },
   { name: 'protocol', file: 'protocol' },
+  { name: 'RenderPool', file: 'render-pool' },
   { name: 'screen', file: 'screen' },
   { name: 'session', file: 'session' },
   { name: 'systemPreferences', file: 'system-preferences' },
@@ -45,3 +47,7 @@ if (features.isViewApiEnabled()) {
     { name: 'TextField', file: 'views/text-field' }
   )
 }
+
+if (features.isOffscreenRenderingEnabled()) {
+  module.exports.push({ name: 'OffscreenAtlas', file: 'offscreen-atlas' })
+}
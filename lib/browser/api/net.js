@@ -15,6 +15,7 @@ EventEmitter.call(net)
 Object.setPrototypeOf(URLRequest.prototype, EventEmitter.prototype)
 
 const kSupportedProtocols = new Set(['http:', 'https:'])
+const kRequestPriorities = ['throttled', 'idle', 'lowest', 'low', 'medium', 'highest']
 
 class IncomingMessage extends Readable {
   constructor (urlRequest) {
@@ -179,6 +180,27 @@ class ClientRequest extends EventEmitter {
         throw new TypeError('`partition` should be an a string.')
       }
     }
+    if (options.bufferSize != null) {
+      if (Number.isInteger(options.bufferSize) && options.bufferSize > 0) {
+        urlRequestOptions.bufferSize = options.bufferSize
+      } else {
+        throw new TypeError('`bufferSize` should be a positive integer.')
+      }
+    }
+    if (options.priority != null) {
+      if (kRequestPriorities.includes(options.priority)) {
+        urlRequestOptions.priority = options.priority
+      } else {
+        throw new TypeError(`\`priority\` should be one of ${kRequestPriorities.join(', ')}.`)
+      }
+    }
+    if (options.savePath != null) {
+      if (typeof options.savePath === 'string') {
+        urlRequestOptions.savePath = options.savePath
+      } else {
+        throw new TypeError('`savePath` should be a string.')
+      }
+    }
 
     const urlRequest = new URLRequest(urlRequestOptions)
 
@@ -349,6 +371,13 @@ class ClientRequest extends EventEmitter {
     this.urlRequest.followRedirect()
   }
 
+  setPriority (priority) {
+    if (!kRequestPriorities.includes(priority)) {
+      throw new TypeError(`\`priority\` should be one of ${kRequestPriorities.join(', ')}.`)
+    }
+    this.urlRequest.setPriority(priority)
+  }
+
   abort () {
     this.urlRequest.cancel()
   }
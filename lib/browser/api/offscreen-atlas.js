@@ -0,0 +1,8 @@
+'use strict'
+
+const { EventEmitter } = require('events')
+const { OffscreenAtlas } = process.atomBinding('offscreen_atlas')
+
+Object.setPrototypeOf(OffscreenAtlas.prototype, EventEmitter.prototype)
+
+module.exports = OffscreenAtlas
@@ -1,6 +1,7 @@
 'use strict'
 
 const { EventEmitter } = require('events')
+const { app } = require('electron')
 const { powerMonitor, PowerMonitor } = process.atomBinding('power_monitor')
 
 // PowerMonitor is an EventEmitter.
@@ -22,4 +23,82 @@ if (process.platform === 'linux') {
   })
 }
 
+// The power saving policy is applied to all WebContents while the system runs
+// on battery power, and the previous settings are restored on AC power.
+let powerSavingPolicy = null
+let powerSavingActive = false
+const savedStates = new WeakMap()
+
+const applyPowerSavingPolicy = (contents) => {
+  if (savedStates.has(contents)) return
+
+  const state = {}
+  const { offscreenFrameRate, backgroundThrottling } = powerSavingPolicy
+  if (typeof offscreenFrameRate === 'number' && contents.isOffscreen()) {
+    state.frameRate = contents.getFrameRate()
+    if (state.frameRate > offscreenFrameRate) {
+      contents.setFrameRate(offscreenFrameRate)
+    }
+  }
+  if (backgroundThrottling) {
+    state.backgroundThrottling = contents.getBackgroundThrottling()
+    contents.setBackgroundThrottling(true)
+  }
+  savedStates.set(contents, state)
+}
+
+const restorePowerSavingPolicy = (contents) => {
+  const state = savedStates.get(contents)
+  if (!state) return
+
+  savedStates.delete(contents)
+  if (state.frameRate !== undefined) {
+    contents.setFrameRate(state.frameRate)
+  }
+  if (state.backgroundThrottling !== undefined) {
+    contents.setBackgroundThrottling(state.backgroundThrottling)
+  }
+}
+
+const updatePowerSaving = () => {
+  const { webContents } = require('electron')
+  const allContents = webContents.getAllWebContents()
+  if (powerSavingActive) {
+    allContents.forEach(restorePowerSavingPolicy)
+  }
+  powerSavingActive = powerSavingPolicy !== null && powerMonitor.isOnBatteryPower()
+  if (powerSavingActive) {
+    allContents.forEach(applyPowerSavingPolicy)
+  }
+}
+
+powerMonitor.on('on-battery', updatePowerSaving)
+powerMonitor.on('on-ac', updatePowerSaving)
+
+app.on('web-contents-created', (event, contents) => {
+  if (powerSavingActive) applyPowerSavingPolicy(contents)
+})
+
+powerMonitor.setPowerSavingPolicy = function (policy) {
+  if (policy !== null && typeof policy !== 'object') {
+    throw new TypeError('Power saving policy must be an object or null')
+  }
+  const { offscreenFrameRate } = policy || {}
+  if (offscreenFrameRate !== undefined &&
+      !(typeof offscreenFrameRate === 'number' && offscreenFrameRate > 0)) {
+    throw new TypeError('offscreenFrameRate must be a positive number')
+  }
+
+  powerSavingPolicy = policy && Object.assign({}, policy)
+  updatePowerSaving()
+}
+
+powerMonitor.getPowerSavingPolicy = function () {
+  return powerSavingPolicy && Object.assign({}, powerSavingPolicy)
+}
+
+powerMonitor.isPowerSaving = function () {
+  return powerSavingActive
+}
+
 module.exports = powerMonitor
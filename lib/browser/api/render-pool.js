@@ -0,0 +1,197 @@
+'use strict'
+
+const { EventEmitter } = require('events')
+
+const kDefaultJobTimeout = 30 * 1000
+
+const formats = ['png', 'jpeg', 'pdf']
+
+// The pages are usually untrusted, the app has to opt in to give them more.
+const kDefaultWebPreferences = {
+  nodeIntegration: false,
+  contextIsolation: true,
+  sandbox: true
+}
+
+// Offscreen windows that are kept loaded between jobs. A window is recycled
+// by loading the next job into it, so its renderer process is reused as long
+// as the pages share a site, and it is only replaced when it crashed.
+class RenderPool extends EventEmitter {
+  constructor (options = {}) {
+    super()
+
+    const { size = 1, webPreferences = {} } = options
+    if (!Number.isInteger(size) || size < 1) {
+      throw new TypeError('size must be a positive integer')
+    }
+
+    this._webPreferences = Object.assign({}, kDefaultWebPreferences, webPreferences, { offscreen: true })
+    this._idle = []
+    // Maps the busy windows to the function that finishes their job.
+    this._busy = new Map()
+    this._queue = []
+    this._destroyed = false
+    this._completedJobs = 0
+
+    for (let i = 0; i < size; i++) {
+      this._idle.push(this._createWindow())
+    }
+  }
+
+  render (job) {
+    if (this._destroyed) {
+      return Promise.reject(new Error('The render pool has been destroyed'))
+    }
+    if (job == null || (typeof job.url !== 'string' && typeof job.html !== 'string')) {
+      return Promise.reject(new TypeError('A job needs a url or html string'))
+    }
+    const format = job.format || 'png'
+    if (!formats.includes(format)) {
+      return Promise.reject(new TypeError(`Unsupported format: ${format}`))
+    }
+
+    return new Promise((resolve, reject) => {
+      this._queue.push({
+        job: Object.assign({}, job, { format }),
+        resolve,
+        reject,
+        queuedAt: Date.now()
+      })
+      this._runQueue()
+    })
+  }
+
+  getStats () {
+    return {
+      size: this._idle.length + this._busy.size,
+      busy: this._busy.size,
+      queueLength: this._queue.length,
+      completedJobs: this._completedJobs
+    }
+  }
+
+  destroy () {
+    this._destroyed = true
+    const error = new Error('The render pool has been destroyed')
+    for (const entry of this._queue.splice(0)) entry.reject(error)
+    for (const window of this._idle.splice(0)) window.destroy()
+    for (const [window, finish] of this._busy) {
+      finish(error)
+      window.destroy()
+    }
+  }
+
+  _createWindow () {
+    const { BrowserWindow } = require('electron')
+    const window = new BrowserWindow({
+      show: false,
+      webPreferences: this._webPreferences
+    })
+    // A busy window is replaced when its job is released.
+    window.webContents.once('crashed', () => {
+      const index = this._idle.indexOf(window)
+      if (this._destroyed || index === -1) return
+      this._idle.splice(index, 1, this._createWindow())
+      window.destroy()
+    })
+    return window
+  }
+
+  _runQueue () {
+    while (this._idle.length > 0 && this._queue.length > 0) {
+      const window = this._idle.pop()
+      const entry = this._queue.shift()
+      this._runJob(window, entry)
+    }
+  }
+
+  _runJob (window, entry) {
+    const { job } = entry
+    const timing = { queued: Date.now() - entry.queuedAt }
+    const startedAt = Date.now()
+
+    const contents = window.webContents
+    const listeners = []
+    const listen = (event, listener) => {
+      contents.on(event, listener)
+      listeners.push([event, listener])
+    }
+
+    let finished = false
+    const finish = (error, data) => {
+      if (finished) return
+      finished = true
+      clearTimeout(timer)
+      for (const [event, listener] of listeners) {
+        contents.removeListener(event, listener)
+      }
+      timing.total = Date.now() - entry.queuedAt
+      this._release(window)
+      this._completedJobs++
+      this.emit('job-finished', { url: job.url, format: job.format, timing, error })
+      if (error) {
+        entry.reject(error)
+      } else {
+        entry.resolve({ data, timing })
+      }
+    }
+
+    this._busy.set(window, finish)
+
+    const timer = setTimeout(() => {
+      finish(new Error('The render job timed out'))
+    }, job.timeout || kDefaultJobTimeout)
+
+    if (job.width && job.height) {
+      window.setContentSize(job.width, job.height)
+    }
+
+    const url = typeof job.url === 'string'
+      ? job.url
+      : `data:text/html;charset=utf-8,${encodeURIComponent(job.html)}`
+
+    listen('did-fail-load', (event, errorCode, errorDescription, validatedURL, isMainFrame) => {
+      if (isMainFrame) finish(new Error(`Failed to load ${url}: ${errorDescription}`))
+    })
+    listen('crashed', () => finish(new Error('The renderer crashed')))
+
+    let loaded = false
+    listen('did-finish-load', () => {
+      if (loaded) return
+      loaded = true
+      timing.load = Date.now() - startedAt
+      const capturedAt = Date.now()
+      const done = (error, data) => {
+        timing.capture = Date.now() - capturedAt
+        finish(error, data)
+      }
+
+      if (job.format === 'pdf') {
+        contents.printToPDF(job.pdfOptions || {}, done)
+        return
+      }
+      // Wait for a frame of the loaded page.
+      listen('paint', (event, dirty, image) => {
+        done(null, job.format === 'jpeg' ? image.toJPEG(job.quality || 90) : image.toPNG())
+      })
+      contents.invalidate()
+    })
+
+    contents.loadURL(url)
+  }
+
+  _release (window) {
+    this._busy.delete(window)
+    if (this._destroyed) return
+
+    if (window.isDestroyed() || window.webContents.isCrashed()) {
+      if (!window.isDestroyed()) window.destroy()
+      this._idle.push(this._createWindow())
+    } else {
+      this._idle.push(window)
+    }
+    this._runQueue()
+  }
+}
+
+module.exports = RenderPool
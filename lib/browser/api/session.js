@@ -1,6 +1,8 @@
 'use strict'
 
 const { EventEmitter } = require('events')
+const fs = require('fs')
+const { Readable } = require('stream')
 const { app } = require('electron')
 const { fromPartition, Session, Cookies } = process.atomBinding('session')
 
@@ -22,3 +24,54 @@ Object.setPrototypeOf(Cookies.prototype, EventEmitter.prototype)
 Session.prototype._init = function () {
   app.emit('session-created', this)
 }
+
+const kDefaultBlobChunkSize = 1024 * 1024
+
+// Reads the blob one chunk at a time, and only when the consumer asks for
+// more, so large blobs are never held in memory at once.
+class BlobReadStream extends Readable {
+  constructor (session, identifier, chunkSize) {
+    super({ highWaterMark: chunkSize })
+    this._session = session
+    this._identifier = identifier
+    this._chunkSize = chunkSize
+    this._offset = 0
+  }
+
+  _read () {
+    this._session._readBlobData(this._identifier, this._offset, this._chunkSize, (chunk) => {
+      if (!chunk) {
+        this.emit('error', new Error(`Failed to read blob ${this._identifier}`))
+      } else if (chunk.length === 0) {
+        this.push(null)
+      } else {
+        this._offset += chunk.length
+        this.push(chunk)
+      }
+    })
+  }
+}
+
+Session.prototype.createBlobReadStream = function (identifier, options = {}) {
+  const { chunkSize = kDefaultBlobChunkSize } = options
+  if (!Number.isInteger(chunkSize) || chunkSize <= 0) {
+    throw new TypeError('`chunkSize` should be a positive integer.')
+  }
+  return new BlobReadStream(this, identifier, chunkSize)
+}
+
+Session.prototype.saveBlobData = function (identifier, filePath, callback) {
+  const stream = this.createBlobReadStream(identifier)
+  const file = fs.createWriteStream(filePath)
+  let done = false
+  const finish = (error) => {
+    if (done) return
+    done = true
+    if (error) file.destroy()
+    if (callback) callback(error || null)
+  }
+  stream.on('error', finish)
+  file.on('error', finish)
+  file.on('finish', () => finish())
+  stream.pipe(file)
+}
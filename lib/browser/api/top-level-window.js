@@ -3,6 +3,7 @@
 const electron = require('electron')
 const { EventEmitter } = require('events')
 const { TopLevelWindow } = process.atomBinding('top_level_window')
+const windowRecycler = require('@electron/internal/browser/window-recycler')
 
 Object.setPrototypeOf(TopLevelWindow.prototype, EventEmitter.prototype)
 
@@ -15,6 +16,8 @@ TopLevelWindow.prototype._init = function () {
     const menu = app.getApplicationMenu()
     if (menu) this.setMenu(menu)
   }
+
+  this.on('closed', () => windowRecycler.onWindowClosed(this))
 }
 
 TopLevelWindow.getFocusedWindow = () => {
@@ -4,11 +4,13 @@ const features = process.atomBinding('features')
 const { EventEmitter } = require('events')
 const electron = require('electron')
 const path = require('path')
+const { Readable } = require('stream')
 const url = require('url')
 const { app, ipcMain, session, NavigationController, deprecate } = electron
 
 const ipcMainInternal = require('@electron/internal/browser/ipc-main-internal')
 const errorUtils = require('@electron/internal/common/error-utils')
+const SharedRing = require('@electron/internal/common/shared-ring')
 
 // session is not used here, the purpose is to make sure session is initalized
 // before the webContents module.
@@ -70,7 +72,6 @@ const defaultPrintingSetting = {
   headerFooterEnabled: false,
   marginsType: 0,
   isFirstRequest: false,
-  requestID: getNextId(),
   previewUIID: 0,
   previewModifiable: true,
   printToPDF: true,
@@ -121,6 +122,43 @@ WebContents.prototype.sendToAll = function (channel, ...args) {
   return this._send(internal, sendToAll, channel, args)
 }
 
+WebContents.prototype.sendSerialized = function (channel, ...args) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument')
+  }
+
+  const internal = false
+  const sendToAll = false
+
+  return this._sendSerialized(internal, sendToAll, channel, args, [])
+}
+
+WebContents.prototype.postMessage = function (channel, message, transfer = []) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument')
+  }
+
+  const internal = false
+  const sendToAll = false
+
+  return this._sendSerialized(internal, sendToAll, channel, [message], transfer)
+}
+
+WebContents.prototype.createSharedRing = function (channel, size = 1024 * 1024) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument')
+  }
+  if (!Number.isInteger(size) || size <= 0) {
+    throw new Error('Must pass size as a positive integer')
+  }
+
+  const ringId = getNextId()
+  const buffer = this._createSharedRingBuffer(channel, ringId, SharedRing.HEADER_SIZE + size)
+  return new SharedRing(buffer, () => this._ringDoorbell(ringId), () => {
+    this._closeSharedRing(ringId)
+  })
+}
+
 WebContents.prototype._sendInternal = function (channel, ...args) {
   if (typeof channel !== 'string') {
     throw new Error('Missing required channel argument')
@@ -196,10 +234,64 @@ WebContents.prototype.executeJavaScript = function (code, hasUserGesture, callba
   }
 }
 
-WebContents.prototype.takeHeapSnapshot = function (filePath) {
+WebContents.prototype.executeJavaScriptInFrames = function (code, options = {}) {
+  const requestId = getNextId()
+
+  if (this.getURL() && !this.isLoadingMainFrame()) {
+    return asyncWebFrameMethods.call(this, requestId, 'executeJavaScriptInFrames', null, code, options)
+  } else {
+    return new Promise((resolve, reject) => {
+      this.once('did-stop-loading', () => {
+        asyncWebFrameMethods.call(this, requestId, 'executeJavaScriptInFrames', null, code, options).then(resolve).catch(reject)
+      })
+    })
+  }
+}
+
+// The encoder does not wait for the consumer of the stream, the chunks are
+// buffered in the stream while it is paused.
+WebContents.prototype.beginRecording = function (options = {}) {
+  this.endRecording()
+  const stream = new Readable({ read () {} })
+  const onChunk = (data) => {
+    stream.push(data)
+  }
+  const onError = (message) => {
+    this._endRecording()
+    this._recordingStream = null
+    stream.emit('error', new Error(message))
+  }
+  this._beginRecording(options, onChunk, onError)
+  this._recordingStream = stream
+  return stream
+}
+
+WebContents.prototype.endRecording = function () {
+  this._endRecording()
+  if (this._recordingStream) {
+    this._recordingStream.push(null)
+    this._recordingStream = null
+  }
+}
+
+WebContents.prototype.capturePageRegions = function (rects, options = {}) {
+  return new Promise((resolve) => {
+    this._capturePageRegions(rects, options, resolve)
+  })
+}
+
+WebContents.prototype.takeHeapSnapshot = function (filePath, options = {}) {
   return new Promise((resolve, reject) => {
     const channel = `ELECTRON_TAKE_HEAP_SNAPSHOT_RESULT_${getNextId()}`
+    const progressChannel = `${channel}_PROGRESS`
+    const onProgress = (event, phase, done, total) => {
+      options.onProgress({ phase, done, total })
+    }
+    if (typeof options.onProgress === 'function') {
+      ipcMain.on(progressChannel, onProgress)
+    }
     ipcMain.once(channel, (event, success) => {
+      ipcMain.removeListener(progressChannel, onProgress)
       if (success) {
         resolve()
       } else {
@@ -212,9 +304,53 @@ WebContents.prototype.takeHeapSnapshot = function (filePath) {
   })
 }
 
+WebContents.prototype.startHeapSampling = function (options = {}) {
+  const { samplingInterval = 32768, stackDepth = 16 } = options
+  return this._startHeapSampling(samplingInterval, stackDepth)
+}
+
+WebContents.prototype.stopHeapSampling = function (filePath) {
+  return new Promise((resolve, reject) => {
+    const channel = `ELECTRON_STOP_HEAP_SAMPLING_RESULT_${getNextId()}`
+    ipcMain.once(channel, (event, success) => {
+      if (success) {
+        resolve()
+      } else {
+        reject(new Error('stopHeapSampling failed'))
+      }
+    })
+    if (!this._stopHeapSampling(filePath, channel)) {
+      ipcMain.emit(channel, false)
+    }
+  })
+}
+
+WebContents.prototype.purgeMemory = function (options = {}) {
+  const { level = 'critical' } = options
+  if (level !== 'moderate' && level !== 'critical') {
+    return Promise.reject(new Error(`Invalid level: ${level}`))
+  }
+  return new Promise((resolve, reject) => {
+    const channel = `ELECTRON_PURGE_MEMORY_RESULT_${getNextId()}`
+    ipcMain.once(channel, (event, before, after) => {
+      if (before) {
+        resolve({ before, after })
+      } else {
+        reject(new Error('purgeMemory failed'))
+      }
+    })
+    if (!this._purgeMemory(level === 'critical', channel)) {
+      ipcMain.emit(channel)
+    }
+  })
+}
+
 // Translate the options of printToPDF.
 WebContents.prototype.printToPDF = function (options, callback) {
-  const printingSetting = Object.assign({}, defaultPrintingSetting)
+  // Each job has its own ID, so several of them can run at the same time.
+  const printingSetting = Object.assign({}, defaultPrintingSetting, {
+    requestID: getNextId()
+  })
   if (options.landscape) {
     printingSetting.landscape = options.landscape
   }
@@ -254,18 +390,61 @@ WebContents.prototype.printToPDF = function (options, callback) {
   // Chromium expects this in a 0-100 range number, not as float
   printingSetting.scaleFactor *= 100
   if (features.isPrintingEnabled()) {
-    this._printToPDF(printingSetting, callback)
+    this._printToPDF(printingSetting, options.path || '', callback)
   } else {
     console.error('Error: Printing feature is disabled.')
   }
 }
 
-WebContents.prototype.print = function (...args) {
-  if (features.isPrintingEnabled()) {
-    this._print(args)
-  } else {
+// The print jobs of each WebContents. A job only starts once the previous one
+// has finished spooling, since starting a job cancels the one that is still
+// spooling.
+const printQueues = new WeakMap()
+
+const startNextPrintJob = function (contents) {
+  const queue = printQueues.get(contents)
+  if (queue.length === 0) {
+    printQueues.delete(contents)
+    return
+  }
+  const { options, callback } = queue[0]
+  let finished = false
+  const done = (success) => {
+    if (finished) return
+    finished = true
+    contents.removeListener('destroyed', fail)
+    contents.removeListener('crashed', fail)
+    queue.shift()
+    if (typeof callback === 'function') callback(success)
+    startNextPrintJob(contents)
+  }
+  const fail = () => done(false)
+
+  if (contents.isDestroyed()) return fail()
+  // The job never reports back when its renderer is gone. A slow job is
+  // waited for, the printing code reports the errors of the printer.
+  contents.once('destroyed', fail)
+  contents.once('crashed', fail)
+  contents._print(options, done)
+}
+
+WebContents.prototype.print = function (options = {}, callback) {
+  if (!features.isPrintingEnabled()) {
     console.error('Error: Printing feature is disabled.')
+    return
+  }
+  if (typeof options === 'function') {
+    callback = options
+    options = {}
   }
+  if (typeof options !== 'object' || options === null) {
+    throw new TypeError('Invalid print settings specified')
+  }
+
+  if (!printQueues.has(this)) printQueues.set(this, [])
+  const queue = printQueues.get(this)
+  queue.push({ options, callback })
+  if (queue.length === 1) startNextPrintJob(this)
 }
 
 WebContents.prototype.getPrinters = function () {
@@ -325,6 +504,24 @@ WebContents.prototype._init = function () {
   this.on('ipc-message', function (event, [channel, ...args]) {
     ipcMain.emit(channel, event, ...args)
   })
+  this.on('ipc-message-batch', function (event, batches) {
+    for (const [channel, messages] of batches) {
+      ipcMain.emit(channel, event, messages)
+    }
+  })
+  this.on('-ipc-invoke', function (event, invokeId, channel, args) {
+    const reply = (success, result) => this._replyToInvoke(invokeId, success, [result])
+    const handler = ipcMain._getHandler(channel)
+    if (!handler) {
+      reply(false, `No handler registered for '${channel}'`)
+      return
+    }
+    Promise.resolve().then(() => handler(event, ...args)).then(result => {
+      reply(true, result)
+    }, error => {
+      reply(false, error instanceof Error ? error.message : String(error))
+    })
+  })
   this.on('ipc-message-sync', function (event, [channel, ...args]) {
     Object.defineProperty(event, 'returnValue', {
       set: function (value) {
@@ -348,6 +545,14 @@ WebContents.prototype._init = function () {
     ipcMainInternal.emit(channel, event, ...args)
   })
 
+  // Messages that ipcMain does not listen to are dropped natively, unless the
+  // app listens to them on the webContents itself.
+  this.on('newListener', function (name) {
+    if (name === 'ipc-message' || name === 'ipc-internal-message') {
+      this._routeAllIPCMessages()
+    }
+  })
+
   // Handle context menu action request from pepper plugin.
   this.on('pepper-context-menu', function (event, params, callback) {
     // Access Menu via electron.Menu to prevent circular require.
@@ -408,5 +613,23 @@ module.exports = {
 
   getAllWebContents () {
     return binding.getAllWebContents()
+  },
+
+  // The regions of each contents are captured in one batch.
+  capturePages (targets, options = {}) {
+    const batches = new Map()
+    const captures = targets.map(({ webContents, rect }) => {
+      if (!batches.has(webContents)) batches.set(webContents, [])
+      const rects = batches.get(webContents)
+      rects.push(rect || { x: 0, y: 0, width: 0, height: 0 })
+      return { rects, index: rects.length - 1 }
+    })
+    const results = new Map()
+    for (const [contents, rects] of batches) {
+      results.set(rects, contents.capturePageRegions(rects, options))
+    }
+    return Promise.all(captures.map(({ rects, index }) => {
+      return results.get(rects).then((images) => images[index])
+    }))
   }
 }
@@ -10,15 +10,18 @@ let requestsQueue = []
 
 const electronSources = 'ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES'
 const capturerResult = (id) => `ELECTRON_RENDERER_DESKTOP_CAPTURER_RESULT_${id}`
+const capturerThumbnail = (id) => `ELECTRON_RENDERER_DESKTOP_CAPTURER_THUMBNAIL_${id}`
 
-ipcMain.on(electronSources, (event, captureWindow, captureScreen, thumbnailSize, id) => {
+ipcMain.on(electronSources, (event, captureWindow, captureScreen, thumbnailSize, thumbnailFormat, streamThumbnails, id) => {
   const request = {
     id,
     options: {
       captureWindow,
       captureScreen,
-      thumbnailSize
+      thumbnailSize,
+      thumbnailFormat
     },
+    streamThumbnails,
     webContents: event.sender
   }
   requestsQueue.push(request)
@@ -33,20 +36,38 @@ ipcMain.on(electronSources, (event, captureWindow, captureScreen, thumbnailSize,
   })
 })
 
-desktopCapturer.emit = (event, name, sources) => {
+// PNG keeps the thumbnails lossless, JPEG is far smaller for large sizes.
+const encodeThumbnail = (thumbnail, format) => {
+  if (thumbnail.isEmpty()) return null
+  return format === 'jpeg' ? thumbnail.toJPEG(90) : thumbnail.toPNG()
+}
+
+const serializeSource = (source, format) => {
+  return {
+    id: source.id,
+    name: source.name,
+    thumbnail: encodeThumbnail(source.thumbnail, format),
+    display_id: source.display_id
+  }
+}
+
+const handleThumbnail = (source) => {
+  // Only the request that is being handled receives the thumbnails as they
+  // are captured, identical requests that are queued get the final result.
+  const request = requestsQueue[0]
+  if (!request || !request.streamThumbnails || !request.webContents) return
+  const result = serializeSource(source, request.options.thumbnailFormat)
+  request.webContents._sendInternal(capturerThumbnail(request.id), result)
+}
+
+const handleFinished = (sources) => {
   // Receiving sources result from main process, now send them back to renderer.
   const handledRequest = requestsQueue.shift()
   const handledWebContents = handledRequest.webContents
   const unhandledRequestsQueue = []
 
-  const result = sources.map(source => {
-    return {
-      id: source.id,
-      name: source.name,
-      thumbnail: source.thumbnail.toDataURL(),
-      display_id: source.display_id
-    }
-  })
+  const { thumbnailFormat } = handledRequest.options
+  const result = sources.map(source => serializeSource(source, thumbnailFormat))
 
   if (handledWebContents) {
     handledWebContents._sendInternal(capturerResult(handledRequest.id), result)
@@ -71,3 +92,11 @@ desktopCapturer.emit = (event, name, sources) => {
     return desktopCapturer.startHandling(captureWindow, captureScreen, thumbnailSize)
   }
 }
+
+desktopCapturer.emit = (event, name, ...args) => {
+  if (name === 'thumbnail') {
+    handleThumbnail(...args)
+  } else if (name === 'finished') {
+    handleFinished(...args)
+  }
+}
@@ -1,6 +1,6 @@
 'use strict'
 
-const { webContents } = require('electron')
+const { app, webContents } = require('electron')
 const ipcMain = require('@electron/internal/browser/ipc-main-internal')
 const parseFeaturesString = require('@electron/internal/common/parse-features-string')
 
@@ -47,6 +47,39 @@ const supportedWebViewEvents = [
 let nextGuestInstanceId = 0
 const guestInstances = {}
 const embedderElementsMap = {}
+// The ids of the guests of each embedder, so the events of an embedder do not
+// visit the guests of all embedders.
+const embedderGuestsMap = new Map()
+
+const setGuestEmbedder = function (guestInstanceId, embedder) {
+  const guestInstance = guestInstances[guestInstanceId]
+  if (guestInstance.embedder) {
+    removeGuestFromEmbedder(guestInstanceId, guestInstance.embedder)
+  }
+  guestInstance.embedder = embedder
+  if (!embedderGuestsMap.has(embedder)) embedderGuestsMap.set(embedder, new Set())
+  embedderGuestsMap.get(embedder).add(guestInstanceId)
+}
+
+const removeGuestFromEmbedder = function (guestInstanceId, embedder) {
+  const guests = embedderGuestsMap.get(embedder)
+  if (!guests) return
+  guests.delete(guestInstanceId)
+  if (guests.size === 0) embedderGuestsMap.delete(embedder)
+}
+
+const getEmbedderGuestIds = function (embedder) {
+  return Array.from(embedderGuestsMap.get(embedder) || [])
+}
+
+// Guests that are created ahead of their <webview> for embedders with the
+// webviewPoolSize web preference, keyed by embedder id and partition.
+const guestPools = {}
+const pendingPoolRefills = new Set()
+
+// Refilling the pool waits a bit, so a page that creates several webviews at
+// once does not create the next guests in between.
+const kPoolRefillDelay = 1000
 
 // Generate guestInstanceId.
 const getNextGuestInstanceId = function () {
@@ -67,8 +100,9 @@ const createGuest = function (embedder, params) {
   })
   guestInstances[guestInstanceId] = {
     guest: guest,
-    embedder: embedder
+    embedder: null
   }
+  setGuestEmbedder(guestInstanceId, embedder)
 
   // Clear the guest from map when it is destroyed.
   //
@@ -161,6 +195,59 @@ const createGuest = function (embedder, params) {
   return guestInstanceId
 }
 
+const getPoolSize = function (embedder) {
+  const webPreferences = embedder.getLastWebPreferences()
+  const size = webPreferences ? webPreferences.webviewPoolSize : 0
+  return Number.isInteger(size) && size > 0 ? size : 0
+}
+
+const fillGuestPool = function (embedder, partition) {
+  if (embedder.isDestroyed()) return
+  const size = getPoolSize(embedder)
+  if (size === 0) return
+
+  watchEmbedder(embedder)
+  const key = `${embedder.id}-${partition}`
+  const pool = guestPools[key] || (guestPools[key] = [])
+  while (pool.length < size) {
+    pool.push(createGuest(embedder, { partition }))
+  }
+}
+
+const scheduleGuestPoolRefill = function (embedder, partition) {
+  const key = `${embedder.id}-${partition}`
+  if (pendingPoolRefills.has(key)) return
+  pendingPoolRefills.add(key)
+  setTimeout(() => {
+    pendingPoolRefills.delete(key)
+    fillGuestPool(embedder, partition)
+  }, kPoolRefillDelay)
+}
+
+// A pooled guest is identical to a new one, it has not been attached or
+// loaded anything yet.
+const takePooledGuest = function (embedder, partition) {
+  const pool = guestPools[`${embedder.id}-${partition}`]
+  if (!pool) return null
+  scheduleGuestPoolRefill(embedder, partition)
+  while (pool.length > 0) {
+    const guestInstanceId = pool.shift()
+    if (guestInstanceId in guestInstances) return guestInstanceId
+  }
+  return null
+}
+
+const destroyGuestPools = function (embedder) {
+  for (const key of Object.keys(guestPools)) {
+    if (!key.startsWith(`${embedder.id}-`)) continue
+    for (const guestInstanceId of guestPools[key]) {
+      const guestInstance = guestInstances[guestInstanceId]
+      if (guestInstance) guestInstance.guest.destroy()
+    }
+    delete guestPools[key]
+  }
+}
+
 // Attach the guest to an element of embedder.
 const attachGuest = function (event, embedderFrameId, elementInstanceId, guestInstanceId, params) {
   const embedder = event.sender
@@ -259,7 +346,7 @@ const attachGuest = function (event, embedderFrameId, elementInstanceId, guestIn
   embedderElementsMap[key] = guestInstanceId
 
   guest.setEmbedder(embedder)
-  guestInstance.embedder = embedder
+  setGuestEmbedder(guestInstanceId, embedder)
   guestInstance.elementInstanceId = elementInstanceId
 
   watchEmbedder(embedder)
@@ -277,6 +364,7 @@ const detachGuest = function (embedder, guestInstanceId) {
 
   webViewManager.removeGuest(embedder, guestInstanceId)
   delete guestInstances[guestInstanceId]
+  removeGuestFromEmbedder(guestInstanceId, embedder)
 
   const key = `${embedder.id}-${guestInstance.elementInstanceId}`
   delete embedderElementsMap[key]
@@ -293,25 +381,22 @@ const watchEmbedder = function (embedder) {
 
   // Forward embedder window visiblity change events to guest
   const onVisibilityChange = function (visibilityState) {
-    for (const guestInstanceId in guestInstances) {
+    for (const guestInstanceId of getEmbedderGuestIds(embedder)) {
       const guestInstance = guestInstances[guestInstanceId]
       guestInstance.visibilityState = visibilityState
-      if (guestInstance.embedder === embedder) {
-        guestInstance.guest._sendInternal('ELECTRON_GUEST_INSTANCE_VISIBILITY_CHANGE', visibilityState)
-      }
+      guestInstance.guest._sendInternal('ELECTRON_GUEST_INSTANCE_VISIBILITY_CHANGE', visibilityState)
     }
   }
   embedder.on('-window-visibility-change', onVisibilityChange)
 
   embedder.once('will-destroy', () => {
+    // The pooled guests are destroyed while they are still known.
+    destroyGuestPools(embedder)
     // Usually the guestInstances is cleared when guest is destroyed, but it
     // may happen that the embedder gets manually destroyed earlier than guest,
     // and the embedder will be invalid in the usual code path.
-    for (const guestInstanceId in guestInstances) {
-      const guestInstance = guestInstances[guestInstanceId]
-      if (guestInstance.embedder === embedder) {
-        detachGuest(embedder, parseInt(guestInstanceId))
-      }
+    for (const guestInstanceId of getEmbedderGuestIds(embedder)) {
+      detachGuest(embedder, guestInstanceId)
     }
     // Clear the listeners.
     embedder.removeListener('-window-visibility-change', onVisibilityChange)
@@ -327,6 +412,16 @@ ipcMain.on('ELECTRON_GUEST_VIEW_MANAGER_CREATE_GUEST_SYNC', function (event, par
   event.returnValue = createGuest(event.sender, params)
 })
 
+// Creates the guest and attaches it in one message, which saves the renderer
+// a round trip for each <webview>.
+ipcMain.on('ELECTRON_GUEST_VIEW_MANAGER_CREATE_AND_ATTACH_GUEST', function (event, embedderFrameId, elementInstanceId, params, requestId) {
+  const embedder = event.sender
+  const partition = params.partition || ''
+  const guestInstanceId = takePooledGuest(embedder, partition) || createGuest(embedder, params)
+  attachGuest(event, embedderFrameId, elementInstanceId, guestInstanceId, params)
+  embedder._sendInternal(`ELECTRON_RESPONSE_${requestId}`, guestInstanceId)
+})
+
 ipcMain.on('ELECTRON_GUEST_VIEW_MANAGER_DESTROY_GUEST', function (event, guestInstanceId) {
   const guest = getGuest(guestInstanceId)
   if (guest) {
@@ -342,6 +437,12 @@ ipcMain.on('ELECTRON_GUEST_VIEW_MANAGER_FOCUS_CHANGE', function (event, focus, g
   event.sender.emit('focus-change', {}, focus, guestInstanceId)
 })
 
+app.on('web-contents-created', function (event, contents) {
+  if (getPoolSize(contents) > 0) {
+    setImmediate(() => fillGuestPool(contents, ''))
+  }
+})
+
 // Returns WebContents from its guest id.
 const getGuest = function (guestInstanceId) {
   const guestInstance = guestInstances[guestInstanceId]
@@ -326,6 +326,36 @@ ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_POSTMESSAGE', function (event,
   }
 })
 
+// Asked once per window pair whether postMessage can use a message port, which
+// needs window-setup.js to run in the main world of the other window.
+// Ports are only available outside of isolated and sandboxed contexts.
+const canUsePort = function (contents) {
+  const { contextIsolation, sandbox } = contents.getLastWebPreferences()
+  return !contextIsolation && !sandbox
+}
+
+// Returns "open" when the sender opens the port to the guest, "accept" when it
+// waits for the guest to open it, and "relay" when messages go through here.
+ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_GET_PORT_ROLE', function (event, guestId) {
+  const guestContents = webContents.fromId(guestId)
+  if (guestContents == null || !canUsePort(event.sender) || !canUsePort(guestContents)) {
+    event.returnValue = 'relay'
+  } else {
+    event.returnValue = event.sender.id < guestId ? 'open' : 'accept'
+  }
+})
+
+ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_REQUEST_PORT', function (event, guestId) {
+  const guestContents = webContents.fromId(guestId)
+  if (guestContents == null || event.sender.id < guestId || !canUsePort(guestContents)) {
+    event.returnValue = false
+    return
+  }
+
+  guestContents._sendInternal('ELECTRON_GUEST_WINDOW_PORT_REQUEST', event.sender.id)
+  event.returnValue = true
+})
+
 ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WEB_CONTENTS_METHOD', function (event, guestId, method, ...args) {
   const guestContents = webContents.fromId(guestId)
   if (guestContents == null) return
@@ -11,12 +11,18 @@ const v8 = require('v8')
 // we need to restore it here.
 process.argv.splice(1, 1)
 
+// Compile the rest of Electron's modules with their code cache.
+require('../common/code-cache').install()
+
 // Clear search paths.
 require('../common/reset-search-paths')
 
 // Import common settings.
 require('@electron/internal/common/init')
 
+// Give the worker threads of Node asar support.
+require('@electron/internal/browser/worker-threads').install()
+
 const globalPaths = Module.globalPaths
 
 // Expose public APIs.
@@ -149,6 +155,26 @@ app.setPath('userData', path.join(app.getPath('appData'), app.getName()))
 app.setPath('userCache', path.join(app.getPath('cache'), app.getName()))
 app.setAppPath(packagePath)
 
+// Read ahead what the last launch read from asar archives while the main
+// script loads. The default userData path is used, so the manifest is found
+// again whatever path the app picks later.
+process.atomBinding('asar').prefetchRecordedReads(path.join(app.getPath('userData'), 'Asar Readahead'))
+
+// Cache the compiled scripts and the module resolutions of the app's asar
+// archives.
+const getAsarCacheDirectory = () => {
+  return path.join(app.getPath('userData'), 'Asar Code Cache')
+}
+const codeCache = require('@electron/internal/common/code-cache')
+codeCache.enableAsarCache(getAsarCacheDirectory)
+require('@electron/internal/common/resolve-cache').enable(getAsarCacheDirectory)
+
+// Prune the cache once startup is over, it is only read by the app.
+const pruneTimer = setTimeout(() => {
+  codeCache.pruneAsarCache(getAsarCacheDirectory())
+}, 60 * 1000)
+pruneTimer.unref()
+
 // Load the chrome extension support.
 require('@electron/internal/browser/chrome-extension')
 
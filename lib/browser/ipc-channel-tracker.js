@@ -0,0 +1,34 @@
+'use strict'
+
+const binding = process.atomBinding('web_contents')
+
+// Keeps the native side informed of the channels |emitter| listens to, so
+// messages sent to other channels are dropped before their arguments are
+// converted.
+exports.trackChannels = function (emitter, internal) {
+  const update = (channel) => {
+    if (typeof channel === 'string') {
+      const listened = emitter.listenerCount(channel) > 0
+      binding._setIPCChannelListened(internal, channel, listened)
+    }
+  }
+
+  // once() and prependOnceListener() go through on() and prependListener().
+  for (const name of ['addListener', 'on', 'prependListener', 'removeListener', 'off']) {
+    const method = emitter[name]
+    emitter[name] = function (channel, ...args) {
+      const result = method.call(this, channel, ...args)
+      update(channel)
+      return result
+    }
+  }
+  const { removeAllListeners } = emitter
+  emitter.removeAllListeners = function (...args) {
+    const channels = args.length === 0 ? this.eventNames() : args
+    const result = removeAllListeners.apply(this, args)
+    channels.forEach(update)
+    return result
+  }
+
+  emitter.eventNames().forEach(update)
+}
@@ -1,10 +1,13 @@
 'use strict'
 
 const { EventEmitter } = require('events')
+const { trackChannels } = require('@electron/internal/browser/ipc-channel-tracker')
 
 const emitter = new EventEmitter()
 
 // Do not throw exception when channel name is "error".
 emitter.on('error', () => {})
 
+trackChannels(emitter, true)
+
 module.exports = emitter
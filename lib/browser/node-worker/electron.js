@@ -0,0 +1,9 @@
+'use strict'
+
+const common = require('@electron/internal/common/api/exports/electron')
+
+// The modules of Electron that can be used in worker threads.
+Object.defineProperty(exports, 'nativeImage', {
+  enumerable: true,
+  get: common.lazyRequire('nativeImage', '@electron/internal/common/api/native-image')
+})
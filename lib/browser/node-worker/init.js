@@ -0,0 +1,32 @@
+'use strict'
+
+// Sets up a worker thread of Node in the main process, the bindings of the
+// browser's APIs can not be used outside of its main thread.
+
+const path = require('path')
+const Module = require('module')
+
+const supportedBindings = new Set(['asar', 'native_image', 'v8_util'])
+const atomBinding = require('../../common/atom-binding-setup')(process.binding, 'browser')
+process.atomBinding = function (name) {
+  if (!supportedBindings.has(name)) {
+    throw new Error(`The "${name}" module is not supported in worker threads`)
+  }
+  return atomBinding(name)
+}
+
+const BASE_INTERNAL_PATH = path.resolve(__dirname, '..', '..')
+const INTERNAL_MODULE_PREFIX = '@electron/internal/'
+
+const electronPath = path.join(__dirname, 'electron.js')
+const originalResolveFilename = Module._resolveFilename
+Module._resolveFilename = function (request, parent, isMain) {
+  if (request === 'electron') {
+    return electronPath
+  } else if (request.startsWith(INTERNAL_MODULE_PREFIX) && request.length > INTERNAL_MODULE_PREFIX.length) {
+    const slicedRequest = request.slice(INTERNAL_MODULE_PREFIX.length)
+    return path.resolve(BASE_INTERNAL_PATH, `${slicedRequest}${slicedRequest.endsWith('.js') ? '' : '.js'}`)
+  } else {
+    return originalResolveFilename(request, parent, isMain)
+  }
+}
@@ -2,114 +2,99 @@
 
 const v8Util = process.atomBinding('v8_util')
 
-const getOwnerKey = (webContents, contextId) => {
-  return `${webContents.id}-${contextId}`
-}
-
 class ObjectsRegistry {
   constructor () {
-    this.nextId = 0
+    // Stores all objects by ref-counting, in a native table so that large
+    // numbers of references do not slow down the garbage collector.
+    this.table = v8Util.createObjectTable()
 
-    // Stores all objects by ref-counting.
-    // (id) => {object, count}
-    this.storage = {}
-
-    // Stores the IDs of objects referenced by WebContents.
-    // (ownerKey) => [id]
-    this.owners = {}
+    // Stores the owner of each context that references objects.
+    // (webContentsId) => Map<contextId, owner>
+    this.owners = new Map()
   }
 
   // Register a new object and return its assigned ID. If the object is already
   // registered then the already assigned ID would be returned.
   add (webContents, contextId, obj) {
     // Get or assign an ID to the object.
-    const id = this.saveToStorage(obj)
-
-    // Add object to the set of referenced objects.
-    const ownerKey = getOwnerKey(webContents, contextId)
-    let owner = this.owners[ownerKey]
-    if (!owner) {
-      owner = this.owners[ownerKey] = new Set()
-      this.registerDeleteListener(webContents, contextId)
-    }
-    if (!owner.has(id)) {
-      owner.add(id)
-      // Increase reference count if not referenced before.
-      this.storage[id].count++
+    let id = v8Util.getHiddenValue(obj, 'atomId')
+    if (!id) {
+      id = this.table.add(obj)
+      v8Util.setHiddenValue(obj, 'atomId', id)
     }
+
+    // Add object to the set of referenced objects, the table increases the
+    // reference count if it was not referenced before.
+    this.table.reference(id, this.getOwner(webContents, contextId))
     return id
   }
 
   // Get an object according to its ID.
   get (id) {
-    const pointer = this.storage[id]
-    if (pointer != null) return pointer.object
+    return this.table.get(id)
   }
 
-  // Dereference an object according to its ID.
+  // Dereference objects according to their IDs.
   // Note that an object may be double-freed (cleared when page is reloaded, and
   // then garbage collected in old page).
-  remove (webContents, contextId, id) {
-    const ownerKey = getOwnerKey(webContents, contextId)
-    const owner = this.owners[ownerKey]
-    if (owner) {
-      // Remove the reference in owner.
-      owner.delete(id)
-      // Dereference from the storage.
-      this.dereference(id)
-    }
+  remove (webContents, contextId, ids) {
+    const owner = this.findOwner(webContents, contextId)
+    if (owner) this.table.dereference(ids, owner)
   }
 
   // Clear all references to objects refrenced by the WebContents.
   clear (webContents, contextId) {
-    const ownerKey = getOwnerKey(webContents, contextId)
-    const owner = this.owners[ownerKey]
-    if (!owner) return
-
-    for (const id of owner) this.dereference(id)
+    const contexts = this.owners.get(webContents.id)
+    if (!contexts || !contexts.has(contextId)) return
 
-    delete this.owners[ownerKey]
+    this.table.releaseOwner(contexts.get(contextId))
+    contexts.delete(contextId)
   }
 
-  // Private: Saves the object into storage and assigns an ID for it.
-  saveToStorage (object) {
-    let id = v8Util.getHiddenValue(object, 'atomId')
-    if (!id) {
-      id = ++this.nextId
-      this.storage[id] = {
-        count: 0,
-        object: object
-      }
-      v8Util.setHiddenValue(object, 'atomId', id)
-    }
-    return id
+  // Private: Returns the owner of the context, or undefined.
+  findOwner (webContents, contextId) {
+    const contexts = this.owners.get(webContents.id)
+    if (contexts) return contexts.get(contextId)
   }
 
-  // Private: Dereference the object from store.
-  dereference (id) {
-    const pointer = this.storage[id]
-    if (pointer == null) {
-      return
+  // Private: Returns the owner of the context, which is created when the
+  // context references its first object.
+  getOwner (webContents, contextId) {
+    let contexts = this.owners.get(webContents.id)
+    if (!contexts) {
+      contexts = new Map()
+      this.owners.set(webContents.id, contexts)
+      this.registerDeleteListener(webContents, contexts)
     }
-    pointer.count -= 1
-    if (pointer.count === 0) {
-      v8Util.deleteHiddenValue(pointer.object, 'atomId')
-      delete this.storage[id]
+    let owner = contexts.get(contextId)
+    if (!owner) {
+      owner = this.table.createOwner()
+      contexts.set(contextId, owner)
     }
+    return owner
   }
 
-  // Private: Clear the storage when renderer process is destroyed.
-  registerDeleteListener (webContents, contextId) {
-    // contextId => ${processHostId}-${contextCount}
-    const processHostId = contextId.split('-')[0]
+  // Private: Clear the storage when renderer process is destroyed, a single
+  // listener handles all the contexts of the WebContents.
+  registerDeleteListener (webContents, contexts) {
+    const webContentsId = webContents.id
     const listener = (event, deletedProcessHostId) => {
-      if (deletedProcessHostId &&
-          deletedProcessHostId.toString() === processHostId) {
-        webContents.removeListener('render-view-deleted', listener)
-        this.clear(webContents, contextId)
+      if (!deletedProcessHostId) return
+      // contextId => ${processHostId}-${contextCount}
+      const prefix = `${deletedProcessHostId}-`
+      for (const [contextId, owner] of contexts) {
+        if (contextId.startsWith(prefix)) {
+          this.table.releaseOwner(owner)
+          contexts.delete(contextId)
+        }
       }
     }
     webContents.on('render-view-deleted', listener)
+    webContents.once('destroyed', () => {
+      webContents.removeListener('render-view-deleted', listener)
+      for (const owner of contexts.values()) this.table.releaseOwner(owner)
+      this.owners.delete(webContentsId)
+    })
   }
 }
 
@@ -23,12 +23,30 @@ const FUNCTION_PROPERTIES = [
   'length', 'name', 'arguments', 'caller', 'prototype'
 ]
 
+// Strings longer than this are fetched when read instead of being sent along
+// with their object.
+const MAX_SNAPSHOT_STRING_LENGTH = 1024
+
 // The remote functions in renderer processes.
 // id => Function
 const rendererFunctions = v8Util.createDoubleIDWeakMap()
 
-// Return the description of object's members:
-const getObjectMembers = function (object) {
+// Whether the value of a data property can be sent along with its object.
+const isSnapshotValue = function (value) {
+  switch (typeof value) {
+    case 'boolean':
+    case 'number':
+      return true
+    case 'string':
+      return value.length <= MAX_SNAPSHOT_STRING_LENGTH
+    default:
+      return value === null
+  }
+}
+
+// Return the description of object's members, with the snapshots of plain
+// data properties when |includeSnapshots| is true:
+const getObjectMembers = function (object, includeSnapshots = false) {
   let names = Object.getOwnPropertyNames(object)
   // For Function, we should not override following properties even though they
   // are "own" properties.
@@ -46,6 +64,9 @@ const getObjectMembers = function (object) {
     } else {
       if (descriptor.set || descriptor.writable) member.writable = true
       member.type = 'get'
+      if (includeSnapshots && descriptor.get === undefined && isSnapshotValue(descriptor.value)) {
+        member.snapshot = { value: descriptor.value }
+      }
     }
     return member
   })
@@ -98,7 +119,7 @@ const valueToMeta = function (sender, contextId, value, optimizeSimpleObject = f
     // passed to renderer we would assume the renderer keeps a reference of
     // it.
     meta.id = objectsRegistry.add(sender, contextId, value)
-    meta.members = getObjectMembers(value)
+    meta.members = getObjectMembers(value, true)
     meta.proto = getObjectPrototype(value)
   } else if (meta.type === 'buffer') {
     meta.value = bufferUtils.bufferToMeta(value)
@@ -399,8 +420,39 @@ handleRemoteCommand('ELECTRON_BROWSER_MEMBER_GET', function (event, contextId, i
   return valueToMeta(event.sender, contextId, obj[name])
 })
 
-handleRemoteCommand('ELECTRON_BROWSER_DEREFERENCE', function (event, contextId, id) {
-  objectsRegistry.remove(event.sender, contextId, id)
+// Runs a chain of member accesses and calls, starting from object |id|, and
+// returns the last value.
+handleRemoteCommand('ELECTRON_BROWSER_MEMBER_PIPELINE', function (event, contextId, id, steps) {
+  let obj = objectsRegistry.get(id)
+
+  if (obj == null) {
+    throwRPCError(`Cannot run pipeline on missing remote object ${id}`)
+  }
+
+  for (const step of steps) {
+    if (obj == null) {
+      throwRPCError(`Cannot ${step.type} '${step.name}' of ${obj}`)
+    }
+
+    if (step.type === 'get') {
+      obj = obj[step.name]
+    } else if (step.type === 'call') {
+      const func = obj[step.name]
+      if (typeof func !== 'function') {
+        throwRPCError(`'${step.name}' is not a function`)
+      }
+      obj = func.apply(obj, unwrapArgs(event.sender, contextId, step.args))
+    } else {
+      throwRPCError(`Unknown pipeline step: ${step.type}`)
+    }
+  }
+
+  return valueToMeta(event.sender, contextId, obj, true)
+})
+
+// The renderer sends the IDs of the objects it collected in batches.
+handleRemoteCommand('ELECTRON_BROWSER_DEREFERENCE', function (event, contextId, ids) {
+  objectsRegistry.remove(event.sender, contextId, ids)
 })
 
 handleRemoteCommand('ELECTRON_BROWSER_CONTEXT_RELEASE', (event, contextId) => {
@@ -520,19 +572,40 @@ ipcMain.on('ELECTRON_BROWSER_CLIPBOARD_WRITE_FIND_TEXT', function (event, text)
   setReturnValue(event, () => electron.clipboard.writeFindText(text))
 })
 
+// The preload scripts of sandboxed frames, which are requested again by every
+// navigation. An entry is reused while the file keeps its size and mtime, which
+// also identify the code cache that the renderer keeps for it.
+const preloadCache = new Map()
+
+const readPreload = function (preloadPath) {
+  const stats = fs.statSync(preloadPath)
+  const cacheKey = `${preloadPath}:${stats.size}:${stats.mtimeMs}`
+  const cached = preloadCache.get(preloadPath)
+  if (cached && cached.cacheKey === cacheKey) return cached
+
+  const entry = { cacheKey, src: fs.readFileSync(preloadPath).toString() }
+  preloadCache.set(preloadPath, entry)
+  return entry
+}
+
 ipcMain.on('ELECTRON_BROWSER_SANDBOX_LOAD', function (event) {
   const preloadPath = event.sender._getPreloadPath()
   let preloadSrc = null
+  let preloadCacheKey = null
   let preloadError = null
   if (preloadPath) {
     try {
-      preloadSrc = fs.readFileSync(preloadPath).toString()
+      const preload = readPreload(preloadPath)
+      preloadSrc = preload.src
+      preloadCacheKey = preload.cacheKey
     } catch (err) {
+      preloadCache.delete(preloadPath)
       preloadError = { stack: err ? err.stack : (new Error(`Failed to load "${preloadPath}"`)).stack }
     }
   }
   event.returnValue = {
     preloadSrc,
+    preloadCacheKey,
     preloadError,
     isRemoteModuleEnabled: event.sender._isRemoteModuleEnabled(),
     process: {
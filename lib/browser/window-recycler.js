@@ -0,0 +1,237 @@
+'use strict'
+
+const electron = require('electron')
+const path = require('path')
+
+// Options that may differ between the uses of a recycled window.
+const perUseOptions = new Set(['x', 'y', 'width', 'height', 'center', 'show', 'title'])
+
+// The number of closed windows kept for each configuration.
+const kMaxRecycledWindows = 4
+
+// Closed windows waiting to be reused, keyed by their options.
+const pools = new Map()
+const poolKeys = new WeakMap()
+let listeningForQuit = false
+let quitting = false
+
+// Returns the key of the windows that can be reused for |options|, or null
+// when windows created with |options| must not be recycled.
+const getPoolKey = function (options) {
+  if (options == null || options.recyclable !== true) return null
+  if (options.webContents != null || options.parent != null) return null
+  if (options.icon != null && typeof options.icon !== 'string') return null
+  // Windows opened by pages are managed by the guest window manager.
+  if (options.webPreferences != null && options.webPreferences.openerId != null) return null
+
+  const creationOptions = {}
+  for (const key of Object.keys(options)) {
+    if (!perUseOptions.has(key)) creationOptions[key] = options[key]
+  }
+  // Sort the keys of all objects so the order of the options does not matter.
+  return JSON.stringify(creationOptions, (key, value) => {
+    if (value == null || typeof value !== 'object' || Array.isArray(value)) return value
+    const sorted = {}
+    for (const name of Object.keys(value).sort()) sorted[name] = value[name]
+    return sorted
+  })
+}
+
+// The listeners added by the app, which are removed when its window is
+// recycled. Electron's own modules may add listeners at any time, those stay.
+const appListeners = new WeakSet()
+
+// Listeners that renderers add through the remote module belong to the app.
+const internalPrefix = path.join(process.resourcesPath, 'electron.asar') + path.sep
+const remoteServer = path.join(internalPrefix, 'browser', 'rpc-server.js')
+
+// Whether the listener being added comes from the app, judged by the caller
+// of the wrapped method, skipping the events module whose "once" calls "on".
+const isAddedByApp = function () {
+  const { prepareStackTrace, stackTraceLimit } = Error
+  let files
+  try {
+    Error.stackTraceLimit = 8
+    Error.prepareStackTrace = (error, frames) => frames.map(frame => frame.getFileName())
+    const holder = {}
+    Error.captureStackTrace(holder, isAddedByApp)
+    files = holder.stack
+  } finally {
+    Error.prepareStackTrace = prepareStackTrace
+    Error.stackTraceLimit = stackTraceLimit
+  }
+  const caller = files.slice(1).find(file => file !== 'events.js')
+  if (caller == null) return false
+  return caller === remoteServer || !caller.startsWith(internalPrefix)
+}
+
+// Tags the listeners the app adds to |emitter| from now on, "once" and
+// "prependOnceListener" go through "on" and "prependListener".
+const trackAppListeners = function (emitter) {
+  for (const method of ['on', 'addListener', 'prependListener']) {
+    const original = emitter[method]
+    emitter[method] = function (name, listener) {
+      if (typeof listener === 'function' && isAddedByApp()) appListeners.add(listener)
+      return original.apply(this, arguments)
+    }
+  }
+}
+
+const removeAppListeners = function (emitter) {
+  for (const name of emitter.eventNames()) {
+    for (const listener of emitter.rawListeners(name)) {
+      if (appListeners.has(listener)) emitter.removeListener(name, listener)
+    }
+  }
+}
+
+const destroyPooledWindows = function () {
+  const windows = []
+  for (const pool of pools.values()) windows.push(...pool)
+  pools.clear()
+  for (const window of windows) {
+    poolKeys.delete(window)
+    window.destroy()
+  }
+}
+
+// Whether a window other than |window| is in use by the app.
+const hasWindowInUse = function (window) {
+  const { TopLevelWindow } = electron
+  return TopLevelWindow.getAllWindows().some((other) => {
+    return other !== window && !other.isDestroyed() && !exports.isPooled(other)
+  })
+}
+
+const canRecycle = function (window, key) {
+  if (quitting) return false
+  const pool = pools.get(key)
+  if (pool != null && pool.length >= kMaxRecycledWindows) return false
+  // The pools are released as soon as no window is in use, so the last one is
+  // destroyed right away.
+  return hasWindowInUse(window)
+}
+
+const recycle = function (window, key, options, emit) {
+  const { webContents } = window
+  if (window.isFullScreen()) window.setFullScreen(false)
+  window.hide()
+  window.setBrowserView(null)
+  if (webContents.isDevToolsOpened()) webContents.closeDevTools()
+
+  // To the app the window is gone.
+  emit.call(window, 'closed', {})
+  removeAppListeners(window)
+  removeAppListeners(webContents)
+
+  // The page can not keep a window that has been closed.
+  const ignoreBeforeUnload = (event) => event.preventDefault()
+  webContents.on('will-prevent-unload', ignoreBeforeUnload)
+  webContents.once('did-finish-load', () => {
+    webContents.removeListener('will-prevent-unload', ignoreBeforeUnload)
+    webContents.clearHistory()
+    // Navigating keeps the sessionStorage of the tab, a new window has none.
+    webContents._clearSessionStorage()
+    const { webPreferences = {} } = options
+    webContents.setZoomFactor(webPreferences.zoomFactor || 1)
+  })
+  webContents.loadURL('about:blank')
+
+  if (!pools.has(key)) pools.set(key, [])
+  pools.get(key).push(window)
+  poolKeys.set(window, key)
+}
+
+// Makes |window| recyclable when it was created with the recyclable option.
+exports.setup = function (window, options) {
+  const key = getPoolKey(options)
+  if (key == null) return
+
+  if (!listeningForQuit) {
+    listeningForQuit = true
+    electron.app.once('before-quit', () => {
+      quitting = true
+      destroyPooledWindows()
+    })
+  }
+
+  // The event is only emitted when it has listeners.
+  window.on('close', () => {})
+
+  // The "close" event is intercepted after all its listeners ran, so a window
+  // is only recycled when the app did not prevent closing it.
+  const { emit } = window
+  window.emit = function (name, event, ...args) {
+    const handled = emit.call(this, name, event, ...args)
+    if (name !== 'close' || event.defaultPrevented ||
+        this.isDestroyed() || exports.isPooled(this) || !canRecycle(this, key)) {
+      return handled
+    }
+    event.preventDefault()
+    recycle(this, key, options, emit)
+    return true
+  }
+  window.on('closed', () => {
+    const pool = pools.get(key)
+    if (pool != null && pool.includes(window)) {
+      pool.splice(pool.indexOf(window), 1)
+      poolKeys.delete(window)
+    }
+  })
+  trackAppListeners(window)
+  trackAppListeners(window.webContents)
+}
+
+// Returns a closed window that was created with the same |options|.
+exports.take = function (options) {
+  const key = getPoolKey(options)
+  const pool = key != null ? pools.get(key) : null
+  if (pool == null || pool.length === 0) return null
+
+  const window = pool.pop()
+  poolKeys.delete(window)
+
+  const { width = 800, height = 600 } = options
+  if (options.useContentSize) {
+    window.setContentSize(width, height)
+  } else {
+    window.setSize(width, height)
+  }
+  if (options.x != null && options.y != null) {
+    window.setPosition(options.x, options.y)
+  } else {
+    window.center()
+  }
+  window.setTitle(options.title || electron.app.getName())
+
+  // Undo the changes of the previous use that new windows do not have.
+  window.setAlwaysOnTop(options.alwaysOnTop === true)
+  window.setOpacity(options.opacity != null ? options.opacity : 1)
+  if (window.isFullScreen() !== (options.fullscreen === true)) {
+    window.setFullScreen(options.fullscreen === true)
+  }
+  if (process.platform !== 'darwin') {
+    window.setMenu(electron.app.getApplicationMenu() || null)
+  }
+
+  // The page painted long ago, apps waiting for "ready-to-show" get it once
+  // their next page has loaded.
+  window.webContents.once('did-finish-load', () => {
+    if (!window.isDestroyed()) window.emit('ready-to-show', {})
+  })
+  if (options.show !== false) window.show()
+
+  electron.app.emit('browser-window-created', {}, window)
+  return window
+}
+
+exports.isPooled = function (window) {
+  return poolKeys.has(window)
+}
+
+// Hidden pooled windows would keep the app from emitting "window-all-closed",
+// so they are destroyed once the last window in use is closed.
+exports.onWindowClosed = function (window) {
+  if (pools.size === 0 || exports.isPooled(window)) return
+  if (!hasWindowInUse(window)) destroyPooledWindows()
+}
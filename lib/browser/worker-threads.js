@@ -0,0 +1,57 @@
+'use strict'
+
+// The worker threads of Node run their scripts without Electron's init.js,
+// so the Worker class is replaced by one that first sets up asar support and
+// the modules of Electron that work in workers, see node-worker/init.js.
+
+const path = require('path')
+
+const initPath = path.join(__dirname, 'node-worker', 'init.js')
+
+// Runs in the worker, before its script.
+function bootstrap (initPath, script, isEval) {
+  const Module = require('module')
+  const path = require('path')
+  const vm = require('vm')
+
+  const source = process.binding('atom_common_asar').getAsarSource()
+  const wrapper = vm.runInThisContext(Module.wrap(source), { filename: 'asar.js' })
+  const asar = { exports: {} }
+  wrapper.call(asar.exports, asar.exports, require, asar)
+  asar.exports.wrapFsWithAsar(require('fs'))
+
+  require(initPath)
+
+  if (isEval) {
+    vm.runInThisContext(script, { filename: '[worker eval]' })
+  } else {
+    process.argv[1] = path.resolve(script)
+    Module.runMain()
+  }
+}
+
+exports.install = function () {
+  let workerThreads
+  try {
+    workerThreads = require('worker_threads')
+  } catch (error) {
+    return
+  }
+
+  const { Worker } = workerThreads
+  workerThreads.Worker = class extends Worker {
+    constructor (filename, options = {}) {
+      const isEval = Boolean(options && options.eval)
+      // Let Node throw for the paths it does not accept.
+      if (typeof filename !== 'string' ||
+          (!isEval && !path.isAbsolute(filename) && !/^\.\.?[\\/]/.test(filename))) {
+        super(filename, options)
+        return
+      }
+
+      const args = JSON.stringify([initPath, filename, isEval])
+      const code = `(${bootstrap})(...${args})`
+      super(code, Object.assign({}, options, { eval: true }))
+    }
+  }
+}
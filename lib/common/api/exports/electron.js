@@ -1,6 +1,7 @@
 'use strict'
 
 const moduleList = require('@electron/internal/common/api/module-list')
+const v8Util = process.atomBinding('v8_util')
 
 exports.memoizedGetter = (getter) => {
   /*
@@ -18,13 +19,25 @@ exports.memoizedGetter = (getter) => {
   }
 }
 
+// Returns a getter that loads the module |id| on its first use, which shows
+// up in traces of the "electron" category as "require <name>".
+exports.lazyRequire = (name, id) => exports.memoizedGetter(() => {
+  const event = `require ${name}`
+  v8Util.traceBegin(event)
+  try {
+    return require(id)
+  } finally {
+    v8Util.traceEnd(event)
+  }
+})
+
 // Attaches properties to |targetExports|.
 exports.defineProperties = function (targetExports) {
   const descriptors = {}
   for (const module of moduleList) {
     descriptors[module.name] = {
       enumerable: !module.private,
-      get: exports.memoizedGetter(() => require(`@electron/internal/common/api/${module.file}`))
+      get: exports.lazyRequire(module.name, `@electron/internal/common/api/${module.file}`)
     }
   }
   return Object.defineProperties(targetExports, descriptors)
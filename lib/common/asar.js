@@ -215,6 +215,113 @@
     }
   }
 
+  // Resolves the modules inside an archive with one lookup per search path,
+  // instead of a stat for each extension and a realpath for the match.
+  const wrapFindPath = (Module, fs) => {
+    const path = require('path')
+    const { preserveSymlinks } = process.binding('config')
+    const findPath = Module._findPath
+    const findPathFrom = (self, request, paths, isMain, cacheKey) => {
+      const filename = findPath.call(self, request, paths, isMain)
+      if (filename) Module._pathCache[cacheKey] = filename
+      return filename
+    }
+
+    Module._findPath = function (request, paths, isMain) {
+      const trailingSlash = /(^|[\\/])\.{0,2}$/.test(request)
+      if (isMain || preserveSymlinks || trailingSlash) {
+        return findPath.apply(this, arguments)
+      }
+
+      if (path.isAbsolute(request)) {
+        paths = ['']
+      } else if (!paths || paths.length === 0) {
+        return false
+      }
+
+      const cacheKey = request + '\x00' +
+        (paths.length === 1 ? paths[0] : paths.join('\x00'))
+      const entry = Module._pathCache[cacheKey]
+      if (entry) return entry
+
+      const extensions = Object.keys(Module._extensions)
+      for (let i = 0; i < paths.length; i++) {
+        const basePath = path.resolve(paths[i], request)
+        const { isAsar, asarPath, filePath } = splitPath(basePath)
+        // Leave the paths outside of archives and the directories, which
+        // need their package.json, to the default lookup.
+        if (!isAsar || !filePath) {
+          return findPathFrom(this, request, paths.slice(i), isMain, cacheKey)
+        }
+
+        const archive = getOrCreateArchive(asarPath)
+        if (!archive) continue
+
+        // Same order as Module._findPath: the path itself when it is a file,
+        // the path with each extension, then the directory with its
+        // package.json or index, which is left to the default lookup.
+        const stats = archive.stat(filePath)
+        const isDirectory = Boolean(stats && stats.isDirectory)
+        const candidates = extensions.map(ext => filePath + ext)
+        if (stats && !isDirectory) candidates.unshift(filePath)
+        const index = archive.resolveCandidates(candidates)
+        if (index >= 0) {
+          const filename = fs.realpathSync(path.join(asarPath, candidates[index]))
+          Module._pathCache[cacheKey] = filename
+          return filename
+        }
+
+        if (isDirectory) {
+          return findPathFrom(this, request, paths.slice(i), isMain, cacheKey)
+        }
+      }
+      return false
+    }
+  }
+
+  // Electron's own modules are compiled into the binary, load them from memory
+  // instead of resolving and reading them in electron.asar. The modules that
+  // were not embedded still come from the archive.
+  const wrapInternalModules = (Module) => {
+    // Node run by ELECTRON_RUN_AS_NODE has no resources path.
+    if (typeof process.resourcesPath !== 'string') return
+
+    const path = require('path')
+    const internalPrefix = path.join(process.resourcesPath, 'electron.asar') + path.sep
+
+    const getInternalPath = filename => {
+      if (isAsarDisabled() || !filename.startsWith(internalPrefix)) return null
+      return filename.substr(internalPrefix.length).split(path.sep).join('/')
+    }
+
+    const findPath = Module._findPath
+    Module._findPath = function (request, paths, isMain) {
+      let basePath = null
+      if (path.isAbsolute(request)) {
+        basePath = request
+      } else if (/^\.\.?[\\/]/.test(request) && paths && paths.length === 1) {
+        basePath = path.resolve(paths[0], request)
+      }
+      const internalPath = basePath && getInternalPath(path.normalize(basePath))
+      if (internalPath) {
+        for (const candidate of [internalPath, `${internalPath}.js`]) {
+          if (asar.hasInternalModule(candidate)) {
+            return internalPrefix + candidate.split('/').join(path.sep)
+          }
+        }
+      }
+      return findPath.apply(this, arguments)
+    }
+
+    const loadJs = Module._extensions['.js']
+    Module._extensions['.js'] = function (module, filename) {
+      const internalPath = getInternalPath(filename)
+      const source = internalPath && asar.getInternalModuleSource(internalPath)
+      if (typeof source !== 'string') return loadJs.apply(this, arguments)
+      module._compile(source, filename)
+    }
+  }
+
   // Override fs APIs.
   exports.wrapFsWithAsar = fs => {
     const logFDs = {}
@@ -259,15 +366,14 @@
         return
       }
 
-      const stats = archive.stat(filePath)
-      if (!stats) {
-        const error = createError(AsarError.NOT_FOUND, { asarPath, filePath })
-        nextTick(callback, [error])
-        return
-      }
+      archive.statAsync(filePath, (stats) => {
+        if (!stats) {
+          callback(createError(AsarError.NOT_FOUND, { asarPath, filePath }))
+          return
+        }
 
-      const fsStats = asarStatsToFsStats(stats)
-      nextTick(callback, [null, fsStats])
+        callback(null, asarStatsToFsStats(stats))
+      })
     }
 
     const { statSync } = fs
@@ -289,7 +395,7 @@
       if (!isAsar) return stat(pathArgument, options, callback)
 
       // Do not distinguish links for now.
-      process.nextTick(() => fs.lstat(pathArgument, options, callback))
+      fs.lstat(pathArgument, options, callback)
     }
 
     const { realpathSync } = fs
@@ -344,20 +450,20 @@
         return
       }
 
-      const fileRealPath = archive.realpath(filePath)
-      if (fileRealPath === false) {
-        const error = createError(AsarError.NOT_FOUND, { asarPath, filePath })
-        nextTick(callback, [error])
-        return
-      }
-
-      realpath(asarPath, options, (error, archiveRealPath) => {
-        if (error === null) {
-          const fullPath = path.join(archiveRealPath, fileRealPath)
-          callback(null, fullPath)
-        } else {
-          callback(error)
+      archive.realpathAsync(filePath, (fileRealPath) => {
+        if (fileRealPath === false) {
+          callback(createError(AsarError.NOT_FOUND, { asarPath, filePath }))
+          return
         }
+
+        realpath(asarPath, options, (error, archiveRealPath) => {
+          if (error === null) {
+            const fullPath = path.join(archiveRealPath, fileRealPath)
+            callback(null, fullPath)
+          } else {
+            callback(error)
+          }
+        })
       })
     }
 
@@ -377,20 +483,20 @@
         return
       }
 
-      const fileRealPath = archive.realpath(filePath)
-      if (fileRealPath === false) {
-        const error = createError(AsarError.NOT_FOUND, { asarPath, filePath })
-        nextTick(callback, [error])
-        return
-      }
-
-      realpath.native(asarPath, options, (error, archiveRealPath) => {
-        if (error === null) {
-          const fullPath = path.join(archiveRealPath, fileRealPath)
-          callback(null, fullPath)
-        } else {
-          callback(error)
+      archive.realpathAsync(filePath, (fileRealPath) => {
+        if (fileRealPath === false) {
+          callback(createError(AsarError.NOT_FOUND, { asarPath, filePath }))
+          return
         }
+
+        realpath.native(asarPath, options, (error, archiveRealPath) => {
+          if (error === null) {
+            const fullPath = path.join(archiveRealPath, fileRealPath)
+            callback(null, fullPath)
+          } else {
+            callback(error)
+          }
+        })
       })
     }
 
@@ -406,8 +512,7 @@
         return
       }
 
-      const pathExists = (archive.stat(filePath) !== false)
-      nextTick(callback, [pathExists])
+      archive.statAsync(filePath, (stats) => callback(stats !== false))
     }
 
     fs.exists[util.promisify.custom] = pathArgument => {
@@ -420,7 +525,9 @@
         return Promise.reject(error)
       }
 
-      return Promise.resolve(archive.stat(filePath) !== false)
+      return new Promise(resolve => {
+        archive.statAsync(filePath, (stats) => resolve(stats !== false))
+      })
     }
 
     const { existsSync } = fs
@@ -459,8 +566,7 @@
       }
 
       if (info.unpacked) {
-        const realPath = archive.copyFileOut(filePath)
-        return fs.access(realPath, mode, callback)
+        return access(info.path, mode, callback)
       }
 
       const stats = archive.stat(filePath)
@@ -497,8 +603,7 @@
       }
 
       if (info.unpacked) {
-        const realPath = archive.copyFileOut(filePath)
-        return fs.accessSync(realPath, mode)
+        return accessSync(info.path, mode)
       }
 
       const stats = archive.stat(filePath)
@@ -548,21 +653,20 @@
       }
 
       if (info.unpacked) {
-        const realPath = archive.copyFileOut(filePath)
-        return fs.readFile(realPath, options, callback)
-      }
-
-      const buffer = Buffer.alloc(info.size)
-      const fd = archive.getFd()
-      if (!(fd >= 0)) {
-        const error = createError(AsarError.NOT_FOUND, { asarPath, filePath })
-        nextTick(callback, [error])
-        return
+        return readFile(info.path, options, callback)
       }
 
+      // The content is checked against the block hashes and decompressed on
+      // the thread pool.
       logASARAccess(asarPath, filePath, info.offset)
-      fs.read(fd, buffer, 0, info.size, info.offset, error => {
-        callback(error, encoding ? buffer.toString(encoding) : buffer)
+      archive.readFileAsync(filePath, buffer => {
+        if (buffer === false) {
+          callback(createError(AsarError.NOT_FOUND, { asarPath, filePath }))
+        } else if (!buffer) {
+          callback(createError(AsarError.INVALID_ARCHIVE, { asarPath }))
+        } else {
+          callback(null, encoding ? buffer.toString(encoding) : buffer)
+        }
       })
     }
 
@@ -574,14 +678,22 @@
       const archive = getOrCreateArchive(asarPath)
       if (!archive) throw createError(AsarError.INVALID_ARCHIVE, { asarPath })
 
+      // Look up and read the file in one call unless the reads are logged.
+      const encoding = typeof options === 'string' ? options : options && options.encoding
+      if (!process.env.ELECTRON_LOG_ASAR_READS &&
+          (options == null || typeof options === 'string' || typeof options === 'object') &&
+          (!encoding || encoding === 'utf8' || encoding === 'utf-8')) {
+        const result = archive.readFileSync(filePath, Boolean(encoding))
+        if (result === false) throw createError(AsarError.NOT_FOUND, { asarPath, filePath })
+        if (result === undefined) throw createError(AsarError.INVALID_ARCHIVE, { asarPath })
+        if (result !== null) return result
+      }
+
       const info = archive.getFileInfo(filePath)
       if (!info) throw createError(AsarError.NOT_FOUND, { asarPath, filePath })
 
       if (info.size === 0) return (options) ? '' : Buffer.alloc(0)
-      if (info.unpacked) {
-        const realPath = archive.copyFileOut(filePath)
-        return fs.readFileSync(realPath, options)
-      }
+      if (info.unpacked) return readFileSync(info.path, options)
 
       if (!options) {
         options = { encoding: null }
@@ -591,14 +703,16 @@
         throw new TypeError('Bad arguments')
       }
 
-      const { encoding } = options
-      const buffer = Buffer.alloc(info.size)
-      const fd = archive.getFd()
-      if (!(fd >= 0)) throw createError(AsarError.NOT_FOUND, { asarPath, filePath })
-
       logASARAccess(asarPath, filePath, info.offset)
-      fs.readSync(fd, buffer, 0, info.size, info.offset)
-      return (encoding) ? buffer.toString(encoding) : buffer
+
+      // The view is backed by read-only mapped memory, never return it as is.
+      const view = info.compressed ? false : archive.readFileView(filePath)
+      if (view === undefined) throw createError(AsarError.INVALID_ARCHIVE, { asarPath })
+      if (view) return (options.encoding) ? view.toString(options.encoding) : Buffer.from(view)
+
+      const buffer = archive.readFile(filePath)
+      if (!buffer) throw createError(AsarError.INVALID_ARCHIVE, { asarPath })
+      return (options.encoding) ? buffer.toString(options.encoding) : buffer
     }
 
     const { readdir } = fs
@@ -617,14 +731,14 @@
         return
       }
 
-      const files = archive.readdir(filePath)
-      if (!files) {
-        const error = createError(AsarError.NOT_FOUND, { asarPath, filePath })
-        nextTick(callback, [error])
-        return
-      }
+      archive.readdirAsync(filePath, (files) => {
+        if (!files) {
+          callback(createError(AsarError.NOT_FOUND, { asarPath, filePath }))
+          return
+        }
 
-      nextTick(callback, [null, files])
+        callback(null, files)
+      })
     }
 
     const { readdirSync } = fs
@@ -653,21 +767,26 @@
       const archive = getOrCreateArchive(asarPath)
       if (!archive) return
 
+      if (!process.env.ELECTRON_LOG_ASAR_READS) {
+        const result = archive.readFileSync(filePath, true)
+        if (result === false || result === undefined) return
+        if (result !== null) return result
+      }
+
       const info = archive.getFileInfo(filePath)
       if (!info) return
       if (info.size === 0) return ''
       if (info.unpacked) {
-        const realPath = archive.copyFileOut(filePath)
-        return fs.readFileSync(realPath, { encoding: 'utf8' })
+        return readFileSync(info.path, { encoding: 'utf8' })
       }
 
-      const buffer = Buffer.alloc(info.size)
-      const fd = archive.getFd()
-      if (!(fd >= 0)) return
-
       logASARAccess(asarPath, filePath, info.offset)
-      fs.readSync(fd, buffer, 0, info.size, info.offset)
-      return buffer.toString('utf8')
+      const view = info.compressed ? false : archive.readFileView(filePath)
+      if (view === undefined) return
+      if (view) return view.toString('utf8')
+
+      const buffer = archive.readFile(filePath)
+      return buffer ? buffer.toString('utf8') : undefined
     }
 
     const { internalModuleStat } = process.binding('fs')
@@ -746,6 +865,8 @@
     overrideAPI(childProcess, 'execFile')
     overrideAPISync(process, 'dlopen', 1)
     overrideAPISync(require('module')._extensions, '.node', 1)
+    wrapFindPath(require('module'), fs)
+    wrapInternalModules(require('module'))
     overrideAPISync(fs, 'openSync')
     overrideAPISync(childProcess, 'execFileSync')
   }
@@ -1,7 +1,12 @@
 'use strict'
 
 module.exports = function atomBindingSetup (binding, processType) {
-  return function atomBinding (name) {
+  // A native module is initialized by the first call that gets it, which is
+  // traced so startup traces show which bindings got loaded.
+  const loaded = new Set()
+  let v8Util = null
+
+  const getBinding = function (name) {
     try {
       return binding(`atom_${processType}_${name}`)
     } catch (error) {
@@ -12,4 +17,19 @@ module.exports = function atomBindingSetup (binding, processType) {
       }
     }
   }
+
+  return function atomBinding (name) {
+    if (loaded.has(name)) return getBinding(name)
+
+    if (!v8Util) v8Util = binding('atom_common_v8_util')
+    const event = `atomBinding ${name}`
+    v8Util.traceBegin(event)
+    try {
+      const result = getBinding(name)
+      loaded.add(name)
+      return result
+    } finally {
+      v8Util.traceEnd(event)
+    }
+  }
 }
@@ -0,0 +1,223 @@
+'use strict'
+
+// The V8 code cache of the modules in electron.asar. It is generated at build
+// time by tools/generate-code-cache.js and stored next to the archive, so the
+// modules loaded by init.js are deserialized instead of parsed and compiled
+// again by every process. The scripts of the app's own archives get a cache
+// generated at runtime, see enableAsarCache().
+
+const fs = require('fs')
+const path = require('path')
+const vm = require('vm')
+
+const asarPath = path.resolve(__dirname, '..')
+
+// The file starts with the size of a JSON header as UInt32LE, followed by the
+// header and the cached data of the files it lists.
+exports.serialize = function (entries) {
+  const files = {}
+  const buffers = []
+  let offset = 0
+  for (const [name, data] of entries) {
+    files[name] = [offset, data.length]
+    buffers.push(data)
+    offset += data.length
+  }
+  const header = Buffer.from(JSON.stringify({ v8: process.versions.v8, files }))
+  const headerSize = Buffer.alloc(4)
+  headerSize.writeUInt32LE(header.length, 0)
+  return Buffer.concat([headerSize, header, ...buffers])
+}
+
+exports.parse = function (data, root) {
+  const entries = new Map()
+  const headerSize = data.readUInt32LE(0)
+  const header = JSON.parse(data.toString('utf8', 4, 4 + headerSize))
+  // A cache of another V8 version is always rejected.
+  if (header.v8 !== process.versions.v8) return entries
+
+  const base = 4 + headerSize
+  for (const name of Object.keys(header.files)) {
+    const [offset, size] = header.files[name]
+    entries.set(path.join(root, name), data.slice(base + offset, base + offset + size))
+  }
+  return entries
+}
+
+let builtinEntries = new Map()
+let getAsarCacheDirectory = null
+
+// Scripts whose cached data is written once startup is over, so the cache
+// also covers the functions that ran by then.
+const kWriteDelay = 10 * 1000
+let pendingScripts = []
+let writeTimer = null
+
+const archives = new Map()
+
+function getArchive (archivePath) {
+  if (!archives.has(archivePath)) {
+    const { createArchive } = process.atomBinding('asar')
+    archives.set(archivePath, createArchive(archivePath))
+  }
+  return archives.get(archivePath)
+}
+
+// The name of the cache is derived from the archive's header and the file's
+// location in it, so a new version of the archive never reuses stale data.
+function getAsarCachePath (filename) {
+  const index = filename.lastIndexOf(`.asar${path.sep}`)
+  if (index === -1) return null
+  const archivePath = filename.substr(0, index + 5)
+  const filePath = filename.substr(index + 6)
+  if (archivePath === asarPath) return null
+
+  const archive = getArchive(archivePath)
+  if (!archive) return null
+  const info = archive.getFileInfo(filePath)
+  if (!info || info.unpacked) return null
+
+  const key = [
+    process.versions.v8, archive.getHeaderDigest(), filePath, info.offset, info.size
+  ].join('\n')
+  const hash = require('crypto').createHash('sha1').update(key).digest('hex')
+  return path.join(getAsarCacheDirectory(), hash)
+}
+
+function writeAsarCache () {
+  const scripts = pendingScripts
+  pendingScripts = []
+  writeTimer = null
+
+  for (const { script, cachePath } of scripts) {
+    const data = script.createCachedData()
+    fs.mkdir(path.dirname(cachePath), () => {
+      // Write into a temporary file first, so other processes of the app
+      // never read a partially written cache.
+      const tempPath = `${cachePath}.${process.pid}`
+      fs.writeFile(tempPath, data, (error) => {
+        if (error) return
+        fs.rename(tempPath, cachePath, (error) => {
+          if (error) fs.unlink(tempPath, () => {})
+        })
+      })
+    })
+  }
+}
+
+function compileWithAsarCache (code, options) {
+  const cachePath = getAsarCachePath(options.filename)
+  if (!cachePath) return null
+
+  let cachedData
+  try {
+    cachedData = fs.readFileSync(cachePath)
+  } catch (error) {
+    cachedData = undefined
+  }
+
+  const script = new vm.Script(code, Object.assign({}, options, { cachedData }))
+  if (!cachedData || script.cachedDataRejected) {
+    pendingScripts.push({ script, cachePath })
+    if (!writeTimer) {
+      writeTimer = setTimeout(writeAsarCache, kWriteDelay)
+      if (writeTimer.unref) writeTimer.unref()
+    }
+  }
+  return script
+}
+
+// Let Node's module loader compile the modules of electron.asar with their
+// cached data. A rejected cache, e.g. because of different V8 flags, only
+// means the module is compiled as usual.
+exports.install = function () {
+  // The file is read only once per process, the environments of workers get a
+  // copy of it.
+  const data = process.atomBinding('asar').readCodeCache(`${asarPath}.cache`)
+  try {
+    builtinEntries = data ? exports.parse(data, asarPath) : new Map()
+  } catch (error) {
+    builtinEntries = new Map()
+  }
+
+  // Module.prototype._compile compiles the wrapper of a module with
+  // vm.runInThisContext before running it. Only that call is given the cached
+  // data, the other callers of vm.runInThisContext, including the module's
+  // own code, get the original function.
+  const Module = require('module')
+  let compilingFilename = null
+  const { _compile } = Module.prototype
+  Module.prototype._compile = function (content, filename) {
+    compilingFilename = filename
+    try {
+      return _compile.apply(this, arguments)
+    } finally {
+      compilingFilename = null
+    }
+  }
+
+  const { runInThisContext } = vm
+  vm.runInThisContext = function (code, options) {
+    const filename = options && options.filename
+    if (compilingFilename === null || filename !== compilingFilename) {
+      return runInThisContext.apply(this, arguments)
+    }
+    compilingFilename = null
+
+    const cachedData = builtinEntries.get(filename)
+    if (cachedData) {
+      // Each module is only compiled once.
+      builtinEntries.delete(filename)
+      const script = new vm.Script(code, Object.assign({}, options, { cachedData }))
+      return script.runInThisContext(options)
+    }
+
+    const script = getAsarCacheDirectory && compileWithAsarCache(code, options)
+    if (script) return script.runInThisContext(options)
+    return runInThisContext.apply(this, arguments)
+  }
+}
+
+// The caches of old versions of the archives, and of archives that are gone,
+// are never read again. The files that were not written for a while are
+// removed, and then the oldest ones until the directory is small enough. A
+// cache that was removed while still in use is only generated again.
+const kMaxCacheAge = 30 * 24 * 60 * 60 * 1000
+const kMaxCacheSize = 64 * 1024 * 1024
+
+exports.pruneAsarCache = function (directory) {
+  fs.readdir(directory, (error, names) => {
+    if (error || names.length === 0) return
+
+    let pending = names.length
+    const files = []
+    const prune = () => {
+      const now = Date.now()
+      let size = 0
+      files.sort((a, b) => b.mtime - a.mtime)
+      for (const file of files) {
+        size += file.size
+        if (now - file.mtime > kMaxCacheAge || size > kMaxCacheSize) {
+          fs.unlink(file.path, () => {})
+        }
+      }
+    }
+
+    for (const name of names) {
+      const filePath = path.join(directory, name)
+      fs.stat(filePath, (error, stats) => {
+        if (!error && stats.isFile()) {
+          files.push({ path: filePath, size: stats.size, mtime: stats.mtimeMs })
+        }
+        if (--pending === 0) prune()
+      })
+    }
+  })
+}
+
+// Also cache the scripts that are required from other asar archives, like the
+// app.asar of the app. Their cache is kept in the directory returned by
+// |getDirectory| and generated after their first use.
+exports.enableAsarCache = function (getDirectory) {
+  getAsarCacheDirectory = getDirectory
+}
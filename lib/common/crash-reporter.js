@@ -32,6 +32,7 @@ class CrashReporter {
       companyName,
       extra,
       ignoreSystemCrashHandler,
+      minidumpSizeLimit,
       submitURL,
       uploadToServer
     } = options
@@ -65,6 +66,7 @@ class CrashReporter {
     if (extra._companyName == null) extra._companyName = companyName
     if (extra._version == null) extra._version = ret.appVersion
 
+    if (minidumpSizeLimit != null) binding.setMinidumpSizeLimit(minidumpSizeLimit)
     binding.start(ret.productName, companyName, submitURL, ret.crashesDirectory, uploadToServer, ignoreSystemCrashHandler, extra)
   }
 
@@ -115,6 +117,19 @@ class CrashReporter {
     binding.removeExtraParameter(key)
   }
 
+  createAnnotation (key) {
+    const slot = binding.allocateAnnotation(String(key))
+    if (slot === -1) throw new Error('All the crash annotations are in use')
+    return {
+      set (value) {
+        binding.setAnnotation(slot, String(value))
+      },
+      clear () {
+        binding.clearAnnotation(slot)
+      }
+    }
+  }
+
   getParameters (key, value) {
     return binding.getParameters()
   }
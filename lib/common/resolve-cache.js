@@ -0,0 +1,152 @@
+'use strict'
+
+// A persistent cache of the module resolutions inside asar archives. The
+// archives never change at runtime, so a request that resolved to a file of
+// an archive keeps resolving to it until the archive is replaced. The cache
+// of an archive is named after its header digest and written shortly after
+// startup, so later launches skip the stats of the node_modules lookup.
+
+const fs = require('fs')
+const path = require('path')
+const Module = require('module')
+
+const kWriteDelay = 10 * 1000
+
+let getCacheDirectory = null
+let writeTimer = null
+const caches = new Map()
+
+function getArchivePath (filePath) {
+  if (filePath.endsWith('.asar')) return filePath
+  const index = filePath.lastIndexOf(`.asar${path.sep}`)
+  return index === -1 ? null : filePath.substr(0, index + 5)
+}
+
+function getCache (archivePath) {
+  if (caches.has(archivePath)) return caches.get(archivePath)
+
+  let cache = null
+  const { createArchive } = process.atomBinding('asar')
+  const archive = createArchive(archivePath)
+  if (archive) {
+    const key = [archivePath, archive.getHeaderDigest()].join('\n')
+    const hash = require('crypto').createHash('sha1').update(key).digest('hex')
+    const cachePath = path.join(getCacheDirectory(), `${hash}.resolve`)
+    let entries
+    try {
+      entries = JSON.parse(fs.readFileSync(cachePath, 'utf8'))
+    } catch (error) {
+      entries = {}
+    }
+    if (!entries || typeof entries !== 'object') entries = {}
+    cache = { cachePath, entries, checked: new Set(), dirty: false }
+  }
+  caches.set(archivePath, cache)
+  return cache
+}
+
+function writeCaches () {
+  writeTimer = null
+  for (const cache of caches.values()) {
+    if (!cache || !cache.dirty) continue
+    cache.dirty = false
+
+    const { cachePath } = cache
+    const data = JSON.stringify(cache.entries)
+    fs.mkdir(path.dirname(cachePath), () => {
+      // Write into a temporary file first, so other processes of the app
+      // never read a partially written cache.
+      const tempPath = `${cachePath}.${process.pid}`
+      fs.writeFile(tempPath, data, (error) => {
+        if (error) return
+        fs.rename(tempPath, cachePath, (error) => {
+          if (error) fs.unlink(tempPath, () => {})
+        })
+      })
+    })
+  }
+}
+
+function scheduleWrite (cache) {
+  cache.dirty = true
+  if (!writeTimer) {
+    writeTimer = setTimeout(writeCaches, kWriteDelay)
+    if (writeTimer.unref) writeTimer.unref()
+  }
+}
+
+function addEntry (cache, key, filename) {
+  cache.entries[key] = filename
+  cache.checked.add(key)
+  scheduleWrite(cache)
+}
+
+// The cache file can be edited outside of the app, so an entry is only used
+// when it names a file of the archive, which is checked once per process.
+function getEntry (cache, key, archivePath) {
+  const entry = cache.entries[key]
+  if (!entry || cache.checked.has(key)) return entry
+
+  let valid = false
+  if (typeof entry === 'string' && path.isAbsolute(entry) &&
+      path.normalize(entry) === entry && getArchivePath(entry) === archivePath) {
+    try {
+      valid = fs.statSync(entry).isFile()
+    } catch (error) {
+      valid = false
+    }
+  }
+  if (!valid) {
+    delete cache.entries[key]
+    scheduleWrite(cache)
+    return null
+  }
+  cache.checked.add(key)
+  return entry
+}
+
+function wrapFindPath () {
+  const findPath = Module._findPath
+  Module._findPath = function (request, paths, isMain) {
+    if (isMain || process.noAsar) return findPath.apply(this, arguments)
+
+    if (path.isAbsolute(request)) {
+      paths = ['']
+    } else if (!paths || paths.length === 0) {
+      return false
+    }
+
+    const archivePath = getArchivePath(path.resolve(paths[0], request))
+    const cache = archivePath && getCache(archivePath)
+    if (!cache) return findPath.apply(this, arguments)
+
+    // The extensions are part of the key, registering one can change what a
+    // request resolves to.
+    const key = [Object.keys(Module._extensions).join(), request, ...paths].join('\x00')
+    const entry = getEntry(cache, key, archivePath)
+    if (entry) return entry
+
+    // Look the search paths up one by one, the result only persists when
+    // it and all the paths that were searched before are in the archive.
+    for (let i = 0; i < paths.length; i++) {
+      if (getArchivePath(path.resolve(paths[i], request)) !== archivePath) {
+        return findPath.call(this, request, paths.slice(i), isMain)
+      }
+
+      const filename = findPath.call(this, request, [paths[i]], isMain)
+      if (filename) {
+        if (getArchivePath(filename) === archivePath) addEntry(cache, key, filename)
+        return filename
+      }
+    }
+    return false
+  }
+}
+
+// Persist the resolutions inside asar archives in the directory returned by
+// |getDirectory|.
+exports.enable = function (getDirectory) {
+  if (getCacheDirectory) return
+  getCacheDirectory = getDirectory
+  wrapFindPath()
+}
@@ -0,0 +1,154 @@
+'use strict'
+
+// A single-producer/single-consumer queue of byte messages in a
+// SharedArrayBuffer that is mapped in both the main and the renderer process.
+//
+// The buffer starts with a header of Int32 slots followed by the data area,
+// every message is stored as its Uint32 length and its bytes, padded to 4
+// bytes. A length of WRAP_MARKER tells the reader that the next message
+// starts at the beginning of the data area.
+const HEADER_SIZE = 16
+const HEAD = 0
+const TAIL = 1
+const WAITING = 2
+const WRAP_MARKER = 0xFFFFFFFF
+
+const align = (size) => (size + 3) & ~3
+
+// The writer lives in the main process and the reader in the renderer, the
+// reader is only woken up by |ringDoorbell| after it started waiting.
+// |closeRing| tells the reader that nothing will be written anymore, the
+// memory stays mapped until no script can reach the buffer.
+class SharedRing {
+  constructor (buffer, ringDoorbell = null, closeRing = null) {
+    this.buffer = buffer
+    this.closed = false
+    this._header = new Int32Array(buffer, 0, HEADER_SIZE / 4)
+    this._capacity = (buffer.byteLength - HEADER_SIZE) & ~3
+    this._bytes = new Uint8Array(buffer, HEADER_SIZE, this._capacity)
+    this._view = new DataView(buffer, HEADER_SIZE, this._capacity)
+    this._ringDoorbell = ringDoorbell
+    this._closeRing = closeRing
+    this._notifyScheduled = false
+    this._waiters = []
+  }
+
+  // Appends |data| to the ring, returns false when there is not enough free
+  // space for it.
+  write (data) {
+    if (this.closed) throw new Error('The ring is closed')
+    const bytes = typeof data === 'string' ? Buffer.from(data) : data
+    if (!(bytes instanceof Uint8Array)) {
+      throw new TypeError('Must pass a string or Uint8Array')
+    }
+
+    const size = align(4 + bytes.length)
+    if (size >= this._capacity) {
+      throw new RangeError('Message is larger than the ring')
+    }
+
+    const head = Atomics.load(this._header, HEAD)
+    const tail = Atomics.load(this._header, TAIL)
+
+    // The head never catches up with the tail, equal positions mean empty.
+    let offset = head
+    if (head >= tail) {
+      if (head + size > this._capacity || (head + size === this._capacity && tail === 0)) {
+        if (size >= tail) return false
+        this._view.setUint32(head, WRAP_MARKER, true)
+        offset = 0
+      }
+    } else if (head + size >= tail) {
+      return false
+    }
+
+    this._view.setUint32(offset, bytes.length, true)
+    this._bytes.set(bytes, offset + 4)
+    Atomics.store(this._header, HEAD, (offset + size) % this._capacity)
+
+    // All the messages written in one task share one doorbell.
+    if (!this._notifyScheduled) {
+      this._notifyScheduled = true
+      setImmediate(() => {
+        this._notifyScheduled = false
+        this.notify()
+      })
+    }
+    return true
+  }
+
+  // Wakes up the reader if it is waiting.
+  notify () {
+    if (this.closed) return
+    if (this._ringDoorbell && this._takeWaiting()) this._ringDoorbell()
+  }
+
+  // Returns a Promise that resolves once the ring has messages to read.
+  wait () {
+    if (this.closed || !this.isEmpty()) return Promise.resolve()
+    return new Promise((resolve) => {
+      this._setWaiting()
+      // A message written before the flag was set would not ring the doorbell.
+      if (!this.isEmpty() && this._takeWaiting()) {
+        resolve()
+      } else {
+        this._waiters.push(resolve)
+      }
+    })
+  }
+
+  _onDoorbell () {
+    const waiters = this._waiters
+    this._waiters = []
+    waiters.forEach((resolve) => resolve())
+  }
+
+  // Returns the oldest message as a Uint8Array, or null when the ring is
+  // empty.
+  read () {
+    let tail = Atomics.load(this._header, TAIL)
+    const head = Atomics.load(this._header, HEAD)
+    if (tail === head) return null
+
+    let length = this._view.getUint32(tail, true)
+    if (length === WRAP_MARKER) {
+      tail = 0
+      length = this._view.getUint32(0, true)
+    }
+
+    const message = this._bytes.slice(tail + 4, tail + 4 + length)
+    Atomics.store(this._header, TAIL, (tail + align(4 + length)) % this._capacity)
+    return message
+  }
+
+  isEmpty () {
+    return Atomics.load(this._header, TAIL) === Atomics.load(this._header, HEAD)
+  }
+
+  // Stops the doorbell of the ring in both processes and resolves the pending
+  // waits, the messages already written can still be read.
+  close () {
+    if (this.closed) return
+    this._onClose()
+    if (this._closeRing) this._closeRing()
+  }
+
+  _onClose () {
+    this.closed = true
+    this._onDoorbell()
+  }
+
+  // The reader sets the waiting flag before sleeping, the writer clears it and
+  // returns true when the reader must be woken up.
+  _setWaiting () {
+    Atomics.store(this._header, WAITING, 1)
+  }
+
+  _takeWaiting () {
+    return Atomics.compareExchange(this._header, WAITING, 1, 0) === 1
+  }
+}
+
+SharedRing.HEADER_SIZE = HEADER_SIZE
+
+module.exports = SharedRing
@@ -18,8 +18,12 @@ const ipcRenderer = {
   once () {}
 }
 
-let { guestInstanceId, hiddenPage, openerId, nativeWindowOpen } = binding
+let { guestInstanceId, hiddenPage, openerId, nativeWindowOpen, gpuPreference } = binding
 if (guestInstanceId != null) guestInstanceId = parseInt(guestInstanceId)
 if (openerId != null) openerId = parseInt(openerId)
 
 require('@electron/internal/renderer/window-setup')(ipcRenderer, guestInstanceId, openerId, hiddenPage, nativeWindowOpen)
+
+if (gpuPreference) {
+  require('@electron/internal/renderer/webgl-power-preference')(gpuPreference)
+}
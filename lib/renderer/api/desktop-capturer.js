@@ -17,6 +17,17 @@ function isValid (options) {
   return Array.isArray(types)
 }
 
+const deserializeSource = (source) => {
+  return {
+    id: source.id,
+    name: source.name,
+    thumbnail: source.thumbnail
+      ? nativeImage.createFromBuffer(source.thumbnail)
+      : nativeImage.createEmpty(),
+    display_id: source.display_id
+  }
+}
+
 exports.getSources = function (options, callback) {
   if (!isValid(options)) return callback(new Error('Invalid options'))
   const captureWindow = includes.call(options.types, 'window')
@@ -28,21 +39,30 @@ exports.getSources = function (options, callback) {
       height: 150
     }
   }
+  const thumbnailFormat = options.thumbnailFormat === 'jpeg' ? 'jpeg' : 'png'
+  const onThumbnail = typeof options.onThumbnail === 'function' ? options.onThumbnail : null
 
   const id = incrementId()
-  ipcRenderer.send('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', captureWindow, captureScreen, options.thumbnailSize, id)
+  const thumbnailChannel = `ELECTRON_RENDERER_DESKTOP_CAPTURER_THUMBNAIL_${id}`
+  const streamed = new Set()
+  if (onThumbnail) {
+    ipcRenderer.on(thumbnailChannel, (event, source) => {
+      streamed.add(source.id)
+      onThumbnail(deserializeSource(source))
+    })
+  }
+
+  ipcRenderer.send('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', captureWindow, captureScreen, options.thumbnailSize, thumbnailFormat, onThumbnail != null, id)
   return ipcRenderer.once(`ELECTRON_RENDERER_DESKTOP_CAPTURER_RESULT_${id}`, (event, sources) => {
-    callback(null, (() => {
-      const results = []
-      sources.forEach(source => {
-        results.push({
-          id: source.id,
-          name: source.name,
-          thumbnail: nativeImage.createFromDataURL(source.thumbnail),
-          display_id: source.display_id
-        })
-      })
-      return results
-    })())
+    const results = sources.map(deserializeSource)
+    if (onThumbnail) {
+      ipcRenderer.removeAllListeners(thumbnailChannel)
+      // A request that was merged with an identical one receives all of its
+      // thumbnails with the result.
+      for (const source of results) {
+        if (!streamed.has(source.id) && !source.thumbnail.isEmpty()) onThumbnail(source)
+      }
+    }
+    callback(null, results)
   })
 }
@@ -18,6 +18,6 @@ for (const {
 
   Object.defineProperty(exports, name, {
     enumerable: !isPrivate,
-    get: common.memoizedGetter(() => require(`@electron/internal/renderer/api/${file}`))
+    get: common.lazyRequire(name, `@electron/internal/renderer/api/${file}`)
   })
 }
@@ -2,29 +2,184 @@
 
 const binding = process.atomBinding('ipc')
 const v8Util = process.atomBinding('v8_util')
+const ipcBatching = require('@electron/internal/renderer/ipc-batching')
+const ipcRendererInternal = require('@electron/internal/renderer/ipc-renderer-internal')
+const SharedRing = require('@electron/internal/common/shared-ring')
 
 // Created by init.js.
 const ipcRenderer = v8Util.getHiddenValue(global, 'ipc')
 const internal = false
 
+// Channels whose messages are coalesced, mapped to when they are flushed.
+const batchingModes = ['task', 'animationFrame']
+const batchedChannels = new Map()
+
+ipcRenderer.setBatching = function (channel, mode) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument')
+  }
+  if (mode && !batchingModes.includes(mode)) {
+    throw new Error(`Invalid batching mode '${mode}'`)
+  }
+
+  if (mode) {
+    batchedChannels.set(channel, mode)
+  } else {
+    batchedChannels.delete(channel)
+    ipcBatching.flush()
+  }
+}
+
 ipcRenderer.send = function (...args) {
+  const mode = batchedChannels.get(args[0])
+  if (mode) {
+    const [channel, ...message] = args
+    ipcBatching.queue(mode, channel, message)
+    return
+  }
+
+  // Keep the order of messages when other channels are batched.
+  ipcBatching.flush()
   return binding.send('ipc-message', args)
 }
 
+ipcRenderer.sendSerialized = function (...args) {
+  ipcBatching.flush()
+  return binding.sendSerialized('ipc-message', args, [])
+}
+
+ipcRenderer.postMessage = function (channel, message, transfer = []) {
+  ipcBatching.flush()
+  return binding.sendSerialized('ipc-message', [channel, message], transfer)
+}
+
 ipcRenderer.sendSync = function (...args) {
+  ipcBatching.flush()
   return binding.sendSync('ipc-message-sync', args)[0]
 }
 
+// Invocations waiting for the reply of the ipcMain handler, keyed by the ids
+// of the requests, which are unique in the process.
+const pendingInvokes = new Map()
+
+ipcRendererInternal.on('ELECTRON_RENDERER_INVOKE_REPLY', function (event, requestId, success, result) {
+  const pending = pendingInvokes.get(requestId)
+  if (!pending) return
+  pendingInvokes.delete(requestId)
+  if (success) {
+    pending.resolve(result)
+  } else {
+    pending.reject(new Error(result))
+  }
+})
+
+ipcRenderer.invoke = function (channel, ...args) {
+  if (typeof channel !== 'string') {
+    return Promise.reject(new Error('Missing required channel argument'))
+  }
+
+  return new Promise((resolve, reject) => {
+    try {
+      ipcBatching.flush()
+      // The reply arrives in a later task, after the request is registered.
+      const requestId = binding.invoke(channel, args)
+      pendingInvokes.set(requestId, { resolve, reject })
+    } catch (error) {
+      reject(error)
+    }
+  })
+}
+
 ipcRenderer.sendToHost = function (...args) {
+  ipcBatching.flush()
   return binding.send('ipc-message-host', args)
 }
 
 ipcRenderer.sendTo = function (webContentsId, channel, ...args) {
+  ipcBatching.flush()
   return binding.sendTo(internal, false, webContentsId, channel, args)
 }
 
 ipcRenderer.sendToAll = function (webContentsId, channel, ...args) {
+  ipcBatching.flush()
   return binding.sendTo(internal, true, webContentsId, channel, args)
 }
 
+// Ports opened by this frame, waiting for their end of the message pipe.
+const pendingPorts = new Map()
+let nextPortId = 0
+
+ipcRenderer.openPort = function (webContentsId, channel) {
+  if (typeof channel !== 'string') {
+    return Promise.reject(new Error('Missing required channel argument'))
+  }
+
+  return new Promise((resolve, reject) => {
+    const requestId = ++nextPortId
+    pendingPorts.set(requestId, { resolve, reject })
+    try {
+      ipcBatching.flush()
+      binding.openPort(requestId, webContentsId, channel)
+    } catch (error) {
+      pendingPorts.delete(requestId)
+      reject(error)
+    }
+  })
+}
+
+// The ports are delivered by the browser as message events of the window,
+// which have no source unlike the ones posted by pages. Events created and
+// dispatched by the page are not trusted, so they can not fake a port.
+const onPortMessage = function (event) {
+  const { data } = event
+  if (!event.isTrusted || event.source !== null) return
+  if (!data || data.type !== 'ELECTRON_IPC_PORT') return
+  event.stopImmediatePropagation()
+
+  const [port] = event.ports
+  if (data.requestId === 0) {
+    if (port) {
+      // Ports opened by Electron itself are not exposed to the page.
+      const emitter = data.channel.startsWith('ELECTRON_') ? ipcRendererInternal : ipcRenderer
+      emitter.emit(data.channel, { sender: emitter, senderId: data.senderId, ports: [port] })
+    }
+    return
+  }
+
+  const pending = pendingPorts.get(data.requestId)
+  if (!pending) return
+  pendingPorts.delete(data.requestId)
+  if (port) {
+    pending.resolve(port)
+  } else {
+    pending.reject(new Error(`No webContents with id ${data.senderId}`))
+  }
+}
+
+// Rings shared by webContents.createSharedRing, keyed by their ids.
+const sharedRings = new Map()
+
+ipcRendererInternal.on('ELECTRON_SHARED_RING', function (event, channel, ringId, buffer) {
+  const ring = new SharedRing(buffer)
+  sharedRings.set(ringId, ring)
+  ipcRenderer.emit(channel, { sender: ipcRenderer, senderId: 0, ring })
+})
+
+ipcRendererInternal.on('ELECTRON_SHARED_RING_DOORBELL', function (event, ringId) {
+  const ring = sharedRings.get(ringId)
+  if (ring) ring._onDoorbell()
+})
+
+// The main process closed the ring, it will not be written anymore.
+ipcRendererInternal.on('ELECTRON_SHARED_RING_CLOSE', function (event, ringId) {
+  const ring = sharedRings.get(ringId)
+  if (!ring) return
+  sharedRings.delete(ringId)
+  ring._onClose()
+})
+
+if (typeof window === 'object' && window.addEventListener) {
+  window.addEventListener('message', onPortMessage, true)
+}
+
 module.exports = ipcRenderer
@@ -15,6 +15,46 @@ const remoteObjectCache = v8Util.createIDWeakMap()
 // An unique ID that can represent current context.
 const contextId = v8Util.getHiddenValue(global, 'contextId')
 
+// The snapshots of plain data properties sent along with remote objects, they
+// are read instead of the property until the next remote call or task.
+// object => { epoch, values: Map<name, value> }
+const remoteSnapshots = new WeakMap()
+let snapshotEpoch = 0
+let snapshotExpiryScheduled = false
+
+const expireSnapshots = function () {
+  snapshotEpoch++
+  snapshotExpiryScheduled = false
+}
+
+const setSnapshots = function (object, members) {
+  if (!Array.isArray(members)) return
+
+  const values = new Map()
+  for (const member of members) {
+    if (member.snapshot) values.set(member.name, member.snapshot.value)
+  }
+  if (values.size === 0) return
+
+  remoteSnapshots.set(object, { epoch: snapshotEpoch, values })
+  if (!snapshotExpiryScheduled) {
+    snapshotExpiryScheduled = true
+    setTimeout(expireSnapshots, 0)
+  }
+}
+
+const getSnapshot = function (object, name) {
+  const snapshot = remoteSnapshots.get(object)
+  if (!snapshot || snapshot.epoch !== snapshotEpoch || !snapshot.values.has(name)) return null
+  return { value: snapshot.values.get(name) }
+}
+
+// Every remote call can change the state of the main process.
+const sendSync = function (...args) {
+  expireSnapshots()
+  return ipcRenderer.sendSync(...args)
+}
+
 // Notify the main process when current context is going to be released.
 // Note that when the renderer process is destroyed, the message may not be
 // sent, we also listen to the "render-view-deleted" event in the main process
@@ -122,7 +162,7 @@ function setObjectMembers (ref, object, metaId, members) {
         } else {
           command = 'ELECTRON_BROWSER_MEMBER_CALL'
         }
-        const ret = ipcRenderer.sendSync(command, contextId, metaId, member.name, wrapArgs(args))
+        const ret = sendSync(command, contextId, metaId, member.name, wrapArgs(args))
         return metaToValue(ret)
       }
 
@@ -140,8 +180,11 @@ function setObjectMembers (ref, object, metaId, members) {
       descriptor.configurable = true
     } else if (member.type === 'get') {
       descriptor.get = () => {
+        const snapshot = getSnapshot(object, member.name)
+        if (snapshot) return snapshot.value
+
         const command = 'ELECTRON_BROWSER_MEMBER_GET'
-        const meta = ipcRenderer.sendSync(command, contextId, metaId, member.name)
+        const meta = sendSync(command, contextId, metaId, member.name)
         return metaToValue(meta)
       }
 
@@ -149,7 +192,7 @@ function setObjectMembers (ref, object, metaId, members) {
         descriptor.set = (value) => {
           const args = wrapArgs([value])
           const command = 'ELECTRON_BROWSER_MEMBER_SET'
-          const meta = ipcRenderer.sendSync(command, contextId, metaId, member.name, args)
+          const meta = sendSync(command, contextId, metaId, member.name, args)
           if (meta != null) metaToValue(meta)
           return value
         }
@@ -179,8 +222,9 @@ function proxyFunctionProperties (remoteMemberFunction, metaId, name) {
     if (loaded) return
     loaded = true
     const command = 'ELECTRON_BROWSER_MEMBER_GET'
-    const meta = ipcRenderer.sendSync(command, contextId, metaId, name)
+    const meta = sendSync(command, contextId, metaId, name)
     setObjectMembers(remoteMemberFunction, remoteMemberFunction, meta.id, meta.members)
+    setSnapshots(remoteMemberFunction, meta.members)
   }
 
   return new Proxy(remoteMemberFunction, {
@@ -227,7 +271,9 @@ function metaToValue (meta) {
   } else {
     let ret
     if (remoteObjectCache.has(meta.id)) {
-      return remoteObjectCache.get(meta.id)
+      ret = remoteObjectCache.get(meta.id)
+      setSnapshots(ret, meta.members)
+      return ret
     }
 
     // A shadow class to represent the remote function object.
@@ -239,7 +285,7 @@ function metaToValue (meta) {
         } else {
           command = 'ELECTRON_BROWSER_FUNCTION_CALL'
         }
-        const obj = ipcRenderer.sendSync(command, contextId, meta.id, wrapArgs(args))
+        const obj = sendSync(command, contextId, meta.id, wrapArgs(args))
         return metaToValue(obj)
       }
       ret = remoteFunction
@@ -249,6 +295,7 @@ function metaToValue (meta) {
 
     setObjectMembers(ret, ret, meta.id, meta.members)
     setObjectPrototype(ret, ret, meta.id, meta.proto)
+    setSnapshots(ret, meta.members)
     Object.defineProperty(ret.constructor, 'name', { value: meta.name })
 
     // Track delegate obj's lifetime & tell browser to clean up when object is GCed.
@@ -285,42 +332,77 @@ handleMessage('ELECTRON_RENDERER_CALLBACK', (id, args) => {
   callbacksRegistry.apply(id, metaToValue(args))
 })
 
-// A callback in browser is released.
-handleMessage('ELECTRON_RENDERER_RELEASE_CALLBACK', (id) => {
-  callbacksRegistry.remove(id)
+// Callbacks in browser are released, in batches.
+handleMessage('ELECTRON_RENDERER_RELEASE_CALLBACK', (ids) => {
+  for (const id of ids) {
+    callbacksRegistry.remove(id)
+  }
 })
 
 exports.require = (module) => {
   const command = 'ELECTRON_BROWSER_REQUIRE'
-  const meta = ipcRenderer.sendSync(command, contextId, module)
+  const meta = sendSync(command, contextId, module)
   return metaToValue(meta)
 }
 
 // Alias to remote.require('electron').xxx.
 exports.getBuiltin = (module) => {
   const command = 'ELECTRON_BROWSER_GET_BUILTIN'
-  const meta = ipcRenderer.sendSync(command, contextId, module)
+  const meta = sendSync(command, contextId, module)
   return metaToValue(meta)
 }
 
 exports.getCurrentWindow = () => {
   const command = 'ELECTRON_BROWSER_CURRENT_WINDOW'
-  const meta = ipcRenderer.sendSync(command, contextId)
+  const meta = sendSync(command, contextId)
   return metaToValue(meta)
 }
 
 // Get current WebContents object.
 exports.getCurrentWebContents = () => {
-  return metaToValue(ipcRenderer.sendSync('ELECTRON_BROWSER_CURRENT_WEB_CONTENTS', contextId))
+  return metaToValue(sendSync('ELECTRON_BROWSER_CURRENT_WEB_CONTENTS', contextId))
 }
 
 // Get a global object in browser.
 exports.getGlobal = (name) => {
   const command = 'ELECTRON_BROWSER_GLOBAL'
-  const meta = ipcRenderer.sendSync(command, contextId, name)
+  const meta = sendSync(command, contextId, name)
   return metaToValue(meta)
 }
 
+// Records a chain of member accesses and calls on a remote object, which is
+// run with a single round trip to the main process.
+class RemotePipeline {
+  constructor (id) {
+    this.id = id
+    this.steps = []
+  }
+
+  get (name) {
+    this.steps.push({ type: 'get', name })
+    return this
+  }
+
+  call (name, ...args) {
+    this.steps.push({ type: 'call', name, args: wrapArgs(args) })
+    return this
+  }
+
+  run () {
+    const command = 'ELECTRON_BROWSER_MEMBER_PIPELINE'
+    const meta = sendSync(command, contextId, this.id, this.steps)
+    return metaToValue(meta)
+  }
+}
+
+exports.pipeline = (object) => {
+  const id = v8Util.getHiddenValue(object, 'atomId')
+  if (!id) {
+    throw new TypeError('Expected a remote object')
+  }
+  return new RemotePipeline(id)
+}
+
 // Get the process object in browser.
 exports.__defineGetter__('process', () => exports.getGlobal('process'))
 
@@ -334,7 +416,7 @@ exports.createFunctionWithReturnValue = (returnValue) => {
 // Get the guest WebContents from guestInstanceId.
 exports.getGuestWebContents = (guestInstanceId) => {
   const command = 'ELECTRON_BROWSER_GUEST_WEB_CONTENTS'
-  const meta = ipcRenderer.sendSync(command, contextId, guestInstanceId)
+  const meta = sendSync(command, contextId, guestInstanceId)
   return metaToValue(meta)
 }
 
@@ -3,25 +3,12 @@
 const ipcRenderer = require('@electron/internal/renderer/ipc-renderer-internal')
 const { runInThisContext } = require('vm')
 
-// Check whether pattern matches.
-// https://developer.chrome.com/extensions/match_patterns
-const matchesPattern = function (pattern) {
-  if (pattern === '<all_urls>') return true
-  const regexp = new RegExp(`^${pattern.replace(/\*/g, '.*')}$`)
-  const url = `${location.protocol}//${location.host}${location.pathname}`
-  return url.match(regexp)
-}
-
-// Run the code with chrome API integrated.
+// Run the code with chrome API integrated, the compiled code is cached for
+// the whole renderer process.
 const runContentScript = function (extensionId, url, code) {
   const context = {}
   require('@electron/internal/renderer/chrome-api').injectTo(extensionId, false, context)
-  const wrapper = `((chrome) => {\n  ${code}\n  })`
-  const compiledWrapper = runInThisContext(wrapper, {
-    filename: url,
-    lineOffset: 1,
-    displayErrors: true
-  })
+  const compiledWrapper = process.compileContentScript(url, code)
   return compiledWrapper.call(this, context.chrome)
 }
 
@@ -57,8 +44,6 @@ const runAllStylesheet = function (css) {
 // Run injected scripts.
 // https://developer.chrome.com/extensions/content_scripts
 const injectContentScript = function (extensionId, script) {
-  if (!script.matches.some(matchesPattern)) return
-
   if (script.js) {
     const fire = runAllContentScript.bind(window, script.js, extensionId)
     if (script.runAt === 'document_start') {
@@ -88,14 +73,7 @@ ipcRenderer.on('CHROME_TABS_EXECUTESCRIPT', function (event, senderWebContentsId
   ipcRenderer.sendToAll(senderWebContentsId, `CHROME_TABS_EXECUTESCRIPT_RESULT_${requestId}`, result)
 })
 
-// Read the renderer process preferences.
-const preferences = process.getRenderProcessPreferences()
-if (preferences) {
-  for (const pref of preferences) {
-    if (pref.contentScripts) {
-      for (const script of pref.contentScripts) {
-        injectContentScript(pref.extensionId, script)
-      }
-    }
-  }
+// Inject the content scripts whose patterns match this page.
+for (const { extensionId, script } of process.getContentScripts()) {
+  injectContentScript(extensionId, script)
 }
@@ -8,6 +8,9 @@ const Module = require('module')
 // init.js, we need to restore it here.
 process.argv.splice(1, 1)
 
+// Compile the rest of Electron's modules with their code cache.
+require('../common/code-cache').install()
+
 // Clear search paths.
 require('../common/reset-search-paths')
 
@@ -37,6 +40,7 @@ let preloadScript = null
 let preloadScripts = []
 let isBackgroundPage = false
 let appPath = null
+let asarCodeCache = null
 for (const arg of process.argv) {
   if (arg.indexOf('--guest-instance-id=') === 0) {
     // This is a guest web view.
@@ -52,6 +56,8 @@ for (const arg of process.argv) {
     isBackgroundPage = true
   } else if (arg.indexOf('--app-path=') === 0) {
     appPath = arg.substr(arg.indexOf('=') + 1)
+  } else if (arg.indexOf('--asar-code-cache=') === 0) {
+    asarCodeCache = arg.substr(arg.indexOf('=') + 1)
   } else if (arg.indexOf('--webview-tag=') === 0) {
     webviewTag = arg.substr(arg.indexOf('=') + 1) === 'true'
   } else if (arg.indexOf('--preload-scripts') === 0) {
@@ -64,6 +70,13 @@ if (preloadScript) {
   preloadScripts.push(preloadScript)
 }
 
+// Cache the compiled scripts and the module resolutions of the app's asar
+// archives.
+if (asarCodeCache) {
+  require('@electron/internal/common/code-cache').enableAsarCache(() => asarCodeCache)
+  require('@electron/internal/common/resolve-cache').enable(() => asarCodeCache)
+}
+
 if (window.location.protocol === 'chrome-devtools:') {
   // Override some inspector APIs.
   require('@electron/internal/renderer/inspector')
@@ -0,0 +1,42 @@
+'use strict'
+
+// The messages of the channels batched with ipcRenderer.setBatching. Every
+// other message sent by the renderer flushes them first, so the main process
+// receives all the messages in the order they were sent.
+
+const binding = process.atomBinding('ipc')
+
+// Messages waiting to be sent, grouped by channel.
+let pendingBatches = null
+const scheduledFlushes = new Set()
+
+const flush = function () {
+  scheduledFlushes.clear()
+  if (!pendingBatches) return
+  const batches = Array.from(pendingBatches)
+  pendingBatches = null
+  binding.send('ipc-message-batch', batches)
+}
+
+const scheduleFlush = function (mode) {
+  if (scheduledFlushes.has(mode)) return
+  scheduledFlushes.add(mode)
+  if (mode === 'animationFrame' && typeof requestAnimationFrame === 'function') {
+    requestAnimationFrame(flush)
+  } else {
+    Promise.resolve().then(flush)
+  }
+}
+
+exports.flush = flush
+
+exports.queue = function (mode, channel, message) {
+  if (!pendingBatches) pendingBatches = new Map()
+  const batch = pendingBatches.get(channel)
+  if (batch) {
+    batch.push(message)
+  } else {
+    pendingBatches.set(channel, [message])
+  }
+  scheduleFlush(mode)
+}
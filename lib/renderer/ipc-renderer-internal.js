@@ -2,24 +2,29 @@
 
 const binding = process.atomBinding('ipc')
 const v8Util = process.atomBinding('v8_util')
+const ipcBatching = require('@electron/internal/renderer/ipc-batching')
 
 // Created by init.js.
 const ipcRenderer = v8Util.getHiddenValue(global, 'ipc-internal')
 const internal = true
 
 ipcRenderer.send = function (...args) {
+  ipcBatching.flush()
   return binding.send('ipc-internal-message', args)
 }
 
 ipcRenderer.sendSync = function (...args) {
+  ipcBatching.flush()
   return binding.sendSync('ipc-internal-message-sync', args)[0]
 }
 
 ipcRenderer.sendTo = function (webContentsId, channel, ...args) {
+  ipcBatching.flush()
   return binding.sendTo(internal, false, webContentsId, channel, args)
 }
 
 ipcRenderer.sendToAll = function (webContentsId, channel, ...args) {
+  ipcBatching.flush()
   return binding.sendTo(internal, true, webContentsId, channel, args)
 }
 
@@ -1,9 +1,16 @@
 'use strict'
 
 const ipcRenderer = require('@electron/internal/renderer/ipc-renderer-internal')
+const { openPort } = require('@electron/internal/renderer/api/ipc-renderer')
+const { isSameOrigin } = process.atomBinding('v8_util')
 
 const { guestInstanceId, openerId } = process
 const hiddenPage = process.argv.includes('--hidden-page')
 const usesNativeWindowOpen = process.argv.includes('--native-window-open')
 
-require('@electron/internal/renderer/window-setup')(ipcRenderer, guestInstanceId, openerId, hiddenPage, usesNativeWindowOpen)
+require('@electron/internal/renderer/window-setup')(ipcRenderer, guestInstanceId, openerId, hiddenPage, usesNativeWindowOpen, openPort, isSameOrigin)
+
+const gpuPreference = process.argv.find((arg) => arg.startsWith('--gpu-preference='))
+if (gpuPreference) {
+  require('@electron/internal/renderer/webgl-power-preference')(gpuPreference.substr(gpuPreference.indexOf('=') + 1))
+}
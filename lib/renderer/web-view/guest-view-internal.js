@@ -92,6 +92,15 @@ module.exports = {
     ipcRenderer.send('ELECTRON_GUEST_VIEW_MANAGER_CREATE_GUEST', params, requestId)
     ipcRenderer.once(`ELECTRON_RESPONSE_${requestId}`, callback)
   },
+  createAndAttachGuest: function (elementInstanceId, params, contentWindow, callback) {
+    const embedderFrameId = webFrame.getWebFrameId(contentWindow)
+    if (embedderFrameId < 0) { // this error should not happen.
+      throw new Error('Invalid embedder frame')
+    }
+    requestId++
+    ipcRenderer.send('ELECTRON_GUEST_VIEW_MANAGER_CREATE_AND_ATTACH_GUEST', embedderFrameId, elementInstanceId, params, requestId)
+    ipcRenderer.once(`ELECTRON_RESPONSE_${requestId}`, callback)
+  },
   createGuestSync: function (params) {
     return ipcRenderer.sendSync('ELECTRON_GUEST_VIEW_MANAGER_CREATE_GUEST_SYNC', params)
   },
@@ -107,8 +107,16 @@ class WebViewImpl {
   }
 
   createGuest () {
-    return guestViewInternal.createGuest(this.buildParams(), (event, guestInstanceId) => {
-      this.attachGuestInstance(guestInstanceId)
+    const internalInstanceId = getNextId()
+    this.internalInstanceId = internalInstanceId
+    guestViewInternal.createAndAttachGuest(internalInstanceId, this.buildParams(), this.internalElement.contentWindow, (event, guestInstanceId) => {
+      if (!this.elementAttached || this.internalInstanceId !== internalInstanceId) {
+        // The element was detached or reattached before the guest arrived.
+        guestViewInternal.destroyGuest(guestInstanceId)
+        return
+      }
+      this.guestInstanceId = guestInstanceId
+      this.observeElementResize()
     })
   }
 
@@ -188,6 +196,10 @@ class WebViewImpl {
     this.internalInstanceId = getNextId()
     this.guestInstanceId = guestInstanceId
     guestViewInternal.attachGuest(this.internalInstanceId, this.guestInstanceId, this.buildParams(), this.internalElement.contentWindow)
+    this.observeElementResize()
+  }
+
+  observeElementResize () {
     // ResizeObserver is a browser global not recognized by "standard".
     /* globals ResizeObserver */
     // TODO(zcbenz): Should we deprecate the "resize" event? Wait, it is not
@@ -0,0 +1,34 @@
+'use strict'
+
+// Makes |powerPreference| the default powerPreference of the WebGL contexts
+// created by the page, the GPU process picks the GPU of each context from it
+// on macOS.
+// Runs in the main world before the page, so the functions used by the
+// wrapper are kept here and the page can not change what it calls.
+module.exports = function (powerPreference) {
+  const { apply, defineProperty, getOwnPropertyDescriptor } = Reflect
+  const { assign } = Object
+
+  const wrap = (constructor) => {
+    if (typeof constructor !== 'function') return
+    const descriptor = getOwnPropertyDescriptor(constructor.prototype, 'getContext')
+    if (!descriptor || typeof descriptor.value !== 'function') return
+
+    const getContext = descriptor.value
+    // A method has no prototype and keeps the name of the original.
+    const wrapper = {
+      getContext (type, attributes) {
+        if ((type === 'webgl' || type === 'webgl2' || type === 'experimental-webgl') &&
+            (attributes == null || attributes.powerPreference == null)) {
+          return apply(getContext, this, [type, assign({}, attributes, { powerPreference })])
+        }
+        return apply(getContext, this, arguments)
+      }
+    }
+    descriptor.value = wrapper.getContext
+    defineProperty(constructor.prototype, 'getContext', descriptor)
+  }
+
+  wrap(window.HTMLCanvasElement)
+  wrap(window.OffscreenCanvas)
+}
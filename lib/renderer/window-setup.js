@@ -41,6 +41,11 @@ const toString = (value) => {
 
 const windowProxies = {}
 
+// Opens a message pipe to another webContents, unavailable in the isolated
+// context where postMessage is relayed by the main process instead.
+let openPort = null
+let isSameOrigin = null
+
 const getOrCreateProxy = (ipcRenderer, guestId) => {
   let proxy = windowProxies[guestId]
   if (proxy == null) {
@@ -50,6 +55,35 @@ const getOrCreateProxy = (ipcRenderer, guestId) => {
   return proxy
 }
 
+const dispatchMessage = (ipcRenderer, sourceId, message, sourceOrigin) => {
+  // Manually dispatch event instead of using postMessage because we also need to
+  // set event.source.
+  const event = document.createEvent('Event')
+  event.initEvent('message', false, false)
+  event.data = message
+  event.origin = sourceOrigin
+  event.source = getOrCreateProxy(ipcRenderer, sourceId)
+  window.dispatchEvent(event)
+}
+
+const isTargetOrigin = (targetOrigin) => {
+  return targetOrigin == null || targetOrigin === '*' ||
+         isSameOrigin(window.location.href, targetOrigin)
+}
+
+// Messages of a proxy go through a message port shared with the other window,
+// so they are structured-cloned and never reach the main process.
+const attachPort = (ipcRenderer, proxy, guestId, port) => {
+  port.onmessage = ({ data }) => {
+    // The W3C does not seem to have word on how postMessage should work when
+    // the origins do not match, the receiver checks the target origin itself.
+    if (isTargetOrigin(data.targetOrigin)) {
+      dispatchMessage(ipcRenderer, guestId, data.message, data.sourceOrigin)
+    }
+  }
+  proxy._port = port
+}
+
 const removeProxy = (guestId) => {
   delete windowProxies[guestId]
 }
@@ -70,6 +104,7 @@ function BrowserWindowProxy (ipcRenderer, guestId) {
   ipcRenderer.once(`ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_CLOSED_${guestId}`, () => {
     removeProxy(guestId)
     this.closed = true
+    if (this._port) this._port.close()
   })
 
   this.close = () => {
@@ -88,8 +123,73 @@ function BrowserWindowProxy (ipcRenderer, guestId) {
     ipcRenderer.send('ELECTRON_GUEST_WINDOW_MANAGER_WEB_CONTENTS_METHOD', guestId, 'print')
   }
 
+  // Both windows would open a port if they posted at the same time, so only
+  // the window with the lower id, normally the opener, opens it. The other one
+  // asks it to and only accepts ports. The messages posted before the port is
+  // connected wait in |pendingMessages|.
+  let pendingMessages = null
+  let portRole = null
+  let openingPort = false
+
+  const getPortRole = () => {
+    if (portRole == null) {
+      portRole = openPort != null ? ipcRenderer.sendSync('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_GET_PORT_ROLE', guestId) : 'relay'
+    }
+    return portRole
+  }
+
+  const relayMessage = ({ message, targetOrigin, sourceOrigin }) => {
+    ipcRenderer.send('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_POSTMESSAGE', guestId, message, targetOrigin, sourceOrigin)
+  }
+
+  const flushPendingMessages = () => {
+    if (pendingMessages == null) return
+    if (this._port) {
+      for (const pending of pendingMessages) this._port.postMessage(pending)
+    } else {
+      pendingMessages.forEach(relayMessage)
+    }
+    pendingMessages = null
+  }
+
+  this._openPort = () => {
+    if (this._port || openingPort || getPortRole() !== 'open') return
+    openingPort = true
+    openPort(guestId, 'ELECTRON_GUEST_WINDOW_PORT').then((port) => {
+      openingPort = false
+      attachPort(ipcRenderer, this, guestId, port)
+      flushPendingMessages()
+    }, () => {
+      openingPort = false
+      portRole = 'relay'
+      flushPendingMessages()
+    })
+  }
+
+  this._acceptPort = (port) => {
+    if (this._port || getPortRole() !== 'accept') {
+      port.close()
+      return
+    }
+    attachPort(ipcRenderer, this, guestId, port)
+    flushPendingMessages()
+  }
+
   this.postMessage = (message, targetOrigin) => {
-    ipcRenderer.send('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_POSTMESSAGE', guestId, message, toString(targetOrigin), window.location.origin)
+    const data = { message, targetOrigin: toString(targetOrigin), sourceOrigin: window.location.origin }
+    if (this._port) {
+      this._port.postMessage(data)
+    } else if (pendingMessages) {
+      pendingMessages.push(data)
+    } else if (getPortRole() === 'open') {
+      pendingMessages = [data]
+      this._openPort()
+    } else if (getPortRole() === 'accept' &&
+               ipcRenderer.sendSync('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_REQUEST_PORT', guestId)) {
+      pendingMessages = [data]
+    } else {
+      relayMessage(data)
+    }
   }
 
   this.eval = (...args) => {
@@ -106,7 +206,12 @@ const getHistoryOperation = function (ipcRenderer, ...args) {
   return ipcRenderer.sendSync('ELECTRON_SYNC_NAVIGATION_CONTROLLER', ...args)
 }
 
-module.exports = (ipcRenderer, guestInstanceId, openerId, hiddenPage, usesNativeWindowOpen) => {
+module.exports = (ipcRenderer, guestInstanceId, openerId, hiddenPage, usesNativeWindowOpen, openPortFn, isSameOriginFn) => {
+  if (openPortFn && isSameOriginFn) {
+    openPort = openPortFn
+    isSameOrigin = isSameOriginFn
+  }
+
   if (guestInstanceId == null) {
     // Override default window.close.
     window.close = function () {
@@ -139,14 +244,18 @@ module.exports = (ipcRenderer, guestInstanceId, openerId, hiddenPage, usesNative
   }
 
   ipcRenderer.on('ELECTRON_GUEST_WINDOW_POSTMESSAGE', function (event, sourceId, message, sourceOrigin) {
-    // Manually dispatch event instead of using postMessage because we also need to
-    // set event.source.
-    event = document.createEvent('Event')
-    event.initEvent('message', false, false)
-    event.data = message
-    event.origin = sourceOrigin
-    event.source = getOrCreateProxy(ipcRenderer, sourceId)
-    window.dispatchEvent(event)
+    dispatchMessage(ipcRenderer, sourceId, message, sourceOrigin)
+  })
+
+  // The port opened by the other window, answers use the same one.
+  ipcRenderer.on('ELECTRON_GUEST_WINDOW_PORT', function (event) {
+    const [port] = event.ports
+    getOrCreateProxy(ipcRenderer, event.senderId)._acceptPort(port)
+  })
+
+  // The other window posted first and can not open the port itself.
+  ipcRenderer.on('ELECTRON_GUEST_WINDOW_PORT_REQUEST', function (event, sourceId) {
+    if (openPort != null) getOrCreateProxy(ipcRenderer, sourceId)._openPort()
   })
 
   window.history.back = function () {
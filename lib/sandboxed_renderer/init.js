@@ -63,7 +63,7 @@ ipcNative.onExit = function () {
 }
 
 const {
-  preloadSrc, preloadError, isRemoteModuleEnabled, process: processProps
+  preloadSrc, preloadCacheKey, preloadError, isRemoteModuleEnabled, process: processProps
 } = ipcRenderer.sendSync('ELECTRON_BROWSER_SANDBOX_LOAD')
 
 const makePropertyNonConfigurable = function (object, name) {
@@ -142,8 +142,9 @@ if (preloadSrc) {
   ${preloadSrc}
   })`
 
-  // eval in window scope
-  const preloadFn = binding.createPreloadScript(preloadWrapperSrc)
+  // eval in window scope, the code cache of the script is kept by the process
+  // for the frames that load it later
+  const preloadFn = binding.createPreloadScript(preloadWrapperSrc, preloadCacheKey)
   const { setImmediate, clearImmediate } = require('timers')
   preloadFn(preloadRequire, preloadProcess, Buffer, global, setImmediate, clearImmediate)
 } else if (preloadError) {
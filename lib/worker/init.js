@@ -7,6 +7,9 @@ const Module = require('module')
 // init.js, we need to restore it here.
 process.argv.splice(1, 1)
 
+// Compile the rest of Electron's modules with their code cache.
+require('../common/code-cache').install()
+
 // Clear search paths.
 require('../common/reset-search-paths')
 
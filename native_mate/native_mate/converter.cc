@@ -4,6 +4,10 @@
 
 #include "native_mate/converter.h"
 
+#include <utility>
+
+#include "base/macros.h"
+#include "base/strings/string_util.h"
 #include "v8/include/v8.h"
 
 using v8::Array;
@@ -21,6 +25,57 @@ using v8::Value;
 
 namespace mate {
 
+namespace {
+
+// Owns the characters of an external string and tells V8 about the memory,
+// so the GC still feels the pressure of large strings.
+class ExternalOneByteString : public String::ExternalOneByteStringResource {
+ public:
+  ExternalOneByteString(Isolate* isolate, std::string&& str)
+      : isolate_(isolate), str_(std::move(str)) {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(str_.size());
+  }
+  ~ExternalOneByteString() override {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(
+        -static_cast<int64_t>(str_.size()));
+  }
+
+  const char* data() const override { return str_.data(); }
+  size_t length() const override { return str_.size(); }
+
+ private:
+  Isolate* isolate_;
+  std::string str_;
+
+  DISALLOW_COPY_AND_ASSIGN(ExternalOneByteString);
+};
+
+class ExternalTwoByteString : public String::ExternalStringResource {
+ public:
+  ExternalTwoByteString(Isolate* isolate, base::string16&& str)
+      : isolate_(isolate), str_(std::move(str)) {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(Size());
+  }
+  ~ExternalTwoByteString() override {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(-Size());
+  }
+
+  const uint16_t* data() const override {
+    return reinterpret_cast<const uint16_t*>(str_.data());
+  }
+  size_t length() const override { return str_.size(); }
+
+ private:
+  int64_t Size() const { return str_.size() * sizeof(base::char16); }
+
+  Isolate* isolate_;
+  base::string16 str_;
+
+  DISALLOW_COPY_AND_ASSIGN(ExternalTwoByteString);
+};
+
+}  // namespace
+
 Local<Value> Converter<bool>::ToV8(Isolate* isolate, bool val) {
   return v8::Boolean::New(isolate, val);
 }
@@ -138,6 +193,12 @@ Local<Value> Converter<base::StringPiece>::ToV8(Isolate* isolate,
 
 Local<Value> Converter<std::string>::ToV8(Isolate* isolate,
                                           const std::string& val) {
+  Local<String> external;
+  if (val.size() >= kExternalStringMinLength && base::IsStringASCII(val) &&
+      String::NewExternalOneByte(
+          isolate, new ExternalOneByteString(isolate, std::string(val)))
+          .ToLocal(&external))
+    return external;
   return Converter<base::StringPiece>::ToV8(isolate, val);
 }
 
@@ -147,6 +208,19 @@ bool Converter<std::string>::FromV8(Isolate* isolate,
   if (!val->IsString())
     return false;
   Local<String> str = Local<String>::Cast(val);
+  // ASCII external strings are already in UTF-8.
+  String::Encoding encoding;
+  const String::ExternalStringResourceBase* resource =
+      str->GetExternalStringResourceBase(&encoding);
+  if (resource && encoding == String::ONE_BYTE_ENCODING) {
+    const auto* one_byte =
+        static_cast<const String::ExternalOneByteStringResource*>(resource);
+    base::StringPiece data(one_byte->data(), one_byte->length());
+    if (base::IsStringASCII(data)) {
+      data.CopyToString(out);
+      return true;
+    }
+  }
   int length = str->Utf8Length();
   out->resize(length);
   str->WriteUtf8(&(*out)[0], length, NULL, String::NO_NULL_TERMINATION);
@@ -245,6 +319,32 @@ v8::Local<v8::String> StringToSymbol(v8::Isolate* isolate,
                                  static_cast<uint32_t>(val.length()));
 }
 
+v8::MaybeLocal<v8::String> NewExternalString(v8::Isolate* isolate,
+                                             std::string&& str) {
+  if (str.size() < kExternalStringMinLength || !base::IsStringASCII(str))
+    return v8::MaybeLocal<v8::String>();
+  return String::NewExternalOneByte(
+      isolate, new ExternalOneByteString(isolate, std::move(str)));
+}
+
+v8::MaybeLocal<v8::String> NewExternalString(v8::Isolate* isolate,
+                                             base::string16&& str) {
+  if (str.size() < kExternalStringMinLength)
+    return v8::MaybeLocal<v8::String>();
+  return String::NewExternalTwoByte(
+      isolate, new ExternalTwoByteString(isolate, std::move(str)));
+}
+
+const v8::String::ExternalStringResource* GetExternalTwoByteResource(
+    v8::Local<v8::String> str) {
+  String::Encoding encoding;
+  const String::ExternalStringResourceBase* resource =
+      str->GetExternalStringResourceBase(&encoding);
+  if (!resource || encoding != String::TWO_BYTE_ENCODING)
+    return nullptr;
+  return static_cast<const String::ExternalStringResource*>(resource);
+}
+
 std::string V8ToString(v8::Local<v8::Value> value) {
   if (value.IsEmpty())
     return std::string();
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/strings/string16.h"
 #include "base/strings/string_piece.h"
 #include "v8/include/v8.h"
 
@@ -136,6 +137,22 @@ struct Converter<std::string> {
 v8::Local<v8::String> StringToSymbol(v8::Isolate* isolate,
                                      const base::StringPiece& input);
 
+// Strings shorter than this are cheaper to copy into the V8 heap.
+constexpr size_t kExternalStringMinLength = 64 * 1024;
+
+// Returns a string that keeps the characters of |str| outside of the V8
+// heap, which saves V8 from copying and collecting large strings. Returns an
+// empty handle and leaves |str| untouched if it is shorter than
+// kExternalStringMinLength, or for |std::string| when it is not ASCII.
+v8::MaybeLocal<v8::String> NewExternalString(v8::Isolate* isolate,
+                                             std::string&& str);
+v8::MaybeLocal<v8::String> NewExternalString(v8::Isolate* isolate,
+                                             base::string16&& str);
+
+// Returns the characters of |str| if it is a two-byte external string.
+const v8::String::ExternalStringResource* GetExternalTwoByteResource(
+    v8::Local<v8::String> str);
+
 std::string V8ToString(v8::Local<v8::Value> value);
 
 template <>
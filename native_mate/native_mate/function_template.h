@@ -5,6 +5,10 @@
 #ifndef NATIVE_MATE_FUNCTION_TEMPLATE_H_
 #define NATIVE_MATE_FUNCTION_TEMPLATE_H_
 
+#include <string>
+#include <tuple>
+#include <type_traits>
+
 #include "base/callback.h"
 #include "base/logging.h"
 #include "native_mate/arguments.h"
@@ -240,6 +244,174 @@ struct Dispatcher<ReturnType(ArgTypes...)> {
   }
 };
 
+// Fast methods are member functions that take and return primitives. They are
+// called without base::Callback, mate::Arguments or a MicrotasksScope, and
+// their arguments and results are converted without allocating.
+
+template <typename T>
+struct FastArgument {
+  static_assert(sizeof(T) == 0, "fast methods only take bool and numbers");
+};
+template <>
+struct FastArgument<bool> {
+  static bool Get(v8::Local<v8::Value> val, bool* out) {
+    if (!val->IsBoolean())
+      return false;
+    *out = val->IsTrue();
+    return true;
+  }
+};
+template <>
+struct FastArgument<int32_t> {
+  static bool Get(v8::Local<v8::Value> val, int32_t* out) {
+    if (!val->IsInt32())
+      return false;
+    *out = val.As<v8::Int32>()->Value();
+    return true;
+  }
+};
+template <>
+struct FastArgument<uint32_t> {
+  static bool Get(v8::Local<v8::Value> val, uint32_t* out) {
+    if (!val->IsUint32())
+      return false;
+    *out = val.As<v8::Uint32>()->Value();
+    return true;
+  }
+};
+template <>
+struct FastArgument<double> {
+  static bool Get(v8::Local<v8::Value> val, double* out) {
+    if (!val->IsNumber())
+      return false;
+    *out = val.As<v8::Number>()->Value();
+    return true;
+  }
+};
+
+// Primitives are stored in the return value directly, other types go through
+// their converter.
+template <typename T>
+void SetFastReturnValue(const v8::FunctionCallbackInfo<v8::Value>& info,
+                        const T& value) {
+  info.GetReturnValue().Set(ConvertToV8(info.GetIsolate(), value));
+}
+inline void SetFastReturnValue(const v8::FunctionCallbackInfo<v8::Value>& info,
+                               bool value) {
+  info.GetReturnValue().Set(value);
+}
+inline void SetFastReturnValue(const v8::FunctionCallbackInfo<v8::Value>& info,
+                               int32_t value) {
+  info.GetReturnValue().Set(value);
+}
+inline void SetFastReturnValue(const v8::FunctionCallbackInfo<v8::Value>& info,
+                               uint32_t value) {
+  info.GetReturnValue().Set(value);
+}
+inline void SetFastReturnValue(const v8::FunctionCallbackInfo<v8::Value>& info,
+                               double value) {
+  info.GetReturnValue().Set(value);
+}
+
+template <typename Method>
+struct MethodTraits {};
+template <typename T, typename ReturnType, typename... ArgTypes>
+struct MethodTraits<ReturnType (T::*)(ArgTypes...)> {
+  using Class = T;
+  using Return = ReturnType;
+  using Args = std::tuple<typename std::decay<ArgTypes>::type...>;
+  static constexpr size_t kArity = sizeof...(ArgTypes);
+};
+template <typename T, typename ReturnType, typename... ArgTypes>
+struct MethodTraits<ReturnType (T::*)(ArgTypes...) const>
+    : MethodTraits<ReturnType (T::*)(ArgTypes...)> {};
+
+template <typename Method>
+class FastMethodHolder : public CallbackHolderBase {
+ public:
+  FastMethodHolder(v8::Isolate* isolate, Method method)
+      : CallbackHolderBase(isolate), method(method) {}
+  Method method;
+
+ private:
+  ~FastMethodHolder() override {}
+
+  DISALLOW_COPY_AND_ASSIGN(FastMethodHolder);
+};
+
+template <typename Method>
+struct FastDispatcher {
+  using Traits = MethodTraits<Method>;
+  using Class = typename Traits::Class;
+  using Return = typename Traits::Return;
+  using Args = typename Traits::Args;
+
+  static void DispatchToMethod(
+      const v8::FunctionCallbackInfo<v8::Value>& info) {
+    auto* holder = static_cast<FastMethodHolder<Method>*>(
+        reinterpret_cast<CallbackHolderBase*>(
+            info.Data().As<v8::External>()->Value()));
+
+    v8::Local<v8::Object> receiver = info.Holder();
+    void* pointer = receiver->InternalFieldCount() == 1
+                        ? receiver->GetAlignedPointerFromInternalField(0)
+                        : nullptr;
+    if (!pointer) {
+      Arguments(info).ThrowError("Object has been destroyed");
+      return;
+    }
+    Class* self = static_cast<Class*>(static_cast<WrappableBase*>(pointer));
+
+    using Indices = typename IndicesGenerator<Traits::kArity>::type;
+    Invoke(info, self, holder->method, Indices(),
+           std::is_void<Return>());
+  }
+
+ private:
+  template <size_t... indices>
+  static bool GetArguments(const v8::FunctionCallbackInfo<v8::Value>& info,
+                           Args* args,
+                           IndicesHolder<indices...>) {
+    if (info.Length() < static_cast<int>(Traits::kArity)) {
+      Arguments(info).ThrowTypeError("Insufficient number of arguments.");
+      return false;
+    }
+    bool results[] = {
+        true, FastArgument<typename std::tuple_element<indices, Args>::type>::
+                  Get(info[indices], &std::get<indices>(*args))...};
+    for (size_t i = 1; i < arraysize(results); ++i) {
+      if (!results[i]) {
+        Arguments(info).ThrowTypeError(
+            "Error processing argument at index " + std::to_string(i - 1));
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <size_t... indices>
+  static void Invoke(const v8::FunctionCallbackInfo<v8::Value>& info,
+                     Class* self,
+                     Method method,
+                     IndicesHolder<indices...> indices_holder,
+                     std::false_type) {
+    Args args;
+    if (GetArguments(info, &args, indices_holder))
+      SetFastReturnValue(info, (self->*method)(std::get<indices>(args)...));
+  }
+
+  template <size_t... indices>
+  static void Invoke(const v8::FunctionCallbackInfo<v8::Value>& info,
+                     Class* self,
+                     Method method,
+                     IndicesHolder<indices...> indices_holder,
+                     std::true_type) {
+    Args args;
+    if (GetArguments(info, &args, indices_holder))
+      (self->*method)(std::get<indices>(args)...);
+  }
+};
+
 }  // namespace internal
 
 
@@ -266,6 +438,25 @@ v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
                                              holder->GetHandle(isolate)));
 }
 
+// CreateFastFunctionTemplate creates a v8::FunctionTemplate for a member
+// function of a Wrappable that only takes bool and numbers, and returns a
+// primitive or a type with a converter. The method must not call into
+// JavaScript, since no microtask checkpoint is performed after it.
+template <typename Method>
+v8::Local<v8::FunctionTemplate> CreateFastFunctionTemplate(
+    v8::Isolate* isolate,
+    Method method) {
+  static_assert(std::is_member_function_pointer<Method>::value,
+                "fast methods must be member functions");
+  typedef internal::FastMethodHolder<Method> HolderT;
+  HolderT* holder = new HolderT(isolate, method);
+
+  return v8::FunctionTemplate::New(
+      isolate, &internal::FastDispatcher<Method>::DispatchToMethod,
+      ConvertToV8<v8::Local<v8::External>>(isolate,
+                                           holder->GetHandle(isolate)));
+}
+
 // CreateFunctionHandler installs a CallAsFunction handler on the given
 // object template that forwards to a provided C++ function or base::Callback.
 template<typename Sig>
@@ -6,6 +6,19 @@
 
 namespace mate {
 
+namespace {
+
+// isDestroyed() guards most calls to destroyable objects, so it reads the
+// internal field directly instead of going through a base::Callback.
+void IsDestroyed(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  v8::Local<v8::Object> holder = info.Holder();
+  info.GetReturnValue().Set(
+      holder->InternalFieldCount() == 0 ||
+      holder->GetAlignedPointerFromInternalField(0) == nullptr);
+}
+
+}  // namespace
+
 ObjectTemplateBuilder::ObjectTemplateBuilder(
     v8::Isolate* isolate,
     v8::Local<v8::ObjectTemplate> templ)
@@ -31,7 +44,7 @@ ObjectTemplateBuilder& ObjectTemplateBuilder::SetPropertyImpl(
 
 ObjectTemplateBuilder& ObjectTemplateBuilder::MakeDestroyable() {
   SetMethod("destroy", base::Bind(internal::Destroyable::Destroy));
-  SetMethod("isDestroyed", base::Bind(internal::Destroyable::IsDestroyed));
+  SetImpl("isDestroyed", v8::FunctionTemplate::New(isolate_, &IsDestroyed));
   return *this;
 }
 
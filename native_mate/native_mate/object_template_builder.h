@@ -108,6 +108,21 @@ class ObjectTemplateBuilder {
         CallbackTraits<U>::CreateTemplate(isolate_, setter));
   }
 
+  // Like SetMethod and SetProperty, for member functions that only take bool
+  // and numbers and never call into JavaScript, see
+  // mate::CreateFastFunctionTemplate(). Meant for hot getters.
+  template<typename T>
+  ObjectTemplateBuilder& SetFastMethod(const base::StringPiece& name,
+                                       T method) {
+    return SetImpl(name, CreateFastFunctionTemplate(isolate_, method));
+  }
+  template<typename T>
+  ObjectTemplateBuilder& SetFastProperty(const base::StringPiece& name,
+                                         T getter) {
+    return SetPropertyImpl(name, CreateFastFunctionTemplate(isolate_, getter),
+                           v8::Local<v8::FunctionTemplate>());
+  }
+
   // Add "destroy" and "isDestroyed" methods.
   ObjectTemplateBuilder& MakeDestroyable();
 
@@ -0,0 +1,43 @@
+#!/usr/bin/env node
+
+// Runs the benchmarks in spec/benchmarks, the options are forwarded to the
+// benchmark app:
+//
+//   --suite=<name>          only run the given suite
+//   --max-size=<size>       skip the IPC payloads larger than size bytes
+//   --max-files=<count>     skip the asar archives with more files than count
+//   --max-requests=<count>  skip the pages with more requests than count
+//   --max-height=<pixels>   skip the offscreen frames taller than pixels
+//   --output=<file>         write the JSON results to the file instead of stdout
+
+const childProcess = require('child_process')
+const path = require('path')
+
+const utils = require('./lib/utils')
+
+const BASE = path.resolve(__dirname, '../..')
+
+function main () {
+  let exe = path.resolve(BASE, utils.getElectronExec())
+  let args = [path.resolve(__dirname, '../spec/benchmarks')].concat(process.argv.slice(2))
+  // The benchmarks need a display, which is provided by xvfb on CI.
+  if (process.platform === 'linux' && !process.env.DISPLAY) {
+    args = ['-a', exe].concat(args)
+    exe = 'xvfb-run'
+  }
+
+  const { status } = childProcess.spawnSync(exe, args, {
+    cwd: BASE,
+    stdio: 'inherit'
+  })
+  if (status !== 0) {
+    throw new Error(`Electron benchmarks failed with code ${status}.`)
+  }
+}
+
+try {
+  main()
+} catch (error) {
+  console.error('An error occurred inside the benchmark runner:', error.message)
+  process.exit(1)
+}
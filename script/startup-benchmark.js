@@ -0,0 +1,185 @@
+#!/usr/bin/env node
+
+// Launches an app repeatedly and reports how long its startup phases take, see
+// docs/development/testing.md. The options are:
+//
+//   --app=<path>             the app to launch, "default" for the default app,
+//                            spec/benchmarks/startup/app when not given
+//   --iterations=<count>     the number of cold and of warm launches, 10 when
+//                            not given
+//   --budget=<phase>=<ms>    fail when the phase takes longer in the warm
+//                            launches, can be repeated
+//   --budget-percentile=<p>  the percentile checked against the budgets, 90
+//                            when not given
+//   --output=<file>          write the JSON results to the file instead of
+//                            stdout
+
+const childProcess = require('child_process')
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+
+const { percentile } = require('../spec/benchmarks/measure')
+const utils = require('./lib/utils')
+
+const BASE = path.resolve(__dirname, '../..')
+const STARTUP_DIR = path.resolve(__dirname, '../spec/benchmarks/startup')
+
+// The phases in the order they happen.
+const kPhases = [
+  'mainProcess',
+  'probeLoaded',
+  'ready',
+  'windowCreated',
+  'rendererProcess',
+  'scriptContext',
+  'preloadDone',
+  'domContentLoaded',
+  'readyToShow'
+]
+const kLaunchTimeout = 60 * 1000
+const kMarker = 'STARTUP-BENCHMARK '
+
+const removeDirectory = function (directory) {
+  for (const name of fs.readdirSync(directory)) {
+    const target = path.join(directory, name)
+    if (fs.lstatSync(target).isDirectory()) {
+      removeDirectory(target)
+    } else {
+      fs.unlinkSync(target)
+    }
+  }
+  fs.rmdirSync(directory)
+}
+
+const launch = function (app, userData) {
+  let exe = path.resolve(BASE, utils.getElectronExec())
+  let args = ['--require', path.join(STARTUP_DIR, 'probe.js')]
+  if (app) args.push(app)
+  // The time xvfb-run takes to start is included in the results.
+  if (process.platform === 'linux' && !process.env.DISPLAY) {
+    args = ['-a', exe].concat(args)
+    exe = 'xvfb-run'
+  }
+
+  const env = Object.assign({}, process.env, {
+    ELECTRON_STARTUP_BENCHMARK_USER_DATA: userData,
+    ELECTRON_STARTUP_BENCHMARK_LAUNCH_TIME: String(Date.now())
+  })
+  const { status, stdout, stderr } = childProcess.spawnSync(exe, args, {
+    cwd: BASE,
+    env,
+    encoding: 'utf8',
+    timeout: kLaunchTimeout
+  })
+  const line = stdout.split('\n').find((line) => line.startsWith(kMarker))
+  if (status !== 0 || !line) {
+    throw new Error(`The app did not start (code ${status}):\n${stderr}`)
+  }
+  return JSON.parse(line.substr(kMarker.length))
+}
+
+const phaseValues = function (launches, phase) {
+  return launches.map((timings) => timings[phase])
+    .filter((value) => typeof value === 'number')
+    .sort((a, b) => a - b)
+}
+
+const summarize = function (launches) {
+  const summary = {}
+  for (const phase of kPhases) {
+    const values = phaseValues(launches, phase)
+    if (values.length === 0) continue
+    summary[phase] = {
+      min: values[0],
+      p50: percentile(values, 0.5),
+      p90: percentile(values, 0.9),
+      p99: percentile(values, 0.99),
+      max: values[values.length - 1]
+    }
+  }
+  return summary
+}
+
+// Cold launches get a new user data directory each, so nothing is cached by
+// Chromium. The caches of the operating system are not dropped.
+const run = function (app, iterations) {
+  const cold = []
+  for (let i = 0; i < iterations; i++) {
+    const userData = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-startup-'))
+    try {
+      cold.push(launch(app, userData))
+    } finally {
+      removeDirectory(userData)
+    }
+  }
+
+  const warm = []
+  const userData = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-startup-'))
+  try {
+    launch(app, userData)
+    for (let i = 0; i < iterations; i++) warm.push(launch(app, userData))
+  } finally {
+    removeDirectory(userData)
+  }
+  return { cold, warm }
+}
+
+// Returns the budgets that the warm launches exceed.
+const checkBudgets = function (launches, budgets, p) {
+  const failures = []
+  for (const budget of budgets) {
+    const [phase, limit] = budget.split('=')
+    if (!kPhases.includes(phase) || isNaN(Number(limit))) {
+      throw new Error(`Invalid budget ${budget}, expected <phase>=<ms>`)
+    }
+    const values = phaseValues(launches, phase)
+    if (values.length === 0) {
+      failures.push(`${phase}: the phase was not reached`)
+    } else if (percentile(values, p / 100) > Number(limit)) {
+      failures.push(`${phase}: p${p} is ${percentile(values, p / 100)} ms, the budget is ${limit} ms`)
+    }
+  }
+  return failures
+}
+
+function main () {
+  const argv = require('minimist')(process.argv.slice(2), { string: ['budget', 'app'] })
+  let app = argv.app || path.join(STARTUP_DIR, 'app')
+  if (app === 'default') app = null
+  const iterations = Number(argv.iterations) || 10
+  const p = Number(argv['budget-percentile']) || 90
+  const budgets = [].concat(argv.budget || [])
+
+  const { cold, warm } = run(app, iterations)
+  const results = {
+    version: require('../package.json').version,
+    platform: process.platform,
+    arch: process.arch,
+    date: new Date().toISOString(),
+    app: app || 'default',
+    iterations,
+    cold: summarize(cold),
+    warm: summarize(warm),
+    launches: { cold, warm }
+  }
+
+  const output = JSON.stringify(results, null, 2)
+  if (argv.output) {
+    fs.writeFileSync(argv.output, output)
+  } else {
+    console.log(output)
+  }
+
+  const failures = checkBudgets(warm, budgets, p)
+  if (failures.length > 0) {
+    throw new Error(`The startup is over budget:\n${failures.join('\n')}`)
+  }
+}
+
+try {
+  main()
+} catch (error) {
+  console.error('An error occurred inside the startup benchmark:', error.message)
+  process.exit(1)
+}
@@ -266,6 +266,27 @@ describe('app module', () => {
       const appPath = path.join(__dirname, 'fixtures', 'api', 'relaunch')
       ChildProcess.spawn(remote.process.execPath, [appPath])
     })
+
+    it('relaunches the app without waiting for it to exit', function (done) {
+      this.timeout(120000)
+
+      let state = 'none'
+      server.once('error', error => done(error))
+      server.on('connection', client => {
+        client.once('data', data => {
+          if (String(data) === 'first' && state === 'none') {
+            state = 'first-launch'
+          } else if (String(data) === 'locked' && state === 'first-launch') {
+            done()
+          } else {
+            done(`Unexpected state: ${state}, ${data}`)
+          }
+        })
+      })
+
+      const appPath = path.join(__dirname, 'fixtures', 'api', 'relaunch-parallel')
+      ChildProcess.spawn(remote.process.execPath, [appPath])
+    })
   })
 
   describe('app.setUserActivity(type, userInfo)', () => {
@@ -777,6 +798,15 @@ describe('app module', () => {
       })
     })
 
+    it('fetches the icons of several paths', done => {
+      app.getFileIcons([iconPath, iconPath], (icons) => {
+        expect(icons).to.have.lengthOf(2)
+        expect(icons[0].isEmpty()).to.be.false()
+        expect(icons[1].isEmpty()).to.be.false()
+        done()
+      })
+    })
+
     it('fetches normal icon size by default', done => {
       app.getFileIcon(iconPath, (err, icon) => {
         const size = icon.getSize()
@@ -850,6 +880,234 @@ describe('app module', () => {
       expect(types).to.include('Browser')
       expect(types).to.include('Tab')
     })
+
+    it('samples the cpu usage at the given interval', async () => {
+      app.setAppMetricsInterval(50)
+      try {
+        app.getAppMetrics()
+        await new Promise(resolve => setTimeout(resolve, 100))
+        // Keep the main process busy, the next sample measures the time spent.
+        const crypto = remote.require('crypto')
+        const start = Date.now()
+        while (Date.now() - start < 300) {
+          crypto.pbkdf2Sync('password', 'salt', 10000, 64, 'sha512')
+        }
+        await new Promise(resolve => setTimeout(resolve, 200))
+        const browser = app.getAppMetrics().find(metric => metric.type === 'Browser')
+        expect(browser.cpu.percentCPUUsage).to.be.a('number').that.is.above(0)
+      } finally {
+        app.setAppMetricsInterval(1000)
+      }
+    })
+
+    it('throws when the interval is not a number', () => {
+      expect(() => app.setAppMetricsInterval(NaN)).to.throw(/must be a number/)
+    })
+  })
+
+  describe('getAppMemoryMetrics() API', () => {
+    it('returns the memory of the browser process', async () => {
+      const metrics = await app.getAppMemoryMetrics()
+      expect(metrics).to.be.an('array').and.have.lengthOf.at.least(1)
+
+      const browser = metrics.find(metric => metric.type === 'Browser')
+      expect(browser).to.be.an('object')
+      expect(browser.pid).to.equal(remote.process.pid)
+      expect(browser.memory.workingSetSize).to.be.above(0)
+      expect(browser.jsHeap.used).to.be.above(0)
+      expect(browser.jsHeap.total).to.be.at.least(browser.jsHeap.used)
+    })
+  })
+
+  describe('getMainThreadTaskStats() API', () => {
+    it('returns histograms of the tasks and uv runs', () => {
+      const { tasks, uvRuns } = app.getMainThreadTaskStats()
+      for (const histogram of [tasks, uvRuns]) {
+        expect(histogram.buckets).to.have.lengthOf(12)
+        const count = histogram.buckets.reduce((sum, bucket) => sum + bucket)
+        expect(count).to.equal(histogram.count)
+      }
+      expect(tasks.count).to.be.above(0)
+    })
+  })
+
+  describe('setLongTaskThreshold() API', () => {
+    afterEach(() => {
+      app.setLongTaskThreshold(0)
+    })
+
+    it('emits long-task for the tasks over the threshold', async () => {
+      app.setLongTaskThreshold(20)
+      const longTask = emittedOnce(app, 'long-task')
+      // Blocks the main process while a child process runs.
+      remote.require('child_process').execFileSync(remote.process.execPath, ['-v'], {
+        env: { ELECTRON_RUN_AS_NODE: '1' }
+      })
+      const [, details] = await longTask
+      expect(details.duration).to.be.at.least(20)
+      expect(details.postedFrom.fileName).to.be.a('string')
+    })
+  })
+
+  describe('setMainProcessHeapOptions() API', () => {
+    it('throws when called after app is ready', () => {
+      expect(() => {
+        app.setMainProcessHeapOptions({ maxOldSpaceSize: 4096 })
+      }).to.throw(/before app is ready/)
+    })
+  })
+
+  describe('notifyMemoryPressure() API', () => {
+    it('accepts the memory pressure levels', () => {
+      for (const level of ['critical', 'moderate', 'none']) {
+        expect(() => app.notifyMemoryPressure(level)).to.not.throw()
+      }
+    })
+
+    it('throws for unknown levels', () => {
+      expect(() => app.notifyMemoryPressure('high')).to.throw(/Invalid memory pressure level/)
+    })
+  })
+
+  describe('simulateMemoryPressure() API', () => {
+    it('emits memory-pressure with the level', async () => {
+      const memoryPressure = emittedOnce(app, 'memory-pressure')
+      app.simulateMemoryPressure('critical')
+      const [, level] = await memoryPressure
+      expect(level).to.equal('critical')
+    })
+
+    it('throws for unknown levels', () => {
+      expect(() => app.simulateMemoryPressure('none')).to.throw(/Invalid memory pressure level/)
+    })
+  })
+
+  describe('requestIdleCallback() API', () => {
+    it('calls the callback with a deadline', (done) => {
+      app.requestIdleCallback((deadline) => {
+        expect(deadline.didTimeout).to.be.a('boolean')
+        expect(deadline.timeRemaining()).to.be.at.least(0)
+        done()
+      }, { timeout: 1000 })
+    })
+
+    it('does not call cancelled callbacks', (done) => {
+      const id = app.requestIdleCallback(() => {
+        done(new Error('cancelled callback was called'))
+      })
+      app.cancelIdleCallback(id)
+      app.requestIdleCallback(() => done())
+    })
+
+    it('throws for invalid arguments', () => {
+      expect(() => app.requestIdleCallback()).to.throw(/Missing required callback function/)
+      expect(() => app.requestIdleCallback(() => {}, { timeout: -1 })).to.throw(/non-negative number/)
+    })
+  })
+
+  describe('getMicrotaskCheckpointStats() API', () => {
+    it('counts the checkpoints run after the tasks', async () => {
+      const before = app.getMicrotaskCheckpointStats()
+      expect(before.checkpoints).to.be.a('number')
+      expect(before.skipped).to.be.a('number')
+
+      await new Promise(resolve => setTimeout(resolve, 10))
+      const after = app.getMicrotaskCheckpointStats()
+      expect(after.checkpoints).to.be.above(before.checkpoints)
+      expect(after.skipped).to.be.at.least(before.skipped)
+    })
+  })
+
+  describe('getStartupTimeline() API', () => {
+    it('returns the startup phases in the order they were reached', () => {
+      const timeline = app.getStartupTimeline()
+      const names = timeline.map(mark => mark.name)
+      expect(names).to.include.members(['preMainMessageLoopRun', 'ready'])
+      expect(names.indexOf('preMainMessageLoopRun')).to.be.below(names.indexOf('ready'))
+
+      let previous = -Infinity
+      for (const { time } of timeline) {
+        expect(time).to.be.a('number').that.is.at.least(previous)
+        previous = time
+      }
+    })
+  })
+
+  describe('setSpareRendererCount() API', () => {
+    let w = null
+
+    afterEach(() => {
+      app.setSpareRendererCount(0)
+      return closeWindow(w).then(() => { w = null })
+    })
+
+    it('sets and gets the count', () => {
+      expect(app.getSpareRendererCount()).to.equal(0)
+      app.setSpareRendererCount(2)
+      expect(app.getSpareRendererCount()).to.equal(2)
+    })
+
+    it('throws for a negative count', () => {
+      expect(() => app.setSpareRendererCount(-1)).to.throw(/negative/)
+    })
+
+    it('loads pages in windows that use spares', async function () {
+      this.timeout(20000)
+      app.setSpareRendererCount(1)
+      const fixture = path.join(__dirname, 'fixtures', 'pages', 'base-page.html')
+      for (let i = 0; i < 2; i++) {
+        await closeWindow(w)
+        w = new BrowserWindow({ show: false })
+        w.loadURL(`file://${fixture}`)
+        await emittedOnce(w.webContents, 'did-finish-load')
+        // Wait for a spare of the same kind to be launched.
+        await new Promise(resolve => setTimeout(resolve, 3000))
+      }
+      const result = await new Promise(resolve => {
+        w.webContents.executeJavaScript('typeof require', resolve)
+      })
+      expect(result).to.equal('function')
+    })
+  })
+
+  describe('setRendererProcessReusePolicy() API', () => {
+    let w1 = null
+    let w2 = null
+
+    afterEach(async () => {
+      app.setRendererProcessReusePolicy({ shareProcesses: false, maxProcesses: 0 })
+      await closeWindow(w1)
+      await closeWindow(w2)
+      w1 = w2 = null
+    })
+
+    it('sets and gets the policy', () => {
+      expect(app.getRendererProcessReusePolicy()).to.deep.equal({
+        shareProcesses: false, maxProcesses: 0
+      })
+      app.setRendererProcessReusePolicy({ maxProcesses: 4 })
+      expect(app.getRendererProcessReusePolicy()).to.deep.equal({
+        shareProcesses: false, maxProcesses: 4
+      })
+    })
+
+    it('throws for a negative maximum', () => {
+      expect(() => {
+        app.setRendererProcessReusePolicy({ maxProcesses: -1 })
+      }).to.throw(/negative/)
+    })
+
+    it('shares the process of windows with the same preferences', async () => {
+      app.setRendererProcessReusePolicy({ shareProcesses: true })
+      const fixture = path.join(__dirname, 'fixtures', 'pages', 'base-page.html')
+      w1 = new BrowserWindow({ show: false })
+      w1.loadURL(`file://${fixture}`)
+      await emittedOnce(w1.webContents, 'did-finish-load')
+      w2 = new BrowserWindow({ show: false })
+      w2.loadURL(`file://${fixture}`)
+      await emittedOnce(w2.webContents, 'did-finish-load')
+      expect(w2.webContents.getOSProcessId()).to.equal(w1.webContents.getOSProcessId())
+    })
   })
 
   describe('getGPUFeatureStatus() API', () => {
@@ -917,6 +1175,21 @@ describe('app module', () => {
       }
     })
 
+    it('emits gpu-info-update only when the complete info changes', async () => {
+      const fixture = path.join(__dirname, 'fixtures', 'api', 'gpu-info-update.js')
+      const appProcess = ChildProcess.spawn(remote.process.execPath, [fixture])
+      let output = ''
+      appProcess.stdout.on('data', (data) => { output += data })
+      const [exitCode] = await emittedOnce(appProcess, 'exit')
+      expect(exitCode).to.equal(0)
+
+      const updates = JSON.parse(output)
+      expect(updates).to.have.lengthOf.at.least(1)
+      for (let i = 1; i < updates.length; i++) {
+        expect(updates[i]).to.not.deep.equal(updates[i - 1])
+      }
+    })
+
     it('fails for invalid info_type', () => {
       const invalidType = 'invalid'
       const expectedErrorMessage = "Invalid info type. Use 'basic' or 'complete'"
@@ -1,6 +1,10 @@
 const { autoUpdater } = require('electron').remote
 const { ipcRenderer } = require('electron')
 const { expect } = require('chai')
+const crypto = require('crypto')
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
 
 describe('autoUpdater module', function () {
   // XXX(alexeykuzmin): Calling `.skip()` in a 'before' hook
@@ -138,6 +142,68 @@ describe('autoUpdater module', function () {
     })
   })
 
+  describe('applyDelta', () => {
+    // Frames the manifest like the header of an asar archive.
+    const createDelta = (manifest, payload) => {
+      const json = Buffer.from(JSON.stringify(manifest))
+      const header = Buffer.alloc(8 + Math.ceil(json.length / 4) * 4)
+      header.writeUInt32LE(header.length - 4, 0)
+      header.writeInt32LE(json.length, 4)
+      json.copy(header, 8)
+      const size = Buffer.alloc(8)
+      size.writeUInt32LE(4, 0)
+      size.writeUInt32LE(header.length, 4)
+      return Buffer.concat([size, header, payload])
+    }
+
+    let dir
+    beforeEach(() => {
+      dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-delta-'))
+      fs.mkdirSync(path.join(dir, 'base'))
+      fs.writeFileSync(path.join(dir, 'base', 'file.txt'), 'hello world')
+    })
+
+    const applyDelta = (sha256) => {
+      const content = 'hello electron'
+      const manifest = {
+        files: [{
+          path: 'file.txt',
+          size: content.length,
+          sha256: sha256 || crypto.createHash('sha256').update(content).digest('hex'),
+          base: { path: 'file.txt', size: 11 },
+          blocks: [
+            { source: 'base', offset: 0, size: 6 },
+            { source: 'delta', offset: 0, size: 8 }
+          ]
+        }]
+      }
+      const deltaPath = path.join(dir, 'update.delta')
+      fs.writeFileSync(deltaPath, createDelta(manifest, Buffer.from('electron')))
+      return autoUpdater.applyDelta({
+        basePath: path.join(dir, 'base'),
+        deltaPath,
+        outputPath: path.join(dir, 'output')
+      })
+    }
+
+    it('writes the files of the delta', async () => {
+      await applyDelta()
+      const output = fs.readFileSync(path.join(dir, 'output', 'file.txt'), 'utf8')
+      expect(output).to.equal('hello electron')
+    })
+
+    it('rejects and removes files that fail the check', async () => {
+      let error
+      try {
+        await applyDelta('00')
+      } catch (e) {
+        error = e
+      }
+      expect(error).to.be.an.instanceof(Error)
+      expect(fs.existsSync(path.join(dir, 'output', 'file.txt'))).to.equal(false)
+    })
+  })
+
   describe('error event', () => {
     it('serializes correctly over the remote module', function (done) {
       if (process.platform === 'linux') {
@@ -2,6 +2,7 @@
 
 const assert = require('assert')
 const chai = require('chai')
+const ChildProcess = require('child_process')
 const dirtyChai = require('dirty-chai')
 const fs = require('fs')
 const path = require('path')
@@ -11,7 +12,7 @@ const http = require('http')
 const { closeWindow } = require('./window-helpers')
 const { emittedOnce } = require('./events-helpers')
 const { resolveGetters } = require('./assert-helpers')
-const { ipcRenderer, remote, screen } = require('electron')
+const { ipcRenderer, nativeImage, remote, screen } = require('electron')
 const { app, ipcMain, BrowserWindow, BrowserView, protocol, session, webContents } = remote
 
 const features = process.atomBinding('features')
@@ -119,6 +120,68 @@ describe('BrowserWindow module', () => {
     })
   })
 
+  describe('recyclable option', () => {
+    const options = { show: false, width: 200, height: 200, recyclable: true }
+
+    const closeRecyclable = async () => {
+      const window = new BrowserWindow(options)
+      const closed = emittedOnce(window, 'closed')
+      window.close()
+      await closed
+      return window.id
+    }
+
+    it('reuses a closed window for the same options', async () => {
+      const id = await closeRecyclable()
+      expect(BrowserWindow.getAllWindows().map((win) => win.id)).to.not.include(id)
+
+      const recycled = new BrowserWindow({ ...options, width: 300 })
+      try {
+        expect(recycled.id).to.equal(id)
+        expect(recycled.getSize()[0]).to.equal(300)
+      } finally {
+        recycled.destroy()
+      }
+    })
+
+    it('removes only the listeners of the app when reusing a window', async () => {
+      const window = new BrowserWindow(options)
+      const internalCount = window.webContents.listenerCount('destroyed')
+      window.on('resize', () => {})
+      window.webContents.on('destroyed', () => {})
+      const closed = emittedOnce(window, 'closed')
+      window.close()
+      await closed
+
+      const recycled = new BrowserWindow(options)
+      try {
+        expect(recycled.id).to.equal(window.id)
+        expect(recycled.listenerCount('resize')).to.equal(0)
+        expect(recycled.webContents.listenerCount('destroyed')).to.equal(internalCount)
+      } finally {
+        recycled.destroy()
+      }
+    })
+
+    it('does not reuse a window for other options', async () => {
+      const id = await closeRecyclable()
+      const other = new BrowserWindow({ ...options, frame: false })
+      try {
+        expect(other.id).to.not.equal(id)
+      } finally {
+        other.destroy()
+        BrowserWindow.fromId(id).destroy()
+      }
+    })
+
+    it('emits window-all-closed with pooled windows', async () => {
+      const fixture = path.join(fixtures, 'api', 'window-recycler-all-closed.js')
+      const appProcess = ChildProcess.spawn(remote.process.execPath, [fixture])
+      const [exitCode] = await emittedOnce(appProcess, 'exit')
+      expect(exitCode).to.equal(0)
+    })
+  })
+
   describe('BrowserWindow.close()', () => {
     let server
 
@@ -524,6 +587,36 @@ describe('BrowserWindow module', () => {
     })
   })
 
+  describe('webContents.capturePageRegions(rects, options)', () => {
+    it('resolves with an encoded image for each region', async () => {
+      w.loadURL('data:text/html,<body style="background: red"></body>')
+      await emittedOnce(w, 'ready-to-show')
+      w.show()
+
+      const rects = [
+        { x: 0, y: 0, width: 10, height: 10 },
+        { x: 10, y: 10, width: 20, height: 20 }
+      ]
+      const images = await w.webContents.capturePageRegions(rects, {
+        encoding: 'jpeg',
+        scaleFactor: 1
+      })
+      expect(images).to.have.lengthOf(2)
+      const image = nativeImage.createFromBuffer(images[1])
+      expect(image.getSize()).to.deep.equal({ width: 20, height: 20 })
+    })
+
+    it('rejects unsupported encodings', async () => {
+      let error = null
+      try {
+        await w.webContents.capturePageRegions([], { encoding: 'gif' })
+      } catch (e) {
+        error = e
+      }
+      expect(error.message).to.match(/Unsupported image encoding/)
+    })
+  })
+
   describe('BrowserWindow.setBounds(bounds[, animate])', () => {
     it('sets the window bounds with full bounds', () => {
       const fullBounds = { x: 440, y: 225, width: 500, height: 400 }
@@ -556,6 +649,23 @@ describe('BrowserWindow module', () => {
     })
   })
 
+  describe('coalesceBoundsEvents option', () => {
+    it('coalesces the resize events and keeps the latest size', async () => {
+      w.destroy()
+      w = new BrowserWindow({ show: false, coalesceBoundsEvents: true })
+
+      let resizes = 0
+      w.on('resize', () => { resizes++ })
+      for (let i = 0; i < 10; i++) {
+        w.setSize(300 + i * 10, 300)
+      }
+      await new Promise(resolve => setTimeout(resolve, 200))
+
+      expect(resizes).to.be.within(1, 9)
+      assertBoundsEqual(w.getSize(), [390, 300])
+    })
+  })
+
   describe('BrowserWindow.setMinimum/MaximumSize(width, height)', () => {
     it('sets the maximum and minimum size of the window', () => {
       assert.deepStrictEqual(w.getMinimumSize(), [0, 0])
@@ -1039,6 +1149,38 @@ describe('BrowserWindow module', () => {
     })
   })
 
+  describe('BrowserWindow.setBoundsForWindows(entries)', () => {
+    let w2 = null
+
+    beforeEach(() => { w2 = new BrowserWindow({ show: false }) })
+
+    afterEach(() => closeWindow(w2, { assertSingleWindow: false }).then(() => { w2 = null }))
+
+    it('sets the bounds of every window', () => {
+      const bounds = { x: 100, y: 120, width: 300, height: 200 }
+      const bounds2 = { x: 420, y: 120, width: 320, height: 220 }
+      BrowserWindow.setBoundsForWindows([
+        { window: w, bounds },
+        { window: w2, bounds: bounds2 }
+      ])
+      assertBoundsEqual(w.getBounds(), bounds)
+      assertBoundsEqual(w2.getBounds(), bounds2)
+    })
+
+    it('accepts partial bounds', () => {
+      const bounds = { x: 100, y: 120, width: 300, height: 200 }
+      w.setBounds(bounds)
+      BrowserWindow.setBoundsForWindows([{ window: w, bounds: { width: 250 } }])
+      assertBoundsEqual(w.getBounds(), Object.assign(bounds, { width: 250 }))
+    })
+
+    it('throws for entries without a window', () => {
+      assert.throws(() => {
+        BrowserWindow.setBoundsForWindows([{ bounds: { x: 0, y: 0, width: 100, height: 100 } }])
+      }, /Each entry must have a window/)
+    })
+  })
+
   describe('BrowserWindow.fromWebContents(webContents)', () => {
     let contents = null
 
@@ -1456,6 +1598,44 @@ describe('BrowserWindow module', () => {
       generateSpecs('with sandbox', true)
     })
 
+    describe('"gpuPreference" option', () => {
+      const getPowerPreference = async (webPreferences) => {
+        const w = await openTheWindow({ show: false, webPreferences })
+        const loaded = emittedOnce(w.webContents, 'did-finish-load')
+        w.loadFile(path.join(fixtures, 'api', 'blank.html'))
+        await loaded
+        return w.webContents.executeJavaScript(`(() => {
+          const context = document.createElement('canvas').getContext('webgl')
+          return context && context.getContextAttributes().powerPreference
+        })()`)
+      }
+
+      for (const contextIsolation of [false, true]) {
+        describe(contextIsolation ? 'with contextIsolation' : 'without contextIsolation', () => {
+          it('is the default powerPreference of WebGL contexts', async function () {
+            const powerPreference = await getPowerPreference({ gpuPreference: 'low-power', contextIsolation })
+            // WebGL is not available on every machine.
+            if (powerPreference == null) return this.skip()
+            expect(powerPreference).to.equal('low-power')
+          })
+        })
+      }
+
+      it('does not override the powerPreference asked for by the page', async function () {
+        const w = await openTheWindow({ show: false, webPreferences: { gpuPreference: 'low-power' } })
+        const loaded = emittedOnce(w.webContents, 'did-finish-load')
+        w.loadFile(path.join(fixtures, 'api', 'blank.html'))
+        await loaded
+        const powerPreference = await w.webContents.executeJavaScript(`(() => {
+          const canvas = document.createElement('canvas')
+          const context = canvas.getContext('webgl', { powerPreference: 'high-performance' })
+          return context && context.getContextAttributes().powerPreference
+        })()`)
+        if (powerPreference == null) return this.skip()
+        expect(powerPreference).to.equal('high-performance')
+      })
+    })
+
     describe('"sandbox" option', () => {
       function waitForEvents (emitter, events, callback) {
         let count = events.length
@@ -2135,6 +2315,28 @@ describe('BrowserWindow module', () => {
 
       w.loadFile(path.join(fixtures, 'pages', 'visibilitychange.html'))
     })
+    it('visibilityState changes when a browser view covers the page', (done) => {
+      w = new BrowserWindow({ width: 100, height: 100, occlusionTracking: true })
+      const view = new BrowserView()
+
+      onNextVisibilityChange((visibilityState, hidden) => {
+        assert.strictEqual(visibilityState, 'visible')
+
+        onNextVisibilityChange((visibilityState, hidden) => {
+          assert.strictEqual(visibilityState, 'hidden')
+          assert.strictEqual(hidden, true)
+          w.setBrowserView(null)
+          view.destroy()
+          done()
+        })
+
+        w.setBrowserView(view)
+        const [width, height] = w.getContentSize()
+        view.setBounds({ x: 0, y: 0, width, height })
+      })
+
+      w.loadFile(path.join(fixtures, 'pages', 'visibilitychange.html'))
+    })
     it('visibilityState changes when window is shown', (done) => {
       w = new BrowserWindow({ width: 100, height: 100 })
 
@@ -2431,6 +2633,54 @@ describe('BrowserWindow module', () => {
         done()
       }
     })
+    it('subscribes to I420 frames of the requested size', (done) => {
+      let called = false
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'))
+      w.webContents.on('dom-ready', () => {
+        const options = { format: 'i420', width: 320, height: 240 }
+        w.webContents.beginFrameSubscription(options, (data, rect, frame) => {
+          if (called) return
+          called = true
+
+          expect(frame.format).to.equal('i420')
+          expect(frame.codedSize).to.deep.equal({ width: 320, height: 240 })
+          expect(data.length).to.equal(320 * 240 * 3 / 2)
+          w.webContents.endFrameSubscription()
+          done()
+        })
+      })
+    })
+    it('throws error when the frame format is not supported', () => {
+      expect(() => {
+        w.webContents.beginFrameSubscription({ format: 'rgb' }, () => {})
+      }).to.throw(/Unsupported frame format/)
+    })
+  })
+
+  describe('beginRecording method', () => {
+    before(function () {
+      // Hardware encoders are not available on the CI machines of Linux.
+      if (process.platform === 'linux') {
+        this.skip()
+      }
+    })
+
+    it('streams the encoded frames until endRecording is called', (done) => {
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'))
+      w.webContents.once('did-finish-load', () => {
+        let size = 0
+        const stream = w.webContents.beginRecording({ width: 320, height: 240 })
+        stream.on('data', (chunk) => {
+          size += chunk.length
+          w.webContents.endRecording()
+        })
+        stream.on('error', done)
+        stream.on('end', () => {
+          assert.notStrictEqual(size, 0)
+          done()
+        })
+      })
+    })
   })
 
   describe('savePage method', () => {
@@ -2438,8 +2688,14 @@ describe('BrowserWindow module', () => {
     const savePageHtmlPath = path.join(savePageDir, 'save_page.html')
     const savePageJsPath = path.join(savePageDir, 'save_page_files', 'test.js')
     const savePageCssPath = path.join(savePageDir, 'save_page_files', 'test.css')
+    const savePageMhtmlPath = path.join(savePageDir, 'save_page.mhtml')
 
     after(() => {
+      try {
+        fs.unlinkSync(savePageMhtmlPath)
+      } catch (e) {
+        // Ignore error
+      }
       try {
         fs.unlinkSync(savePageCssPath)
         fs.unlinkSync(savePageJsPath)
@@ -2463,6 +2719,20 @@ describe('BrowserWindow module', () => {
       })
       w.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'))
     })
+
+    it('should save page to disk as MHTML', (done) => {
+      if (!fs.existsSync(savePageDir)) fs.mkdirSync(savePageDir)
+      w.webContents.once('did-finish-load', () => {
+        w.webContents.savePage(savePageMhtmlPath, 'MHTML', function (error) {
+          assert.strictEqual(error, null)
+          const content = fs.readFileSync(savePageMhtmlPath, 'utf8')
+          assert(content.includes('test.js'))
+          assert(content.includes('multipart/related'))
+          done()
+        })
+      })
+      w.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'))
+    })
   })
 
   describe('BrowserWindow options argument is optional', () => {
@@ -3504,6 +3774,64 @@ describe('BrowserWindow module', () => {
       w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
     })
 
+    it('empties the image of the frame after the paint event', (done) => {
+      w.webContents.once('paint', function (event, rect, image) {
+        const bitmap = image.getBitmap()
+        expect(bitmap.length).to.not.equal(0)
+        setImmediate(() => {
+          expect(bitmap.length).to.equal(0)
+          expect(image.isEmpty()).to.be.true()
+          expect(image.getBitmap().length).to.equal(0)
+          done()
+        })
+      })
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+    })
+
+    it('emits only the dirty regions with paintRegions', (done) => {
+      w.destroy()
+      w = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: true,
+          paintRegions: true
+        }
+      })
+      w.webContents.once('paint-regions', (event, regions) => {
+        assert.ok(regions.length > 0)
+        for (const { rect, buffer } of regions) {
+          assert.ok(rect.width <= 100 + 2 && rect.height <= 100 + 2)
+          assert.strictEqual(buffer.length, rect.width * rect.height * 4)
+        }
+        done()
+      })
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+    })
+
+    it('paints into the region of an OffscreenAtlas', (done) => {
+      const { OffscreenAtlas } = remote.require('electron')
+      const atlas = new OffscreenAtlas({ width: 200, height: 100 })
+      w.webContents.on('paint', () => {
+        done(new Error('paint should not be emitted by atlas members'))
+      })
+      atlas.once('paint', (event, regions, image) => {
+        assert.deepStrictEqual(image.getSize(), { width: 200, height: 100 })
+        assert.ok(regions.length > 0)
+        for (const { webContentsId, rect } of regions) {
+          assert.strictEqual(webContentsId, w.webContents.id)
+          assert.ok(rect.x >= 100 && rect.x + rect.width <= 200)
+        }
+        w.webContents.removeAllListeners('paint')
+        atlas.destroy()
+        done()
+      })
+      atlas.add(w.webContents, { x: 100, y: 0, width: 100, height: 100 })
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+    })
+
     describe('window.webContents.isOffscreen()', () => {
       it('is true for offscreen type', () => {
         w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
@@ -3562,6 +3890,19 @@ describe('BrowserWindow module', () => {
       })
     })
 
+    describe('window.webContents.sendBeginFrame()', () => {
+      it('paints with external begin frames', (done) => {
+        w.webContents.setExternalBeginFrames(true)
+        const interval = setInterval(() => w.webContents.sendBeginFrame(), 16)
+        w.webContents.once('paint', function (event, rect, data) {
+          clearInterval(interval)
+          assert.notStrictEqual(data.length, 0)
+          done()
+        })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+      })
+    })
+
     describe('window.webContents.setFrameRate(frameRate)', () => {
       it('sets custom frame rate', (done) => {
         w.webContents.on('dom-ready', () => {
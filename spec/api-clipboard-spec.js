@@ -16,12 +16,32 @@ describe('clipboard module', () => {
     })
   })
 
+  describe('clipboard.readImageAsync()', () => {
+    it('resolves with the image written by writeImageAsync()', async () => {
+      const p = path.join(fixtures, 'assets', 'logo.png')
+      const i = nativeImage.createFromPath(p)
+      await clipboard.writeImageAsync(i)
+      const image = await clipboard.readImageAsync()
+      expect(image.toDataURL()).to.equal(i.toDataURL())
+    })
+  })
+
   describe('clipboard.readText()', () => {
     it('returns unicode string correctly', () => {
       const text = '千江有水千江月，万里无云万里天'
       clipboard.writeText(text)
       expect(clipboard.readText()).to.equal(text)
     })
+
+    it('returns large strings correctly', () => {
+      const ascii = 'a'.repeat(1024 * 1024)
+      clipboard.writeText(ascii)
+      expect(clipboard.readText()).to.equal(ascii)
+
+      const unicode = '千江有水千江月'.repeat(64 * 1024)
+      clipboard.writeText(unicode)
+      expect(clipboard.readText()).to.equal(unicode)
+    })
   })
 
   describe('clipboard.readHTML()', () => {
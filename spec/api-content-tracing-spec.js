@@ -0,0 +1,80 @@
+const { app, contentTracing } = require('electron').remote
+const chai = require('chai')
+const dirtyChai = require('dirty-chai')
+const fs = require('fs')
+const path = require('path')
+
+const { expect } = chai
+chai.use(dirtyChai)
+
+describe('contentTracing module', () => {
+  describe('snapshotRecording()', () => {
+    const filePath = path.join(app.getPath('temp'), 'snapshot.json')
+
+    afterEach(() => {
+      try {
+        fs.unlinkSync(filePath)
+      } catch (e) {
+        // ignore error
+      }
+    })
+
+    it('writes the recorded data and keeps recording', (done) => {
+      const options = {
+        categoryFilter: 'electron',
+        traceOptions: 'record-continuously'
+      }
+      contentTracing.startRecording(options, () => {
+        contentTracing.snapshotRecording(filePath, (resultFilePath) => {
+          expect(resultFilePath).to.equal(filePath)
+          const trace = JSON.parse(fs.readFileSync(filePath, 'utf8'))
+          expect(trace.traceEvents).to.be.an('array')
+          contentTracing.stopRecording('', (path) => {
+            fs.unlinkSync(path)
+            done()
+          })
+        })
+      })
+    })
+
+    it('throws when recording has not been started', () => {
+      expect(() => {
+        contentTracing.snapshotRecording('')
+      }).to.throw('Recording has not been started')
+    })
+  })
+
+  describe('startCpuProfiling() and stopCpuProfiling()', () => {
+    const filePath = path.join(app.getPath('temp'), 'main.cpuprofile')
+
+    afterEach(() => {
+      try {
+        fs.unlinkSync(filePath)
+      } catch (e) {
+        // ignore error
+      }
+    })
+
+    it('writes a profile of the main process', async () => {
+      expect(contentTracing.startCpuProfiling({ samplingInterval: 100 })).to.be.true()
+      expect(contentTracing.startCpuProfiling()).to.be.false()
+      await contentTracing.stopCpuProfiling(filePath)
+
+      const profile = JSON.parse(fs.readFileSync(filePath, 'utf8'))
+      expect(profile.nodes).to.be.an('array').that.is.not.empty()
+      expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length)
+      expect(profile.endTime).to.be.at.least(profile.startTime)
+    })
+
+    it('rejects when the profiler is not running', async () => {
+      let error
+      try {
+        await contentTracing.stopCpuProfiling(filePath)
+      } catch (e) {
+        error = e
+      }
+      expect(error).to.be.an('error')
+      expect(error.message).to.equal('The CPU profiler is not running')
+    })
+  })
+})
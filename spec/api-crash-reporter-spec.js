@@ -352,6 +352,22 @@ describe('crashReporter module', () => {
     })
   })
 
+  describe('createAnnotation(key)', () => {
+    it('can be set and cleared', () => {
+      const annotation = crashReporter.createAnnotation('route')
+      annotation.set('/settings')
+      annotation.set('x'.repeat(1024))
+      annotation.clear()
+    })
+
+    it('reuses the slot of an existing key', () => {
+      // There are far fewer slots than calls.
+      for (let i = 0; i < 100; i++) {
+        crashReporter.createAnnotation('same-key').set(String(i))
+      }
+    })
+  })
+
   describe('Parameters', () => {
     it('returns all of the current parameters', () => {
       crashReporter.start({
@@ -31,6 +31,36 @@ describe('desktopCapturer', () => {
     })
   })
 
+  it('returns sources without thumbnails when the size is empty', done => {
+    desktopCapturer.getSources({
+      types: ['window', 'screen'],
+      thumbnailSize: { width: 0, height: 0 }
+    }, (error, sources) => {
+      expect(error).to.be.null()
+      expect(sources).to.be.an('array').that.is.not.empty()
+      for (const source of sources) {
+        expect(source.thumbnail.isEmpty()).to.be.true()
+      }
+      done()
+    })
+  })
+
+  it('streams the thumbnails to onThumbnail', done => {
+    const thumbnails = []
+    desktopCapturer.getSources({
+      types: ['screen'],
+      thumbnailFormat: 'jpeg',
+      onThumbnail: source => thumbnails.push(source)
+    }, (error, sources) => {
+      expect(error).to.be.null()
+      expect(thumbnails).to.have.lengthOf(sources.length)
+      for (const source of thumbnails) {
+        expect(source.thumbnail.isEmpty()).to.be.false()
+      }
+      done()
+    })
+  })
+
   it('throws an error for invalid options', done => {
     desktopCapturer.getSources(['window', 'screen'], error => {
       expect(error.message).to.equal('Invalid options')
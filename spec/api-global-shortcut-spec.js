@@ -50,4 +50,31 @@ describe('globalShortcut module', () => {
     expect(globalShortcut.isRegistered(accelerators[0])).to.be.false()
     expect(globalShortcut.isRegistered(accelerators[1])).to.be.false()
   })
+
+  it('can unregister only the given accelerators', () => {
+    const accelerators = ['CmdOrCtrl+X', 'CmdOrCtrl+Y', 'CmdOrCtrl+Z']
+
+    globalShortcut.registerAll(accelerators, () => {})
+    globalShortcut.unregisterAll(accelerators.slice(0, 2))
+
+    expect(globalShortcut.isRegistered(accelerators[0])).to.be.false()
+    expect(globalShortcut.isRegistered(accelerators[1])).to.be.false()
+    expect(globalShortcut.isRegistered(accelerators[2])).to.be.true()
+  })
+
+  it('can register accelerators that forward to a webContents', () => {
+    const accelerator = 'CmdOrCtrl+A+B+C'
+    const webContents = require('electron').remote.getCurrentWebContents()
+
+    expect(globalShortcut.register(accelerator, { webContents, channel: 'shortcut' })).to.be.true()
+    expect(globalShortcut.isRegistered(accelerator)).to.be.true()
+    globalShortcut.unregister(accelerator)
+    expect(globalShortcut.isRegistered(accelerator)).to.be.false()
+  })
+
+  it('throws for an invalid shortcut handler', () => {
+    expect(() => {
+      globalShortcut.register('CmdOrCtrl+A+B+C', { channel: 'shortcut' })
+    }).to.throw(/webContents and channel/)
+  })
 })
@@ -85,5 +85,21 @@ describe('ipc main module', () => {
       output = JSON.parse(output)
       expect(output).to.deep.equal(['error'])
     })
+
+    it('receives messages of channels listened to after the page loaded', async () => {
+      w = new BrowserWindow({ show: false })
+      await w.loadURL('about:blank')
+
+      const send = (channel) => w.webContents.executeJavaScript(
+        `require('electron').ipcRenderer.send('${channel}', 'hello')`)
+
+      const listener = () => {}
+      ipcMain.on('late-channel', listener)
+      ipcMain.removeListener('late-channel', listener)
+      const received = emittedOnce(ipcMain, 'late-channel')
+      send('late-channel')
+      const [, arg] = await received
+      expect(arg).to.equal('hello')
+    })
   })
 })
@@ -119,6 +119,170 @@ describe('ipc renderer module', () => {
     })
   })
 
+  describe('ipcRenderer.sendSerialized', () => {
+    it('keeps Date, Map, Set and ArrayBuffer intact', done => {
+      const date = new Date()
+      const map = new Map([['a', 1], ['b', { c: 2 }]])
+      const set = new Set([1, 'two'])
+      const buffer = new Uint8Array([1, 2, 3]).buffer
+      ipcRenderer.once('message', (event, dateValue, mapValue, setValue, bufferValue) => {
+        expect(dateValue).to.be.an.instanceof(Date)
+        expect(dateValue.getTime()).to.equal(date.getTime())
+        expect(mapValue).to.be.an.instanceof(Map)
+        expect(mapValue.get('b')).to.deep.equal({ c: 2 })
+        expect(Array.from(setValue)).to.deep.equal([1, 'two'])
+        expect(bufferValue).to.be.an.instanceof(ArrayBuffer)
+        expect(Array.from(new Uint8Array(bufferValue))).to.deep.equal([1, 2, 3])
+        done()
+      })
+      ipcRenderer.sendSerialized('message-serialized', date, map, set, buffer)
+    })
+
+    it('only sends the viewed part of a typed array', done => {
+      const view = new Float64Array(new ArrayBuffer(64), 16, 2)
+      view[0] = 1.5
+      view[1] = -2
+      ipcRenderer.once('message', (event, value) => {
+        expect(value).to.be.an.instanceof(Float64Array)
+        expect(value.buffer.byteLength).to.equal(16)
+        expect(Array.from(value)).to.deep.equal([1.5, -2])
+        done()
+      })
+      ipcRenderer.sendSerialized('message-serialized', view)
+    })
+
+    it('keeps cyclic references', done => {
+      const child = { hello: 'world' }
+      child.child = child
+      ipcRenderer.once('message', (event, value) => {
+        expect(value.child).to.equal(value)
+        done()
+      })
+      ipcRenderer.sendSerialized('message-serialized', child)
+    })
+
+    it('throws when a value can not be cloned', () => {
+      expect(() => {
+        ipcRenderer.sendSerialized('message-serialized', () => {})
+      }).to.throw()
+    })
+  })
+
+  describe('ipcRenderer.setBatching', () => {
+    afterEach(() => {
+      ipcRenderer.setBatching('message-batched', null)
+    })
+
+    it('sends the messages of a task as one batch', done => {
+      ipcRenderer.setBatching('message-batched', 'task')
+      ipcRenderer.once('message', (event, messages) => {
+        expect(messages).to.deep.equal([[1], [2, 'two'], [{ three: 3 }]])
+        done()
+      })
+      ipcRenderer.send('message-batched', 1)
+      ipcRenderer.send('message-batched', 2, 'two')
+      ipcRenderer.send('message-batched', { three: 3 })
+    })
+
+    it('keeps the order of messages on other channels', done => {
+      ipcRenderer.setBatching('message-batched', 'animationFrame')
+      const received = []
+      const listener = (event, value) => {
+        received.push(value)
+        if (received.length === 2) {
+          ipcRenderer.removeListener('message', listener)
+          expect(received).to.deep.equal([['batched'], 'direct'])
+          done()
+        }
+      }
+      ipcRenderer.on('message', listener)
+      ipcRenderer.send('message-batched', 'batched')
+      ipcRenderer.send('message', 'direct')
+    })
+
+    it('sends the pending batches before an invoke', async () => {
+      ipcRenderer.setBatching('message-batched', 'animationFrame')
+      const received = []
+      const listener = (event, value) => received.push(value)
+      ipcRenderer.on('message', listener)
+      try {
+        ipcRenderer.send('message-batched', 'batched')
+        await ipcRenderer.invoke('invoke-echo')
+      } finally {
+        ipcRenderer.removeListener('message', listener)
+      }
+      expect(received).to.deep.equal([[['batched']]])
+    })
+
+    it('rejects invalid modes', () => {
+      expect(() => {
+        ipcRenderer.setBatching('message-batched', 'never')
+      }).to.throw(/Invalid batching mode/)
+    })
+  })
+
+  describe('ipcRenderer.invoke', () => {
+    it('resolves with the value returned by the handler', async () => {
+      const result = await ipcRenderer.invoke('invoke-echo', 1, 'two', { three: 3 })
+      expect(result).to.deep.equal([1, 'two', { three: 3 }])
+    })
+
+    it('resolves with the value of a returned promise', async () => {
+      expect(await ipcRenderer.invoke('invoke-async', 21)).to.equal(42)
+    })
+
+    it('handles concurrent invocations', async () => {
+      const results = await Promise.all([1, 2, 3].map(n => ipcRenderer.invoke('invoke-async', n)))
+      expect(results).to.deep.equal([2, 4, 6])
+    })
+
+    it('rejects when the handler throws', async () => {
+      let error
+      try {
+        await ipcRenderer.invoke('invoke-throw')
+      } catch (e) {
+        error = e
+      }
+      expect(error).to.be.an('error')
+      expect(error.message).to.equal('handler failed')
+    })
+
+    it('rejects when there is no handler', async () => {
+      let error
+      try {
+        await ipcRenderer.invoke('invoke-missing')
+      } catch (e) {
+        error = e
+      }
+      expect(error.message).to.match(/No handler registered for 'invoke-missing'/)
+    })
+  })
+
+  describe('ipcRenderer.postMessage', () => {
+    for (const size of [16, 4 * 1024 * 1024]) {
+      it(`transfers an ArrayBuffer of ${size} bytes`, done => {
+        const buffer = new ArrayBuffer(size)
+        new Uint8Array(buffer).fill(42)
+        ipcRenderer.once('message', (event, value) => {
+          expect(value).to.be.an.instanceof(ArrayBuffer)
+          expect(value.byteLength).to.equal(size)
+          const bytes = new Uint8Array(value)
+          expect(bytes[0]).to.equal(42)
+          expect(bytes[size - 1]).to.equal(42)
+          done()
+        })
+        ipcRenderer.postMessage('message-transfer', buffer, [buffer])
+        expect(buffer.byteLength).to.equal(0)
+      })
+    }
+
+    it('throws when transferring other objects', () => {
+      expect(() => {
+        ipcRenderer.postMessage('message-transfer', {}, [{}])
+      }).to.throw(/Only ArrayBuffers can be transferred/)
+    })
+  })
+
   describe('ipc.sendSync', () => {
     afterEach(() => {
       ipcMain.removeAllListeners('send-sync-message')
@@ -198,6 +362,100 @@ describe('ipc renderer module', () => {
     })
   })
 
+  describe('ipcRenderer.openPort', () => {
+    let contents = null
+
+    afterEach(() => {
+      if (contents) contents.destroy()
+      contents = null
+    })
+
+    it('connects the port to the other WebContents', done => {
+      contents = webContents.create({
+        preload: path.join(fixtures, 'module', 'preload-inject-ipc.js')
+      })
+
+      contents.once('did-finish-load', () => {
+        ipcRenderer.openPort(contents.id, 'port').then(port => {
+          port.onmessage = message => {
+            expect(message.data).to.deep.equal({ hello: 'world' })
+            done()
+          }
+          port.postMessage({ hello: 'world' })
+        }).catch(done)
+      })
+
+      contents.loadFile(path.join(fixtures, 'pages', 'ping-pong.html'))
+    })
+
+    it('rejects when the WebContents does not exist', () => {
+      return ipcRenderer.openPort(-1, 'port').then(() => {
+        throw new Error('openPort should be rejected')
+      }, error => {
+        expect(error.message).to.equal('No webContents with id -1')
+      })
+    })
+
+    it('ignores ports posted by the page', () => {
+      let emitted = false
+      const listener = () => { emitted = true }
+      ipcRenderer.once('forged-port', listener)
+
+      const { port1 } = new MessageChannel()
+      window.dispatchEvent(new MessageEvent('message', {
+        data: { type: 'ELECTRON_IPC_PORT', requestId: 0, channel: 'forged-port', senderId: 0 },
+        ports: [port1]
+      }))
+      ipcRenderer.removeListener('forged-port', listener)
+      expect(emitted).to.be.false()
+    })
+  })
+
+  describe('webContents.createSharedRing', () => {
+    it('delivers the messages written in the main process', done => {
+      ipcRenderer.once('ring', ({ ring }) => {
+        ring.wait().then(() => {
+          const messages = []
+          let message
+          while ((message = ring.read()) !== null) {
+            messages.push(Buffer.from(message).toString())
+          }
+          expect(messages).to.deep.equal(['first', 'second'])
+          expect(ring.isEmpty()).to.be.true()
+          done()
+        }).catch(done)
+      })
+
+      const ring = remote.getCurrentWebContents().createSharedRing('ring', 64)
+      expect(ring.write('first')).to.be.true()
+      expect(ring.write('second')).to.be.true()
+    })
+
+    it('refuses messages that do not fit', () => {
+      const ring = remote.getCurrentWebContents().createSharedRing('ring-full', 40)
+      expect(ring.write('0123456789')).to.be.true()
+      expect(ring.write('0123456789')).to.be.true()
+      expect(ring.write('0123456789')).to.be.false()
+    })
+
+    it('closes the ring in both processes', done => {
+      const ring = remote.getCurrentWebContents().createSharedRing('ring-close', 64)
+      ipcRenderer.once('ring-close', ({ ring: reader }) => {
+        reader.wait().then(() => {
+          expect(reader.closed).to.be.true()
+          expect(reader.buffer).to.be.an.instanceof(SharedArrayBuffer)
+          expect(Buffer.from(reader.read()).toString()).to.equal('last')
+          expect(reader.read()).to.be.null()
+          done()
+        }).catch(done)
+        ring.write('last')
+        ring.close()
+        expect(ring.closed).to.be.true()
+        expect(() => ring.write('late')).to.throw('The ring is closed')
+      })
+    })
+  })
+
   describe('remote listeners', () => {
     it('detaches listeners subscribed to destroyed renderers, and shows a warning', (done) => {
       w = new BrowserWindow({ show: false })
@@ -0,0 +1,67 @@
+const chai = require('chai')
+const dirtyChai = require('dirty-chai')
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+const { remote } = require('electron')
+const { json } = remote
+
+const { expect } = chai
+chai.use(dirtyChai)
+
+describe('json module', () => {
+  describe('json.parse(text)', () => {
+    it('parses strings and buffers', async () => {
+      const text = '{"a": [1, -2, 3.5, true, null], "b": {"c": "dé"}, "0": "zero"}'
+      expect(await json.parse(text)).to.deep.equal(JSON.parse(text))
+      expect(await json.parse(Buffer.from(text))).to.deep.equal(JSON.parse(text))
+    })
+
+    it('keeps the order of the properties', async () => {
+      const text = '{"b": 1, "a": {"d": 2, "c": 3}, "1": 4, "b": 5}'
+      const value = await json.parse(text)
+      expect(JSON.stringify(value)).to.equal(JSON.stringify(JSON.parse(text)))
+    })
+
+    it('rejects invalid JSON', async () => {
+      let error = null
+      try {
+        await json.parse('{"a": ')
+      } catch (e) {
+        error = e
+      }
+      expect(error).to.be.an('error')
+    })
+  })
+
+  describe('json.stringifyToFile(value, path)', () => {
+    const file = path.join(os.tmpdir(), 'electron-json-spec.json')
+
+    afterEach(() => {
+      if (fs.existsSync(file)) fs.unlinkSync(file)
+    })
+
+    it('writes the value as JSON', async () => {
+      const value = { a: [1, 2, 3], b: 'c' }
+      await json.stringifyToFile(value, file)
+      expect(JSON.parse(fs.readFileSync(file, 'utf8'))).to.deep.equal(value)
+    })
+
+    it('writes the text JSON.stringify returns', async () => {
+      const value = { b: 1, a: { d: new Date(0), c: [undefined] }, e: undefined }
+      await json.stringifyToFile(value, file)
+      expect(fs.readFileSync(file, 'utf8')).to.equal(JSON.stringify(value))
+    })
+
+    it('rejects values that can not be written as JSON', async () => {
+      let error = null
+      try {
+        await json.stringifyToFile(undefined, file)
+      } catch (e) {
+        error = e
+      }
+      expect(error).to.be.an('error')
+      expect(fs.existsSync(file)).to.be.false()
+    })
+  })
+})
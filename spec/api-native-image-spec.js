@@ -270,6 +270,34 @@ describe('nativeImage module', () => {
     })
   })
 
+  describe('toPNGAsync()', () => {
+    it('resolves with the same data as toPNG()', async () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'))
+      for (const scaleFactor of [1.0, 2.0]) {
+        const png = await image.toPNGAsync({ scaleFactor })
+        expect(png.equals(image.toPNG({ scaleFactor }))).to.be.true()
+      }
+    })
+  })
+
+  describe('toJPEGAsync()', () => {
+    it('resolves with the same data as toJPEG()', async () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'))
+      const jpeg = await image.toJPEGAsync(80)
+      expect(jpeg.equals(image.toJPEG(80))).to.be.true()
+    })
+  })
+
+  describe('getBitmap()', () => {
+    it('keeps the pixels alive after the representation is replaced', () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'))
+      const bitmap = image.getBitmap({ scaleFactor: 2.0 })
+      const copy = image.toBitmap({ scaleFactor: 2.0 })
+      image.addRepresentation({ scaleFactor: 2.0, buffer: image.toPNG() })
+      expect(bitmap.equals(copy)).to.be.true()
+    })
+  })
+
   describe('createFromPath(path)', () => {
     it('returns an empty image for invalid paths', () => {
       expect(nativeImage.createFromPath('').isEmpty())
@@ -332,6 +360,47 @@ describe('nativeImage module', () => {
     })
   })
 
+  describe('getCacheStats()', () => {
+    afterEach(() => {
+      nativeImage.clearCache()
+    })
+
+    it('counts the images created from the same path', () => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+      nativeImage.clearCache()
+      const before = nativeImage.getCacheStats()
+      const imageA = nativeImage.createFromPath(imagePath)
+      const imageB = nativeImage.createFromPath(imagePath)
+
+      const stats = nativeImage.getCacheStats()
+      expect(stats.misses - before.misses).to.equal(1)
+      expect(stats.hits - before.hits).to.equal(1)
+      expect(stats.count).to.equal(1)
+      expect(imageA.toBitmap().equals(imageB.toBitmap())).to.be.true()
+    })
+
+    it('does not share the representations added to an image', () => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+      const imageA = nativeImage.createFromPath(imagePath)
+      imageA.toBitmap()
+      const buffer = imageA.resize({ width: 100 }).toPNG()
+      imageA.addRepresentation({ scaleFactor: 2.0, buffer })
+
+      const imageB = nativeImage.createFromPath(imagePath)
+      expect(imageA.toBitmap({ scaleFactor: 2.0 }).equals(imageA.toBitmap())).to.be.false()
+      expect(imageB.toBitmap({ scaleFactor: 2.0 }).equals(imageB.toBitmap())).to.be.true()
+    })
+
+    it('evicts the images over the limit', () => {
+      nativeImage.setCacheLimit(0)
+      nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'))
+      const stats = nativeImage.getCacheStats()
+      expect(stats.count).to.equal(0)
+      expect(stats.limit).to.equal(0)
+      nativeImage.setCacheLimit(32 * 1024 * 1024)
+    })
+  })
+
   describe('createFromNamedImage(name)', () => {
     it('returns empty for invalid options', () => {
       const image = nativeImage.createFromNamedImage('totally_not_real')
@@ -407,6 +476,15 @@ describe('nativeImage module', () => {
     })
   })
 
+  describe('resizeAsync(options)', () => {
+    it('resolves with a resized image', async () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'))
+      const resized = await image.resizeAsync({ width: 269 })
+      expect(resized.getSize()).to.deep.equal({ width: 269, height: 95 })
+      expect(resized.toBitmap().equals(image.resize({ width: 269 }).toBitmap())).to.be.true()
+    })
+  })
+
   describe('crop(bounds)', () => {
     it('returns an empty image when called on an empty image', () => {
       expect(nativeImage.createEmpty().crop({ width: 1, height: 2, x: 0, y: 0 }).isEmpty())
@@ -80,6 +80,41 @@ describe('netLog module', () => {
     })
   })
 
+  it('should dump the events captured in memory when .dumpCapture() is called', done => {
+    expect(netLog.currentlyCapturing).to.be.false()
+    netLog.startCapture({ maxSize: 1024 * 1024 })
+    expect(netLog.currentlyCapturing).to.be.true()
+
+    const request = remote.net.request({ url: server.url, session: session.fromPartition('net-log') })
+    request.on('response', (response) => {
+      response.on('data', () => {})
+      response.on('end', () => {
+        netLog.dumpCapture(dumpFileDynamic, (success) => {
+          netLog.stopCapture()
+          expect(netLog.currentlyCapturing).to.be.false()
+          expect(success).to.be.true()
+          const log = JSON.parse(fs.readFileSync(dumpFileDynamic, 'utf8'))
+          expect(log.constants).to.be.an('object')
+          expect(log.events).to.be.an('array').that.is.not.empty()
+          done()
+        })
+      })
+    })
+    request.end()
+  })
+
+  it('should stream events in batches when .startStreaming() is called', done => {
+    netLog.startStreaming({ interval: 100 }, (events) => {
+      netLog.stopStreaming()
+      expect(events).to.be.an('array').that.is.not.empty()
+      expect(events[0]).to.have.property('type')
+      done()
+    })
+    const request = remote.net.request({ url: server.url, session: session.fromPartition('net-log') })
+    request.on('response', (response) => response.on('data', () => {}))
+    request.end()
+  })
+
   it('should silence when .stopLogging() is called without calling .startLogging()', done => {
     expect(netLog.currentlyLogging).to.be.false()
     expect(netLog.currentlyLoggingPath).to.equal('')
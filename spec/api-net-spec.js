@@ -1,7 +1,10 @@
 const assert = require('assert')
 const { remote } = require('electron')
 const { ipcRenderer } = require('electron')
+const fs = require('fs')
 const http = require('http')
+const os = require('os')
+const path = require('path')
 const url = require('url')
 const { net } = remote
 const { session } = remote
@@ -1240,6 +1243,119 @@ describe('net module', () => {
       }
     })
 
+    it('should read the response with the given buffer size', (done) => {
+      const requestUrl = '/requestUrl'
+      const bodyData = randomBuffer(kOneMegaByte)
+      server.on('request', (request, response) => {
+        switch (request.url) {
+          case requestUrl:
+            response.end(bodyData)
+            break
+          default:
+            handleUnexpectedURL(request, response)
+        }
+      })
+      const urlRequest = net.request({
+        url: `${server.url}${requestUrl}`,
+        bufferSize: 256 * kOneKiloByte
+      })
+      urlRequest.on('response', (response) => {
+        const chunks = []
+        response.on('data', (chunk) => {
+          assert(chunk.length <= 256 * kOneKiloByte)
+          chunks.push(chunk)
+        })
+        response.on('end', () => {
+          assert(Buffer.concat(chunks).equals(bodyData))
+          done()
+        })
+        response.resume()
+      })
+      urlRequest.end()
+    })
+
+    it('should throw if given an invalid bufferSize option', () => {
+      assert.throws(() => {
+        net.request({
+          url: `${server.url}/requestUrl`,
+          bufferSize: -1
+        })
+      }, /bufferSize/)
+    })
+
+    it('should be able to change the priority of a request', (done) => {
+      const requestUrl = '/requestUrl'
+      server.on('request', (request, response) => {
+        switch (request.url) {
+          case requestUrl:
+            response.end()
+            break
+          default:
+            handleUnexpectedURL(request, response)
+        }
+      })
+      const urlRequest = net.request({
+        url: `${server.url}${requestUrl}`,
+        priority: 'lowest'
+      })
+      urlRequest.on('response', (response) => {
+        assert.strictEqual(response.statusCode, 200)
+        response.on('data', () => {})
+        response.on('end', () => {
+          done()
+        })
+      })
+      urlRequest.setPriority('highest')
+      urlRequest.end()
+    })
+
+    it('should throw if given an invalid priority', () => {
+      assert.throws(() => {
+        net.request({
+          url: `${server.url}/requestUrl`,
+          priority: 'urgent'
+        })
+      }, /priority/)
+      const urlRequest = net.request(`${server.url}/requestUrl`)
+      assert.throws(() => {
+        urlRequest.setPriority('urgent')
+      }, /priority/)
+      urlRequest.abort()
+    })
+
+    it('should write the response to savePath', (done) => {
+      const requestUrl = '/requestUrl'
+      const bodyData = randomBuffer(2 * kOneMegaByte)
+      const savePath = path.join(os.tmpdir(), `net-save-path-${Date.now()}`)
+      server.on('request', (request, response) => {
+        switch (request.url) {
+          case requestUrl:
+            response.end(bodyData)
+            break
+          default:
+            handleUnexpectedURL(request, response)
+        }
+      })
+      const urlRequest = net.request({
+        url: `${server.url}${requestUrl}`,
+        savePath
+      })
+      urlRequest.on('response', (response) => {
+        assert.strictEqual(response.statusCode, 200)
+        response.on('data', () => {
+          assert.fail('data should not be emitted with savePath')
+        })
+        response.on('end', () => {
+          const saved = fs.readFileSync(savePath)
+          fs.unlinkSync(savePath)
+          assert(saved.equals(bodyData))
+          done()
+        })
+        response.resume()
+      })
+      urlRequest.end()
+    })
+
     it('should be able to create a request with options', (done) => {
       const requestUrl = '/'
       const customHeaderName = 'Some-Custom-Header-Name'
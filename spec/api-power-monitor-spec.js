@@ -163,5 +163,37 @@ describe('powerMonitor', () => {
         })
       })
     })
+
+    describe('powerMonitor.isOnBatteryPower', () => {
+      it('returns a boolean', () => {
+        expect(powerMonitor.isOnBatteryPower()).to.be.a('boolean')
+      })
+    })
+
+    describe('powerMonitor.setPowerSavingPolicy', () => {
+      afterEach(() => {
+        powerMonitor.setPowerSavingPolicy(null)
+      })
+
+      it('stores the policy', () => {
+        powerMonitor.setPowerSavingPolicy({ offscreenFrameRate: 15 })
+        expect(powerMonitor.getPowerSavingPolicy()).to.deep.equal({ offscreenFrameRate: 15 })
+        expect(powerMonitor.isPowerSaving()).to.equal(powerMonitor.isOnBatteryPower())
+
+        powerMonitor.setPowerSavingPolicy(null)
+        expect(powerMonitor.getPowerSavingPolicy()).to.be.null()
+        expect(powerMonitor.isPowerSaving()).to.be.false()
+      })
+
+      it('rejects invalid policies', () => {
+        expect(() => {
+          powerMonitor.setPowerSavingPolicy('battery')
+        }).to.throw(/must be an object or null/)
+
+        expect(() => {
+          powerMonitor.setPowerSavingPolicy({ offscreenFrameRate: 0 })
+        }).to.throw(/must be a positive number/)
+      })
+    })
   })
 })
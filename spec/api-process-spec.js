@@ -1,4 +1,4 @@
-const { remote } = require('electron')
+const { ipcRenderer, remote } = require('electron')
 const fs = require('fs')
 const path = require('path')
 
@@ -57,6 +57,50 @@ describe('process module', () => {
     })
   })
 
+  describe('process.getUvRunStats()', () => {
+    it('returns uv run stats object', (done) => {
+      setTimeout(() => {
+        const stats = process.getUvRunStats()
+        expect(stats.wakeups).to.be.a('number').and.be.above(0)
+        expect(stats.passes).to.be.at.least(stats.wakeups)
+        expect(stats.budgetExhausted).to.be.a('number')
+        expect(stats.totalLatency).to.be.a('number')
+        expect(stats.maxLatency).to.be.a('number')
+        expect(stats.totalRunTime).to.be.a('number')
+        done()
+      }, 10)
+    })
+  })
+
+  describe('process.getWorkerStats()', () => {
+    it('returns worker stats object', () => {
+      const stats = process.getWorkerStats()
+      expect(stats.created).to.be.a('number').and.be.at.least(0)
+      expect(stats.active).to.be.at.most(stats.created)
+      expect(stats.totalCreationTime).to.be.a('number')
+      expect(stats.maxCreationTime).to.be.at.most(stats.totalCreationTime)
+    })
+  })
+
+  describe('process.getIPCStats()', () => {
+    it('counts the messages sent on each channel', () => {
+      process.resetIPCStats()
+      ipcRenderer.sendSync('echo', 'test')
+      const stats = process.getIPCStats()
+      const channel = stats.find(s => s.channel === 'echo')
+      expect(channel).to.be.an('object')
+      expect(channel.sentCount).to.equal(1)
+      expect(channel.sentBytes).to.be.above(0)
+      expect(channel.receivedCount).to.equal(0)
+    })
+
+    it('is cleared by process.resetIPCStats()', () => {
+      ipcRenderer.send('ipc-stats-ping')
+      process.resetIPCStats()
+      expect(process.getIPCStats()).to.deep.equal([])
+    })
+  })
+
   describe('process.getHeapStatistics()', () => {
     it('returns heap statistics object', () => {
       const heapStats = process.getHeapStatistics()
@@ -168,6 +168,34 @@ describe('protocol module', () => {
       })
     })
 
+    it('serves cached responses without calling the handler', (done) => {
+      let calls = 0
+      const handler = (request, callback) => {
+        calls++
+        callback({ data: text, cache: { maxAge: 60, etag: 'v1' } })
+      }
+      const url = protocolName + '://fake-host/cached'
+      protocol.registerStringProtocol(protocolName, handler, (error) => {
+        if (error) return done(error)
+        $.ajax({
+          url,
+          success: () => {
+            $.ajax({
+              url,
+              success: (data, status, request) => {
+                assert.strictEqual(data, text)
+                assert.strictEqual(request.getResponseHeader('ETag'), 'v1')
+                assert.strictEqual(calls, 1)
+                done()
+              },
+              error: (xhr, errorType, error) => done(error)
+            })
+          },
+          error: (xhr, errorType, error) => done(error)
+        })
+      })
+    })
+
     it('sends object as response', (done) => {
       const handler = (request, callback) => {
         callback({
@@ -224,6 +252,26 @@ describe('protocol module', () => {
       })
     })
 
+    it('sends the requested range of the Buffer', (done) => {
+      const handler = (request, callback) => callback(buffer)
+      protocol.registerBufferProtocol(protocolName, handler, (error) => {
+        if (error) return done(error)
+        $.ajax({
+          url: protocolName + '://fake-host',
+          cache: false,
+          headers: { Range: 'bytes=2-5' },
+          success: (data, status, request) => {
+            assert.strictEqual(request.status, 206)
+            assert.strictEqual(data, text.substr(2, 4))
+            assert.strictEqual(request.getResponseHeader('Content-Range'),
+              `bytes 2-5/${buffer.length}`)
+            done()
+          },
+          error: (xhr, errorType, error) => done(error)
+        })
+      })
+    })
+
     it('sets Access-Control-Allow-Origin', (done) => {
       const handler = (request, callback) => callback(buffer)
       protocol.registerBufferProtocol(protocolName, handler, (error) => {
@@ -386,6 +434,115 @@ describe('protocol module', () => {
     })
   })
 
+  describe('protocol.registerDirectoryProtocol', () => {
+    const directory = path.join(__dirname, 'fixtures', 'pages')
+    const content = String(require('fs').readFileSync(path.join(directory, 'a.html')))
+
+    it('sends the files of the directory', (done) => {
+      protocol.registerDirectoryProtocol(protocolName, directory, (error) => {
+        if (error) return done(error)
+        $.ajax({
+          url: protocolName + '://fake-host/a.html',
+          cache: false,
+          success: (data, status, request) => {
+            assert.strictEqual(data, content)
+            assert.strictEqual(request.getResponseHeader('Access-Control-Allow-Origin'), '*')
+            done()
+          },
+          error: (xhr, errorType, error) => done(error)
+        })
+      })
+    })
+
+    it('fails for files outside of the directory', (done) => {
+      protocol.registerDirectoryProtocol(protocolName, directory, (error) => {
+        if (error) return done(error)
+        $.ajax({
+          url: protocolName + '://fake-host/%2e%2e/api-protocol-spec.js',
+          cache: false,
+          success: () => done('request succeeded but it should not'),
+          error: (xhr, errorType) => {
+            assert.strictEqual(errorType, 'error')
+            done()
+          }
+        })
+      })
+    })
+  })
+
+  describe('protocol.setFileProtocolRules', () => {
+    const directory = path.join(__dirname, 'fixtures', 'pages')
+    const content = String(require('fs').readFileSync(path.join(directory, 'a.html')))
+    const rules = [{
+      host: 'bundle',
+      pathPrefix: '/static',
+      directory,
+      mimeType: 'text/plain',
+      headers: {
+        'Access-Control-Expose-Headers': 'X-Rule',
+        'X-Rule': 'matched'
+      }
+    }]
+
+    it('sends the files of the matching rule', (done) => {
+      protocol.registerFileProtocol(protocolName, (request, callback) => {
+        callback(path.join(directory, 'b.html'))
+      }, (error) => {
+        if (error) return done(error)
+        protocol.setFileProtocolRules(protocolName, rules, (error) => {
+          if (error) return done(error)
+          $.ajax({
+            url: protocolName + '://bundle/static/a.html',
+            cache: false,
+            success: (data, status, request) => {
+              assert.strictEqual(data, content)
+              assert.strictEqual(request.getResponseHeader('Content-Type'), 'text/plain')
+              assert.strictEqual(request.getResponseHeader('X-Rule'), 'matched')
+              done()
+            },
+            error: (xhr, errorType, error) => done(error)
+          })
+        })
+      })
+    })
+
+    it('falls back to the handler when no rule matches', (done) => {
+      let handled = false
+      protocol.registerFileProtocol(protocolName, (request, callback) => {
+        handled = true
+        callback(path.join(directory, 'a.html'))
+      }, (error) => {
+        if (error) return done(error)
+        protocol.setFileProtocolRules(protocolName, rules, (error) => {
+          if (error) return done(error)
+          $.ajax({
+            url: protocolName + '://other/static/a.html',
+            cache: false,
+            success: (data) => {
+              assert.strictEqual(data, content)
+              assert(handled)
+              done()
+            },
+            error: (xhr, errorType, error) => done(error)
+          })
+        })
+      })
+    })
+
+    it('fails when the scheme is not registered', (done) => {
+      protocol.setFileProtocolRules('not-registered', rules, (error) => {
+        assert.notStrictEqual(error, null)
+        done()
+      })
+    })
+
+    it('throws for rules without a directory', () => {
+      assert.throws(() => {
+        protocol.setFileProtocolRules(protocolName, [{ pathPrefix: '/' }])
+      }, /must have a directory/)
+    })
+  })
+
   describe('protocol.registerHttpProtocol', () => {
     it('sends url as response', (done) => {
       const server = http.createServer((req, res) => {
@@ -528,6 +685,54 @@ describe('protocol module', () => {
       })
     })
 
+    it('sends large streams in full', (done) => {
+      const data = 'a'.repeat(3 * 1024 * 1024)
+      const handler = (request, callback) => {
+        callback(getStream(1024 * 1024, data))
+      }
+      protocol.registerStreamProtocol(protocolName, handler, (error) => {
+        if (error) return done(error)
+        $.ajax({
+          url: protocolName + '://fake-host',
+          cache: false,
+          success: (body) => {
+            assert.strictEqual(body.length, data.length)
+            assert.strictEqual(body, data)
+            done()
+          },
+          error: (xhr, errorType, error) => {
+            done(error || new Error(`Request failed: ${xhr.status}`))
+          }
+        })
+      })
+    })
+
+    it('sends the requested range of the stream', (done) => {
+      const handler = (request, callback) => {
+        assert.deepStrictEqual(request.range, { start: 6 })
+        callback({
+          headers: { 'Content-Length': String(text.length) },
+          data: getStream(3)
+        })
+      }
+      protocol.registerStreamProtocol(protocolName, handler, (error) => {
+        if (error) return done(error)
+        $.ajax({
+          url: protocolName + '://fake-host',
+          cache: false,
+          headers: { Range: 'bytes=6-' },
+          success: (data, status, request) => {
+            assert.strictEqual(request.status, 206)
+            assert.strictEqual(data, text.substr(6))
+            done()
+          },
+          error: (xhr, errorType, error) => {
+            done(error || new Error(`Request failed: ${xhr.status}`))
+          }
+        })
+      })
+    })
+
     it('sends custom response headers', (done) => {
       const handler = (request, callback) => callback({
         data: getStream(3),
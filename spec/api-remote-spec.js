@@ -218,6 +218,19 @@ describe('remote module', () => {
       property.property = 1127
     })
 
+    it('reads the snapshot of plain properties until the next task', (done) => {
+      const property = remote.require(path.join(fixtures, 'module', 'property.js'))
+      property.property = 1127
+      const snapshot = remote.require(path.join(fixtures, 'module', 'property.js'))
+      ipcRenderer.sendSync('eval', `require(${JSON.stringify(path.join(fixtures, 'module', 'property.js'))}).property = 2`)
+      assert.strictEqual(snapshot.property, 1127)
+      setTimeout(() => {
+        assert.strictEqual(snapshot.property, 2)
+        snapshot.property = 1127
+        done()
+      })
+    })
+
     it('rethrows errors getting/setting properties', () => {
       const foo = remote.require(path.join(fixtures, 'module', 'error-properties.js'))
 
@@ -262,6 +275,34 @@ describe('remote module', () => {
     })
   })
 
+  describe('remote.pipeline', () => {
+    it('runs a chain of property accesses and calls', () => {
+      const property = remote.require(path.join(fixtures, 'module', 'property.js'))
+      const result = remote.pipeline(property)
+        .get('func')
+        .get('property')
+        .call('toUpperCase')
+        .run()
+      assert.strictEqual(result, 'FOO')
+    })
+
+    it('returns remote objects', () => {
+      const value = remote.pipeline(remote.getCurrentWindow()).get('webContents').run()
+      assert.strictEqual(value.id, remote.getCurrentWebContents().id)
+    })
+
+    it('throws when a step fails', () => {
+      const property = remote.require(path.join(fixtures, 'module', 'property.js'))
+      expect(() => {
+        remote.pipeline(property).get('missing').get('value').run()
+      }).to.throw(/Cannot get 'value' of undefined/)
+    })
+
+    it('throws for values that are not remote objects', () => {
+      expect(() => remote.pipeline({})).to.throw('Expected a remote object')
+    })
+  })
+
   describe('remote value in browser', () => {
     const print = path.join(fixtures, 'module', 'print_name.js')
     const printName = remote.require(print)
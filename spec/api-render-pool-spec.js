@@ -0,0 +1,60 @@
+const chai = require('chai')
+const dirtyChai = require('dirty-chai')
+const { nativeImage, remote } = require('electron')
+const { RenderPool } = remote
+
+const { expect } = chai
+chai.use(dirtyChai)
+
+describe('RenderPool module', () => {
+  let pool = null
+
+  afterEach(() => {
+    if (pool) pool.destroy()
+    pool = null
+  })
+
+  it('renders HTML to a PNG of the viewport size', async () => {
+    pool = new RenderPool()
+    const { data, timing } = await pool.render({
+      html: '<body style="background: red"></body>',
+      width: 100,
+      height: 50
+    })
+    const size = nativeImage.createFromBuffer(data).getSize()
+    expect(size.width).to.equal(100)
+    expect(size.height).to.equal(50)
+    expect(timing.total).to.be.at.least(timing.load)
+  })
+
+  it('queues the jobs that exceed the size of the pool', async () => {
+    pool = new RenderPool({ size: 1 })
+    const jobs = [pool.render({ html: 'a' }), pool.render({ html: 'b' })]
+    expect(pool.getStats()).to.include({ size: 1, busy: 1, queueLength: 1 })
+    await Promise.all(jobs)
+    expect(pool.getStats()).to.include({ busy: 0, queueLength: 0, completedJobs: 2 })
+  })
+
+  it('isolates the pages unless the app opts in', () => {
+    pool = new RenderPool({ size: 2 })
+    let preferences = pool._idle[0].webContents.getWebPreferences()
+    expect(preferences).to.include({ nodeIntegration: false, contextIsolation: true, sandbox: true })
+    pool.destroy()
+
+    pool = new RenderPool({ webPreferences: { sandbox: false } })
+    preferences = pool._idle[0].webContents.getWebPreferences()
+    expect(preferences).to.include({ nodeIntegration: false, sandbox: false })
+  })
+
+  it('rejects the jobs of a destroyed pool', async () => {
+    pool = new RenderPool()
+    pool.destroy()
+    let error = null
+    try {
+      await pool.render({ html: 'a' })
+    } catch (e) {
+      error = e
+    }
+    expect(error).to.be.an('error')
+  })
+})
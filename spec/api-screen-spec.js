@@ -18,4 +18,22 @@ describe('screen module', () => {
       assert(display.size.height > 0)
     })
   })
+
+  describe('screen.getAllDisplays()', () => {
+    it('returns an array of display objects', () => {
+      const displays = screen.getAllDisplays()
+      assert(Array.isArray(displays))
+      assert(displays.length > 0)
+      for (const display of displays) {
+        assert.strictEqual(typeof display.scaleFactor, 'number')
+        assert(display.size.width > 0)
+      }
+    })
+
+    it('returns a new array on each call', () => {
+      const displays = screen.getAllDisplays()
+      displays.pop()
+      assert.strictEqual(screen.getAllDisplays().length, displays.length + 1)
+    })
+  })
 })
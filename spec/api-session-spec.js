@@ -148,6 +148,33 @@ describe('session module', () => {
       })
     })
 
+    it('should set and remove cookies in batches', (done) => {
+      const { cookies } = session.fromPartition('cookies-batch')
+      const names = ['a', 'b', 'c']
+      cookies.setBatch(names.map((name) => ({ url, name, value: name })), (error) => {
+        if (error) return done(error)
+        cookies.get({ domain: '127.0.0.1' }, (error, list) => {
+          if (error) return done(error)
+          assert.deepStrictEqual(list.map((cookie) => cookie.name).sort(), names)
+          cookies.removeBatch(names.map((name) => ({ url, name })), () => {
+            cookies.get({ url }, (error, list) => {
+              if (error) return done(error)
+              assert.strictEqual(list.length, 0)
+              done()
+            })
+          })
+        })
+      })
+    })
+
+    it('calls back with an error when a cookie of a batch is invalid', (done) => {
+      const { cookies } = session.fromPartition('cookies-batch-error')
+      cookies.setBatch([{ url, name: 'a', value: '1' }, { name: 'b' }], (error) => {
+        assert(error, 'Should have an error')
+        done()
+      })
+    })
+
     it('should set cookie for standard scheme', (done) => {
       const standardScheme = remote.getGlobal('standardScheme')
       const origin = standardScheme + '://fake-host'
@@ -199,6 +226,24 @@ describe('session module', () => {
       })
     })
 
+    it('emits the filtered changes together with setChangeBatching', (done) => {
+      const { cookies } = session.fromPartition('cookies-changed-batch')
+      cookies.setChangeBatching({ interval: 50, names: ['a', 'b'] })
+      cookies.on('changed', () => {
+        done(new Error('changed should not be emitted'))
+      })
+      cookies.once('changed-batch', (event, changes) => {
+        cookies.setChangeBatching(null)
+        cookies.removeAllListeners('changed')
+        assert.deepStrictEqual(changes.map((change) => change.cookie.name), ['a', 'b'])
+        assert(changes.every((change) => change.cause === 'explicit' && !change.removed))
+        done()
+      })
+      cookies.setBatch(['a', 'b', 'c'].map((name) => ({ url, name, value: name })), (error) => {
+        if (error) return done(error)
+      })
+    })
+
     describe('ses.cookies.flushStore(callback)', () => {
       it('flushes the cookies to disk and invokes the callback when done', (done) => {
         session.defaultSession.cookies.set({
@@ -212,6 +257,17 @@ describe('session module', () => {
           })
         })
       })
+
+      it('returns a promise resolved when the cookies are on disk', (done) => {
+        const ses = session.fromPartition('persist:cookie-commit-policy', {
+          cookieCommitInterval: 100,
+          cookieCommitBatchSize: 16
+        })
+        ses.cookies.set({ url, name: 'foo', value: 'bar' }, (error) => {
+          if (error) return done(error)
+          ses.cookies.flushStore().then(() => done(), done)
+        })
+      })
     })
   })
 
@@ -235,6 +291,39 @@ describe('session module', () => {
         })
       })
     })
+
+    it('reports progress for each storage type and origin', (done) => {
+      const progress = []
+      const options = {
+        origins: ['http://a.localhost', 'http://b.localhost'],
+        storages: ['cookies', 'localstorage', 'indexdb'],
+        progress: (completed, total) => progress.push([completed, total])
+      }
+      session.fromPartition('clear-storage-progress').clearStorageData(options, () => {
+        // One part per origin for cookies and localstorage, and one per
+        // origin and quota type for indexdb.
+        assert.deepStrictEqual(progress, [
+          [1, 8], [2, 8], [3, 8], [4, 8], [5, 8], [6, 8], [7, 8], [8, 8]
+        ])
+        done()
+      })
+    })
+
+    it('calls back before purging other storages with deferPurge', (done) => {
+      let completed = 0
+      const options = {
+        origin: 'http://a.localhost',
+        storages: ['cookies', 'indexdb', 'cachestorage'],
+        deferPurge: true,
+        progress: (count, total) => {
+          completed = count
+          if (count === total) done()
+        }
+      }
+      session.fromPartition('clear-storage-defer').clearStorageData(options, () => {
+        assert(completed >= 1)
+      })
+    })
   })
 
   describe('will-download event', () => {
@@ -467,6 +556,19 @@ describe('session module', () => {
     })
   })
 
+  describe('ses.getDownloadProgress()', () => {
+    it('reports no downloads for a new session', () => {
+      const ses = session.fromPartition('download-progress')
+      ses.setDownloadUpdateThrottle({ interval: 500, bytes: 1024 })
+      assert.deepStrictEqual(ses.getDownloadProgress(), {
+        count: 0,
+        receivedBytes: 0,
+        totalBytes: 0,
+        currentSpeed: 0
+      })
+    })
+  })
+
   describe('ses.protocol', () => {
     const partitionName = 'temp'
     const protocolName = 'sp'
@@ -571,6 +673,168 @@ describe('session module', () => {
         })
       })
     })
+
+    it('resolves multiple URLs at once', (done) => {
+      const config = {
+        proxyRules: 'http=myproxy:80',
+        proxyBypassRules: '<local>'
+      }
+      customSession.setProxy(config, () => {
+        customSession.resolveProxies(['http://localhost', 'http://example.com'], (proxies) => {
+          assert.deepStrictEqual(proxies, ['DIRECT', 'PROXY myproxy:80'])
+          done()
+        })
+      })
+    })
+
+    it('does not reuse cached results after the settings change', (done) => {
+      customSession.setProxy({ proxyRules: 'http=myproxy:80' }, () => {
+        customSession.resolveProxy('http://example.com', (proxy) => {
+          assert.strictEqual(proxy, 'PROXY myproxy:80')
+          customSession.setProxy({ proxyRules: 'http=otherproxy:81' }, () => {
+            customSession.resolveProxy('http://example.com/other', (proxy) => {
+              assert.strictEqual(proxy, 'PROXY otherproxy:81')
+              done()
+            })
+          })
+        })
+      })
+    })
+  })
+
+  describe('ses.getSocketPoolInfo(callback)', () => {
+    let server = null
+    let customSession = null
+
+    afterEach(() => {
+      if (server) {
+        server.close()
+      }
+      if (customSession) {
+        customSession.destroy()
+      }
+    })
+
+    it('reports reused sockets within the session limits', (done) => {
+      customSession = session.fromPartition('socketpool', {
+        maxSocketsPerGroup: 2
+      })
+      const sockets = new Set()
+      server = http.createServer((req, res) => {
+        sockets.add(req.socket)
+        setTimeout(() => res.end('ok'), 50)
+      })
+      server.listen(0, '127.0.0.1', () => {
+        const requestUrl = `http://127.0.0.1:${server.address().port}`
+        const count = 6
+        let finished = 0
+        for (let i = 0; i < count; ++i) {
+          const request = net.request({ url: requestUrl, session: customSession })
+          request.on('response', (response) => {
+            response.on('data', () => {})
+            response.on('end', () => {
+              if (++finished !== count) return
+              assert.strictEqual(sockets.size, 2)
+              customSession.getSocketPoolInfo((info) => {
+                assert(Array.isArray(info.socketPools))
+                assert(Array.isArray(info.http2Sessions))
+                assert.strictEqual(info.networkRequestCount, count)
+                assert.strictEqual(info.reusedSocketCount, count - 2)
+                done()
+              })
+            })
+          })
+          request.end()
+        }
+      })
+    })
+  })
+
+  describe('ses.getCacheStats(callback)', () => {
+    let server = null
+    let customSession = null
+
+    afterEach(() => {
+      if (server) {
+        server.close()
+      }
+      if (customSession) {
+        customSession.destroy()
+      }
+    })
+
+    it('counts the requests served from the cache', (done) => {
+      customSession = session.fromPartition('persist:cachestats', {
+        cacheInMemory: true,
+        cacheSize: 1024 * 1024
+      })
+      server = http.createServer((req, res) => {
+        res.setHeader('Cache-Control', 'max-age=3600')
+        res.end('cached')
+      })
+      server.listen(0, '127.0.0.1', () => {
+        const requestUrl = `http://127.0.0.1:${server.address().port}`
+        const fetch = (callback) => {
+          const request = net.request({ url: requestUrl, session: customSession })
+          request.on('response', (response) => {
+            response.on('data', () => {})
+            response.on('end', callback)
+          })
+          request.end()
+        }
+        fetch(() => fetch(() => {
+          customSession.getCacheStats((stats) => {
+            assert.strictEqual(stats.missCount, 1)
+            assert.strictEqual(stats.hitCount, 1)
+            assert.strictEqual(stats.entryCount, 1)
+            assert.strictEqual(typeof stats.backendStats, 'object')
+            done()
+          })
+        }))
+      })
+    })
+  })
+
+  describe('ses.preconnect(options)', () => {
+    let server = null
+    let customSession = null
+
+    afterEach(() => {
+      if (server) {
+        server.close()
+      }
+      if (customSession) {
+        customSession.destroy()
+      }
+    })
+
+    it('throws for an invalid url', () => {
+      assert.throws(() => {
+        session.defaultSession.preconnect({ url: 'file:///tmp' })
+      }, /Must pass an HTTP or HTTPS url/)
+    })
+
+    it('opens sockets that the first request uses', (done) => {
+      customSession = session.fromPartition('preconnect')
+      let connections = 0
+      server = http.createServer((req, res) => res.end('ok'))
+      server.on('connection', () => {
+        if (++connections > 1) return
+        const requestUrl = `http://127.0.0.1:${server.address().port}`
+        const request = net.request({ url: requestUrl, session: customSession })
+        request.on('response', (response) => {
+          response.on('data', () => {})
+          response.on('end', () => {
+            assert.strictEqual(connections, 1)
+            done()
+          })
+        })
+        request.end()
+      })
+      server.listen(0, '127.0.0.1', () => {
+        customSession.preconnect({ url: `http://127.0.0.1:${server.address().port}` })
+      })
+    })
   })
 
   describe('ses.getBlobData(identifier, callback)', () => {
@@ -624,6 +888,66 @@ describe('session module', () => {
     })
   })
 
+  describe('ses.createBlobReadStream(identifier, options)', () => {
+    const scheme = 'temp-stream'
+    const url = `${scheme}://host`
+    const postData = 'hello blob stream'.repeat(64)
+
+    afterEach((done) => {
+      session.defaultSession.protocol.unregisterProtocol(scheme, () => done())
+    })
+
+    const withBlobUUID = (callback) => {
+      const content = `<html>
+                       <script>
+                       const {webFrame} = require('electron')
+                       webFrame.registerURLSchemeAsPrivileged('${scheme}')
+                       let fd = new FormData();
+                       fd.append('file', new Blob(['${postData}'], {type:'text/plain'}));
+                       fetch('${url}', {method:'POST', body: fd });
+                       </script>
+                       </html>`
+      session.defaultSession.protocol.registerStringProtocol(scheme, (request, respond) => {
+        if (request.method === 'GET') {
+          respond({ data: content, mimeType: 'text/html' })
+        } else if (request.method === 'POST') {
+          callback(request.uploadData[1].blobUUID)
+        }
+      }, (error) => {
+        if (error) throw error
+        w.loadURL(url)
+      })
+    }
+
+    it('reads the blob in chunks', (done) => {
+      withBlobUUID((uuid) => {
+        const chunks = []
+        const stream = session.defaultSession.createBlobReadStream(uuid, { chunkSize: 100 })
+        stream.on('data', (chunk) => {
+          assert(chunk.length <= 100)
+          chunks.push(chunk)
+        })
+        stream.on('end', () => {
+          assert(chunks.length > 1)
+          assert.strictEqual(Buffer.concat(chunks).toString(), postData)
+          done()
+        })
+      })
+    })
+
+    it('saves the blob to a file', (done) => {
+      const filePath = path.join(remote.app.getPath('temp'), `blob-${Date.now()}`)
+      withBlobUUID((uuid) => {
+        session.defaultSession.saveBlobData(uuid, filePath, (error) => {
+          if (error) return done(error)
+          assert.strictEqual(fs.readFileSync(filePath, 'utf8'), postData)
+          fs.unlinkSync(filePath)
+          done()
+        })
+      })
+    })
+  })
+
   describe('ses.setCertificateVerifyProc(callback)', () => {
     let server = null
 
@@ -641,7 +965,7 @@ describe('session module', () => {
       }
 
       server = https.createServer(options, (req, res) => {
-        res.writeHead(200)
+        res.writeHead(200, { 'Connection': 'close' })
         res.end('<title>hello</title>')
       })
       server.listen(0, '127.0.0.1', done)
@@ -689,6 +1013,26 @@ describe('session module', () => {
       })
       w.loadURL(url)
     })
+
+    it('reuses the result for new connections when cacheFor is set', async () => {
+      let verifyCount = 0
+      session.defaultSession.setCertificateVerifyProc((request, callback) => {
+        verifyCount++
+        callback(0)
+      }, { cacheFor: 60000 })
+
+      const load = (path) => {
+        const loaded = new Promise((resolve) => w.webContents.once('did-finish-load', resolve))
+        w.loadURL(`https://127.0.0.1:${server.address().port}${path}`)
+        return loaded
+      }
+
+      // The server closes each connection, so each load verifies the certificate.
+      await load('/first')
+      await load('/second')
+      expect(w.webContents.getTitle()).to.equal('hello')
+      expect(verifyCount).to.equal(1)
+    })
   })
 
   describe('ses.createInterruptedDownload(options)', () => {
@@ -717,6 +1061,25 @@ describe('session module', () => {
       })
     })
 
+    it('keeps the received slices of a parallel download', (done) => {
+      ipcRenderer.sendSync('set-download-option', true, false)
+      const receivedSlices = [
+        { offset: 0, receivedBytes: 1024, finished: false },
+        { offset: 2621440, receivedBytes: 2048, finished: false }
+      ]
+      w.webContents.session.once('will-download', (event, item) => {
+        assert.deepStrictEqual(item.getReceivedSlices(), receivedSlices)
+        done()
+      })
+      w.webContents.session.createInterruptedDownload({
+        path: path.join(__dirname, 'fixtures', 'mock.pdf'),
+        urlChain: ['http://127.0.0.1/'],
+        offset: 3072,
+        length: 5242880,
+        receivedSlices
+      })
+    })
+
     it('can be resumed', (done) => {
       const fixtures = path.join(__dirname, 'fixtures')
       const downloadFilePath = path.join(fixtures, 'logo.png')
@@ -820,6 +1183,182 @@ describe('session module', () => {
     })
   })
 
+  describe('ses.addUserStyleSheet(css)', () => {
+    const partition = 'user-style-sheets'
+    const getColor = () => w.webContents.executeJavaScript(
+      'window.getComputedStyle(document.body).getPropertyValue("color")')
+    const load = () => {
+      const loaded = new Promise((resolve) => w.webContents.once('did-finish-load', resolve))
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'))
+      return loaded
+    }
+
+    beforeEach(async () => {
+      await closeWindow(w)
+      w = new BrowserWindow({ show: false, webPreferences: { partition } })
+    })
+
+    it('adds the stylesheet to new documents until it is removed', async () => {
+      const ses = session.fromPartition(partition)
+      const id = ses.addUserStyleSheet('body { color: rgb(1, 2, 3); }')
+
+      await load()
+      expect(await getColor()).to.equal('rgb(1, 2, 3)')
+
+      expect(ses.removeUserStyleSheet(id)).to.equal(true)
+      expect(ses.removeUserStyleSheet(id)).to.equal(false)
+      await load()
+      expect(await getColor()).to.not.equal('rgb(1, 2, 3)')
+    })
+
+    it('rejects empty stylesheets', () => {
+      expect(() => {
+        session.fromPartition(partition).addUserStyleSheet('')
+      }).to.throw(/must not be empty/)
+    })
+  })
+
+  describe('ses.setNavigationPolicy(policy)', () => {
+    const partition = 'navigation-policy'
+    let server = null
+    let port = 0
+
+    before((done) => {
+      server = http.createServer((req, res) => {
+        if (req.url === '/redirect') {
+          res.statusCode = 302
+          res.setHeader('Location', `http://localhost:${port}/`)
+        }
+        res.end()
+      })
+      server.listen(0, '127.0.0.1', () => {
+        port = server.address().port
+        done()
+      })
+    })
+
+    after(() => {
+      server.close()
+    })
+
+    beforeEach(async () => {
+      await closeWindow(w)
+      w = new BrowserWindow({ show: false, webPreferences: { partition } })
+    })
+
+    afterEach(() => {
+      session.fromPartition(partition).setNavigationPolicy(null)
+    })
+
+    it('cancels redirects to denied domains', (done) => {
+      session.fromPartition(partition).setNavigationPolicy({ deny: ['localhost'] })
+      w.webContents.once('will-redirect', () => {
+        done(new Error('will-redirect was emitted'))
+      })
+      w.webContents.once('did-stop-loading', () => {
+        expect(w.webContents.getURL()).to.not.include('localhost')
+        done()
+      })
+      w.loadURL(`http://127.0.0.1:${port}/redirect`)
+    })
+
+    it('allows redirects to allowed domains without emitting will-redirect', (done) => {
+      session.fromPartition(partition).setNavigationPolicy({ allow: ['localhost'] })
+      w.webContents.once('will-redirect', () => {
+        done(new Error('will-redirect was emitted'))
+      })
+      w.webContents.once('did-stop-loading', () => {
+        expect(w.webContents.getURL()).to.equal(`http://localhost:${port}/`)
+        done()
+      })
+      w.loadURL(`http://127.0.0.1:${port}/redirect`)
+    })
+
+    it('denies file: URLs with the * entry', (done) => {
+      session.fromPartition(partition).setNavigationPolicy({ deny: ['*'] })
+      w.webContents.once('did-fail-load', (event, code) => {
+        expect(code).to.equal(-3)
+        done()
+      })
+      w.webContents.once('did-finish-load', () => {
+        done(new Error('The file: URL was loaded'))
+      })
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'))
+    })
+
+    it('allows file: URLs with a scheme entry', (done) => {
+      session.fromPartition(partition).setNavigationPolicy({ allow: ['file:'], deny: ['*'] })
+      w.webContents.once('did-fail-load', () => {
+        done(new Error('The file: URL was cancelled'))
+      })
+      w.webContents.once('did-finish-load', () => done())
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'))
+    })
+
+    it('denies data: URLs with a scheme entry', (done) => {
+      session.fromPartition(partition).setNavigationPolicy({ deny: ['data:'] })
+      w.webContents.once('did-fail-load', (event, code) => {
+        expect(code).to.equal(-3)
+        done()
+      })
+      w.webContents.once('did-finish-load', () => {
+        done(new Error('The data: URL was loaded'))
+      })
+      w.loadURL('data:text/html,<p>denied</p>')
+    })
+
+    it('rejects invalid domains', () => {
+      expect(() => {
+        session.fromPartition(partition).setNavigationPolicy({ deny: ['exa mple.com'] })
+      }).to.throw(/Invalid domain/)
+    })
+
+    it('rejects invalid schemes', () => {
+      expect(() => {
+        session.fromPartition(partition).setNavigationPolicy({ deny: ['1file:'] })
+      }).to.throw(/Invalid scheme/)
+    })
+  })
+
+  describe('ses.clearPermissionCheckCache()', () => {
+    const partition = 'permission-check-cache'
+
+    afterEach(() => {
+      session.fromPartition(partition).setPermissionCheckHandler(null)
+    })
+
+    it('reuses cacheable decisions until the cache is cleared', async () => {
+      if (remote.getGlobal('isCi')) return
+
+      // The handler has to answer synchronously, so it lives in the main process.
+      ipcRenderer.sendSync('eval', `(() => {
+        global.permissionCheckCount = 0
+        electron.session.fromPartition('${partition}').setPermissionCheckHandler(() => {
+          global.permissionCheckCount++
+          return { granted: false, cacheFor: 60000 }
+        })
+      })()`)
+      const checkCount = () => ipcRenderer.sendSync('eval', 'global.permissionCheckCount')
+      const enumerateDevices = () => w.webContents.executeJavaScript(
+        'navigator.mediaDevices.enumerateDevices().then((devices) => devices.length)')
+
+      await closeWindow(w)
+      w = new BrowserWindow({ show: false, webPreferences: { partition } })
+      const loaded = new Promise((resolve) => w.webContents.once('did-finish-load', resolve))
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'))
+      await loaded
+
+      await enumerateDevices()
+      const count = checkCount()
+      await enumerateDevices()
+      expect(checkCount()).to.equal(count)
+
+      session.fromPartition(partition).clearPermissionCheckCache()
+      await enumerateDevices()
+      expect(checkCount()).to.equal(count * 2)
+    })
+  })
+
   describe('ses.setPermissionRequestHandler(handler)', () => {
     it('cancels any pending requests when cleared', (done) => {
       const ses = session.fromPartition('permissionTest')
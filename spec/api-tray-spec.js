@@ -1,3 +1,4 @@
+const { expect } = require('chai')
 const { remote } = require('electron')
 const { Menu, Tray, nativeImage } = remote
 
@@ -44,4 +45,32 @@ describe('tray module', () => {
       tray.setTitle('')
     })
   })
+  describe('tray.setMouseMoveInterval', () => {
+    it('defaults to 0', () => {
+      expect(tray.getMouseMoveInterval()).to.equal(0)
+    })
+
+    it('clamps negative intervals to 0', () => {
+      tray.setMouseMoveInterval(50)
+      expect(tray.getMouseMoveInterval()).to.equal(50)
+      tray.setMouseMoveInterval(-1)
+      expect(tray.getMouseMoveInterval()).to.equal(0)
+    })
+  })
+
+  describe('tray.setIgnoreMouseEvents', () => {
+    it('toggles the ignored state', () => {
+      expect(tray.getIgnoreMouseEvents()).to.equal(false)
+      tray.setIgnoreMouseEvents(true)
+      expect(tray.getIgnoreMouseEvents()).to.equal(true)
+    })
+  })
+
+  describe('tray.setIgnoreDragEvents', () => {
+    it('toggles the ignored state', () => {
+      expect(tray.getIgnoreDragEvents()).to.equal(false)
+      tray.setIgnoreDragEvents(true)
+      expect(tray.getIgnoreDragEvents()).to.equal(true)
+    })
+  })
 })
@@ -103,6 +103,28 @@ describe('webContents module', () => {
     })
   })
 
+  describe('openDevTools() API', () => {
+    it('reuses the devtools webContents after they were closed', async () => {
+      let opened = emittedOnce(w.webContents, 'devtools-opened')
+      w.webContents.openDevTools({ mode: 'detach' })
+      await opened
+      const { id } = w.webContents.devToolsWebContents
+
+      const closed = emittedOnce(w.webContents, 'devtools-closed')
+      w.webContents.closeDevTools()
+      await closed
+      assert.strictEqual(w.webContents.devToolsWebContents, null)
+      assert.strictEqual(w.webContents.isDevToolsOpened(), false)
+      assert.ok(webContents.getAllWebContents().every(contents => contents.id !== id))
+
+      opened = emittedOnce(w.webContents, 'devtools-opened')
+      w.webContents.openDevTools({ mode: 'detach' })
+      await opened
+      assert.strictEqual(w.webContents.devToolsWebContents.id, id)
+      assert.ok(w.webContents.isDevToolsOpened())
+    })
+  })
+
   describe('setDevToolsWebContents() API', () => {
     it('sets arbitry webContents as devtools', (done) => {
       const devtools = new BrowserWindow({ show: false })
@@ -256,6 +278,20 @@ describe('webContents module', () => {
         }).then(done).catch(done)
       })
     })
+
+    it('is only emitted for keys matching the input event filter', (done) => {
+      w.webContents.once('did-finish-load', () => {
+        w.webContents.setInputEventFilter(['B'])
+        w.webContents.on('before-input-event', (event, input) => {
+          assert.strictEqual(input.key, 'b')
+          w.webContents.setInputEventFilter(null)
+          done()
+        })
+        w.webContents.sendInputEvent({ type: 'keyDown', keyCode: 'a' })
+        w.webContents.sendInputEvent({ type: 'keyDown', keyCode: 'b' })
+      })
+      w.loadFile(path.join(fixtures, 'pages', 'base-page.html'))
+    })
   })
 
   describe('devtools window', () => {
@@ -387,6 +423,42 @@ describe('webContents module', () => {
     })
   })
 
+  describe('sendInputEvents(events)', () => {
+    beforeEach((done) => {
+      w.webContents.once('did-finish-load', () => done())
+      w.loadFile(path.join(fixtures, 'pages', 'mouse-events.html'))
+    })
+
+    it('can send a batch of mouse events', (done) => {
+      ipcMain.once('mousedown', (event, x, y, button, shiftKey, ctrlKey) => {
+        expect([x, y, button, shiftKey, ctrlKey]).to.deep.equal([20, 30, 0, true, false])
+        ipcMain.once('mouseup', (event, x, y, button, shiftKey, ctrlKey) => {
+          expect([x, y, button, shiftKey, ctrlKey]).to.deep.equal([25, 35, 0, false, true])
+          done()
+        })
+      })
+      w.webContents.sendInputEvents(new Float64Array([
+        0, 10, 10, 0, 100,
+        0, 20, 30, 0, 116,
+        1, 20, 30, 1 | 16, 120,
+        0, 25, 35, 16, 132,
+        2, 25, 35, 2, 140
+      ]))
+    })
+
+    it('throws on malformed events', () => {
+      expect(() => {
+        w.webContents.sendInputEvents([0, 10, 10, 0, 100])
+      }).to.throw(/Float64Array/)
+      expect(() => {
+        w.webContents.sendInputEvents(new Float64Array([0, 10, 10, 0]))
+      }).to.throw(/multiple of 5/)
+      expect(() => {
+        w.webContents.sendInputEvents(new Float64Array([42, 10, 10, 0, 100]))
+      }).to.throw(/index 0/)
+    })
+  })
+
   it('supports inserting CSS', (done) => {
     w.loadURL('about:blank')
     w.webContents.insertCSS('body { background-repeat: round; }')
@@ -804,6 +876,37 @@ describe('webContents module', () => {
     })
   })
 
+  describe('setConsoleMessageOptions(options)', () => {
+    it('throws on an unknown level', () => {
+      expect(() => {
+        w.webContents.setConsoleMessageOptions({ minLevel: 'loud' })
+      }).to.throw('Unknown console message level: loud')
+    })
+
+    it('emits the messages in batches', (done) => {
+      w.webContents.setConsoleMessageOptions({ batchInterval: 100 })
+      w.webContents.on('console-messages', (e, messages) => {
+        if (messages.some(m => m.message === 'a')) {
+          w.webContents.setConsoleMessageOptions(null)
+          done()
+        }
+      })
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'))
+    })
+
+    it('drops the messages below minLevel', (done) => {
+      w.webContents.setConsoleMessageOptions({ minLevel: 'error' })
+      w.webContents.on('console-message', (e, level, message) => {
+        if (message === 'a') done(new Error('message was not dropped'))
+      })
+      w.webContents.once('did-finish-load', () => {
+        w.webContents.setConsoleMessageOptions(null)
+        done()
+      })
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'))
+    })
+  })
+
   describe('referrer', () => {
     it('propagates referrer information to new target=_blank windows', (done) => {
       const server = http.createServer((req, res) => {
@@ -916,6 +1019,69 @@ describe('webContents module', () => {
       const promise = w.webContents.takeHeapSnapshot('')
       return expect(promise).to.be.eventually.rejectedWith(Error, 'takeHeapSnapshot failed')
     })
+
+    it('reports the progress of the snapshot', async () => {
+      w.loadURL('about:blank')
+      await emittedOnce(w.webContents, 'did-finish-load')
+
+      const filePath = path.join(remote.app.getPath('temp'), 'progress.heapsnapshot')
+      const phases = []
+      try {
+        await w.webContents.takeHeapSnapshot(filePath, {
+          onProgress: ({ phase }) => phases.push(phase)
+        })
+        expect(phases).to.include('snapshot')
+      } finally {
+        fs.unlinkSync(filePath)
+      }
+    })
+  })
+
+  describe('startHeapSampling() and stopHeapSampling()', () => {
+    it('writes a sampling heap profile', async () => {
+      w.loadURL('about:blank')
+      await emittedOnce(w.webContents, 'did-finish-load')
+
+      const filePath = path.join(remote.app.getPath('temp'), 'test.heapprofile')
+      expect(w.webContents.startHeapSampling({ samplingInterval: 1024 })).to.be.true()
+      await w.webContents.executeJavaScript('window.kept = new Array(100000).fill({})')
+      try {
+        await w.webContents.stopHeapSampling(filePath)
+        const profile = JSON.parse(fs.readFileSync(filePath, 'utf8'))
+        expect(profile.head.callFrame).to.be.an('object')
+        expect(profile.head.children).to.be.an('array')
+      } finally {
+        fs.unlinkSync(filePath)
+      }
+    })
+
+    it('fails when the profiler is not running', async () => {
+      w.loadURL('about:blank')
+      await emittedOnce(w.webContents, 'did-finish-load')
+
+      const filePath = path.join(remote.app.getPath('temp'), 'none.heapprofile')
+      const promise = w.webContents.stopHeapSampling(filePath)
+      await expect(promise).to.be.eventually.rejectedWith(Error, 'stopHeapSampling failed')
+      fs.unlinkSync(filePath)
+    })
+  })
+
+  describe('purgeMemory()', () => {
+    it('reports the memory before and after', async () => {
+      w.loadURL('about:blank')
+      await emittedOnce(w.webContents, 'did-finish-load')
+
+      await w.webContents.executeJavaScript('window.garbage = new Array(100000).fill({}); window.garbage = null')
+      const { before, after } = await w.webContents.purgeMemory()
+      expect(before.jsHeap.used).to.be.a('number')
+      expect(after.jsHeap.used).to.be.at.most(before.jsHeap.used)
+      expect(after.memoryCache.size).to.equal(0)
+    })
+
+    it('rejects an invalid level', async () => {
+      const promise = w.webContents.purgeMemory({ level: 'extreme' })
+      await expect(promise).to.be.eventually.rejectedWith(Error, 'Invalid level: extreme')
+    })
   })
 
   describe('setBackgroundThrottling()', () => {
@@ -945,6 +1111,20 @@ describe('webContents module', () => {
     })
   })
 
+  describe('hibernate()', () => {
+    it('keeps the renderer when background throttling is disabled', (done) => {
+      w.webContents.once('did-finish-load', () => {
+        w.webContents.hibernate((hibernated) => {
+          assert.strictEqual(hibernated, false)
+          assert.strictEqual(w.webContents.isHibernated(), false)
+          assert.ok(w.webContents.getHibernationSnapshot().isEmpty())
+          done()
+        })
+      })
+      w.loadURL('about:blank')
+    })
+  })
+
   describe('getPrinterList()', () => {
     before(function () {
       if (!features.isPrintingEnabled()) {
@@ -1000,5 +1180,37 @@ describe('webContents module', () => {
         })
       })
     })
+
+    it('can print to a PDF file', (done) => {
+      const pdfPath = path.join(remote.app.getPath('temp'), 'print-to-pdf-spec.pdf')
+      w.loadURL('data:text/html,%3Ch1%3EHello%2C%20World!%3C%2Fh1%3E')
+      w.webContents.once('did-finish-load', () => {
+        w.webContents.printToPDF({ path: pdfPath }, function (error, data) {
+          assert.strictEqual(error, null)
+          assert.strictEqual(data, null)
+          assert.notStrictEqual(fs.statSync(pdfPath).size, 0)
+          fs.unlinkSync(pdfPath)
+          done()
+        })
+      })
+    })
+
+    it('can run several print jobs at the same time', (done) => {
+      w.loadURL('data:text/html,%3Ch1%3EHello%2C%20World!%3C%2Fh1%3E')
+      w.webContents.once('did-finish-load', () => {
+        const results = []
+        const onPrinted = (index) => (error, data) => {
+          assert.strictEqual(error, null)
+          assert.strictEqual(data instanceof Buffer, true)
+          assert.notStrictEqual(data.length, 0)
+          assert.strictEqual(results[index], undefined)
+          results[index] = data
+          if (results.filter(Boolean).length === 3) done()
+        }
+        w.webContents.printToPDF({}, onPrinted(0))
+        w.webContents.printToPDF({ landscape: true }, onPrinted(1))
+        w.webContents.printToPDF({ pageSize: 'A3' }, onPrinted(2))
+      })
+    })
   })
 })
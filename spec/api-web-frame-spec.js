@@ -5,7 +5,7 @@ const path = require('path')
 const { closeWindow } = require('./window-helpers')
 const { remote, webFrame } = require('electron')
 const { BrowserWindow, protocol, ipcMain } = remote
-const { emittedOnce } = require('./events-helpers')
+const { emittedOnce, waitForEvent } = require('./events-helpers')
 
 const { expect } = chai
 chai.use(dirtyChai)
@@ -138,6 +138,89 @@ describe('webFrame module', function () {
     }
   })
 
+  describe('webFrame.executeJavaScriptInFrames', () => {
+    let iframes = []
+
+    beforeEach(async () => {
+      iframes = ['first', 'second'].map((name) => {
+        const iframe = document.createElement('iframe')
+        iframe.name = name
+        iframe.srcdoc = `<title>${name}</title>`
+        document.body.appendChild(iframe)
+        return iframe
+      })
+      await Promise.all(iframes.map((iframe) => waitForEvent(iframe, 'load')))
+    })
+
+    afterEach(() => {
+      for (const iframe of iframes) iframe.remove()
+      iframes = []
+    })
+
+    it('returns the results of all the frames', () => {
+      const results = webFrame.executeJavaScriptInFrames('({ name: window.name, title: document.title })')
+      expect(results[0].routingId).to.equal(webFrame.routingId)
+      const subframes = results.filter(({ result }) => ['first', 'second'].includes(result.name))
+      expect(subframes.map(({ result }) => result)).to.deep.equal([
+        { name: 'first', title: 'first' },
+        { name: 'second', title: 'second' }
+      ])
+      for (const { routingId } of subframes) {
+        expect(webFrame.findFrameByRoutingId(routingId)).to.not.be.null()
+      }
+    })
+
+    it('reports errors for each frame', () => {
+      const results = webFrame.executeJavaScriptInFrames('throw new Error("boom")')
+      expect(results).to.have.lengthOf.at.least(3)
+      for (const { error, result } of results) {
+        expect(error).to.match(/boom/)
+        expect(result).to.be.undefined()
+      }
+    })
+
+    it('reports results that can not be cloned', () => {
+      const [{ error }] = webFrame.executeJavaScriptInFrames('(() => {})')
+      expect(error).to.match(/could not be cloned/)
+    })
+
+    it('runs the script in an isolated world', () => {
+      webFrame.executeJavaScriptInFrames('window.isolatedValue = 42', { worldId: 1000 })
+      const isolated = webFrame.executeJavaScriptInFrames('window.isolatedValue', { worldId: 1000 })
+      const main = webFrame.executeJavaScriptInFrames('typeof window.isolatedValue')
+      expect(isolated.map(({ result }) => result)).to.deep.equal(isolated.map(() => 42))
+      expect(main.map(({ result }) => result)).to.deep.equal(main.map(() => 'undefined'))
+    })
+  })
+
+  describe('webFrame.copyToMainWorld', () => {
+    afterEach(() => {
+      delete window.copiedValue
+    })
+
+    it('copies the value with the structured clone algorithm', () => {
+      const value = { date: new Date(0), map: new Map([['a', 1]]), list: [1, 'two'] }
+      webFrame.copyToMainWorld('copiedValue', value)
+      expect(window.copiedValue).to.not.equal(value)
+      expect(window.copiedValue).to.deep.equal(value)
+    })
+
+    it('moves transferred ArrayBuffers', () => {
+      const array = new Uint8Array([1, 2, 3, 4])
+      const view = array.subarray(1, 3)
+      webFrame.copyToMainWorld('copiedValue', { array, view }, [array.buffer])
+      expect(array.buffer.byteLength).to.equal(0)
+      const { array: copiedArray, view: copiedView } = window.copiedValue
+      expect(Array.from(copiedView)).to.deep.equal([2, 3])
+      expect(copiedView.buffer).to.equal(copiedArray.buffer)
+    })
+
+    it('throws for values that can not be cloned', () => {
+      expect(() => webFrame.copyToMainWorld('copiedValue', () => {})).to.throw()
+      expect(window.copiedValue).to.be.undefined()
+    })
+  })
+
   it('supports setting the visual and layout zoom level limits', function () {
     assert.doesNotThrow(function () {
       webFrame.setVisualZoomLevelLimits(1, 50)
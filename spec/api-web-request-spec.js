@@ -78,6 +78,29 @@ describe('webRequest module', () => {
       })
     })
 
+    it('can filter URLs with many patterns', (done) => {
+      const urls = []
+      for (let i = 0; i < 1000; i++) {
+        urls.push(`*://*.host${i}.com/*`, `http://host${i}.org/filter/*`)
+      }
+      urls.push(defaultURL + 'filter/*')
+      ses.webRequest.onBeforeRequest({ urls }, (details, callback) => {
+        callback({ cancel: true })
+      })
+      $.ajax({
+        url: `${defaultURL}nofilter/test`,
+        success: (data) => {
+          assert.strictEqual(data, '/nofilter/test')
+          $.ajax({
+            url: `${defaultURL}filter/test`,
+            success: () => done('unexpected success'),
+            error: () => done()
+          })
+        },
+        error: (xhr, errorType) => done(errorType)
+      })
+    })
+
     it('receives details object', (done) => {
       ses.webRequest.onBeforeRequest((details, callback) => {
         assert.strictEqual(typeof details.id, 'number')
@@ -162,6 +185,21 @@ describe('webRequest module', () => {
       })
     })
 
+    it('passes the headers as plain properties', (done) => {
+      ses.webRequest.onBeforeSendHeaders((details, callback) => {
+        assert.ok(Object.keys(details).includes('requestHeaders'))
+        const { requestHeaders } = JSON.parse(JSON.stringify(details))
+        assert.deepStrictEqual(requestHeaders, details.requestHeaders)
+        callback({})
+      })
+      $.ajax({
+        url: defaultURL,
+        headers: { 'Foo.Bar': 'baz' },
+        success: () => done(),
+        error: (xhr, errorType) => done(errorType)
+      })
+    })
+
     it('can change the request headers', (done) => {
       ses.webRequest.onBeforeSendHeaders((details, callback) => {
         const requestHeaders = details.requestHeaders
@@ -382,6 +420,138 @@ describe('webRequest module', () => {
     })
   })
 
+  describe('webRequest.setRules', () => {
+    afterEach(() => {
+      ses.webRequest.setRules(null)
+      ses.webRequest.onSendHeaders(null)
+    })
+
+    it('throws for invalid rules', () => {
+      assert.throws(() => {
+        ses.webRequest.setRules([{ redirectURL: 'not a url' }])
+      }, /valid rules/)
+      assert.throws(() => {
+        ses.webRequest.setRules([{ requestHeaders: { Test: 1 } }])
+      }, /valid rules/)
+    })
+
+    it('can cancel the request', (done) => {
+      ses.webRequest.setRules([{ urls: [defaultURL + '*'], cancel: true }])
+      $.ajax({
+        url: defaultURL,
+        success: () => done('unexpected success'),
+        error: () => done()
+      })
+    })
+
+    it('can filter URLs', (done) => {
+      ses.webRequest.setRules([{ urls: [defaultURL + 'nofilter/*'], cancel: true }])
+      $.ajax({
+        url: `${defaultURL}nofilter/test`,
+        success: () => done('unexpected success'),
+        error: () => {
+          $.ajax({
+            url: `${defaultURL}filter/test`,
+            success: (data) => {
+              assert.strictEqual(data, '/filter/test')
+              done()
+            },
+            error: (xhr, errorType) => done(errorType)
+          })
+        }
+      })
+    })
+
+    it('can redirect the request', (done) => {
+      ses.webRequest.setRules([{
+        urls: [defaultURL + 'redirect'],
+        redirectURL: defaultURL + 'redirected'
+      }])
+      $.ajax({
+        url: defaultURL + 'redirect',
+        success: (data) => {
+          assert.strictEqual(data, '/redirected')
+          done()
+        },
+        error: (xhr, errorType) => done(errorType)
+      })
+    })
+
+    it('can change the request headers', (done) => {
+      ses.webRequest.setRules([{
+        requestHeaders: { Accept: '*/*;test/header', Test: 'header' }
+      }])
+      ses.webRequest.onSendHeaders((details) => {
+        assert.strictEqual(details.requestHeaders.Test, 'header')
+      })
+      $.ajax({
+        url: defaultURL,
+        success: (data) => {
+          assert.strictEqual(data, '/header/received')
+          done()
+        },
+        error: (xhr, errorType) => done(errorType)
+      })
+    })
+
+    it('can change the response headers', (done) => {
+      ses.webRequest.setRules([{
+        responseHeaders: { Custom: null, Rule: 'header' }
+      }])
+      $.ajax({
+        url: defaultURL,
+        success: (data, status, xhr) => {
+          assert.strictEqual(xhr.getResponseHeader('Custom'), null)
+          assert.strictEqual(xhr.getResponseHeader('Rule'), 'header')
+          done()
+        },
+        error: (xhr, errorType) => done(errorType)
+      })
+    })
+  })
+
+  describe('webRequest.setCompletionLog', () => {
+    const fs = require('fs')
+    const os = require('os')
+    const path = require('path')
+    const logPath = path.join(os.tmpdir(), `electron-request-log-${Date.now()}.log`)
+
+    afterEach(() => {
+      ses.webRequest.setCompletionLog(null)
+      if (fs.existsSync(logPath)) fs.unlinkSync(logPath)
+    })
+
+    it('throws for invalid options', () => {
+      assert.throws(() => {
+        ses.webRequest.setCompletionLog({})
+      }, /path of the log/)
+      assert.throws(() => {
+        ses.webRequest.setCompletionLog({ path: logPath, fields: ['unknown'] })
+      }, /Unknown log field: unknown/)
+    })
+
+    it('writes the completed requests to the file', (done) => {
+      ses.webRequest.setCompletionLog({ path: logPath, fields: ['method', 'url', 'statusCode'] })
+      $.ajax({
+        url: defaultURL + 'logged',
+        success: () => {
+          // Stopping the log writes the remaining lines.
+          ses.webRequest.setCompletionLog(null)
+          const interval = setInterval(() => {
+            if (!fs.existsSync(logPath)) return
+            const lines = fs.readFileSync(logPath, 'utf8').split('\n').filter(line => line)
+            const record = lines.map(line => JSON.parse(line)).find(record => record.url === defaultURL + 'logged')
+            if (!record) return
+            clearInterval(interval)
+            assert.deepStrictEqual(record, { method: 'GET', url: defaultURL + 'logged', statusCode: 200 })
+            done()
+          }, 100)
+        },
+        error: (xhr, errorType) => done(errorType)
+      })
+    })
+  })
+
   describe('webRequest.onErrorOccurred', () => {
     afterEach(() => {
       ses.webRequest.onErrorOccurred(null)
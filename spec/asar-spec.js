@@ -942,6 +942,98 @@ describe('asar package', function () {
       })
     })
 
+    describe('require.resolve', function () {
+      it('resolves the extension of a module in archive', function () {
+        const p = path.join(fixtures, 'asar', 'a.asar', 'ping')
+        assert.strictEqual(require.resolve(p), `${p}.js`)
+      })
+
+      it('throws for a module that does not exist in archive', function () {
+        const p = path.join(fixtures, 'asar', 'a.asar', 'not-exist')
+        assert.throws(() => require.resolve(p), /Cannot find module/)
+      })
+    })
+
+    describe('archive with binary index', function () {
+      const archive = path.join(fixtures, 'asar', 'indexed.asar')
+
+      it('reads a normal file', function () {
+        assert.strictEqual(fs.readFileSync(path.join(archive, 'file1')).toString().trim(), 'file1')
+        assert.strictEqual(fs.readFileSync(path.join(archive, 'dir1', 'file2')).toString().trim(), 'file2')
+      })
+
+      it('reads a file from linked directory', function () {
+        const p = path.join(archive, 'link2', 'link2', 'file1')
+        assert.strictEqual(fs.readFileSync(p).toString().trim(), 'file1')
+      })
+
+      it('reads dirs', function () {
+        const dirs = fs.readdirSync(path.join(archive, 'dir1'))
+        assert.deepStrictEqual(dirs, ['file1', 'file2', 'file3', 'link1', 'link2'])
+      })
+
+      it('returns information of a directory or link', function () {
+        assert.strictEqual(fs.lstatSync(path.join(archive, 'dir3')).isDirectory(), true)
+        assert.strictEqual(fs.lstatSync(path.join(archive, 'link1')).isSymbolicLink(), true)
+      })
+
+      it('throws ENOENT error when can not find file', function () {
+        assert.throws(() => {
+          fs.readFileSync(path.join(archive, 'not-exist'))
+        }, /ENOENT/)
+      })
+    })
+
+    describe('archive with block hashes', function () {
+      const archive = path.join(fixtures, 'asar', 'integrity.asar')
+
+      it('reads a file with valid block hashes', function (done) {
+        assert.strictEqual(fs.readFileSync(path.join(archive, 'file1'), 'utf8').trim(), 'file1')
+        fs.readFile(path.join(archive, 'file1'), function (err, content) {
+          assert.strictEqual(err, null)
+          assert.strictEqual(String(content).trim(), 'file1')
+          done()
+        })
+      })
+
+      it('throws when the block hashes do not match', function () {
+        assert.throws(() => {
+          fs.readFileSync(path.join(archive, 'file2'))
+        }, /Invalid package/)
+        assert.throws(() => {
+          fs.readFileSync(path.join(archive, 'file2'), 'latin1')
+        }, /Invalid package/)
+      })
+
+      it('fails to read asynchronously when the block hashes do not match', function (done) {
+        fs.readFile(path.join(archive, 'file2'), function (err) {
+          assert.ok(/Invalid package/.test(err.message))
+          done()
+        })
+      })
+    })
+
+    describe('archive with compressed files', function () {
+      const archive = path.join(fixtures, 'asar', 'compressed.asar')
+
+      it('reads a compressed file', function () {
+        assert.strictEqual(fs.readFileSync(path.join(archive, 'file1'), 'utf8').trim(), 'file1')
+        assert.strictEqual(fs.readFileSync(path.join(archive, 'file2'), 'utf8').trim(), 'file2')
+      })
+
+      it('reads a compressed file asynchronously', function (done) {
+        fs.readFile(path.join(archive, 'file1'), function (err, content) {
+          assert.strictEqual(err, null)
+          assert.strictEqual(String(content).trim(), 'file1')
+          done()
+        })
+      })
+
+      it('returns the uncompressed size', function () {
+        assert.strictEqual(fs.lstatSync(path.join(archive, 'file1')).size, 6)
+      })
+    })
+
     describe('util.promisify', function () {
       it('can promisify all fs functions', function () {
         const originalFs = require('original-fs')
@@ -1103,6 +1195,35 @@ describe('asar package', function () {
       })
     })
 
+    it('can request a file with valid block hashes', function (done) {
+      const p = path.resolve(fixtures, 'asar', 'integrity.asar', 'file1')
+      $.get('file://' + p, function (data) {
+        assert.strictEqual(data.trim(), 'file1')
+        done()
+      })
+    })
+
+    it('fails to request a file with invalid block hashes', function (done) {
+      const p = path.resolve(fixtures, 'asar', 'integrity.asar', 'file2')
+      $.ajax({
+        url: 'file://' + p,
+        success: function () {
+          done(new Error('request should fail'))
+        },
+        error: function () {
+          done()
+        }
+      })
+    })
+
+    it('can request a compressed file in package', function (done) {
+      const p = path.resolve(fixtures, 'asar', 'compressed.asar', 'file1')
+      $.get('file://' + p, function (data) {
+        assert.strictEqual(data.trim(), 'file1')
+        done()
+      })
+    })
+
     it('gets 404 when file is not found', function (done) {
       const p = path.resolve(fixtures, 'asar', 'a.asar', 'no-exist')
       $.ajax({
@@ -1175,6 +1296,22 @@ describe('asar package', function () {
     })
   })
 
+  describe('internal modules', function () {
+    const asar = process.atomBinding('asar')
+
+    it('are compiled into the binary', function () {
+      expect(asar.hasInternalModule('renderer/init.js')).to.equal(true)
+      expect(asar.hasInternalModule('renderer/does-not-exist.js')).to.equal(false)
+      expect(asar.getInternalModuleSource('renderer/does-not-exist.js')).to.equal(undefined)
+    })
+
+    it('match the files of electron.asar', function () {
+      const initPath = path.join(process.resourcesPath, 'electron.asar', 'renderer', 'init.js')
+      const source = asar.getInternalModuleSource('renderer/init.js')
+      expect(source).to.equal(fs.readFileSync(initPath, 'utf8'))
+    })
+  })
+
   describe('original-fs module', function () {
     const originalFs = require('original-fs')
 
@@ -0,0 +1,109 @@
+// Runs the benchmark suites in a hidden window and writes the results as
+// JSON, see script/benchmark-runner.js.
+
+const { app, BrowserWindow, ipcMain } = require('electron')
+const fs = require('fs')
+const path = require('path')
+
+const measure = require('./measure')
+require('./network')
+require('./offscreen')
+const payloads = require('./suites/payloads')
+
+const argv = require('minimist')(process.argv.slice(2))
+
+// The latency of the messages received since the last collection, the
+// renderer collects them once it has sent everything.
+let latencies = []
+ipcMain.on('benchmark-message', (event, sentAt) => {
+  latencies.push(payloads.now() - sentAt)
+})
+ipcMain.on('benchmark-collect', (event) => {
+  event.returnValue = { latencies }
+  latencies = []
+})
+
+ipcMain.on('benchmark-sync', (event) => {
+  event.returnValue = null
+})
+
+ipcMain.on('benchmark-web-contents-send', (event, shape, size, count) => {
+  const payload = payloads.create(shape, size)
+  for (let i = 0; i < count; i++) {
+    event.sender.send('benchmark-message', payloads.now(), payload)
+  }
+})
+
+// The calls are made in batches, so the loop of measure() is not what is
+// timed.
+const kCallsPerIteration = 1000
+ipcMain.on('benchmark-calls', (event) => {
+  const contents = event.sender
+  const calls = {
+    'webContents.id': () => contents.id,
+    'webContents.isDestroyed()': () => contents.isDestroyed(),
+    'webContents.getURL()': () => contents.getURL(),
+    'webContents.getProcessId()': () => contents.getProcessId(),
+    'webContents.isLoading()': () => contents.isLoading(),
+    'webContents.getTitle()': () => contents.getTitle()
+  }
+  event.returnValue = Object.keys(calls).map((name) => {
+    const call = calls[name]
+    const result = measure(name, () => {
+      for (let i = 0; i < kCallsPerIteration; i++) call()
+    }, { minTime: 500 })
+    result.opsPerSecond *= kCallsPerIteration
+    return result
+  })
+})
+
+ipcMain.on('benchmark-results', (event, results) => {
+  const output = JSON.stringify({
+    version: process.versions.electron,
+    platform: process.platform,
+    arch: process.arch,
+    date: new Date().toISOString(),
+    results
+  }, null, 2)
+
+  if (argv.output) {
+    fs.writeFileSync(argv.output, output)
+  } else {
+    console.log(output)
+  }
+  app.exit(0)
+})
+
+ipcMain.on('benchmark-error', (event, message) => {
+  console.error(message)
+  app.exit(1)
+})
+
+const createWindow = function () {
+  return new BrowserWindow({
+    show: false,
+    webPreferences: {
+      backgroundThrottling: false
+    }
+  })
+}
+
+app.on('ready', () => {
+  // Receives the messages of the sendTo benchmark.
+  const peer = createWindow()
+  peer.loadFile(path.join(__dirname, 'peer.html'))
+
+  peer.webContents.once('did-finish-load', () => {
+    const window = createWindow()
+    window.loadFile(path.join(__dirname, 'index.html'), {
+      query: {
+        suite: argv.suite || '',
+        maxSize: argv['max-size'] || '',
+        maxFiles: argv['max-files'] || '',
+        maxRequests: argv['max-requests'] || '',
+        maxHeight: argv['max-height'] || '',
+        peerId: String(peer.webContents.id)
+      }
+    })
+  })
+})
@@ -0,0 +1,30 @@
+const { performance } = require('perf_hooks')
+
+// Calls |fn| until |minTime| milliseconds have elapsed, the first calls are
+// not measured so the code is optimized before the timing starts.
+module.exports = function (name, fn, { warmup = 10, minTime = 1000 } = {}) {
+  for (let i = 0; i < warmup; i++) fn()
+
+  let iterations = 0
+  const start = performance.now()
+  let elapsed = 0
+  while (elapsed < minTime) {
+    fn()
+    iterations++
+    elapsed = performance.now() - start
+  }
+  return {
+    name,
+    iterations,
+    totalMs: elapsed,
+    opsPerSecond: iterations * 1000 / elapsed
+  }
+}
+
+// Returns the nearest-rank percentile of the ascending |sorted| values, |p| is
+// between 0 and 1.
+module.exports.percentile = function (sorted, p) {
+  if (sorted.length === 0) return 0
+  const rank = Math.ceil(sorted.length * p)
+  return sorted[Math.min(sorted.length, Math.max(1, rank)) - 1]
+}
@@ -0,0 +1,199 @@
+// The main process side of the network suite. Pages with many subresources are
+// loaded in a hidden window, served or intercepted by one mechanism at a time.
+
+const { BrowserWindow, ipcMain, protocol, session } = require('electron')
+const fs = require('fs')
+const http = require('http')
+const https = require('https')
+const path = require('path')
+const { PassThrough } = require('stream')
+const { performance } = require('perf_hooks')
+
+const { percentile } = require('./measure')
+
+protocol.registerStandardSchemes(['benchmark-buffer', 'benchmark-stream'])
+
+const kStyle = 'body { margin: 0 }\n'
+
+// Every subresource is a stylesheet, the load event waits for all of them.
+const createPage = function (count, run) {
+  const links = []
+  for (let i = 0; i < count; i++) {
+    links.push(`<link rel="stylesheet" href="res/${i}.css?run=${run}">`)
+  }
+  return `<html><head>
+<script>performance.setResourceTimingBufferSize(${count + 10})</script>
+${links.join('\n')}
+</head><body></body></html>`
+}
+
+const respond = function (url) {
+  const { pathname, searchParams } = new URL(url)
+  if (pathname.startsWith('/res/')) return { mimeType: 'text/css', data: kStyle }
+  const page = createPage(Number(searchParams.get('count')), searchParams.get('run'))
+  return { mimeType: 'text/html', data: page }
+}
+
+const serve = function (request, response) {
+  const { mimeType, data } = respond(`http://localhost${request.url}`)
+  response.writeHead(200, { 'Content-Type': mimeType, 'Cache-Control': 'no-store' })
+  response.end(data)
+}
+
+const listen = function (server) {
+  return new Promise((resolve) => {
+    server.listen(0, '127.0.0.1', () => resolve(server.address().port))
+  })
+}
+
+let servers = null
+const startServers = async function () {
+  if (servers) return servers
+  const certPath = path.join(__dirname, '..', 'fixtures', 'certificates')
+  const httpsServer = https.createServer({
+    key: fs.readFileSync(path.join(certPath, 'server.key')),
+    cert: fs.readFileSync(path.join(certPath, 'server.pem'))
+  }, serve)
+  servers = {
+    http: `http://127.0.0.1:${await listen(http.createServer(serve))}/`,
+    https: `https://127.0.0.1:${await listen(httpsServer)}/`
+  }
+  return servers
+}
+
+const promisify = function (method, ...args) {
+  return new Promise((resolve, reject) => {
+    method.call(protocol, ...args, (error) => error ? reject(error) : resolve())
+  })
+}
+
+// Each mechanism is set up with |time|, which wraps the handlers so the time
+// they spend on the main thread is counted.
+const mechanisms = {
+  http: {
+    setup: async () => (await startServers()).http
+  },
+
+  bufferProtocol: {
+    async setup (time) {
+      await promisify(protocol.registerBufferProtocol, 'benchmark-buffer',
+        time((request, callback) => {
+          const { mimeType, data } = respond(request.url)
+          callback({ mimeType, data: Buffer.from(data) })
+        }))
+      return 'benchmark-buffer://benchmark/'
+    },
+    teardown: () => promisify(protocol.unregisterProtocol, 'benchmark-buffer')
+  },
+
+  streamProtocol: {
+    async setup (time) {
+      await promisify(protocol.registerStreamProtocol, 'benchmark-stream',
+        time((request, callback) => {
+          const { mimeType, data } = respond(request.url)
+          const stream = new PassThrough()
+          stream.end(data)
+          callback({ statusCode: 200, headers: { 'content-type': mimeType }, data: stream })
+        }))
+      return 'benchmark-stream://benchmark/'
+    },
+    teardown: () => promisify(protocol.unregisterProtocol, 'benchmark-stream')
+  },
+
+  // The requests are sent again without a session, so they are not
+  // intercepted a second time.
+  interceptHttpProtocol: {
+    async setup (time) {
+      const { http: url } = await startServers()
+      await promisify(protocol.interceptHttpProtocol, 'http',
+        time((request, callback) => {
+          callback({ url: request.url, method: request.method, session: null })
+        }))
+      return url
+    },
+    teardown: () => promisify(protocol.uninterceptProtocol, 'http')
+  },
+
+  // Only the last of the |filters| URL patterns matches the requests.
+  webRequest: {
+    async setup (time, filters) {
+      const urls = []
+      for (let i = 1; i < filters; i++) urls.push(`*://host${i}.invalid/*`)
+      urls.push('*://127.0.0.1/*')
+      session.defaultSession.webRequest.onBeforeRequest({ urls },
+        time((details, callback) => callback({})))
+      return (await startServers()).http
+    },
+    teardown: async () => session.defaultSession.webRequest.onBeforeRequest(null)
+  },
+
+  certificateVerifyProc: {
+    async setup (time) {
+      session.defaultSession.setCertificateVerifyProc(
+        time((request, callback) => callback(0)))
+      return (await startServers()).https
+    },
+    teardown: async () => session.defaultSession.setCertificateVerifyProc(null)
+  }
+}
+
+const load = function (window, url) {
+  return new Promise((resolve, reject) => {
+    window.webContents.once('did-finish-load', resolve)
+    window.webContents.once('did-fail-load', (event, code, description) => {
+      reject(new Error(`Loading ${url} failed: ${description}`))
+    })
+    window.loadURL(url)
+  })
+}
+
+const runCase = async function (name, count, filters, run) {
+  const mechanism = mechanisms[name]
+  if (!mechanism) throw new Error(`Unknown mechanism ${name}`)
+
+  let handlerMs = 0
+  const time = (fn) => function (...args) {
+    const start = performance.now()
+    try {
+      return fn.apply(this, args)
+    } finally {
+      handlerMs += performance.now() - start
+    }
+  }
+
+  const baseURL = await mechanism.setup(time, filters)
+  const window = new BrowserWindow({
+    show: false,
+    webPreferences: { backgroundThrottling: false }
+  })
+  try {
+    const cpuUsage = process.cpuUsage()
+    const start = performance.now()
+    await load(window, `${baseURL}page?count=${count}&run=${run}`)
+    const totalMs = performance.now() - start
+    const { user, system } = process.cpuUsage(cpuUsage)
+
+    const durations = await window.webContents.executeJavaScript(
+      `performance.getEntriesByType('resource').map((entry) => entry.duration)`)
+    durations.sort((a, b) => a - b)
+    return {
+      requests: durations.length,
+      totalMs,
+      handlerMs,
+      browserCpuMs: (user + system) / 1000,
+      p50Ms: percentile(durations, 0.5),
+      p99Ms: percentile(durations, 0.99)
+    }
+  } finally {
+    window.destroy()
+    if (mechanism.teardown) await mechanism.teardown()
+  }
+}
+
+ipcMain.on('benchmark-network', (event, name, count, filters, run) => {
+  runCase(name, count, filters, run).then((result) => {
+    event.sender.send('benchmark-network-result', result)
+  }, (error) => {
+    event.sender.send('benchmark-network-result', { error: error.stack })
+  })
+})
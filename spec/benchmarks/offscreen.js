@@ -0,0 +1,199 @@
+// The main process side of the offscreen suite. An animated page is rendered
+// offscreen at a given size and frame rate, and its frames are counted while
+// the paint handlers of OffScreenRenderWidgetHostView are traced.
+
+const { app, BrowserWindow, contentTracing, ipcMain } = require('electron')
+const fs = require('fs')
+const path = require('path')
+const { performance } = require('perf_hooks')
+
+const { percentile } = require('./measure')
+
+const kWarmupMs = 500
+const kDurationMs = 2000
+const kLatencyFrames = 60
+// A begin frame that has not been painted after this many frame intervals is
+// counted as missed.
+const kMissedFrameIntervals = 4
+
+const kPaintEvents = [
+  'OffScreenRenderWidgetHostView::OnPaint',
+  'OffScreenRenderWidgetHostView::OnTexturePaint'
+]
+const kComposeEvent = 'OffScreenCompositionBuffer::Compose'
+
+const delay = (ms) => new Promise((resolve) => setTimeout(resolve, ms))
+
+// Calls |onFrame| with the bytes copied for each frame and whether the frame
+// was passed as a shared texture.
+const listen = function (contents, mode, onFrame) {
+  if (mode === 'paintRegions') {
+    contents.on('paint-regions', (event, regions) => {
+      onFrame(regions.reduce((bytes, { buffer }) => bytes + buffer.length, 0))
+    })
+  } else {
+    contents.on('paint', (event, dirty, image, texture) => {
+      if (texture) {
+        texture.release()
+        onFrame(0, true)
+      } else {
+        onFrame(dirty.width * dirty.height * 4, false)
+      }
+    })
+  }
+}
+
+const startTracing = function () {
+  return new Promise((resolve) => {
+    contentTracing.startRecording({
+      categoryFilter: 'electron',
+      traceOptions: 'record-until-full'
+    }, resolve)
+  })
+}
+
+// Returns the thread time of the paint handlers in the browser process, or
+// their wall time when the platform does not record thread times.
+const stopTracing = function () {
+  return new Promise((resolve) => {
+    contentTracing.stopRecording('', (tracePath) => {
+      const trace = JSON.parse(fs.readFileSync(tracePath, 'utf8'))
+      fs.unlinkSync(tracePath)
+      const events = Array.isArray(trace) ? trace : trace.traceEvents
+      const totals = { paintUs: 0, composeUs: 0 }
+      for (const event of events) {
+        if (event.ph !== 'X' || event.pid !== process.pid) continue
+        const duration = event.tdur != null ? event.tdur : event.dur
+        if (kPaintEvents.includes(event.name)) totals.paintUs += duration
+        if (event.name === kComposeEvent) totals.composeUs += duration
+      }
+      resolve(totals)
+    })
+  })
+}
+
+// Sends |kLatencyFrames| begin frames at the frame rate and measures how long
+// each takes to reach the paint handler.
+const measureLatency = async function (contents, fps, nextFrame) {
+  const latencies = []
+  let missed = 0
+  const interval = 1000 / fps
+  contents.setExternalBeginFrames(true)
+  try {
+    for (let i = 0; i < kLatencyFrames; i++) {
+      const painted = nextFrame(interval * kMissedFrameIntervals)
+      const start = performance.now()
+      contents.sendBeginFrame()
+      if (await painted) {
+        latencies.push(performance.now() - start)
+      } else {
+        missed++
+      }
+      await delay(Math.max(0, interval - (performance.now() - start)))
+    }
+  } finally {
+    contents.setExternalBeginFrames(false)
+  }
+  latencies.sort((a, b) => a - b)
+  return {
+    latencyP50Ms: percentile(latencies, 0.5),
+    latencyP99Ms: percentile(latencies, 0.99),
+    missedFrames: missed
+  }
+}
+
+const load = function (window, fixture) {
+  return new Promise((resolve, reject) => {
+    window.webContents.once('did-finish-load', resolve)
+    window.webContents.once('did-fail-load', (event, code, description) => {
+      reject(new Error(`Loading the ${fixture} fixture failed: ${description}`))
+    })
+    window.loadFile(path.join(__dirname, 'offscreen.html'), {
+      query: { fixture }
+    })
+  })
+}
+
+const runCase = async function (mode, fixture, width, height, fps) {
+  const window = new BrowserWindow({
+    show: false,
+    width,
+    height,
+    useContentSize: true,
+    enableLargerThanScreen: true,
+    webPreferences: {
+      offscreen: true,
+      sharedTexture: mode === 'sharedTexture',
+      paintRegions: mode === 'paintRegions',
+      backgroundThrottling: false
+    }
+  })
+  const contents = window.webContents
+
+  let frames = 0
+  let bytes = 0
+  let textures = 0
+  let waiting = null
+  listen(contents, mode, (frameBytes, texture) => {
+    frames++
+    bytes += frameBytes
+    if (texture) textures++
+    if (waiting) waiting(true)
+  })
+  // Resolves with whether a frame was painted within |timeout| milliseconds.
+  const nextFrame = (timeout) => new Promise((resolve) => {
+    const timer = setTimeout(() => {
+      waiting = null
+      resolve(false)
+    }, timeout)
+    waiting = (painted) => {
+      clearTimeout(timer)
+      waiting = null
+      resolve(painted)
+    }
+  })
+
+  try {
+    contents.setFrameRate(fps)
+    await load(window, fixture)
+    await delay(kWarmupMs)
+
+    await startTracing()
+    frames = bytes = textures = 0
+    const start = performance.now()
+    await delay(kDurationMs)
+    const elapsedMs = performance.now() - start
+    const counted = { frames, bytes, textures }
+    const { paintUs, composeUs } = await stopTracing()
+
+    // The frames were passed as bitmaps, the platform can not share them.
+    if (mode === 'sharedTexture' && counted.textures === 0) {
+      return { supported: false }
+    }
+
+    const perFrame = (value) => counted.frames > 0 ? value / counted.frames : 0
+    return Object.assign({
+      supported: true,
+      frames: counted.frames,
+      fps: counted.frames * 1000 / elapsedMs,
+      bytesPerFrame: perFrame(counted.bytes),
+      paintMsPerFrame: perFrame(paintUs) / 1000,
+      composeMsPerFrame: perFrame(composeUs) / 1000
+    }, await measureLatency(contents, fps, nextFrame))
+  } finally {
+    window.destroy()
+  }
+}
+
+ipcMain.on('benchmark-offscreen', (event, mode, fixture, width, height, fps) => {
+  runCase(mode, fixture, width, height, fps).then((result) => {
+    event.sender.send('benchmark-offscreen-result', result)
+  }, (error) => {
+    event.sender.send('benchmark-offscreen-result', { error: error.stack })
+  })
+})
+
+ipcMain.on('benchmark-offscreen-compositing', (event) => {
+  const { gpu_compositing: status } = app.getGPUFeatureStatus()
+  event.returnValue = status && status.startsWith('enabled') ? 'gpu' : 'software'
+})
@@ -0,0 +1,36 @@
+const { ipcRenderer } = require('electron')
+
+const measure = require('./measure')
+
+const suites = {
+  asar: require('./suites/asar'),
+  calls: require('./suites/calls'),
+  converter: require('./suites/converter'),
+  ipc: require('./suites/ipc'),
+  network: require('./suites/network'),
+  offscreen: require('./suites/offscreen')
+}
+
+const run = async function () {
+  const query = new URLSearchParams(window.location.search)
+  const options = {
+    maxSize: query.get('maxSize'),
+    maxFiles: query.get('maxFiles'),
+    maxRequests: query.get('maxRequests'),
+    maxHeight: query.get('maxHeight'),
+    peerId: Number(query.get('peerId'))
+  }
+  const selected = query.get('suite')
+  const results = []
+  for (const name of Object.keys(suites)) {
+    if (selected && selected !== name) continue
+    for (const result of await suites[name]({ measure, options })) {
+      results.push(Object.assign({ suite: name }, result))
+    }
+  }
+  ipcRenderer.send('benchmark-results', results)
+}
+
+run().catch((error) => {
+  ipcRenderer.send('benchmark-error', error.stack)
+})
@@ -0,0 +1,11 @@
+// The app measured by default by script/startup-benchmark.js, it shows a
+// window the way apps usually do.
+
+const { app, BrowserWindow } = require('electron')
+const path = require('path')
+
+app.on('ready', () => {
+  const window = new BrowserWindow({ show: false })
+  window.once('ready-to-show', () => window.show())
+  window.loadFile(path.join(__dirname, 'index.html'))
+})
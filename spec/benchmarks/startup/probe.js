@@ -0,0 +1,60 @@
+// Loaded with --require by script/startup-benchmark.js before the measured app,
+// it records when the startup phases happen and prints them once the first
+// window is ready to show. The times are in milliseconds since the benchmark
+// launched the process.
+
+const { app, ipcMain, session } = require('electron')
+const path = require('path')
+
+const launchTime = Number(process.env.ELECTRON_STARTUP_BENCHMARK_LAUNCH_TIME)
+const since = (time) => time - launchTime
+
+const timings = {
+  mainProcess: since(process.getCreationTime()),
+  probeLoaded: since(Date.now())
+}
+
+// The cold runs get a new user data directory, the warm ones reuse one.
+if (process.env.ELECTRON_STARTUP_BENCHMARK_USER_DATA) {
+  app.setPath('userData', process.env.ELECTRON_STARTUP_BENCHMARK_USER_DATA)
+}
+
+let windowReady = false
+let rendererTimings = null
+let firstContents = null
+
+const report = function () {
+  if (!windowReady || !rendererTimings) return
+  Object.assign(timings, rendererTimings)
+  console.log(`STARTUP-BENCHMARK ${JSON.stringify(timings)}`)
+  app.exit(0)
+}
+
+app.once('ready', () => {
+  timings.ready = since(Date.now())
+  session.defaultSession.setPreloads(
+    session.defaultSession.getPreloads().concat(path.join(__dirname, 'renderer-probe.js')))
+})
+
+app.once('browser-window-created', (event, window) => {
+  timings.windowCreated = since(Date.now())
+  firstContents = window.webContents
+  // Windows that are shown right away are ready at their first paint.
+  const onReady = () => {
+    if (windowReady) return
+    timings.readyToShow = since(Date.now())
+    windowReady = true
+    report()
+  }
+  window.once('ready-to-show', onReady)
+  window.once('show', onReady)
+})
+
+ipcMain.on('startup-benchmark-renderer', (event, renderer) => {
+  if (rendererTimings || event.sender !== firstContents) return
+  rendererTimings = {}
+  for (const name of Object.keys(renderer)) {
+    rendererTimings[name] = since(renderer[name])
+  }
+  report()
+})
@@ -0,0 +1,20 @@
+// Added to the session preloads by probe.js, it runs before the preload of the
+// window, right after the script context and its Node environment are
+// created.
+
+const { ipcRenderer } = require('electron')
+
+const timings = {
+  rendererProcess: process.getCreationTime(),
+  scriptContext: Date.now()
+}
+
+// Emitted once all the preload scripts have run.
+process.once('loaded', () => {
+  timings.preloadDone = Date.now()
+})
+
+document.addEventListener('DOMContentLoaded', () => {
+  timings.domContentLoaded = Date.now()
+  ipcRenderer.send('startup-benchmark-renderer', timings)
+})
@@ -0,0 +1,110 @@
+// Writes synthetic asar archives for the asar suite. The files are spread over
+// directories of 100 files, like the node_modules of an app.
+
+const fs = require('fs')
+const path = require('path')
+
+const kFilesPerDirectory = 100
+const kModuleCount = 100
+const kLargeFileSize = 16 * 1024 * 1024
+
+exports.sizes = [1000, 10000, 100000]
+exports.largeFileSize = kLargeFileSize
+
+exports.filePath = function (index) {
+  return path.join(`dir${Math.floor(index / kFilesPerDirectory)}`, `file${index}.js`)
+}
+
+// The modules required by the require() benchmark, |index.js| requires all
+// the others.
+const getModules = function () {
+  const modules = new Map()
+  const requires = []
+  for (let i = 0; i < kModuleCount; i++) {
+    modules.set(`mod${i}.js`, `exports.value = ${i}\nexports.name = 'mod${i}'\n`)
+    requires.push(`require('./mod${i}')`)
+  }
+  modules.set('index.js', `module.exports = [\n  ${requires.join(',\n  ')}\n]\n`)
+  return modules
+}
+
+// The asar header is a Pickle holding the JSON string, preceded by a Pickle
+// holding the size of the first one.
+const createHeader = function (header) {
+  const json = Buffer.from(JSON.stringify(header))
+  const stringSize = 4 + json.length + ((4 - json.length % 4) % 4)
+  const buffer = Buffer.alloc(8 + 4 + stringSize)
+  buffer.writeUInt32LE(4, 0)
+  buffer.writeUInt32LE(4 + stringSize, 4)
+  buffer.writeUInt32LE(stringSize, 8)
+  buffer.writeUInt32LE(json.length, 12)
+  json.copy(buffer, 16)
+  return buffer
+}
+
+const addFile = function (root, filePath, size, offset) {
+  let node = root
+  for (const name of path.dirname(filePath).split(path.sep)) {
+    if (name === '.') continue
+    if (!node.files[name]) node.files[name] = { files: {} }
+    node = node.files[name]
+  }
+  node.files[path.basename(filePath)] = { size, offset: String(offset) }
+}
+
+// Writes an archive with |fileCount| small files, the modules in |modules/|
+// and |large.bin|. Returns the size of its header.
+exports.create = function (archivePath, fileCount) {
+  const root = { files: {} }
+  const contents = []
+  let offset = 0
+  const add = function (filePath, content) {
+    const data = Buffer.isBuffer(content) ? content : Buffer.from(content)
+    addFile(root, filePath, data.length, offset)
+    contents.push(data)
+    offset += data.length
+  }
+
+  for (let i = 0; i < fileCount; i++) {
+    add(exports.filePath(i), `module.exports = ${i}\n`)
+  }
+  for (const [name, content] of getModules()) {
+    add(path.join('modules', name), content)
+  }
+  add('large.bin', Buffer.alloc(kLargeFileSize, 'x'))
+
+  const header = createHeader(root)
+  const fd = fs.openSync(archivePath, 'w')
+  try {
+    fs.writeSync(fd, header)
+    for (const data of contents) fs.writeSync(fd, data)
+  } finally {
+    fs.closeSync(fd)
+  }
+  return header.length
+}
+
+// Writes the modules of the archives to a directory.
+exports.createModules = function (directory) {
+  fs.mkdirSync(directory)
+  for (const [name, content] of getModules()) {
+    fs.writeFileSync(path.join(directory, name), content)
+  }
+}
+
+exports.remove = function (target) {
+  const noAsar = process.noAsar
+  process.noAsar = true
+  try {
+    if (fs.lstatSync(target).isDirectory()) {
+      for (const name of fs.readdirSync(target)) {
+        exports.remove(path.join(target, name))
+      }
+      fs.rmdirSync(target)
+    } else {
+      fs.unlinkSync(target)
+    }
+  } finally {
+    process.noAsar = noAsar
+  }
+}
@@ -0,0 +1,113 @@
+// Measures reading asar archives through lib/common/asar.js and
+// URLRequestAsarJob, on synthetic archives of growing sizes. The native side
+// of the archives is measured by the electron_asar_benchmark executable.
+
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+
+const archives = require('./archives')
+const payloads = require('./payloads')
+
+// The lookups are made in batches, so the loop of measure() is not what is
+// timed.
+const kLookupsPerIteration = 1000
+
+const toFileURL = function (filePath) {
+  const prefix = process.platform === 'win32' ? 'file:///' : 'file://'
+  return prefix + filePath.replace(/\\/g, '/')
+}
+
+// Removes the modules under |directory| from the cache, so require() loads
+// them again.
+const forgetModules = function (directory) {
+  for (const name of Object.keys(require.cache)) {
+    if (name.startsWith(directory)) delete require.cache[name]
+  }
+}
+
+const measureRequire = function (measure, name, directory) {
+  const index = path.join(directory, 'index.js')
+  return measure(name, () => {
+    forgetModules(directory)
+    require(index)
+  }, { minTime: 500 })
+}
+
+// Runs |fn| until |minTime| milliseconds have elapsed and returns the bytes
+// read per second.
+const measureThroughput = async function (name, fn, { minTime = 1000 } = {}) {
+  await fn()
+  let bytes = 0
+  let iterations = 0
+  const start = payloads.now()
+  let elapsed = 0
+  while (elapsed < minTime) {
+    bytes += await fn()
+    iterations++
+    elapsed = payloads.now() - start
+  }
+  return {
+    name,
+    iterations,
+    totalMs: elapsed,
+    bytesPerSecond: bytes * 1000 / elapsed
+  }
+}
+
+const measureArchive = async function (measure, archivePath, fileCount) {
+  const results = []
+  const files = Array.from({ length: kLookupsPerIteration }, (_, i) => {
+    return path.join(archivePath, archives.filePath(i * 7919 % fileCount))
+  })
+  const lookup = function (name, fn) {
+    const result = measure(`${name} (${fileCount} files)`, () => {
+      for (const file of files) fn(file)
+    }, { minTime: 500 })
+    result.opsPerSecond *= kLookupsPerIteration
+    results.push(result)
+  }
+  lookup('fs.statSync', (file) => fs.statSync(file))
+  lookup('fs.existsSync', (file) => fs.existsSync(file))
+  lookup('fs.readFileSync small', (file) => fs.readFileSync(file))
+  results.push(measure(`fs.readdirSync (${fileCount} files)`, () => {
+    fs.readdirSync(archivePath)
+    fs.readdirSync(path.dirname(files[0]))
+  }, { minTime: 500 }))
+
+  const largeFile = path.join(archivePath, 'large.bin')
+  results.push(await measureThroughput(`fs.readFileSync large (${fileCount} files)`, () => {
+    return fs.readFileSync(largeFile).length
+  }))
+  results.push(await measureThroughput(`fetch large (${fileCount} files)`, async () => {
+    const response = await window.fetch(toFileURL(largeFile))
+    return (await response.arrayBuffer()).byteLength
+  }))
+
+  results.push(measureRequire(measure, `require packed (${fileCount} files)`,
+    path.join(archivePath, 'modules')))
+  return results
+}
+
+module.exports = async function ({ measure, options }) {
+  const maxFiles = Number(options.maxFiles) || Infinity
+  const directory = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-asar-benchmark-'))
+  const results = []
+  try {
+    const unpacked = path.join(directory, 'modules')
+    archives.createModules(unpacked)
+    results.push(measureRequire(measure, 'require unpacked', unpacked))
+
+    for (const fileCount of archives.sizes) {
+      if (fileCount > maxFiles) continue
+      const archivePath = path.join(directory, `archive-${fileCount}.asar`)
+      const headerSize = archives.create(archivePath, fileCount)
+      for (const result of await measureArchive(measure, archivePath, fileCount)) {
+        results.push(Object.assign({ files: fileCount, headerSize }, result))
+      }
+    }
+  } finally {
+    archives.remove(directory)
+  }
+  return results
+}
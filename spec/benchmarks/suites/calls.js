@@ -0,0 +1,9 @@
+// Measures the overhead of calling native methods, through the getters of
+// webContents that apps call at high rates. The calls are made by the main
+// process, which owns the webContents of this renderer.
+
+const { ipcRenderer } = require('electron')
+
+module.exports = async function () {
+  return ipcRenderer.sendSync('benchmark-calls')
+}
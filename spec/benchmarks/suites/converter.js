@@ -0,0 +1,34 @@
+// Measures the conversion of arguments to base::Value, through the cost of
+// ipcRenderer.send for payloads that stress different paths of
+// V8ValueConverter.
+
+const { ipcRenderer } = require('electron')
+const payloads = require('./payloads')
+
+const converterPayloads = {
+  // An array of objects with the same shape, like the rows of a table.
+  rows: Array.from({ length: 1000 }, (_, i) => ({
+    id: i,
+    name: `row ${i}`,
+    price: i * 1.5,
+    enabled: i % 2 === 0,
+    tags: ['a', 'b'],
+    owner: { id: i, email: `user${i}@example.com` }
+  })),
+  integers: Array.from({ length: 100000 }, (_, i) => i),
+  doubles: Array.from({ length: 100000 }, (_, i) => i + 0.5),
+  asciiString: 'x'.repeat(1024 * 1024),
+  unicodeString: 'ü€'.repeat(512 * 1024)
+}
+
+module.exports = async function ({ measure }) {
+  const results = []
+  for (const name of Object.keys(converterPayloads)) {
+    const payload = converterPayloads[name]
+    results.push(measure(name, () => {
+      ipcRenderer.send('benchmark-message', payloads.now(), payload)
+    }))
+    ipcRenderer.sendSync('benchmark-collect')
+  }
+  return results
+}
@@ -0,0 +1,98 @@
+// Measures the throughput and latency of the IPC methods. Each case sends a
+// burst of messages and waits for all of them to arrive, the latency of each
+// message is measured by the receiver, so it includes the time spent queued.
+
+const { ipcRenderer } = require('electron')
+const { percentile } = require('../measure')
+const payloads = require('./payloads')
+
+// Bounds the number of bytes sent by each case.
+const kBytesPerCase = 256 * 1024 * 1024
+
+const getCount = function (size) {
+  return Math.max(5, Math.min(1000, Math.floor(kBytesPerCase / size)))
+}
+
+const summarize = function (count, size, elapsed, latencies) {
+  const sorted = latencies.slice().sort((a, b) => a - b)
+  return {
+    count,
+    messagesPerSecond: count * 1000 / elapsed,
+    bytesPerSecond: count * size * 1000 / elapsed,
+    p50Ms: percentile(sorted, 0.5),
+    p99Ms: percentile(sorted, 0.99)
+  }
+}
+
+// Messages sent to this renderer by the main process.
+let received = []
+let onReceived = null
+ipcRenderer.on('benchmark-message', (event, sentAt) => {
+  received.push(payloads.now() - sentAt)
+  if (onReceived) onReceived()
+})
+
+const methods = {
+  send (payload, count) {
+    for (let i = 0; i < count; i++) {
+      ipcRenderer.send('benchmark-message', payloads.now(), payload)
+    }
+    // Synchronous messages are handled after the pending asynchronous ones.
+    return ipcRenderer.sendSync('benchmark-collect').latencies
+  },
+
+  sendSync (payload, count) {
+    const latencies = []
+    for (let i = 0; i < count; i++) {
+      const start = payloads.now()
+      ipcRenderer.sendSync('benchmark-sync', payload)
+      latencies.push(payloads.now() - start)
+    }
+    return latencies
+  },
+
+  sendTo (payload, count, { peerId }) {
+    return new Promise((resolve) => {
+      ipcRenderer.once('benchmark-collected', (event, result) => {
+        resolve(result.latencies)
+      })
+      for (let i = 0; i < count; i++) {
+        ipcRenderer.sendTo(peerId, 'benchmark-message', payloads.now(), payload)
+      }
+      ipcRenderer.sendTo(peerId, 'benchmark-collect')
+    })
+  },
+
+  // The payload is created by the main process.
+  webContentsSend (payload, count, { shape, size }) {
+    return new Promise((resolve) => {
+      received = []
+      onReceived = () => {
+        if (received.length < count) return
+        onReceived = null
+        resolve(received)
+      }
+      ipcRenderer.send('benchmark-web-contents-send', shape, size, count)
+    })
+  }
+}
+
+module.exports = async function ({ options }) {
+  const maxSize = Number(options.maxSize) || Infinity
+  const results = []
+  for (const method of Object.keys(methods)) {
+    for (const shape of payloads.shapes) {
+      for (const size of payloads.sizes) {
+        if (size > maxSize) continue
+        const payload = method === 'webContentsSend' ? null : payloads.create(shape, size)
+        const count = getCount(size)
+        const start = payloads.now()
+        const latencies = await methods[method](payload, count, { peerId: options.peerId, shape, size })
+        const elapsed = payloads.now() - start
+        results.push(Object.assign({ name: `${method} ${shape} ${size}`, method, shape, size },
+          summarize(count, size, elapsed, latencies)))
+      }
+    }
+  }
+  return results
+}
@@ -0,0 +1,55 @@
+// Measures what serving or intercepting requests costs, by loading pages with
+// 100 to 5000 stylesheets through each mechanism. The pages are loaded by the
+// main process, see ../network.js, and each case is compared with the same
+// page served by a plain HTTP server.
+
+const { ipcRenderer } = require('electron')
+
+const counts = [100, 1000, 5000]
+
+// The mechanisms and the number of URL patterns of their filter.
+const cases = [
+  ['http', 0],
+  ['bufferProtocol', 0],
+  ['streamProtocol', 0],
+  ['interceptHttpProtocol', 0],
+  ['webRequest', 1],
+  ['webRequest', 100],
+  ['certificateVerifyProc', 0]
+]
+
+const load = function (mechanism, count, filters, run) {
+  return new Promise((resolve, reject) => {
+    ipcRenderer.once('benchmark-network-result', (event, result) => {
+      if (result.error) {
+        reject(new Error(result.error))
+      } else {
+        resolve(result)
+      }
+    })
+    ipcRenderer.send('benchmark-network', mechanism, count, filters, run)
+  })
+}
+
+module.exports = async function ({ options }) {
+  const maxRequests = Number(options.maxRequests) || Infinity
+  const results = []
+  // Every page uses new URLs, so nothing is cached between the cases.
+  let run = 0
+  for (const count of counts) {
+    if (count > maxRequests) continue
+    let baseline = null
+    for (const [mechanism, filters] of cases) {
+      const result = await load(mechanism, count, filters, run++)
+      if (baseline === null) baseline = result
+      const name = filters > 0
+        ? `${mechanism} ${filters} filters ${count}`
+        : `${mechanism} ${count}`
+      results.push(Object.assign({ name, mechanism, filters, count }, result, {
+        addedMsPerRequest: (result.totalMs - baseline.totalMs) / count,
+        handlerMsPerRequest: result.handlerMs / count
+      }))
+    }
+  }
+  return results
+}
@@ -0,0 +1,45 @@
+// Measures offscreen rendering, by animating a page at 720p, 1080p and 4K for
+// each frame rate and way of passing frames. The windows are created by the
+// main process, see ../offscreen.js. The compositing is done on the GPU unless
+// the benchmarks are run with --disable-gpu.
+
+const { ipcRenderer } = require('electron')
+
+const sizes = [[1280, 720], [1920, 1080], [3840, 2160]]
+const frameRates = [30, 60, 120]
+const modes = ['paint', 'paintRegions', 'sharedTexture']
+const fixtures = ['full', 'partial']
+
+const render = function (mode, fixture, width, height, fps) {
+  return new Promise((resolve, reject) => {
+    ipcRenderer.once('benchmark-offscreen-result', (event, result) => {
+      if (result.error) {
+        reject(new Error(result.error))
+      } else {
+        resolve(result)
+      }
+    })
+    ipcRenderer.send('benchmark-offscreen', mode, fixture, width, height, fps)
+  })
+}
+
+module.exports = async function ({ options }) {
+  const maxHeight = Number(options.maxHeight) || Infinity
+  const compositing = ipcRenderer.sendSync('benchmark-offscreen-compositing')
+  const results = []
+  for (const [width, height] of sizes) {
+    if (height > maxHeight) continue
+    for (const fps of frameRates) {
+      for (const mode of modes) {
+        for (const fixture of fixtures) {
+          const result = await render(mode, fixture, width, height, fps)
+          const name = `${mode} ${fixture} ${height}p ${fps}fps`
+          results.push(Object.assign({
+            name, compositing, mode, fixture, width, height, targetFps: fps
+          }, result))
+        }
+      }
+    }
+  }
+  return results
+}
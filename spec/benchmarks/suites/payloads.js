@@ -0,0 +1,40 @@
+// Payloads of a given shape whose serialized size is roughly |size| bytes.
+
+const createObject = function (size) {
+  // Each item is about 64 bytes in JSON.
+  const count = Math.max(1, Math.floor(size / 64))
+  return Array.from({ length: count }, (_, i) => ({
+    id: i,
+    name: 'item',
+    child: { enabled: true, values: [i, i + 1] }
+  }))
+}
+
+const shapes = {
+  string: (size) => 'x'.repeat(size),
+  object: createObject,
+  // Sent as a Buffer, which is how ArrayBuffers are carried by send.
+  arrayBuffer: (size) => Buffer.from(new ArrayBuffer(size))
+}
+
+exports.shapes = Object.keys(shapes)
+
+exports.sizes = [
+  16,
+  1024,
+  64 * 1024,
+  1024 * 1024,
+  16 * 1024 * 1024,
+  64 * 1024 * 1024
+]
+
+exports.create = function (shape, size) {
+  return shapes[shape](size)
+}
+
+// Returns the current time in milliseconds, as a monotonic clock that is
+// shared by all the processes on the machine.
+exports.now = function () {
+  const [seconds, nanoseconds] = process.hrtime()
+  return seconds * 1e3 + nanoseconds / 1e6
+}
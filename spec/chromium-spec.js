@@ -746,6 +746,26 @@ describe('chromium feature', () => {
       b = window.open(`file://${fixtures}/pages/window-open-postMessage.html`, '', 'show=no')
     })
 
+    it('keeps values that can only be structured-cloned', (done) => {
+      let b = null
+      listener = (event) => {
+        window.removeEventListener('message', listener)
+        b.close()
+        assert.ok(event.data.map instanceof Map)
+        assert.strictEqual(event.data.map.get('key'), 'value')
+        assert.ok(event.data.date instanceof Date)
+        assert.strictEqual(event.source, b)
+        done()
+      }
+      window.addEventListener('message', listener)
+      app.once('browser-window-created', (event, { webContents }) => {
+        webContents.once('did-finish-load', () => {
+          b.postMessage({ map: new Map([['key', 'value']]), date: new Date() }, '*')
+        })
+      })
+      b = window.open(`file://${fixtures}/pages/window-open-postMessage-echo.html`, '', 'show=no')
+    })
+
     it('throws an exception when the targetOrigin cannot be converted to a string', () => {
       const b = window.open('')
       assert.throws(() => {
@@ -0,0 +1,26 @@
+const { app, BrowserWindow } = require('electron')
+
+app.commandLine.appendSwitch('--disable-software-rasterizer')
+
+const updates = []
+app.on('gpu-info-update', (event, info) => {
+  updates.push(info)
+})
+
+app.on('ready', async () => {
+  try {
+    await app.getGPUInfo('complete')
+    // Using WebGL makes the GPU process report its info again.
+    const window = new BrowserWindow({ show: false })
+    await window.loadURL('data:text/html,<canvas></canvas><script>' +
+      'document.querySelector("canvas").getContext("webgl")</script>')
+    await app.getGPUInfo('complete')
+    setTimeout(() => {
+      console.log(JSON.stringify(updates))
+      app.exit(0)
+    }, 1000)
+  } catch (error) {
+    console.error(error)
+    app.exit(1)
+  }
+})
@@ -0,0 +1,41 @@
+const { app } = require('electron')
+const net = require('net')
+
+const socketPath = process.platform === 'win32' ? '\\\\.\\pipe\\electron-app-relaunch' : '/tmp/electron-app-relaunch'
+
+process.on('uncaughtException', () => {
+  app.exit(1)
+})
+
+// The second instance starts while the first one is still running, it only
+// gets the lock when the first one handed it over.
+const second = process.argv[process.argv.length - 1] === '--second'
+const locked = app.requestSingleInstanceLock()
+
+app.on('second-instance', () => {
+  app.exit(1)
+})
+
+app.once('ready', () => {
+  const client = net.connect(socketPath)
+  client.once('connect', () => {
+    if (!second) {
+      client.end('first')
+    } else {
+      client.end(locked ? 'locked' : 'not-locked')
+    }
+  })
+  client.once('end', () => {
+    if (second) {
+      app.exit(0)
+      return
+    }
+    app.relaunch({
+      args: process.argv.slice(1).concat('--second'),
+      waitForExit: false
+    })
+    // Stay alive a moment, so the second instance starts while this one
+    // still runs.
+    setTimeout(() => app.exit(0), 1000)
+  })
+})
@@ -0,0 +1,17 @@
+const { app, BrowserWindow } = require('electron')
+
+// Exits with 0 when "window-all-closed" is emitted while a closed recyclable
+// window is pooled.
+app.on('window-all-closed', () => app.exit(0))
+
+app.on('ready', () => {
+  setTimeout(() => app.exit(1), 10000)
+
+  const other = new BrowserWindow({ show: false })
+  const recyclable = new BrowserWindow({ show: false, recyclable: true })
+  recyclable.once('closed', () => {
+    if (BrowserWindow.getAllWindows().length !== 1) app.exit(2)
+    other.close()
+  })
+  recyclable.close()
+})
@@ -0,0 +1,3 @@
+const fs = require('fs')
+const { parentPort, workerData } = require('worker_threads')
+parentPort.postMessage(fs.readFileSync(workerData, 'utf8').trim())
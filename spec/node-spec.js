@@ -298,6 +298,20 @@ describe('node feature', () => {
     })
   })
 
+  describe('worker_threads in the main process', () => {
+    it('can read files in asar archives', (done) => {
+      const { Worker } = remote.require('worker_threads')
+      const worker = new Worker(path.join(fixtures, 'workers', 'node_worker_asar.js'), {
+        workerData: path.join(fixtures, 'asar', 'a.asar', 'file1')
+      })
+      worker.once('message', (message) => {
+        expect(message).to.equal('file1')
+        worker.terminate()
+        done()
+      })
+    })
+  })
+
   describe('net.connect', () => {
     before(function () {
       if (process.platform !== 'darwin') {
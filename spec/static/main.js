@@ -48,6 +48,30 @@ ipcMain.on('message', function (event, ...args) {
   event.sender.send('message', ...args)
 })
 
+ipcMain.on('message-serialized', function (event, ...args) {
+  event.sender.sendSerialized('message', ...args)
+})
+
+ipcMain.on('message-transfer', function (event, message) {
+  event.sender.postMessage('message', message, [message])
+})
+
+ipcMain.on('message-batched', function (event, messages) {
+  event.sender.send('message', messages)
+})
+
+ipcMain.handle('invoke-echo', function (event, ...args) {
+  return args
+})
+
+ipcMain.handle('invoke-async', function (event, value) {
+  return new Promise(resolve => setTimeout(() => resolve(value * 2), 10))
+})
+
+ipcMain.handle('invoke-throw', function (event) {
+  throw new Error('handler failed')
+})
+
 // Set productName so getUploadedReports() uses the right directory in specs
 if (process.platform !== 'darwin') {
   crashReporter.productName = 'Zombies'
@@ -1284,6 +1284,28 @@ describe('<webview> tag', function () {
       const [, id] = await emittedOnce(ipcMain, 'webview-dom-ready')
       expect(webContents.id).to.equal(id)
     })
+
+    it('attaches a webview to a pooled guest', async () => {
+      const guestCreated = new Promise(resolve => {
+        const listener = (event, contents) => {
+          if (!contents.isGuest()) return
+          app.removeListener('web-contents-created', listener)
+          resolve(contents)
+        }
+        app.on('web-contents-created', listener)
+      })
+      const w = await openTheWindow({
+        show: false,
+        webPreferences: { webviewTag: true, webviewPoolSize: 1 }
+      })
+      const pooledGuest = await guestCreated
+      w.loadFile(path.join(fixtures, 'pages', 'webview-did-attach-event.html'))
+
+      const [, webContents] = await emittedOnce(w.webContents, 'did-attach-webview')
+      expect(webContents.id).to.equal(pooledGuest.id)
+      const [, id] = await emittedOnce(ipcMain, 'webview-dom-ready')
+      expect(webContents.id).to.equal(id)
+    })
   })
 
   it('loads devtools extensions registered on the parent window', async () => {
@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+
+# Generates a header with the sources of Electron's internal modules, which
+# is compiled into the binary so they can be loaded without reading
+# electron.asar.
+#
+# Usage: embed-internal-modules.py <output> <root> <sources...>
+
+import os
+import sys
+
+
+TEMPLATE = """// This file is generated by tools/embed-internal-modules.py, do not edit.
+
+#ifndef ATOM_INTERNAL_MODULES_DATA_H_
+#define ATOM_INTERNAL_MODULES_DATA_H_
+
+#include "atom/common/internal_modules.h"
+
+namespace atom {{
+
+namespace {{
+
+{definitions}
+
+// Sorted by path.
+const InternalModule kInternalModules[] = {{
+{entries}
+}};
+
+}}  // namespace
+
+}}  // namespace atom
+
+#endif  // ATOM_INTERNAL_MODULES_DATA_H_
+"""
+
+
+def to_c_array(name, data):
+  lines = []
+  for i in range(0, len(data), 20):
+    lines.append(','.join(str(c) for c in data[i:i + 20]))
+  return 'const uint8_t {0}[] = {{\n{1}\n}};'.format(name, ',\n'.join(lines))
+
+
+def is_ascii(data):
+  return all(c < 128 for c in data)
+
+
+def main():
+  output = sys.argv[1]
+  root = os.path.abspath(sys.argv[2])
+  sources = sorted(sys.argv[3:],
+                   key=lambda s: os.path.relpath(os.path.abspath(s), root))
+
+  definitions = []
+  entries = []
+  for index, source in enumerate(sources):
+    path = os.path.relpath(os.path.abspath(source), root).replace('\\', '/')
+    with open(source, 'rb') as f:
+      data = bytearray(f.read())
+    name = 'kSource{0}'.format(index)
+    # Empty arrays are not valid C++.
+    definitions.append(to_c_array(name, data or bytearray(1)))
+    entries.append('    {{"{0}", {1}, {2}, {3}}},'.format(
+        path, name, len(data), 'true' if is_ascii(data) else 'false'))
+
+  content = TEMPLATE.format(definitions='\n\n'.join(definitions),
+                            entries='\n'.join(entries))
+  with open(output, 'w') as f:
+    f.write(content)
+
+
+if __name__ == '__main__':
+  sys.exit(main())
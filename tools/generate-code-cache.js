@@ -0,0 +1,40 @@
+// Generates the V8 code cache of the modules in electron.asar, which is read
+// by lib/common/code-cache.js. It must be run by the built Electron with
+// ELECTRON_RUN_AS_NODE, so the cache matches its V8.
+//
+// Usage: generate-code-cache.js path/to/electron.asar path/to/output
+
+const fs = require('fs')
+const Module = require('module')
+const path = require('path')
+const vm = require('vm')
+
+const codeCache = require('../lib/common/code-cache')
+
+const asarPath = path.resolve(process.argv[2])
+const outputPath = path.resolve(process.argv[3])
+
+function listFiles (dir, prefix, result) {
+  for (const name of fs.readdirSync(dir)) {
+    const filePath = path.join(dir, name)
+    const relativePath = prefix ? `${prefix}/${name}` : name
+    if (fs.statSync(filePath).isDirectory()) {
+      listFiles(filePath, relativePath, result)
+    } else if (name.endsWith('.js')) {
+      result.push(relativePath)
+    }
+  }
+  return result
+}
+
+const entries = []
+for (const name of listFiles(asarPath, '', [])) {
+  // Same as what Node's module loader compiles.
+  const content = fs.readFileSync(path.join(asarPath, name), 'utf8').replace(/^\uFEFF/, '')
+  const script = new vm.Script(Module.wrap(content), {
+    filename: path.join(asarPath, name)
+  })
+  entries.push([name, script.createCachedData()])
+}
+
+fs.writeFileSync(outputPath, codeCache.serialize(entries))
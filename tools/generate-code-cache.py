@@ -0,0 +1,22 @@
+#!/usr/bin/env python
+
+import os
+import subprocess
+import sys
+
+SOURCE_ROOT = os.path.abspath(os.path.dirname(os.path.dirname(__file__)))
+
+
+def main():
+  electron = sys.argv[1]
+  archive = sys.argv[2]
+  output = sys.argv[3]
+
+  env = os.environ.copy()
+  env['ELECTRON_RUN_AS_NODE'] = '1'
+  script = os.path.join(SOURCE_ROOT, 'tools', 'generate-code-cache.js')
+  return subprocess.call([electron, script, archive, output], env=env)
+
+
+if __name__ == '__main__':
+  sys.exit(main())